@@ -0,0 +1,262 @@
+/*
+    bench_zip.c - Throughput of pas_zip open/find/list/extract on synthetic archives.
+    From repo root: gcc -std=c99 -Wall -Wextra -O2 -o bench/pas_zip/bench_zip bench/pas_zip/bench_zip.c -I.
+
+    Usage: bench_zip [--quick] [--max-entries N] [--min-time SECONDS]
+        --quick          archives up to 10000 entries, shorter timing runs (CI)
+        --max-entries N  largest archive (default 1000000)
+        --min-time S     minimum time per measurement (default 0.2)
+
+    Output: one JSON object per line on stdout, e.g.
+        {"bench":"find_hit","method":"store","entries":1000,"payload":64,"ops":51200,"ns_per_op":812.4}
+    Extraction lines also carry "mb_per_s" (uncompressed bytes). Progress goes to stderr.
+*/
+
+#define _POSIX_C_SOURCE 199309L  /* clock_gettime under -std=c99 */
+#define PAS_ZIP_IMPLEMENTATION
+#include "pas_zip.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <windows.h>
+static double now_sec(void) {
+    LARGE_INTEGER f, c;
+    QueryPerformanceFrequency(&f);
+    QueryPerformanceCounter(&c);
+    return (double)c.QuadPart / (double)f.QuadPart;
+}
+#else
+#include <time.h>
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+#endif
+
+#define NAME_LEN 32
+
+static double g_min_time = 0.2;
+static pas_zip_deflate_t g_deflate;
+static pas_zip_t g_zip;
+
+typedef struct {
+    unsigned char *zip;
+    size_t         zip_size;
+    char          *names;      /* count * NAME_LEN */
+    size_t         count;
+    size_t         payload;    /* bytes per entry */
+    int            level;      /* 0 = Store */
+    unsigned char *data;       /* shared payload of all entries */
+} archive_t;
+
+/* Log-like text compresses about 3:1, close to typical source and config files. */
+static void fill_payload(unsigned char *p, size_t n, uint32_t seed) {
+    static const char *words[] = { "GET ", "/api/", "items ", "200 ", "host", "OK ", "user=", "id=" };
+    size_t i = 0;
+    while (i < n) {
+        const char *w;
+        seed = seed * 1103515245u + 12345u;
+        w = words[(seed >> 16) & 7];
+        while (*w && i < n) p[i++] = (unsigned char)*w++;
+        if (i < n) p[i++] = (unsigned char)('0' + (seed >> 28) % 10);
+        if ((seed >> 24) % 11 == 0 && i < n) p[i++] = '\n';
+    }
+}
+
+/* The streaming writer emits ZIP64 records, so archives may exceed 65535 entries. */
+static int build_archive(archive_t *a, size_t count, size_t payload, int level) {
+    static pas_zip_writer_t writer;
+    pas_zip_writer_entry_t *entries;
+    pas_zip_status st;
+    size_t cap, i;
+    int ok;
+
+    memset(a, 0, sizeof(*a));
+    a->count = count;
+    a->payload = payload;
+    a->level = level;
+    a->names = (char *)malloc(count * NAME_LEN);
+    a->data = (unsigned char *)malloc(payload ? payload : 1);
+    entries = (pas_zip_writer_entry_t *)malloc(count * sizeof(*entries));
+    cap = count * (30 + 46 + 2 * NAME_LEN + 2 * 28 + payload + payload / 8) + 65536;
+    a->zip = (unsigned char *)malloc(cap);
+    ok = a->names && a->data && entries && a->zip;
+
+    if (ok) {
+        fill_payload(a->data, payload, 1);
+        ok = pas_zip_writer_begin(&writer, a->zip, cap, entries, count, &g_deflate, &st);
+    }
+    for (i = 0; ok && i < count; i++) {
+        char *nm = a->names + i * NAME_LEN;
+        (void)sprintf(nm, "dir%03u/file%07u.txt", (unsigned)(i % 1000), (unsigned)i);
+        ok = pas_zip_writer_add_entry(&writer, nm, level, &st) &&
+             pas_zip_writer_add_chunk(&writer, a->data, payload, &st);
+    }
+    if (ok) a->zip_size = pas_zip_writer_finish(&writer, &st);
+    free(entries);
+    return a->zip_size > 0;
+}
+
+static void free_archive(archive_t *a) {
+    free(a->zip);
+    free(a->names);
+    free(a->data);
+}
+
+static void report(const char *bench, const archive_t *a, size_t ops, double sec, double bytes) {
+    (void)printf("{\"bench\":\"%s\",\"method\":\"%s\",\"entries\":%lu,\"payload\":%lu,\"ops\":%lu,\"ns_per_op\":%.1f",
+                 bench, a->level ? "deflate" : "store", (unsigned long)a->count, (unsigned long)a->payload,
+                 (unsigned long)ops, sec * 1e9 / (double)ops);
+    if (bytes > 0) (void)printf(",\"mb_per_s\":%.1f", bytes / sec / 1e6);
+    (void)printf("}\n");
+    (void)fflush(stdout);
+}
+
+/* Run fn(a, i) for i = 0, 1, ... in doubling batches until g_min_time has passed. */
+typedef int (*op_fn)(const archive_t *a, size_t i);
+
+static double run_timed(const archive_t *a, op_fn fn, size_t *ops_out) {
+    size_t batch = 1, ops = 0, i;
+    double start = now_sec(), elapsed = 0;
+    int sink = 0;
+    while (elapsed < g_min_time) {
+        for (i = 0; i < batch; i++) sink += fn(a, ops + i);
+        ops += batch;
+        elapsed = now_sec() - start;
+        if (batch < ((size_t)1 << 20)) batch *= 2;
+    }
+    if (sink == -1) (void)fprintf(stderr, "?");
+    *ops_out = ops;
+    return elapsed;
+}
+
+static size_t pick(const archive_t *a, size_t i) {
+    return (size_t)(((uint64_t)i * 2654435761u) % a->count);
+}
+
+static int op_open(const archive_t *a, size_t i) {
+    pas_zip_status st;
+    (void)i;
+    return pas_zip_open(a->zip, a->zip_size, &st) != NULL;
+}
+
+static int op_find_hit(const archive_t *a, size_t i) {
+    return pas_zip_find(&g_zip, a->names + pick(a, i) * NAME_LEN) != NULL;
+}
+
+static int op_find_miss(const archive_t *a, size_t i) {
+    char name[NAME_LEN];
+    (void)sprintf(name, "dir%03u/missing%07u.txt", (unsigned)(i % 1000), (unsigned)i);
+    (void)a;
+    return pas_zip_find(&g_zip, name) != NULL;
+}
+
+static int op_find_indexed(const archive_t *a, size_t i) {
+    return pas_zip_find_indexed(&g_zip, a->names + pick(a, i) * NAME_LEN) != NULL;
+}
+
+static void count_cb(const char *name, size_t size, void *user) {
+    (void)name;
+    *(size_t *)user += size;
+}
+
+static int op_list(const archive_t *a, size_t i) {
+    size_t total = 0;
+    (void)a;
+    (void)i;
+    (void)pas_zip_list(&g_zip, count_cb, &total);
+    return total != 0;
+}
+
+static unsigned char *g_out;
+static pas_zip_file_t *g_entries;
+
+static int op_extract(const archive_t *a, size_t i) {
+    pas_zip_status st;
+    return pas_zip_extract(&g_entries[i % a->count], g_out, a->payload, &st) == a->payload;
+}
+
+static void bench_archive(size_t count, size_t payload, int level) {
+    archive_t a;
+    pas_zip_status st;
+    size_t ops, i;
+    double sec;
+    void *index;
+
+    (void)fprintf(stderr, "%s: %lu entries x %lu bytes\n", level ? "deflate" : "store",
+                  (unsigned long)count, (unsigned long)payload);
+    if (!build_archive(&a, count, payload, level)) {
+        (void)fprintf(stderr, "  archive build failed\n");
+        free_archive(&a);
+        return;
+    }
+
+    sec = run_timed(&a, op_open, &ops);
+    report("open", &a, ops, sec, 0);
+    if (!pas_zip_open_ex(&g_zip, a.zip, a.zip_size, &st)) {
+        free_archive(&a);
+        return;
+    }
+
+    /* Central Directory scans; pas_zip_find switches to the hash index once one is built */
+    sec = run_timed(&a, op_find_hit, &ops);
+    report("find_hit", &a, ops, sec, 0);
+    sec = run_timed(&a, op_find_miss, &ops);
+    report("find_miss", &a, ops, sec, 0);
+    sec = run_timed(&a, op_list, &ops);
+    report("list", &a, ops, sec, 0);
+
+    /* The index also resolves every entry for the extraction loop in O(n) */
+    index = malloc(pas_zip_index_size(&g_zip));
+    g_entries = (pas_zip_file_t *)malloc(count * sizeof(*g_entries));
+    g_out = (unsigned char *)malloc(payload ? payload : 1);
+    if (index && g_entries && g_out &&
+        pas_zip_index_build(&g_zip, index, pas_zip_index_size(&g_zip), &st) == 0) {
+        sec = run_timed(&a, op_find_indexed, &ops);
+        report("find_indexed", &a, ops, sec, 0);
+
+        for (i = 0; i < count; i++)
+            if (!pas_zip_find_indexed_ex(&g_zip, a.names + i * NAME_LEN, &g_entries[i])) break;
+        if (i == count) {
+            sec = run_timed(&a, op_extract, &ops);
+            report("extract", &a, ops, sec, (double)ops * (double)payload);
+        }
+    }
+    g_zip.index = NULL;
+    free(index);
+    free(g_entries);
+    free(g_out);
+    free_archive(&a);
+}
+
+int main(int argc, char **argv) {
+    static const size_t counts[] = { 1, 100, 10000, 1000000 };
+    size_t max_entries = 1000000, c;
+    int i, level;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--quick") == 0) {
+            max_entries = 10000;
+            g_min_time = 0.05;
+        } else if (strcmp(argv[i], "--max-entries") == 0 && i + 1 < argc) {
+            max_entries = (size_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+            g_min_time = atof(argv[++i]);
+        } else {
+            (void)fprintf(stderr, "usage: %s [--quick] [--max-entries N] [--min-time SECONDS]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    for (level = 0; level <= 6; level += 6) {
+        /* Many small entries: directory-bound operations */
+        for (c = 0; c < sizeof(counts) / sizeof(counts[0]); c++)
+            if (counts[c] <= max_entries) bench_archive(counts[c], 64, level);
+        /* Few large entries: extraction throughput */
+        bench_archive(16, 4 << 20, level);
+    }
+    return 0;
+}
@@ -1,5 +1,5 @@
 /*
-    example_extract.c - Extract a file from a RAR archive (RAR4/RAR5, store/uncompressed only).
+    example_extract.c - Extract a file from a RAR archive (store, RAR5 LZ or RAR4 LZ/PPMd).
     From repo root: gcc -o examples/pas_rar/example_extract examples/pas_rar/example_extract.c -I.
     Usage: ./example_extract <file.rar> <entry_name> [output_file]
 */
@@ -17,7 +17,7 @@ int main(int argc, char **argv) {
     pas_rar_t *rar;
     pas_rar_file_t *file;
     pas_rar_status status;
-    size_t extracted;
+    size_t extracted, buf_size;
     unsigned char *buf;
     FILE *out;
     uint64_t file_size;
@@ -61,26 +61,25 @@ int main(int argc, char **argv) {
         return 1;
     }
 
-    if (pas_rar_is_compressed(file)) {
-        (void)fprintf(stderr, "Entry is compressed; pas_rar extracts only store/uncompressed files.\n");
-        free(data);
-        return 1;
-    }
-
     file_size = pas_rar_size(file);
-    if (file_size > (uint64_t)SIZE_MAX - 1) {
+    if (file_size > ((uint64_t)SIZE_MAX - 1) / 2) {
         (void)fprintf(stderr, "File too large\n");
         free(data);
         return 1;
     }
 
-    buf = (unsigned char *)malloc((size_t)file_size + 1);
+    /* Compressed entries use the space after the data as the dictionary window, RAR4 ones also
+       as the PPMd model (its size is only known once a PPMd block starts, so reserve the largest) */
+    buf_size = (size_t)file_size + 1 + pas_rar_window_size(file);
+    if (rar->format == 4 && pas_rar_is_compressed(file))
+        buf_size += pas_rar_ppm_arena_size(PAS_RAR_PPM_MAX_MB);
+    buf = (unsigned char *)malloc(buf_size);
     if (!buf) {
         free(data);
         return 1;
     }
 
-    extracted = pas_rar_extract(file, buf, (size_t)file_size + 1, &status);
+    extracted = pas_rar_extract(file, buf, buf_size, &status);
     if (status != PAS_RAR_OK || extracted == 0) {
         (void)fprintf(stderr, "pas_rar_extract failed: %d\n", status);
         free(buf);
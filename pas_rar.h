@@ -6,10 +6,20 @@
       - OS-independent: no OS calls; pure parsing and memcpy extraction.
 
     Format support:
-      - RAR4 ("Rar!\x1A\x07\x00"): header parsing + file listing + extraction for METHOD=store only.
-      - RAR5 ("Rar!\x1A\x07\x01\x00"): basic support — file listing and extraction for uncompressed files
-        (compression method 0, non-solid, non-encrypted).
-      - Compressed methods (RAR4/RAR5): detected, return PAS_RAR_E_COMPRESSED.
+      - RAR4 ("Rar!\x1A\x07\x00"): file listing and extraction of stored files and of files packed by
+        RAR 2.9/3.x (LZ and PPMd blocks, standard VM filters; non-encrypted).
+      - RAR5 ("Rar!\x1A\x07\x01\x00"): file listing and extraction of stored and compressed files
+        (methods 0..5 with the E8, E8E9, ARM and delta filters).
+      - Solid archives: entries are extracted in archive order with the pas_rar_seq_* functions.
+      - Multi-volume archives (name.part1.rar..., name.rar + name.r00...): pas_rar_open_volumes takes
+        the volumes in order; entries split over volumes are read part by part, nothing is joined.
+      - Integrity checks (opt-in, rar->verify): the stored CRC32 (RAR4, RAR5) or BLAKE2sp (RAR5)
+        of every extracted entry, with PCLMULQDQ / ARMv8 CRC32 and 8-lane AVX2 BLAKE2sp kernels.
+      - RAR5 encryption (pas_rar_set_password): AES-256-CBC entries and encrypted headers (rar -hp),
+        AES-NI when the CPU has it. PBKDF2-HMAC-SHA256 keys are cached per salt in caller memory,
+        filled by pas_rar_derive_keys on worker threads.
+      - RAR 1.5/2.0 compression: detected, returns PAS_RAR_E_COMPRESSED. Custom VM filter programs
+        return PAS_RAR_E_UNSUPPORTED.
 
     Usage:
         In ONE translation unit:
@@ -19,10 +29,18 @@
         In others:
             #include "pas_rar.h"
 
+    Threads (optional, for pas_rar_derive_keys):
+        #define PAS_RAR_USE_THREADS   // Win32 threads or pthreads (link with -lpthread)
+        Without it, keys are derived on the calling thread.
+
     Notes:
-      - This is intentionally minimal. RAR commonly uses compression; extraction here works only when the
-        file method is "store" (0x30) and packed size equals unpacked size.
-      - The API is not thread-safe / not re-entrant because it uses internal static storage (like pas_zip.h).
+      - Decompression keeps its window (and the PPMd model of RAR 3.x entries) in caller memory:
+        pas_rar_extract uses the tail of the output buffer, pas_rar_extract_ex takes a separate window
+        and decoder state.
+      - pas_rar_open / pas_rar_find return internal static storage (one archive and one entry at a time).
+        The _ex variants take caller-owned structs and are re-entrant: any number of archives and entries
+        may be live at once and used from different threads (pas_rar_set_password and
+        pas_rar_derive_keys excepted: they change the archive).
 */
 
 #ifndef PAS_RAR_H
@@ -42,6 +60,8 @@ extern "C" {
 #define PAS_RAR_E_UNSUPPORTED -4
 #define PAS_RAR_E_NOSPACE    -5
 #define PAS_RAR_E_RANGE      -6
+#define PAS_RAR_E_CRC        -7  /* extracted data does not match the stored CRC32 / BLAKE2sp */
+#define PAS_RAR_E_PASSWORD   -8  /* encrypted entry or headers: no password set, or a wrong one */
 
 typedef int pas_rar_status;
 
@@ -54,40 +74,330 @@ typedef struct pas_rar_file pas_rar_file_t;
 #ifndef PAS_RAR_MAX_NAME
 #define PAS_RAR_MAX_NAME 512
 #endif
+#ifndef PAS_RAR_MAX_HEADER
+#define PAS_RAR_MAX_HEADER 8192  /* longest encrypted header; each is decrypted on the stack */
+#endif
+#ifndef PAS_RAR_MAX_THREADS
+#define PAS_RAR_MAX_THREADS 64
+#endif
+
+typedef struct pas_rar_index_slot pas_rar_index_slot_t;
+
+/* Keys derived from the password for one RAR5 salt (a slot of the key cache) */
+typedef struct pas_rar_key {
+    uint8_t salt[16];
+    uint8_t lg2_count;        /* PBKDF2 ran 2^lg2_count rounds */
+    uint8_t used;             /* 0: free slot */
+    uint8_t check[8];         /* password check value */
+    uint8_t hash_key[32];     /* HMAC key of the checksums of encrypted entries */
+    uint8_t round_keys[240];  /* AES-256 decryption key schedule */
+} pas_rar_key_t;
+
+/* One volume of a multi-volume archive: its bytes in memory (read or mapped by the caller) */
+typedef struct pas_rar_volume {
+    const void *data;
+    size_t      size;
+} pas_rar_volume_t;
 
 struct pas_rar {
-    const uint8_t *data;
-    size_t         size;
-    size_t         scan_offset; /* offset after the main header (RAR4) */
-    int            format;      /* 4 or 5 */
+    const uint8_t          *data;
+    size_t                  size;
+    size_t                  scan_offset; /* offset after the main header (RAR4) */
+    int                     format;      /* 4 or 5 */
+    pas_rar_index_slot_t   *index;       /* optional entry table (pas_rar_index_build), NULL if none */
+    size_t                  index_slots; /* power of two */
+    const pas_rar_volume_t *volumes;     /* pas_rar_open_volumes: every volume, data is the first */
+    size_t                  nvolumes;    /* 0 for a single buffer */
+    int                     verify;      /* set to 1 to check CRC32 / BLAKE2sp on extract */
+    int                     crypt_headers; /* RAR5 headers past the signature are encrypted */
+    const char             *password;    /* pas_rar_set_password: UTF-8, not copied */
+    size_t                  password_len;
+    pas_rar_key_t          *keys;        /* key cache, one slot per salt; NULL if none */
+    size_t                  nkeys;
 };
 
+/* pas_rar_file_t.split: the entry's packed data continues from the previous / in the next volume */
+#define PAS_RAR_SPLIT_BEFORE 1
+#define PAS_RAR_SPLIT_AFTER  2
+
+/* pas_rar_file_t.checks: checksums of the unpacked data stored in the entry's header */
+#define PAS_RAR_CHECK_CRC32  1
+#define PAS_RAR_CHECK_BLAKE2 2
+
+/* pas_rar_file_t.crypt */
+#define PAS_RAR_CRYPT_DATA   1  /* packed data encrypted (RAR5: AES-256-CBC; RAR4: not supported) */
+#define PAS_RAR_CRYPT_HEADER 2  /* the header is encrypted: name bytes at name_offset are too */
+#define PAS_RAR_CRYPT_CHECK  4  /* check holds the password check value */
+#define PAS_RAR_CRYPT_MAC    8  /* crc32 / blake2 are HMAC-SHA256 based, keyed from the password */
+
 struct pas_rar_file {
-    const char *name;
-    uint64_t    packed_size;
-    uint64_t    unpacked_size;
-    uint8_t     method;
-    uint32_t    data_offset; /* into archive buffer */
+    const char      *name;        /* NUL-terminated; set by pas_rar_find only (shared buffer), NULL for _ex */
+    uint64_t         packed_size;
+    uint64_t         unpacked_size;
+    uint8_t          method;
+    uint64_t         data_offset; /* into archive buffer */
+    const pas_rar_t *rar;         /* owning archive */
+    size_t           name_offset; /* name bytes in the entry's volume, not NUL-terminated */
+    uint16_t         name_len;
+    uint64_t         dict_size;      /* LZ dictionary the entry was packed with (0 for store) */
+    uint8_t          unpack_version; /* RAR4 UNP_VER (20, 26, 29, ...); 50 for RAR5 */
+    uint8_t          solid;          /* continues the previous entry's decoder state */
+    uint8_t          split;          /* PAS_RAR_SPLIT_* */
+    uint32_t         volume;         /* volume of the header and first data part (0: rar->data) */
+    uint64_t         part_size;      /* packed bytes at data_offset; packed_size sums all parts */
+    uint8_t          checks;         /* PAS_RAR_CHECK_*; a split entry's come from its last part */
+    uint32_t         crc32;
+    uint8_t          blake2[32];     /* BLAKE2sp (RAR5 hash record) */
+    size_t           header_offset;  /* block header in the entry's volume */
+    uint8_t          crypt;          /* PAS_RAR_CRYPT_* */
+    uint8_t          lg2_count;      /* key derivation rounds (log2); 255: unknown encryption */
+    uint8_t          salt[16];
+    uint8_t          iv[16];
+    uint8_t          check[8];
+};
+
+struct pas_rar_index_slot {
+    uint32_t       hash;  /* FNV-1a of the name */
+    uint32_t       used;  /* 0 = empty slot */
+    pas_rar_file_t file;
 };
 
-/* Open RAR from memory. data/size must remain valid. */
+/* Open RAR from memory. data/size must remain valid.
+   Returns a pointer to internal static storage: one archive at a time, not thread-safe. */
 pas_rar_t *pas_rar_open(const void *data, size_t size, pas_rar_status *status);
 
-/* Find file by name (case-sensitive). Returns NULL if not found. */
+/* Find file by name (case-sensitive). Returns NULL if not found.
+   Returns internal static storage, overwritten by the next pas_rar_find. */
 pas_rar_file_t *pas_rar_find(pas_rar_t *rar, const char *name);
 
+/* Re-entrant variants: caller owns *out. Return 1 on success, 0 on failure / not found. */
+int pas_rar_open_ex(pas_rar_t *out, const void *data, size_t size, pas_rar_status *status);
+int pas_rar_find_ex(const pas_rar_t *rar, const char *name, pas_rar_file_t *out);
+
+/* Open a multi-volume archive from its count volumes in order (the volumes array and every buffer
+   must remain valid). Entries are listed once, from the volume their header starts in; an entry
+   split over volumes is read across them by the extract functions, part by part. Opening one
+   volume alone with pas_rar_open_ex lists its entries, but split ones cannot be extracted
+   (PAS_RAR_E_INVALID) and the tails continued from an earlier volume are not listed.
+   Returns 1 on success. */
+int pas_rar_open_volumes(pas_rar_t *out, const pas_rar_volume_t *volumes, size_t count,
+                         pas_rar_status *status);
+
 /* File info */
 const char *pas_rar_name(pas_rar_file_t *file);
+const char *pas_rar_name_span(const pas_rar_file_t *file, size_t *len); /* not NUL-terminated */
+/* Name copied to buf, NUL-terminated and truncated to size - 1 bytes; decrypted when the headers
+   are encrypted (pas_rar_name_span returns NULL for those). Returns the bytes copied. */
+size_t       pas_rar_name_copy(const pas_rar_file_t *file, char *buf, size_t size);
 uint64_t     pas_rar_size(pas_rar_file_t *file);        /* unpacked size */
 uint64_t     pas_rar_packed_size(pas_rar_file_t *file);
 int          pas_rar_is_compressed(pas_rar_file_t *file); /* non-zero if not store */
 
-/* Extract file to buffer. Returns bytes written or 0 on error. */
+/* Extract file to buffer. Returns bytes written or 0 on error.
+   Compressed entries need buffer_size >= unpacked size + pas_rar_window_size(file): the tail of
+   buffer serves as the dictionary window (decoder state goes on the stack). RAR4 entries with
+   PPMd blocks also need pas_rar_ppm_arena_size of the packer's model size past the window.
+   With rar->verify set, every extract function checks the written bytes against the entry's
+   stored CRC32 and BLAKE2sp and fails with PAS_RAR_E_CRC on a mismatch. */
 size_t pas_rar_extract(pas_rar_file_t *file, void *buffer, size_t buffer_size, pas_rar_status *status);
 
 /* List all files. callback(name, unpacked_size, user). Returns 0 on success, -1 on error. */
 int pas_rar_list(pas_rar_t *rar, void (*callback)(const char *name, uint64_t size, void *user), void *user);
 
+/* Entry table (optional): one walk over the block headers records every entry in a caller-owned
+   hash table of capacity slots; afterwards pas_rar_find / pas_rar_find_ex look names up there
+   instead of re-parsing the header chain. The table must stay valid while rar->index is set.
+   Only the largest power of two <= capacity is used and it must hold at least twice the entry
+   count; pas_rar_index_capacity returns that size (one extra header walk, 0 on error).
+   Returns 1 on success, 0 on error (PAS_RAR_E_NOSPACE if the table is too small). */
+size_t pas_rar_index_capacity(const pas_rar_t *rar);
+int    pas_rar_index_build(pas_rar_t *rar, pas_rar_index_slot_t *table, size_t capacity, pas_rar_status *status);
+
+/* Password for RAR5 encryption: password_len bytes of UTF-8 (the string must remain valid), and
+   count caller-owned key slots. Deriving the keys for a salt takes 2^lg2_count PBKDF2 rounds
+   (32768 by default, tens of milliseconds); pas_rar_derive_keys fills a slot per salt, which every
+   entry with that salt then reuses. Entries whose salt has no slot derive their keys again on
+   each extraction; extraction never writes the slots. Setting a password clears the slots; NULL
+   removes it. Archives with encrypted headers need a slot, and their first header is decrypted
+   here (its key kept in slot 0): PAS_RAR_E_PASSWORD if that fails. Neither this nor
+   pas_rar_derive_keys may run while other threads use the archive. Returns 1 on success. */
+int pas_rar_set_password(pas_rar_t *rar, const char *password, size_t password_len,
+                         pas_rar_key_t *keys, size_t count, pas_rar_status *status);
+
+/* Derive the keys of every salt used by the archive's encrypted entries and by each volume's
+   encrypted headers into the key slots, on up to thread_count threads (PAS_RAR_USE_THREADS), one
+   salt per thread at a time. Returns 1 on success, 0 on error (PAS_RAR_E_NOSPACE when there
+   are more salts than free slots, the ones that fit derived all the same; PAS_RAR_E_PASSWORD
+   without a password). */
+int pas_rar_derive_keys(pas_rar_t *rar, int thread_count, pas_rar_status *status);
+
+/* CRC32 as stored by RAR (the zlib polynomial). Start with crc = 0 and pass the previous result
+   to continue over more data. */
+uint32_t pas_rar_crc32(uint32_t crc, const void *data, size_t len);
+/* BLAKE2sp digest of len bytes, as in RAR5 hash records */
+void     pas_rar_blake2sp(const void *data, size_t len, uint8_t out[32]);
+
+/* ----- Decompression -----
+   RAR5 entries (methods 1..5) are decoded with LZSS + Huffman into a caller-provided
+   dictionary window and copied out to the destination buffer; the standard E8, E8E9, ARM and
+   delta filters are applied there. Huffman codes decode through a 2^10 (main table) or 2^7
+   quick-lookup table; only longer codes fall back to the canonical length search.
+   RAR4 entries packed by RAR 2.9/3.x (UNP_VER 29/36) go through the same window and tables. Their
+   streams switch between LZ blocks and PPMd (variant H) blocks; the PPMd model lives in the part
+   of the window buffer past the dictionary. VM filters are recognised by their code checksum and
+   run natively (E8, E8E9, Itanium, delta, RGB, audio); other programs are not executed.
+   Encrypted entries are decrypted into a 4 KB staging buffer ahead of the decoder.
+   All decoder state lives in a caller-owned pas_rar_unpack_t (about 21 KB). */
+
+#define PAS_RAR5_NC         306  /* literals, filter, repeat codes and 44 length slots */
+#define PAS_RAR5_DC         64   /* distance slots */
+#define PAS_RAR5_LDC        16   /* low distance bits */
+#define PAS_RAR5_RC         44   /* repeat-distance length slots */
+#define PAS_RAR5_MAX_FILTER 0x400000
+#define PAS_RAR3_NC         299  /* literals, end of block, VM code, repeats, short and long matches */
+#define PAS_RAR3_DC         60
+#define PAS_RAR3_LDC        17   /* low distance bits and "repeat the previous low bits" */
+#define PAS_RAR3_RC         28
+#define PAS_RAR3_TABLES     (PAS_RAR3_NC + PAS_RAR3_DC + PAS_RAR3_LDC + PAS_RAR3_RC)
+#define PAS_RAR3_MAX_FILTER 0x40000  /* VM memory size */
+#define PAS_RAR_MAX_FILTERS 64   /* filters pending at once; also RAR3 filter programs */
+#define PAS_RAR_QUICK_BITS  10
+#define PAS_RAR_PPM_MAX_MB  256  /* largest PPMd model a RAR 3.x stream can ask for */
+#define PAS_RAR_CRYPT_CHUNK 4096 /* encrypted packed data decrypted at a time */
+
+typedef struct pas_rar_huff {
+    uint32_t decode_len[16];  /* left-aligned upper limit of the codes of each length */
+    uint32_t decode_pos[16];  /* index in decode_num of the first code of each length */
+    uint32_t max_num;
+    unsigned quick_bits;
+    uint16_t quick_num[1 << PAS_RAR_QUICK_BITS];
+    uint8_t  quick_len[1 << PAS_RAR_QUICK_BITS];
+    uint16_t decode_num[PAS_RAR5_NC];
+} pas_rar_huff_t;
+
+typedef struct pas_rar_filter {
+    uint64_t start;    /* stream position of the filtered block */
+    uint32_t length;
+    uint32_t channels; /* delta and audio; RGB: bytes per line */
+    uint8_t  type;     /* 0 delta, 1 E8, 2 E8E9, 3 ARM, 4 RGB, 5 audio, 6 Itanium */
+    uint8_t  pos_r;    /* RGB: offset of the red byte (0..2) */
+} pas_rar_filter_t;
+
+/* AES-256-CBC decryption of an entry's packed data, in order across its parts */
+typedef struct pas_rar_crypt {
+    uint8_t          round_keys[240];
+    uint8_t          iv[16];       /* last ciphertext block */
+    const pas_rar_t *rar;
+    const uint8_t   *src;          /* ciphertext left in the current part */
+    size_t           src_size;
+    uint32_t         vol;          /* volume of src */
+    uint64_t         left;         /* ciphertext bytes left over all parts */
+} pas_rar_crypt_t;
+
+typedef struct pas_rar_unpack {
+    const uint8_t   *in;           /* part of the packed data holding bitpos */
+    size_t           in_size;
+    uint64_t         in_base;      /* packed-data position of in[0] */
+    uint64_t         in_total;     /* packed bytes over all parts */
+    const pas_rar_t *in_rar;       /* volumes of the later parts */
+    uint32_t         in_vol;       /* volume of in */
+    uint64_t         bitpos;       /* MSB-first bit position in the packed data */
+    uint64_t         block_end;    /* bit position where the current block ends */
+    int              last_block;
+    int              tables_read;
+    uint8_t         *window;
+    size_t           window_size;
+    size_t           win_pos;      /* window index of stream position unp */
+    uint64_t         unp;          /* bytes decoded into the window */
+    uint64_t         flushed;      /* bytes copied out of the window */
+    uint8_t         *out;          /* destination of the current entry */
+    uint64_t         out_base;     /* stream position of out[0] */
+    uint64_t         old_dist[4];
+    uint32_t         last_len;
+    unsigned         nfilters;
+    pas_rar_filter_t filters[PAS_RAR_MAX_FILTERS];
+    pas_rar_huff_t   ld, dd, ldd, rd;
+    int              format;         /* 4 or 5, as the archive */
+    /* RAR 2.9/3.x */
+    uint32_t         prev_low_dist;
+    unsigned         low_dist_rep;   /* distances left that reuse prev_low_dist */
+    int              ppm_block;      /* current block is PPMd */
+    int              ppm_esc;        /* escape byte of PPMd blocks */
+    void            *ppm;            /* PPMd model, NULL until the first PPMd block */
+    uint8_t         *ppm_arena;      /* window buffer past the dictionary */
+    size_t           ppm_arena_size;
+    unsigned         last_filter;
+    unsigned         nprogs;         /* filter programs defined since the last reset */
+    uint8_t          prog_type[PAS_RAR_MAX_FILTERS];
+    uint32_t         prog_len[PAS_RAR_MAX_FILTERS];
+    uint8_t          old_table[PAS_RAR3_TABLES];
+    /* Encrypted entries: in is crypt_buf, the last 16 bytes kept across refills for lookahead */
+    int              crypted;
+    pas_rar_crypt_t  crypt;
+    uint8_t          crypt_buf[16 + PAS_RAR_CRYPT_CHUNK];
+} pas_rar_unpack_t;
+
+/* Window bytes needed to extract file: the dictionary size, but no more than the unpacked size
+   (a non-solid entry never looks further back), and at least 8 MB when the entry is larger than
+   that so a 4 MB delta-filter block is still in the window when it completes. 0 for store. */
+size_t pas_rar_window_size(const pas_rar_file_t *file);
+
+/* Memory for a RAR 3.x PPMd model of model_mb megabytes (1..PAS_RAR_PPM_MAX_MB), to be added to
+   pas_rar_window_size. The model size is chosen by the packer and only known once a PPMd block
+   starts; PAS_RAR_E_NOSPACE means it did not fit. 0 if model_mb is out of range. */
+size_t pas_rar_ppm_arena_size(unsigned model_mb);
+
+/* Extract file through the caller's decoder state and window (window_size >= the smaller of the
+   dictionary and unpacked sizes; pas_rar_window_size is always enough). For RAR4 entries the
+   bytes past pas_rar_window_size(file) hold the PPMd model. Store entries are copied without
+   touching state or window. Returns bytes written or 0 on error: PAS_RAR_E_NOSPACE when buffer,
+   window or model memory is too small, PAS_RAR_E_INVALID on corrupt data, PAS_RAR_E_COMPRESSED
+   for RAR 1.5/2.0 compression, PAS_RAR_E_UNSUPPORTED for solid entries (see below), unknown VM
+   filters and RAR 7 dictionaries. */
+size_t pas_rar_extract_ex(const pas_rar_file_t *file, void *buffer, size_t buffer_size,
+                          pas_rar_unpack_t *state, void *window, size_t window_size,
+                          pas_rar_status *status);
+
+/* Sequential extraction: entries in archive order through one decoder state and window. In a
+   solid archive every entry continues the stream of the one before, so extracting it alone would
+   mean decoding everything in front of it; walking the archive once costs a single pass. Entries
+   the caller does not extract are decoded without output when a solid entry follows them.
+   Non-solid entries start a fresh stream, so any archive can be walked this way. */
+typedef struct pas_rar_seq {
+    const pas_rar_t  *rar;
+    pas_rar_unpack_t *state;
+    void             *window;
+    size_t            window_size;
+    size_t            ring;     /* dictionary part of window; RAR4: the rest is the PPMd arena */
+    uint32_t          volume;   /* volume of offset */
+    size_t            offset;   /* block header after the current entry */
+    pas_rar_file_t    file;     /* current entry */
+    int               pending;  /* current entry not decoded yet */
+    int               live;     /* state holds the stream up to the end of the last decoded entry */
+} pas_rar_seq_t;
+
+/* Window bytes for sequential extraction: the largest dictionary, each capped at the unpacked
+   size of its solid run so far (and at least 8 MB for larger runs, as pas_rar_window_size). RAR4
+   archives with PPMd blocks need pas_rar_ppm_arena_size more. 0 on error or if nothing is
+   compressed. */
+size_t pas_rar_seq_window_size(const pas_rar_t *rar);
+
+/* Start before the first entry of rar; state and window (window_size >= pas_rar_seq_window_size)
+   are used by every later call. Returns 1 on success. */
+int pas_rar_seq_begin(pas_rar_seq_t *seq, const pas_rar_t *rar, pas_rar_unpack_t *state,
+                      void *window, size_t window_size, pas_rar_status *status);
+
+/* Move to the next entry and copy it to *out (may be NULL). Returns 1, or 0 at the end of the
+   archive (status PAS_RAR_OK) or on a corrupt header. */
+int pas_rar_seq_next(pas_rar_seq_t *seq, pas_rar_file_t *out, pas_rar_status *status);
+
+/* Extract the current entry to buffer (buffer_size >= its unpacked size). Returns bytes written or
+   0 on error, as pas_rar_extract_ex; a buffer too small (PAS_RAR_E_NOSPACE) leaves the entry
+   current for another try.
+   A solid entry whose predecessor could not be decoded (or that starts the archive) gives
+   PAS_RAR_E_INVALID. */
+size_t pas_rar_seq_extract(pas_rar_seq_t *seq, void *buffer, size_t buffer_size, pas_rar_status *status);
+
 #ifdef __cplusplus
 }
 #endif
@@ -98,6 +408,19 @@ int pas_rar_list(pas_rar_t *rar, void (*callback)(const char *name, uint64_t siz
 
 #include <string.h>
 
+#ifdef PAS_RAR_USE_THREADS
+#if defined(_WIN32) || defined(_WIN64)
+    #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+    typedef HANDLE pas_rar__thread_t;
+#else
+    #include <pthread.h>
+    typedef pthread_t pas_rar__thread_t;
+#endif
+#endif
+
 static pas_rar_t pas_rar__handle;
 static pas_rar_file_t pas_rar__current_file;
 static char pas_rar__name_buf[PAS_RAR_MAX_NAME];
@@ -245,11 +568,626 @@ static int pas_rar__read_block5(const uint8_t *data, size_t size, size_t off,
     return 1;
 }
 
+/* ----- CPU features -----
+   Checked once: PCLMULQDQ + SSE4.1 for CRC32, AVX2 (with the OS saving YMM state) for BLAKE2sp,
+   AES-NI for decryption */
+
+#define PAS_RAR__CPU_KNOWN  1
+#define PAS_RAR__CPU_PCLMUL 2
+#define PAS_RAR__CPU_AVX2   4
+#define PAS_RAR__CPU_AES    8
+
+#if !defined(PAS_RAR_NO_SIMD) && (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define PAS_RAR_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#define PAS_RAR_TARGET_PCLMUL __attribute__((target("pclmul,sse4.1")))
+#define PAS_RAR_TARGET_AVX2   __attribute__((target("avx2")))
+#define PAS_RAR_TARGET_AES    __attribute__((target("aes,sse2")))
+static int pas_rar__cpu_detect(void)
+{
+    unsigned a, b, c, d, lo, hi;
+    int f = PAS_RAR__CPU_KNOWN;
+    if (!__get_cpuid(1, &a, &b, &c, &d)) return f;
+    if ((c & (1u << 1)) && (c & (1u << 19))) f |= PAS_RAR__CPU_PCLMUL;
+    if ((c & (1u << 25)) && (d & (1u << 26))) f |= PAS_RAR__CPU_AES;
+    if ((c & (1u << 27)) && (c & (1u << 28)) && __get_cpuid_max(0, NULL) >= 7) { /* OSXSAVE, AVX */
+        __asm__ __volatile__("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+        __cpuid_count(7, 0, a, b, c, d);
+        if ((lo & 6) == 6 && (b & (1u << 5))) f |= PAS_RAR__CPU_AVX2;
+    }
+    (void)hi;
+    return f;
+}
+#elif !defined(PAS_RAR_NO_SIMD) && (defined(_M_X64) || defined(_M_IX86)) && defined(_MSC_VER)
+#define PAS_RAR_X86 1
+#include <intrin.h>
+#include <immintrin.h>
+#define PAS_RAR_TARGET_PCLMUL
+#define PAS_RAR_TARGET_AVX2
+#define PAS_RAR_TARGET_AES
+static int pas_rar__cpu_detect(void)
+{
+    int r[4], f = PAS_RAR__CPU_KNOWN;
+    __cpuid(r, 1);
+    if ((r[2] & (1 << 1)) && (r[2] & (1 << 19))) f |= PAS_RAR__CPU_PCLMUL;
+    if (r[2] & (1 << 25)) f |= PAS_RAR__CPU_AES;
+    if ((r[2] & (1 << 27)) && (r[2] & (1 << 28)) && (_xgetbv(0) & 6) == 6) {
+        __cpuidex(r, 7, 0);
+        if (r[1] & (1 << 5)) f |= PAS_RAR__CPU_AVX2;
+    }
+    return f;
+}
+#elif !defined(PAS_RAR_NO_SIMD) && defined(__ARM_FEATURE_CRC32)
+#define PAS_RAR_CRC_ARM 1
+#include <arm_acle.h>
+#endif
+
+#ifdef PAS_RAR_X86
+/* Detection result cached: 0 unknown, else PAS_RAR__CPU_* bits */
+static int pas_rar__cpu_mode;
+
+#if defined(__GNUC__)
+#define PAS_RAR_CPU_MODE_LOAD()    __atomic_load_n(&pas_rar__cpu_mode, __ATOMIC_RELAXED)
+#define PAS_RAR_CPU_MODE_STORE(v)  __atomic_store_n(&pas_rar__cpu_mode, (v), __ATOMIC_RELAXED)
+#else
+#define PAS_RAR_CPU_MODE_LOAD()    (*(volatile int *)&pas_rar__cpu_mode)
+#define PAS_RAR_CPU_MODE_STORE(v)  (*(volatile int *)&pas_rar__cpu_mode = (v))
+#endif
+
+static int pas_rar__cpu(void)
+{
+    int mode = PAS_RAR_CPU_MODE_LOAD();
+    if (mode == 0) {
+        mode = pas_rar__cpu_detect();
+        PAS_RAR_CPU_MODE_STORE(mode);
+    }
+    return mode;
+}
+#endif /* PAS_RAR_X86 */
+
+/* ----- Encryption -----
+   RAR5 encrypts with AES-256 in CBC mode. The key comes from the password through
+   PBKDF2-HMAC-SHA256 (2^lg2_count rounds over a 16-byte salt); as in unrar, the same running sum
+   after 16 and 32 more rounds gives the key of the checksum MACs and the password check value.
+   Decryption uses the equivalent inverse cipher: the key schedule last round first, the inner
+   round keys through InvMixColumns, which is the layout both the T-table path and AESDEC expect.
+   CBC blocks decrypt independently (each XORs in the ciphertext before it), so AES-NI keeps
+   eight in flight. */
+
+#define PAS_RAR__ROTR32(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+static uint32_t pas_rar__u32be(const uint8_t *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+static void pas_rar__put32be(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+static const uint32_t pas_rar__sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static const uint32_t pas_rar__sha256_h0[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+/* One SHA-256 compression of the message block m (big-endian words) into h */
+static void pas_rar__sha256_compress(uint32_t h[8], const uint32_t m[16])
+{
+    uint32_t w[64], a, b, c, d, e, f, g, hh, t1, t2;
+    unsigned i;
+
+    for (i = 0; i < 16; i++) w[i] = m[i];
+    for (i = 16; i < 64; i++) {
+        uint32_t s0 = PAS_RAR__ROTR32(w[i - 15], 7) ^ PAS_RAR__ROTR32(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = PAS_RAR__ROTR32(w[i - 2], 17) ^ PAS_RAR__ROTR32(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+    a = h[0]; b = h[1]; c = h[2]; d = h[3]; e = h[4]; f = h[5]; g = h[6]; hh = h[7];
+    for (i = 0; i < 64; i++) {
+        t1 = hh + (PAS_RAR__ROTR32(e, 6) ^ PAS_RAR__ROTR32(e, 11) ^ PAS_RAR__ROTR32(e, 25)) +
+             ((e & f) ^ (~e & g)) + pas_rar__sha256_k[i] + w[i];
+        t2 = (PAS_RAR__ROTR32(a, 2) ^ PAS_RAR__ROTR32(a, 13) ^ PAS_RAR__ROTR32(a, 22)) +
+             ((a & b) ^ (a & c) ^ (b & c));
+        hh = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+    h[0] += a; h[1] += b; h[2] += c; h[3] += d; h[4] += e; h[5] += f; h[6] += g; h[7] += hh;
+}
+
+static void pas_rar__sha256_block(uint32_t h[8], const uint8_t *p)
+{
+    uint32_t m[16];
+    unsigned i;
+    for (i = 0; i < 16; i++) m[i] = pas_rar__u32be(p + 4 * i);
+    pas_rar__sha256_compress(h, m);
+}
+
+typedef struct {
+    uint32_t h[8];
+    uint8_t  buf[64];
+    uint64_t len;      /* bytes hashed so far */
+} pas_rar__sha256_t;
+
+static void pas_rar__sha256_init(pas_rar__sha256_t *c)
+{
+    memcpy(c->h, pas_rar__sha256_h0, sizeof(c->h));
+    c->len = 0;
+}
+
+static void pas_rar__sha256_update(pas_rar__sha256_t *c, const uint8_t *p, size_t n)
+{
+    size_t have = (size_t)(c->len & 63);
+
+    c->len += n;
+    if (have) {
+        size_t take = 64 - have < n ? 64 - have : n;
+        memcpy(c->buf + have, p, take);
+        p += take;
+        n -= take;
+        if (have + take < 64) return;
+        pas_rar__sha256_block(c->h, c->buf);
+    }
+    for (; n >= 64; p += 64, n -= 64) pas_rar__sha256_block(c->h, p);
+    if (n) memcpy(c->buf, p, n);
+}
+
+static void pas_rar__sha256_final(pas_rar__sha256_t *c, uint8_t out[32])
+{
+    uint8_t pad[72];
+    uint64_t bits = c->len * 8;
+    size_t n = 1 + ((119 - (size_t)(c->len & 63)) & 63); /* 0x80 and zeros up to 56 mod 64 */
+    unsigned i;
+
+    memset(pad, 0, sizeof(pad));
+    pad[0] = 0x80;
+    for (i = 0; i < 8; i++) pad[n + i] = (uint8_t)(bits >> (56 - 8 * i));
+    pas_rar__sha256_update(c, pad, n + 8);
+    for (i = 0; i < 8; i++) pas_rar__put32be(out + 4 * i, c->h[i]);
+}
+
+/* HMAC-SHA256 with the key's inner and outer pad blocks already hashed */
+typedef struct {
+    uint32_t inner[8];
+    uint32_t outer[8];
+} pas_rar__hmac_t;
+
+static void pas_rar__hmac_init(pas_rar__hmac_t *m, const uint8_t *key, size_t len)
+{
+    uint8_t k[64], pad[64];
+    unsigned i;
+
+    memset(k, 0, sizeof(k));
+    if (len > 64) {
+        pas_rar__sha256_t c;
+        pas_rar__sha256_init(&c);
+        pas_rar__sha256_update(&c, key, len);
+        pas_rar__sha256_final(&c, k);
+    } else if (len) {
+        memcpy(k, key, len);
+    }
+    for (i = 0; i < 64; i++) pad[i] = (uint8_t)(k[i] ^ 0x36);
+    memcpy(m->inner, pas_rar__sha256_h0, sizeof(m->inner));
+    pas_rar__sha256_block(m->inner, pad);
+    for (i = 0; i < 64; i++) pad[i] = (uint8_t)(k[i] ^ 0x5c);
+    memcpy(m->outer, pas_rar__sha256_h0, sizeof(m->outer));
+    pas_rar__sha256_block(m->outer, pad);
+}
+
+/* out may be msg */
+static void pas_rar__hmac(const pas_rar__hmac_t *m, const uint8_t *msg, size_t len, uint8_t out[32])
+{
+    pas_rar__sha256_t c;
+
+    memcpy(c.h, m->inner, sizeof(c.h));
+    c.len = 64;
+    pas_rar__sha256_update(&c, msg, len);
+    pas_rar__sha256_final(&c, out);
+    memcpy(c.h, m->outer, sizeof(c.h));
+    c.len = 64;
+    pas_rar__sha256_update(&c, out, 32);
+    pas_rar__sha256_final(&c, out);
+}
+
+static const uint8_t pas_rar__aes_sbox[256] = {
+    0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
+    0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
+    0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+    0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
+    0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
+    0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+    0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
+    0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
+    0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+    0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
+    0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
+    0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+    0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
+    0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
+    0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+    0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16
+};
+
+static const uint8_t pas_rar__aes_inv_sbox[256] = {
+    0x52, 0x09, 0x6a, 0xd5, 0x30, 0x36, 0xa5, 0x38, 0xbf, 0x40, 0xa3, 0x9e, 0x81, 0xf3, 0xd7, 0xfb,
+    0x7c, 0xe3, 0x39, 0x82, 0x9b, 0x2f, 0xff, 0x87, 0x34, 0x8e, 0x43, 0x44, 0xc4, 0xde, 0xe9, 0xcb,
+    0x54, 0x7b, 0x94, 0x32, 0xa6, 0xc2, 0x23, 0x3d, 0xee, 0x4c, 0x95, 0x0b, 0x42, 0xfa, 0xc3, 0x4e,
+    0x08, 0x2e, 0xa1, 0x66, 0x28, 0xd9, 0x24, 0xb2, 0x76, 0x5b, 0xa2, 0x49, 0x6d, 0x8b, 0xd1, 0x25,
+    0x72, 0xf8, 0xf6, 0x64, 0x86, 0x68, 0x98, 0x16, 0xd4, 0xa4, 0x5c, 0xcc, 0x5d, 0x65, 0xb6, 0x92,
+    0x6c, 0x70, 0x48, 0x50, 0xfd, 0xed, 0xb9, 0xda, 0x5e, 0x15, 0x46, 0x57, 0xa7, 0x8d, 0x9d, 0x84,
+    0x90, 0xd8, 0xab, 0x00, 0x8c, 0xbc, 0xd3, 0x0a, 0xf7, 0xe4, 0x58, 0x05, 0xb8, 0xb3, 0x45, 0x06,
+    0xd0, 0x2c, 0x1e, 0x8f, 0xca, 0x3f, 0x0f, 0x02, 0xc1, 0xaf, 0xbd, 0x03, 0x01, 0x13, 0x8a, 0x6b,
+    0x3a, 0x91, 0x11, 0x41, 0x4f, 0x67, 0xdc, 0xea, 0x97, 0xf2, 0xcf, 0xce, 0xf0, 0xb4, 0xe6, 0x73,
+    0x96, 0xac, 0x74, 0x22, 0xe7, 0xad, 0x35, 0x85, 0xe2, 0xf9, 0x37, 0xe8, 0x1c, 0x75, 0xdf, 0x6e,
+    0x47, 0xf1, 0x1a, 0x71, 0x1d, 0x29, 0xc5, 0x89, 0x6f, 0xb7, 0x62, 0x0e, 0xaa, 0x18, 0xbe, 0x1b,
+    0xfc, 0x56, 0x3e, 0x4b, 0xc6, 0xd2, 0x79, 0x20, 0x9a, 0xdb, 0xc0, 0xfe, 0x78, 0xcd, 0x5a, 0xf4,
+    0x1f, 0xdd, 0xa8, 0x33, 0x88, 0x07, 0xc7, 0x31, 0xb1, 0x12, 0x10, 0x59, 0x27, 0x80, 0xec, 0x5f,
+    0x60, 0x51, 0x7f, 0xa9, 0x19, 0xb5, 0x4a, 0x0d, 0x2d, 0xe5, 0x7a, 0x9f, 0x93, 0xc9, 0x9c, 0xef,
+    0xa0, 0xe0, 0x3b, 0x4d, 0xae, 0x2a, 0xf5, 0xb0, 0xc8, 0xeb, 0xbb, 0x3c, 0x83, 0x53, 0x99, 0x61,
+    0x17, 0x2b, 0x04, 0x7e, 0xba, 0x77, 0xd6, 0x26, 0xe1, 0x69, 0x14, 0x63, 0x55, 0x21, 0x0c, 0x7d
+};
+
+static const uint32_t pas_rar__aes_td[256] = {
+    0x51f4a750, 0x7e416553, 0x1a17a4c3, 0x3a275e96, 0x3bab6bcb, 0x1f9d45f1, 0xacfa58ab, 0x4be30393,
+    0x2030fa55, 0xad766df6, 0x88cc7691, 0xf5024c25, 0x4fe5d7fc, 0xc52acbd7, 0x26354480, 0xb562a38f,
+    0xdeb15a49, 0x25ba1b67, 0x45ea0e98, 0x5dfec0e1, 0xc32f7502, 0x814cf012, 0x8d4697a3, 0x6bd3f9c6,
+    0x038f5fe7, 0x15929c95, 0xbf6d7aeb, 0x955259da, 0xd4be832d, 0x587421d3, 0x49e06929, 0x8ec9c844,
+    0x75c2896a, 0xf48e7978, 0x99583e6b, 0x27b971dd, 0xbee14fb6, 0xf088ad17, 0xc920ac66, 0x7dce3ab4,
+    0x63df4a18, 0xe51a3182, 0x97513360, 0x62537f45, 0xb16477e0, 0xbb6bae84, 0xfe81a01c, 0xf9082b94,
+    0x70486858, 0x8f45fd19, 0x94de6c87, 0x527bf8b7, 0xab73d323, 0x724b02e2, 0xe31f8f57, 0x6655ab2a,
+    0xb2eb2807, 0x2fb5c203, 0x86c57b9a, 0xd33708a5, 0x302887f2, 0x23bfa5b2, 0x02036aba, 0xed16825c,
+    0x8acf1c2b, 0xa779b492, 0xf307f2f0, 0x4e69e2a1, 0x65daf4cd, 0x0605bed5, 0xd134621f, 0xc4a6fe8a,
+    0x342e539d, 0xa2f355a0, 0x058ae132, 0xa4f6eb75, 0x0b83ec39, 0x4060efaa, 0x5e719f06, 0xbd6e1051,
+    0x3e218af9, 0x96dd063d, 0xdd3e05ae, 0x4de6bd46, 0x91548db5, 0x71c45d05, 0x0406d46f, 0x605015ff,
+    0x1998fb24, 0xd6bde997, 0x894043cc, 0x67d99e77, 0xb0e842bd, 0x07898b88, 0xe7195b38, 0x79c8eedb,
+    0xa17c0a47, 0x7c420fe9, 0xf8841ec9, 0x00000000, 0x09808683, 0x322bed48, 0x1e1170ac, 0x6c5a724e,
+    0xfd0efffb, 0x0f853856, 0x3daed51e, 0x362d3927, 0x0a0fd964, 0x685ca621, 0x9b5b54d1, 0x24362e3a,
+    0x0c0a67b1, 0x9357e70f, 0xb4ee96d2, 0x1b9b919e, 0x80c0c54f, 0x61dc20a2, 0x5a774b69, 0x1c121a16,
+    0xe293ba0a, 0xc0a02ae5, 0x3c22e043, 0x121b171d, 0x0e090d0b, 0xf28bc7ad, 0x2db6a8b9, 0x141ea9c8,
+    0x57f11985, 0xaf75074c, 0xee99ddbb, 0xa37f60fd, 0xf701269f, 0x5c72f5bc, 0x44663bc5, 0x5bfb7e34,
+    0x8b432976, 0xcb23c6dc, 0xb6edfc68, 0xb8e4f163, 0xd731dcca, 0x42638510, 0x13972240, 0x84c61120,
+    0x854a247d, 0xd2bb3df8, 0xaef93211, 0xc729a16d, 0x1d9e2f4b, 0xdcb230f3, 0x0d8652ec, 0x77c1e3d0,
+    0x2bb3166c, 0xa970b999, 0x119448fa, 0x47e96422, 0xa8fc8cc4, 0xa0f03f1a, 0x567d2cd8, 0x223390ef,
+    0x87494ec7, 0xd938d1c1, 0x8ccaa2fe, 0x98d40b36, 0xa6f581cf, 0xa57ade28, 0xdab78e26, 0x3fadbfa4,
+    0x2c3a9de4, 0x5078920d, 0x6a5fcc9b, 0x547e4662, 0xf68d13c2, 0x90d8b8e8, 0x2e39f75e, 0x82c3aff5,
+    0x9f5d80be, 0x69d0937c, 0x6fd52da9, 0xcf2512b3, 0xc8ac993b, 0x10187da7, 0xe89c636e, 0xdb3bbb7b,
+    0xcd267809, 0x6e5918f4, 0xec9ab701, 0x834f9aa8, 0xe6956e65, 0xaaffe67e, 0x21bccf08, 0xef15e8e6,
+    0xbae79bd9, 0x4a6f36ce, 0xea9f09d4, 0x29b07cd6, 0x31a4b2af, 0x2a3f2331, 0xc6a59430, 0x35a266c0,
+    0x744ebc37, 0xfc82caa6, 0xe090d0b0, 0x33a7d815, 0xf104984a, 0x41ecdaf7, 0x7fcd500e, 0x1791f62f,
+    0x764dd68d, 0x43efb04d, 0xccaa4d54, 0xe49604df, 0x9ed1b5e3, 0x4c6a881b, 0xc12c1fb8, 0x4665517f,
+    0x9d5eea04, 0x018c355d, 0xfa877473, 0xfb0b412e, 0xb3671d5a, 0x92dbd252, 0xe9105633, 0x6dd64713,
+    0x9ad7618c, 0x37a10c7a, 0x59f8148e, 0xeb133c89, 0xcea927ee, 0xb761c935, 0xe11ce5ed, 0x7a47b13c,
+    0x9cd2df59, 0x55f2733f, 0x1814ce79, 0x73c737bf, 0x53f7cdea, 0x5ffdaa5b, 0xdf3d6f14, 0x7844db86,
+    0xcaaff381, 0xb968c43e, 0x3824342c, 0xc2a3405f, 0x161dc372, 0xbce2250c, 0x283c498b, 0xff0d9541,
+    0x39a80171, 0x080cb3de, 0xd8b4e49c, 0x6456c190, 0x7bcb8461, 0xd532b670, 0x486c5c74, 0xd0b85742
+};
+
+static uint32_t pas_rar__aes_sub_word(uint32_t t)
+{
+    return ((uint32_t)pas_rar__aes_sbox[t >> 24] << 24) | ((uint32_t)pas_rar__aes_sbox[(t >> 16) & 0xff] << 16) |
+           ((uint32_t)pas_rar__aes_sbox[(t >> 8) & 0xff] << 8) | pas_rar__aes_sbox[t & 0xff];
+}
+
+/* AES-256 key schedule in decryption order: round keys last to first, all but the outer two
+   through InvMixColumns (Td0 of the S-box undoes the substitution) */
+static void pas_rar__aes_key(uint8_t round_keys[240], const uint8_t key[32])
+{
+    static const uint8_t rcon[7] = { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40 };
+    const uint32_t *td = pas_rar__aes_td;
+    const uint8_t *s = pas_rar__aes_sbox;
+    uint32_t w[60], t;
+    unsigned i, r;
+
+    for (i = 0; i < 8; i++) w[i] = pas_rar__u32be(key + 4 * i);
+    for (i = 8; i < 60; i++) {
+        t = w[i - 1];
+        if (i % 8 == 0)
+            t = pas_rar__aes_sub_word((t << 8) | (t >> 24)) ^ ((uint32_t)rcon[i / 8 - 1] << 24);
+        else if (i % 8 == 4)
+            t = pas_rar__aes_sub_word(t);
+        w[i] = w[i - 8] ^ t;
+    }
+    for (r = 0; r < 15; r++) {
+        for (i = 0; i < 4; i++) {
+            t = w[4 * (14 - r) + i];
+            if (r > 0 && r < 14)
+                t = td[s[t >> 24]] ^ PAS_RAR__ROTR32(td[s[(t >> 16) & 0xff]], 8) ^
+                    PAS_RAR__ROTR32(td[s[(t >> 8) & 0xff]], 16) ^ PAS_RAR__ROTR32(td[s[t & 0xff]], 24);
+            pas_rar__put32be(round_keys + 16 * r + 4 * i, t);
+        }
+    }
+}
+
+/* Decrypt blocks 16-byte CBC blocks from in to out (which may be in). iv is the ciphertext block
+   before in; it is left holding the last block of in. */
+static void pas_rar__aes_cbc_c(const uint8_t *round_keys, uint8_t iv[16], const uint8_t *in, uint8_t *out,
+                               size_t blocks)
+{
+    const uint32_t *td = pas_rar__aes_td;
+    const uint8_t *is = pas_rar__aes_inv_sbox;
+    uint32_t rk[60], s0, s1, s2, s3, t0, t1, t2, t3;
+    uint8_t c[16];
+    unsigned i, r;
+
+    for (i = 0; i < 60; i++) rk[i] = pas_rar__u32be(round_keys + 4 * i);
+    for (; blocks; blocks--, in += 16, out += 16) {
+        memcpy(c, in, 16);
+        s0 = pas_rar__u32be(c) ^ rk[0];
+        s1 = pas_rar__u32be(c + 4) ^ rk[1];
+        s2 = pas_rar__u32be(c + 8) ^ rk[2];
+        s3 = pas_rar__u32be(c + 12) ^ rk[3];
+        for (r = 1; r < 14; r++) {
+            const uint32_t *k = rk + 4 * r;
+            t0 = td[s0 >> 24] ^ PAS_RAR__ROTR32(td[(s3 >> 16) & 0xff], 8) ^
+                 PAS_RAR__ROTR32(td[(s2 >> 8) & 0xff], 16) ^ PAS_RAR__ROTR32(td[s1 & 0xff], 24) ^ k[0];
+            t1 = td[s1 >> 24] ^ PAS_RAR__ROTR32(td[(s0 >> 16) & 0xff], 8) ^
+                 PAS_RAR__ROTR32(td[(s3 >> 8) & 0xff], 16) ^ PAS_RAR__ROTR32(td[s2 & 0xff], 24) ^ k[1];
+            t2 = td[s2 >> 24] ^ PAS_RAR__ROTR32(td[(s1 >> 16) & 0xff], 8) ^
+                 PAS_RAR__ROTR32(td[(s0 >> 8) & 0xff], 16) ^ PAS_RAR__ROTR32(td[s3 & 0xff], 24) ^ k[2];
+            t3 = td[s3 >> 24] ^ PAS_RAR__ROTR32(td[(s2 >> 16) & 0xff], 8) ^
+                 PAS_RAR__ROTR32(td[(s1 >> 8) & 0xff], 16) ^ PAS_RAR__ROTR32(td[s0 & 0xff], 24) ^ k[3];
+            s0 = t0; s1 = t1; s2 = t2; s3 = t3;
+        }
+        t0 = ((uint32_t)is[s0 >> 24] << 24) ^ ((uint32_t)is[(s3 >> 16) & 0xff] << 16) ^
+             ((uint32_t)is[(s2 >> 8) & 0xff] << 8) ^ is[s1 & 0xff] ^ rk[56];
+        t1 = ((uint32_t)is[s1 >> 24] << 24) ^ ((uint32_t)is[(s0 >> 16) & 0xff] << 16) ^
+             ((uint32_t)is[(s3 >> 8) & 0xff] << 8) ^ is[s2 & 0xff] ^ rk[57];
+        t2 = ((uint32_t)is[s2 >> 24] << 24) ^ ((uint32_t)is[(s1 >> 16) & 0xff] << 16) ^
+             ((uint32_t)is[(s0 >> 8) & 0xff] << 8) ^ is[s3 & 0xff] ^ rk[58];
+        t3 = ((uint32_t)is[s3 >> 24] << 24) ^ ((uint32_t)is[(s2 >> 16) & 0xff] << 16) ^
+             ((uint32_t)is[(s1 >> 8) & 0xff] << 8) ^ is[s0 & 0xff] ^ rk[59];
+        pas_rar__put32be(out, t0 ^ pas_rar__u32be(iv));
+        pas_rar__put32be(out + 4, t1 ^ pas_rar__u32be(iv + 4));
+        pas_rar__put32be(out + 8, t2 ^ pas_rar__u32be(iv + 8));
+        pas_rar__put32be(out + 12, t3 ^ pas_rar__u32be(iv + 12));
+        memcpy(iv, c, 16);
+    }
+}
+
+#ifdef PAS_RAR_X86
+PAS_RAR_TARGET_AES
+static void pas_rar__aes_cbc_ni(const uint8_t *round_keys, uint8_t iv[16], const uint8_t *in, uint8_t *out,
+                                size_t blocks)
+{
+    __m128i k[15], c[8], x[8], prev = _mm_loadu_si128((const __m128i *)iv);
+    unsigned i, r;
+
+    for (r = 0; r < 15; r++) k[r] = _mm_loadu_si128((const __m128i *)(round_keys + 16 * r));
+    for (; blocks >= 8; blocks -= 8, in += 128, out += 128) {
+        for (i = 0; i < 8; i++) {
+            c[i] = _mm_loadu_si128((const __m128i *)(in + 16 * i));
+            x[i] = _mm_xor_si128(c[i], k[0]);
+        }
+        for (r = 1; r < 14; r++)
+            for (i = 0; i < 8; i++) x[i] = _mm_aesdec_si128(x[i], k[r]);
+        for (i = 0; i < 8; i++) x[i] = _mm_aesdeclast_si128(x[i], k[14]);
+        _mm_storeu_si128((__m128i *)out, _mm_xor_si128(x[0], prev));
+        for (i = 1; i < 8; i++) _mm_storeu_si128((__m128i *)(out + 16 * i), _mm_xor_si128(x[i], c[i - 1]));
+        prev = c[7];
+    }
+    for (; blocks; blocks--, in += 16, out += 16) {
+        __m128i b = _mm_loadu_si128((const __m128i *)in), y = _mm_xor_si128(b, k[0]);
+        for (r = 1; r < 14; r++) y = _mm_aesdec_si128(y, k[r]);
+        _mm_storeu_si128((__m128i *)out, _mm_xor_si128(_mm_aesdeclast_si128(y, k[14]), prev));
+        prev = b;
+    }
+    _mm_storeu_si128((__m128i *)iv, prev);
+}
+#endif
+
+static void pas_rar__aes_cbc(const uint8_t *round_keys, uint8_t iv[16], const uint8_t *in, uint8_t *out,
+                             size_t blocks)
+{
+#ifdef PAS_RAR_X86
+    if (pas_rar__cpu() & PAS_RAR__CPU_AES) {
+        pas_rar__aes_cbc_ni(round_keys, iv, in, out, blocks);
+        return;
+    }
+#endif
+    pas_rar__aes_cbc_c(round_keys, iv, in, out, blocks);
+}
+
+/* PBKDF2-HMAC-SHA256 of the password over k->salt (block 1), continued as unrar does: the sum after
+   2^lg2_count rounds is the AES key, 16 rounds later the MAC key, 16 more the check value (folded
+   to 8 bytes). Every round after the first hashes one 32-byte value, so the padded blocks are
+   built once and only the compressions run in the loop. */
+static void pas_rar__derive(const char *password, size_t len, pas_rar_key_t *k)
+{
+    pas_rar__hmac_t m;
+    uint32_t u[16], h[8], sum[8];
+    uint32_t rounds = ((uint32_t)1 << k->lg2_count) - 1, r;
+    uint8_t buf[32];
+    unsigned i, stage;
+
+    pas_rar__hmac_init(&m, (const uint8_t *)password, len);
+    {
+        uint8_t salt[20];
+        memcpy(salt, k->salt, 16);
+        salt[16] = salt[17] = salt[18] = 0;
+        salt[19] = 1;
+        pas_rar__hmac(&m, salt, 20, buf);
+    }
+    for (i = 0; i < 8; i++) u[i] = sum[i] = pas_rar__u32be(buf + 4 * i);
+    u[8] = 0x80000000u;
+    for (i = 9; i < 15; i++) u[i] = 0;
+    u[15] = (64 + 32) * 8;
+    for (stage = 0; stage < 3; stage++, rounds = 16) {
+        for (r = 0; r < rounds; r++) {
+            memcpy(h, m.inner, sizeof(h));
+            pas_rar__sha256_compress(h, u);
+            memcpy(u, h, sizeof(h));
+            memcpy(h, m.outer, sizeof(h));
+            pas_rar__sha256_compress(h, u);
+            for (i = 0; i < 8; i++) sum[i] ^= u[i] = h[i];
+        }
+        for (i = 0; i < 8; i++) pas_rar__put32be(buf + 4 * i, sum[i]);
+        if (stage == 0) {
+            pas_rar__aes_key(k->round_keys, buf);
+        } else if (stage == 1) {
+            memcpy(k->hash_key, buf, 32);
+        } else {
+            memset(k->check, 0, sizeof(k->check));
+            for (i = 0; i < 32; i++) k->check[i % 8] ^= buf[i];
+        }
+    }
+}
+
+/* Keys for salt and lg2_count: copied from a key slot, or derived into out. The slots are only
+   read here (pas_rar_set_password and pas_rar_derive_keys fill them), so entries of one archive
+   can be extracted from several threads. */
+static void pas_rar__key_get(const pas_rar_t *rar, const uint8_t salt[16], unsigned lg2_count, pas_rar_key_t *out)
+{
+    size_t i;
+
+    for (i = 0; i < rar->nkeys; i++) {
+        const pas_rar_key_t *k = &rar->keys[i];
+        if (k->used == 1 && k->lg2_count == lg2_count && memcmp(k->salt, salt, 16) == 0) {
+            *out = *k;
+            return;
+        }
+    }
+    memcpy(out->salt, salt, 16);
+    out->lg2_count = (uint8_t)lg2_count;
+    pas_rar__derive(rar->password, rar->password_len, out);
+    out->used = 1;
+}
+
+/* Checksum of an entry with PAS_RAR_CRYPT_MAC: HMAC-SHA256 keyed with hash_key of the CRC32
+   (little-endian), folded back to 32 bits, or of the BLAKE2sp digest */
+static uint32_t pas_rar__crc_mac(const uint8_t hash_key[32], uint32_t crc)
+{
+    pas_rar__hmac_t m;
+    uint8_t raw[4], d[32];
+    uint32_t r = 0;
+    unsigned i;
+
+    for (i = 0; i < 4; i++) raw[i] = (uint8_t)(crc >> (8 * i));
+    pas_rar__hmac_init(&m, hash_key, 32);
+    pas_rar__hmac(&m, raw, 4, d);
+    for (i = 0; i < 32; i++) r ^= (uint32_t)d[i] << ((i & 3) * 8);
+    return r;
+}
+
+static void pas_rar__blake2_mac(const uint8_t hash_key[32], uint8_t digest[32])
+{
+    pas_rar__hmac_t m;
+    pas_rar__hmac_init(&m, hash_key, 32);
+    pas_rar__hmac(&m, digest, 32, digest);
+}
+
+/* Encryption fields of a file encryption record (iv != NULL) or encryption header: version
+   (0: AES-256), flags (1: check value, 2: MAC checksums), lg2_count, salt, the file's IV, then the
+   check value and the first 4 bytes of its SHA-256. Returns PAS_RAR_CRYPT_* bits (a check value
+   failing its checksum is ignored, as unrar does), 0 for another version or corrupt fields. */
+static int pas_rar__read_crypt(const uint8_t *p, const uint8_t *end, uint8_t *lg2_count, uint8_t salt[16],
+                               uint8_t *iv, uint8_t check[8])
+{
+    uint64_t version = 0, flags = 0;
+    size_t len = 0;
+    int crypt = PAS_RAR_CRYPT_DATA;
+
+    if (!pas_rar__read_vint(p, end, &version, &len) || version != 0) return 0;
+    p += len;
+    if (!pas_rar__read_vint(p, end, &flags, &len)) return 0;
+    p += len;
+    if ((size_t)(end - p) < 17 + (iv ? 16u : 0u) + ((flags & 1) ? 12u : 0u)) return 0;
+    *lg2_count = *p++;
+    memcpy(salt, p, 16);
+    p += 16;
+    if (iv) {
+        memcpy(iv, p, 16);
+        p += 16;
+    }
+    if (flags & 1) {
+        pas_rar__sha256_t c;
+        uint8_t d[32];
+        pas_rar__sha256_init(&c);
+        pas_rar__sha256_update(&c, p, 8);
+        pas_rar__sha256_final(&c, d);
+        if (memcmp(d, p + 8, 4) == 0) {
+            memcpy(check, p, 8);
+            crypt |= PAS_RAR_CRYPT_CHECK;
+        }
+    }
+    if (flags & 2) crypt |= PAS_RAR_CRYPT_MAC;
+    return crypt;
+}
+
+/* Fields of the encryption header after the signature of data, as pas_rar__read_crypt; 0 when
+   there is none */
+static int pas_rar__head_crypt(const uint8_t *data, size_t size, uint8_t *lg2_count, uint8_t salt[16],
+                               uint8_t check[8])
+{
+    uint64_t type = 0;
+    size_t fields = 0, end = 0;
+
+    if (pas_rar__read_block5(data, size, 8, &type, NULL, NULL, NULL, &fields, &end, NULL) && type == 4)
+        return pas_rar__read_crypt(data + fields, data + end, lg2_count, salt, NULL, check);
+    return 0;
+}
+
+/* Key of the encrypted headers of an archive (rar or one of its volumes, data and size), from the
+   encryption header after the signature */
+static int pas_rar__head_key(const pas_rar_t *rar, const uint8_t *data, size_t size, pas_rar_key_t *key,
+                             pas_rar_status *status)
+{
+    uint8_t lg2_count = 0, salt[16], check[8];
+    int crypt = pas_rar__head_crypt(data, size, &lg2_count, salt, check);
+
+    if (!crypt || lg2_count > 24) {
+        *status = crypt ? PAS_RAR_E_UNSUPPORTED : PAS_RAR_E_INVALID;
+        return 0;
+    }
+    if (!rar->password) {
+        *status = PAS_RAR_E_PASSWORD;
+        return 0;
+    }
+    pas_rar__key_get(rar, salt, lg2_count, key);
+    if ((crypt & PAS_RAR_CRYPT_CHECK) && memcmp(key->check, check, 8) != 0) {
+        *status = PAS_RAR_E_PASSWORD;
+        return 0;
+    }
+    return 1;
+}
+
+/* Decrypt the header at off of an archive with encrypted headers into head: a 16-byte IV, then
+   the CRC32, size and fields padded to whole blocks. Returns the padded length (the data area
+   starts 16 + that past off), 0 if it is longer than cap, truncated or fails its CRC (a wrong
+   password or corruption). */
+static size_t pas_rar__decrypt_header(const uint8_t *data, size_t size, size_t off, const pas_rar_key_t *key,
+                                      uint8_t *head, size_t cap)
+{
+    uint8_t iv[16];
+    uint64_t hdr_size = 0;
+    size_t len = 0, total;
+
+    if (off > size || size - off < 32 || cap < 16) return 0;
+    memcpy(iv, data + off, 16);
+    pas_rar__aes_cbc(key->round_keys, iv, data + off + 16, head, 1);
+    if (!pas_rar__read_vint(head + 4, head + 16, &hdr_size, &len) || hdr_size > cap) return 0;
+    total = (4 + len + (size_t)hdr_size + 15) & ~(size_t)15;
+    if (total > cap || total > size - off - 16) return 0;
+    if (total > 16) pas_rar__aes_cbc(key->round_keys, iv, data + off + 32, head + 16, (total - 16) / 16);
+    if (pas_rar_crc32(0, head + 4, len + (size_t)hdr_size) != pas_rar__u32le(head)) return 0;
+    return total;
+}
+
 /* Skip main header if present; returns offset to start scanning for file headers. */
-static int pas_rar__init_scan4(pas_rar_status *status, size_t *out_scan_off)
+static int pas_rar__init_scan4(const pas_rar_t *rar, pas_rar_status *status, size_t *out_scan_off)
 {
-    const uint8_t *d = pas_rar__handle.data;
-    size_t sz = pas_rar__handle.size;
+    const uint8_t *d = rar->data;
+    size_t sz = rar->size;
     size_t off = 7; /* signature length for RAR4 is 7 */
     uint8_t type;
     uint16_t flags, hsize;
@@ -277,44 +1215,88 @@ static int pas_rar__init_scan4(pas_rar_status *status, size_t *out_scan_off)
     }
 }
 
-pas_rar_t *pas_rar_open(const void *data, size_t size, pas_rar_status *status)
+int pas_rar_open_ex(pas_rar_t *out, const void *data, size_t size, pas_rar_status *status)
 {
     static const uint8_t sig4[7] = { 'R','a','r','!',0x1A,0x07,0x00 };
     static const uint8_t sig5[8] = { 'R','a','r','!',0x1A,0x07,0x01,0x00 };
 
     if (status) *status = PAS_RAR_E_INVALID;
-    if (!data || size < 7) return NULL;
+    if (!out || !data || size < 7) return 0;
 
-    pas_rar__handle.data = (const uint8_t *)data;
-    pas_rar__handle.size = size;
-    pas_rar__handle.scan_offset = 0;
-    pas_rar__handle.format = 0;
+    out->data = (const uint8_t *)data;
+    out->size = size;
+    out->scan_offset = 0;
+    out->format = 0;
+    out->index = NULL;
+    out->index_slots = 0;
+    out->volumes = NULL;
+    out->nvolumes = 0;
+    out->verify = 0;
+    out->crypt_headers = 0;
+    out->password = NULL;
+    out->password_len = 0;
+    out->keys = NULL;
+    out->nkeys = 0;
 
     if (size >= 8 && pas_rar__memcmp(data, sig5, 8) == 0) {
-        pas_rar__handle.format = 5;
-        pas_rar__handle.scan_offset = 8; /* first block starts after 8-byte RAR5 signature */
+        uint64_t type = 0;
+        size_t end = 0;
+        out->format = 5;
+        out->scan_offset = 8; /* first block starts after 8-byte RAR5 signature */
+        /* An encryption header there (rar -hp): every later header is encrypted */
+        if (pas_rar__read_block5(out->data, size, 8, &type, NULL, NULL, NULL, NULL, &end, NULL) && type == 4) {
+            out->crypt_headers = 1;
+            out->scan_offset = end;
+        }
         if (status) *status = PAS_RAR_OK;
-        return &pas_rar__handle;
+        return 1;
     }
     if (pas_rar__memcmp(data, sig4, 7) != 0) {
         if (status) *status = PAS_RAR_E_INVALID;
-        return NULL;
+        return 0;
     }
 
-    pas_rar__handle.format = 4;
-    if (!pas_rar__init_scan4(status, &pas_rar__handle.scan_offset)) {
+    out->format = 4;
+    if (!pas_rar__init_scan4(out, status, &out->scan_offset)) {
         if (status) *status = PAS_RAR_E_INVALID;
-        return NULL;
+        return 0;
     }
 
     if (status) *status = PAS_RAR_OK;
+    return 1;
+}
+
+int pas_rar_open_volumes(pas_rar_t *out, const pas_rar_volume_t *volumes, size_t count,
+                         pas_rar_status *status)
+{
+    pas_rar_t view;
+    size_t i;
+
+    if (status) *status = PAS_RAR_E_INVALID;
+    if (!out || !volumes || !count || (uint64_t)count > UINT32_MAX) return 0;
+    for (i = 0; i < count; i++) {
+        if (!pas_rar_open_ex(i ? &view : out, volumes[i].data, volumes[i].size, status)) return 0;
+        if (i && view.format != out->format) {
+            if (status) *status = PAS_RAR_E_INVALID;
+            return 0;
+        }
+    }
+    out->volumes = volumes;
+    out->nvolumes = count;
+    return 1;
+}
+
+pas_rar_t *pas_rar_open(const void *data, size_t size, pas_rar_status *status)
+{
+    if (!pas_rar_open_ex(&pas_rar__handle, data, size, status)) return NULL;
     return &pas_rar__handle;
 }
 
-static int pas_rar__parse_file4(size_t off, pas_rar_file_t *out, size_t *out_next, pas_rar_status *status)
+static int pas_rar__parse_file4(const pas_rar_t *rar, size_t off, pas_rar_file_t *out, size_t *out_next,
+                                pas_rar_status *status)
 {
-    const uint8_t *d = pas_rar__handle.data;
-    size_t sz = pas_rar__handle.size;
+    const uint8_t *d = rar->data;
+    size_t sz = rar->size;
     uint8_t type;
     uint16_t flags, hsize;
     uint32_t add;
@@ -336,16 +1318,17 @@ static int pas_rar__parse_file4(size_t off, pas_rar_file_t *out, size_t *out_nex
         return 2; /* not a file, but valid header */
     }
 
-    /* RAR4 file header fixed fields start after base_len. */
-    if (off + base_len + 25 > sz) return 0;
+    /* RAR4 file header fixed fields start at PACK_SIZE, which doubles as the block's ADD_SIZE. */
+    (void)base_len;
+    if (hsize < 32 || off + 7 + 25 > sz) return 0;
     {
-        const uint8_t *p = d + off + base_len;
+        const uint8_t *p = d + off + 7;
         uint32_t pack_lo = pas_rar__u32le(p + 0);
         uint32_t unp_lo  = pas_rar__u32le(p + 4);
         /* uint8_t host_os = p[8]; */
-        /* uint32_t file_crc = pas_rar__u32le(p + 9); */
+        uint32_t file_crc = pas_rar__u32le(p + 9); /* of the packed part when split after */
         /* uint32_t ftime = pas_rar__u32le(p + 13); */
-        /* uint8_t unp_ver = p[17]; */
+        uint8_t unp_ver = p[17];
         uint8_t method = p[18];
         uint16_t name_len = pas_rar__u16le(p + 19);
         /* uint32_t attr = pas_rar__u32le(p + 21); */
@@ -355,20 +1338,19 @@ static int pas_rar__parse_file4(size_t off, pas_rar_file_t *out, size_t *out_nex
 
         /* If LARGE flag set, high sizes follow (8 bytes). */
         if ((flags & 0x0100u) != 0) {
-            if (off + base_len + 25 + 8 > sz) return 0;
+            if (off + 7 + 25 + 8 > sz) return 0;
             pack_hi = pas_rar__u32le(p + 25);
             unp_hi  = pas_rar__u32le(p + 29);
             extra_off += 8;
         }
 
-        /* Name follows; may be followed by optional unicode name data if flags indicate, but we keep the raw bytes. */
-        if (off + base_len + extra_off + (size_t)name_len > sz) return 0;
+        /* Name follows. With the UNICODE flag it is "ascii\0encoded"; the span stops at the NUL. */
+        if (off + 7 + extra_off + (size_t)name_len > sz) return 0;
 
         {
-            size_t copy = (size_t)name_len;
-            if (copy >= sizeof(pas_rar__name_buf)) copy = sizeof(pas_rar__name_buf) - 1;
-            memcpy(pas_rar__name_buf, p + extra_off, copy);
-            pas_rar__name_buf[copy] = '\0';
+            const uint8_t *nul = (const uint8_t *)memchr(p + extra_off, 0, name_len);
+            out->name_offset = off + 7 + extra_off;
+            out->name_len = nul ? (uint16_t)(nul - (p + extra_off)) : name_len;
         }
 
         {
@@ -376,24 +1358,29 @@ static int pas_rar__parse_file4(size_t off, pas_rar_file_t *out, size_t *out_nex
             uint64_t unpacked = ((uint64_t)unp_hi << 32) | (uint64_t)unp_lo;
             uint64_t data_off_u64 = (uint64_t)off + (uint64_t)hsize;
 
-            if (data_off_u64 > (uint64_t)UINT32_MAX) {
-                if (status) *status = PAS_RAR_E_RANGE;
-                return 0;
-            }
             if (data_off_u64 + packed > (uint64_t)sz) return 0;
 
-            /* If header didn't include ADD_SIZE, treat PACK_SIZE as the data chunk length for skipping. */
-            if ((flags & 0x8000u) == 0) {
-                uint64_t next = (uint64_t)off + (uint64_t)hsize + packed;
-                if (next > (uint64_t)sz) return 0;
-                *out_next = (size_t)next;
-            }
+            /* The data area is PACK_SIZE long, including HIGH_PACK_SIZE for large files. */
+            *out_next = (size_t)(data_off_u64 + packed);
 
-            out->name = pas_rar__name_buf;
+            out->name = NULL;
+            out->rar = rar;
             out->packed_size = packed;
             out->unpacked_size = unpacked;
             out->method = method;
-            out->data_offset = (uint32_t)data_off_u64;
+            out->unpack_version = unp_ver;
+            out->solid = (uint8_t)((flags & 0x0010u) != 0);
+            /* 0x01 / 0x02: continued from the previous volume / in the next */
+            out->split = (uint8_t)(flags & (PAS_RAR_SPLIT_BEFORE | PAS_RAR_SPLIT_AFTER));
+            out->volume = 0;
+            out->part_size = packed;
+            out->checks = PAS_RAR_CHECK_CRC32;
+            out->crc32 = file_crc;
+            out->header_offset = off;
+            out->crypt = (uint8_t)((flags & 0x0004u) ? PAS_RAR_CRYPT_DATA : 0);
+            /* Dictionary: flag bits 5..7 as 64 KB << n (7 marks a directory) */
+            out->dict_size = method == PAS_RAR_METHOD_STORE ? 0 : (uint64_t)0x10000 << ((flags >> 5) & 7);
+            out->data_offset = data_off_u64;
 
             if (status) *status = PAS_RAR_OK;
             return 1; /* file parsed */
@@ -401,50 +1388,125 @@ static int pas_rar__parse_file4(size_t off, pas_rar_file_t *out, size_t *out_nex
     }
 }
 
-static int pas_rar__iterate4(pas_rar_t *rar,
-                            const char *find_name,
-                            pas_rar_file_t *out,
-                            void (*cb)(const char *, uint64_t, void *),
-                            void *user)
+/* Bytes of volume vol (rar->data for a single buffer) */
+static const uint8_t *pas_rar__vol_data(const pas_rar_t *rar, uint32_t vol)
 {
-    size_t off;
-    int saw_any = 0;
+    return rar->nvolumes ? (const uint8_t *)rar->volumes[vol].data : rar->data;
+}
 
-    if (!rar || rar->format != 4) return 0;
-    off = rar->scan_offset;
-    if (off >= rar->size) return 0;
+static const uint8_t *pas_rar__name_ptr(const pas_rar_file_t *f)
+{
+    return pas_rar__vol_data(f->rar, f->volume) + f->name_offset;
+}
 
-    while (off + 7 <= rar->size) {
-        size_t next = off;
-        pas_rar_file_t f;
-        pas_rar_status st;
-        int r = pas_rar__parse_file4(off, &f, &next, &st);
-        if (r == 0) return 0;
-        if (next <= off) return 0;
-
-        if (r == 1) {
-            saw_any = 1;
-            if (cb) cb(f.name, f.unpacked_size, user);
-            if (find_name && strcmp(f.name, find_name) == 0) {
-                if (out) *out = f;
-                return 1;
-            }
-        }
+/* Key of the encrypted headers of f's volume */
+static int pas_rar__name_key(const pas_rar_file_t *f, pas_rar_key_t *key)
+{
+    const pas_rar_t *rar = f->rar;
+    size_t size = rar->nvolumes ? rar->volumes[f->volume].size : rar->size;
+    pas_rar_status st;
+    return pas_rar__head_key(rar, pas_rar__vol_data(rar, f->volume), size, key, &st);
+}
+
+/* Name bytes [at, at + n) of f, n <= 64. With PAS_RAR_CRYPT_HEADER they are decrypted with the
+   header key: CBC needs only the ciphertext block before each block, the header's IV for the first. */
+static void pas_rar__name_read(const pas_rar_file_t *f, const pas_rar_key_t *key, size_t at, uint8_t *dst,
+                               size_t n)
+{
+    const uint8_t *ct;
+    uint8_t iv[16], buf[80];
+    size_t pos, blk;
+
+    if (!(f->crypt & PAS_RAR_CRYPT_HEADER)) {
+        memcpy(dst, pas_rar__name_ptr(f) + at, n);
+        return;
+    }
+    ct = pas_rar__vol_data(f->rar, f->volume) + f->header_offset + 16;
+    pos = f->name_offset - (f->header_offset + 16) + at;
+    blk = pos & ~(size_t)15;
+    memcpy(iv, ct + blk - 16, 16);
+    pas_rar__aes_cbc(key->round_keys, iv, ct + blk, buf, (pos - blk + n + 15) / 16);
+    memcpy(dst, buf + (pos - blk), n);
+}
+
+/* Entry name is s (len bytes) exactly */
+static int pas_rar__name_is(const pas_rar_file_t *f, const char *s, size_t len)
+{
+    pas_rar_key_t key;
+    uint8_t buf[64];
+    size_t at, n;
+
+    if (len != f->name_len) return 0;
+    if (!(f->crypt & PAS_RAR_CRYPT_HEADER)) return memcmp(pas_rar__name_ptr(f), s, len) == 0;
+    if (!pas_rar__name_key(f, &key)) return 0;
+    for (at = 0; at < len; at += n) {
+        n = len - at < sizeof(buf) ? len - at : sizeof(buf);
+        pas_rar__name_read(f, &key, at, buf, n);
+        if (memcmp(buf, s + at, n) != 0) return 0;
+    }
+    return 1;
+}
+
+/* Entries a and b have the same name */
+static int pas_rar__name_same(const pas_rar_file_t *a, const pas_rar_file_t *b)
+{
+    pas_rar_key_t ka, kb;
+    uint8_t x[64], y[64];
+    size_t at, n;
+
+    if (a->name_len != b->name_len) return 0;
+    if (!((a->crypt | b->crypt) & PAS_RAR_CRYPT_HEADER))
+        return memcmp(pas_rar__name_ptr(a), pas_rar__name_ptr(b), a->name_len) == 0;
+    if (((a->crypt & PAS_RAR_CRYPT_HEADER) && !pas_rar__name_key(a, &ka)) ||
+        ((b->crypt & PAS_RAR_CRYPT_HEADER) && !pas_rar__name_key(b, &kb)))
+        return 0;
+    for (at = 0; at < a->name_len; at += n) {
+        n = a->name_len - at < sizeof(x) ? a->name_len - at : sizeof(x);
+        pas_rar__name_read(a, &ka, at, x, n);
+        pas_rar__name_read(b, &kb, at, y, n);
+        if (memcmp(x, y, n) != 0) return 0;
+    }
+    return 1;
+}
+
+/* Entry name matches find_name exactly */
+static int pas_rar__name_eq(const pas_rar_file_t *f, const char *find_name)
+{
+    return pas_rar__name_is(f, find_name, strlen(find_name));
+}
+
+/* NUL-terminated copy of the entry name for list callbacks, truncated to PAS_RAR_MAX_NAME - 1 */
+static const char *pas_rar__name_copy(const pas_rar_file_t *f, char *buf)
+{
+    pas_rar_name_copy(f, buf, PAS_RAR_MAX_NAME);
+    return buf;
+}
 
-        off = next;
+/* Next entry from the block header at *off: 1 with *out set and *off past the entry, 0 at the
+   end of the archive, -1 on a corrupt header */
+static int pas_rar__next4(const pas_rar_t *rar, size_t *off, pas_rar_file_t *out)
+{
+    while (*off + 7 <= rar->size) {
+        size_t next = *off;
+        pas_rar_status st;
+        int r = pas_rar__parse_file4(rar, *off, out, &next, &st);
+        if (r == 0 || next <= *off) return -1;
+        *off = next;
+        if (r == 1) return 1;
     }
-    return find_name ? 0 : (saw_any ? 1 : 1);
+    return 0;
 }
 
 /* ----- RAR5 iteration ----- */
 
-static int pas_rar__parse_file5(size_t file_hdr_off,
+/* File fields of the header in d, which ends at sz; the caller sets the data area fields */
+static int pas_rar__parse_file5(const uint8_t *d, size_t sz,
+                                size_t file_hdr_off,
+                                uint64_t block_flags,
                                 uint64_t extra_size,
                                 uint64_t data_size,
                                 pas_rar_file_t *out)
 {
-    const uint8_t *d = pas_rar__handle.data;
-    size_t sz = pas_rar__handle.size;
     const uint8_t *p = d + file_hdr_off;
     const uint8_t *end = d + sz;
     uint64_t file_flags = 0;
@@ -456,7 +1518,6 @@ static int pas_rar__parse_file5(size_t file_hdr_off,
     size_t len = 0;
     size_t header_data_end;
     size_t extra_start = 0;
-    int encrypted = 0;
     uint64_t val = 0;
 
     /* We rely on caller to ensure that file_hdr_off is within range and that
@@ -484,9 +1545,13 @@ static int pas_rar__parse_file5(size_t file_hdr_off,
         if (p + 4 > end) return 0;
         p += 4;
     }
-    /* Optional data CRC32 */
+    /* Optional data CRC32 (of the packed part when split after) */
+    out->checks = 0;
+    out->crypt = 0;
     if (file_flags & 0x0004u) {
         if (p + 4 > end) return 0;
+        out->checks = PAS_RAR_CHECK_CRC32;
+        out->crc32 = pas_rar__u32le(p);
         p += 4;
     }
 
@@ -500,15 +1565,10 @@ static int pas_rar__parse_file5(size_t file_hdr_off,
     /* Name length + name */
     if (!pas_rar__read_vint(p, end, &name_len, &len)) return 0;
     p += len;
-    if (name_len > (uint64_t)(end - p)) return 0;
-
-    {
-        size_t copy = (size_t)name_len;
-        if (copy >= sizeof(pas_rar__name_buf)) copy = sizeof(pas_rar__name_buf) - 1;
-        memcpy(pas_rar__name_buf, p, copy);
-        pas_rar__name_buf[copy] = '\0';
-        p += name_len;
-    }
+    if (name_len > (uint64_t)(end - p) || name_len > 0xFFFFu) return 0;
+    out->name_offset = (size_t)(p - d);
+    out->name_len = (uint16_t)name_len;
+    p += name_len;
 
     /* At this point, p points just after Name field. Extra area, if any, starts here
        and has size extra_size. Data area immediately follows extra area and has size data_size. */
@@ -518,7 +1578,7 @@ static int pas_rar__parse_file5(size_t file_hdr_off,
         if (header_data_end + exsz > sz) return 0;
         extra_start = header_data_end;
 
-        /* Scan extra area records for File encryption record (type 0x01). */
+        /* Scan extra area records for File encryption (type 0x01) and File hash (type 0x02). */
         {
             const uint8_t *ep = d + extra_start;
             const uint8_t *eend = ep + exsz;
@@ -527,173 +1587,3856 @@ static int pas_rar__parse_file5(size_t file_hdr_off,
                 size_t type_len = 0;
                 uint64_t rec_size = 0;
                 uint64_t rec_type = 0;
+                const uint8_t *rec_end;
 
                 if (!pas_rar__read_vint(ep, eend, &rec_size, &rec_len)) return 0;
                 ep += rec_len;
-                if (!pas_rar__read_vint(ep, eend, &rec_type, &type_len)) return 0;
-                if (rec_size < type_len) return 0;
+                /* Size counts Type + Data */
+                if (rec_size > (uint64_t)(eend - ep)) return 0;
+                rec_end = ep + (size_t)rec_size;
+                if (!pas_rar__read_vint(ep, rec_end, &rec_type, &type_len)) return 0;
+                ep += type_len;
 
                 if (rec_type == 0x01u) {
-                    encrypted = 1;
+                    /* An unknown version is reported by lg2_count 255 and fails on extraction */
+                    int crypt = pas_rar__read_crypt(ep, rec_end, &out->lg2_count, out->salt, out->iv,
+                                                    out->check);
+                    out->crypt = (uint8_t)(crypt ? crypt : PAS_RAR_CRYPT_DATA);
+                    if (!crypt) out->lg2_count = 255;
+                } else if (rec_type == 0x02u) {
+                    /* Hash type 0 is BLAKE2sp: 32 bytes. Others are not known. */
+                    uint64_t hash_type = 0;
+                    if (pas_rar__read_vint(ep, rec_end, &hash_type, &len) && hash_type == 0 &&
+                        (size_t)(rec_end - ep) >= len + 32) {
+                        memcpy(out->blake2, ep + len, 32);
+                        out->checks |= PAS_RAR_CHECK_BLAKE2;
+                    }
                 }
-
-                if (rec_size > (uint64_t)(eend - (ep - type_len))) return 0;
-                /* Skip the rest of this record (Type + Data) minus what we already consumed for Type. */
-                ep += (size_t)rec_size - type_len;
+                ep = rec_end;
             }
         }
     }
 
     /* Validate flags for minimal support:
        - No directory only entries.
-       - Unpacked size known (no 0x0008 flag).
-       - No encryption.
-       - Compression method == 0 (no compression). */
+       - Unpacked size known (no 0x0008 flag). */
     if (file_flags & 0x0001u) return 2; /* directory: skip */
     if (file_flags & 0x0008u) return 2; /* unknown unpacked size: skip */
-    if (encrypted) return 2;           /* encrypted: unsupported */
 
+    /* Compression information: 0x003f = version, 0x0040 = solid, 0x0380 = method,
+       0x3c00 = dictionary size as 128 KB << n. Version 0 is RAR 5.0; 1 (RAR 7) is reported as
+       unpack_version 70 and rejected on extraction. */
     {
-        uint64_t method_bits = (comp_info & 0x0380u) >> 7; /* see spec: 0x003f=version, 0x0040=solid, 0x0380=method */
-        if (method_bits != 0) return 2; /* compressed: unsupported */
+        uint64_t method_bits = (comp_info & 0x0380u) >> 7;
+        out->method = (uint8_t)(PAS_RAR_METHOD_STORE + method_bits);
+        out->unpack_version = (uint8_t)((comp_info & 0x003fu) == 0 ? 50 : 70);
+        out->solid = (uint8_t)((comp_info & 0x0040u) != 0);
+        out->dict_size = method_bits ? (uint64_t)0x20000 << ((comp_info >> 10) & 0x0fu) : 0;
     }
 
-    /* For uncompressed data, data_size must match uncompressed size. */
-    if (unp_size != data_size) return 0;
-
-    /* Compute data offset: header_data_end + extra_size. */
-    {
-        uint64_t data_off_u64 = (uint64_t)header_data_end + extra_size;
-        if (data_off_u64 + data_size > (uint64_t)sz) return 0;
-        if (data_off_u64 > (uint64_t)UINT32_MAX) return 0;
+    /* Block flags 0x0008 / 0x0010: data continued from the previous volume / in the next */
+    out->split = (uint8_t)(((block_flags & 0x0008u) ? PAS_RAR_SPLIT_BEFORE : 0) |
+                           ((block_flags & 0x0010u) ? PAS_RAR_SPLIT_AFTER : 0));
 
-        out->name = pas_rar__name_buf;
-        out->packed_size = data_size;
-        out->unpacked_size = unp_size;
-        out->method = PAS_RAR_METHOD_STORE; /* unify: store for RAR4 and RAR5 */
-        out->data_offset = (uint32_t)data_off_u64;
-    }
+    /* For uncompressed data, data_size must match uncompressed size (a split entry: all parts);
+       encrypted data is padded to whole AES blocks. */
+    if (out->method == PAS_RAR_METHOD_STORE && !out->split &&
+        (out->crypt ? data_size < unp_size || data_size - unp_size > 15 : unp_size != data_size))
+        return 0;
 
+    out->unpacked_size = unp_size;
     return 1;
 }
 
-static int pas_rar__iterate5(pas_rar_t *rar,
-                             const char *find_name,
-                             pas_rar_file_t *out,
-                             void (*cb)(const char *, uint64_t, void *),
-                             void *user)
+/* Next entry from the block header at *off, as pas_rar__next4. With encrypted headers each header
+   is decrypted onto the stack and parsed there; name_offset is then the offset of the name's
+   ciphertext (PAS_RAR_CRYPT_HEADER). */
+static int pas_rar__next5(const pas_rar_t *rar, size_t *off, pas_rar_file_t *out)
 {
-    size_t off;
-    int saw_any = 0;
+    uint8_t head[PAS_RAR_MAX_HEADER];
+    pas_rar_key_t key;
+    pas_rar_status st;
 
-    if (!rar || rar->format != 5) return 0;
-    off = rar->scan_offset;
-    if (off >= rar->size) return 0;
-
-    while (off + 6 <= rar->size) {
+    if (rar->crypt_headers && !pas_rar__head_key(rar, rar->data, rar->size, &key, &st)) return -1;
+    while (*off + 6 <= rar->size) {
         uint64_t type = 0, flags = 0, extra_size = 0, data_size = 0;
         size_t file_hdr_off = 0;
         size_t hdr_end_off = 0;
-        size_t next_off = 0;
+        size_t data_off, header_off = *off;
+        const uint8_t *d = rar->data;
+        size_t size = rar->size, at = *off;
 
-        if (!pas_rar__read_block5(rar->data, rar->size, off,
+        if (rar->crypt_headers) {
+            size = pas_rar__decrypt_header(rar->data, rar->size, *off, &key, head, sizeof(head));
+            if (!size) return -1;
+            d = head;
+            at = 0;
+        }
+        if (!pas_rar__read_block5(d, size, at,
                                   &type, &flags, &extra_size, &data_size,
-                                  &file_hdr_off, &hdr_end_off, &next_off))
-            return 0;
-        if (next_off <= off) return 0;
+                                  &file_hdr_off, &hdr_end_off, NULL))
+            return -1;
+        data_off = rar->crypt_headers ? *off + 16 + size : hdr_end_off;
+        if (data_size > (uint64_t)(rar->size - data_off)) return -1;
 
         if (type == 5) { /* End of archive */
-            break;
+            return 0;
         }
 
-        /* Archive encryption header means we cannot process this archive. */
+        /* An encryption header belongs right after the signature (pas_rar_open_ex skips it) */
         if (type == 4) {
-            return 0;
+            return -1;
         }
 
+        *off = data_off + (size_t)data_size;
         if (type == 2) { /* File header */
-            pas_rar_file_t f;
-            int r = pas_rar__parse_file5(file_hdr_off, extra_size, data_size, &f);
-            if (r == 0) return 0;
+            int r = pas_rar__parse_file5(d, hdr_end_off, file_hdr_off, flags, extra_size, data_size, out);
+            if (r == 0) return -1;
             if (r == 1) {
-                saw_any = 1;
-                if (cb) cb(f.name, f.unpacked_size, user);
-                if (find_name && strcmp(f.name, find_name) == 0) {
-                    if (out) *out = f;
-                    return 1;
+                out->name = NULL;
+                out->rar = rar;
+                out->packed_size = data_size;
+                out->data_offset = data_off;
+                out->volume = 0;
+                out->part_size = data_size;
+                out->header_offset = header_off;
+                if (rar->crypt_headers) {
+                    out->crypt |= PAS_RAR_CRYPT_HEADER;
+                    out->name_offset += header_off + 16;
                 }
+                return 1;
             }
             /* r==2: entry skipped, continue */
         }
+    }
+    return 0;
+}
+
+/* Next file header of one buffer, split parts included */
+static int pas_rar__next_header(const pas_rar_t *rar, size_t *off, pas_rar_file_t *out)
+{
+    if (rar->format == 4) return pas_rar__next4(rar, off, out);
+    if (rar->format == 5) return pas_rar__next5(rar, off, out);
+    return -1;
+}
+
+/* ----- Volumes ----- */
+
+/* Volume vol as an archive of its own; pas_rar_open_volumes already checked its headers */
+static int pas_rar__volume_view(const pas_rar_t *rar, uint32_t vol, pas_rar_t *view)
+{
+    if (!rar->nvolumes) {
+        *view = *rar;
+        return vol == 0;
+    }
+    if (vol >= rar->nvolumes || !pas_rar_open_ex(view, rar->volumes[vol].data, rar->volumes[vol].size, NULL))
+        return 0;
+    view->password = rar->password;
+    view->password_len = rar->password_len;
+    view->keys = rar->keys;
+    view->nkeys = rar->nkeys;
+    return 1;
+}
+
+/* Packed data part after the one in volume *vol: the first file header of the next volume, which
+   must carry on from the volume before. 1 with *part set (volume, data_offset, part_size, split)
+   and *vol moved to it; 0 when that volume is missing or starts with another entry. */
+static int pas_rar__next_part(const pas_rar_t *rar, uint32_t *vol, pas_rar_file_t *part)
+{
+    pas_rar_t view;
+    size_t off;
+
+    if (*vol + 1 >= rar->nvolumes || !pas_rar__volume_view(rar, *vol + 1, &view)) return 0;
+    off = view.scan_offset;
+    if (pas_rar__next_header(&view, &off, part) != 1 || !(part->split & PAS_RAR_SPLIT_BEFORE)) return 0;
+    part->rar = rar;
+    part->volume = ++*vol;
+    return 1;
+}
+
+/* Add the parts of an entry split over volumes to its packed_size, up to the last one or the first
+   missing (or differently named) part; extraction then finds the data incomplete. The checksums are
+   taken from the last part found. */
+static void pas_rar__join_parts(pas_rar_file_t *f)
+{
+    pas_rar_file_t part;
+    uint32_t vol = f->volume;
+
+    part.split = f->split;
+    while ((part.split & PAS_RAR_SPLIT_AFTER) && pas_rar__next_part(f->rar, &vol, &part) &&
+           pas_rar__name_same(&part, f)) {
+        f->packed_size += part.part_size;
+        /* Only the last part's header has the checksums of the whole unpacked data */
+        f->checks = part.checks;
+        f->crc32 = part.crc32;
+        memcpy(f->blake2, part.blake2, sizeof(f->blake2));
+    }
+}
+
+/* The packed data of file is all there: its first part inside its volume and, when split, every
+   later part present and adding up to packed_size */
+static int pas_rar__data_ok(const pas_rar_file_t *file)
+{
+    const pas_rar_t *rar = file->rar;
+    pas_rar_file_t part;
+    uint32_t vol = file->volume;
+    uint64_t total = file->part_size;
+    size_t size = rar->nvolumes ? (vol < rar->nvolumes ? rar->volumes[vol].size : 0) : (vol ? 0 : rar->size);
+
+    if ((uint64_t)file->data_offset + file->part_size > (uint64_t)size) return 0;
+    part.split = file->split;
+    while (part.split & PAS_RAR_SPLIT_AFTER) {
+        if (!pas_rar__next_part(rar, &vol, &part)) return 0;
+        total += part.part_size;
+    }
+    return total == file->packed_size;
+}
+
+/* Next entry at the cursor (*vol, *off): 1 with *out set, 0 past the last volume, -1 on a corrupt
+   header. *off 0 starts volume *vol after its main header. Parts carried on from an earlier volume
+   are skipped; a split entry is reported once, with the packed size of all its parts. */
+static int pas_rar__next_entry(const pas_rar_t *rar, uint32_t *vol, size_t *off, pas_rar_file_t *out)
+{
+    pas_rar_t view;
+    int r;
+
+    for (;;) {
+        if (!pas_rar__volume_view(rar, *vol, &view)) return -1;
+        if (!*off) *off = view.scan_offset;
+        r = pas_rar__next_header(&view, off, out);
+        if (r < 0) return -1;
+        if (r == 0) {
+            if (*vol + 1 >= rar->nvolumes) return 0;
+            ++*vol;
+            *off = 0;
+            continue;
+        }
+        if (out->split & PAS_RAR_SPLIT_BEFORE) continue;
+        out->rar = rar;
+        out->volume = *vol;
+        pas_rar__join_parts(out);
+        return 1;
+    }
+}
+
+/* Walk the file headers: stops at find_name (returns 1 with *out set) or calls visit for every
+   entry; a non-zero return from visit aborts the walk (returns 0). */
+typedef int (*pas_rar__visit_fn)(const pas_rar_file_t *f, void *ctx);
+
+static int pas_rar__iterate(const pas_rar_t *rar,
+                            const char *find_name,
+                            pas_rar_file_t *out,
+                            pas_rar__visit_fn visit,
+                            void *ctx)
+{
+    size_t off;
+    uint32_t vol = 0;
+    pas_rar_file_t f;
+    int r;
+
+    if (!rar || rar->scan_offset >= rar->size) return 0;
+    off = rar->scan_offset;
+    while ((r = pas_rar__next_entry(rar, &vol, &off, &f)) == 1) {
+        if (visit && visit(&f, ctx)) return 0;
+        if (find_name && pas_rar__name_eq(&f, find_name)) {
+            if (out) *out = f;
+            return 1;
+        }
+    }
+    return r == 0 && !find_name;
+}
+
+static int pas_rar__walk(const pas_rar_t *rar, pas_rar__visit_fn visit, void *ctx)
+{
+    return pas_rar__iterate(rar, NULL, NULL, visit, ctx);
+}
+
+/* ----- Entry table -----
+   FNV-1a name hash, open addressing with linear probing. Each used slot holds a full entry, so a
+   lookup is one probe sequence and a name compare; the header chain is not touched again. */
+
+static uint32_t pas_rar__hash_update(uint32_t h, const uint8_t *s, size_t len)
+{
+    while (len--) {
+        h ^= *s++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static uint32_t pas_rar__hash(const uint8_t *s, size_t len)
+{
+    return pas_rar__hash_update(2166136261u, s, len);
+}
+
+/* pas_rar__hash of the entry name, decrypted a chunk at a time with encrypted headers */
+static uint32_t pas_rar__name_hash(const pas_rar_file_t *f)
+{
+    pas_rar_key_t key;
+    uint8_t buf[64];
+    uint32_t h = 2166136261u;
+    size_t at, n;
+
+    if (!(f->crypt & PAS_RAR_CRYPT_HEADER)) return pas_rar__hash(pas_rar__name_ptr(f), f->name_len);
+    if (!pas_rar__name_key(f, &key)) return h;
+    for (at = 0; at < f->name_len; at += n) {
+        n = f->name_len - at < sizeof(buf) ? f->name_len - at : sizeof(buf);
+        pas_rar__name_read(f, &key, at, buf, n);
+        h = pas_rar__hash_update(h, buf, n);
+    }
+    return h;
+}
+
+static int pas_rar__count_visit(const pas_rar_file_t *f, void *ctx)
+{
+    (void)f;
+    ++*(size_t *)ctx;
+    return 0;
+}
+
+size_t pas_rar_index_capacity(const pas_rar_t *rar)
+{
+    size_t count = 0, slots = 16;
+    if (!rar || !pas_rar__walk(rar, pas_rar__count_visit, &count)) return 0;
+    while (slots < count * 2) slots <<= 1;
+    return slots;
+}
+
+typedef struct {
+    pas_rar_index_slot_t *table;
+    size_t                mask;
+    size_t                count;
+} pas_rar__index_ctx;
+
+static int pas_rar__index_visit(const pas_rar_file_t *f, void *ctx)
+{
+    pas_rar__index_ctx *c = (pas_rar__index_ctx *)ctx;
+    uint32_t h = pas_rar__name_hash(f);
+    size_t i;
+
+    /* Keep the first entry for duplicate names, matching the linear scan. */
+    for (i = h & c->mask; c->table[i].used; i = (i + 1) & c->mask) {
+        const pas_rar_file_t *e = &c->table[i].file;
+        if (c->table[i].hash == h && pas_rar__name_same(e, f))
+            return 0;
+    }
+    if (++c->count > (c->mask + 1) / 2) return 1; /* keep the load factor at 1/2 */
+    c->table[i].hash = h;
+    c->table[i].used = 1;
+    c->table[i].file = *f;
+    return 0;
+}
+
+int pas_rar_index_build(pas_rar_t *rar, pas_rar_index_slot_t *table, size_t capacity, pas_rar_status *status)
+{
+    pas_rar__index_ctx c;
+    size_t slots = 16;
+
+    if (status) *status = PAS_RAR_E_INVALID;
+    if (!rar || !table) return 0;
+    rar->index = NULL;
+    rar->index_slots = 0;
+    if (capacity < slots) {
+        if (status) *status = PAS_RAR_E_NOSPACE;
+        return 0;
+    }
+    while (slots <= capacity / 2) slots <<= 1;
+    memset(table, 0, slots * sizeof(*table));
+    c.table = table;
+    c.mask = slots - 1;
+    c.count = 0;
+
+    if (!pas_rar__walk(rar, pas_rar__index_visit, &c)) {
+        if (status && c.count > slots / 2) *status = PAS_RAR_E_NOSPACE;
+        return 0;
+    }
+    rar->index = table;
+    rar->index_slots = slots;
+    if (status) *status = PAS_RAR_OK;
+    return 1;
+}
 
-        off = next_off;
+static int pas_rar__find_indexed(const pas_rar_t *rar, const char *name, pas_rar_file_t *out)
+{
+    size_t len = strlen(name), mask = rar->index_slots - 1, i;
+    uint32_t h = pas_rar__hash((const uint8_t *)name, len);
+
+    for (i = h & mask; rar->index[i].used; i = (i + 1) & mask) {
+        pas_rar_file_t e;
+        if (rar->index[i].hash != h || rar->index[i].file.name_len != len) continue;
+        e = rar->index[i].file;
+        e.rar = rar;
+        if (!pas_rar__name_is(&e, name, len)) continue;
+        *out = e;
+        return 1;
     }
+    return 0;
+}
 
-    return find_name ? 0 : (saw_any ? 1 : 1);
+int pas_rar_find_ex(const pas_rar_t *rar, const char *name, pas_rar_file_t *out)
+{
+    if (!rar || !name || !out) return 0;
+    if (rar->index) return pas_rar__find_indexed(rar, name, out);
+    return pas_rar__iterate(rar, name, out, NULL, NULL);
 }
 
 pas_rar_file_t *pas_rar_find(pas_rar_t *rar, const char *name)
 {
     pas_rar_file_t ent;
-    if (!rar || !name) return NULL;
-    if (rar->format == 4) {
-        if (!pas_rar__iterate4(rar, name, &ent, NULL, NULL)) return NULL;
-    } else if (rar->format == 5) {
-        if (!pas_rar__iterate5(rar, name, &ent, NULL, NULL)) return NULL;
-    } else {
-        return NULL;
-    }
+    if (!pas_rar_find_ex(rar, name, &ent)) return NULL;
     pas_rar__current_file = ent;
+    pas_rar__current_file.name = pas_rar__name_copy(&ent, pas_rar__name_buf);
     return &pas_rar__current_file;
 }
 
 const char *pas_rar_name(pas_rar_file_t *file) { return file ? file->name : NULL; }
+const char *pas_rar_name_span(const pas_rar_file_t *file, size_t *len)
+{
+    if (!file || !file->rar) {
+        if (len) *len = 0;
+        return NULL;
+    }
+    if (file->crypt & PAS_RAR_CRYPT_HEADER) {
+        if (len) *len = 0;
+        return NULL;
+    }
+    if (len) *len = file->name_len;
+    return (const char *)pas_rar__name_ptr(file);
+}
+
+size_t pas_rar_name_copy(const pas_rar_file_t *file, char *buf, size_t size)
+{
+    pas_rar_key_t key;
+    size_t copy, at, n;
+
+    if (!buf || !size) return 0;
+    copy = file && file->rar ? file->name_len : 0;
+    if (copy >= size) copy = size - 1;
+    if (copy && !(file->crypt & PAS_RAR_CRYPT_HEADER)) {
+        memcpy(buf, pas_rar__name_ptr(file), copy);
+    } else if (copy && !pas_rar__name_key(file, &key)) {
+        copy = 0;
+    } else {
+        for (at = 0; at < copy; at += n) {
+            n = copy - at < 64 ? copy - at : 64;
+            pas_rar__name_read(file, &key, at, (uint8_t *)buf + at, n);
+        }
+    }
+    buf[copy] = '\0';
+    return copy;
+}
+
 uint64_t pas_rar_size(pas_rar_file_t *file) { return file ? file->unpacked_size : 0; }
 uint64_t pas_rar_packed_size(pas_rar_file_t *file) { return file ? file->packed_size : 0; }
 int pas_rar_is_compressed(pas_rar_file_t *file) { return file && file->method != PAS_RAR_METHOD_STORE; }
 
-size_t pas_rar_extract(pas_rar_file_t *file, void *buffer, size_t buffer_size, pas_rar_status *status)
+/* ----- Passwords -----
+   Keys are derived once per salt and kept in the caller's key slots. PBKDF2 is a chain of
+   dependent hashes, so one salt's keys cannot be split; pas_rar_derive_keys runs different salts
+   on worker threads. pas_rar__run_workers(fn, arg, count) calls fn(arg, w) for w = 0..count-1,
+   worker 0 on the calling thread; workers whose thread cannot be created run inline after it. */
+
+#ifdef PAS_RAR_USE_THREADS
+typedef struct {
+    void (*fn)(void *arg, int worker);
+    void *arg;
+    int worker;
+} pas_rar__worker_t;
+
+#if defined(_WIN32) || defined(_WIN64)
+static DWORD WINAPI pas_rar__worker_entry(LPVOID p) {
+    pas_rar__worker_t *w = (pas_rar__worker_t *)p;
+    w->fn(w->arg, w->worker);
+    return 0;
+}
+static int pas_rar__thread_start(pas_rar__thread_t *t, pas_rar__worker_t *w) {
+    *t = CreateThread(NULL, 0, pas_rar__worker_entry, w, 0, NULL);
+    return *t != NULL;
+}
+static void pas_rar__thread_join(pas_rar__thread_t t) {
+    WaitForSingleObject(t, INFINITE);
+    CloseHandle(t);
+}
+#else
+static void *pas_rar__worker_entry(void *p) {
+    pas_rar__worker_t *w = (pas_rar__worker_t *)p;
+    w->fn(w->arg, w->worker);
+    return NULL;
+}
+static int pas_rar__thread_start(pas_rar__thread_t *t, pas_rar__worker_t *w) {
+    return pthread_create(t, NULL, pas_rar__worker_entry, w) == 0;
+}
+static void pas_rar__thread_join(pas_rar__thread_t t) {
+    pthread_join(t, NULL);
+}
+#endif
+#endif /* PAS_RAR_USE_THREADS */
+
+static void pas_rar__run_workers(void (*fn)(void *arg, int worker), void *arg, int count) {
+#ifdef PAS_RAR_USE_THREADS
+    pas_rar__thread_t threads[PAS_RAR_MAX_THREADS];
+    pas_rar__worker_t workers[PAS_RAR_MAX_THREADS];
+    int started[PAS_RAR_MAX_THREADS];
+    int i;
+
+    if (count > PAS_RAR_MAX_THREADS) count = PAS_RAR_MAX_THREADS;
+    for (i = 1; i < count; i++) {
+        workers[i].fn = fn;
+        workers[i].arg = arg;
+        workers[i].worker = i;
+        started[i] = pas_rar__thread_start(&threads[i], &workers[i]);
+    }
+    fn(arg, 0);
+    for (i = 1; i < count; i++) {
+        if (started[i]) pas_rar__thread_join(threads[i]);
+        else fn(arg, i);
+    }
+#else
+    int i;
+    for (i = 0; i < count; i++) fn(arg, i);
+#endif
+}
+
+int pas_rar_set_password(pas_rar_t *rar, const char *password, size_t password_len,
+                         pas_rar_key_t *keys, size_t count, pas_rar_status *status)
 {
-    const uint8_t *d = pas_rar__handle.data;
-    size_t sz = pas_rar__handle.size;
+    uint8_t head[PAS_RAR_MAX_HEADER];
+    pas_rar_key_t key;
+    pas_rar_status st = PAS_RAR_OK;
 
     if (status) *status = PAS_RAR_E_INVALID;
-    if (!file || !buffer) return 0;
+    if (!rar || (count && !keys)) return 0;
+    if (count) memset(keys, 0, count * sizeof(*keys));
+    rar->password = password;
+    rar->password_len = password ? password_len : 0;
+    rar->keys = count ? keys : NULL;
+    rar->nkeys = count;
+
+    /* The header key goes to slot 0: every header walk needs it */
+    if (password && rar->crypt_headers) {
+        if (!count)
+            st = PAS_RAR_E_NOSPACE;
+        else if (pas_rar__head_key(rar, rar->data, rar->size, &key, &st) &&
+                 !pas_rar__decrypt_header(rar->data, rar->size, rar->scan_offset, &key, head, sizeof(head)))
+            st = PAS_RAR_E_PASSWORD;
+        if (st != PAS_RAR_OK) {
+            rar->password = NULL;
+            rar->password_len = 0;
+            if (status) *status = st;
+            return 0;
+        }
+        keys[0] = key;
+    }
+    if (status) *status = PAS_RAR_OK;
+    return 1;
+}
 
-    if (file->method != PAS_RAR_METHOD_STORE) {
-        if (status) *status = PAS_RAR_E_COMPRESSED;
+typedef struct {
+    const pas_rar_t *rar;
+    size_t           pending;  /* slots with used == 2: salt set, keys not derived yet */
+    int              workers;
+    int              full;
+} pas_rar__derive_ctx;
+
+/* Queue salt in a free slot unless one has it already. 0 (and c->full set) when none is free. */
+static int pas_rar__derive_add(pas_rar__derive_ctx *c, const uint8_t salt[16], uint8_t lg2_count)
+{
+    const pas_rar_t *rar = c->rar;
+    size_t i, slot = rar->nkeys;
+
+    for (i = 0; i < rar->nkeys; i++) {
+        const pas_rar_key_t *k = &rar->keys[i];
+        if (k->used && k->lg2_count == lg2_count && memcmp(k->salt, salt, 16) == 0) return 1;
+        if (!k->used && slot == rar->nkeys) slot = i;
+    }
+    if (slot == rar->nkeys) {
+        c->full = 1;
         return 0;
     }
-    if (file->packed_size != file->unpacked_size) {
-        if (status) *status = PAS_RAR_E_INVALID;
+    memcpy(rar->keys[slot].salt, salt, 16);
+    rar->keys[slot].lg2_count = lg2_count;
+    rar->keys[slot].used = 2;
+    c->pending++;
+    return 1;
+}
+
+static int pas_rar__derive_visit(const pas_rar_file_t *f, void *ctx)
+{
+    if (!(f->crypt & PAS_RAR_CRYPT_DATA) || f->lg2_count > 24) return 0;
+    return !pas_rar__derive_add((pas_rar__derive_ctx *)ctx, f->salt, f->lg2_count);
+}
+
+/* The pending slots are dealt out round-robin; used is only read here, so workers see the same
+   list */
+static void pas_rar__derive_worker(void *arg, int worker)
+{
+    pas_rar__derive_ctx *c = (pas_rar__derive_ctx *)arg;
+    const pas_rar_t *rar = c->rar;
+    size_t i, n = 0;
+
+    for (i = 0; i < rar->nkeys; i++) {
+        if (rar->keys[i].used != 2) continue;
+        if (n++ % (size_t)c->workers == (size_t)worker)
+            pas_rar__derive(rar->password, rar->password_len, &rar->keys[i]);
+    }
+}
+
+/* Derive the pending slots and mark them ready */
+static void pas_rar__derive_pending(pas_rar__derive_ctx *c, int thread_count)
+{
+    const pas_rar_t *rar = c->rar;
+    size_t i;
+
+    if (thread_count < 1) thread_count = 1;
+    if (thread_count > PAS_RAR_MAX_THREADS) thread_count = PAS_RAR_MAX_THREADS;
+    if ((size_t)thread_count > c->pending) thread_count = (int)c->pending;
+    c->workers = thread_count;
+    if (c->pending) pas_rar__run_workers(pas_rar__derive_worker, c, thread_count);
+    for (i = 0; i < rar->nkeys; i++)
+        if (rar->keys[i].used == 2) rar->keys[i].used = 1;
+    c->pending = 0;
+}
+
+int pas_rar_derive_keys(pas_rar_t *rar, int thread_count, pas_rar_status *status)
+{
+    pas_rar__derive_ctx c;
+    pas_rar_t view;
+    uint32_t vol;
+    size_t i;
+
+    if (status) *status = PAS_RAR_E_INVALID;
+    if (!rar) return 0;
+    if (!rar->password) {
+        if (status) *status = PAS_RAR_E_PASSWORD;
         return 0;
     }
-    if (file->unpacked_size > (uint64_t)SIZE_MAX) {
-        if (status) *status = PAS_RAR_E_RANGE;
+    c.rar = rar;
+    c.pending = 0;
+    c.full = 0;
+
+    /* Header salts first: each volume's headers are decrypted on every header walk, the one
+       below included */
+    for (vol = 0; !c.full && pas_rar__volume_view(rar, vol, &view); vol++) {
+        uint8_t lg2_count = 0, salt[16], check[8];
+        if (view.crypt_headers && pas_rar__head_crypt(view.data, view.size, &lg2_count, salt, check) &&
+            lg2_count <= 24)
+            (void)pas_rar__derive_add(&c, salt, lg2_count);
+    }
+    pas_rar__derive_pending(&c, thread_count);
+
+    if (!pas_rar__walk(rar, pas_rar__derive_visit, &c) && !c.full) {
+        for (i = 0; i < rar->nkeys; i++)
+            if (rar->keys[i].used == 2) rar->keys[i].used = 0;
         return 0;
     }
-    if (buffer_size < (size_t)file->unpacked_size) {
+    pas_rar__derive_pending(&c, thread_count);
+    if (c.full) {
         if (status) *status = PAS_RAR_E_NOSPACE;
         return 0;
     }
-    if ((uint64_t)file->data_offset + file->packed_size > (uint64_t)sz) {
-        if (status) *status = PAS_RAR_E_INVALID;
-        return 0;
+    if (status) *status = PAS_RAR_OK;
+    return 1;
+}
+
+/* ----- Checksums -----
+   CRC32 (RAR4 file CRC, RAR5 data CRC, RAR3 filter programs): slice-by-16 tables for the portable
+   path; on x86 with PCLMULQDQ (checked at runtime) blocks of 64+ bytes are folded with carry-less
+   multiplies, and with ARMv8 CRC32 instructions enabled at compile time (__ARM_FEATURE_CRC32)
+   those are used. BLAKE2sp (RAR5 hash records): eight BLAKE2s leaves over interleaved 64-byte
+   blocks and a root over their digests. The leaves are independent, so with AVX2 (checked at
+   runtime) they run one per 32-bit lane. Define PAS_RAR_NO_SIMD to force the portable paths. */
+
+static const uint32_t pas_rar__crc_table[16][256] = {
+    {
+        0x00000000, 0x77073096, 0xee0e612c, 0x990951ba, 0x076dc419, 0x706af48f, 0xe963a535, 0x9e6495a3,
+        0x0edb8832, 0x79dcb8a4, 0xe0d5e91e, 0x97d2d988, 0x09b64c2b, 0x7eb17cbd, 0xe7b82d07, 0x90bf1d91,
+        0x1db71064, 0x6ab020f2, 0xf3b97148, 0x84be41de, 0x1adad47d, 0x6ddde4eb, 0xf4d4b551, 0x83d385c7,
+        0x136c9856, 0x646ba8c0, 0xfd62f97a, 0x8a65c9ec, 0x14015c4f, 0x63066cd9, 0xfa0f3d63, 0x8d080df5,
+        0x3b6e20c8, 0x4c69105e, 0xd56041e4, 0xa2677172, 0x3c03e4d1, 0x4b04d447, 0xd20d85fd, 0xa50ab56b,
+        0x35b5a8fa, 0x42b2986c, 0xdbbbc9d6, 0xacbcf940, 0x32d86ce3, 0x45df5c75, 0xdcd60dcf, 0xabd13d59,
+        0x26d930ac, 0x51de003a, 0xc8d75180, 0xbfd06116, 0x21b4f4b5, 0x56b3c423, 0xcfba9599, 0xb8bda50f,
+        0x2802b89e, 0x5f058808, 0xc60cd9b2, 0xb10be924, 0x2f6f7c87, 0x58684c11, 0xc1611dab, 0xb6662d3d,
+        0x76dc4190, 0x01db7106, 0x98d220bc, 0xefd5102a, 0x71b18589, 0x06b6b51f, 0x9fbfe4a5, 0xe8b8d433,
+        0x7807c9a2, 0x0f00f934, 0x9609a88e, 0xe10e9818, 0x7f6a0dbb, 0x086d3d2d, 0x91646c97, 0xe6635c01,
+        0x6b6b51f4, 0x1c6c6162, 0x856530d8, 0xf262004e, 0x6c0695ed, 0x1b01a57b, 0x8208f4c1, 0xf50fc457,
+        0x65b0d9c6, 0x12b7e950, 0x8bbeb8ea, 0xfcb9887c, 0x62dd1ddf, 0x15da2d49, 0x8cd37cf3, 0xfbd44c65,
+        0x4db26158, 0x3ab551ce, 0xa3bc0074, 0xd4bb30e2, 0x4adfa541, 0x3dd895d7, 0xa4d1c46d, 0xd3d6f4fb,
+        0x4369e96a, 0x346ed9fc, 0xad678846, 0xda60b8d0, 0x44042d73, 0x33031de5, 0xaa0a4c5f, 0xdd0d7cc9,
+        0x5005713c, 0x270241aa, 0xbe0b1010, 0xc90c2086, 0x5768b525, 0x206f85b3, 0xb966d409, 0xce61e49f,
+        0x5edef90e, 0x29d9c998, 0xb0d09822, 0xc7d7a8b4, 0x59b33d17, 0x2eb40d81, 0xb7bd5c3b, 0xc0ba6cad,
+        0xedb88320, 0x9abfb3b6, 0x03b6e20c, 0x74b1d29a, 0xead54739, 0x9dd277af, 0x04db2615, 0x73dc1683,
+        0xe3630b12, 0x94643b84, 0x0d6d6a3e, 0x7a6a5aa8, 0xe40ecf0b, 0x9309ff9d, 0x0a00ae27, 0x7d079eb1,
+        0xf00f9344, 0x8708a3d2, 0x1e01f268, 0x6906c2fe, 0xf762575d, 0x806567cb, 0x196c3671, 0x6e6b06e7,
+        0xfed41b76, 0x89d32be0, 0x10da7a5a, 0x67dd4acc, 0xf9b9df6f, 0x8ebeeff9, 0x17b7be43, 0x60b08ed5,
+        0xd6d6a3e8, 0xa1d1937e, 0x38d8c2c4, 0x4fdff252, 0xd1bb67f1, 0xa6bc5767, 0x3fb506dd, 0x48b2364b,
+        0xd80d2bda, 0xaf0a1b4c, 0x36034af6, 0x41047a60, 0xdf60efc3, 0xa867df55, 0x316e8eef, 0x4669be79,
+        0xcb61b38c, 0xbc66831a, 0x256fd2a0, 0x5268e236, 0xcc0c7795, 0xbb0b4703, 0x220216b9, 0x5505262f,
+        0xc5ba3bbe, 0xb2bd0b28, 0x2bb45a92, 0x5cb36a04, 0xc2d7ffa7, 0xb5d0cf31, 0x2cd99e8b, 0x5bdeae1d,
+        0x9b64c2b0, 0xec63f226, 0x756aa39c, 0x026d930a, 0x9c0906a9, 0xeb0e363f, 0x72076785, 0x05005713,
+        0x95bf4a82, 0xe2b87a14, 0x7bb12bae, 0x0cb61b38, 0x92d28e9b, 0xe5d5be0d, 0x7cdcefb7, 0x0bdbdf21,
+        0x86d3d2d4, 0xf1d4e242, 0x68ddb3f8, 0x1fda836e, 0x81be16cd, 0xf6b9265b, 0x6fb077e1, 0x18b74777,
+        0x88085ae6, 0xff0f6a70, 0x66063bca, 0x11010b5c, 0x8f659eff, 0xf862ae69, 0x616bffd3, 0x166ccf45,
+        0xa00ae278, 0xd70dd2ee, 0x4e048354, 0x3903b3c2, 0xa7672661, 0xd06016f7, 0x4969474d, 0x3e6e77db,
+        0xaed16a4a, 0xd9d65adc, 0x40df0b66, 0x37d83bf0, 0xa9bcae53, 0xdebb9ec5, 0x47b2cf7f, 0x30b5ffe9,
+        0xbdbdf21c, 0xcabac28a, 0x53b39330, 0x24b4a3a6, 0xbad03605, 0xcdd70693, 0x54de5729, 0x23d967bf,
+        0xb3667a2e, 0xc4614ab8, 0x5d681b02, 0x2a6f2b94, 0xb40bbe37, 0xc30c8ea1, 0x5a05df1b, 0x2d02ef8d
+    },
+    {
+        0x00000000, 0x191b3141, 0x32366282, 0x2b2d53c3, 0x646cc504, 0x7d77f445, 0x565aa786, 0x4f4196c7,
+        0xc8d98a08, 0xd1c2bb49, 0xfaefe88a, 0xe3f4d9cb, 0xacb54f0c, 0xb5ae7e4d, 0x9e832d8e, 0x87981ccf,
+        0x4ac21251, 0x53d92310, 0x78f470d3, 0x61ef4192, 0x2eaed755, 0x37b5e614, 0x1c98b5d7, 0x05838496,
+        0x821b9859, 0x9b00a918, 0xb02dfadb, 0xa936cb9a, 0xe6775d5d, 0xff6c6c1c, 0xd4413fdf, 0xcd5a0e9e,
+        0x958424a2, 0x8c9f15e3, 0xa7b24620, 0xbea97761, 0xf1e8e1a6, 0xe8f3d0e7, 0xc3de8324, 0xdac5b265,
+        0x5d5daeaa, 0x44469feb, 0x6f6bcc28, 0x7670fd69, 0x39316bae, 0x202a5aef, 0x0b07092c, 0x121c386d,
+        0xdf4636f3, 0xc65d07b2, 0xed705471, 0xf46b6530, 0xbb2af3f7, 0xa231c2b6, 0x891c9175, 0x9007a034,
+        0x179fbcfb, 0x0e848dba, 0x25a9de79, 0x3cb2ef38, 0x73f379ff, 0x6ae848be, 0x41c51b7d, 0x58de2a3c,
+        0xf0794f05, 0xe9627e44, 0xc24f2d87, 0xdb541cc6, 0x94158a01, 0x8d0ebb40, 0xa623e883, 0xbf38d9c2,
+        0x38a0c50d, 0x21bbf44c, 0x0a96a78f, 0x138d96ce, 0x5ccc0009, 0x45d73148, 0x6efa628b, 0x77e153ca,
+        0xbabb5d54, 0xa3a06c15, 0x888d3fd6, 0x91960e97, 0xded79850, 0xc7cca911, 0xece1fad2, 0xf5facb93,
+        0x7262d75c, 0x6b79e61d, 0x4054b5de, 0x594f849f, 0x160e1258, 0x0f152319, 0x243870da, 0x3d23419b,
+        0x65fd6ba7, 0x7ce65ae6, 0x57cb0925, 0x4ed03864, 0x0191aea3, 0x188a9fe2, 0x33a7cc21, 0x2abcfd60,
+        0xad24e1af, 0xb43fd0ee, 0x9f12832d, 0x8609b26c, 0xc94824ab, 0xd05315ea, 0xfb7e4629, 0xe2657768,
+        0x2f3f79f6, 0x362448b7, 0x1d091b74, 0x04122a35, 0x4b53bcf2, 0x52488db3, 0x7965de70, 0x607eef31,
+        0xe7e6f3fe, 0xfefdc2bf, 0xd5d0917c, 0xcccba03d, 0x838a36fa, 0x9a9107bb, 0xb1bc5478, 0xa8a76539,
+        0x3b83984b, 0x2298a90a, 0x09b5fac9, 0x10aecb88, 0x5fef5d4f, 0x46f46c0e, 0x6dd93fcd, 0x74c20e8c,
+        0xf35a1243, 0xea412302, 0xc16c70c1, 0xd8774180, 0x9736d747, 0x8e2de606, 0xa500b5c5, 0xbc1b8484,
+        0x71418a1a, 0x685abb5b, 0x4377e898, 0x5a6cd9d9, 0x152d4f1e, 0x0c367e5f, 0x271b2d9c, 0x3e001cdd,
+        0xb9980012, 0xa0833153, 0x8bae6290, 0x92b553d1, 0xddf4c516, 0xc4eff457, 0xefc2a794, 0xf6d996d5,
+        0xae07bce9, 0xb71c8da8, 0x9c31de6b, 0x852aef2a, 0xca6b79ed, 0xd37048ac, 0xf85d1b6f, 0xe1462a2e,
+        0x66de36e1, 0x7fc507a0, 0x54e85463, 0x4df36522, 0x02b2f3e5, 0x1ba9c2a4, 0x30849167, 0x299fa026,
+        0xe4c5aeb8, 0xfdde9ff9, 0xd6f3cc3a, 0xcfe8fd7b, 0x80a96bbc, 0x99b25afd, 0xb29f093e, 0xab84387f,
+        0x2c1c24b0, 0x350715f1, 0x1e2a4632, 0x07317773, 0x4870e1b4, 0x516bd0f5, 0x7a468336, 0x635db277,
+        0xcbfad74e, 0xd2e1e60f, 0xf9ccb5cc, 0xe0d7848d, 0xaf96124a, 0xb68d230b, 0x9da070c8, 0x84bb4189,
+        0x03235d46, 0x1a386c07, 0x31153fc4, 0x280e0e85, 0x674f9842, 0x7e54a903, 0x5579fac0, 0x4c62cb81,
+        0x8138c51f, 0x9823f45e, 0xb30ea79d, 0xaa1596dc, 0xe554001b, 0xfc4f315a, 0xd7626299, 0xce7953d8,
+        0x49e14f17, 0x50fa7e56, 0x7bd72d95, 0x62cc1cd4, 0x2d8d8a13, 0x3496bb52, 0x1fbbe891, 0x06a0d9d0,
+        0x5e7ef3ec, 0x4765c2ad, 0x6c48916e, 0x7553a02f, 0x3a1236e8, 0x230907a9, 0x0824546a, 0x113f652b,
+        0x96a779e4, 0x8fbc48a5, 0xa4911b66, 0xbd8a2a27, 0xf2cbbce0, 0xebd08da1, 0xc0fdde62, 0xd9e6ef23,
+        0x14bce1bd, 0x0da7d0fc, 0x268a833f, 0x3f91b27e, 0x70d024b9, 0x69cb15f8, 0x42e6463b, 0x5bfd777a,
+        0xdc656bb5, 0xc57e5af4, 0xee530937, 0xf7483876, 0xb809aeb1, 0xa1129ff0, 0x8a3fcc33, 0x9324fd72
+    },
+    {
+        0x00000000, 0x01c26a37, 0x0384d46e, 0x0246be59, 0x0709a8dc, 0x06cbc2eb, 0x048d7cb2, 0x054f1685,
+        0x0e1351b8, 0x0fd13b8f, 0x0d9785d6, 0x0c55efe1, 0x091af964, 0x08d89353, 0x0a9e2d0a, 0x0b5c473d,
+        0x1c26a370, 0x1de4c947, 0x1fa2771e, 0x1e601d29, 0x1b2f0bac, 0x1aed619b, 0x18abdfc2, 0x1969b5f5,
+        0x1235f2c8, 0x13f798ff, 0x11b126a6, 0x10734c91, 0x153c5a14, 0x14fe3023, 0x16b88e7a, 0x177ae44d,
+        0x384d46e0, 0x398f2cd7, 0x3bc9928e, 0x3a0bf8b9, 0x3f44ee3c, 0x3e86840b, 0x3cc03a52, 0x3d025065,
+        0x365e1758, 0x379c7d6f, 0x35dac336, 0x3418a901, 0x3157bf84, 0x3095d5b3, 0x32d36bea, 0x331101dd,
+        0x246be590, 0x25a98fa7, 0x27ef31fe, 0x262d5bc9, 0x23624d4c, 0x22a0277b, 0x20e69922, 0x2124f315,
+        0x2a78b428, 0x2bbade1f, 0x29fc6046, 0x283e0a71, 0x2d711cf4, 0x2cb376c3, 0x2ef5c89a, 0x2f37a2ad,
+        0x709a8dc0, 0x7158e7f7, 0x731e59ae, 0x72dc3399, 0x7793251c, 0x76514f2b, 0x7417f172, 0x75d59b45,
+        0x7e89dc78, 0x7f4bb64f, 0x7d0d0816, 0x7ccf6221, 0x798074a4, 0x78421e93, 0x7a04a0ca, 0x7bc6cafd,
+        0x6cbc2eb0, 0x6d7e4487, 0x6f38fade, 0x6efa90e9, 0x6bb5866c, 0x6a77ec5b, 0x68315202, 0x69f33835,
+        0x62af7f08, 0x636d153f, 0x612bab66, 0x60e9c151, 0x65a6d7d4, 0x6464bde3, 0x662203ba, 0x67e0698d,
+        0x48d7cb20, 0x4915a117, 0x4b531f4e, 0x4a917579, 0x4fde63fc, 0x4e1c09cb, 0x4c5ab792, 0x4d98dda5,
+        0x46c49a98, 0x4706f0af, 0x45404ef6, 0x448224c1, 0x41cd3244, 0x400f5873, 0x4249e62a, 0x438b8c1d,
+        0x54f16850, 0x55330267, 0x5775bc3e, 0x56b7d609, 0x53f8c08c, 0x523aaabb, 0x507c14e2, 0x51be7ed5,
+        0x5ae239e8, 0x5b2053df, 0x5966ed86, 0x58a487b1, 0x5deb9134, 0x5c29fb03, 0x5e6f455a, 0x5fad2f6d,
+        0xe1351b80, 0xe0f771b7, 0xe2b1cfee, 0xe373a5d9, 0xe63cb35c, 0xe7fed96b, 0xe5b86732, 0xe47a0d05,
+        0xef264a38, 0xeee4200f, 0xeca29e56, 0xed60f461, 0xe82fe2e4, 0xe9ed88d3, 0xebab368a, 0xea695cbd,
+        0xfd13b8f0, 0xfcd1d2c7, 0xfe976c9e, 0xff5506a9, 0xfa1a102c, 0xfbd87a1b, 0xf99ec442, 0xf85cae75,
+        0xf300e948, 0xf2c2837f, 0xf0843d26, 0xf1465711, 0xf4094194, 0xf5cb2ba3, 0xf78d95fa, 0xf64fffcd,
+        0xd9785d60, 0xd8ba3757, 0xdafc890e, 0xdb3ee339, 0xde71f5bc, 0xdfb39f8b, 0xddf521d2, 0xdc374be5,
+        0xd76b0cd8, 0xd6a966ef, 0xd4efd8b6, 0xd52db281, 0xd062a404, 0xd1a0ce33, 0xd3e6706a, 0xd2241a5d,
+        0xc55efe10, 0xc49c9427, 0xc6da2a7e, 0xc7184049, 0xc25756cc, 0xc3953cfb, 0xc1d382a2, 0xc011e895,
+        0xcb4dafa8, 0xca8fc59f, 0xc8c97bc6, 0xc90b11f1, 0xcc440774, 0xcd866d43, 0xcfc0d31a, 0xce02b92d,
+        0x91af9640, 0x906dfc77, 0x922b422e, 0x93e92819, 0x96a63e9c, 0x976454ab, 0x9522eaf2, 0x94e080c5,
+        0x9fbcc7f8, 0x9e7eadcf, 0x9c381396, 0x9dfa79a1, 0x98b56f24, 0x99770513, 0x9b31bb4a, 0x9af3d17d,
+        0x8d893530, 0x8c4b5f07, 0x8e0de15e, 0x8fcf8b69, 0x8a809dec, 0x8b42f7db, 0x89044982, 0x88c623b5,
+        0x839a6488, 0x82580ebf, 0x801eb0e6, 0x81dcdad1, 0x8493cc54, 0x8551a663, 0x8717183a, 0x86d5720d,
+        0xa9e2d0a0, 0xa820ba97, 0xaa6604ce, 0xaba46ef9, 0xaeeb787c, 0xaf29124b, 0xad6fac12, 0xacadc625,
+        0xa7f18118, 0xa633eb2f, 0xa4755576, 0xa5b73f41, 0xa0f829c4, 0xa13a43f3, 0xa37cfdaa, 0xa2be979d,
+        0xb5c473d0, 0xb40619e7, 0xb640a7be, 0xb782cd89, 0xb2cddb0c, 0xb30fb13b, 0xb1490f62, 0xb08b6555,
+        0xbbd72268, 0xba15485f, 0xb853f606, 0xb9919c31, 0xbcde8ab4, 0xbd1ce083, 0xbf5a5eda, 0xbe9834ed
+    },
+    {
+        0x00000000, 0xb8bc6765, 0xaa09c88b, 0x12b5afee, 0x8f629757, 0x37def032, 0x256b5fdc, 0x9dd738b9,
+        0xc5b428ef, 0x7d084f8a, 0x6fbde064, 0xd7018701, 0x4ad6bfb8, 0xf26ad8dd, 0xe0df7733, 0x58631056,
+        0x5019579f, 0xe8a530fa, 0xfa109f14, 0x42acf871, 0xdf7bc0c8, 0x67c7a7ad, 0x75720843, 0xcdce6f26,
+        0x95ad7f70, 0x2d111815, 0x3fa4b7fb, 0x8718d09e, 0x1acfe827, 0xa2738f42, 0xb0c620ac, 0x087a47c9,
+        0xa032af3e, 0x188ec85b, 0x0a3b67b5, 0xb28700d0, 0x2f503869, 0x97ec5f0c, 0x8559f0e2, 0x3de59787,
+        0x658687d1, 0xdd3ae0b4, 0xcf8f4f5a, 0x7733283f, 0xeae41086, 0x525877e3, 0x40edd80d, 0xf851bf68,
+        0xf02bf8a1, 0x48979fc4, 0x5a22302a, 0xe29e574f, 0x7f496ff6, 0xc7f50893, 0xd540a77d, 0x6dfcc018,
+        0x359fd04e, 0x8d23b72b, 0x9f9618c5, 0x272a7fa0, 0xbafd4719, 0x0241207c, 0x10f48f92, 0xa848e8f7,
+        0x9b14583d, 0x23a83f58, 0x311d90b6, 0x89a1f7d3, 0x1476cf6a, 0xaccaa80f, 0xbe7f07e1, 0x06c36084,
+        0x5ea070d2, 0xe61c17b7, 0xf4a9b859, 0x4c15df3c, 0xd1c2e785, 0x697e80e0, 0x7bcb2f0e, 0xc377486b,
+        0xcb0d0fa2, 0x73b168c7, 0x6104c729, 0xd9b8a04c, 0x446f98f5, 0xfcd3ff90, 0xee66507e, 0x56da371b,
+        0x0eb9274d, 0xb6054028, 0xa4b0efc6, 0x1c0c88a3, 0x81dbb01a, 0x3967d77f, 0x2bd27891, 0x936e1ff4,
+        0x3b26f703, 0x839a9066, 0x912f3f88, 0x299358ed, 0xb4446054, 0x0cf80731, 0x1e4da8df, 0xa6f1cfba,
+        0xfe92dfec, 0x462eb889, 0x549b1767, 0xec277002, 0x71f048bb, 0xc94c2fde, 0xdbf98030, 0x6345e755,
+        0x6b3fa09c, 0xd383c7f9, 0xc1366817, 0x798a0f72, 0xe45d37cb, 0x5ce150ae, 0x4e54ff40, 0xf6e89825,
+        0xae8b8873, 0x1637ef16, 0x048240f8, 0xbc3e279d, 0x21e91f24, 0x99557841, 0x8be0d7af, 0x335cb0ca,
+        0xed59b63b, 0x55e5d15e, 0x47507eb0, 0xffec19d5, 0x623b216c, 0xda874609, 0xc832e9e7, 0x708e8e82,
+        0x28ed9ed4, 0x9051f9b1, 0x82e4565f, 0x3a58313a, 0xa78f0983, 0x1f336ee6, 0x0d86c108, 0xb53aa66d,
+        0xbd40e1a4, 0x05fc86c1, 0x1749292f, 0xaff54e4a, 0x322276f3, 0x8a9e1196, 0x982bbe78, 0x2097d91d,
+        0x78f4c94b, 0xc048ae2e, 0xd2fd01c0, 0x6a4166a5, 0xf7965e1c, 0x4f2a3979, 0x5d9f9697, 0xe523f1f2,
+        0x4d6b1905, 0xf5d77e60, 0xe762d18e, 0x5fdeb6eb, 0xc2098e52, 0x7ab5e937, 0x680046d9, 0xd0bc21bc,
+        0x88df31ea, 0x3063568f, 0x22d6f961, 0x9a6a9e04, 0x07bda6bd, 0xbf01c1d8, 0xadb46e36, 0x15080953,
+        0x1d724e9a, 0xa5ce29ff, 0xb77b8611, 0x0fc7e174, 0x9210d9cd, 0x2aacbea8, 0x38191146, 0x80a57623,
+        0xd8c66675, 0x607a0110, 0x72cfaefe, 0xca73c99b, 0x57a4f122, 0xef189647, 0xfdad39a9, 0x45115ecc,
+        0x764dee06, 0xcef18963, 0xdc44268d, 0x64f841e8, 0xf92f7951, 0x41931e34, 0x5326b1da, 0xeb9ad6bf,
+        0xb3f9c6e9, 0x0b45a18c, 0x19f00e62, 0xa14c6907, 0x3c9b51be, 0x842736db, 0x96929935, 0x2e2efe50,
+        0x2654b999, 0x9ee8defc, 0x8c5d7112, 0x34e11677, 0xa9362ece, 0x118a49ab, 0x033fe645, 0xbb838120,
+        0xe3e09176, 0x5b5cf613, 0x49e959fd, 0xf1553e98, 0x6c820621, 0xd43e6144, 0xc68bceaa, 0x7e37a9cf,
+        0xd67f4138, 0x6ec3265d, 0x7c7689b3, 0xc4caeed6, 0x591dd66f, 0xe1a1b10a, 0xf3141ee4, 0x4ba87981,
+        0x13cb69d7, 0xab770eb2, 0xb9c2a15c, 0x017ec639, 0x9ca9fe80, 0x241599e5, 0x36a0360b, 0x8e1c516e,
+        0x866616a7, 0x3eda71c2, 0x2c6fde2c, 0x94d3b949, 0x090481f0, 0xb1b8e695, 0xa30d497b, 0x1bb12e1e,
+        0x43d23e48, 0xfb6e592d, 0xe9dbf6c3, 0x516791a6, 0xccb0a91f, 0x740cce7a, 0x66b96194, 0xde0506f1
+    },
+    {
+        0x00000000, 0x3d6029b0, 0x7ac05360, 0x47a07ad0, 0xf580a6c0, 0xc8e08f70, 0x8f40f5a0, 0xb220dc10,
+        0x30704bc1, 0x0d106271, 0x4ab018a1, 0x77d03111, 0xc5f0ed01, 0xf890c4b1, 0xbf30be61, 0x825097d1,
+        0x60e09782, 0x5d80be32, 0x1a20c4e2, 0x2740ed52, 0x95603142, 0xa80018f2, 0xefa06222, 0xd2c04b92,
+        0x5090dc43, 0x6df0f5f3, 0x2a508f23, 0x1730a693, 0xa5107a83, 0x98705333, 0xdfd029e3, 0xe2b00053,
+        0xc1c12f04, 0xfca106b4, 0xbb017c64, 0x866155d4, 0x344189c4, 0x0921a074, 0x4e81daa4, 0x73e1f314,
+        0xf1b164c5, 0xccd14d75, 0x8b7137a5, 0xb6111e15, 0x0431c205, 0x3951ebb5, 0x7ef19165, 0x4391b8d5,
+        0xa121b886, 0x9c419136, 0xdbe1ebe6, 0xe681c256, 0x54a11e46, 0x69c137f6, 0x2e614d26, 0x13016496,
+        0x9151f347, 0xac31daf7, 0xeb91a027, 0xd6f18997, 0x64d15587, 0x59b17c37, 0x1e1106e7, 0x23712f57,
+        0x58f35849, 0x659371f9, 0x22330b29, 0x1f532299, 0xad73fe89, 0x9013d739, 0xd7b3ade9, 0xead38459,
+        0x68831388, 0x55e33a38, 0x124340e8, 0x2f236958, 0x9d03b548, 0xa0639cf8, 0xe7c3e628, 0xdaa3cf98,
+        0x3813cfcb, 0x0573e67b, 0x42d39cab, 0x7fb3b51b, 0xcd93690b, 0xf0f340bb, 0xb7533a6b, 0x8a3313db,
+        0x0863840a, 0x3503adba, 0x72a3d76a, 0x4fc3feda, 0xfde322ca, 0xc0830b7a, 0x872371aa, 0xba43581a,
+        0x9932774d, 0xa4525efd, 0xe3f2242d, 0xde920d9d, 0x6cb2d18d, 0x51d2f83d, 0x167282ed, 0x2b12ab5d,
+        0xa9423c8c, 0x9422153c, 0xd3826fec, 0xeee2465c, 0x5cc29a4c, 0x61a2b3fc, 0x2602c92c, 0x1b62e09c,
+        0xf9d2e0cf, 0xc4b2c97f, 0x8312b3af, 0xbe729a1f, 0x0c52460f, 0x31326fbf, 0x7692156f, 0x4bf23cdf,
+        0xc9a2ab0e, 0xf4c282be, 0xb362f86e, 0x8e02d1de, 0x3c220dce, 0x0142247e, 0x46e25eae, 0x7b82771e,
+        0xb1e6b092, 0x8c869922, 0xcb26e3f2, 0xf646ca42, 0x44661652, 0x79063fe2, 0x3ea64532, 0x03c66c82,
+        0x8196fb53, 0xbcf6d2e3, 0xfb56a833, 0xc6368183, 0x74165d93, 0x49767423, 0x0ed60ef3, 0x33b62743,
+        0xd1062710, 0xec660ea0, 0xabc67470, 0x96a65dc0, 0x248681d0, 0x19e6a860, 0x5e46d2b0, 0x6326fb00,
+        0xe1766cd1, 0xdc164561, 0x9bb63fb1, 0xa6d61601, 0x14f6ca11, 0x2996e3a1, 0x6e369971, 0x5356b0c1,
+        0x70279f96, 0x4d47b626, 0x0ae7ccf6, 0x3787e546, 0x85a73956, 0xb8c710e6, 0xff676a36, 0xc2074386,
+        0x4057d457, 0x7d37fde7, 0x3a978737, 0x07f7ae87, 0xb5d77297, 0x88b75b27, 0xcf1721f7, 0xf2770847,
+        0x10c70814, 0x2da721a4, 0x6a075b74, 0x576772c4, 0xe547aed4, 0xd8278764, 0x9f87fdb4, 0xa2e7d404,
+        0x20b743d5, 0x1dd76a65, 0x5a7710b5, 0x67173905, 0xd537e515, 0xe857cca5, 0xaff7b675, 0x92979fc5,
+        0xe915e8db, 0xd475c16b, 0x93d5bbbb, 0xaeb5920b, 0x1c954e1b, 0x21f567ab, 0x66551d7b, 0x5b3534cb,
+        0xd965a31a, 0xe4058aaa, 0xa3a5f07a, 0x9ec5d9ca, 0x2ce505da, 0x11852c6a, 0x562556ba, 0x6b457f0a,
+        0x89f57f59, 0xb49556e9, 0xf3352c39, 0xce550589, 0x7c75d999, 0x4115f029, 0x06b58af9, 0x3bd5a349,
+        0xb9853498, 0x84e51d28, 0xc34567f8, 0xfe254e48, 0x4c059258, 0x7165bbe8, 0x36c5c138, 0x0ba5e888,
+        0x28d4c7df, 0x15b4ee6f, 0x521494bf, 0x6f74bd0f, 0xdd54611f, 0xe03448af, 0xa794327f, 0x9af41bcf,
+        0x18a48c1e, 0x25c4a5ae, 0x6264df7e, 0x5f04f6ce, 0xed242ade, 0xd044036e, 0x97e479be, 0xaa84500e,
+        0x4834505d, 0x755479ed, 0x32f4033d, 0x0f942a8d, 0xbdb4f69d, 0x80d4df2d, 0xc774a5fd, 0xfa148c4d,
+        0x78441b9c, 0x4524322c, 0x028448fc, 0x3fe4614c, 0x8dc4bd5c, 0xb0a494ec, 0xf704ee3c, 0xca64c78c
+    },
+    {
+        0x00000000, 0xcb5cd3a5, 0x4dc8a10b, 0x869472ae, 0x9b914216, 0x50cd91b3, 0xd659e31d, 0x1d0530b8,
+        0xec53826d, 0x270f51c8, 0xa19b2366, 0x6ac7f0c3, 0x77c2c07b, 0xbc9e13de, 0x3a0a6170, 0xf156b2d5,
+        0x03d6029b, 0xc88ad13e, 0x4e1ea390, 0x85427035, 0x9847408d, 0x531b9328, 0xd58fe186, 0x1ed33223,
+        0xef8580f6, 0x24d95353, 0xa24d21fd, 0x6911f258, 0x7414c2e0, 0xbf481145, 0x39dc63eb, 0xf280b04e,
+        0x07ac0536, 0xccf0d693, 0x4a64a43d, 0x81387798, 0x9c3d4720, 0x57619485, 0xd1f5e62b, 0x1aa9358e,
+        0xebff875b, 0x20a354fe, 0xa6372650, 0x6d6bf5f5, 0x706ec54d, 0xbb3216e8, 0x3da66446, 0xf6fab7e3,
+        0x047a07ad, 0xcf26d408, 0x49b2a6a6, 0x82ee7503, 0x9feb45bb, 0x54b7961e, 0xd223e4b0, 0x197f3715,
+        0xe82985c0, 0x23755665, 0xa5e124cb, 0x6ebdf76e, 0x73b8c7d6, 0xb8e41473, 0x3e7066dd, 0xf52cb578,
+        0x0f580a6c, 0xc404d9c9, 0x4290ab67, 0x89cc78c2, 0x94c9487a, 0x5f959bdf, 0xd901e971, 0x125d3ad4,
+        0xe30b8801, 0x28575ba4, 0xaec3290a, 0x659ffaaf, 0x789aca17, 0xb3c619b2, 0x35526b1c, 0xfe0eb8b9,
+        0x0c8e08f7, 0xc7d2db52, 0x4146a9fc, 0x8a1a7a59, 0x971f4ae1, 0x5c439944, 0xdad7ebea, 0x118b384f,
+        0xe0dd8a9a, 0x2b81593f, 0xad152b91, 0x6649f834, 0x7b4cc88c, 0xb0101b29, 0x36846987, 0xfdd8ba22,
+        0x08f40f5a, 0xc3a8dcff, 0x453cae51, 0x8e607df4, 0x93654d4c, 0x58399ee9, 0xdeadec47, 0x15f13fe2,
+        0xe4a78d37, 0x2ffb5e92, 0xa96f2c3c, 0x6233ff99, 0x7f36cf21, 0xb46a1c84, 0x32fe6e2a, 0xf9a2bd8f,
+        0x0b220dc1, 0xc07ede64, 0x46eaacca, 0x8db67f6f, 0x90b34fd7, 0x5bef9c72, 0xdd7beedc, 0x16273d79,
+        0xe7718fac, 0x2c2d5c09, 0xaab92ea7, 0x61e5fd02, 0x7ce0cdba, 0xb7bc1e1f, 0x31286cb1, 0xfa74bf14,
+        0x1eb014d8, 0xd5ecc77d, 0x5378b5d3, 0x98246676, 0x852156ce, 0x4e7d856b, 0xc8e9f7c5, 0x03b52460,
+        0xf2e396b5, 0x39bf4510, 0xbf2b37be, 0x7477e41b, 0x6972d4a3, 0xa22e0706, 0x24ba75a8, 0xefe6a60d,
+        0x1d661643, 0xd63ac5e6, 0x50aeb748, 0x9bf264ed, 0x86f75455, 0x4dab87f0, 0xcb3ff55e, 0x006326fb,
+        0xf135942e, 0x3a69478b, 0xbcfd3525, 0x77a1e680, 0x6aa4d638, 0xa1f8059d, 0x276c7733, 0xec30a496,
+        0x191c11ee, 0xd240c24b, 0x54d4b0e5, 0x9f886340, 0x828d53f8, 0x49d1805d, 0xcf45f2f3, 0x04192156,
+        0xf54f9383, 0x3e134026, 0xb8873288, 0x73dbe12d, 0x6eded195, 0xa5820230, 0x2316709e, 0xe84aa33b,
+        0x1aca1375, 0xd196c0d0, 0x5702b27e, 0x9c5e61db, 0x815b5163, 0x4a0782c6, 0xcc93f068, 0x07cf23cd,
+        0xf6999118, 0x3dc542bd, 0xbb513013, 0x700de3b6, 0x6d08d30e, 0xa65400ab, 0x20c07205, 0xeb9ca1a0,
+        0x11e81eb4, 0xdab4cd11, 0x5c20bfbf, 0x977c6c1a, 0x8a795ca2, 0x41258f07, 0xc7b1fda9, 0x0ced2e0c,
+        0xfdbb9cd9, 0x36e74f7c, 0xb0733dd2, 0x7b2fee77, 0x662adecf, 0xad760d6a, 0x2be27fc4, 0xe0beac61,
+        0x123e1c2f, 0xd962cf8a, 0x5ff6bd24, 0x94aa6e81, 0x89af5e39, 0x42f38d9c, 0xc467ff32, 0x0f3b2c97,
+        0xfe6d9e42, 0x35314de7, 0xb3a53f49, 0x78f9ecec, 0x65fcdc54, 0xaea00ff1, 0x28347d5f, 0xe368aefa,
+        0x16441b82, 0xdd18c827, 0x5b8cba89, 0x90d0692c, 0x8dd55994, 0x46898a31, 0xc01df89f, 0x0b412b3a,
+        0xfa1799ef, 0x314b4a4a, 0xb7df38e4, 0x7c83eb41, 0x6186dbf9, 0xaada085c, 0x2c4e7af2, 0xe712a957,
+        0x15921919, 0xdececabc, 0x585ab812, 0x93066bb7, 0x8e035b0f, 0x455f88aa, 0xc3cbfa04, 0x089729a1,
+        0xf9c19b74, 0x329d48d1, 0xb4093a7f, 0x7f55e9da, 0x6250d962, 0xa90c0ac7, 0x2f987869, 0xe4c4abcc
+    },
+    {
+        0x00000000, 0xa6770bb4, 0x979f1129, 0x31e81a9d, 0xf44f2413, 0x52382fa7, 0x63d0353a, 0xc5a73e8e,
+        0x33ef4e67, 0x959845d3, 0xa4705f4e, 0x020754fa, 0xc7a06a74, 0x61d761c0, 0x503f7b5d, 0xf64870e9,
+        0x67de9cce, 0xc1a9977a, 0xf0418de7, 0x56368653, 0x9391b8dd, 0x35e6b369, 0x040ea9f4, 0xa279a240,
+        0x5431d2a9, 0xf246d91d, 0xc3aec380, 0x65d9c834, 0xa07ef6ba, 0x0609fd0e, 0x37e1e793, 0x9196ec27,
+        0xcfbd399c, 0x69ca3228, 0x582228b5, 0xfe552301, 0x3bf21d8f, 0x9d85163b, 0xac6d0ca6, 0x0a1a0712,
+        0xfc5277fb, 0x5a257c4f, 0x6bcd66d2, 0xcdba6d66, 0x081d53e8, 0xae6a585c, 0x9f8242c1, 0x39f54975,
+        0xa863a552, 0x0e14aee6, 0x3ffcb47b, 0x998bbfcf, 0x5c2c8141, 0xfa5b8af5, 0xcbb39068, 0x6dc49bdc,
+        0x9b8ceb35, 0x3dfbe081, 0x0c13fa1c, 0xaa64f1a8, 0x6fc3cf26, 0xc9b4c492, 0xf85cde0f, 0x5e2bd5bb,
+        0x440b7579, 0xe27c7ecd, 0xd3946450, 0x75e36fe4, 0xb044516a, 0x16335ade, 0x27db4043, 0x81ac4bf7,
+        0x77e43b1e, 0xd19330aa, 0xe07b2a37, 0x460c2183, 0x83ab1f0d, 0x25dc14b9, 0x14340e24, 0xb2430590,
+        0x23d5e9b7, 0x85a2e203, 0xb44af89e, 0x123df32a, 0xd79acda4, 0x71edc610, 0x4005dc8d, 0xe672d739,
+        0x103aa7d0, 0xb64dac64, 0x87a5b6f9, 0x21d2bd4d, 0xe47583c3, 0x42028877, 0x73ea92ea, 0xd59d995e,
+        0x8bb64ce5, 0x2dc14751, 0x1c295dcc, 0xba5e5678, 0x7ff968f6, 0xd98e6342, 0xe86679df, 0x4e11726b,
+        0xb8590282, 0x1e2e0936, 0x2fc613ab, 0x89b1181f, 0x4c162691, 0xea612d25, 0xdb8937b8, 0x7dfe3c0c,
+        0xec68d02b, 0x4a1fdb9f, 0x7bf7c102, 0xdd80cab6, 0x1827f438, 0xbe50ff8c, 0x8fb8e511, 0x29cfeea5,
+        0xdf879e4c, 0x79f095f8, 0x48188f65, 0xee6f84d1, 0x2bc8ba5f, 0x8dbfb1eb, 0xbc57ab76, 0x1a20a0c2,
+        0x8816eaf2, 0x2e61e146, 0x1f89fbdb, 0xb9fef06f, 0x7c59cee1, 0xda2ec555, 0xebc6dfc8, 0x4db1d47c,
+        0xbbf9a495, 0x1d8eaf21, 0x2c66b5bc, 0x8a11be08, 0x4fb68086, 0xe9c18b32, 0xd82991af, 0x7e5e9a1b,
+        0xefc8763c, 0x49bf7d88, 0x78576715, 0xde206ca1, 0x1b87522f, 0xbdf0599b, 0x8c184306, 0x2a6f48b2,
+        0xdc27385b, 0x7a5033ef, 0x4bb82972, 0xedcf22c6, 0x28681c48, 0x8e1f17fc, 0xbff70d61, 0x198006d5,
+        0x47abd36e, 0xe1dcd8da, 0xd034c247, 0x7643c9f3, 0xb3e4f77d, 0x1593fcc9, 0x247be654, 0x820cede0,
+        0x74449d09, 0xd23396bd, 0xe3db8c20, 0x45ac8794, 0x800bb91a, 0x267cb2ae, 0x1794a833, 0xb1e3a387,
+        0x20754fa0, 0x86024414, 0xb7ea5e89, 0x119d553d, 0xd43a6bb3, 0x724d6007, 0x43a57a9a, 0xe5d2712e,
+        0x139a01c7, 0xb5ed0a73, 0x840510ee, 0x22721b5a, 0xe7d525d4, 0x41a22e60, 0x704a34fd, 0xd63d3f49,
+        0xcc1d9f8b, 0x6a6a943f, 0x5b828ea2, 0xfdf58516, 0x3852bb98, 0x9e25b02c, 0xafcdaab1, 0x09baa105,
+        0xfff2d1ec, 0x5985da58, 0x686dc0c5, 0xce1acb71, 0x0bbdf5ff, 0xadcafe4b, 0x9c22e4d6, 0x3a55ef62,
+        0xabc30345, 0x0db408f1, 0x3c5c126c, 0x9a2b19d8, 0x5f8c2756, 0xf9fb2ce2, 0xc813367f, 0x6e643dcb,
+        0x982c4d22, 0x3e5b4696, 0x0fb35c0b, 0xa9c457bf, 0x6c636931, 0xca146285, 0xfbfc7818, 0x5d8b73ac,
+        0x03a0a617, 0xa5d7ada3, 0x943fb73e, 0x3248bc8a, 0xf7ef8204, 0x519889b0, 0x6070932d, 0xc6079899,
+        0x304fe870, 0x9638e3c4, 0xa7d0f959, 0x01a7f2ed, 0xc400cc63, 0x6277c7d7, 0x539fdd4a, 0xf5e8d6fe,
+        0x647e3ad9, 0xc209316d, 0xf3e12bf0, 0x55962044, 0x90311eca, 0x3646157e, 0x07ae0fe3, 0xa1d90457,
+        0x579174be, 0xf1e67f0a, 0xc00e6597, 0x66796e23, 0xa3de50ad, 0x05a95b19, 0x34414184, 0x92364a30
+    },
+    {
+        0x00000000, 0xccaa009e, 0x4225077d, 0x8e8f07e3, 0x844a0efa, 0x48e00e64, 0xc66f0987, 0x0ac50919,
+        0xd3e51bb5, 0x1f4f1b2b, 0x91c01cc8, 0x5d6a1c56, 0x57af154f, 0x9b0515d1, 0x158a1232, 0xd92012ac,
+        0x7cbb312b, 0xb01131b5, 0x3e9e3656, 0xf23436c8, 0xf8f13fd1, 0x345b3f4f, 0xbad438ac, 0x767e3832,
+        0xaf5e2a9e, 0x63f42a00, 0xed7b2de3, 0x21d12d7d, 0x2b142464, 0xe7be24fa, 0x69312319, 0xa59b2387,
+        0xf9766256, 0x35dc62c8, 0xbb53652b, 0x77f965b5, 0x7d3c6cac, 0xb1966c32, 0x3f196bd1, 0xf3b36b4f,
+        0x2a9379e3, 0xe639797d, 0x68b67e9e, 0xa41c7e00, 0xaed97719, 0x62737787, 0xecfc7064, 0x205670fa,
+        0x85cd537d, 0x496753e3, 0xc7e85400, 0x0b42549e, 0x01875d87, 0xcd2d5d19, 0x43a25afa, 0x8f085a64,
+        0x562848c8, 0x9a824856, 0x140d4fb5, 0xd8a74f2b, 0xd2624632, 0x1ec846ac, 0x9047414f, 0x5ced41d1,
+        0x299dc2ed, 0xe537c273, 0x6bb8c590, 0xa712c50e, 0xadd7cc17, 0x617dcc89, 0xeff2cb6a, 0x2358cbf4,
+        0xfa78d958, 0x36d2d9c6, 0xb85dde25, 0x74f7debb, 0x7e32d7a2, 0xb298d73c, 0x3c17d0df, 0xf0bdd041,
+        0x5526f3c6, 0x998cf358, 0x1703f4bb, 0xdba9f425, 0xd16cfd3c, 0x1dc6fda2, 0x9349fa41, 0x5fe3fadf,
+        0x86c3e873, 0x4a69e8ed, 0xc4e6ef0e, 0x084cef90, 0x0289e689, 0xce23e617, 0x40ace1f4, 0x8c06e16a,
+        0xd0eba0bb, 0x1c41a025, 0x92cea7c6, 0x5e64a758, 0x54a1ae41, 0x980baedf, 0x1684a93c, 0xda2ea9a2,
+        0x030ebb0e, 0xcfa4bb90, 0x412bbc73, 0x8d81bced, 0x8744b5f4, 0x4beeb56a, 0xc561b289, 0x09cbb217,
+        0xac509190, 0x60fa910e, 0xee7596ed, 0x22df9673, 0x281a9f6a, 0xe4b09ff4, 0x6a3f9817, 0xa6959889,
+        0x7fb58a25, 0xb31f8abb, 0x3d908d58, 0xf13a8dc6, 0xfbff84df, 0x37558441, 0xb9da83a2, 0x7570833c,
+        0x533b85da, 0x9f918544, 0x111e82a7, 0xddb48239, 0xd7718b20, 0x1bdb8bbe, 0x95548c5d, 0x59fe8cc3,
+        0x80de9e6f, 0x4c749ef1, 0xc2fb9912, 0x0e51998c, 0x04949095, 0xc83e900b, 0x46b197e8, 0x8a1b9776,
+        0x2f80b4f1, 0xe32ab46f, 0x6da5b38c, 0xa10fb312, 0xabcaba0b, 0x6760ba95, 0xe9efbd76, 0x2545bde8,
+        0xfc65af44, 0x30cfafda, 0xbe40a839, 0x72eaa8a7, 0x782fa1be, 0xb485a120, 0x3a0aa6c3, 0xf6a0a65d,
+        0xaa4de78c, 0x66e7e712, 0xe868e0f1, 0x24c2e06f, 0x2e07e976, 0xe2ade9e8, 0x6c22ee0b, 0xa088ee95,
+        0x79a8fc39, 0xb502fca7, 0x3b8dfb44, 0xf727fbda, 0xfde2f2c3, 0x3148f25d, 0xbfc7f5be, 0x736df520,
+        0xd6f6d6a7, 0x1a5cd639, 0x94d3d1da, 0x5879d144, 0x52bcd85d, 0x9e16d8c3, 0x1099df20, 0xdc33dfbe,
+        0x0513cd12, 0xc9b9cd8c, 0x4736ca6f, 0x8b9ccaf1, 0x8159c3e8, 0x4df3c376, 0xc37cc495, 0x0fd6c40b,
+        0x7aa64737, 0xb60c47a9, 0x3883404a, 0xf42940d4, 0xfeec49cd, 0x32464953, 0xbcc94eb0, 0x70634e2e,
+        0xa9435c82, 0x65e95c1c, 0xeb665bff, 0x27cc5b61, 0x2d095278, 0xe1a352e6, 0x6f2c5505, 0xa386559b,
+        0x061d761c, 0xcab77682, 0x44387161, 0x889271ff, 0x825778e6, 0x4efd7878, 0xc0727f9b, 0x0cd87f05,
+        0xd5f86da9, 0x19526d37, 0x97dd6ad4, 0x5b776a4a, 0x51b26353, 0x9d1863cd, 0x1397642e, 0xdf3d64b0,
+        0x83d02561, 0x4f7a25ff, 0xc1f5221c, 0x0d5f2282, 0x079a2b9b, 0xcb302b05, 0x45bf2ce6, 0x89152c78,
+        0x50353ed4, 0x9c9f3e4a, 0x121039a9, 0xdeba3937, 0xd47f302e, 0x18d530b0, 0x965a3753, 0x5af037cd,
+        0xff6b144a, 0x33c114d4, 0xbd4e1337, 0x71e413a9, 0x7b211ab0, 0xb78b1a2e, 0x39041dcd, 0xf5ae1d53,
+        0x2c8e0fff, 0xe0240f61, 0x6eab0882, 0xa201081c, 0xa8c40105, 0x646e019b, 0xeae10678, 0x264b06e6
+    },
+    {
+        0x00000000, 0x177b1443, 0x2ef62886, 0x398d3cc5, 0x5dec510c, 0x4a97454f, 0x731a798a, 0x64616dc9,
+        0xbbd8a218, 0xaca3b65b, 0x952e8a9e, 0x82559edd, 0xe634f314, 0xf14fe757, 0xc8c2db92, 0xdfb9cfd1,
+        0xacc04271, 0xbbbb5632, 0x82366af7, 0x954d7eb4, 0xf12c137d, 0xe657073e, 0xdfda3bfb, 0xc8a12fb8,
+        0x1718e069, 0x0063f42a, 0x39eec8ef, 0x2e95dcac, 0x4af4b165, 0x5d8fa526, 0x640299e3, 0x73798da0,
+        0x82f182a3, 0x958a96e0, 0xac07aa25, 0xbb7cbe66, 0xdf1dd3af, 0xc866c7ec, 0xf1ebfb29, 0xe690ef6a,
+        0x392920bb, 0x2e5234f8, 0x17df083d, 0x00a41c7e, 0x64c571b7, 0x73be65f4, 0x4a335931, 0x5d484d72,
+        0x2e31c0d2, 0x394ad491, 0x00c7e854, 0x17bcfc17, 0x73dd91de, 0x64a6859d, 0x5d2bb958, 0x4a50ad1b,
+        0x95e962ca, 0x82927689, 0xbb1f4a4c, 0xac645e0f, 0xc80533c6, 0xdf7e2785, 0xe6f31b40, 0xf1880f03,
+        0xde920307, 0xc9e91744, 0xf0642b81, 0xe71f3fc2, 0x837e520b, 0x94054648, 0xad887a8d, 0xbaf36ece,
+        0x654aa11f, 0x7231b55c, 0x4bbc8999, 0x5cc79dda, 0x38a6f013, 0x2fdde450, 0x1650d895, 0x012bccd6,
+        0x72524176, 0x65295535, 0x5ca469f0, 0x4bdf7db3, 0x2fbe107a, 0x38c50439, 0x014838fc, 0x16332cbf,
+        0xc98ae36e, 0xdef1f72d, 0xe77ccbe8, 0xf007dfab, 0x9466b262, 0x831da621, 0xba909ae4, 0xadeb8ea7,
+        0x5c6381a4, 0x4b1895e7, 0x7295a922, 0x65eebd61, 0x018fd0a8, 0x16f4c4eb, 0x2f79f82e, 0x3802ec6d,
+        0xe7bb23bc, 0xf0c037ff, 0xc94d0b3a, 0xde361f79, 0xba5772b0, 0xad2c66f3, 0x94a15a36, 0x83da4e75,
+        0xf0a3c3d5, 0xe7d8d796, 0xde55eb53, 0xc92eff10, 0xad4f92d9, 0xba34869a, 0x83b9ba5f, 0x94c2ae1c,
+        0x4b7b61cd, 0x5c00758e, 0x658d494b, 0x72f65d08, 0x169730c1, 0x01ec2482, 0x38611847, 0x2f1a0c04,
+        0x6655004f, 0x712e140c, 0x48a328c9, 0x5fd83c8a, 0x3bb95143, 0x2cc24500, 0x154f79c5, 0x02346d86,
+        0xdd8da257, 0xcaf6b614, 0xf37b8ad1, 0xe4009e92, 0x8061f35b, 0x971ae718, 0xae97dbdd, 0xb9eccf9e,
+        0xca95423e, 0xddee567d, 0xe4636ab8, 0xf3187efb, 0x97791332, 0x80020771, 0xb98f3bb4, 0xaef42ff7,
+        0x714de026, 0x6636f465, 0x5fbbc8a0, 0x48c0dce3, 0x2ca1b12a, 0x3bdaa569, 0x025799ac, 0x152c8def,
+        0xe4a482ec, 0xf3df96af, 0xca52aa6a, 0xdd29be29, 0xb948d3e0, 0xae33c7a3, 0x97befb66, 0x80c5ef25,
+        0x5f7c20f4, 0x480734b7, 0x718a0872, 0x66f11c31, 0x029071f8, 0x15eb65bb, 0x2c66597e, 0x3b1d4d3d,
+        0x4864c09d, 0x5f1fd4de, 0x6692e81b, 0x71e9fc58, 0x15889191, 0x02f385d2, 0x3b7eb917, 0x2c05ad54,
+        0xf3bc6285, 0xe4c776c6, 0xdd4a4a03, 0xca315e40, 0xae503389, 0xb92b27ca, 0x80a61b0f, 0x97dd0f4c,
+        0xb8c70348, 0xafbc170b, 0x96312bce, 0x814a3f8d, 0xe52b5244, 0xf2504607, 0xcbdd7ac2, 0xdca66e81,
+        0x031fa150, 0x1464b513, 0x2de989d6, 0x3a929d95, 0x5ef3f05c, 0x4988e41f, 0x7005d8da, 0x677ecc99,
+        0x14074139, 0x037c557a, 0x3af169bf, 0x2d8a7dfc, 0x49eb1035, 0x5e900476, 0x671d38b3, 0x70662cf0,
+        0xafdfe321, 0xb8a4f762, 0x8129cba7, 0x9652dfe4, 0xf233b22d, 0xe548a66e, 0xdcc59aab, 0xcbbe8ee8,
+        0x3a3681eb, 0x2d4d95a8, 0x14c0a96d, 0x03bbbd2e, 0x67dad0e7, 0x70a1c4a4, 0x492cf861, 0x5e57ec22,
+        0x81ee23f3, 0x969537b0, 0xaf180b75, 0xb8631f36, 0xdc0272ff, 0xcb7966bc, 0xf2f45a79, 0xe58f4e3a,
+        0x96f6c39a, 0x818dd7d9, 0xb800eb1c, 0xaf7bff5f, 0xcb1a9296, 0xdc6186d5, 0xe5ecba10, 0xf297ae53,
+        0x2d2e6182, 0x3a5575c1, 0x03d84904, 0x14a35d47, 0x70c2308e, 0x67b924cd, 0x5e341808, 0x494f0c4b
+    },
+    {
+        0x00000000, 0xefc26b3e, 0x04f5d03d, 0xeb37bb03, 0x09eba07a, 0xe629cb44, 0x0d1e7047, 0xe2dc1b79,
+        0x13d740f4, 0xfc152bca, 0x172290c9, 0xf8e0fbf7, 0x1a3ce08e, 0xf5fe8bb0, 0x1ec930b3, 0xf10b5b8d,
+        0x27ae81e8, 0xc86cead6, 0x235b51d5, 0xcc993aeb, 0x2e452192, 0xc1874aac, 0x2ab0f1af, 0xc5729a91,
+        0x3479c11c, 0xdbbbaa22, 0x308c1121, 0xdf4e7a1f, 0x3d926166, 0xd2500a58, 0x3967b15b, 0xd6a5da65,
+        0x4f5d03d0, 0xa09f68ee, 0x4ba8d3ed, 0xa46ab8d3, 0x46b6a3aa, 0xa974c894, 0x42437397, 0xad8118a9,
+        0x5c8a4324, 0xb348281a, 0x587f9319, 0xb7bdf827, 0x5561e35e, 0xbaa38860, 0x51943363, 0xbe56585d,
+        0x68f38238, 0x8731e906, 0x6c065205, 0x83c4393b, 0x61182242, 0x8eda497c, 0x65edf27f, 0x8a2f9941,
+        0x7b24c2cc, 0x94e6a9f2, 0x7fd112f1, 0x901379cf, 0x72cf62b6, 0x9d0d0988, 0x763ab28b, 0x99f8d9b5,
+        0x9eba07a0, 0x71786c9e, 0x9a4fd79d, 0x758dbca3, 0x9751a7da, 0x7893cce4, 0x93a477e7, 0x7c661cd9,
+        0x8d6d4754, 0x62af2c6a, 0x89989769, 0x665afc57, 0x8486e72e, 0x6b448c10, 0x80733713, 0x6fb15c2d,
+        0xb9148648, 0x56d6ed76, 0xbde15675, 0x52233d4b, 0xb0ff2632, 0x5f3d4d0c, 0xb40af60f, 0x5bc89d31,
+        0xaac3c6bc, 0x4501ad82, 0xae361681, 0x41f47dbf, 0xa32866c6, 0x4cea0df8, 0xa7ddb6fb, 0x481fddc5,
+        0xd1e70470, 0x3e256f4e, 0xd512d44d, 0x3ad0bf73, 0xd80ca40a, 0x37cecf34, 0xdcf97437, 0x333b1f09,
+        0xc2304484, 0x2df22fba, 0xc6c594b9, 0x2907ff87, 0xcbdbe4fe, 0x24198fc0, 0xcf2e34c3, 0x20ec5ffd,
+        0xf6498598, 0x198beea6, 0xf2bc55a5, 0x1d7e3e9b, 0xffa225e2, 0x10604edc, 0xfb57f5df, 0x14959ee1,
+        0xe59ec56c, 0x0a5cae52, 0xe16b1551, 0x0ea97e6f, 0xec756516, 0x03b70e28, 0xe880b52b, 0x0742de15,
+        0xe6050901, 0x09c7623f, 0xe2f0d93c, 0x0d32b202, 0xefeea97b, 0x002cc245, 0xeb1b7946, 0x04d91278,
+        0xf5d249f5, 0x1a1022cb, 0xf12799c8, 0x1ee5f2f6, 0xfc39e98f, 0x13fb82b1, 0xf8cc39b2, 0x170e528c,
+        0xc1ab88e9, 0x2e69e3d7, 0xc55e58d4, 0x2a9c33ea, 0xc8402893, 0x278243ad, 0xccb5f8ae, 0x23779390,
+        0xd27cc81d, 0x3dbea323, 0xd6891820, 0x394b731e, 0xdb976867, 0x34550359, 0xdf62b85a, 0x30a0d364,
+        0xa9580ad1, 0x469a61ef, 0xadaddaec, 0x426fb1d2, 0xa0b3aaab, 0x4f71c195, 0xa4467a96, 0x4b8411a8,
+        0xba8f4a25, 0x554d211b, 0xbe7a9a18, 0x51b8f126, 0xb364ea5f, 0x5ca68161, 0xb7913a62, 0x5853515c,
+        0x8ef68b39, 0x6134e007, 0x8a035b04, 0x65c1303a, 0x871d2b43, 0x68df407d, 0x83e8fb7e, 0x6c2a9040,
+        0x9d21cbcd, 0x72e3a0f3, 0x99d41bf0, 0x761670ce, 0x94ca6bb7, 0x7b080089, 0x903fbb8a, 0x7ffdd0b4,
+        0x78bf0ea1, 0x977d659f, 0x7c4ade9c, 0x9388b5a2, 0x7154aedb, 0x9e96c5e5, 0x75a17ee6, 0x9a6315d8,
+        0x6b684e55, 0x84aa256b, 0x6f9d9e68, 0x805ff556, 0x6283ee2f, 0x8d418511, 0x66763e12, 0x89b4552c,
+        0x5f118f49, 0xb0d3e477, 0x5be45f74, 0xb426344a, 0x56fa2f33, 0xb938440d, 0x520fff0e, 0xbdcd9430,
+        0x4cc6cfbd, 0xa304a483, 0x48331f80, 0xa7f174be, 0x452d6fc7, 0xaaef04f9, 0x41d8bffa, 0xae1ad4c4,
+        0x37e20d71, 0xd820664f, 0x3317dd4c, 0xdcd5b672, 0x3e09ad0b, 0xd1cbc635, 0x3afc7d36, 0xd53e1608,
+        0x24354d85, 0xcbf726bb, 0x20c09db8, 0xcf02f686, 0x2ddeedff, 0xc21c86c1, 0x292b3dc2, 0xc6e956fc,
+        0x104c8c99, 0xff8ee7a7, 0x14b95ca4, 0xfb7b379a, 0x19a72ce3, 0xf66547dd, 0x1d52fcde, 0xf29097e0,
+        0x039bcc6d, 0xec59a753, 0x076e1c50, 0xe8ac776e, 0x0a706c17, 0xe5b20729, 0x0e85bc2a, 0xe147d714
+    },
+    {
+        0x00000000, 0xc18edfc0, 0x586cb9c1, 0x99e26601, 0xb0d97382, 0x7157ac42, 0xe8b5ca43, 0x293b1583,
+        0xbac3e145, 0x7b4d3e85, 0xe2af5884, 0x23218744, 0x0a1a92c7, 0xcb944d07, 0x52762b06, 0x93f8f4c6,
+        0xaef6c4cb, 0x6f781b0b, 0xf69a7d0a, 0x3714a2ca, 0x1e2fb749, 0xdfa16889, 0x46430e88, 0x87cdd148,
+        0x1435258e, 0xd5bbfa4e, 0x4c599c4f, 0x8dd7438f, 0xa4ec560c, 0x656289cc, 0xfc80efcd, 0x3d0e300d,
+        0x869c8fd7, 0x47125017, 0xdef03616, 0x1f7ee9d6, 0x3645fc55, 0xf7cb2395, 0x6e294594, 0xafa79a54,
+        0x3c5f6e92, 0xfdd1b152, 0x6433d753, 0xa5bd0893, 0x8c861d10, 0x4d08c2d0, 0xd4eaa4d1, 0x15647b11,
+        0x286a4b1c, 0xe9e494dc, 0x7006f2dd, 0xb1882d1d, 0x98b3389e, 0x593de75e, 0xc0df815f, 0x01515e9f,
+        0x92a9aa59, 0x53277599, 0xcac51398, 0x0b4bcc58, 0x2270d9db, 0xe3fe061b, 0x7a1c601a, 0xbb92bfda,
+        0xd64819ef, 0x17c6c62f, 0x8e24a02e, 0x4faa7fee, 0x66916a6d, 0xa71fb5ad, 0x3efdd3ac, 0xff730c6c,
+        0x6c8bf8aa, 0xad05276a, 0x34e7416b, 0xf5699eab, 0xdc528b28, 0x1ddc54e8, 0x843e32e9, 0x45b0ed29,
+        0x78bedd24, 0xb93002e4, 0x20d264e5, 0xe15cbb25, 0xc867aea6, 0x09e97166, 0x900b1767, 0x5185c8a7,
+        0xc27d3c61, 0x03f3e3a1, 0x9a1185a0, 0x5b9f5a60, 0x72a44fe3, 0xb32a9023, 0x2ac8f622, 0xeb4629e2,
+        0x50d49638, 0x915a49f8, 0x08b82ff9, 0xc936f039, 0xe00de5ba, 0x21833a7a, 0xb8615c7b, 0x79ef83bb,
+        0xea17777d, 0x2b99a8bd, 0xb27bcebc, 0x73f5117c, 0x5ace04ff, 0x9b40db3f, 0x02a2bd3e, 0xc32c62fe,
+        0xfe2252f3, 0x3fac8d33, 0xa64eeb32, 0x67c034f2, 0x4efb2171, 0x8f75feb1, 0x169798b0, 0xd7194770,
+        0x44e1b3b6, 0x856f6c76, 0x1c8d0a77, 0xdd03d5b7, 0xf438c034, 0x35b61ff4, 0xac5479f5, 0x6ddaa635,
+        0x77e1359f, 0xb66fea5f, 0x2f8d8c5e, 0xee03539e, 0xc738461d, 0x06b699dd, 0x9f54ffdc, 0x5eda201c,
+        0xcd22d4da, 0x0cac0b1a, 0x954e6d1b, 0x54c0b2db, 0x7dfba758, 0xbc757898, 0x25971e99, 0xe419c159,
+        0xd917f154, 0x18992e94, 0x817b4895, 0x40f59755, 0x69ce82d6, 0xa8405d16, 0x31a23b17, 0xf02ce4d7,
+        0x63d41011, 0xa25acfd1, 0x3bb8a9d0, 0xfa367610, 0xd30d6393, 0x1283bc53, 0x8b61da52, 0x4aef0592,
+        0xf17dba48, 0x30f36588, 0xa9110389, 0x689fdc49, 0x41a4c9ca, 0x802a160a, 0x19c8700b, 0xd846afcb,
+        0x4bbe5b0d, 0x8a3084cd, 0x13d2e2cc, 0xd25c3d0c, 0xfb67288f, 0x3ae9f74f, 0xa30b914e, 0x62854e8e,
+        0x5f8b7e83, 0x9e05a143, 0x07e7c742, 0xc6691882, 0xef520d01, 0x2edcd2c1, 0xb73eb4c0, 0x76b06b00,
+        0xe5489fc6, 0x24c64006, 0xbd242607, 0x7caaf9c7, 0x5591ec44, 0x941f3384, 0x0dfd5585, 0xcc738a45,
+        0xa1a92c70, 0x6027f3b0, 0xf9c595b1, 0x384b4a71, 0x11705ff2, 0xd0fe8032, 0x491ce633, 0x889239f3,
+        0x1b6acd35, 0xdae412f5, 0x430674f4, 0x8288ab34, 0xabb3beb7, 0x6a3d6177, 0xf3df0776, 0x3251d8b6,
+        0x0f5fe8bb, 0xced1377b, 0x5733517a, 0x96bd8eba, 0xbf869b39, 0x7e0844f9, 0xe7ea22f8, 0x2664fd38,
+        0xb59c09fe, 0x7412d63e, 0xedf0b03f, 0x2c7e6fff, 0x05457a7c, 0xc4cba5bc, 0x5d29c3bd, 0x9ca71c7d,
+        0x2735a3a7, 0xe6bb7c67, 0x7f591a66, 0xbed7c5a6, 0x97ecd025, 0x56620fe5, 0xcf8069e4, 0x0e0eb624,
+        0x9df642e2, 0x5c789d22, 0xc59afb23, 0x041424e3, 0x2d2f3160, 0xeca1eea0, 0x754388a1, 0xb4cd5761,
+        0x89c3676c, 0x484db8ac, 0xd1afdead, 0x1021016d, 0x391a14ee, 0xf894cb2e, 0x6176ad2f, 0xa0f872ef,
+        0x33008629, 0xf28e59e9, 0x6b6c3fe8, 0xaae2e028, 0x83d9f5ab, 0x42572a6b, 0xdbb54c6a, 0x1a3b93aa
+    },
+    {
+        0x00000000, 0x9ba54c6f, 0xec3b9e9f, 0x779ed2f0, 0x03063b7f, 0x98a37710, 0xef3da5e0, 0x7498e98f,
+        0x060c76fe, 0x9da93a91, 0xea37e861, 0x7192a40e, 0x050a4d81, 0x9eaf01ee, 0xe931d31e, 0x72949f71,
+        0x0c18edfc, 0x97bda193, 0xe0237363, 0x7b863f0c, 0x0f1ed683, 0x94bb9aec, 0xe325481c, 0x78800473,
+        0x0a149b02, 0x91b1d76d, 0xe62f059d, 0x7d8a49f2, 0x0912a07d, 0x92b7ec12, 0xe5293ee2, 0x7e8c728d,
+        0x1831dbf8, 0x83949797, 0xf40a4567, 0x6faf0908, 0x1b37e087, 0x8092ace8, 0xf70c7e18, 0x6ca93277,
+        0x1e3dad06, 0x8598e169, 0xf2063399, 0x69a37ff6, 0x1d3b9679, 0x869eda16, 0xf10008e6, 0x6aa54489,
+        0x14293604, 0x8f8c7a6b, 0xf812a89b, 0x63b7e4f4, 0x172f0d7b, 0x8c8a4114, 0xfb1493e4, 0x60b1df8b,
+        0x122540fa, 0x89800c95, 0xfe1ede65, 0x65bb920a, 0x11237b85, 0x8a8637ea, 0xfd18e51a, 0x66bda975,
+        0x3063b7f0, 0xabc6fb9f, 0xdc58296f, 0x47fd6500, 0x33658c8f, 0xa8c0c0e0, 0xdf5e1210, 0x44fb5e7f,
+        0x366fc10e, 0xadca8d61, 0xda545f91, 0x41f113fe, 0x3569fa71, 0xaeccb61e, 0xd95264ee, 0x42f72881,
+        0x3c7b5a0c, 0xa7de1663, 0xd040c493, 0x4be588fc, 0x3f7d6173, 0xa4d82d1c, 0xd346ffec, 0x48e3b383,
+        0x3a772cf2, 0xa1d2609d, 0xd64cb26d, 0x4de9fe02, 0x3971178d, 0xa2d45be2, 0xd54a8912, 0x4eefc57d,
+        0x28526c08, 0xb3f72067, 0xc469f297, 0x5fccbef8, 0x2b545777, 0xb0f11b18, 0xc76fc9e8, 0x5cca8587,
+        0x2e5e1af6, 0xb5fb5699, 0xc2658469, 0x59c0c806, 0x2d582189, 0xb6fd6de6, 0xc163bf16, 0x5ac6f379,
+        0x244a81f4, 0xbfefcd9b, 0xc8711f6b, 0x53d45304, 0x274cba8b, 0xbce9f6e4, 0xcb772414, 0x50d2687b,
+        0x2246f70a, 0xb9e3bb65, 0xce7d6995, 0x55d825fa, 0x2140cc75, 0xbae5801a, 0xcd7b52ea, 0x56de1e85,
+        0x60c76fe0, 0xfb62238f, 0x8cfcf17f, 0x1759bd10, 0x63c1549f, 0xf86418f0, 0x8ffaca00, 0x145f866f,
+        0x66cb191e, 0xfd6e5571, 0x8af08781, 0x1155cbee, 0x65cd2261, 0xfe686e0e, 0x89f6bcfe, 0x1253f091,
+        0x6cdf821c, 0xf77ace73, 0x80e41c83, 0x1b4150ec, 0x6fd9b963, 0xf47cf50c, 0x83e227fc, 0x18476b93,
+        0x6ad3f4e2, 0xf176b88d, 0x86e86a7d, 0x1d4d2612, 0x69d5cf9d, 0xf27083f2, 0x85ee5102, 0x1e4b1d6d,
+        0x78f6b418, 0xe353f877, 0x94cd2a87, 0x0f6866e8, 0x7bf08f67, 0xe055c308, 0x97cb11f8, 0x0c6e5d97,
+        0x7efac2e6, 0xe55f8e89, 0x92c15c79, 0x09641016, 0x7dfcf999, 0xe659b5f6, 0x91c76706, 0x0a622b69,
+        0x74ee59e4, 0xef4b158b, 0x98d5c77b, 0x03708b14, 0x77e8629b, 0xec4d2ef4, 0x9bd3fc04, 0x0076b06b,
+        0x72e22f1a, 0xe9476375, 0x9ed9b185, 0x057cfdea, 0x71e41465, 0xea41580a, 0x9ddf8afa, 0x067ac695,
+        0x50a4d810, 0xcb01947f, 0xbc9f468f, 0x273a0ae0, 0x53a2e36f, 0xc807af00, 0xbf997df0, 0x243c319f,
+        0x56a8aeee, 0xcd0de281, 0xba933071, 0x21367c1e, 0x55ae9591, 0xce0bd9fe, 0xb9950b0e, 0x22304761,
+        0x5cbc35ec, 0xc7197983, 0xb087ab73, 0x2b22e71c, 0x5fba0e93, 0xc41f42fc, 0xb381900c, 0x2824dc63,
+        0x5ab04312, 0xc1150f7d, 0xb68bdd8d, 0x2d2e91e2, 0x59b6786d, 0xc2133402, 0xb58de6f2, 0x2e28aa9d,
+        0x489503e8, 0xd3304f87, 0xa4ae9d77, 0x3f0bd118, 0x4b933897, 0xd03674f8, 0xa7a8a608, 0x3c0dea67,
+        0x4e997516, 0xd53c3979, 0xa2a2eb89, 0x3907a7e6, 0x4d9f4e69, 0xd63a0206, 0xa1a4d0f6, 0x3a019c99,
+        0x448dee14, 0xdf28a27b, 0xa8b6708b, 0x33133ce4, 0x478bd56b, 0xdc2e9904, 0xabb04bf4, 0x3015079b,
+        0x428198ea, 0xd924d485, 0xaeba0675, 0x351f4a1a, 0x4187a395, 0xda22effa, 0xadbc3d0a, 0x36197165
+    },
+    {
+        0x00000000, 0xdd96d985, 0x605cb54b, 0xbdca6cce, 0xc0b96a96, 0x1d2fb313, 0xa0e5dfdd, 0x7d730658,
+        0x5a03d36d, 0x87950ae8, 0x3a5f6626, 0xe7c9bfa3, 0x9abab9fb, 0x472c607e, 0xfae60cb0, 0x2770d535,
+        0xb407a6da, 0x69917f5f, 0xd45b1391, 0x09cdca14, 0x74becc4c, 0xa92815c9, 0x14e27907, 0xc974a082,
+        0xee0475b7, 0x3392ac32, 0x8e58c0fc, 0x53ce1979, 0x2ebd1f21, 0xf32bc6a4, 0x4ee1aa6a, 0x937773ef,
+        0xb37e4bf5, 0x6ee89270, 0xd322febe, 0x0eb4273b, 0x73c72163, 0xae51f8e6, 0x139b9428, 0xce0d4dad,
+        0xe97d9898, 0x34eb411d, 0x89212dd3, 0x54b7f456, 0x29c4f20e, 0xf4522b8b, 0x49984745, 0x940e9ec0,
+        0x0779ed2f, 0xdaef34aa, 0x67255864, 0xbab381e1, 0xc7c087b9, 0x1a565e3c, 0xa79c32f2, 0x7a0aeb77,
+        0x5d7a3e42, 0x80ece7c7, 0x3d268b09, 0xe0b0528c, 0x9dc354d4, 0x40558d51, 0xfd9fe19f, 0x2009381a,
+        0xbd8d91ab, 0x601b482e, 0xddd124e0, 0x0047fd65, 0x7d34fb3d, 0xa0a222b8, 0x1d684e76, 0xc0fe97f3,
+        0xe78e42c6, 0x3a189b43, 0x87d2f78d, 0x5a442e08, 0x27372850, 0xfaa1f1d5, 0x476b9d1b, 0x9afd449e,
+        0x098a3771, 0xd41ceef4, 0x69d6823a, 0xb4405bbf, 0xc9335de7, 0x14a58462, 0xa96fe8ac, 0x74f93129,
+        0x5389e41c, 0x8e1f3d99, 0x33d55157, 0xee4388d2, 0x93308e8a, 0x4ea6570f, 0xf36c3bc1, 0x2efae244,
+        0x0ef3da5e, 0xd36503db, 0x6eaf6f15, 0xb339b690, 0xce4ab0c8, 0x13dc694d, 0xae160583, 0x7380dc06,
+        0x54f00933, 0x8966d0b6, 0x34acbc78, 0xe93a65fd, 0x944963a5, 0x49dfba20, 0xf415d6ee, 0x29830f6b,
+        0xbaf47c84, 0x6762a501, 0xdaa8c9cf, 0x073e104a, 0x7a4d1612, 0xa7dbcf97, 0x1a11a359, 0xc7877adc,
+        0xe0f7afe9, 0x3d61766c, 0x80ab1aa2, 0x5d3dc327, 0x204ec57f, 0xfdd81cfa, 0x40127034, 0x9d84a9b1,
+        0xa06a2517, 0x7dfcfc92, 0xc036905c, 0x1da049d9, 0x60d34f81, 0xbd459604, 0x008ffaca, 0xdd19234f,
+        0xfa69f67a, 0x27ff2fff, 0x9a354331, 0x47a39ab4, 0x3ad09cec, 0xe7464569, 0x5a8c29a7, 0x871af022,
+        0x146d83cd, 0xc9fb5a48, 0x74313686, 0xa9a7ef03, 0xd4d4e95b, 0x094230de, 0xb4885c10, 0x691e8595,
+        0x4e6e50a0, 0x93f88925, 0x2e32e5eb, 0xf3a43c6e, 0x8ed73a36, 0x5341e3b3, 0xee8b8f7d, 0x331d56f8,
+        0x13146ee2, 0xce82b767, 0x7348dba9, 0xaede022c, 0xd3ad0474, 0x0e3bddf1, 0xb3f1b13f, 0x6e6768ba,
+        0x4917bd8f, 0x9481640a, 0x294b08c4, 0xf4ddd141, 0x89aed719, 0x54380e9c, 0xe9f26252, 0x3464bbd7,
+        0xa713c838, 0x7a8511bd, 0xc74f7d73, 0x1ad9a4f6, 0x67aaa2ae, 0xba3c7b2b, 0x07f617e5, 0xda60ce60,
+        0xfd101b55, 0x2086c2d0, 0x9d4cae1e, 0x40da779b, 0x3da971c3, 0xe03fa846, 0x5df5c488, 0x80631d0d,
+        0x1de7b4bc, 0xc0716d39, 0x7dbb01f7, 0xa02dd872, 0xdd5ede2a, 0x00c807af, 0xbd026b61, 0x6094b2e4,
+        0x47e467d1, 0x9a72be54, 0x27b8d29a, 0xfa2e0b1f, 0x875d0d47, 0x5acbd4c2, 0xe701b80c, 0x3a976189,
+        0xa9e01266, 0x7476cbe3, 0xc9bca72d, 0x142a7ea8, 0x695978f0, 0xb4cfa175, 0x0905cdbb, 0xd493143e,
+        0xf3e3c10b, 0x2e75188e, 0x93bf7440, 0x4e29adc5, 0x335aab9d, 0xeecc7218, 0x53061ed6, 0x8e90c753,
+        0xae99ff49, 0x730f26cc, 0xcec54a02, 0x13539387, 0x6e2095df, 0xb3b64c5a, 0x0e7c2094, 0xd3eaf911,
+        0xf49a2c24, 0x290cf5a1, 0x94c6996f, 0x495040ea, 0x342346b2, 0xe9b59f37, 0x547ff3f9, 0x89e92a7c,
+        0x1a9e5993, 0xc7088016, 0x7ac2ecd8, 0xa754355d, 0xda273305, 0x07b1ea80, 0xba7b864e, 0x67ed5fcb,
+        0x409d8afe, 0x9d0b537b, 0x20c13fb5, 0xfd57e630, 0x8024e068, 0x5db239ed, 0xe0785523, 0x3dee8ca6
+    },
+    {
+        0x00000000, 0x9d0fe176, 0xe16ec4ad, 0x7c6125db, 0x19ac8f1b, 0x84a36e6d, 0xf8c24bb6, 0x65cdaac0,
+        0x33591e36, 0xae56ff40, 0xd237da9b, 0x4f383bed, 0x2af5912d, 0xb7fa705b, 0xcb9b5580, 0x5694b4f6,
+        0x66b23c6c, 0xfbbddd1a, 0x87dcf8c1, 0x1ad319b7, 0x7f1eb377, 0xe2115201, 0x9e7077da, 0x037f96ac,
+        0x55eb225a, 0xc8e4c32c, 0xb485e6f7, 0x298a0781, 0x4c47ad41, 0xd1484c37, 0xad2969ec, 0x3026889a,
+        0xcd6478d8, 0x506b99ae, 0x2c0abc75, 0xb1055d03, 0xd4c8f7c3, 0x49c716b5, 0x35a6336e, 0xa8a9d218,
+        0xfe3d66ee, 0x63328798, 0x1f53a243, 0x825c4335, 0xe791e9f5, 0x7a9e0883, 0x06ff2d58, 0x9bf0cc2e,
+        0xabd644b4, 0x36d9a5c2, 0x4ab88019, 0xd7b7616f, 0xb27acbaf, 0x2f752ad9, 0x53140f02, 0xce1bee74,
+        0x988f5a82, 0x0580bbf4, 0x79e19e2f, 0xe4ee7f59, 0x8123d599, 0x1c2c34ef, 0x604d1134, 0xfd42f042,
+        0x41b9f7f1, 0xdcb61687, 0xa0d7335c, 0x3dd8d22a, 0x581578ea, 0xc51a999c, 0xb97bbc47, 0x24745d31,
+        0x72e0e9c7, 0xefef08b1, 0x938e2d6a, 0x0e81cc1c, 0x6b4c66dc, 0xf64387aa, 0x8a22a271, 0x172d4307,
+        0x270bcb9d, 0xba042aeb, 0xc6650f30, 0x5b6aee46, 0x3ea74486, 0xa3a8a5f0, 0xdfc9802b, 0x42c6615d,
+        0x1452d5ab, 0x895d34dd, 0xf53c1106, 0x6833f070, 0x0dfe5ab0, 0x90f1bbc6, 0xec909e1d, 0x719f7f6b,
+        0x8cdd8f29, 0x11d26e5f, 0x6db34b84, 0xf0bcaaf2, 0x95710032, 0x087ee144, 0x741fc49f, 0xe91025e9,
+        0xbf84911f, 0x228b7069, 0x5eea55b2, 0xc3e5b4c4, 0xa6281e04, 0x3b27ff72, 0x4746daa9, 0xda493bdf,
+        0xea6fb345, 0x77605233, 0x0b0177e8, 0x960e969e, 0xf3c33c5e, 0x6eccdd28, 0x12adf8f3, 0x8fa21985,
+        0xd936ad73, 0x44394c05, 0x385869de, 0xa55788a8, 0xc09a2268, 0x5d95c31e, 0x21f4e6c5, 0xbcfb07b3,
+        0x8373efe2, 0x1e7c0e94, 0x621d2b4f, 0xff12ca39, 0x9adf60f9, 0x07d0818f, 0x7bb1a454, 0xe6be4522,
+        0xb02af1d4, 0x2d2510a2, 0x51443579, 0xcc4bd40f, 0xa9867ecf, 0x34899fb9, 0x48e8ba62, 0xd5e75b14,
+        0xe5c1d38e, 0x78ce32f8, 0x04af1723, 0x99a0f655, 0xfc6d5c95, 0x6162bde3, 0x1d039838, 0x800c794e,
+        0xd698cdb8, 0x4b972cce, 0x37f60915, 0xaaf9e863, 0xcf3442a3, 0x523ba3d5, 0x2e5a860e, 0xb3556778,
+        0x4e17973a, 0xd318764c, 0xaf795397, 0x3276b2e1, 0x57bb1821, 0xcab4f957, 0xb6d5dc8c, 0x2bda3dfa,
+        0x7d4e890c, 0xe041687a, 0x9c204da1, 0x012facd7, 0x64e20617, 0xf9ede761, 0x858cc2ba, 0x188323cc,
+        0x28a5ab56, 0xb5aa4a20, 0xc9cb6ffb, 0x54c48e8d, 0x3109244d, 0xac06c53b, 0xd067e0e0, 0x4d680196,
+        0x1bfcb560, 0x86f35416, 0xfa9271cd, 0x679d90bb, 0x02503a7b, 0x9f5fdb0d, 0xe33efed6, 0x7e311fa0,
+        0xc2ca1813, 0x5fc5f965, 0x23a4dcbe, 0xbeab3dc8, 0xdb669708, 0x4669767e, 0x3a0853a5, 0xa707b2d3,
+        0xf1930625, 0x6c9ce753, 0x10fdc288, 0x8df223fe, 0xe83f893e, 0x75306848, 0x09514d93, 0x945eace5,
+        0xa478247f, 0x3977c509, 0x4516e0d2, 0xd81901a4, 0xbdd4ab64, 0x20db4a12, 0x5cba6fc9, 0xc1b58ebf,
+        0x97213a49, 0x0a2edb3f, 0x764ffee4, 0xeb401f92, 0x8e8db552, 0x13825424, 0x6fe371ff, 0xf2ec9089,
+        0x0fae60cb, 0x92a181bd, 0xeec0a466, 0x73cf4510, 0x1602efd0, 0x8b0d0ea6, 0xf76c2b7d, 0x6a63ca0b,
+        0x3cf77efd, 0xa1f89f8b, 0xdd99ba50, 0x40965b26, 0x255bf1e6, 0xb8541090, 0xc435354b, 0x593ad43d,
+        0x691c5ca7, 0xf413bdd1, 0x8872980a, 0x157d797c, 0x70b0d3bc, 0xedbf32ca, 0x91de1711, 0x0cd1f667,
+        0x5a454291, 0xc74aa3e7, 0xbb2b863c, 0x2624674a, 0x43e9cd8a, 0xdee62cfc, 0xa2870927, 0x3f88e851
+    },
+    {
+        0x00000000, 0xb9fbdbe8, 0xa886b191, 0x117d6a79, 0x8a7c6563, 0x3387be8b, 0x22fad4f2, 0x9b010f1a,
+        0xcf89cc87, 0x7672176f, 0x670f7d16, 0xdef4a6fe, 0x45f5a9e4, 0xfc0e720c, 0xed731875, 0x5488c39d,
+        0x44629f4f, 0xfd9944a7, 0xece42ede, 0x551ff536, 0xce1efa2c, 0x77e521c4, 0x66984bbd, 0xdf639055,
+        0x8beb53c8, 0x32108820, 0x236de259, 0x9a9639b1, 0x019736ab, 0xb86ced43, 0xa911873a, 0x10ea5cd2,
+        0x88c53e9e, 0x313ee576, 0x20438f0f, 0x99b854e7, 0x02b95bfd, 0xbb428015, 0xaa3fea6c, 0x13c43184,
+        0x474cf219, 0xfeb729f1, 0xefca4388, 0x56319860, 0xcd30977a, 0x74cb4c92, 0x65b626eb, 0xdc4dfd03,
+        0xcca7a1d1, 0x755c7a39, 0x64211040, 0xdddacba8, 0x46dbc4b2, 0xff201f5a, 0xee5d7523, 0x57a6aecb,
+        0x032e6d56, 0xbad5b6be, 0xaba8dcc7, 0x1253072f, 0x89520835, 0x30a9d3dd, 0x21d4b9a4, 0x982f624c,
+        0xcafb7b7d, 0x7300a095, 0x627dcaec, 0xdb861104, 0x40871e1e, 0xf97cc5f6, 0xe801af8f, 0x51fa7467,
+        0x0572b7fa, 0xbc896c12, 0xadf4066b, 0x140fdd83, 0x8f0ed299, 0x36f50971, 0x27886308, 0x9e73b8e0,
+        0x8e99e432, 0x37623fda, 0x261f55a3, 0x9fe48e4b, 0x04e58151, 0xbd1e5ab9, 0xac6330c0, 0x1598eb28,
+        0x411028b5, 0xf8ebf35d, 0xe9969924, 0x506d42cc, 0xcb6c4dd6, 0x7297963e, 0x63eafc47, 0xda1127af,
+        0x423e45e3, 0xfbc59e0b, 0xeab8f472, 0x53432f9a, 0xc8422080, 0x71b9fb68, 0x60c49111, 0xd93f4af9,
+        0x8db78964, 0x344c528c, 0x253138f5, 0x9ccae31d, 0x07cbec07, 0xbe3037ef, 0xaf4d5d96, 0x16b6867e,
+        0x065cdaac, 0xbfa70144, 0xaeda6b3d, 0x1721b0d5, 0x8c20bfcf, 0x35db6427, 0x24a60e5e, 0x9d5dd5b6,
+        0xc9d5162b, 0x702ecdc3, 0x6153a7ba, 0xd8a87c52, 0x43a97348, 0xfa52a8a0, 0xeb2fc2d9, 0x52d41931,
+        0x4e87f0bb, 0xf77c2b53, 0xe601412a, 0x5ffa9ac2, 0xc4fb95d8, 0x7d004e30, 0x6c7d2449, 0xd586ffa1,
+        0x810e3c3c, 0x38f5e7d4, 0x29888dad, 0x90735645, 0x0b72595f, 0xb28982b7, 0xa3f4e8ce, 0x1a0f3326,
+        0x0ae56ff4, 0xb31eb41c, 0xa263de65, 0x1b98058d, 0x80990a97, 0x3962d17f, 0x281fbb06, 0x91e460ee,
+        0xc56ca373, 0x7c97789b, 0x6dea12e2, 0xd411c90a, 0x4f10c610, 0xf6eb1df8, 0xe7967781, 0x5e6dac69,
+        0xc642ce25, 0x7fb915cd, 0x6ec47fb4, 0xd73fa45c, 0x4c3eab46, 0xf5c570ae, 0xe4b81ad7, 0x5d43c13f,
+        0x09cb02a2, 0xb030d94a, 0xa14db333, 0x18b668db, 0x83b767c1, 0x3a4cbc29, 0x2b31d650, 0x92ca0db8,
+        0x8220516a, 0x3bdb8a82, 0x2aa6e0fb, 0x935d3b13, 0x085c3409, 0xb1a7efe1, 0xa0da8598, 0x19215e70,
+        0x4da99ded, 0xf4524605, 0xe52f2c7c, 0x5cd4f794, 0xc7d5f88e, 0x7e2e2366, 0x6f53491f, 0xd6a892f7,
+        0x847c8bc6, 0x3d87502e, 0x2cfa3a57, 0x9501e1bf, 0x0e00eea5, 0xb7fb354d, 0xa6865f34, 0x1f7d84dc,
+        0x4bf54741, 0xf20e9ca9, 0xe373f6d0, 0x5a882d38, 0xc1892222, 0x7872f9ca, 0x690f93b3, 0xd0f4485b,
+        0xc01e1489, 0x79e5cf61, 0x6898a518, 0xd1637ef0, 0x4a6271ea, 0xf399aa02, 0xe2e4c07b, 0x5b1f1b93,
+        0x0f97d80e, 0xb66c03e6, 0xa711699f, 0x1eeab277, 0x85ebbd6d, 0x3c106685, 0x2d6d0cfc, 0x9496d714,
+        0x0cb9b558, 0xb5426eb0, 0xa43f04c9, 0x1dc4df21, 0x86c5d03b, 0x3f3e0bd3, 0x2e4361aa, 0x97b8ba42,
+        0xc33079df, 0x7acba237, 0x6bb6c84e, 0xd24d13a6, 0x494c1cbc, 0xf0b7c754, 0xe1caad2d, 0x583176c5,
+        0x48db2a17, 0xf120f1ff, 0xe05d9b86, 0x59a6406e, 0xc2a74f74, 0x7b5c949c, 0x6a21fee5, 0xd3da250d,
+        0x8752e690, 0x3ea93d78, 0x2fd45701, 0x962f8ce9, 0x0d2e83f3, 0xb4d5581b, 0xa5a83262, 0x1c53e98a
+    },
+    {
+        0x00000000, 0xae689191, 0x87a02563, 0x29c8b4f2, 0xd4314c87, 0x7a59dd16, 0x539169e4, 0xfdf9f875,
+        0x73139f4f, 0xdd7b0ede, 0xf4b3ba2c, 0x5adb2bbd, 0xa722d3c8, 0x094a4259, 0x2082f6ab, 0x8eea673a,
+        0xe6273e9e, 0x484faf0f, 0x61871bfd, 0xcfef8a6c, 0x32167219, 0x9c7ee388, 0xb5b6577a, 0x1bdec6eb,
+        0x9534a1d1, 0x3b5c3040, 0x129484b2, 0xbcfc1523, 0x4105ed56, 0xef6d7cc7, 0xc6a5c835, 0x68cd59a4,
+        0x173f7b7d, 0xb957eaec, 0x909f5e1e, 0x3ef7cf8f, 0xc30e37fa, 0x6d66a66b, 0x44ae1299, 0xeac68308,
+        0x642ce432, 0xca4475a3, 0xe38cc151, 0x4de450c0, 0xb01da8b5, 0x1e753924, 0x37bd8dd6, 0x99d51c47,
+        0xf11845e3, 0x5f70d472, 0x76b86080, 0xd8d0f111, 0x25290964, 0x8b4198f5, 0xa2892c07, 0x0ce1bd96,
+        0x820bdaac, 0x2c634b3d, 0x05abffcf, 0xabc36e5e, 0x563a962b, 0xf85207ba, 0xd19ab348, 0x7ff222d9,
+        0x2e7ef6fa, 0x8016676b, 0xa9ded399, 0x07b64208, 0xfa4fba7d, 0x54272bec, 0x7def9f1e, 0xd3870e8f,
+        0x5d6d69b5, 0xf305f824, 0xdacd4cd6, 0x74a5dd47, 0x895c2532, 0x2734b4a3, 0x0efc0051, 0xa09491c0,
+        0xc859c864, 0x663159f5, 0x4ff9ed07, 0xe1917c96, 0x1c6884e3, 0xb2001572, 0x9bc8a180, 0x35a03011,
+        0xbb4a572b, 0x1522c6ba, 0x3cea7248, 0x9282e3d9, 0x6f7b1bac, 0xc1138a3d, 0xe8db3ecf, 0x46b3af5e,
+        0x39418d87, 0x97291c16, 0xbee1a8e4, 0x10893975, 0xed70c100, 0x43185091, 0x6ad0e463, 0xc4b875f2,
+        0x4a5212c8, 0xe43a8359, 0xcdf237ab, 0x639aa63a, 0x9e635e4f, 0x300bcfde, 0x19c37b2c, 0xb7abeabd,
+        0xdf66b319, 0x710e2288, 0x58c6967a, 0xf6ae07eb, 0x0b57ff9e, 0xa53f6e0f, 0x8cf7dafd, 0x229f4b6c,
+        0xac752c56, 0x021dbdc7, 0x2bd50935, 0x85bd98a4, 0x784460d1, 0xd62cf140, 0xffe445b2, 0x518cd423,
+        0x5cfdedf4, 0xf2957c65, 0xdb5dc897, 0x75355906, 0x88cca173, 0x26a430e2, 0x0f6c8410, 0xa1041581,
+        0x2fee72bb, 0x8186e32a, 0xa84e57d8, 0x0626c649, 0xfbdf3e3c, 0x55b7afad, 0x7c7f1b5f, 0xd2178ace,
+        0xbadad36a, 0x14b242fb, 0x3d7af609, 0x93126798, 0x6eeb9fed, 0xc0830e7c, 0xe94bba8e, 0x47232b1f,
+        0xc9c94c25, 0x67a1ddb4, 0x4e696946, 0xe001f8d7, 0x1df800a2, 0xb3909133, 0x9a5825c1, 0x3430b450,
+        0x4bc29689, 0xe5aa0718, 0xcc62b3ea, 0x620a227b, 0x9ff3da0e, 0x319b4b9f, 0x1853ff6d, 0xb63b6efc,
+        0x38d109c6, 0x96b99857, 0xbf712ca5, 0x1119bd34, 0xece04541, 0x4288d4d0, 0x6b406022, 0xc528f1b3,
+        0xade5a817, 0x038d3986, 0x2a458d74, 0x842d1ce5, 0x79d4e490, 0xd7bc7501, 0xfe74c1f3, 0x501c5062,
+        0xdef63758, 0x709ea6c9, 0x5956123b, 0xf73e83aa, 0x0ac77bdf, 0xa4afea4e, 0x8d675ebc, 0x230fcf2d,
+        0x72831b0e, 0xdceb8a9f, 0xf5233e6d, 0x5b4baffc, 0xa6b25789, 0x08dac618, 0x211272ea, 0x8f7ae37b,
+        0x01908441, 0xaff815d0, 0x8630a122, 0x285830b3, 0xd5a1c8c6, 0x7bc95957, 0x5201eda5, 0xfc697c34,
+        0x94a42590, 0x3accb401, 0x130400f3, 0xbd6c9162, 0x40956917, 0xeefdf886, 0xc7354c74, 0x695ddde5,
+        0xe7b7badf, 0x49df2b4e, 0x60179fbc, 0xce7f0e2d, 0x3386f658, 0x9dee67c9, 0xb426d33b, 0x1a4e42aa,
+        0x65bc6073, 0xcbd4f1e2, 0xe21c4510, 0x4c74d481, 0xb18d2cf4, 0x1fe5bd65, 0x362d0997, 0x98459806,
+        0x16afff3c, 0xb8c76ead, 0x910fda5f, 0x3f674bce, 0xc29eb3bb, 0x6cf6222a, 0x453e96d8, 0xeb560749,
+        0x839b5eed, 0x2df3cf7c, 0x043b7b8e, 0xaa53ea1f, 0x57aa126a, 0xf9c283fb, 0xd00a3709, 0x7e62a698,
+        0xf088c1a2, 0x5ee05033, 0x7728e4c1, 0xd9407550, 0x24b98d25, 0x8ad11cb4, 0xa319a846, 0x0d7139d7
     }
+};
 
-    memcpy(buffer, d + file->data_offset, (size_t)file->packed_size);
-    if (status) *status = PAS_RAR_OK;
-    return (size_t)file->unpacked_size;
+static uint32_t pas_rar__crc_slice16(uint32_t crc, const uint8_t *p, size_t len)
+{
+    while (len >= 16) {
+        uint32_t a = crc ^ pas_rar__u32le(p), b = pas_rar__u32le(p + 4);
+        uint32_t c = pas_rar__u32le(p + 8), d = pas_rar__u32le(p + 12);
+        crc = pas_rar__crc_table[15][a & 0xFF] ^ pas_rar__crc_table[14][(a >> 8) & 0xFF] ^
+              pas_rar__crc_table[13][(a >> 16) & 0xFF] ^ pas_rar__crc_table[12][a >> 24] ^
+              pas_rar__crc_table[11][b & 0xFF] ^ pas_rar__crc_table[10][(b >> 8) & 0xFF] ^
+              pas_rar__crc_table[9][(b >> 16) & 0xFF] ^ pas_rar__crc_table[8][b >> 24] ^
+              pas_rar__crc_table[7][c & 0xFF] ^ pas_rar__crc_table[6][(c >> 8) & 0xFF] ^
+              pas_rar__crc_table[5][(c >> 16) & 0xFF] ^ pas_rar__crc_table[4][c >> 24] ^
+              pas_rar__crc_table[3][d & 0xFF] ^ pas_rar__crc_table[2][(d >> 8) & 0xFF] ^
+              pas_rar__crc_table[1][(d >> 16) & 0xFF] ^ pas_rar__crc_table[0][d >> 24];
+        p += 16;
+        len -= 16;
+    }
+    while (len--) crc = (crc >> 8) ^ pas_rar__crc_table[0][(crc ^ *p++) & 0xFF];
+    return crc;
 }
 
-int pas_rar_list(pas_rar_t *rar, void (*callback)(const char *name, uint64_t size, void *user), void *user)
+#ifdef PAS_RAR_X86
+/* len >= 64 and a multiple of 16. Folds four 128-bit lanes, then one, then Barrett-reduces. */
+PAS_RAR_TARGET_PCLMUL
+static uint32_t pas_rar__crc_pclmul(uint32_t crc, const uint8_t *p, size_t len)
 {
-    if (!rar || !callback) return -1;
-    if (rar->format == 4)
-        return pas_rar__iterate4(rar, NULL, NULL, callback, user) ? 0 : -1;
-    if (rar->format == 5)
-        return pas_rar__iterate5(rar, NULL, NULL, callback, user) ? 0 : -1;
-    return -1;
+    /* 33-bit folding constants as (low, high) 32-bit halves of each 64-bit lane */
+    static const uint32_t k[4][4] = {
+        { 0x54442bd4u, 1, 0xc6e41596u, 1 },  /* k1, k2: fold by 512 bits */
+        { 0x751997d0u, 1, 0xccaa009eu, 0 },  /* k3, k4: fold by 128 bits */
+        { 0x63cd6124u, 1, 0, 0 },            /* k5: 64 -> 32 */
+        { 0xdb710641u, 1, 0xf7011641u, 1 }   /* P(x), mu: Barrett reduction */
+    };
+    const __m128i k1k2 = _mm_loadu_si128((const __m128i *)k[0]);
+    const __m128i k3k4 = _mm_loadu_si128((const __m128i *)k[1]);
+    const __m128i k5k0 = _mm_loadu_si128((const __m128i *)k[2]);
+    const __m128i poly = _mm_loadu_si128((const __m128i *)k[3]);
+    const __m128i mask32 = _mm_setr_epi32(-1, 0, -1, 0);
+    __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8;
+
+    x1 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)p), _mm_cvtsi32_si128((int)crc));
+    x2 = _mm_loadu_si128((const __m128i *)(p + 16));
+    x3 = _mm_loadu_si128((const __m128i *)(p + 32));
+    x4 = _mm_loadu_si128((const __m128i *)(p + 48));
+    p += 64;
+    len -= 64;
+
+    x0 = k1k2;
+    while (len >= 64) {
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+        x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+        x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((const __m128i *)p));
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128((const __m128i *)(p + 16)));
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128((const __m128i *)(p + 32)));
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128((const __m128i *)(p + 48)));
+        p += 64;
+        len -= 64;
+    }
+
+    /* Fold the four lanes into one */
+    x0 = k3k4;
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, x0, 0x11), x2), x5);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, x0, 0x11), x3), x5);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, x0, 0x11), x4), x5);
+    while (len >= 16) {
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128((const __m128i *)p)), x5);
+        p += 16;
+        len -= 16;
+    }
+
+    /* 128 -> 64 bits */
+    x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, mask32);
+    x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, k5k0, 0x00), x2);
+
+    /* Barrett reduction to 32 bits */
+    x2 = _mm_and_si128(x1, mask32);
+    x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+    x2 = _mm_and_si128(x2, mask32);
+    x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+    return (uint32_t)_mm_extract_epi32(x1, 1);
+}
+#endif /* PAS_RAR_X86 */
+
+uint32_t pas_rar_crc32(uint32_t crc, const void *data, size_t len)
+{
+    const uint8_t *p = (const uint8_t *)data;
+
+    if (!data) return crc;
+    crc = ~crc;
+#if defined(PAS_RAR_X86)
+    if (len >= 64 && (pas_rar__cpu() & PAS_RAR__CPU_PCLMUL)) {
+        size_t n = len & ~(size_t)15;
+        crc = pas_rar__crc_pclmul(crc, p, n);
+        p += n;
+        len -= n;
+    }
+#elif defined(PAS_RAR_CRC_ARM)
+    while (len >= 8) {
+        uint64_t v;
+        memcpy(&v, p, 8);
+        crc = __crc32d(crc, v);
+        p += 8;
+        len -= 8;
+    }
+    while (len--) crc = __crc32b(crc, *p++);
+#endif
+    crc = pas_rar__crc_slice16(crc, p, len);
+    return ~crc;
+}
+
+static const uint32_t pas_rar__b2s_iv[8] = {
+    0x6a09e667u, 0xbb67ae85u, 0x3c6ef372u, 0xa54ff53au, 0x510e527fu, 0x9b05688cu, 0x1f83d9abu, 0x5be0cd19u
+};
+
+static const uint8_t pas_rar__b2s_sigma[10][16] = {
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+    { 14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3 },
+    { 11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4 },
+    { 7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8 },
+    { 9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13 },
+    { 2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9 },
+    { 12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11 },
+    { 13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10 },
+    { 6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5 },
+    { 10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0 }
+};
+
+#define PAS_RAR__B2S_G(a, b, c, d, x, y) do { \
+    a += b + (x); d = PAS_RAR__ROTR32(d ^ a, 16); c += d; b = PAS_RAR__ROTR32(b ^ c, 12); \
+    a += b + (y); d = PAS_RAR__ROTR32(d ^ a, 8);  c += d; b = PAS_RAR__ROTR32(b ^ c, 7); \
+} while (0)
+
+/* One BLAKE2s compression of block into h: t counts the bytes hashed including this block, f0 / f1
+   are the last-block and last-node flags */
+static void pas_rar__b2s_compress(uint32_t h[8], const uint8_t *block, uint64_t t, uint32_t f0, uint32_t f1)
+{
+    uint32_t m[16], v[16];
+    unsigned i;
+
+    for (i = 0; i < 16; i++) m[i] = pas_rar__u32le(block + 4 * i);
+    for (i = 0; i < 8; i++) {
+        v[i] = h[i];
+        v[i + 8] = pas_rar__b2s_iv[i];
+    }
+    v[12] ^= (uint32_t)t;
+    v[13] ^= (uint32_t)(t >> 32);
+    v[14] ^= f0;
+    v[15] ^= f1;
+    for (i = 0; i < 10; i++) {
+        const uint8_t *s = pas_rar__b2s_sigma[i];
+        PAS_RAR__B2S_G(v[0], v[4], v[8], v[12], m[s[0]], m[s[1]]);
+        PAS_RAR__B2S_G(v[1], v[5], v[9], v[13], m[s[2]], m[s[3]]);
+        PAS_RAR__B2S_G(v[2], v[6], v[10], v[14], m[s[4]], m[s[5]]);
+        PAS_RAR__B2S_G(v[3], v[7], v[11], v[15], m[s[6]], m[s[7]]);
+        PAS_RAR__B2S_G(v[0], v[5], v[10], v[15], m[s[8]], m[s[9]]);
+        PAS_RAR__B2S_G(v[1], v[6], v[11], v[12], m[s[10]], m[s[11]]);
+        PAS_RAR__B2S_G(v[2], v[7], v[8], v[13], m[s[12]], m[s[13]]);
+        PAS_RAR__B2S_G(v[3], v[4], v[9], v[14], m[s[14]], m[s[15]]);
+    }
+    for (i = 0; i < 8; i++) h[i] ^= v[i] ^ v[i + 8];
+}
+
+/* BLAKE2sp node: 32-byte digest, fanout 8, depth 2, inner length 32 (the parameter block XORed
+   into the IV) */
+static void pas_rar__b2s_init(uint32_t h[8], uint32_t node_offset, uint32_t node_depth)
+{
+    memcpy(h, pas_rar__b2s_iv, sizeof(pas_rar__b2s_iv));
+    h[0] ^= 0x02080020u;
+    h[2] ^= node_offset;
+    h[3] ^= (node_depth << 16) | 0x20000000u;
+}
+
+#ifdef PAS_RAR_X86
+/* 8x8 32-bit transpose: row i of r becomes lane i of every vector */
+PAS_RAR_TARGET_AVX2
+static void pas_rar__transpose8(__m256i r[8])
+{
+    __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]), t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+    __m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]), t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+    __m256i t4 = _mm256_unpacklo_epi32(r[4], r[5]), t5 = _mm256_unpackhi_epi32(r[4], r[5]);
+    __m256i t6 = _mm256_unpacklo_epi32(r[6], r[7]), t7 = _mm256_unpackhi_epi32(r[6], r[7]);
+    __m256i u0 = _mm256_unpacklo_epi64(t0, t2), u1 = _mm256_unpackhi_epi64(t0, t2);
+    __m256i u2 = _mm256_unpacklo_epi64(t1, t3), u3 = _mm256_unpackhi_epi64(t1, t3);
+    __m256i u4 = _mm256_unpacklo_epi64(t4, t6), u5 = _mm256_unpackhi_epi64(t4, t6);
+    __m256i u6 = _mm256_unpacklo_epi64(t5, t7), u7 = _mm256_unpackhi_epi64(t5, t7);
+    r[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+    r[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+    r[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+    r[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+    r[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+    r[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+    r[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+    r[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+#define PAS_RAR__B2V_G(a, b, c, d, x, y) do { \
+    a = _mm256_add_epi32(_mm256_add_epi32(a, b), x); \
+    d = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), rot16); \
+    c = _mm256_add_epi32(c, d); \
+    b = _mm256_xor_si256(b, c); \
+    b = _mm256_or_si256(_mm256_srli_epi32(b, 12), _mm256_slli_epi32(b, 20)); \
+    a = _mm256_add_epi32(_mm256_add_epi32(a, b), y); \
+    d = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), rot8); \
+    c = _mm256_add_epi32(c, d); \
+    b = _mm256_xor_si256(b, c); \
+    b = _mm256_or_si256(_mm256_srli_epi32(b, 7), _mm256_slli_epi32(b, 25)); \
+} while (0)
+
+/* The eight leaves over stripes 512-byte stripes, none holding a leaf's last block: lane i of
+   each vector is leaf i, its message words gathered from p + 64 * i by transposing */
+PAS_RAR_TARGET_AVX2
+static void pas_rar__b2sp_avx2(uint32_t h[8][8], const uint8_t *p, size_t stripes)
+{
+    const __m256i rot16 = _mm256_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13,
+                                           2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13);
+    const __m256i rot8 = _mm256_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12,
+                                          1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    __m256i hv[8], m[16], v[16];
+    uint64_t t = 0;
+    unsigned i, r;
+
+    for (i = 0; i < 8; i++) hv[i] = _mm256_loadu_si256((const __m256i *)h[i]);
+    pas_rar__transpose8(hv);
+    for (; stripes; stripes--, p += 512) {
+        for (i = 0; i < 8; i++) {
+            m[i] = _mm256_loadu_si256((const __m256i *)(p + 64 * i));
+            m[i + 8] = _mm256_loadu_si256((const __m256i *)(p + 64 * i + 32));
+        }
+        pas_rar__transpose8(m);
+        pas_rar__transpose8(m + 8);
+        t += 64;
+        for (i = 0; i < 8; i++) {
+            v[i] = hv[i];
+            v[i + 8] = _mm256_set1_epi32((int)pas_rar__b2s_iv[i]);
+        }
+        v[12] = _mm256_xor_si256(v[12], _mm256_set1_epi32((int)(uint32_t)t));
+        v[13] = _mm256_xor_si256(v[13], _mm256_set1_epi32((int)(uint32_t)(t >> 32)));
+        for (r = 0; r < 10; r++) {
+            const uint8_t *s = pas_rar__b2s_sigma[r];
+            PAS_RAR__B2V_G(v[0], v[4], v[8], v[12], m[s[0]], m[s[1]]);
+            PAS_RAR__B2V_G(v[1], v[5], v[9], v[13], m[s[2]], m[s[3]]);
+            PAS_RAR__B2V_G(v[2], v[6], v[10], v[14], m[s[4]], m[s[5]]);
+            PAS_RAR__B2V_G(v[3], v[7], v[11], v[15], m[s[6]], m[s[7]]);
+            PAS_RAR__B2V_G(v[0], v[5], v[10], v[15], m[s[8]], m[s[9]]);
+            PAS_RAR__B2V_G(v[1], v[6], v[11], v[12], m[s[10]], m[s[11]]);
+            PAS_RAR__B2V_G(v[2], v[7], v[8], v[13], m[s[12]], m[s[13]]);
+            PAS_RAR__B2V_G(v[3], v[4], v[9], v[14], m[s[14]], m[s[15]]);
+        }
+        for (i = 0; i < 8; i++) hv[i] = _mm256_xor_si256(hv[i], _mm256_xor_si256(v[i], v[i + 8]));
+    }
+    pas_rar__transpose8(hv);
+    for (i = 0; i < 8; i++) _mm256_storeu_si256((__m256i *)h[i], hv[i]);
+}
+#endif /* PAS_RAR_X86 */
+
+void pas_rar_blake2sp(const void *data, size_t len, uint8_t out[32])
+{
+    const uint8_t *p = (const uint8_t *)data;
+    uint32_t h[8][8], root[8];
+    uint8_t block[64], digests[256];
+    size_t bulk = 0, s;
+    unsigned i, j;
+
+    if (!p) len = 0;
+    for (i = 0; i < 8; i++) pas_rar__b2s_init(h[i], i, 0);
+
+    /* Leaf i hashes the 64-byte blocks at 64 * i + 512 * k. Whole stripes run as long as leaf 7
+       has a block after them; then each leaf finishes its own tail, the last block flagged. */
+    if (len > 448) bulk = (len - 449) / 512;
+    s = 0;
+#ifdef PAS_RAR_X86
+    if (bulk && (pas_rar__cpu() & PAS_RAR__CPU_AVX2)) {
+        pas_rar__b2sp_avx2(h, p, bulk);
+        s = bulk;
+    }
+#endif
+    for (; s < bulk; s++)
+        for (i = 0; i < 8; i++) pas_rar__b2s_compress(h[i], p + 512 * s + 64 * i, (uint64_t)(s + 1) * 64, 0, 0);
+
+    for (i = 0; i < 8; i++) {
+        size_t off = 512 * bulk + 64 * (size_t)i;
+        uint64_t t = (uint64_t)bulk * 64;
+        while (off + 512 < len) {
+            t += 64;
+            pas_rar__b2s_compress(h[i], p + off, t, 0, 0);
+            off += 512;
+        }
+        memset(block, 0, sizeof(block));
+        if (off < len) {
+            size_t n = len - off < 64 ? len - off : 64;
+            memcpy(block, p + off, n);
+            t += n;
+        }
+        pas_rar__b2s_compress(h[i], block, t, 0xffffffffu, i == 7 ? 0xffffffffu : 0);
+        for (j = 0; j < 8; j++) {
+            digests[32 * i + 4 * j] = (uint8_t)h[i][j];
+            digests[32 * i + 4 * j + 1] = (uint8_t)(h[i][j] >> 8);
+            digests[32 * i + 4 * j + 2] = (uint8_t)(h[i][j] >> 16);
+            digests[32 * i + 4 * j + 3] = (uint8_t)(h[i][j] >> 24);
+        }
+    }
+
+    pas_rar__b2s_init(root, 0, 1);
+    for (i = 0; i < 4; i++)
+        pas_rar__b2s_compress(root, digests + 64 * i, 64 * (i + 1), i == 3 ? 0xffffffffu : 0, i == 3 ? 0xffffffffu : 0);
+    for (j = 0; j < 8; j++) {
+        out[4 * j] = (uint8_t)root[j];
+        out[4 * j + 1] = (uint8_t)(root[j] >> 8);
+        out[4 * j + 2] = (uint8_t)(root[j] >> 16);
+        out[4 * j + 3] = (uint8_t)(root[j] >> 24);
+    }
+}
+
+/* Last step of every extract: with rar->verify set, the n bytes written against the checksums
+   stored for file (MACs keyed by key for an encrypted entry with PAS_RAR_CRYPT_MAC) */
+static size_t pas_rar__extract_check(const pas_rar_file_t *file, const pas_rar_key_t *key, const void *buffer,
+                                     size_t n, pas_rar_status *status)
+{
+    if (file->rar->verify) {
+        uint8_t digest[32];
+        int mac = key && (file->crypt & PAS_RAR_CRYPT_MAC);
+        int bad = 0;
+        if (file->checks & PAS_RAR_CHECK_CRC32) {
+            uint32_t crc = pas_rar_crc32(0, buffer, n);
+            bad = (mac ? pas_rar__crc_mac(key->hash_key, crc) : crc) != file->crc32;
+        }
+        if (!bad && (file->checks & PAS_RAR_CHECK_BLAKE2)) {
+            pas_rar_blake2sp(buffer, n, digest);
+            if (mac) pas_rar__blake2_mac(key->hash_key, digest);
+            bad = memcmp(digest, file->blake2, sizeof(digest)) != 0;
+        }
+        if (bad) {
+            if (status) *status = PAS_RAR_E_CRC;
+            return 0;
+        }
+    }
+    if (status) *status = PAS_RAR_OK;
+    return n;
+}
+
+/* Keys of an encrypted entry, checked against its password check value */
+static pas_rar_status pas_rar__file_key(const pas_rar_file_t *file, pas_rar_key_t *key)
+{
+    if (file->rar->format != 5 || file->lg2_count > 24) return PAS_RAR_E_UNSUPPORTED;
+    if (!file->rar->password) return PAS_RAR_E_PASSWORD;
+    if (file->packed_size % 16) return PAS_RAR_E_INVALID;
+    pas_rar__key_get(file->rar, file->salt, file->lg2_count, key);
+    if ((file->crypt & PAS_RAR_CRYPT_CHECK) && memcmp(key->check, file->check, sizeof(file->check)) != 0)
+        return PAS_RAR_E_PASSWORD;
+    return PAS_RAR_OK;
+}
+
+static void pas_rar__crypt_start(pas_rar_crypt_t *c, const pas_rar_file_t *file, const pas_rar_key_t *key)
+{
+    memcpy(c->round_keys, key->round_keys, sizeof(c->round_keys));
+    memcpy(c->iv, file->iv, sizeof(c->iv));
+    c->rar = file->rar;
+    c->src = pas_rar__vol_data(file->rar, file->volume) + file->data_offset;
+    c->src_size = (size_t)file->part_size;
+    c->vol = file->volume;
+    c->left = file->packed_size;
+}
+
+/* Decrypt the next n bytes of the entry (whole blocks, n <= left) into out. The ciphertext runs
+   on over the parts of a split entry, which need not end on a block boundary: a block across two
+   parts is gathered first. 0 if a part is missing. */
+static int pas_rar__crypt_read(pas_rar_crypt_t *c, uint8_t *out, size_t n)
+{
+    pas_rar_file_t part;
+    uint8_t block[16];
+    size_t k, got;
+
+    while (n) {
+        if (c->src_size >= 16) {
+            k = c->src_size & ~(size_t)15;
+            if (k > n) k = n;
+            pas_rar__aes_cbc(c->round_keys, c->iv, c->src, out, k / 16);
+            c->src += k;
+            c->src_size -= k;
+        } else {
+            for (got = 0; got < 16; got += k) {
+                if (!c->src_size) {
+                    if (!pas_rar__next_part(c->rar, &c->vol, &part)) return 0;
+                    c->src = pas_rar__vol_data(c->rar, c->vol) + part.data_offset;
+                    c->src_size = (size_t)part.part_size;
+                }
+                k = 16 - got < c->src_size ? 16 - got : c->src_size;
+                memcpy(block + got, c->src, k);
+                c->src += k;
+                c->src_size -= k;
+            }
+            k = 16;
+            pas_rar__aes_cbc(c->round_keys, c->iv, block, out, 1);
+        }
+        out += k;
+        n -= k;
+        c->left -= k;
+    }
+    return 1;
+}
+
+/* ----- Decompression: shared LZ machinery ----- */
+
+#define PAS_RAR5_TABLES    (PAS_RAR5_NC + PAS_RAR5_DC + PAS_RAR5_LDC + PAS_RAR5_RC)
+#define PAS_RAR_MAX_MATCH 0x1100 /* longest copy: 4097 from the length slots + 3 for far distances */
+#define PAS_RAR_MIN_WINDOW 0x800000
+#define PAS_RAR__DONE     1      /* pas_rar__checkpoint: target reached */
+
+enum {
+    PAS_RAR_FILTER_DELTA, PAS_RAR_FILTER_E8, PAS_RAR_FILTER_E8E9, PAS_RAR_FILTER_ARM,
+    PAS_RAR_FILTER_RGB, PAS_RAR_FILTER_AUDIO, PAS_RAR_FILTER_ITANIUM
+};
+
+/* Packed byte at pos, 0 past the end. The packed data may be split over volumes: advance makes
+   the part holding pos current (reads never go back before it), otherwise later parts are only
+   looked into. */
+static unsigned pas_rar__in_byte(pas_rar_unpack_t *u, uint64_t pos, int advance)
+{
+    const uint8_t *in = u->in;
+    size_t size = u->in_size;
+    uint64_t base = u->in_base;
+    uint32_t vol = u->in_vol;
+    pas_rar_file_t part;
+
+    if (pos < base || pos >= u->in_total) return 0;
+    if (u->crypted) {
+        /* Decrypted a chunk at a time into crypt_buf; the last 16 bytes stay for lookahead */
+        while (pos - u->in_base >= u->in_size) {
+            size_t keep = u->in_size < 16 ? u->in_size : 16;
+            size_t n = u->crypt.left < PAS_RAR_CRYPT_CHUNK ? (size_t)u->crypt.left : PAS_RAR_CRYPT_CHUNK;
+            memmove(u->crypt_buf, u->crypt_buf + u->in_size - keep, keep);
+            if (!n || !pas_rar__crypt_read(&u->crypt, u->crypt_buf + keep, n)) return 0;
+            u->in_base += u->in_size - keep;
+            u->in_size = keep + n;
+        }
+        return u->in[pos - u->in_base];
+    }
+    while (pos - base >= size) {
+        if (!pas_rar__next_part(u->in_rar, &vol, &part)) return 0;
+        base += size;
+        in = pas_rar__vol_data(u->in_rar, vol) + part.data_offset;
+        size = (size_t)part.part_size;
+        if (advance) {
+            u->in = in;
+            u->in_size = size;
+            u->in_base = base;
+            u->in_vol = vol;
+        }
+    }
+    return in[pos - base];
+}
+
+/* 32 bits at the current bit position, MSB first; zeros past the end of the input */
+static uint32_t pas_rar__peek32(pas_rar_unpack_t *u)
+{
+    uint64_t byte = u->bitpos >> 3, at = byte - u->in_base;
+    uint64_t v = 0;
+    unsigned i;
+
+    if (byte >= u->in_base && at + 8 <= u->in_size) {
+        const uint8_t *p = u->in + (size_t)at;
+        v = ((uint64_t)p[0] << 56) | ((uint64_t)p[1] << 48) | ((uint64_t)p[2] << 40) | ((uint64_t)p[3] << 32) |
+            ((uint64_t)p[4] << 24) | ((uint64_t)p[5] << 16) | ((uint64_t)p[6] << 8) | (uint64_t)p[7];
+    } else {
+        for (i = 0; i < 8; i++) v = (v << 8) | pas_rar__in_byte(u, byte + i, i == 0);
+    }
+    return (uint32_t)((v << (u->bitpos & 7)) >> 32);
+}
+
+static unsigned pas_rar__peek16(pas_rar_unpack_t *u) { return pas_rar__peek32(u) >> 16; }
+
+/* Canonical code from bit lengths (shorter codes first, then symbol order), as in unrar's
+   MakeDecodeTables. Codes up to quick_bits long resolve with one lookup. */
+static void pas_rar__huff_build(pas_rar_huff_t *h, const uint8_t *lens, unsigned n, unsigned quick_bits)
+{
+    uint32_t count[16], pos[16], upper = 0;
+    unsigned i, len = 1;
+
+    memset(count, 0, sizeof(count));
+    for (i = 0; i < n; i++) count[lens[i] & 15]++;
+    count[0] = 0;
+    h->decode_len[0] = 0;
+    h->decode_pos[0] = 0;
+    for (i = 1; i < 16; i++) {
+        upper += count[i];
+        h->decode_len[i] = upper << (16 - i);
+        upper <<= 1;
+        h->decode_pos[i] = h->decode_pos[i - 1] + count[i - 1];
+    }
+    memcpy(pos, h->decode_pos, sizeof(pos));
+    memset(h->decode_num, 0, n * sizeof(h->decode_num[0]));
+    for (i = 0; i < n; i++)
+        if (lens[i] & 15) h->decode_num[pos[lens[i] & 15]++] = (uint16_t)i;
+    h->max_num = n;
+    h->quick_bits = quick_bits;
+
+    for (i = 0; i < (1u << quick_bits); i++) {
+        uint32_t bits = (uint32_t)i << (16 - quick_bits), p;
+        while (len < 16 && bits >= h->decode_len[len]) len++;
+        h->quick_len[i] = (uint8_t)len;
+        p = len < 16 ? h->decode_pos[len] + ((bits - h->decode_len[len - 1]) >> (16 - len)) : n;
+        h->quick_num[i] = p < n ? h->decode_num[p] : 0;
+    }
+}
+
+static unsigned pas_rar__decode(pas_rar_unpack_t *u, const pas_rar_huff_t *h)
+{
+    uint32_t bits = pas_rar__peek16(u) & 0xfffeu, p;
+    unsigned len;
+
+    if (bits < h->decode_len[h->quick_bits]) {
+        unsigned code = bits >> (16 - h->quick_bits);
+        u->bitpos += h->quick_len[code];
+        return h->quick_num[code];
+    }
+    for (len = h->quick_bits + 1; len < 15; len++)
+        if (bits < h->decode_len[len]) break;
+    u->bitpos += len;
+    p = h->decode_pos[len] + ((bits - h->decode_len[len - 1]) >> (16 - len));
+    return p < h->max_num ? h->decode_num[p] : 0;
+}
+
+/* Table bit lengths, the same in both formats: 20 nibble-coded lengths of a pre-code (15 followed
+   by a zero count of 0 means length 15), then n lengths through it with repeat (16, 17) and
+   zero-run (18, 19) codes. RAR 3.x sends plain lengths as deltas to old, mod 16. The pre-code
+   decoder goes in u->rd, which the caller rebuilds last. */
+static int pas_rar__read_lengths(pas_rar_unpack_t *u, uint8_t *lens, unsigned n, const uint8_t *old)
+{
+    uint8_t bl[20];
+    unsigned i;
+
+    for (i = 0; i < 20; i++) {
+        unsigned len = pas_rar__peek16(u) >> 12;
+        u->bitpos += 4;
+        if (len == 15) {
+            unsigned zeros = pas_rar__peek16(u) >> 12;
+            u->bitpos += 4;
+            if (zeros != 0) {
+                for (zeros += 2; zeros > 0 && i < 20; zeros--) bl[i++] = 0;
+                i--;
+                continue;
+            }
+        }
+        bl[i] = (uint8_t)len;
+    }
+    pas_rar__huff_build(&u->rd, bl, 20, 7);
+
+    for (i = 0; i < n; ) {
+        unsigned sym = pas_rar__decode(u, &u->rd), count;
+        if (sym < 16) {
+            lens[i] = (uint8_t)(old ? (sym + old[i]) & 15 : sym);
+            i++;
+            continue;
+        }
+        if (sym == 16 || sym == 18) {
+            count = (pas_rar__peek16(u) >> 13) + 3;
+            u->bitpos += 3;
+        } else {
+            count = (pas_rar__peek16(u) >> 9) + 11;
+            u->bitpos += 7;
+        }
+        if (sym < 18) {
+            if (i == 0) return 0;
+            for (; count > 0 && i < n; count--, i++) lens[i] = lens[i - 1];
+        } else {
+            for (; count > 0 && i < n; count--) lens[i++] = 0;
+        }
+    }
+    return u->bitpos <= u->block_end;
+}
+
+/* Copy window bytes [flushed, unp) to the destination, if there is one */
+static void pas_rar__flush(pas_rar_unpack_t *u)
+{
+    size_t n = (size_t)(u->unp - u->flushed);
+    size_t from = u->win_pos >= n ? u->win_pos - n : u->win_pos + u->window_size - n;
+    uint8_t *dst;
+
+    if (!u->out) {
+        u->flushed = u->unp;
+        return;
+    }
+    dst = u->out + (size_t)(u->flushed - u->out_base);
+    if (from + n > u->window_size) {
+        size_t first = u->window_size - from;
+        memcpy(dst, u->window + from, first);
+        dst += first;
+        n -= first;
+        from = 0;
+    }
+    memcpy(dst, u->window + from, n);
+    u->flushed = u->unp;
+}
+
+/* Window index of stream position pos, which must still be in the window */
+static size_t pas_rar__win_index(const pas_rar_unpack_t *u, uint64_t pos)
+{
+    size_t back = (size_t)(u->unp - pos);
+    return u->win_pos >= back ? u->win_pos - back : u->win_pos + u->window_size - back;
+}
+
+/* Itanium bundle fields: little-endian bit strings of up to 20 bits */
+static uint32_t pas_rar__ia64_get(const uint8_t *d, unsigned bitpos, unsigned bits)
+{
+    return (pas_rar__u32le(d + bitpos / 8) >> (bitpos & 7)) & (0xffffffffu >> (32 - bits));
+}
+
+static void pas_rar__ia64_set(uint8_t *d, uint32_t v, unsigned bitpos, unsigned bits)
+{
+    uint32_t mask = ~((0xffffffffu >> (32 - bits)) << (bitpos & 7)), i;
+    v <<= bitpos & 7;
+    for (i = 0; i < 4; i++) {
+        d[bitpos / 8 + i] = (uint8_t)((d[bitpos / 8 + i] & mask) | v);
+        mask = (mask >> 8) | 0xff000000u;
+        v >>= 8;
+    }
+}
+
+/* Run filter on its block, already copied to the destination. E8/E8E9/ARM/Itanium rewrite it in
+   place; delta, RGB and audio read the unfiltered bytes back from the window. RAR 3.x filters
+   whose parameters the VM would reject leave the block as it is, like unrar. */
+static int pas_rar__apply_filter(pas_rar_unpack_t *u, const pas_rar_filter_t *f)
+{
+    uint32_t file_off = (uint32_t)(f->start - u->out_base), n = f->length, i;
+    uint8_t *d = u->out + (size_t)(f->start - u->out_base);
+    size_t src;
+
+    if (f->type == PAS_RAR_FILTER_E8 || f->type == PAS_RAR_FILTER_E8E9) {
+        const uint32_t file_size = 0x1000000;
+        uint8_t cmp2 = f->type == PAS_RAR_FILTER_E8E9 ? 0xe9 : 0xe8;
+        for (i = 0; i + 4 < n; ) {
+            uint8_t b = d[i++];
+            if (b == 0xe8 || b == cmp2) {
+                uint32_t offset = u->format == 5 ? (i + file_off) % file_size : i + file_off;
+                uint32_t addr = pas_rar__u32le(d + i), conv;
+                /* The packer stored absolute call targets; turn them back into relative offsets */
+                if (addr & 0x80000000u) conv = ((addr + offset) & 0x80000000u) == 0 ? addr + file_size : addr;
+                else conv = ((addr - file_size) & 0x80000000u) ? addr - offset : addr;
+                d[i] = (uint8_t)conv;
+                d[i + 1] = (uint8_t)(conv >> 8);
+                d[i + 2] = (uint8_t)(conv >> 16);
+                d[i + 3] = (uint8_t)(conv >> 24);
+                i += 4;
+            }
+        }
+        return PAS_RAR_OK;
+    }
+    if (f->type == PAS_RAR_FILTER_ARM) {
+        for (i = 0; i + 3 < n; i += 4) {
+            if (d[i + 3] == 0xeb) { /* BL with the "always" condition */
+                uint32_t off = d[i] | ((uint32_t)d[i + 1] << 8) | ((uint32_t)d[i + 2] << 16);
+                off -= (file_off + i) / 4;
+                d[i] = (uint8_t)off;
+                d[i + 1] = (uint8_t)(off >> 8);
+                d[i + 2] = (uint8_t)(off >> 16);
+            }
+        }
+        return PAS_RAR_OK;
+    }
+    if (f->type == PAS_RAR_FILTER_ITANIUM) {
+        /* Branch targets in the slots of each 16-byte bundle, per the template's slot mask */
+        static const uint8_t masks[16] = { 4, 4, 6, 6, 0, 0, 7, 7, 4, 4, 0, 0, 4, 4, 0, 0 };
+        uint32_t bundle = file_off >> 4;
+        if (n < 21) return PAS_RAR_OK;
+        for (i = 0; i < n - 21; i += 16, bundle++) {
+            int t = (d[i] & 0x1f) - 0x10;
+            unsigned slot;
+            if (t < 0 || masks[t] == 0) continue;
+            for (slot = 0; slot <= 2; slot++) {
+                unsigned pos = slot * 41 + 5;
+                if ((masks[t] & (1u << slot)) && pas_rar__ia64_get(d + i, pos + 37, 4) == 5) {
+                    uint32_t off = pas_rar__ia64_get(d + i, pos + 13, 20);
+                    pas_rar__ia64_set(d + i, (off - bundle) & 0xfffff, pos + 13, 20);
+                }
+            }
+        }
+        return PAS_RAR_OK;
+    }
+
+    if (u->unp - f->start > (uint64_t)u->window_size) return PAS_RAR_E_NOSPACE;
+    src = pas_rar__win_index(u, f->start);
+    if (u->format == 4 && n > PAS_RAR3_MAX_FILTER / 2) return PAS_RAR_OK;
+
+    if (f->type == PAS_RAR_FILTER_RGB) {
+        /* Paeth-style prediction per colour byte from the left and upper pixels, then G added
+           back to R and B. channels carries the line width + 3. */
+        uint32_t width = f->channels - 3;
+        unsigned c;
+        if (n < 3 || width > n || f->pos_r > 2) return PAS_RAR_OK;
+        for (c = 0; c < 3; c++) {
+            unsigned prev = 0;
+            for (i = c; i < n; i += 3) {
+                unsigned pred = prev;
+                if (i >= width + 3) {
+                    unsigned up = d[i - width], up_left = d[i - width - 3];
+                    int pa, pb, pc;
+                    pred = prev + up - up_left;
+                    pa = (int)(pred - prev);
+                    pb = (int)(pred - up);
+                    pc = (int)(pred - up_left);
+                    if (pa < 0) pa = -pa;
+                    if (pb < 0) pb = -pb;
+                    if (pc < 0) pc = -pc;
+                    pred = pa <= pb && pa <= pc ? prev : pb <= pc ? up : up_left;
+                }
+                prev = (uint8_t)(pred - u->window[src]);
+                d[i] = (uint8_t)prev;
+                if (++src == u->window_size) src = 0;
+            }
+        }
+        for (i = f->pos_r; i + 2 < n; i += 3) {
+            d[i] = (uint8_t)(d[i] + d[i + 1]);
+            d[i + 2] = (uint8_t)(d[i + 2] + d[i + 1]);
+        }
+    } else if (f->type == PAS_RAR_FILTER_AUDIO) {
+        /* Per channel, a third-order predictor whose weights adapt every 32 samples toward the
+           variant with the smallest accumulated error */
+        unsigned c, j;
+        if (f->channels == 0 || f->channels > 128) return PAS_RAR_OK;
+        for (c = 0; c < f->channels; c++) {
+            uint32_t dif[7], prev = 0, count = 0;
+            int d1 = 0, d2 = 0, d3, k1 = 0, k2 = 0, k3 = 0, prev_delta = 0;
+            memset(dif, 0, sizeof(dif));
+            for (i = c; i < n; i += f->channels, count++) {
+                uint32_t pred;
+                int cur, e;
+                d3 = d2;
+                d2 = prev_delta - d1;
+                d1 = prev_delta;
+                pred = ((8 * prev + (uint32_t)(k1 * d1) + (uint32_t)(k2 * d2) + (uint32_t)(k3 * d3)) >> 3) & 0xff;
+                cur = u->window[src];
+                if (++src == u->window_size) src = 0;
+                pred = (pred - (uint32_t)cur) & 0xff;
+                d[i] = (uint8_t)pred;
+                prev_delta = (signed char)(pred - prev);
+                prev = pred;
+                e = (signed char)cur * 8;
+                dif[0] += (uint32_t)(e < 0 ? -e : e);
+                dif[1] += (uint32_t)(e - d1 < 0 ? d1 - e : e - d1);
+                dif[2] += (uint32_t)(e + d1 < 0 ? -e - d1 : e + d1);
+                dif[3] += (uint32_t)(e - d2 < 0 ? d2 - e : e - d2);
+                dif[4] += (uint32_t)(e + d2 < 0 ? -e - d2 : e + d2);
+                dif[5] += (uint32_t)(e - d3 < 0 ? d3 - e : e - d3);
+                dif[6] += (uint32_t)(e + d3 < 0 ? -e - d3 : e + d3);
+                if ((count & 0x1f) == 0) {
+                    uint32_t min_dif = dif[0];
+                    unsigned best = 0;
+                    dif[0] = 0;
+                    for (j = 1; j < 7; j++) {
+                        if (dif[j] < min_dif) {
+                            min_dif = dif[j];
+                            best = j;
+                        }
+                        dif[j] = 0;
+                    }
+                    switch (best) {
+                    case 1: if (k1 >= -16) k1--; break;
+                    case 2: if (k1 < 16) k1++; break;
+                    case 3: if (k2 >= -16) k2--; break;
+                    case 4: if (k2 < 16) k2++; break;
+                    case 5: if (k3 >= -16) k3--; break;
+                    case 6: if (k3 < 16) k3++; break;
+                    default: break;
+                    }
+                }
+            }
+        }
+    } else {
+        /* Delta: channel c holds bytes c, c + channels, ... stored one channel after another */
+        unsigned c;
+        if (f->channels == 0 || f->channels > 1024) return PAS_RAR_OK;
+        for (c = 0; c < f->channels; c++) {
+            uint8_t prev = 0;
+            for (i = c; i < n; i += f->channels) {
+                prev = (uint8_t)(prev - u->window[src]);
+                d[i] = prev;
+                if (++src == u->window_size) src = 0;
+            }
+        }
+    }
+    return PAS_RAR_OK;
+}
+
+/* Called by the decode loops when unp reaches limit: flush, run the filters whose blocks are
+   complete, and compute the next limit - the nearest of target, the end of the first pending
+   filter and the point where unflushed bytes would start to be overwritten in the window. That
+   keeps the per-symbol work to one compare. Returns PAS_RAR__DONE at target. */
+static pas_rar_status pas_rar__checkpoint(pas_rar_unpack_t *u, uint64_t target, uint64_t *limit)
+{
+    if (u->unp > target) return PAS_RAR_E_INVALID;
+    pas_rar__flush(u);
+    while (u->nfilters && u->filters[0].start + u->filters[0].length <= u->unp) {
+        pas_rar_status st = u->out ? pas_rar__apply_filter(u, &u->filters[0]) : PAS_RAR_OK;
+        if (st != PAS_RAR_OK) return st;
+        memmove(u->filters, u->filters + 1, --u->nfilters * sizeof(u->filters[0]));
+    }
+    if (u->unp == target) return u->nfilters ? PAS_RAR_E_INVALID : PAS_RAR__DONE;
+    *limit = target;
+    if (u->nfilters && u->filters[0].start + u->filters[0].length < *limit)
+        *limit = u->filters[0].start + u->filters[0].length;
+    if (target - u->flushed > u->window_size && u->flushed + u->window_size - PAS_RAR_MAX_MATCH < *limit)
+        *limit = u->flushed + u->window_size - PAS_RAR_MAX_MATCH;
+    return PAS_RAR_OK;
+}
+
+/* Queue filter f; blocks must not overlap and must end by target */
+static pas_rar_status pas_rar__add_filter(pas_rar_unpack_t *u, const pas_rar_filter_t *f, uint64_t target,
+                                          uint64_t *limit)
+{
+    if (f->start + f->length > target) return PAS_RAR_E_INVALID;
+    if (u->nfilters) {
+        const pas_rar_filter_t *prev = &u->filters[u->nfilters - 1];
+        /* The same block again would run a second filter on the first one's output */
+        if (f->start == prev->start && f->length == prev->length) return PAS_RAR_E_UNSUPPORTED;
+        if (f->start < prev->start + prev->length) return PAS_RAR_E_INVALID;
+    }
+    if (u->nfilters == PAS_RAR_MAX_FILTERS) return PAS_RAR_E_UNSUPPORTED;
+    u->filters[u->nfilters++] = *f;
+    if (f->start + f->length < *limit) *limit = f->start + f->length;
+    return PAS_RAR_OK;
+}
+
+/* Copy len bytes from dist back; one contiguous run unless either end wraps */
+static int pas_rar__copy(pas_rar_unpack_t *u, uint32_t len, uint64_t dist)
+{
+    uint8_t *w = u->window;
+    size_t ws = u->window_size, pos = u->win_pos, src;
+
+    if (dist == 0 || dist > u->unp || dist > ws) return 0;
+    src = pos >= dist ? pos - (size_t)dist : pos + ws - (size_t)dist;
+    u->unp += len;
+    if (src + len <= ws && pos + len <= ws) {
+        uint8_t *d = w + pos;
+        const uint8_t *s = w + src;
+        if (dist >= len) {
+            memcpy(d, s, len);
+        } else {
+            uint32_t i;
+            for (i = 0; i < len; i++) d[i] = s[i];
+        }
+        pos += len;
+        if (pos == ws) pos = 0;
+    } else {
+        while (len--) {
+            w[pos] = w[src];
+            if (++pos == ws) pos = 0;
+            if (++src == ws) src = 0;
+        }
+    }
+    u->win_pos = pos;
+    return 1;
+}
+
+/* ----- RAR5 ----- */
+
+static int pas_rar5__read_tables(pas_rar_unpack_t *u)
+{
+    uint8_t lens[PAS_RAR5_TABLES];
+
+    if (!pas_rar__read_lengths(u, lens, PAS_RAR5_TABLES, NULL)) return 0;
+    pas_rar__huff_build(&u->ld, lens, PAS_RAR5_NC, PAS_RAR_QUICK_BITS);
+    pas_rar__huff_build(&u->dd, lens + PAS_RAR5_NC, PAS_RAR5_DC, 7);
+    pas_rar__huff_build(&u->ldd, lens + PAS_RAR5_NC + PAS_RAR5_DC, PAS_RAR5_LDC, 7);
+    pas_rar__huff_build(&u->rd, lens + PAS_RAR5_NC + PAS_RAR5_DC + PAS_RAR5_LDC, PAS_RAR5_RC, 7);
+    u->tables_read = 1;
+    return 1;
+}
+
+/* Block header, byte-aligned: flags (bits 0-2 = valid bits in the last byte - 1, bits 3-4 = size
+   bytes - 1, 0x40 = last block, 0x80 = tables follow), check byte, 1-3 size bytes (LE). */
+static int pas_rar5__block_header(pas_rar_unpack_t *u)
+{
+    uint64_t p = (u->bitpos + 7) >> 3, start;
+    unsigned flags, check, count, i;
+    uint32_t size = 0;
+
+    if (p + 2 > u->in_total) return 0;
+    flags = pas_rar__in_byte(u, p, 1);
+    check = pas_rar__in_byte(u, p + 1, 1);
+    count = ((flags >> 3) & 3) + 1;
+    if (count == 4 || p + 2 + count > u->in_total) return 0;
+    for (i = 0; i < count; i++) size |= (uint32_t)pas_rar__in_byte(u, p + 2 + i, 1) << (8 * i);
+    if (check != (uint8_t)(0x5a ^ flags ^ size ^ (size >> 8) ^ (size >> 16))) return 0;
+    start = p + 2 + count;
+    if (size > u->in_total - start) return 0;
+
+    u->bitpos = start * 8;
+    u->block_end = (start + size) * 8 - 8 + (flags & 7) + 1;
+    u->last_block = (flags & 0x40) != 0;
+    if (flags & 0x80) return pas_rar5__read_tables(u);
+    return u->tables_read;
+}
+
+static uint32_t pas_rar5__slot_to_length(pas_rar_unpack_t *u, unsigned slot)
+{
+    uint32_t len = 2;
+    unsigned bits;
+    if (slot < 8) return len + slot;
+    bits = slot / 4 - 1;
+    len += (uint32_t)(4 | (slot & 3)) << bits;
+    len += pas_rar__peek16(u) >> (16 - bits);
+    u->bitpos += bits;
+    return len;
+}
+
+static uint32_t pas_rar5__filter_number(pas_rar_unpack_t *u)
+{
+    unsigned n = (pas_rar__peek16(u) >> 14) + 1, i;
+    uint32_t v = 0;
+    u->bitpos += 2;
+    for (i = 0; i < n; i++) {
+        v |= (uint32_t)(pas_rar__peek16(u) >> 8) << (8 * i);
+        u->bitpos += 8;
+    }
+    return v;
+}
+
+/* Decode until stream position target, copying [out_base, target) to u->out */
+static pas_rar_status pas_rar5__run(pas_rar_unpack_t *u, uint64_t target)
+{
+    uint64_t limit = u->unp;
+
+    for (;;) {
+        uint64_t dist;
+        uint32_t len;
+        unsigned sym;
+
+        if (u->unp >= limit) {
+            pas_rar_status st = pas_rar__checkpoint(u, target, &limit);
+            if (st != PAS_RAR_OK) return st == PAS_RAR__DONE ? PAS_RAR_OK : st;
+        }
+        if (u->bitpos >= u->block_end) {
+            if (u->last_block || !pas_rar5__block_header(u)) return PAS_RAR_E_INVALID;
+            continue;
+        }
+
+        sym = pas_rar__decode(u, &u->ld);
+        if (sym < 256) {
+            u->window[u->win_pos] = (uint8_t)sym;
+            if (++u->win_pos == u->window_size) u->win_pos = 0;
+            u->unp++;
+            continue;
+        }
+        if (sym >= 262) {
+            unsigned dslot;
+            len = pas_rar5__slot_to_length(u, sym - 262);
+            dslot = pas_rar__decode(u, &u->dd);
+            if (dslot < 4) {
+                dist = 1 + dslot;
+            } else {
+                unsigned bits = dslot / 2 - 1;
+                dist = 1 + ((uint64_t)(2 | (dslot & 1)) << bits);
+                if (bits >= 4) {
+                    if (bits > 4) {
+                        dist += (uint64_t)(pas_rar__peek32(u) >> (36 - bits)) << 4;
+                        u->bitpos += bits - 4;
+                    }
+                    dist += pas_rar__decode(u, &u->ldd);
+                } else {
+                    dist += pas_rar__peek32(u) >> (32 - bits);
+                    u->bitpos += bits;
+                }
+            }
+            if (dist > 0x100) {
+                len++;
+                if (dist > 0x2000) {
+                    len++;
+                    if (dist > 0x40000) len++;
+                }
+            }
+            memmove(u->old_dist + 1, u->old_dist, 3 * sizeof(u->old_dist[0]));
+            u->old_dist[0] = dist;
+            u->last_len = len;
+        } else if (sym == 256) {
+            pas_rar_filter_t f;
+            pas_rar_status st;
+            uint32_t start = pas_rar5__filter_number(u);
+            f.length = pas_rar5__filter_number(u);
+            f.type = (uint8_t)(pas_rar__peek16(u) >> 13);
+            f.channels = 0;
+            f.pos_r = 0;
+            u->bitpos += 3;
+            if (f.type == PAS_RAR_FILTER_DELTA) {
+                f.channels = (pas_rar__peek16(u) >> 11) + 1;
+                u->bitpos += 5;
+            }
+            if (f.type > PAS_RAR_FILTER_ARM) return PAS_RAR_E_UNSUPPORTED;
+            if (f.length == 0 || f.length > PAS_RAR5_MAX_FILTER) continue; /* ignored, as by unrar */
+            f.start = u->unp + start;
+            st = pas_rar__add_filter(u, &f, target, &limit);
+            if (st != PAS_RAR_OK) return st;
+            continue;
+        } else if (sym == 257) {
+            if (u->last_len == 0) continue;
+            len = u->last_len;
+            dist = u->old_dist[0];
+        } else {
+            unsigned idx = sym - 258;
+            dist = u->old_dist[idx];
+            memmove(u->old_dist + 1, u->old_dist, idx * sizeof(u->old_dist[0]));
+            u->old_dist[0] = dist;
+            len = pas_rar5__slot_to_length(u, pas_rar__decode(u, &u->rd));
+            u->last_len = len;
+        }
+        if (!pas_rar__copy(u, len, dist)) return PAS_RAR_E_INVALID;
+    }
+}
+
+/* ----- PPMd variant H -----
+   Dmitry Shkarin's model as used by RAR 2.9/3.x, following unrar's model.cpp and suballoc.cpp so
+   that the model restarts exactly where the packer's did. The model memory is a heap of 12-byte
+   units in the caller's arena; the references stored in it are 32-bit offsets from base, 0 being
+   NULL. The text area (raw symbols the successors point into) grows up from offset 12, contexts
+   are allocated down from the top and statistics up from units_start. */
+
+#define PAS_RAR_PPM_UNIT        12
+#define PAS_RAR_PPM_INDEXES     38
+#define PAS_RAR_PPM_MAX_O       64
+#define PAS_RAR_PPM_MAX_FREQ    124
+#define PAS_RAR_PPM_INT_BITS    7
+#define PAS_RAR_PPM_PERIOD_BITS 7
+#define PAS_RAR_PPM_TOT_BITS    (PAS_RAR_PPM_INT_BITS + PAS_RAR_PPM_PERIOD_BITS)
+#define PAS_RAR_PPM_INTERVAL    (1 << PAS_RAR_PPM_INT_BITS)
+#define PAS_RAR_PPM_BIN_SCALE   (1 << PAS_RAR_PPM_TOT_BITS)
+#define PAS_RAR_PPM_TOP         (1u << 24)
+#define PAS_RAR_PPM_BOT         (1u << 15)
+#define PAS_RAR_PPM_MEAN(s)     (((s) + (1 << (PAS_RAR_PPM_PERIOD_BITS - 2))) >> PAS_RAR_PPM_PERIOD_BITS)
+
+typedef struct {
+    uint8_t  symbol, freq;
+    uint16_t succ_lo, succ_hi;  /* successor: a context, or a text position while still unique */
+} pas_rar__ppm_state;
+
+typedef struct {
+    uint16_t num_stats;
+    union {
+        struct { uint16_t summ_freq, stats_lo, stats_hi; } s;  /* num_stats > 1 */
+        pas_rar__ppm_state one;                                 /* num_stats == 1 */
+    } u;
+    uint32_t suffix;
+} pas_rar__ppm_ctx;
+
+typedef struct { uint16_t summ; uint8_t shift, count; } pas_rar__ppm_see;
+
+typedef struct {
+    uint8_t            *base;
+    uint32_t            size;  /* text and units, model MB << 20 */
+    uint32_t            text, units_start, lo_unit, hi_unit;
+    unsigned            glue_count;
+    uint32_t            free_list[PAS_RAR_PPM_INDEXES];
+    uint8_t             indx2units[PAS_RAR_PPM_INDEXES], units2indx[128];
+    pas_rar__ppm_ctx   *min_context, *max_context;
+    pas_rar__ppm_state *found_state;
+    int                 order_fall, init_esc, max_order, run_length, init_rl;
+    unsigned            num_masked, prev_success, hi_bits_flag;
+    uint8_t             esc_count;
+    uint8_t             char_mask[256], ns2indx[256], ns2bsindx[256], hb2flag[256];
+    pas_rar__ppm_see    see2[25][16], dummy_see2;
+    uint16_t            bin_summ[128][64];
+    /* range decoder over the packed stream */
+    pas_rar_unpack_t   *src;
+    uint64_t            in_pos;           /* may run past src->in_total; zeros are read there */
+    uint32_t            low, code, range, scale, low_count, high_count;
+} pas_rar__ppm;
+
+static pas_rar__ppm_ctx *pas_rar__ppm_ctx_at(const pas_rar__ppm *m, uint32_t r)
+{
+    return r ? (pas_rar__ppm_ctx *)(void *)(m->base + r) : NULL;
+}
+static uint32_t pas_rar__ppm_ref(const pas_rar__ppm *m, const void *p)
+{
+    return p ? (uint32_t)((const uint8_t *)p - m->base) : 0;
+}
+static uint32_t pas_rar__ppm_stats_ref(const pas_rar__ppm_ctx *c)
+{
+    return (uint32_t)c->u.s.stats_lo | ((uint32_t)c->u.s.stats_hi << 16);
+}
+static pas_rar__ppm_state *pas_rar__ppm_stats(const pas_rar__ppm *m, const pas_rar__ppm_ctx *c)
+{
+    return (pas_rar__ppm_state *)(void *)(m->base + pas_rar__ppm_stats_ref(c));
+}
+static void pas_rar__ppm_set_stats(pas_rar__ppm_ctx *c, uint32_t r)
+{
+    c->u.s.stats_lo = (uint16_t)r;
+    c->u.s.stats_hi = (uint16_t)(r >> 16);
+}
+static uint32_t pas_rar__ppm_succ(const pas_rar__ppm_state *s)
+{
+    return (uint32_t)s->succ_lo | ((uint32_t)s->succ_hi << 16);
+}
+static void pas_rar__ppm_set_succ(pas_rar__ppm_state *s, uint32_t r)
+{
+    s->succ_lo = (uint16_t)r;
+    s->succ_hi = (uint16_t)(r >> 16);
+}
+static void pas_rar__ppm_swap(pas_rar__ppm_state *a, pas_rar__ppm_state *b)
+{
+    pas_rar__ppm_state t = *a;
+    *a = *b;
+    *b = t;
+}
+
+/* Free blocks: a free-list link at +0; while gluing, stamp (0xFFFF) at +0, unit count at +2 and
+   list links at +4 / +8. Accessed bytewise since the same units hold contexts and states. */
+static uint32_t pas_rar__ppm_get32(const pas_rar__ppm *m, uint32_t at)
+{
+    return pas_rar__u32le(m->base + at);
+}
+static void pas_rar__ppm_put32(pas_rar__ppm *m, uint32_t at, uint32_t v)
+{
+    m->base[at] = (uint8_t)v;
+    m->base[at + 1] = (uint8_t)(v >> 8);
+    m->base[at + 2] = (uint8_t)(v >> 16);
+    m->base[at + 3] = (uint8_t)(v >> 24);
+}
+static unsigned pas_rar__ppm_get16(const pas_rar__ppm *m, uint32_t at)
+{
+    return pas_rar__u16le(m->base + at);
+}
+static void pas_rar__ppm_put16(pas_rar__ppm *m, uint32_t at, unsigned v)
+{
+    m->base[at] = (uint8_t)v;
+    m->base[at + 1] = (uint8_t)(v >> 8);
+}
+
+static void pas_rar__ppm_insert(pas_rar__ppm *m, uint32_t p, unsigned indx)
+{
+    pas_rar__ppm_put32(m, p, m->free_list[indx]);
+    m->free_list[indx] = p;
+}
+
+static uint32_t pas_rar__ppm_remove(pas_rar__ppm *m, unsigned indx)
+{
+    uint32_t p = m->free_list[indx];
+    m->free_list[indx] = pas_rar__ppm_get32(m, p);
+    return p;
+}
+
+static void pas_rar__ppm_split(pas_rar__ppm *m, uint32_t p, unsigned old_indx, unsigned new_indx)
+{
+    unsigned diff = m->indx2units[old_indx] - m->indx2units[new_indx], i;
+    p += m->indx2units[new_indx] * PAS_RAR_PPM_UNIT;
+    if (m->indx2units[i = m->units2indx[diff - 1]] != diff) {
+        pas_rar__ppm_insert(m, p, --i);
+        p += m->indx2units[i] * PAS_RAR_PPM_UNIT;
+        diff -= m->indx2units[i];
+    }
+    pas_rar__ppm_insert(m, p, m->units2indx[diff - 1]);
+}
+
+/* Merge neighbouring free blocks and refill the free lists (unrar's GlueFreeBlocks). The unit at
+   offset 0 heads the doubly linked list; the free block ending the heap meets a zero sentinel. */
+static void pas_rar__ppm_glue(pas_rar__ppm *m)
+{
+    uint32_t p, p1, prev, next;
+    unsigned i, k, sz;
+
+    pas_rar__ppm_put32(m, 4, 0);
+    pas_rar__ppm_put32(m, 8, 0);
+    if (m->lo_unit != m->hi_unit) m->base[m->lo_unit] = 0;
+    for (i = 0; i < PAS_RAR_PPM_INDEXES; i++)
+        while (m->free_list[i]) {
+            p = pas_rar__ppm_remove(m, i);
+            next = pas_rar__ppm_get32(m, 4);
+            pas_rar__ppm_put32(m, p + 8, 0);
+            pas_rar__ppm_put32(m, p + 4, next);
+            pas_rar__ppm_put32(m, next + 8, p);
+            pas_rar__ppm_put32(m, 4, p);
+            pas_rar__ppm_put16(m, p, 0xFFFF);
+            pas_rar__ppm_put16(m, p + 2, m->indx2units[i]);
+        }
+    for (p = pas_rar__ppm_get32(m, 4); p != 0; p = pas_rar__ppm_get32(m, p + 4))
+        for (;;) {
+            unsigned nu = pas_rar__ppm_get16(m, p + 2);
+            p1 = p + nu * PAS_RAR_PPM_UNIT;
+            if (pas_rar__ppm_get16(m, p1) != 0xFFFF || nu + pas_rar__ppm_get16(m, p1 + 2) >= 0x10000) break;
+            prev = pas_rar__ppm_get32(m, p1 + 8);
+            next = pas_rar__ppm_get32(m, p1 + 4);
+            pas_rar__ppm_put32(m, prev + 4, next);
+            pas_rar__ppm_put32(m, next + 8, prev);
+            pas_rar__ppm_put16(m, p + 2, nu + pas_rar__ppm_get16(m, p1 + 2));
+        }
+    while ((p = pas_rar__ppm_get32(m, 4)) != 0) {
+        next = pas_rar__ppm_get32(m, p + 4);
+        pas_rar__ppm_put32(m, 4, next);
+        pas_rar__ppm_put32(m, next + 8, 0);
+        for (sz = pas_rar__ppm_get16(m, p + 2); sz > 128; sz -= 128, p += 128 * PAS_RAR_PPM_UNIT)
+            pas_rar__ppm_insert(m, p, PAS_RAR_PPM_INDEXES - 1);
+        if (m->indx2units[i = m->units2indx[sz - 1]] != sz) {
+            k = sz - m->indx2units[--i];
+            pas_rar__ppm_insert(m, p + (sz - k) * PAS_RAR_PPM_UNIT, k - 1);
+        }
+        pas_rar__ppm_insert(m, p, i);
+    }
+}
+
+static uint32_t pas_rar__ppm_alloc_rare(pas_rar__ppm *m, unsigned indx)
+{
+    unsigned i = indx;
+    if (!m->glue_count) {
+        m->glue_count = 255;
+        pas_rar__ppm_glue(m);
+        if (m->free_list[indx]) return pas_rar__ppm_remove(m, indx);
+    }
+    do {
+        if (++i == PAS_RAR_PPM_INDEXES) {
+            uint32_t bytes = m->indx2units[indx] * PAS_RAR_PPM_UNIT;
+            m->glue_count--;
+            if (m->units_start - m->text > bytes) return m->units_start -= bytes;
+            return 0;
+        }
+    } while (!m->free_list[i]);
+    {
+        uint32_t p = pas_rar__ppm_remove(m, i);
+        pas_rar__ppm_split(m, p, i, indx);
+        return p;
+    }
+}
+
+static uint32_t pas_rar__ppm_alloc_units(pas_rar__ppm *m, unsigned nu)
+{
+    unsigned indx = m->units2indx[nu - 1];
+    uint32_t bytes = m->indx2units[indx] * PAS_RAR_PPM_UNIT;
+    if (m->free_list[indx]) return pas_rar__ppm_remove(m, indx);
+    if (m->hi_unit - m->lo_unit >= bytes) {
+        m->lo_unit += bytes;
+        return m->lo_unit - bytes;
+    }
+    return pas_rar__ppm_alloc_rare(m, indx);
+}
+
+static uint32_t pas_rar__ppm_alloc_context(pas_rar__ppm *m)
+{
+    if (m->hi_unit != m->lo_unit) return m->hi_unit -= PAS_RAR_PPM_UNIT;
+    if (m->free_list[0]) return pas_rar__ppm_remove(m, 0);
+    return pas_rar__ppm_alloc_rare(m, 0);
+}
+
+static uint32_t pas_rar__ppm_expand_units(pas_rar__ppm *m, uint32_t old, unsigned old_nu)
+{
+    unsigned i0 = m->units2indx[old_nu - 1], i1 = m->units2indx[old_nu];
+    uint32_t p;
+    if (i0 == i1) return old;
+    p = pas_rar__ppm_alloc_units(m, old_nu + 1);
+    if (p) {
+        memcpy(m->base + p, m->base + old, old_nu * PAS_RAR_PPM_UNIT);
+        pas_rar__ppm_insert(m, old, i0);
+    }
+    return p;
+}
+
+static uint32_t pas_rar__ppm_shrink_units(pas_rar__ppm *m, uint32_t old, unsigned old_nu, unsigned new_nu)
+{
+    unsigned i0 = m->units2indx[old_nu - 1], i1 = m->units2indx[new_nu - 1];
+    if (i0 == i1) return old;
+    if (m->free_list[i1]) {
+        uint32_t p = pas_rar__ppm_remove(m, i1);
+        memcpy(m->base + p, m->base + old, new_nu * PAS_RAR_PPM_UNIT);
+        pas_rar__ppm_insert(m, old, i0);
+        return p;
+    }
+    pas_rar__ppm_split(m, old, i0, i1);
+    return old;
+}
+
+static void pas_rar__ppm_restart(pas_rar__ppm *m)
+{
+    static const uint16_t init_bin_esc[8] = { 0x3CDD, 0x1F3F, 0x59BF, 0x48F3, 0x64A1, 0x5ABC, 0x6632, 0x6051 };
+    uint32_t size2 = PAS_RAR_PPM_UNIT * (m->size / 8 / PAS_RAR_PPM_UNIT * 7);
+    pas_rar__ppm_ctx *c;
+    pas_rar__ppm_state *s;
+    unsigned i, k, j;
+
+    memset(m->char_mask, 0, sizeof(m->char_mask));
+    memset(m->free_list, 0, sizeof(m->free_list));
+    m->text = PAS_RAR_PPM_UNIT;
+    m->hi_unit = PAS_RAR_PPM_UNIT + m->size;
+    m->lo_unit = m->units_start = m->hi_unit - size2;
+    m->glue_count = 0;
+
+    m->init_rl = -(m->max_order < 12 ? m->max_order : 12) - 1;
+    c = m->min_context = m->max_context = pas_rar__ppm_ctx_at(m, pas_rar__ppm_alloc_context(m));
+    c->suffix = 0;
+    m->order_fall = m->max_order;
+    c->num_stats = 256;
+    c->u.s.summ_freq = 257;
+    pas_rar__ppm_set_stats(c, pas_rar__ppm_alloc_units(m, 128));
+    s = m->found_state = pas_rar__ppm_stats(m, c);
+    for (i = 0; i < 256; i++) {
+        s[i].symbol = (uint8_t)i;
+        s[i].freq = 1;
+        pas_rar__ppm_set_succ(&s[i], 0);
+    }
+    m->run_length = m->init_rl;
+    m->prev_success = 0;
+    for (i = 0; i < 128; i++)
+        for (k = 0; k < 8; k++)
+            for (j = 0; j < 64; j += 8)
+                m->bin_summ[i][k + j] = (uint16_t)(PAS_RAR_PPM_BIN_SCALE - init_bin_esc[k] / (i + 2));
+    for (i = 0; i < 25; i++)
+        for (k = 0; k < 16; k++) {
+            m->see2[i][k].shift = PAS_RAR_PPM_PERIOD_BITS - 4;
+            m->see2[i][k].summ = (uint16_t)((5 * i + 10) << m->see2[i][k].shift);
+            m->see2[i][k].count = 4;
+        }
+}
+
+/* New model of size bytes (heap at base) and maximum order */
+static void pas_rar__ppm_start(pas_rar__ppm *m, uint32_t size, int max_order)
+{
+    unsigned i, k, n, step;
+
+    m->size = size;
+    memset(m->base + PAS_RAR_PPM_UNIT + size, 0, PAS_RAR_PPM_UNIT);
+    for (i = 0, k = 1; i < 4; i++, k += 1) m->indx2units[i] = (uint8_t)k;
+    for (k++; i < 8; i++, k += 2) m->indx2units[i] = (uint8_t)k;
+    for (k++; i < 12; i++, k += 3) m->indx2units[i] = (uint8_t)k;
+    for (k++; i < PAS_RAR_PPM_INDEXES; i++, k += 4) m->indx2units[i] = (uint8_t)k;
+    for (k = i = 0; k < 128; k++) {
+        i += m->indx2units[i] < k + 1;
+        m->units2indx[k] = (uint8_t)i;
+    }
+    m->esc_count = 1;
+    m->max_order = max_order;
+    pas_rar__ppm_restart(m);
+    m->ns2bsindx[0] = 0;
+    m->ns2bsindx[1] = 2;
+    memset(m->ns2bsindx + 2, 4, 9);
+    memset(m->ns2bsindx + 11, 6, 256 - 11);
+    for (i = 0; i < 3; i++) m->ns2indx[i] = (uint8_t)i;
+    for (n = i, k = step = 1; i < 256; i++) {
+        m->ns2indx[i] = (uint8_t)n;
+        if (!--k) {
+            k = ++step;
+            n++;
+        }
+    }
+    memset(m->hb2flag, 0, 0x40);
+    memset(m->hb2flag + 0x40, 8, 0x100 - 0x40);
+    m->dummy_see2.shift = PAS_RAR_PPM_PERIOD_BITS;
+    m->dummy_see2.summ = 0;
+    m->dummy_see2.count = 0;
+}
+
+static void pas_rar__ppm_rescale(pas_rar__ppm *m, pas_rar__ppm_ctx *c)
+{
+    pas_rar__ppm_state *stats = pas_rar__ppm_stats(m, c), *p, *p1, tmp;
+    int old_ns = c->num_stats, i = c->num_stats - 1, adder, esc_freq;
+
+    for (p = m->found_state; p != stats; p--) pas_rar__ppm_swap(p, p - 1);
+    stats->freq = (uint8_t)(stats->freq + 4);
+    c->u.s.summ_freq += 4;
+    esc_freq = c->u.s.summ_freq - p->freq;
+    adder = m->order_fall != 0;
+    c->u.s.summ_freq = p->freq = (uint8_t)((p->freq + adder) >> 1);
+    do {
+        esc_freq -= (++p)->freq;
+        c->u.s.summ_freq = (uint16_t)(c->u.s.summ_freq + (p->freq = (uint8_t)((p->freq + adder) >> 1)));
+        if (p[0].freq > p[-1].freq) {
+            tmp = *(p1 = p);
+            do {
+                p1[0] = p1[-1];
+            } while (--p1 != stats && tmp.freq > p1[-1].freq);
+            *p1 = tmp;
+        }
+    } while (--i);
+    if (p->freq == 0) {
+        do {
+            i++;
+        } while ((--p)->freq == 0);
+        esc_freq += i;
+        if ((c->num_stats = (uint16_t)(c->num_stats - i)) == 1) {
+            tmp = *stats;
+            do {
+                tmp.freq = (uint8_t)(tmp.freq - (tmp.freq >> 1));
+                esc_freq >>= 1;
+            } while (esc_freq > 1);
+            pas_rar__ppm_insert(m, pas_rar__ppm_ref(m, stats), m->units2indx[((old_ns + 1) >> 1) - 1]);
+            *(m->found_state = &c->u.one) = tmp;
+            return;
+        }
+    }
+    c->u.s.summ_freq = (uint16_t)(c->u.s.summ_freq + (esc_freq -= esc_freq >> 1));
+    if ((old_ns + 1) >> 1 != (c->num_stats + 1) >> 1)
+        pas_rar__ppm_set_stats(c, pas_rar__ppm_shrink_units(m, pas_rar__ppm_ref(m, stats), (unsigned)(old_ns + 1) >> 1,
+                                                            (c->num_stats + 1u) >> 1));
+    m->found_state = pas_rar__ppm_stats(m, c);
+}
+
+static pas_rar__ppm_ctx *pas_rar__ppm_create_child(pas_rar__ppm *m, pas_rar__ppm_ctx *parent,
+                                                   pas_rar__ppm_state *ps, const pas_rar__ppm_state *first)
+{
+    pas_rar__ppm_ctx *c = pas_rar__ppm_ctx_at(m, pas_rar__ppm_alloc_context(m));
+    if (c) {
+        c->num_stats = 1;
+        c->u.one = *first;
+        c->suffix = pas_rar__ppm_ref(m, parent);
+        pas_rar__ppm_set_succ(ps, pas_rar__ppm_ref(m, c));
+    }
+    return c;
+}
+
+static pas_rar__ppm_ctx *pas_rar__ppm_create_successors(pas_rar__ppm *m, int skip, pas_rar__ppm_state *p1)
+{
+    pas_rar__ppm_state up_state, *p, *ps[PAS_RAR_PPM_MAX_O];
+    pas_rar__ppm_ctx *pc = m->min_context;
+    uint32_t up_branch = pas_rar__ppm_succ(m->found_state);
+    uint8_t sym = m->found_state->symbol;
+    unsigned n = 0;
+
+    if (!skip) {
+        ps[n++] = m->found_state;
+        if (!pc->suffix) goto no_loop;
+    }
+    if (p1) {
+        p = p1;
+        pc = pas_rar__ppm_ctx_at(m, pc->suffix);
+        goto loop_entry;
+    }
+    do {
+        pc = pas_rar__ppm_ctx_at(m, pc->suffix);
+        if (pc->num_stats != 1) {
+            if ((p = pas_rar__ppm_stats(m, pc))->symbol != sym)
+                do {
+                    p++;
+                } while (p->symbol != sym);
+        } else {
+            p = &pc->u.one;
+        }
+loop_entry:
+        if (pas_rar__ppm_succ(p) != up_branch) {
+            pc = pas_rar__ppm_ctx_at(m, pas_rar__ppm_succ(p));
+            break;
+        }
+        if (n >= PAS_RAR_PPM_MAX_O) return NULL;
+        ps[n++] = p;
+    } while (pc->suffix);
+no_loop:
+    if (n == 0) return pc;
+    up_state.symbol = m->base[up_branch];
+    pas_rar__ppm_set_succ(&up_state, up_branch + 1);
+    if (pc->num_stats != 1) {
+        uint32_t cf, s0;
+        if (pas_rar__ppm_ref(m, pc) <= m->text) return NULL;
+        if ((p = pas_rar__ppm_stats(m, pc))->symbol != up_state.symbol)
+            do {
+                p++;
+            } while (p->symbol != up_state.symbol);
+        cf = p->freq - 1u;
+        s0 = pc->u.s.summ_freq - pc->num_stats - cf;
+        /* s0 counts the escape frequency and is never 0 in a consistent model; stay defined anyway */
+        up_state.freq = (uint8_t)(1 + (2 * cf <= s0 ? (5 * cf > s0) : (2 * cf + 3 * s0 - 1) / (2 * s0 + !s0)));
+    } else {
+        up_state.freq = pc->u.one.freq;
+    }
+    do {
+        pc = pas_rar__ppm_create_child(m, pc, ps[--n], &up_state);
+        if (!pc) return NULL;
+    } while (n);
+    return pc;
+}
+
+static void pas_rar__ppm_update_model(pas_rar__ppm *m)
+{
+    pas_rar__ppm_state fs = *m->found_state, *p = NULL;
+    pas_rar__ppm_ctx *pc, *mc = m->min_context;
+    uint32_t successor, ns1, ns, cf, sf, s0, r;
+
+    if (fs.freq < PAS_RAR_PPM_MAX_FREQ / 4 && (pc = pas_rar__ppm_ctx_at(m, mc->suffix)) != NULL) {
+        if (pc->num_stats != 1) {
+            if ((p = pas_rar__ppm_stats(m, pc))->symbol != fs.symbol) {
+                do {
+                    p++;
+                } while (p->symbol != fs.symbol);
+                if (p[0].freq >= p[-1].freq) {
+                    pas_rar__ppm_swap(p, p - 1);
+                    p--;
+                }
+            }
+            if (p->freq < PAS_RAR_PPM_MAX_FREQ - 9) {
+                p->freq = (uint8_t)(p->freq + 2);
+                pc->u.s.summ_freq += 2;
+            }
+        } else {
+            p = &pc->u.one;
+            p->freq = (uint8_t)(p->freq + (p->freq < 32));
+        }
+    }
+    if (!m->order_fall) {
+        m->min_context = m->max_context = pas_rar__ppm_create_successors(m, 1, p);
+        if (!m->min_context) goto restart;
+        pas_rar__ppm_set_succ(m->found_state, pas_rar__ppm_ref(m, m->min_context));
+        return;
+    }
+    m->base[m->text++] = fs.symbol;
+    successor = m->text;
+    if (m->text >= m->units_start) goto restart;
+    if (pas_rar__ppm_succ(&fs)) {
+        if (pas_rar__ppm_succ(&fs) <= m->text) {
+            pas_rar__ppm_ctx *cs = pas_rar__ppm_create_successors(m, 0, p);
+            if (!cs) goto restart;
+            pas_rar__ppm_set_succ(&fs, pas_rar__ppm_ref(m, cs));
+        }
+        if (!--m->order_fall) {
+            successor = pas_rar__ppm_succ(&fs);
+            m->text -= m->max_context != mc;
+        }
+    } else {
+        pas_rar__ppm_set_succ(m->found_state, successor);
+        pas_rar__ppm_set_succ(&fs, pas_rar__ppm_ref(m, mc));
+    }
+    /* A binary context has no SummFreq; like unrar on little-endian hosts, read its state's
+       symbol and frequency bytes in its place */
+    ns = mc->num_stats;
+    s0 = (ns != 1 ? mc->u.s.summ_freq : mc->u.one.symbol | (uint32_t)mc->u.one.freq << 8) - ns - (fs.freq - 1u);
+    for (pc = m->max_context; pc != mc; pc = pas_rar__ppm_ctx_at(m, pc->suffix)) {
+        if ((ns1 = pc->num_stats) != 1) {
+            if ((ns1 & 1) == 0) {
+                r = pas_rar__ppm_expand_units(m, pas_rar__ppm_stats_ref(pc), ns1 >> 1);
+                if (!r) goto restart;
+                pas_rar__ppm_set_stats(pc, r);
+            }
+            pc->u.s.summ_freq = (uint16_t)(pc->u.s.summ_freq + (2 * ns1 < ns) +
+                                           2 * ((4 * ns1 <= ns) & (pc->u.s.summ_freq <= 8 * ns1)));
+        } else {
+            r = pas_rar__ppm_alloc_units(m, 1);
+            if (!r) goto restart;
+            p = (pas_rar__ppm_state *)(void *)(m->base + r);
+            *p = pc->u.one;
+            pas_rar__ppm_set_stats(pc, r);
+            if (p->freq < PAS_RAR_PPM_MAX_FREQ / 4 - 1) p->freq = (uint8_t)(p->freq * 2);
+            else p->freq = PAS_RAR_PPM_MAX_FREQ - 4;
+            pc->u.s.summ_freq = (uint16_t)(p->freq + m->init_esc + (ns > 3));
+        }
+        cf = 2 * fs.freq * (pc->u.s.summ_freq + 6u);
+        sf = s0 + pc->u.s.summ_freq;
+        if (cf < 6 * sf) {
+            cf = 1 + (cf > sf) + (cf >= 4 * sf);
+            pc->u.s.summ_freq += 3;
+        } else {
+            cf = 4 + (cf >= 9 * sf) + (cf >= 12 * sf) + (cf >= 15 * sf);
+            pc->u.s.summ_freq = (uint16_t)(pc->u.s.summ_freq + cf);
+        }
+        p = pas_rar__ppm_stats(m, pc) + ns1;
+        pas_rar__ppm_set_succ(p, successor);
+        p->symbol = fs.symbol;
+        p->freq = (uint8_t)cf;
+        pc->num_stats = (uint16_t)++ns1;
+    }
+    m->max_context = m->min_context = pas_rar__ppm_ctx_at(m, pas_rar__ppm_succ(&fs));
+    return;
+restart:
+    pas_rar__ppm_restart(m);
+    m->esc_count = 0;
+}
+
+static unsigned pas_rar__ppm_see_mean(pas_rar__ppm_see *s)
+{
+    unsigned r = (unsigned)s->summ >> s->shift;
+    s->summ = (uint16_t)(s->summ - r);
+    return r + (r == 0);
+}
+
+static void pas_rar__ppm_see_update(pas_rar__ppm_see *s)
+{
+    if (s->shift < PAS_RAR_PPM_PERIOD_BITS && --s->count == 0) {
+        s->summ = (uint16_t)(s->summ * 2);
+        s->count = (uint8_t)(3 << s->shift++);
+    }
+}
+
+static void pas_rar__ppm_clear_mask(pas_rar__ppm *m)
+{
+    m->esc_count = 1;
+    memset(m->char_mask, 0, sizeof(m->char_mask));
+}
+
+/* Probability cell of the escape from a binary context */
+static uint16_t *pas_rar__ppm_bin_summ(pas_rar__ppm *m, pas_rar__ppm_ctx *c)
+{
+    const pas_rar__ppm_state *rs = &c->u.one;
+    m->hi_bits_flag = m->hb2flag[m->found_state->symbol];
+    return &m->bin_summ[rs->freq - 1][m->prev_success + m->ns2bsindx[pas_rar__ppm_ctx_at(m, c->suffix)->num_stats - 1] +
+                                      m->hi_bits_flag + 2 * m->hb2flag[rs->symbol] + (m->run_length < 0 ? 0x20 : 0)];
+}
+
+/* SEE context for the escape of c with diff unmasked symbols; sets the coder scale */
+static pas_rar__ppm_see *pas_rar__ppm_make_esc_freq2(pas_rar__ppm *m, pas_rar__ppm_ctx *c, unsigned diff)
+{
+    pas_rar__ppm_see *see;
+    if (c->num_stats != 256) {
+        see = &m->see2[m->ns2indx[diff - 1]]
+                      [((int)diff < (int)pas_rar__ppm_ctx_at(m, c->suffix)->num_stats - (int)c->num_stats) +
+                       2 * (c->u.s.summ_freq < 11 * c->num_stats) + 4 * (m->num_masked > diff) + m->hi_bits_flag];
+        m->scale = pas_rar__ppm_see_mean(see);
+    } else {
+        see = &m->dummy_see2;
+        m->scale = 1;
+    }
+    return see;
+}
+
+static void pas_rar__ppm_update1(pas_rar__ppm *m, pas_rar__ppm_ctx *c, pas_rar__ppm_state *p)
+{
+    (m->found_state = p)->freq = (uint8_t)(p->freq + 4);
+    c->u.s.summ_freq += 4;
+    if (p[0].freq > p[-1].freq) {
+        pas_rar__ppm_swap(p, p - 1);
+        m->found_state = --p;
+        if (p->freq > PAS_RAR_PPM_MAX_FREQ) pas_rar__ppm_rescale(m, c);
+    }
+}
+
+static void pas_rar__ppm_update2(pas_rar__ppm *m, pas_rar__ppm_ctx *c, pas_rar__ppm_state *p)
+{
+    (m->found_state = p)->freq = (uint8_t)(p->freq + 4);
+    c->u.s.summ_freq += 4;
+    if (p->freq > PAS_RAR_PPM_MAX_FREQ) pas_rar__ppm_rescale(m, c);
+    m->esc_count++;
+    m->run_length = m->init_rl;
+}
+
+/* Range decoder (Subbotin's carryless coder, as in RAR) */
+static unsigned pas_rar__ppm_byte(pas_rar__ppm *m)
+{
+    return pas_rar__in_byte(m->src, m->in_pos++, 1);
+}
+
+static void pas_rar__ppm_coder_init(pas_rar__ppm *m)
+{
+    unsigned i;
+    m->low = m->code = 0;
+    m->range = 0xffffffffu;
+    for (i = 0; i < 4; i++) m->code = (m->code << 8) | pas_rar__ppm_byte(m);
+}
+
+static unsigned pas_rar__ppm_count(pas_rar__ppm *m)
+{
+    m->range /= m->scale;
+    return m->range ? (m->code - m->low) / m->range : m->scale; /* range < scale: corrupt */
+}
+
+static void pas_rar__ppm_coder_decode(pas_rar__ppm *m)
+{
+    m->low += m->range * m->low_count;
+    m->range *= m->high_count - m->low_count;
+}
+
+static void pas_rar__ppm_normalize(pas_rar__ppm *m)
+{
+    for (;;) {
+        if ((m->low ^ (m->low + m->range)) >= PAS_RAR_PPM_TOP) {
+            if (m->range >= PAS_RAR_PPM_BOT) break;
+            m->range = (0u - m->low) & (PAS_RAR_PPM_BOT - 1);
+        }
+        m->code = (m->code << 8) | pas_rar__ppm_byte(m);
+        m->range <<= 8;
+        m->low <<= 8;
+    }
+}
+
+static void pas_rar__ppm_decode_bin(pas_rar__ppm *m, pas_rar__ppm_ctx *c)
+{
+    pas_rar__ppm_state *rs = &c->u.one;
+    uint16_t *bs = pas_rar__ppm_bin_summ(m, c);
+
+    if ((m->code - m->low) / (m->range >>= PAS_RAR_PPM_TOT_BITS) < *bs) {
+        m->found_state = rs;
+        rs->freq = (uint8_t)(rs->freq + (rs->freq < 128));
+        m->low_count = 0;
+        m->high_count = *bs;
+        *bs = (uint16_t)(*bs + PAS_RAR_PPM_INTERVAL - PAS_RAR_PPM_MEAN(*bs));
+        m->prev_success = 1;
+        m->run_length++;
+    } else {
+        static const uint8_t exp_escape[16] = { 25, 14, 9, 7, 5, 5, 4, 4, 4, 3, 3, 3, 2, 2, 2, 2 };
+        m->low_count = *bs;
+        *bs = (uint16_t)(*bs - PAS_RAR_PPM_MEAN(*bs));
+        m->high_count = PAS_RAR_PPM_BIN_SCALE;
+        m->init_esc = exp_escape[*bs >> 10];
+        m->num_masked = 1;
+        m->char_mask[rs->symbol] = m->esc_count;
+        m->prev_success = 0;
+        m->found_state = NULL;
+    }
+}
+
+static int pas_rar__ppm_decode_symbol1(pas_rar__ppm *m, pas_rar__ppm_ctx *c)
+{
+    pas_rar__ppm_state *p = pas_rar__ppm_stats(m, c);
+    unsigned i, count, hi_cnt;
+
+    m->scale = c->u.s.summ_freq;
+    count = pas_rar__ppm_count(m);
+    if (count >= m->scale) return 0;
+    if (count < (hi_cnt = p->freq)) {
+        m->high_count = hi_cnt;
+        m->prev_success = 2 * hi_cnt > m->scale;
+        m->run_length += (int)m->prev_success;
+        (m->found_state = p)->freq = (uint8_t)(hi_cnt += 4);
+        c->u.s.summ_freq += 4;
+        if (hi_cnt > PAS_RAR_PPM_MAX_FREQ) pas_rar__ppm_rescale(m, c);
+        m->low_count = 0;
+        return 1;
+    }
+    if (!m->found_state) return 0;
+    m->prev_success = 0;
+    i = c->num_stats - 1u;
+    while ((hi_cnt += (++p)->freq) <= count)
+        if (--i == 0) {
+            /* Escape: mask every symbol of this context for the shorter ones */
+            m->hi_bits_flag = m->hb2flag[m->found_state->symbol];
+            m->low_count = hi_cnt;
+            m->char_mask[p->symbol] = m->esc_count;
+            i = (m->num_masked = c->num_stats) - 1u;
+            m->found_state = NULL;
+            do {
+                m->char_mask[(--p)->symbol] = m->esc_count;
+            } while (--i);
+            m->high_count = m->scale;
+            return 1;
+        }
+    m->low_count = (m->high_count = hi_cnt) - p->freq;
+    pas_rar__ppm_update1(m, c, p);
+    return 1;
+}
+
+static int pas_rar__ppm_decode_symbol2(pas_rar__ppm *m, pas_rar__ppm_ctx *c)
+{
+    pas_rar__ppm_state *ps[256], *p = pas_rar__ppm_stats(m, c) - 1;
+    unsigned i = c->num_stats - m->num_masked, n = 0, k, hi_cnt = 0, count;
+    pas_rar__ppm_see *see = pas_rar__ppm_make_esc_freq2(m, c, i);
+
+    do {
+        do {
+            p++;
+        } while (m->char_mask[p->symbol] == m->esc_count);
+        hi_cnt += p->freq;
+        if (n == 256) return 0;
+        ps[n++] = p;
+    } while (--i);
+    m->scale += hi_cnt;
+    count = pas_rar__ppm_count(m);
+    if (count >= m->scale) return 0;
+    if (count < hi_cnt) {
+        k = 0;
+        hi_cnt = 0;
+        while ((hi_cnt += ps[k]->freq) <= count) k++;
+        p = ps[k];
+        m->low_count = (m->high_count = hi_cnt) - p->freq;
+        pas_rar__ppm_see_update(see);
+        pas_rar__ppm_update2(m, c, p);
+    } else {
+        m->low_count = hi_cnt;
+        m->high_count = m->scale;
+        for (k = 0; k < n; k++) m->char_mask[ps[k]->symbol] = m->esc_count;
+        see->summ = (uint16_t)(see->summ + m->scale);
+        m->num_masked = c->num_stats;
+    }
+    return 1;
+}
+
+/* Context reference that points into the units area */
+static int pas_rar__ppm_valid(const pas_rar__ppm *m, uint32_t r)
+{
+    return r > m->text && r <= m->size;
+}
+
+/* Next symbol, or -1 on corrupt data */
+static int pas_rar__ppm_decode_char(pas_rar__ppm *m)
+{
+    pas_rar__ppm_ctx *c = m->min_context;
+    int sym;
+
+    if (!pas_rar__ppm_valid(m, pas_rar__ppm_ref(m, c))) return -1;
+    if (c->num_stats != 1) {
+        if (!pas_rar__ppm_valid(m, pas_rar__ppm_stats_ref(c)) || !pas_rar__ppm_decode_symbol1(m, c)) return -1;
+    } else {
+        pas_rar__ppm_decode_bin(m, c);
+    }
+    pas_rar__ppm_coder_decode(m);
+    while (!m->found_state) {
+        pas_rar__ppm_normalize(m);
+        do {
+            m->order_fall++;
+            if (!pas_rar__ppm_valid(m, c->suffix)) return -1;
+            c = m->min_context = pas_rar__ppm_ctx_at(m, c->suffix);
+        } while (c->num_stats == m->num_masked);
+        if (!pas_rar__ppm_decode_symbol2(m, c)) return -1;
+        pas_rar__ppm_coder_decode(m);
+    }
+    sym = m->found_state->symbol;
+    if (!m->order_fall && pas_rar__ppm_succ(m->found_state) > m->text) {
+        m->min_context = m->max_context = pas_rar__ppm_ctx_at(m, pas_rar__ppm_succ(m->found_state));
+    } else {
+        pas_rar__ppm_update_model(m);
+        if (m->esc_count == 0) pas_rar__ppm_clear_mask(m);
+    }
+    pas_rar__ppm_normalize(m);
+    return sym;
+}
+
+/* ----- RAR 2.9/3.x ----- */
+
+static const uint8_t pas_rar3__lbits[28] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5
+};
+static const uint8_t pas_rar3__sdbits[8] = { 2, 2, 3, 4, 5, 6, 6, 6 };
+static const uint8_t pas_rar3__sddecode[8] = { 0, 4, 8, 16, 32, 64, 128, 192 };
+
+/* Length slot: base from the bit counts above */
+static uint32_t pas_rar3__length(pas_rar_unpack_t *u, unsigned slot)
+{
+    static const uint8_t ldecode[28] = {
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 10, 12, 14, 16, 20, 24, 28, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224
+    };
+    unsigned bits = pas_rar3__lbits[slot];
+    uint32_t len = ldecode[slot];
+    if (bits) {
+        len += pas_rar__peek16(u) >> (16 - bits);
+        u->bitpos += bits;
+    }
+    return len;
+}
+
+/* Distance slots: base and extra bits */
+static const uint32_t pas_rar3__ddecode[60] = {
+    0, 1, 2, 3, 4, 6, 8, 12, 16, 24, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024, 1536,
+    2048, 3072, 4096, 6144, 8192, 12288, 16384, 24576, 32768, 49152, 65536, 98304, 131072, 196608,
+    262144, 327680, 393216, 458752, 524288, 589824, 655360, 720896, 786432, 851968, 917504, 983040,
+    1048576, 1310720, 1572864, 1835008, 2097152, 2359296, 2621440, 2883584, 3145728, 3407872,
+    3670016, 3932160
+};
+static const uint8_t pas_rar3__dbits[60] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13,
+    13, 14, 14, 15, 15, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 18, 18, 18, 18, 18,
+    18, 18, 18, 18, 18, 18, 18
+};
+
+/* Start of a PPMd block (unrar's ModelPPM::DecodeInit), at the byte position of bitpos: flags
+   (0x20 = new model, order - 1 in the low 5 bits; 0x40 = new escape byte follows), model MB - 1
+   when 0x20 is set, then the range coder's first 4 bytes. */
+static pas_rar_status pas_rar3__ppm_init(pas_rar_unpack_t *u)
+{
+    uint64_t pos = u->bitpos >> 3;
+    pas_rar__ppm *m;
+    unsigned flags, mb = 0;
+
+    if (pos >= u->in_total) return PAS_RAR_E_INVALID;
+    flags = pas_rar__in_byte(u, pos++, 1);
+    if (flags & 0x20) {
+        if (pos >= u->in_total) return PAS_RAR_E_INVALID;
+        mb = pas_rar__in_byte(u, pos++, 1) + 1u;
+    } else if (!u->ppm) {
+        return PAS_RAR_E_INVALID;
+    }
+    if (flags & 0x40) {
+        if (pos >= u->in_total) return PAS_RAR_E_INVALID;
+        u->ppm_esc = (uint8_t)pas_rar__in_byte(u, pos++, 1);
+    }
+    if (flags & 0x20) {
+        int order = (int)(flags & 0x1f) + 1;
+        uint8_t *a = u->ppm_arena;
+        if (order > 16) order = 16 + (order - 16) * 3;
+        if (order == 1) {
+            u->ppm = NULL;
+            return PAS_RAR_E_INVALID;
+        }
+        if (!a || u->ppm_arena_size < pas_rar_ppm_arena_size(mb)) {
+            u->ppm = NULL;
+            return PAS_RAR_E_NOSPACE;
+        }
+        a += (8 - ((size_t)a & 7)) & 7;
+        m = (pas_rar__ppm *)(void *)a;
+        m->base = a + sizeof(pas_rar__ppm);
+        pas_rar__ppm_start(m, (uint32_t)mb << 20, order);
+        u->ppm = m;
+    }
+    m = (pas_rar__ppm *)u->ppm;
+    m->src = u;
+    m->in_pos = pos;
+    pas_rar__ppm_coder_init(m);
+    u->ppm_block = 1;
+    return PAS_RAR_OK;
+}
+
+/* Tables at a byte boundary: bit 0x8000 starts a PPMd block instead, 0x4000 keeps the previous
+   lengths as the base of the deltas */
+static pas_rar_status pas_rar3__read_tables(pas_rar_unpack_t *u)
+{
+    uint8_t lens[PAS_RAR3_TABLES];
+    unsigned bits;
+
+    u->bitpos = (u->bitpos + 7) & ~(uint64_t)7;
+    bits = pas_rar__peek16(u);
+    if (bits & 0x8000) return pas_rar3__ppm_init(u);
+    u->ppm_block = 0;
+    u->prev_low_dist = 0;
+    u->low_dist_rep = 0;
+    if (!(bits & 0x4000)) memset(u->old_table, 0, sizeof(u->old_table));
+    u->bitpos += 2;
+    if (!pas_rar__read_lengths(u, lens, PAS_RAR3_TABLES, u->old_table)) return PAS_RAR_E_INVALID;
+    pas_rar__huff_build(&u->ld, lens, PAS_RAR3_NC, PAS_RAR_QUICK_BITS);
+    pas_rar__huff_build(&u->dd, lens + PAS_RAR3_NC, PAS_RAR3_DC, 7);
+    pas_rar__huff_build(&u->ldd, lens + PAS_RAR3_NC + PAS_RAR3_DC, PAS_RAR3_LDC, 7);
+    pas_rar__huff_build(&u->rd, lens + PAS_RAR3_NC + PAS_RAR3_DC + PAS_RAR3_LDC, PAS_RAR3_RC, 7);
+    memcpy(u->old_table, lens, sizeof(u->old_table));
+    u->tables_read = 1;
+    return PAS_RAR_OK;
+}
+
+/* 16 bits at bit pos of a filter record, zeros past its end */
+static unsigned pas_rar3__vm_bits(const uint8_t *code, size_t size, size_t pos)
+{
+    uint32_t v = 0;
+    unsigned i;
+    for (i = 0; i < 3; i++) v = (v << 8) | (pos / 8 + i < size ? code[pos / 8 + i] : 0u);
+    return (v >> (8 - (pos & 7))) & 0xffff;
+}
+
+/* RarVM::ReadData: 2-bit selector, then 4, 8 (or negative 8), 16 or 32 bits */
+static uint32_t pas_rar3__vm_number(const uint8_t *code, size_t size, size_t *pos)
+{
+    uint32_t v = pas_rar3__vm_bits(code, size, *pos);
+    switch (v & 0xc000) {
+    case 0:
+        *pos += 6;
+        return (v >> 10) & 0xf;
+    case 0x4000:
+        if ((v & 0x3c00) == 0) {
+            *pos += 14;
+            return 0xffffff00u | ((v >> 2) & 0xff);
+        }
+        *pos += 10;
+        return (v >> 6) & 0xff;
+    case 0x8000:
+        *pos += 2;
+        v = pas_rar3__vm_bits(code, size, *pos);
+        *pos += 16;
+        return v;
+    default:
+        *pos += 2;
+        v = (uint32_t)pas_rar3__vm_bits(code, size, *pos) << 16;
+        *pos += 16;
+        v |= pas_rar3__vm_bits(code, size, *pos);
+        *pos += 16;
+        return v;
+    }
+}
+
+/* Filter record (unrar's AddVMCode). first: 0x80 = program number follows (0 resets the
+   programs), 0x40 = block start + 258, 0x20 = block length follows, 0x10 = register mask and
+   values follow. A program seen for the first time carries its byte code; only the standard
+   filters are recognised, by length and CRC32. */
+static pas_rar_status pas_rar3__filter(pas_rar_unpack_t *u, unsigned first, const uint8_t *code, size_t size,
+                                       uint64_t target, uint64_t *limit)
+{
+    static const struct { uint32_t len, crc; uint8_t type; } known[6] = {
+        { 53, 0xad576887u, PAS_RAR_FILTER_E8 }, { 57, 0x3cd7e57eu, PAS_RAR_FILTER_E8E9 },
+        { 120, 0x3769893fu, PAS_RAR_FILTER_ITANIUM }, { 29, 0x0e06077du, PAS_RAR_FILTER_DELTA },
+        { 149, 0x1c2c5dc8u, PAS_RAR_FILTER_RGB }, { 216, 0xbc85e701u, PAS_RAR_FILTER_AUDIO }
+    };
+    pas_rar_filter_t f;
+    uint32_t num, start, r[7];
+    size_t pos = 0;
+    unsigned i;
+
+    if (first & 0x80) {
+        num = pas_rar3__vm_number(code, size, &pos);
+        if (num == 0) {
+            u->nprogs = 0;
+            u->nfilters = 0;
+        } else {
+            num--;
+        }
+    } else {
+        num = u->last_filter;
+    }
+    if (num > u->nprogs) return PAS_RAR_E_INVALID;
+    if (num == PAS_RAR_MAX_FILTERS) return PAS_RAR_E_UNSUPPORTED;
+    u->last_filter = num;
+    if (num == u->nprogs) u->prog_len[num] = 0;
+
+    start = pas_rar3__vm_number(code, size, &pos);
+    if (first & 0x40) start += 258;
+    if (first & 0x20) u->prog_len[num] = pas_rar3__vm_number(code, size, &pos);
+    memset(r, 0, sizeof(r));
+    if (first & 0x10) {
+        unsigned mask = pas_rar3__vm_bits(code, size, pos) >> 9;
+        pos += 7;
+        for (i = 0; i < 7; i++)
+            if (mask & (1u << i)) r[i] = pas_rar3__vm_number(code, size, &pos);
+    }
+
+    if (num == u->nprogs) {
+        uint32_t len = pas_rar3__vm_number(code, size, &pos), crc;
+        uint8_t prog[256], x = 0;
+        if (len == 0 || len >= 0x10000 || pos / 8 + len > size) return PAS_RAR_E_INVALID;
+        if (len > sizeof(prog)) return PAS_RAR_E_UNSUPPORTED;
+        for (i = 0; i < len; i++, pos += 8) {
+            prog[i] = (uint8_t)(pas_rar3__vm_bits(code, size, pos) >> 8);
+            if (i) x ^= prog[i];
+        }
+        crc = pas_rar_crc32(0, prog, len);
+        for (i = 0; i < 6; i++)
+            if (known[i].len == len && known[i].crc == crc) break;
+        if (i == 6 || x != prog[0]) return PAS_RAR_E_UNSUPPORTED;
+        u->prog_type[u->nprogs++] = known[i].type;
+    }
+
+    f.type = u->prog_type[num];
+    f.start = u->unp + start;
+    f.length = u->prog_len[num];
+    f.channels = r[0];
+    f.pos_r = (uint8_t)(r[1] > 2 ? 3 : r[1]);
+    if (f.length == 0) return PAS_RAR_OK;
+    if (f.length > PAS_RAR3_MAX_FILTER) return PAS_RAR_E_INVALID;
+    return pas_rar__add_filter(u, &f, target, limit);
+}
+
+/* Filter record from an LZ block: flags byte, length 1..6 in its low bits, or 7 + one byte, or
+   16 bits, then the record */
+static pas_rar_status pas_rar3__filter_lz(pas_rar_unpack_t *u, uint64_t target, uint64_t *limit)
+{
+    uint8_t code[512];
+    unsigned first = pas_rar__peek16(u) >> 8, i;
+    size_t len = (first & 7) + 1;
+
+    u->bitpos += 8;
+    if (len == 7) {
+        len = (pas_rar__peek16(u) >> 8) + 7;
+        u->bitpos += 8;
+    } else if (len == 8) {
+        len = pas_rar__peek16(u);
+        u->bitpos += 16;
+    }
+    if (len == 0) return PAS_RAR_E_INVALID;
+    if (len > sizeof(code)) return PAS_RAR_E_UNSUPPORTED;
+    for (i = 0; i < len; i++) {
+        code[i] = (uint8_t)(pas_rar__peek16(u) >> 8);
+        u->bitpos += 8;
+    }
+    if (u->bitpos > u->block_end) return PAS_RAR_E_INVALID;
+    return pas_rar3__filter(u, first, code, len, target, limit);
+}
+
+/* Next PPMd symbol, -1 on corrupt data or past the end of the input */
+static int pas_rar3__ppm_char(pas_rar_unpack_t *u)
+{
+    pas_rar__ppm *m = (pas_rar__ppm *)u->ppm;
+    int c = pas_rar__ppm_decode_char(m);
+    return m->in_pos > m->src->in_total ? -1 : c;
+}
+
+/* The same record coded as PPMd symbols */
+static pas_rar_status pas_rar3__filter_ppm(pas_rar_unpack_t *u, uint64_t target, uint64_t *limit)
+{
+    uint8_t code[512];
+    int first = pas_rar3__ppm_char(u), c, c2;
+    size_t len, i;
+
+    if (first < 0) return PAS_RAR_E_INVALID;
+    len = (size_t)(first & 7) + 1;
+    if (len == 7) {
+        if ((c = pas_rar3__ppm_char(u)) < 0) return PAS_RAR_E_INVALID;
+        len = (size_t)c + 7;
+    } else if (len == 8) {
+        if ((c = pas_rar3__ppm_char(u)) < 0 || (c2 = pas_rar3__ppm_char(u)) < 0) return PAS_RAR_E_INVALID;
+        len = (size_t)c * 256 + (size_t)c2;
+    }
+    if (len == 0) return PAS_RAR_E_INVALID;
+    if (len > sizeof(code)) return PAS_RAR_E_UNSUPPORTED;
+    for (i = 0; i < len; i++) {
+        if ((c = pas_rar3__ppm_char(u)) < 0) return PAS_RAR_E_INVALID;
+        code[i] = (uint8_t)c;
+    }
+    return pas_rar3__filter(u, (unsigned)first, code, len, target, limit);
+}
+
+/* Decode until stream position target, as pas_rar5__run. The stream is one bit string with no
+   block framing: LZ symbol 256 and the PPMd escape sequence 0 switch to new tables or to the
+   other block type. */
+static pas_rar_status pas_rar3__run(pas_rar_unpack_t *u, uint64_t target)
+{
+    uint64_t limit = u->unp;
+    pas_rar_status st;
+
+    for (;;) {
+        uint32_t len, dist;
+        unsigned sym, bits;
+
+        if (u->unp >= limit) {
+            st = pas_rar__checkpoint(u, target, &limit);
+            if (st != PAS_RAR_OK) return st == PAS_RAR__DONE ? PAS_RAR_OK : st;
+        }
+
+        if (u->ppm_block) {
+            int c = pas_rar3__ppm_char(u);
+            if (c < 0) return PAS_RAR_E_INVALID;
+            if (c == u->ppm_esc) {
+                int n = pas_rar3__ppm_char(u), i, b;
+                switch (n) {
+                case 0: /* end of the PPMd block */
+                    u->bitpos = (uint64_t)((pas_rar__ppm *)u->ppm)->in_pos * 8;
+                    st = pas_rar3__read_tables(u);
+                    if (st != PAS_RAR_OK) return st;
+                    continue;
+                case 3:
+                    st = pas_rar3__filter_ppm(u, target, &limit);
+                    if (st != PAS_RAR_OK) return st;
+                    continue;
+                case 4: /* match: 3 distance bytes (MSB first) and a length byte */
+                    dist = 0;
+                    for (i = 0; i < 3; i++) {
+                        if ((b = pas_rar3__ppm_char(u)) < 0) return PAS_RAR_E_INVALID;
+                        dist = (dist << 8) | (uint32_t)b;
+                    }
+                    if ((b = pas_rar3__ppm_char(u)) < 0) return PAS_RAR_E_INVALID;
+                    if (!pas_rar__copy(u, (uint32_t)b + 32, (uint64_t)dist + 2)) return PAS_RAR_E_INVALID;
+                    continue;
+                case 5: /* run of the previous byte */
+                    if ((b = pas_rar3__ppm_char(u)) < 0) return PAS_RAR_E_INVALID;
+                    if (!pas_rar__copy(u, (uint32_t)b + 4, 1)) return PAS_RAR_E_INVALID;
+                    continue;
+                case -1:
+                case 2: /* end of file before target */
+                    return PAS_RAR_E_INVALID;
+                default: /* the escape byte itself */
+                    break;
+                }
+            }
+            u->window[u->win_pos] = (uint8_t)c;
+            if (++u->win_pos == u->window_size) u->win_pos = 0;
+            u->unp++;
+            continue;
+        }
+
+        if (u->bitpos > u->block_end) return PAS_RAR_E_INVALID;
+        sym = pas_rar__decode(u, &u->ld);
+        if (sym < 256) {
+            u->window[u->win_pos] = (uint8_t)sym;
+            if (++u->win_pos == u->window_size) u->win_pos = 0;
+            u->unp++;
+            continue;
+        }
+        if (sym >= 271) {
+            unsigned dslot;
+            len = pas_rar3__length(u, sym - 271) + 3;
+            dslot = pas_rar__decode(u, &u->dd);
+            dist = pas_rar3__ddecode[dslot] + 1;
+            bits = pas_rar3__dbits[dslot];
+            if (dslot > 9) {
+                /* Low 4 bits through their own table, which can say "same as last time" */
+                if (bits > 4) {
+                    dist += (pas_rar__peek16(u) >> (20 - bits)) << 4;
+                    u->bitpos += bits - 4;
+                }
+                if (u->low_dist_rep) {
+                    u->low_dist_rep--;
+                    dist += u->prev_low_dist;
+                } else {
+                    unsigned low = pas_rar__decode(u, &u->ldd);
+                    if (low == 16) {
+                        u->low_dist_rep = 15;
+                        dist += u->prev_low_dist;
+                    } else {
+                        dist += low;
+                        u->prev_low_dist = low;
+                    }
+                }
+            } else if (bits) {
+                dist += pas_rar__peek16(u) >> (16 - bits);
+                u->bitpos += bits;
+            }
+            if (dist >= 0x2000) {
+                len++;
+                if (dist >= 0x40000) len++;
+            }
+            memmove(u->old_dist + 1, u->old_dist, 3 * sizeof(u->old_dist[0]));
+            u->old_dist[0] = dist;
+            u->last_len = len;
+        } else if (sym == 256) {
+            /* "1": new tables here; "0x": the file ends, with new tables after it if x is set */
+            if (!(pas_rar__peek16(u) & 0x8000)) return PAS_RAR_E_INVALID;
+            u->bitpos++;
+            st = pas_rar3__read_tables(u);
+            if (st != PAS_RAR_OK) return st;
+            continue;
+        } else if (sym == 257) {
+            st = pas_rar3__filter_lz(u, target, &limit);
+            if (st != PAS_RAR_OK) return st;
+            continue;
+        } else if (sym == 258) {
+            if (u->last_len == 0) continue;
+            len = u->last_len;
+            dist = (uint32_t)u->old_dist[0];
+        } else if (sym < 263) {
+            unsigned idx = sym - 259;
+            dist = (uint32_t)u->old_dist[idx];
+            memmove(u->old_dist + 1, u->old_dist, idx * sizeof(u->old_dist[0]));
+            u->old_dist[0] = dist;
+            len = pas_rar3__length(u, pas_rar__decode(u, &u->rd)) + 2;
+            u->last_len = len;
+        } else {
+            unsigned slot = sym - 263;
+            bits = pas_rar3__sdbits[slot];
+            dist = pas_rar3__sddecode[slot] + 1u + (pas_rar__peek16(u) >> (16 - bits));
+            u->bitpos += bits;
+            memmove(u->old_dist + 1, u->old_dist, 3 * sizeof(u->old_dist[0]));
+            u->old_dist[0] = dist;
+            len = 2;
+            u->last_len = len;
+        }
+        if (!pas_rar__copy(u, len, dist)) return PAS_RAR_E_INVALID;
+    }
+}
+
+/* Past the last byte of a file in a solid stream: read the end-of-file code, which decides how
+   the next file's data starts. LZ "00" keeps the tables, "01" has the next file begin with new
+   ones; PPMd escape + 2 leaves the block running into the next file. Tables met on the way (LZ
+   "1", PPMd escape + 0) are read as in the decode loop. A stream without the code keeps its
+   state. */
+static pas_rar_status pas_rar3__file_end(pas_rar_unpack_t *u)
+{
+    pas_rar_status st;
+
+    for (;;) {
+        if (u->ppm_block) {
+            if (pas_rar3__ppm_char(u) != u->ppm_esc || pas_rar3__ppm_char(u) != 0) return PAS_RAR_OK;
+            u->bitpos = (uint64_t)((pas_rar__ppm *)u->ppm)->in_pos * 8;
+        } else {
+            unsigned bits;
+            if (u->bitpos >= u->block_end || pas_rar__decode(u, &u->ld) != 256) return PAS_RAR_OK;
+            bits = pas_rar__peek16(u);
+            if (!(bits & 0x8000)) {
+                u->bitpos += 2;
+                u->tables_read = !(bits & 0x4000);
+                return PAS_RAR_OK;
+            }
+            u->bitpos++;
+        }
+        st = pas_rar3__read_tables(u);
+        if (st != PAS_RAR_OK) return st;
+    }
+}
+
+size_t pas_rar_window_size(const pas_rar_file_t *file)
+{
+    uint64_t need;
+    if (!file || file->method == PAS_RAR_METHOD_STORE) return 0;
+    need = file->dict_size;
+    if (need < PAS_RAR_MIN_WINDOW) need = PAS_RAR_MIN_WINDOW;
+    if (need > file->unpacked_size) need = file->unpacked_size;
+    return need > (uint64_t)SIZE_MAX ? 0 : (size_t)need;
+}
+
+size_t pas_rar_ppm_arena_size(unsigned model_mb)
+{
+    if (model_mb == 0 || model_mb > PAS_RAR_PPM_MAX_MB) return 0;
+    /* model struct (8-aligned), NULL unit, heap, sentinel unit */
+    return sizeof(pas_rar__ppm) + 7 + PAS_RAR_PPM_UNIT + ((size_t)model_mb << 20) + PAS_RAR_PPM_UNIT;
+}
+
+static size_t pas_rar__extract_stored(const pas_rar_file_t *file, void *buffer, size_t buffer_size,
+                                      pas_rar_status *status)
+{
+    pas_rar_key_t key;
+    pas_rar_status st;
+    int crypted = (file->crypt & PAS_RAR_CRYPT_DATA) != 0;
+
+    if (crypted ? file->packed_size < file->unpacked_size || file->packed_size - file->unpacked_size > 15
+                : file->packed_size != file->unpacked_size) {
+        if (status) *status = PAS_RAR_E_INVALID;
+        return 0;
+    }
+    if (file->unpacked_size > (uint64_t)SIZE_MAX) {
+        if (status) *status = PAS_RAR_E_RANGE;
+        return 0;
+    }
+    if (buffer_size < (size_t)file->unpacked_size) {
+        if (status) *status = PAS_RAR_E_NOSPACE;
+        return 0;
+    }
+    if (!pas_rar__data_ok(file)) {
+        if (status) *status = PAS_RAR_E_INVALID;
+        return 0;
+    }
+
+    if (crypted) {
+        /* Whole blocks straight into buffer, the padded last one through a block of its own */
+        pas_rar_crypt_t c;
+        uint8_t last[16];
+        size_t whole = (size_t)file->unpacked_size & ~(size_t)15;
+
+        st = pas_rar__file_key(file, &key);
+        if (st != PAS_RAR_OK) {
+            if (status) *status = st;
+            return 0;
+        }
+        pas_rar__crypt_start(&c, file, &key);
+        (void)pas_rar__crypt_read(&c, (uint8_t *)buffer, whole);
+        if (whole < file->unpacked_size) {
+            (void)pas_rar__crypt_read(&c, last, 16);
+            memcpy((uint8_t *)buffer + whole, last, (size_t)file->unpacked_size - whole);
+        }
+        return pas_rar__extract_check(file, &key, buffer, (size_t)file->unpacked_size, status);
+    }
+    {
+        uint8_t *dst = (uint8_t *)buffer;
+        pas_rar_file_t part = *file;
+        uint32_t vol = file->volume;
+        for (;;) {
+            memcpy(dst, pas_rar__vol_data(file->rar, vol) + part.data_offset, (size_t)part.part_size);
+            dst += part.part_size;
+            if (!(part.split & PAS_RAR_SPLIT_AFTER)) break;
+            (void)pas_rar__next_part(file->rar, &vol, &part);
+        }
+    }
+    return pas_rar__extract_check(file, NULL, buffer, (size_t)file->unpacked_size, status);
+}
+
+/* Compression the decoders handle: RAR 2.9/3.x streams in RAR4 archives, RAR 5.0 in RAR5 */
+static pas_rar_status pas_rar__check_version(const pas_rar_file_t *file)
+{
+    if (file->rar->format == 4 && file->unpack_version < 29) return PAS_RAR_E_COMPRESSED;
+    if (file->rar->format == 4 ? file->unpack_version != 29 && file->unpack_version != 36
+                               : file->unpack_version != 50)
+        return PAS_RAR_E_UNSUPPORTED;
+    return PAS_RAR_OK;
+}
+
+/* Fresh stream: empty window of ring bytes, RAR4 PPMd arena in the rest of the window buffer */
+static void pas_rar__unpack_reset(pas_rar_unpack_t *u, int format, void *window, size_t ring, size_t window_size)
+{
+    u->format = format;
+    u->tables_read = 0;
+    u->window = (uint8_t *)window;
+    u->window_size = ring;
+    u->win_pos = 0;
+    u->unp = 0;
+    u->flushed = 0;
+    memset(u->old_dist, 0, sizeof(u->old_dist));
+    u->last_len = 0;
+    u->nfilters = 0;
+    u->prev_low_dist = 0;
+    u->low_dist_rep = 0;
+    u->ppm_block = 0;
+    u->ppm_esc = 2;
+    u->ppm = NULL;
+    u->ppm_arena = (uint8_t *)window + ring;
+    u->ppm_arena_size = window_size - ring;
+    u->last_filter = 0;
+    u->nprogs = 0;
+    memset(u->old_table, 0, sizeof(u->old_table));
+}
+
+/* Decode file's packed data into out, continuing the stream in u: after a reset that is a
+   non-solid entry, otherwise the window, distances, tables and PPMd model of the previous file
+   carry over. Each file's data starts on its own first byte (a RAR5 block header; a RAR 3.x
+   table read only if the previous file's end code asked for one). out NULL decodes without
+   copying anything out, to move a solid stream past an entry. key is set for an encrypted entry. */
+static pas_rar_status pas_rar__unpack_file(pas_rar_unpack_t *u, const pas_rar_file_t *file,
+                                           const pas_rar_key_t *key, uint8_t *out)
+{
+    uint64_t target = u->unp + file->unpacked_size;
+    pas_rar_status st = PAS_RAR_OK;
+
+    u->crypted = key != NULL;
+    if (key) {
+        pas_rar__crypt_start(&u->crypt, file, key);
+        u->in = u->crypt_buf;
+        u->in_size = 0;
+    } else {
+        u->in = pas_rar__vol_data(file->rar, file->volume) + file->data_offset;
+        u->in_size = (size_t)file->part_size;
+    }
+    u->in_base = 0;
+    u->in_total = file->packed_size;
+    u->in_rar = file->rar;
+    u->in_vol = file->volume;
+    u->bitpos = 0;
+    u->block_end = u->format == 4 ? u->in_total * 8 : 0;
+    u->last_block = 0;
+    u->nfilters = 0;
+    u->out = out;
+    u->out_base = u->unp;
+    u->flushed = u->unp;
+
+    if (u->format == 5) return pas_rar5__run(u, target);
+    if (!file->unpacked_size) return PAS_RAR_OK;
+    if (!u->tables_read) {
+        st = pas_rar3__read_tables(u);
+    } else if (u->ppm_block) {
+        /* The PPMd block goes on: same model and coder, reading the new data */
+        pas_rar__ppm *m = (pas_rar__ppm *)u->ppm;
+        m->src = u;
+        m->in_pos = 0;
+    }
+    return st == PAS_RAR_OK ? pas_rar3__run(u, target) : st;
+}
+
+size_t pas_rar_extract_ex(const pas_rar_file_t *file, void *buffer, size_t buffer_size,
+                          pas_rar_unpack_t *state, void *window, size_t window_size,
+                          pas_rar_status *status)
+{
+    pas_rar_unpack_t *u = state;
+    pas_rar_key_t key;
+    const pas_rar_key_t *crypt_key = NULL;
+    uint64_t need;
+    size_t ring = window_size;
+    pas_rar_status st;
+
+    if (status) *status = PAS_RAR_E_INVALID;
+    if (!file || !file->rar || !buffer) return 0;
+    if (file->method == PAS_RAR_METHOD_STORE) return pas_rar__extract_stored(file, buffer, buffer_size, status);
+    st = pas_rar__check_version(file);
+    if (st == PAS_RAR_OK && file->solid) st = PAS_RAR_E_UNSUPPORTED;
+    if (st == PAS_RAR_OK && (file->crypt & PAS_RAR_CRYPT_DATA)) {
+        st = pas_rar__file_key(file, &key);
+        crypt_key = &key;
+    }
+    if (st != PAS_RAR_OK) {
+        if (status) *status = st;
+        return 0;
+    }
+    if (file->unpacked_size > (uint64_t)SIZE_MAX) {
+        if (status) *status = PAS_RAR_E_RANGE;
+        return 0;
+    }
+    need = file->dict_size < file->unpacked_size ? file->dict_size : file->unpacked_size;
+    if (buffer_size < (size_t)file->unpacked_size || (uint64_t)window_size < need) {
+        if (status) *status = PAS_RAR_E_NOSPACE;
+        return 0;
+    }
+    if (!u || (!window && need) || !pas_rar__data_ok(file)) return 0;
+
+    /* RAR4: the window buffer past the dictionary is the PPMd arena */
+    if (file->rar->format == 4 && pas_rar_window_size(file) < ring) ring = pas_rar_window_size(file);
+
+    pas_rar__unpack_reset(u, file->rar->format, window, ring, window_size);
+    st = pas_rar__unpack_file(u, file, crypt_key, (uint8_t *)buffer);
+    if (st != PAS_RAR_OK) {
+        if (status) *status = st;
+        return 0;
+    }
+    return pas_rar__extract_check(file, crypt_key, buffer, (size_t)file->unpacked_size, status);
+}
+
+size_t pas_rar_extract(pas_rar_file_t *file, void *buffer, size_t buffer_size, pas_rar_status *status)
+{
+    pas_rar_unpack_t state;
+    size_t unp, win;
+
+    if (status) *status = PAS_RAR_E_INVALID;
+    if (!file || !file->rar || !buffer) return 0;
+    if (file->method == PAS_RAR_METHOD_STORE) return pas_rar__extract_stored(file, buffer, buffer_size, status);
+    if (file->unpacked_size > (uint64_t)SIZE_MAX) {
+        if (status) *status = PAS_RAR_E_RANGE;
+        return 0;
+    }
+    unp = (size_t)file->unpacked_size;
+    win = pas_rar_window_size(file);
+    if (buffer_size < unp || buffer_size - unp < win) {
+        if (status) *status = PAS_RAR_E_NOSPACE;
+        return 0;
+    }
+    return pas_rar_extract_ex(file, buffer, unp, &state, (uint8_t *)buffer + unp, buffer_size - unp, status);
+}
+
+/* ----- Sequential extraction ----- */
+
+typedef struct {
+    uint64_t run;   /* unpacked bytes of the solid run so far */
+    uint64_t need;
+} pas_rar__seq_ctx;
+
+static int pas_rar__seq_size_visit(const pas_rar_file_t *f, void *ctx)
+{
+    pas_rar__seq_ctx *c = (pas_rar__seq_ctx *)ctx;
+    uint64_t need;
+
+    if (f->method == PAS_RAR_METHOD_STORE) return 0;
+    if (!f->solid) c->run = 0;
+    c->run += f->unpacked_size;
+    if (c->run < f->unpacked_size) c->run = (uint64_t)-1;
+    need = f->dict_size < PAS_RAR_MIN_WINDOW ? PAS_RAR_MIN_WINDOW : f->dict_size;
+    if (need > c->run) need = c->run;
+    if (need > c->need) c->need = need;
+    return 0;
+}
+
+size_t pas_rar_seq_window_size(const pas_rar_t *rar)
+{
+    pas_rar__seq_ctx c;
+    c.run = 0;
+    c.need = 0;
+    if (!rar || !pas_rar__walk(rar, pas_rar__seq_size_visit, &c)) return 0;
+    return c.need > (uint64_t)SIZE_MAX ? 0 : (size_t)c.need;
+}
+
+int pas_rar_seq_begin(pas_rar_seq_t *seq, const pas_rar_t *rar, pas_rar_unpack_t *state,
+                      void *window, size_t window_size, pas_rar_status *status)
+{
+    size_t need;
+
+    if (status) *status = PAS_RAR_E_INVALID;
+    if (!seq || !rar || !state || (!window && window_size)) return 0;
+    seq->rar = rar;
+    seq->state = state;
+    seq->window = window;
+    seq->window_size = window_size;
+    seq->ring = window_size;
+    need = pas_rar_seq_window_size(rar);
+    if (rar->format == 4 && need < window_size) seq->ring = need;
+    seq->volume = 0;
+    seq->offset = rar->scan_offset;
+    seq->pending = 0;
+    seq->live = 0;
+    if (status) *status = PAS_RAR_OK;
+    return 1;
+}
+
+/* Decode the current entry into out (NULL: only advance the stream); an encrypted entry's keys go
+   to key */
+static pas_rar_status pas_rar__seq_decode(pas_rar_seq_t *seq, uint8_t *out, pas_rar_key_t *key)
+{
+    const pas_rar_file_t *f = &seq->file;
+    pas_rar_unpack_t *u = seq->state;
+    pas_rar_status st;
+    uint64_t need;
+
+    seq->pending = 0;
+    if (f->method == PAS_RAR_METHOD_STORE) return PAS_RAR_OK;
+    st = pas_rar__check_version(f);
+    if (st == PAS_RAR_OK && f->solid && !seq->live) st = PAS_RAR_E_INVALID;
+    if (st == PAS_RAR_OK && !pas_rar__data_ok(f)) st = PAS_RAR_E_INVALID;
+    if (st == PAS_RAR_OK && (f->crypt & PAS_RAR_CRYPT_DATA)) st = pas_rar__file_key(f, key);
+    seq->live = 0;
+    if (st != PAS_RAR_OK) return st;
+    if (!f->solid) pas_rar__unpack_reset(u, seq->rar->format, seq->window, seq->ring, seq->window_size);
+
+    need = u->unp + f->unpacked_size;
+    if (f->dict_size < need) need = f->dict_size;
+    if (need > (uint64_t)seq->ring || (need && !seq->window)) return PAS_RAR_E_NOSPACE;
+
+    st = pas_rar__unpack_file(u, f, (f->crypt & PAS_RAR_CRYPT_DATA) ? key : NULL, out);
+    if (st != PAS_RAR_OK) return st;
+    /* RAR 3.x: the end-of-file code tells how the next entry's data starts */
+    seq->live = u->format == 5 || !f->unpacked_size || pas_rar3__file_end(u) == PAS_RAR_OK;
+    return PAS_RAR_OK;
+}
+
+int pas_rar_seq_next(pas_rar_seq_t *seq, pas_rar_file_t *out, pas_rar_status *status)
+{
+    pas_rar_file_t f;
+    pas_rar_key_t key;
+    int r;
+
+    if (status) *status = PAS_RAR_E_INVALID;
+    if (!seq || !seq->rar) return 0;
+    r = pas_rar__next_entry(seq->rar, &seq->volume, &seq->offset, &f);
+    if (r < 0) return 0;
+    if (r == 0) {
+        if (status) *status = PAS_RAR_OK;
+        return 0;
+    }
+    /* A solid entry needs the one before it decoded, extracted or not; its failure shows up
+       when the solid entry is extracted */
+    if (seq->pending && f.solid) {
+        (void)pas_rar__seq_decode(seq, NULL, &key);
+    } else if (seq->pending && seq->file.method != PAS_RAR_METHOD_STORE) {
+        seq->live = 0;
+    }
+    seq->file = f;
+    seq->pending = 1;
+    if (out) *out = f;
+    if (status) *status = PAS_RAR_OK;
+    return 1;
+}
+
+size_t pas_rar_seq_extract(pas_rar_seq_t *seq, void *buffer, size_t buffer_size, pas_rar_status *status)
+{
+    const pas_rar_file_t *f;
+    pas_rar_key_t key;
+    pas_rar_status st;
+
+    if (status) *status = PAS_RAR_E_INVALID;
+    if (!seq || !seq->rar || !buffer || !seq->pending) return 0;
+    f = &seq->file;
+    if (f->method == PAS_RAR_METHOD_STORE) {
+        seq->pending = 0;
+        return pas_rar__extract_stored(f, buffer, buffer_size, status);
+    }
+    if (f->unpacked_size > (uint64_t)SIZE_MAX) {
+        if (status) *status = PAS_RAR_E_RANGE;
+        return 0;
+    }
+    if (buffer_size < (size_t)f->unpacked_size) {
+        if (status) *status = PAS_RAR_E_NOSPACE;
+        return 0;
+    }
+    st = pas_rar__seq_decode(seq, (uint8_t *)buffer, &key);
+    if (st != PAS_RAR_OK) {
+        if (status) *status = st;
+        return 0;
+    }
+    return pas_rar__extract_check(f, (f->crypt & PAS_RAR_CRYPT_DATA) ? &key : NULL, buffer,
+                                  (size_t)f->unpacked_size, status);
+}
+
+typedef struct {
+    void (*callback)(const char *name, uint64_t size, void *user);
+    void  *user;
+} pas_rar__list_ctx;
+
+static int pas_rar__list_visit(const pas_rar_file_t *f, void *ctx)
+{
+    pas_rar__list_ctx *c = (pas_rar__list_ctx *)ctx;
+    char name[PAS_RAR_MAX_NAME];
+    c->callback(pas_rar__name_copy(f, name), f->unpacked_size, c->user);
+    return 0;
+}
+
+int pas_rar_list(pas_rar_t *rar, void (*callback)(const char *name, uint64_t size, void *user), void *user)
+{
+    pas_rar__list_ctx c;
+    if (!rar || !callback) return -1;
+    c.callback = callback;
+    c.user = user;
+    return pas_rar__walk(rar, pas_rar__list_visit, &c) ? 0 : -1;
 }
 
 #endif /* PAS_RAR_IMPLEMENTATION */
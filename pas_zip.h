@@ -2,10 +2,20 @@
     pas_zip.h - single-header ZIP reader/writer (stb-style)
 
     - No malloc: all APIs use user-provided buffers
-    - Read ZIP from memory: Central Directory parsing
-    - Extract: Store (always), Deflate (optional via PAS_ZIP_USE_MINIZ or PAS_ZIP_USE_ZLIB)
-    - Write ZIP: Store only (optional)
+    - Read ZIP from memory: Central Directory parsing, ZIP64 (archives > 4 GiB, > 65535 entries)
+    - Open from a file path via a read-only memory mapping (optional via PAS_ZIP_USE_MMAP)
+    - Extract: Store and Deflate (built-in decoder; or miniz/zlib via PAS_ZIP_USE_MINIZ / PAS_ZIP_USE_ZLIB)
+    - Streaming reader: decompress an entry chunk by chunk with fixed memory
+    - Random access inside Deflate entries through a zran-style checkpoint index
+    - Write ZIP: Store, or Deflate with the built-in encoder (levels 1-9)
+    - Streaming writer: entries added chunk by chunk, Central Directory from a caller entry table
+    - Parallel Deflate for large entries: pigz-style blocks on worker threads, CRCs combined
+    - CRC-32 (PCLMULQDQ / ARMv8 CRC / slice-by-16), written on create, optionally verified on extract
+    - Duplicate-content deduplication on create (XXH64 into a caller-provided table)
     - UTF-8 filenames: optional via pas_unicode.h
+    - Sorted Central Directory snapshot: prefix and directory listing by binary search
+    - Re-entrant _ex API: caller-owned pas_zip_t / pas_zip_file_t, no shared state
+    - Batch extraction on worker threads (optional via PAS_ZIP_USE_THREADS)
 
     Usage:
         In ONE translation unit:
@@ -15,13 +25,20 @@
         In others:
             #include "pas_zip.h"
 
-    Deflate support (optional):
+    Deflate via an external library (optional, replaces the built-in decoder in pas_zip_extract):
         #define PAS_ZIP_USE_MINIZ
         #include "miniz.h"   // miniz.c or miniz.h single-header
 
         Or:
         #define PAS_ZIP_USE_ZLIB
         #include <zlib.h>
+
+    Memory-mapped files (optional, for pas_zip_open_file / pas_zip_close_file):
+        #define PAS_ZIP_USE_MMAP      // POSIX mmap or Win32 file mapping
+
+    Threads (optional, for pas_zip_extract_many and pas_zip_writer_add_chunk_parallel):
+        #define PAS_ZIP_USE_THREADS   // Win32 threads or pthreads (link with -lpthread)
+        Without it, both run on the calling thread.
 */
 
 #ifndef PAS_ZIP_H
@@ -39,7 +56,9 @@ extern "C" {
 #define PAS_ZIP_E_NOT_FOUND -2
 #define PAS_ZIP_E_COMPRESSED -3  /* deflate needed */
 #define PAS_ZIP_E_NOSPACE   -4
-#define PAS_ZIP_E_ZLIB      -5
+#define PAS_ZIP_E_ZLIB      -5  /* corrupt Deflate data */
+#define PAS_ZIP_E_IO        -6  /* file could not be opened or mapped */
+#define PAS_ZIP_E_CRC       -7  /* extracted data does not match the stored CRC-32 */
 
 #define PAS_ZIP_METHOD_STORE  0
 #define PAS_ZIP_METHOD_DEFLATE 8
@@ -49,42 +68,360 @@ typedef int pas_zip_status;
 typedef struct pas_zip pas_zip_t;
 typedef struct pas_zip_file pas_zip_file_t;
 
+#ifndef PAS_ZIP_MAX_NAME
+#define PAS_ZIP_MAX_NAME 512
+#endif
+#ifndef PAS_ZIP_MAX_THREADS
+#define PAS_ZIP_MAX_THREADS 64
+#endif
+
 struct pas_zip {
     const uint8_t *data;
     size_t         size;
-    uint32_t       cd_offset;
-    uint16_t       num_entries;
+    uint64_t       cd_offset;
+    uint64_t       num_entries; /* from the ZIP64 end record when present */
+    uint32_t      *index;       /* optional name hash index (pas_zip_index_build), NULL if none */
+    size_t         index_slots; /* power of two */
+    int            mapped;      /* data is a file mapping owned by pas_zip_open_file */
+    int            verify_crc;  /* set to 1 to check CRC-32 on extract and streaming reads */
 };
 
 struct pas_zip_file {
-    const char *name;
-    size_t      compressed_size;
-    size_t      uncompressed_size;
-    uint16_t    compression_method;
-    uint32_t    local_header_offset;
+    const char      *name;        /* NUL-terminated; set by pas_zip_find only (shared buffer), NULL for _ex */
+    uint64_t         compressed_size;     /* ZIP64 extra field applied */
+    uint64_t         uncompressed_size;
+    uint16_t         compression_method;
+    uint64_t         local_header_offset;
+    uint32_t         crc32;
+    const pas_zip_t *zip;         /* owning archive */
+    size_t           name_offset; /* name bytes: zip->data + name_offset, not NUL-terminated */
+    uint16_t         name_len;
 };
 
-/* Open ZIP from memory. data/size must remain valid. */
+/* Open ZIP from memory. data/size must remain valid.
+   Returns a pointer to internal static storage: one archive at a time, not thread-safe. */
 pas_zip_t *pas_zip_open(const void *data, size_t size, pas_zip_status *status);
 
-/* Find file by name (case-sensitive). Returns NULL if not found. */
+#ifdef PAS_ZIP_USE_MMAP
+/* Open ZIP from a file by mapping it read-only; nothing is read up front except the Central
+   Directory. Pages are faulted in on demand (random access hint); extracting or streaming an
+   entry first asks the OS to read ahead that entry's range. Returns 1 on success, 0 on error
+   (PAS_ZIP_E_IO if the file cannot be opened or mapped). Release with pas_zip_close_file. */
+int  pas_zip_open_file(pas_zip_t *out, const char *path, pas_zip_status *status);
+void pas_zip_close_file(pas_zip_t *zip);
+#endif
+
+/* Find file by name (case-sensitive). Returns NULL if not found.
+   Returns internal static storage, overwritten by the next pas_zip_find. */
 pas_zip_file_t *pas_zip_find(pas_zip_t *zip, const char *name);
 
+/* Re-entrant variants: caller owns *out. Any number of archives and entries may be live at once,
+   and lookups/extraction on them may run concurrently from different threads.
+   Return 1 on success, 0 on failure / not found. */
+int pas_zip_open_ex(pas_zip_t *out, const void *data, size_t size, pas_zip_status *status);
+int pas_zip_find_ex(const pas_zip_t *zip, const char *name, pas_zip_file_t *out);
+
 /* File info */
 const char *pas_zip_name(pas_zip_file_t *file);
+const char *pas_zip_name_span(const pas_zip_file_t *file, size_t *len); /* not NUL-terminated */
 size_t      pas_zip_size(pas_zip_file_t *file);
 int         pas_zip_is_compressed(pas_zip_file_t *file);
 
-/* Extract file to buffer. Returns bytes written or 0 on error. */
+/* Extract file to buffer. Returns bytes written or 0 on error.
+   With zip->verify_crc set, a CRC-32 mismatch fails with PAS_ZIP_E_CRC. */
 size_t pas_zip_extract(pas_zip_file_t *file, void *buffer, size_t buffer_size, pas_zip_status *status);
 
-/* List all files. callback(name, uncompressed_size, user) */
+/* Zero-copy access to a Store entry: *ptr points into zip->data (for a file, the bytes sit at
+   file offset *ptr - zip->data), valid as long as the archive is. PAS_ZIP_E_COMPRESSED for
+   other methods; with zip->verify_crc the CRC-32 is checked first. Returns 1 on success. */
+int pas_zip_get_data_ptr(const pas_zip_file_t *file, const void **ptr, size_t *len, pas_zip_status *status);
+
+/* Extract n entries of zip in parallel on up to thread_count threads (calling thread included).
+   Entries are split into per-thread ranges of roughly equal compressed size; idle threads steal
+   half of the largest remaining range. Entry i goes to out_buffers[i] (buffer_sizes[i] bytes);
+   statuses[i] and out_sizes[i] (optional) receive the per-entry result of pas_zip_extract.
+   Returns the number of entries extracted successfully. */
+size_t pas_zip_extract_many(const pas_zip_t *zip, const pas_zip_file_t *entries,
+                            void *const *out_buffers, const size_t *buffer_sizes,
+                            size_t *out_sizes, pas_zip_status *statuses, size_t n, int thread_count);
+
+/* List all files. callback(name, uncompressed_size, user); name is valid only during the call
+   and truncated to PAS_ZIP_MAX_NAME - 1 bytes. */
 int pas_zip_list(pas_zip_t *zip, void (*callback)(const char *name, size_t size, void *user), void *user);
 
+/* Name hash index (optional). storage is caller-owned, must stay valid while the index is in use
+   and be at least pas_zip_index_size(zip) bytes. Once built, pas_zip_find uses it too.
+   Returns 0 on success, -1 on error (PAS_ZIP_E_NOSPACE if storage is too small). */
+size_t pas_zip_index_size(pas_zip_t *zip);
+int    pas_zip_index_build(pas_zip_t *zip, void *storage, size_t storage_size, pas_zip_status *status);
+
+/* Find file by name through the index: one hash probe instead of a Central Directory scan.
+   Returns NULL if not found or if no index was built. */
+pas_zip_file_t *pas_zip_find_indexed(pas_zip_t *zip, const char *name);
+int             pas_zip_find_indexed_ex(const pas_zip_t *zip, const char *name, pas_zip_file_t *out);
+
+/* ----- Sorted Central Directory snapshot -----
+   Entries sorted by name (bytewise) in a caller-provided array, so every name starting with a
+   prefix forms one contiguous run found by binary search: prefix and directory queries cost
+   O(log n + k) instead of a full Central Directory scan. Names are spans into the archive. */
+
+typedef struct pas_zip_sorted_entry {
+    size_t   name_offset;  /* name bytes: zip->data + name_offset, not NUL-terminated */
+    uint64_t cd_offset;    /* Central Directory record, from the start of the archive */
+    uint16_t name_len;
+} pas_zip_sorted_entry_t;
+
+typedef struct pas_zip_sorted {
+    const pas_zip_t        *zip;
+    pas_zip_sorted_entry_t *entries;
+    size_t                  count;
+} pas_zip_sorted_t;
+
+typedef struct pas_zip_dir_iter {
+    size_t pos;      /* next sorted position */
+    size_t end;      /* end of the directory's run */
+    size_t dir_len;
+} pas_zip_dir_iter_t;
+
+/* Sort zip's entries into entries (room for max_entries, at least zip->num_entries). Entries with
+   the same name keep Central Directory order. Returns 1 on success, 0 on error
+   (PAS_ZIP_E_NOSPACE if the array is too small). */
+int pas_zip_sorted_build(const pas_zip_t *zip, pas_zip_sorted_t *out, pas_zip_sorted_entry_t *entries,
+                         size_t max_entries, pas_zip_status *status);
+/* Entries whose name starts with prefix are entries[*first .. *first + count). Returns the count. */
+size_t pas_zip_sorted_prefix(const pas_zip_sorted_t *sorted, const char *prefix, size_t *first);
+/* Exact name lookup by binary search. Returns 1 if found. */
+int    pas_zip_sorted_find(const pas_zip_sorted_t *sorted, const char *name, pas_zip_file_t *out);
+/* File info for the entry at sorted position i. Returns 1 on success. */
+int    pas_zip_sorted_entry(const pas_zip_sorted_t *sorted, size_t i, pas_zip_file_t *out);
+
+/* Immediate children of dir ("" for the top level, otherwise ending in '/'). dir_begin returns 0
+   if nothing is under dir. Each dir_next yields one child as a span of its full path: a file,
+   or a subdirectory ending in '/' reported once however many entries it holds (*index is then
+   its first entry). Returns 0 when done. */
+int pas_zip_dir_begin(const pas_zip_sorted_t *sorted, const char *dir, pas_zip_dir_iter_t *it);
+int pas_zip_dir_next(const pas_zip_sorted_t *sorted, pas_zip_dir_iter_t *it,
+                     size_t *index, const char **name, size_t *name_len);
+
+/* ----- Built-in Deflate decoder (raw RFC 1951 stream) -----
+   All decoder state lives in a caller-provided pas_zip_inflate_t (about 12 KB); no window is kept
+   inside it, the output buffer itself is the history. pas_zip_extract uses one on its stack when
+   neither PAS_ZIP_USE_MINIZ nor PAS_ZIP_USE_ZLIB is defined. */
+
+#define PAS_ZIP_LITLEN_TABLE_SIZE 2342  /* 2^11 primary + worst-case subtables for 288 symbols */
+#define PAS_ZIP_DIST_TABLE_SIZE   402   /* 2^8 primary + worst-case subtables for 32 symbols */
+#define PAS_ZIP_PRECODE_TABLE_SIZE 128
+
+typedef struct pas_zip_inflate {
+    const uint8_t *in;          /* next unread input byte */
+    const uint8_t *in_end;
+    uint64_t       bitbuf;      /* LSB-first bit buffer */
+    unsigned       bitcount;
+    unsigned       overrun;     /* zero bytes fed past in_end */
+    int            block;       /* current block kind (internal) */
+    int            final;       /* last block seen */
+    int            fixed_tables; /* which tables hold the fixed Huffman code (internal) */
+    int            block_stop;  /* return at each block boundary (seek index build) */
+    size_t         stored_left; /* bytes left in a stored block */
+    unsigned       match_len;   /* pending match copy after output filled up */
+    unsigned       match_dist;
+    uint32_t       litlen[PAS_ZIP_LITLEN_TABLE_SIZE];
+    uint32_t       dist[PAS_ZIP_DIST_TABLE_SIZE];
+    uint32_t       precode[PAS_ZIP_PRECODE_TABLE_SIZE];
+} pas_zip_inflate_t;
+
+/* Decompress a raw Deflate stream. Returns bytes written. status: PAS_ZIP_OK when the stream
+   ended, PAS_ZIP_E_NOSPACE if out filled up first, PAS_ZIP_E_ZLIB on corrupt or truncated data. */
+size_t pas_zip_inflate(pas_zip_inflate_t *state, const void *in, size_t in_len,
+                       void *out, size_t out_size, pas_zip_status *status);
+
+/* ----- Streaming reader -----
+   Decompresses one Store or Deflate entry chunk by chunk into buffers of any size. Memory use is
+   the fixed size of pas_zip_reader_t (decoder state plus a 64 KB window), whatever the entry size. */
+
+#define PAS_ZIP_WINDOW_SIZE 32768
+
+typedef struct pas_zip_reader {
+    pas_zip_file_t    file;
+    const uint8_t    *payload;    /* compressed data in the archive */
+    uint64_t          produced;   /* uncompressed bytes decoded so far */
+    uint64_t          delivered;  /* uncompressed bytes handed to the caller */
+    uint32_t          crc;        /* CRC-32 of the delivered bytes (zip->verify_crc) */
+    size_t            win_pos;    /* decoded bytes in window */
+    size_t            win_read;   /* bytes of window already delivered */
+    int               done;
+    int               check_crc;  /* zip->verify_crc, off after pas_zip_read_at */
+    pas_zip_status    error;
+    pas_zip_inflate_t inflate;
+    uint8_t           window[2 * PAS_ZIP_WINDOW_SIZE];
+} pas_zip_reader_t;
+
+/* Start reading file. Returns 1 on success, 0 on error (PAS_ZIP_E_COMPRESSED for other methods). */
+int    pas_zip_reader_init(pas_zip_reader_t *reader, const pas_zip_file_t *file, pas_zip_status *status);
+/* Read up to size bytes. Returns bytes read; 0 with PAS_ZIP_OK at end of entry. With
+   zip->verify_crc set, the read that delivers the last byte reports PAS_ZIP_E_CRC on mismatch. */
+size_t pas_zip_reader_read(pas_zip_reader_t *reader, void *buffer, size_t size, pas_zip_status *status);
+void   pas_zip_reader_close(pas_zip_reader_t *reader);
+
+/* ----- Random access inside Deflate entries -----
+   A seek index in the style of zlib's zran: one pass over the entry saves, at block boundaries
+   at least span bytes of output apart, the bit offset in the compressed data and the 32 KB of
+   output before it. pas_zip_read_at then starts inflating at the nearest saved point, so a read
+   at offset costs about span bytes of decoding instead of offset. Each point takes
+   PAS_ZIP_WINDOW_SIZE + 16 bytes of caller storage. */
+
+typedef struct pas_zip_seek_point {
+    uint64_t out_offset;  /* uncompressed offset of the block */
+    uint64_t in_bit;      /* its bit offset in the compressed data */
+} pas_zip_seek_point_t;
+
+typedef struct pas_zip_seek_index {
+    pas_zip_file_t        file;
+    pas_zip_seek_point_t *points;   /* ascending out_offset */
+    uint8_t              *windows;  /* PAS_ZIP_WINDOW_SIZE bytes per point */
+    size_t                count;
+} pas_zip_seek_index_t;
+
+/* Storage needed for an index of file with points every span bytes. */
+size_t pas_zip_seek_index_size(const pas_zip_file_t *file, uint64_t span);
+/* Decode file once and fill idx in storage. work is scratch for the pass. Store entries need no
+   points. Returns 1 on success, 0 on error (PAS_ZIP_E_NOSPACE if storage is too small). */
+int    pas_zip_seek_index_build(pas_zip_seek_index_t *idx, const pas_zip_file_t *file, uint64_t span,
+                                void *storage, size_t storage_size, pas_zip_reader_t *work,
+                                pas_zip_status *status);
+/* Read up to len bytes at uncompressed offset. work is left positioned after them, so
+   pas_zip_reader_read can continue from there (CRCs are not checked on such reads).
+   Returns bytes read (fewer at the end of the entry), 0 on error. */
+size_t pas_zip_read_at(const pas_zip_seek_index_t *idx, pas_zip_reader_t *work, uint64_t offset,
+                       void *buffer, size_t len, pas_zip_status *status);
+
+/* ----- Built-in Deflate encoder -----
+   Hash chains over the in-memory input (no window copy). Levels 1-3 take the longest match
+   greedily, 4-9 use lazy matching with longer chains. Each block of up to PAS_ZIP_BLOCK_SYMS
+   symbols is written as dynamic Huffman, fixed Huffman or stored, whichever is smallest.
+   The state is about 320 KB; keep it off the stack. */
+
+#define PAS_ZIP_HASH_BITS  15
+#define PAS_ZIP_BLOCK_SYMS 16384
+
+typedef struct pas_zip_deflate {
+    uint32_t head[1 << PAS_ZIP_HASH_BITS]; /* latest position + 1 per hash of 3 bytes, 0 = none */
+    uint32_t prev[PAS_ZIP_WINDOW_SIZE];    /* previous position + 1 with the same hash */
+    uint16_t sym_ll[PAS_ZIP_BLOCK_SYMS];   /* literal byte, or 256 + match length */
+    uint16_t sym_dist[PAS_ZIP_BLOCK_SYMS]; /* match distance, 0 for a literal */
+    size_t   nsyms;
+    uint32_t freq_ll[288];
+    uint32_t freq_d[32];
+    uint8_t  len_code[259];                /* match length -> length code (0..28) */
+    uint8_t  dist_code[512];               /* see deflate_dist_code */
+} pas_zip_deflate_t;
+
+/* Compress in as one raw Deflate stream. level 0 (stored blocks) .. 9 (smallest), clamped.
+   Returns bytes written. status: PAS_ZIP_OK, PAS_ZIP_E_NOSPACE if out is too small,
+   PAS_ZIP_E_INVALID if in_len is 4 GiB or more. */
+size_t pas_zip_deflate(pas_zip_deflate_t *state, int level, const void *in, size_t in_len,
+                       void *out, size_t out_size, pas_zip_status *status);
+
+/* CRC-32 as used by ZIP, gzip and zlib's crc32(). Start with crc = 0 and pass the previous
+   result to continue over further pieces. */
+uint32_t pas_zip_crc32(uint32_t crc, const void *data, size_t len);
+/* CRC-32 of A followed by B from crc1 = CRC(A), crc2 = CRC(B) and len2 = length of B, in
+   O(log len2) time without the data, so pieces can be checksummed independently. */
+uint32_t pas_zip_crc32_combine(uint32_t crc1, uint32_t crc2, uint64_t len2);
+
 /* Create ZIP (Store only). Returns bytes written or 0 on error. */
 size_t pas_zip_create(const char **filenames, const void **datas, const size_t *sizes,
                       int file_count, void *buffer, size_t buffer_size, pas_zip_status *status);
 
+/* Create ZIP with Deflate entries at level (0 = Store, 1..9) using the caller's encoder state.
+   Entries that do not shrink are stored. Same return and status as pas_zip_create. */
+size_t pas_zip_create_ex(const char **filenames, const void **datas, const size_t *sizes,
+                         int file_count, int level, pas_zip_deflate_t *state,
+                         void *buffer, size_t buffer_size, pas_zip_status *status);
+
+/* Like pas_zip_create_ex, but byte-identical inputs are stored once: a later duplicate gets only
+   a Central Directory record pointing at the first copy's local header and data. Inputs are
+   hashed with XXH64 into a table in storage (pas_zip_dedup_size(file_count) bytes, else
+   PAS_ZIP_E_NOSPACE) and matches are confirmed with memcmp. Empty inputs are not shared.
+   Shared local headers carry the first copy's name. pas_zip reads such archives, but stricter
+   readers refuse them: Info-ZIP unzip 6.0 reports overlapped components (zip bomb check) and
+   Python's zipfile a name mismatch. Use it for archives consumed by pas_zip or similar readers. */
+size_t pas_zip_dedup_size(int file_count);
+size_t pas_zip_create_dedup(const char **filenames, const void **datas, const size_t *sizes,
+                            int file_count, int level, pas_zip_deflate_t *state,
+                            void *storage, size_t storage_size,
+                            void *buffer, size_t buffer_size, pas_zip_status *status);
+
+/* ----- Streaming writer -----
+   Builds an archive in the caller's buffer one entry and one chunk at a time, so inputs never
+   have to be in memory together. Each entry's local header offset and sizes are recorded in a
+   caller-provided table as it is written; finish emits the Central Directory from that table
+   in one pass. ZIP64 records are added when there are more than 65535 entries or offsets and
+   sizes reach 4 GiB. Deflate entries are compressed in pieces of PAS_ZIP_WRITER_CHUNK bytes,
+   each using the previous 32 KB as history. */
+
+#define PAS_ZIP_WRITER_CHUNK 65536
+
+typedef struct pas_zip_writer_entry {
+    uint64_t local_header_offset;
+    uint64_t compressed_size;
+    uint64_t uncompressed_size;
+    uint32_t crc32;
+    uint16_t method;
+} pas_zip_writer_entry_t;
+
+typedef struct pas_zip_writer {
+    uint8_t                *out;
+    size_t                  out_size;
+    size_t                  pos;          /* bytes written */
+    pas_zip_writer_entry_t *entries;
+    size_t                  max_entries;
+    size_t                  count;        /* entries started */
+    pas_zip_deflate_t      *deflate;      /* NULL: Store only */
+    int                     level;        /* current entry: 0 = Store */
+    int                     open;         /* an entry is being written */
+    int                     finished;     /* pas_zip_writer_finish was called */
+    size_t                  payload;      /* current entry's data offset */
+    uint64_t                bitbuf;       /* pending Deflate bits between pieces */
+    unsigned                bitcount;
+    size_t                  hist_len;     /* history bytes at the start of window */
+    size_t                  fill;         /* new bytes after the history */
+    pas_zip_status          error;        /* sticky */
+    uint8_t                 window[PAS_ZIP_WINDOW_SIZE + PAS_ZIP_WRITER_CHUNK];
+} pas_zip_writer_t;
+
+/* Start an archive in buffer. entries has room for max_entries; deflate may be NULL (Store only).
+   Returns 1 on success, 0 on error. */
+int    pas_zip_writer_begin(pas_zip_writer_t *writer, void *buffer, size_t buffer_size,
+                            pas_zip_writer_entry_t *entries, size_t max_entries,
+                            pas_zip_deflate_t *deflate, pas_zip_status *status);
+/* Finish the current entry, if any, and start a new one. level 0 = Store, 1..9 = Deflate.
+   PAS_ZIP_E_NOSPACE if the entry table or buffer is full, PAS_ZIP_E_INVALID for a name longer
+   than 65535 bytes. Returns 1 on success, 0 on error. */
+int    pas_zip_writer_add_entry(pas_zip_writer_t *writer, const char *name, int level, pas_zip_status *status);
+/* Append data to the current entry. Returns 1 on success, 0 on error. */
+int    pas_zip_writer_add_chunk(pas_zip_writer_t *writer, const void *data, size_t size, pas_zip_status *status);
+/* Finish the current entry, write the Central Directory and end records.
+   Returns the archive size, 0 on error (including any earlier error). After it, every writer
+   call (finish included) fails with PAS_ZIP_E_INVALID until pas_zip_writer_begin. */
+size_t pas_zip_writer_finish(pas_zip_writer_t *writer, pas_zip_status *status);
+
+/* Parallel Deflate (pigz-style) for large chunks of the current entry. data is cut into blocks
+   of block_size bytes (0: PAS_ZIP_PARALLEL_BLOCK) compressed on up to thread_count threads, each
+   primed with the 32 KB before it as dictionary (for the first block, the entry's data written
+   so far) and ended with a sync flush (empty stored block) so the pieces join byte-aligned into
+   one Deflate stream. Each thread also checksums its block; the CRCs are joined with
+   pas_zip_crc32_combine. Store entries take the data as pas_zip_writer_add_chunk does.
+   scratch holds an encoder state and an output slot per thread and must be at least
+   pas_zip_writer_parallel_size(thread_count, block_size) bytes (PAS_ZIP_E_NOSPACE otherwise).
+   Without PAS_ZIP_USE_THREADS the blocks are compressed one after another with the same output.
+   Returns 1 on success, 0 on error. */
+#define PAS_ZIP_PARALLEL_BLOCK (1u << 20)
+size_t pas_zip_writer_parallel_size(int thread_count, size_t block_size);
+int    pas_zip_writer_add_chunk_parallel(pas_zip_writer_t *writer, const void *data, size_t size,
+                                         int thread_count, size_t block_size, void *scratch,
+                                         size_t scratch_size, pas_zip_status *status);
+
 #ifdef __cplusplus
 }
 #endif
@@ -95,6 +432,21 @@ size_t pas_zip_create(const char **filenames, const void **datas, const size_t *
 
 #include <string.h>
 
+/* Vector scans (find_eocd). AVX2 is used when the compiler targets it; SSE2 is baseline on x86-64. */
+#ifndef PAS_ZIP_NO_SIMD
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define PAS_ZIP_SSE2 1
+    #include <emmintrin.h>
+    #ifdef __AVX2__
+    #define PAS_ZIP_AVX2 1
+    #include <immintrin.h>
+    #endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+    #define PAS_ZIP_NEON 1
+    #include <arm_neon.h>
+#endif
+#endif
+
 #ifdef PAS_ZIP_USE_MINIZ
 #include "miniz.h"
 #endif
@@ -102,13 +454,72 @@ size_t pas_zip_create(const char **filenames, const void **datas, const size_t *
 #include <zlib.h>
 #endif
 
+#ifdef PAS_ZIP_USE_MMAP
+#if defined(_WIN32) || defined(_WIN64)
+    #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+#else
+    #include <sys/types.h>
+    #include <sys/stat.h>
+    #include <sys/mman.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+    /* Access hints are advisory; strict ISO modes may hide both spellings. */
+    #if defined(POSIX_MADV_WILLNEED)
+    #define PAS_ZIP_MADVISE(p, n, advice) (void)posix_madvise(p, n, POSIX_MADV_##advice)
+    #elif defined(MADV_WILLNEED)
+    #define PAS_ZIP_MADVISE(p, n, advice) (void)madvise(p, n, MADV_##advice)
+    #else
+    #define PAS_ZIP_MADVISE(p, n, advice) ((void)(p), (void)(n))
+    #endif
+#endif
+#endif
+
+#ifdef PAS_ZIP_USE_THREADS
+#if defined(_WIN32) || defined(_WIN64)
+    #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+    typedef HANDLE pas_zip__thread_t;
+    typedef CRITICAL_SECTION pas_zip__mutex_t;
+    #define PAS_ZIP_MUTEX_INIT(m)    InitializeCriticalSection(m)
+    #define PAS_ZIP_MUTEX_LOCK(m)    EnterCriticalSection(m)
+    #define PAS_ZIP_MUTEX_UNLOCK(m)  LeaveCriticalSection(m)
+    #define PAS_ZIP_MUTEX_DESTROY(m) DeleteCriticalSection(m)
+    typedef CONDITION_VARIABLE pas_zip__cond_t;
+    #define PAS_ZIP_COND_INIT(c)      InitializeConditionVariable(c)
+    #define PAS_ZIP_COND_WAIT(c, m)   SleepConditionVariableCS(c, m, INFINITE)
+    #define PAS_ZIP_COND_BROADCAST(c) WakeAllConditionVariable(c)
+    #define PAS_ZIP_COND_DESTROY(c)   ((void)(c))
+#else
+    #include <pthread.h>
+    typedef pthread_t pas_zip__thread_t;
+    typedef pthread_mutex_t pas_zip__mutex_t;
+    #define PAS_ZIP_MUTEX_INIT(m)    pthread_mutex_init(m, NULL)
+    #define PAS_ZIP_MUTEX_LOCK(m)    pthread_mutex_lock(m)
+    #define PAS_ZIP_MUTEX_UNLOCK(m)  pthread_mutex_unlock(m)
+    #define PAS_ZIP_MUTEX_DESTROY(m) pthread_mutex_destroy(m)
+    typedef pthread_cond_t pas_zip__cond_t;
+    #define PAS_ZIP_COND_INIT(c)      pthread_cond_init(c, NULL)
+    #define PAS_ZIP_COND_WAIT(c, m)   pthread_cond_wait(c, m)
+    #define PAS_ZIP_COND_BROADCAST(c) pthread_cond_broadcast(c)
+    #define PAS_ZIP_COND_DESTROY(c)   pthread_cond_destroy(c)
+#endif
+#endif
+
 #define PAS_ZIP_EOCD_SIG  0x06054b50u
+#define PAS_ZIP_EOCD64_SIG 0x06064b50u
+#define PAS_ZIP_EOCD64_LOC_SIG 0x07064b50u
+#define PAS_ZIP_ZIP64_EXTRA 0x0001u
 #define PAS_ZIP_CDH_SIG   0x02014b50u
 #define PAS_ZIP_LFH_SIG   0x04034b50u
 
 static pas_zip_t pas_zip__handle;
 static pas_zip_file_t pas_zip__current_file;
-static char pas_zip__name_buf[512];
+static char pas_zip__name_buf[PAS_ZIP_MAX_NAME];
 
 static uint32_t read_u32_le(const uint8_t *p) {
     return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
@@ -117,48 +528,321 @@ static uint16_t read_u16_le(const uint8_t *p) {
     return (uint16_t)p[0] | ((uint16_t)p[1] << 8);
 }
 
-static int find_eocd(const uint8_t *data, size_t size, uint32_t *cd_offset, uint16_t *num_entries) {
-    size_t i;
-    size_t search_end;
+static uint64_t read_u64_le(const uint8_t *p) {
+    return (uint64_t)read_u32_le(p) | ((uint64_t)read_u32_le(p + 4) << 32);
+}
+
+/* ZIP64 end of central directory: a 20-byte locator sits right before the classic EOCD at eocd
+   and points at the 56-byte ZIP64 record. Returns 1 and fills the 64-bit values if present. */
+static int read_eocd64(const uint8_t *data, size_t eocd,
+                       uint64_t *cd_offset, uint64_t *num_entries, uint64_t *cd_size) {
+    const uint8_t *loc;
+    uint64_t rec;
+
+    if (eocd < 20) return 0;
+    loc = data + eocd - 20;
+    if (read_u32_le(loc) != PAS_ZIP_EOCD64_LOC_SIG) return 0;
+    rec = read_u64_le(loc + 8);
+    if (rec > eocd - 20 || eocd - 20 - rec < 56) return 0;
+    if (read_u32_le(data + rec) != PAS_ZIP_EOCD64_SIG) return 0;
+    *num_entries = read_u64_le(data + rec + 32);
+    *cd_size = read_u64_le(data + rec + 40);
+    *cd_offset = read_u64_le(data + rec + 48);
+    return 1;
+}
+
+/* Accept an EOCD signature at i only if its comment fits in the file, the Central Directory it
+   describes ends before it, holds at least 46 bytes per entry and starts with a CD header.
+   Signature bytes inside a comment or stored data rarely pass all of these. */
+static int eocd_candidate(const uint8_t *data, size_t size, size_t i,
+                          uint64_t *cd_offset, uint64_t *num_entries) {
+    uint64_t cd_size;
+
+    if (i + 22 + read_u16_le(data + i + 20) > size) return 0;
+    if (!read_eocd64(data, i, cd_offset, num_entries, &cd_size)) {
+        *num_entries = read_u16_le(data + i + 8);
+        cd_size = read_u32_le(data + i + 12);
+        *cd_offset = read_u32_le(data + i + 16);
+        /* Saturated fields without a ZIP64 record: truncated or corrupt archive */
+        if (*num_entries == 0xFFFFu || *cd_offset == 0xFFFFFFFFu) return 0;
+    }
+    if (*cd_offset > i || cd_size > i - *cd_offset) return 0;
+    if (*num_entries > cd_size / 46) return 0;
+    if (*num_entries > 0 && read_u32_le(data + *cd_offset) != PAS_ZIP_CDH_SIG) return 0;
+    return 1;
+}
+
+#if defined(PAS_ZIP_SSE2) || defined(PAS_ZIP_NEON)
+static int top_bit(uint64_t m) { /* m != 0 */
+#if defined(__GNUC__)
+    return 63 - __builtin_clzll(m);
+#else
+    int b = 0;
+    while (m >>= 1) b++;
+    return b;
+#endif
+}
+#endif
+
+/* Scan backwards from the last possible position over at most 64 KB of comment. The vector
+   loops compare 32 or 16 consecutive positions against the four signature bytes at once and
+   visit the matches from the highest; the remaining head is done byte by byte. */
+static int find_eocd(const uint8_t *data, size_t size, uint64_t *cd_offset, uint64_t *num_entries) {
+    size_t lo, i;
 
     if (size < 22) return 0;
-    search_end = (size > 65557) ? size - 65557 : 0;
-
-    for (i = size - 22; ; i--) {
-        if (i + 22 > size) continue;
-        if (read_u32_le(data + i) == PAS_ZIP_EOCD_SIG) {
-            *num_entries = read_u16_le(data + i + 8);
-            *cd_offset = read_u32_le(data + i + 16);
-            if (*cd_offset >= size) return 0;
-            return 1;
+    lo = (size > 65557) ? size - 65557 : 0;
+    i = size - 21; /* one past the last candidate; loads reach i + 18 at most */
+
+#if defined(PAS_ZIP_AVX2)
+    {
+        const __m256i s0 = _mm256_set1_epi8(0x50), s1 = _mm256_set1_epi8(0x4b);
+        const __m256i s2 = _mm256_set1_epi8(0x05), s3 = _mm256_set1_epi8(0x06);
+        while (i - lo >= 32) {
+            uint32_t m;
+            __m256i a, b;
+            i -= 32;
+            a = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(data + i)), s0),
+                                 _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(data + i + 1)), s1));
+            b = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(data + i + 2)), s2),
+                                 _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(data + i + 3)), s3));
+            m = (uint32_t)_mm256_movemask_epi8(_mm256_and_si256(a, b));
+            while (m) {
+                int bit = top_bit(m);
+                if (eocd_candidate(data, size, i + (size_t)bit, cd_offset, num_entries)) return 1;
+                m &= ~(1u << bit);
+            }
+        }
+    }
+#endif
+#if defined(PAS_ZIP_SSE2)
+    {
+        const __m128i s0 = _mm_set1_epi8(0x50), s1 = _mm_set1_epi8(0x4b);
+        const __m128i s2 = _mm_set1_epi8(0x05), s3 = _mm_set1_epi8(0x06);
+        while (i - lo >= 16) {
+            uint32_t m;
+            __m128i a, b;
+            i -= 16;
+            a = _mm_and_si128(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(data + i)), s0),
+                              _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(data + i + 1)), s1));
+            b = _mm_and_si128(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(data + i + 2)), s2),
+                              _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(data + i + 3)), s3));
+            m = (uint32_t)_mm_movemask_epi8(_mm_and_si128(a, b));
+            while (m) {
+                int bit = top_bit(m);
+                if (eocd_candidate(data, size, i + (size_t)bit, cd_offset, num_entries)) return 1;
+                m &= ~(1u << bit);
+            }
+        }
+    }
+#elif defined(PAS_ZIP_NEON)
+    {
+        const uint8x16_t s0 = vdupq_n_u8(0x50), s1 = vdupq_n_u8(0x4b);
+        const uint8x16_t s2 = vdupq_n_u8(0x05), s3 = vdupq_n_u8(0x06);
+        while (i - lo >= 16) {
+            uint64_t m;
+            uint8x16_t eq;
+            i -= 16;
+            eq = vandq_u8(vandq_u8(vceqq_u8(vld1q_u8(data + i), s0), vceqq_u8(vld1q_u8(data + i + 1), s1)),
+                          vandq_u8(vceqq_u8(vld1q_u8(data + i + 2), s2), vceqq_u8(vld1q_u8(data + i + 3), s3)));
+            /* Narrow to one nibble per position */
+            m = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+            while (m) {
+                int bit = top_bit(m) >> 2;
+                if (eocd_candidate(data, size, i + (size_t)bit, cd_offset, num_entries)) return 1;
+                m &= ~((uint64_t)0xF << (bit * 4));
+            }
         }
-        if (i <= search_end || i == 0) break;
+    }
+#endif
+
+    while (i > lo) {
+        i--;
+        if (data[i] == 0x50 && read_u32_le(data + i) == PAS_ZIP_EOCD_SIG &&
+            eocd_candidate(data, size, i, cd_offset, num_entries))
+            return 1;
     }
     return 0;
 }
 
-pas_zip_t *pas_zip_open(const void *data, size_t size, pas_zip_status *status) {
-    uint32_t cd_offset;
-    uint16_t num_entries;
+int pas_zip_open_ex(pas_zip_t *out, const void *data, size_t size, pas_zip_status *status) {
+    uint64_t cd_offset;
+    uint64_t num_entries;
 
     if (status) *status = PAS_ZIP_E_INVALID;
-    if (!data || size < 22) return NULL;
+    if (!out || !data || size < 22) return 0;
 
     if (!find_eocd((const uint8_t *)data, size, &cd_offset, &num_entries)) {
         if (status) *status = PAS_ZIP_E_INVALID;
-        return NULL;
+        return 0;
     }
 
-    pas_zip__handle.data = (const uint8_t *)data;
-    pas_zip__handle.size = size;
-    pas_zip__handle.cd_offset = cd_offset;
-    pas_zip__handle.num_entries = num_entries;
+    out->data = (const uint8_t *)data;
+    out->size = size;
+    out->cd_offset = cd_offset;
+    out->num_entries = num_entries;
+    out->index = NULL;
+    out->index_slots = 0;
+    out->mapped = 0;
+    out->verify_crc = 0;
 
     if (status) *status = PAS_ZIP_OK;
+    return 1;
+}
+
+/* ----- Memory-mapped files ----- */
+
+#ifdef PAS_ZIP_USE_MMAP
+#if defined(_WIN32) || defined(_WIN64)
+
+static void map_will_need(const pas_zip_t *zip, uint64_t offset, uint64_t len) {
+    (void)zip; (void)offset; (void)len; /* the Win32 cache manager reads ahead on its own */
+}
+
+int pas_zip_open_file(pas_zip_t *out, const char *path, pas_zip_status *status) {
+    HANDLE file, mapping;
+    LARGE_INTEGER size;
+    const void *view;
+
+    if (status) *status = PAS_ZIP_E_INVALID;
+    if (!out || !path) return 0;
+
+    file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                       FILE_FLAG_RANDOM_ACCESS, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        if (status) *status = PAS_ZIP_E_IO;
+        return 0;
+    }
+    if (!GetFileSizeEx(file, &size) || size.QuadPart < 22 ||
+        (uint64_t)size.QuadPart > (size_t)-1) {
+        CloseHandle(file);
+        if (status) *status = PAS_ZIP_E_IO;
+        return 0;
+    }
+    mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if (!mapping) {
+        if (status) *status = PAS_ZIP_E_IO;
+        return 0;
+    }
+    view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping); /* the view keeps the mapping alive */
+    if (!view) {
+        if (status) *status = PAS_ZIP_E_IO;
+        return 0;
+    }
+    if (!pas_zip_open_ex(out, view, (size_t)size.QuadPart, status)) {
+        UnmapViewOfFile(view);
+        return 0;
+    }
+    out->mapped = 1;
+    return 1;
+}
+
+void pas_zip_close_file(pas_zip_t *zip) {
+    if (!zip || !zip->mapped) return;
+    UnmapViewOfFile((LPCVOID)zip->data);
+    zip->data = NULL;
+    zip->size = 0;
+    zip->mapped = 0;
+}
+
+#else
+
+/* Start asynchronous read-ahead of [offset, offset + len), widened to page boundaries. */
+static void map_will_need(const pas_zip_t *zip, uint64_t offset, uint64_t len) {
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t start = (size_t)offset & ~(page - 1);
+    size_t end = (size_t)(offset + len);
+    if (end > zip->size) end = zip->size;
+    if (start >= end) return;
+    PAS_ZIP_MADVISE((void *)(zip->data + start), end - start, WILLNEED);
+}
+
+int pas_zip_open_file(pas_zip_t *out, const char *path, pas_zip_status *status) {
+    struct stat st;
+    void *view;
+    int fd;
+
+    if (status) *status = PAS_ZIP_E_INVALID;
+    if (!out || !path) return 0;
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        if (status) *status = PAS_ZIP_E_IO;
+        return 0;
+    }
+    if (fstat(fd, &st) != 0 || st.st_size < 22 || (uint64_t)st.st_size > (size_t)-1) {
+        (void)close(fd);
+        if (status) *status = PAS_ZIP_E_IO;
+        return 0;
+    }
+    view = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    (void)close(fd); /* the mapping keeps the file open */
+    if (view == MAP_FAILED) {
+        if (status) *status = PAS_ZIP_E_IO;
+        return 0;
+    }
+    /* Entries are visited in any order: no blind read-ahead, map_will_need covers each entry. */
+    PAS_ZIP_MADVISE(view, (size_t)st.st_size, RANDOM);
+    if (!pas_zip_open_ex(out, view, (size_t)st.st_size, status)) {
+        (void)munmap(view, (size_t)st.st_size);
+        return 0;
+    }
+    out->mapped = 1;
+    map_will_need(out, out->cd_offset, out->size - out->cd_offset);
+    return 1;
+}
+
+void pas_zip_close_file(pas_zip_t *zip) {
+    if (!zip || !zip->mapped) return;
+    (void)munmap((void *)zip->data, zip->size);
+    zip->data = NULL;
+    zip->size = 0;
+    zip->mapped = 0;
+}
+
+#endif
+#endif /* PAS_ZIP_USE_MMAP */
+
+pas_zip_t *pas_zip_open(const void *data, size_t size, pas_zip_status *status) {
+    if (!pas_zip_open_ex(&pas_zip__handle, data, size, status)) return NULL;
     return &pas_zip__handle;
 }
 
-static int parse_cd_entry(const uint8_t *p, const uint8_t *end, pas_zip_file_t *out) {
+/* ZIP64 extended information extra field: 8-byte values for exactly those of uncompressed size,
+   compressed size and local header offset (in that order) that are 0xFFFFFFFF in the header. */
+static int apply_zip64_extra(const uint8_t *extra, size_t extra_len, pas_zip_file_t *out) {
+    const uint8_t *end = extra + extra_len;
+    uint64_t *fields[3];
+    size_t i;
+
+    fields[0] = &out->uncompressed_size;
+    fields[1] = &out->compressed_size;
+    fields[2] = &out->local_header_offset;
+
+    while (extra + 4 <= end) {
+        uint16_t id = read_u16_le(extra);
+        uint16_t len = read_u16_le(extra + 2);
+        const uint8_t *q = extra + 4;
+        if (q + len > end) return 0;
+        if (id == PAS_ZIP_ZIP64_EXTRA) {
+            for (i = 0; i < 3; i++) {
+                if (*fields[i] != 0xFFFFFFFFu) continue;
+                if (q + 8 > extra + 4 + len) return 0;
+                *fields[i] = read_u64_le(q);
+                q += 8;
+            }
+            return 1;
+        }
+        extra = q + len;
+    }
+    /* A saturated field must come with the ZIP64 extra field */
+    for (i = 0; i < 3; i++) if (*fields[i] == 0xFFFFFFFFu) return 0;
+    return 1;
+}
+
+static int parse_cd_entry(const pas_zip_t *zip, const uint8_t *p, const uint8_t *end, pas_zip_file_t *out) {
     uint16_t fn_len, extra_len, comment_len;
     size_t need;
 
@@ -172,32 +856,45 @@ static int parse_cd_entry(const uint8_t *p, const uint8_t *end, pas_zip_file_t *
     if (p + need > end) return 0;
 
     out->compression_method = read_u16_le(p + 10);
-    out->compressed_size = (size_t)read_u32_le(p + 20);
-    out->uncompressed_size = (size_t)read_u32_le(p + 24);
+    out->crc32 = read_u32_le(p + 16);
+    out->compressed_size = read_u32_le(p + 20);
+    out->uncompressed_size = read_u32_le(p + 24);
     out->local_header_offset = read_u32_le(p + 42);
+    if ((out->compressed_size == 0xFFFFFFFFu || out->uncompressed_size == 0xFFFFFFFFu ||
+         out->local_header_offset == 0xFFFFFFFFu) &&
+        !apply_zip64_extra(p + 46 + fn_len, extra_len, out))
+        return 0;
 
-    if (fn_len >= sizeof(pas_zip__name_buf)) fn_len = (uint16_t)(sizeof(pas_zip__name_buf) - 1);
-    memcpy(pas_zip__name_buf, p + 46, fn_len);
-    pas_zip__name_buf[fn_len] = '\0';
-    out->name = pas_zip__name_buf;
+    out->name = NULL;
+    out->zip = zip;
+    out->name_offset = (size_t)(p + 46 - zip->data);
+    out->name_len = fn_len;
 
     return 1;
 }
 
-static int cd_iterate(pas_zip_t *zip, const char *find_name,
+/* Names are compared as spans straight from the Central Directory; the callback gets a
+   NUL-terminated copy in a stack buffer, so concurrent iteration is safe. */
+static int cd_iterate(const pas_zip_t *zip, const char *find_name,
                       pas_zip_file_t *out, void (*cb)(const char *, size_t, void *), void *user) {
     const uint8_t *p = zip->data + zip->cd_offset;
     const uint8_t *end = zip->data + zip->size;
-    uint16_t n = zip->num_entries;
+    uint64_t n = zip->num_entries;
+    size_t find_len = find_name ? strlen(find_name) : 0;
 
     while (n-- && p < end) {
         pas_zip_file_t entry;
-        if (!parse_cd_entry(p, end, &entry)) return 0;
+        if (!parse_cd_entry(zip, p, end, &entry)) return 0;
 
         if (cb) {
-            cb(entry.name, entry.uncompressed_size, user);
+            char name[PAS_ZIP_MAX_NAME];
+            size_t len = entry.name_len;
+            if (len >= sizeof(name)) len = sizeof(name) - 1;
+            memcpy(name, p + 46, len);
+            name[len] = '\0';
+            cb(name, (size_t)entry.uncompressed_size, user);
         }
-        if (find_name && strcmp(entry.name, find_name) == 0) {
+        if (find_name && entry.name_len == find_len && memcmp(p + 46, find_name, find_len) == 0) {
             *out = entry;
             return 1;
         }
@@ -207,176 +904,3398 @@ static int cd_iterate(pas_zip_t *zip, const char *find_name,
     return find_name ? 0 : 1;
 }
 
+/* Legacy API: copy the entry into the static slot and give it a NUL-terminated name. */
+static pas_zip_file_t *set_current_file(const pas_zip_file_t *ent) {
+    size_t len = ent->name_len;
+    if (len >= sizeof(pas_zip__name_buf)) len = sizeof(pas_zip__name_buf) - 1;
+    memcpy(pas_zip__name_buf, ent->zip->data + ent->name_offset, len);
+    pas_zip__name_buf[len] = '\0';
+    pas_zip__current_file = *ent;
+    pas_zip__current_file.name = pas_zip__name_buf;
+    return &pas_zip__current_file;
+}
+
+int pas_zip_find_ex(const pas_zip_t *zip, const char *name, pas_zip_file_t *out) {
+    if (!zip || !name || !out) return 0;
+    if (zip->index) return pas_zip_find_indexed_ex(zip, name, out);
+    return cd_iterate(zip, name, out, NULL, NULL);
+}
+
 pas_zip_file_t *pas_zip_find(pas_zip_t *zip, const char *name) {
     pas_zip_file_t ent;
 
-    if (!zip || !name) return NULL;
-    if (!cd_iterate(zip, name, &ent, NULL, NULL)) return NULL;
-    pas_zip__current_file = ent;
-    return &pas_zip__current_file;
+    if (!pas_zip_find_ex(zip, name, &ent)) return NULL;
+    return set_current_file(&ent);
 }
 
-const char *pas_zip_name(pas_zip_file_t *file) { return file ? file->name : NULL; }
-size_t pas_zip_size(pas_zip_file_t *file) { return file ? file->uncompressed_size : 0; }
-int pas_zip_is_compressed(pas_zip_file_t *file) { return file && file->compression_method != PAS_ZIP_METHOD_STORE; }
+/* ----- Name hash index -----
+   Open addressing, linear probing. Each slot is two uint32: FNV-1a hash of the name and
+   (CD entry offset relative to cd_offset) + 1; 0 marks an empty slot. */
 
-static size_t skip_local_header(const uint8_t *data, size_t size, uint32_t offset) {
-    const uint8_t *p;
-    uint16_t fn_len, extra_len;
+static uint32_t hash_name(const uint8_t *s, size_t len) {
+    uint32_t h = 2166136261u;
+    while (len--) {
+        h ^= *s++;
+        h *= 16777619u;
+    }
+    return h;
+}
 
-    if (offset + 30 > size) return 0;
-    p = data + offset;
-    if (read_u32_le(p) != PAS_ZIP_LFH_SIG) return 0;
-    fn_len = read_u16_le(p + 26);
-    extra_len = read_u16_le(p + 28);
-    return 30 + fn_len + extra_len;
+static size_t index_slots_for(uint64_t num_entries) {
+    size_t slots = 16;
+    while ((uint64_t)slots < num_entries * 2) slots <<= 1;
+    return slots;
 }
 
-size_t pas_zip_extract(pas_zip_file_t *file, void *buffer, size_t buffer_size, pas_zip_status *status) {
-    const uint8_t *data;
-    size_t data_size;
-    size_t payload_offset;
+size_t pas_zip_index_size(pas_zip_t *zip) {
+    if (!zip) return 0;
+    return index_slots_for(zip->num_entries) * 2 * sizeof(uint32_t);
+}
+
+int pas_zip_index_build(pas_zip_t *zip, void *storage, size_t storage_size, pas_zip_status *status) {
+    const uint8_t *cd;
+    const uint8_t *p;
+    const uint8_t *end;
+    uint32_t *slots = (uint32_t *)storage;
+    size_t n, mask;
+    uint64_t left;
 
     if (status) *status = PAS_ZIP_E_INVALID;
-    if (!file || !buffer) return 0;
+    if (!zip || !storage) return -1;
+    zip->index = NULL;
+    zip->index_slots = 0;
 
-    data = pas_zip__handle.data;
-    data_size = pas_zip__handle.size;
+    n = index_slots_for(zip->num_entries);
+    if (storage_size < n * 2 * sizeof(uint32_t)) {
+        if (status) *status = PAS_ZIP_E_NOSPACE;
+        return -1;
+    }
+    memset(slots, 0, n * 2 * sizeof(uint32_t));
+    mask = n - 1;
 
-    {
-        size_t hdr_len = skip_local_header(data, data_size, file->local_header_offset);
-        if (hdr_len == 0) return 0;
-        payload_offset = file->local_header_offset + hdr_len;
+    cd = zip->data + zip->cd_offset;
+    end = zip->data + zip->size;
+    p = cd;
+    left = zip->num_entries;
+    while (left--) {
+        uint16_t fn_len;
+        uint32_t h;
+        size_t i;
+
+        if (p + 46 > end || read_u32_le(p) != PAS_ZIP_CDH_SIG) return -1;
+        fn_len = read_u16_le(p + 28);
+        if (p + 46 + fn_len > end) return -1;
+        h = hash_name(p + 46, fn_len);
+
+        /* Keep the first entry for duplicate names, matching the linear scan. */
+        for (i = h & mask; slots[i * 2 + 1] != 0; i = (i + 1) & mask) {
+            const uint8_t *q = cd + slots[i * 2 + 1] - 1;
+            if (slots[i * 2] == h && read_u16_le(q + 28) == fn_len && memcmp(q + 46, p + 46, fn_len) == 0)
+                break;
+        }
+        if (slots[i * 2 + 1] == 0) {
+            if ((size_t)(p - cd) >= 0xFFFFFFFFu) return -1; /* slot offsets are 32-bit */
+            slots[i * 2] = h;
+            slots[i * 2 + 1] = (uint32_t)(p - cd) + 1;
+        }
+
+        p += 46 + fn_len + read_u16_le(p + 30) + read_u16_le(p + 32);
+        if (p > end) return -1;
     }
-    if (payload_offset + file->compressed_size > data_size) return 0;
 
-    if (buffer_size < file->uncompressed_size) {
+    zip->index = slots;
+    zip->index_slots = n;
+    if (status) *status = PAS_ZIP_OK;
+    return 0;
+}
+
+int pas_zip_find_indexed_ex(const pas_zip_t *zip, const char *name, pas_zip_file_t *out) {
+    const uint8_t *cd;
+    const uint8_t *end;
+    size_t len, i, mask;
+    uint32_t h;
+
+    if (!zip || !name || !out || !zip->index) return 0;
+    cd = zip->data + zip->cd_offset;
+    end = zip->data + zip->size;
+    len = strlen(name);
+    h = hash_name((const uint8_t *)name, len);
+    mask = zip->index_slots - 1;
+
+    for (i = h & mask; zip->index[i * 2 + 1] != 0; i = (i + 1) & mask) {
+        const uint8_t *q;
+        if (zip->index[i * 2] != h) continue;
+        q = cd + zip->index[i * 2 + 1] - 1;
+        if (read_u16_le(q + 28) != len || memcmp(q + 46, name, len) != 0) continue;
+        return parse_cd_entry(zip, q, end, out);
+    }
+    return 0;
+}
+
+pas_zip_file_t *pas_zip_find_indexed(pas_zip_t *zip, const char *name) {
+    pas_zip_file_t ent;
+
+    if (!pas_zip_find_indexed_ex(zip, name, &ent)) return NULL;
+    return set_current_file(&ent);
+}
+
+/* ----- Sorted Central Directory snapshot -----
+   Bytewise order (memcmp, shorter name first on a tie) keeps every prefix a contiguous run.
+   Heapsort needs no scratch memory; archives written in sorted order skip it. */
+
+static const uint8_t *sorted_name(const pas_zip_sorted_t *s, size_t i) {
+    return s->zip->data + s->entries[i].name_offset;
+}
+
+static int sorted_cmp(const pas_zip_t *zip, const pas_zip_sorted_entry_t *a, const pas_zip_sorted_entry_t *b) {
+    size_t n = a->name_len < b->name_len ? a->name_len : b->name_len;
+    int c = memcmp(zip->data + a->name_offset, zip->data + b->name_offset, n);
+    if (c) return c;
+    if (a->name_len != b->name_len) return a->name_len < b->name_len ? -1 : 1;
+    return a->cd_offset < b->cd_offset ? -1 : a->cd_offset > b->cd_offset;
+}
+
+static void sorted_sift(const pas_zip_t *zip, pas_zip_sorted_entry_t *e, size_t root, size_t n) {
+    pas_zip_sorted_entry_t tmp = e[root];
+    size_t child;
+    while ((child = 2 * root + 1) < n) {
+        if (child + 1 < n && sorted_cmp(zip, &e[child], &e[child + 1]) < 0) child++;
+        if (sorted_cmp(zip, &tmp, &e[child]) >= 0) break;
+        e[root] = e[child];
+        root = child;
+    }
+    e[root] = tmp;
+}
+
+int pas_zip_sorted_build(const pas_zip_t *zip, pas_zip_sorted_t *out, pas_zip_sorted_entry_t *entries,
+                         size_t max_entries, pas_zip_status *status) {
+    const uint8_t *p, *end;
+    size_t n, i;
+    int in_order = 1;
+
+    if (status) *status = PAS_ZIP_E_INVALID;
+    if (!zip || !out || (!entries && zip->num_entries)) return 0;
+    out->zip = zip;
+    out->entries = entries;
+    out->count = 0;
+    if (zip->num_entries > (uint64_t)max_entries) {
         if (status) *status = PAS_ZIP_E_NOSPACE;
         return 0;
     }
 
-    if (file->compression_method == PAS_ZIP_METHOD_STORE) {
-        memcpy(buffer, data + payload_offset, file->compressed_size);
-        if (status) *status = PAS_ZIP_OK;
-        return file->uncompressed_size;
+    n = (size_t)zip->num_entries;
+    p = zip->data + zip->cd_offset;
+    end = zip->data + zip->size;
+    for (i = 0; i < n; i++) {
+        uint16_t fn_len;
+        if (p + 46 > end || read_u32_le(p) != PAS_ZIP_CDH_SIG) return 0;
+        fn_len = read_u16_le(p + 28);
+        if (p + 46 + fn_len > end) return 0;
+        entries[i].cd_offset = (uint64_t)(p - zip->data);
+        entries[i].name_offset = (size_t)(p + 46 - zip->data);
+        entries[i].name_len = fn_len;
+        if (i > 0 && in_order && sorted_cmp(zip, &entries[i - 1], &entries[i]) > 0) in_order = 0;
+        p += 46 + fn_len + read_u16_le(p + 30) + read_u16_le(p + 32);
     }
 
-    if (file->compression_method == PAS_ZIP_METHOD_DEFLATE) {
-#if defined(PAS_ZIP_USE_MINIZ) || defined(PAS_ZIP_USE_ZLIB)
-        unsigned long dest_len = (unsigned long)file->uncompressed_size;
-        int r;
-#if defined(PAS_ZIP_USE_MINIZ)
-        r = mz_uncompress((unsigned char *)buffer, &dest_len,
-                          data + payload_offset, (mz_ulong)file->compressed_size);
-#else
-        r = uncompress((Bytef *)buffer, &dest_len,
-                       data + payload_offset, (uLong)file->compressed_size);
-#endif
-        if (r != 0) {
-            if (status) *status = PAS_ZIP_E_ZLIB;
-            return 0;
+    if (!in_order) {
+        for (i = n / 2; i-- > 0;) sorted_sift(zip, entries, i, n);
+        for (i = n; i-- > 1;) {
+            pas_zip_sorted_entry_t tmp = entries[0];
+            entries[0] = entries[i];
+            entries[i] = tmp;
+            sorted_sift(zip, entries, 0, i);
         }
-        if (status) *status = PAS_ZIP_OK;
-        return (size_t)dest_len;
-#else
-        if (status) *status = PAS_ZIP_E_COMPRESSED;
-        return 0;
-#endif
     }
+    out->count = n;
+    if (status) *status = PAS_ZIP_OK;
+    return 1;
+}
 
-    if (status) *status = PAS_ZIP_E_INVALID;
-    return 0;
+/* Order of entry i against a prefix: 0 if the name starts with it. */
+static int sorted_cmp_prefix(const pas_zip_sorted_t *s, size_t i, const char *prefix, size_t len) {
+    size_t name_len = s->entries[i].name_len;
+    int c = memcmp(sorted_name(s, i), prefix, name_len < len ? name_len : len);
+    if (c) return c;
+    return name_len < len ? -1 : 0;
 }
 
-int pas_zip_list(pas_zip_t *zip, void (*callback)(const char *name, size_t size, void *user), void *user) {
-    if (!zip || !callback) return -1;
-    return cd_iterate(zip, NULL, NULL, callback, user) ? 0 : -1;
+/* First position in [lo, hi) whose name orders after the prefix (upper = 1) or not before it. */
+static size_t sorted_bound(const pas_zip_sorted_t *s, size_t lo, size_t hi, const char *prefix,
+                           size_t len, int upper) {
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        int c = sorted_cmp_prefix(s, mid, prefix, len);
+        if (c < 0 || (upper && c == 0)) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
 }
 
-/* Create ZIP (Store only) */
-size_t pas_zip_create(const char **filenames, const void **datas, const size_t *sizes,
-                      int file_count, void *buffer, size_t buffer_size, pas_zip_status *status) {
-    uint8_t *out = (uint8_t *)buffer;
-    size_t written = 0;
-    uint32_t cd_offset;
-    uint32_t cd_size = 0;
-    uint16_t n;
-    int i;
+size_t pas_zip_sorted_prefix(const pas_zip_sorted_t *s, const char *prefix, size_t *first) {
+    size_t len, lo, hi;
 
-    if (status) *status = PAS_ZIP_E_INVALID;
-    if (!filenames || !datas || !sizes || !buffer || file_count <= 0) return 0;
+    if (first) *first = 0;
+    if (!s || !prefix) return 0;
+    len = strlen(prefix);
+    lo = sorted_bound(s, 0, s->count, prefix, len, 0);
+    hi = sorted_bound(s, lo, s->count, prefix, len, 1);
+    if (first) *first = lo;
+    return hi - lo;
+}
 
-    for (i = 0; i < file_count; i++) {
-        uint16_t fn_len = (uint16_t)strlen(filenames[i]);
-        uint32_t sz = (uint32_t)sizes[i];
-        size_t need = 30 + fn_len + sz;
-        if (fn_len != strlen(filenames[i])) return 0; /* overflow */
-        if (written + need > buffer_size) {
-            if (status) *status = PAS_ZIP_E_NOSPACE;
-            return 0;
+int pas_zip_sorted_entry(const pas_zip_sorted_t *s, size_t i, pas_zip_file_t *out) {
+    if (!s || !out || i >= s->count) return 0;
+    return parse_cd_entry(s->zip, s->zip->data + s->entries[i].cd_offset, s->zip->data + s->zip->size, out);
+}
+
+int pas_zip_sorted_find(const pas_zip_sorted_t *s, const char *name, pas_zip_file_t *out) {
+    size_t len, i;
+
+    if (!s || !name || !out) return 0;
+    len = strlen(name);
+    i = sorted_bound(s, 0, s->count, name, len, 0);
+    if (i == s->count || s->entries[i].name_len != len || sorted_cmp_prefix(s, i, name, len) != 0) return 0;
+    return pas_zip_sorted_entry(s, i, out);
+}
+
+int pas_zip_dir_begin(const pas_zip_sorted_t *s, const char *dir, pas_zip_dir_iter_t *it) {
+    if (!it) return 0;
+    it->pos = it->end = it->dir_len = 0;
+    if (!s || !dir) return 0;
+    it->dir_len = strlen(dir);
+    it->end = pas_zip_sorted_prefix(s, dir, &it->pos);
+    it->end += it->pos;
+    return it->pos < it->end;
+}
+
+int pas_zip_dir_next(const pas_zip_sorted_t *s, pas_zip_dir_iter_t *it,
+                     size_t *index, const char **name, size_t *name_len) {
+    while (it && s && it->pos < it->end) {
+        const uint8_t *full = sorted_name(s, it->pos);
+        size_t len = s->entries[it->pos].name_len;
+        const uint8_t *slash;
+        size_t child_len, step, lo, hi;
+
+        if (len == it->dir_len) { /* the directory's own entry */
+            it->pos++;
+            continue;
+        }
+        slash = (const uint8_t *)memchr(full + it->dir_len, '/', len - it->dir_len);
+        child_len = slash ? (size_t)(slash - full) + 1 : len;
+        if (index) *index = it->pos;
+        if (name) *name = (const char *)full;
+        if (name_len) *name_len = child_len;
+        if (!slash) {
+            it->pos++;
+            return 1;
         }
-        out[written++] = 0x50; out[written++] = 0x4b; out[written++] = 0x03; out[written++] = 0x04;
-        out[written++] = 20; out[written++] = 0;  out[written++] = 0; out[written++] = 0;
-        out[written++] = 0; out[written++] = 0;  /* store */
-        for (n = 0; n < 8; n++) out[written++] = 0;  /* mod time, mod date, crc */
-        out[written++] = (uint8_t)(sz); out[written++] = (uint8_t)(sz>>8);
-        out[written++] = (uint8_t)(sz>>16); out[written++] = (uint8_t)(sz>>24);
-        out[written++] = (uint8_t)(sz); out[written++] = (uint8_t)(sz>>8);
-        out[written++] = (uint8_t)(sz>>16); out[written++] = (uint8_t)(sz>>24);
-        out[written++] = (uint8_t)(fn_len); out[written++] = (uint8_t)(fn_len>>8);
-        out[written++] = 0; out[written++] = 0;  /* extra len */
-        memcpy(out + written, filenames[i], fn_len); written += fn_len;
-        memcpy(out + written, datas[i], sz); written += sz;
-    }
 
-    cd_offset = (uint32_t)written;
-    for (i = 0; i < file_count; i++) {
-        uint16_t fn_len = (uint16_t)strlen(filenames[i]);
-        uint32_t sz = (uint32_t)sizes[i];
-        uint32_t local_off = 0;
-        size_t j;
-        for (j = 0; j < (size_t)i; j++)
-            local_off += 30 + (uint32_t)strlen(filenames[j]) + (uint32_t)sizes[j];
-        if (written + 46 + fn_len > buffer_size) {
-            if (status) *status = PAS_ZIP_E_NOSPACE;
-            return 0;
+        /* Skip the subdirectory's run: gallop from its first entry (lo), then binary search */
+        lo = it->pos;
+        step = 1;
+        while (lo + step < it->end && sorted_cmp_prefix(s, lo + step, (const char *)full, child_len) == 0) {
+            lo += step;
+            step *= 2;
         }
-        cd_size += 46 + fn_len;
-        out[written++] = 0x50; out[written++] = 0x4b; out[written++] = 0x01; out[written++] = 0x02;
-        out[written++] = 20; out[written++] = 0; out[written++] = 20; out[written++] = 0;
-        out[written++] = 0; out[written++] = 0; out[written++] = 0; out[written++] = 0;
-        for (n = 0; n < 8; n++) out[written++] = 0;
-        out[written++] = (uint8_t)(sz); out[written++] = (uint8_t)(sz>>8);
-        out[written++] = (uint8_t)(sz>>16); out[written++] = (uint8_t)(sz>>24);
-        out[written++] = (uint8_t)(sz); out[written++] = (uint8_t)(sz>>8);
-        out[written++] = (uint8_t)(sz>>16); out[written++] = (uint8_t)(sz>>24);
-        out[written++] = (uint8_t)(fn_len); out[written++] = (uint8_t)(fn_len>>8);
-        out[written++] = 0; out[written++] = 0; out[written++] = 0; out[written++] = 0;
-        out[written++] = 0; out[written++] = 0; out[written++] = 0; out[written++] = 0;
-        out[written++] = 0; out[written++] = 0; out[written++] = 0; out[written++] = 0;  /* extra, comment, disk, internal, external */
-        out[written++] = (uint8_t)(local_off); out[written++] = (uint8_t)(local_off>>8);
-        out[written++] = (uint8_t)(local_off>>16); out[written++] = (uint8_t)(local_off>>24);
-        memcpy(out + written, filenames[i], fn_len); written += fn_len;
-    }
-
-    if (written + 22 > buffer_size) {
-        if (status) *status = PAS_ZIP_E_NOSPACE;
-        return 0;
+        hi = lo + step < it->end ? lo + step : it->end;
+        it->pos = sorted_bound(s, lo + 1, hi, (const char *)full, child_len, 1);
+        return 1;
     }
-    out[written++] = 0x50; out[written++] = 0x4b; out[written++] = 0x05; out[written++] = 0x06;
-    for (n = 0; n < 4; n++) out[written++] = 0;
-    out[written++] = (uint8_t)file_count; out[written++] = (uint8_t)(file_count>>8);
-    out[written++] = (uint8_t)file_count; out[written++] = (uint8_t)(file_count>>8);
-    out[written++] = (uint8_t)(cd_size); out[written++] = (uint8_t)(cd_size>>8);
-    out[written++] = (uint8_t)(cd_size>>16); out[written++] = (uint8_t)(cd_size>>24);
-    out[written++] = (uint8_t)(cd_offset); out[written++] = (uint8_t)(cd_offset>>8);
-    out[written++] = (uint8_t)(cd_offset>>16); out[written++] = (uint8_t)(cd_offset>>24);
-    out[written++] = 0; out[written++] = 0;
+    return 0;
+}
+
+const char *pas_zip_name(pas_zip_file_t *file) { return file ? file->name : NULL; }
+const char *pas_zip_name_span(const pas_zip_file_t *file, size_t *len) {
+    if (!file || !file->zip) {
+        if (len) *len = 0;
+        return NULL;
+    }
+    if (len) *len = file->name_len;
+    return (const char *)file->zip->data + file->name_offset;
+}
+size_t pas_zip_size(pas_zip_file_t *file) { return file ? (size_t)file->uncompressed_size : 0; }
+int pas_zip_is_compressed(pas_zip_file_t *file) { return file && file->compression_method != PAS_ZIP_METHOD_STORE; }
+
+/* ----- Built-in Deflate decoder -----
+   Huffman tables are flat uint32 entries, LSB-first index:
+     bits 0..7   bits consumed by this entry
+     bits 8..11  extra bits (length/distance), subtable index bits, or bits of the first literal (LIT2)
+     bits 12..15 kind
+     bits 16..31 literal(s), length/distance base, or subtable offset
+   The literal/length table packs two literals into one entry whenever both codes fit in the
+   11-bit primary index, so runs of literals decode two at a time. The bit buffer is 64 bits and
+   is refilled with one unaligned 8-byte load; one refill covers a whole length/distance pair. */
+
+#define PAS_ZIP_LITLEN_BITS 11
+#define PAS_ZIP_DIST_BITS   8
+#define PAS_ZIP_PRECODE_BITS 7
+
+#define PAS_ZIP_K_LIT  0u
+#define PAS_ZIP_K_LIT2 1u
+#define PAS_ZIP_K_LEN  2u
+#define PAS_ZIP_K_EOB  3u
+#define PAS_ZIP_K_SUB  4u
+#define PAS_ZIP_K_BAD  5u
+
+#define PAS_ZIP_ENTRY(kind, aux, value, nbits) \
+    (((uint32_t)(value) << 16) | ((uint32_t)(kind) << 12) | ((uint32_t)(aux) << 8) | (uint32_t)(nbits))
+#define PAS_ZIP_E_KIND(e)  (((e) >> 12) & 0xFu)
+#define PAS_ZIP_E_AUX(e)   (((e) >> 8) & 0xFu)
+#define PAS_ZIP_E_NBITS(e) ((e) & 0xFFu)
+
+enum { PAS_ZIP_BLOCK_HEADER, PAS_ZIP_BLOCK_STORED, PAS_ZIP_BLOCK_HUFF, PAS_ZIP_BLOCK_DONE };
+enum { PAS_ZIP_FIXED_NONE, PAS_ZIP_FIXED_OWN, PAS_ZIP_FIXED_SHARED };
+
+static const uint16_t pas_zip__len_base[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const uint8_t pas_zip__len_extra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+static const uint16_t pas_zip__dist_base[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+static const uint8_t pas_zip__dist_extra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+static const uint8_t pas_zip__precode_order[19] = {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+};
+
+
+/* Entry template for symbol sym of table kind (0 = literal/length, 1 = distance, 2 = precode). */
+static uint32_t huff_symbol_entry(int table, unsigned sym) {
+    if (table == 0) {
+        if (sym < 256) return PAS_ZIP_ENTRY(PAS_ZIP_K_LIT, 0, sym, 0);
+        if (sym == 256) return PAS_ZIP_ENTRY(PAS_ZIP_K_EOB, 0, 0, 0);
+        if (sym < 286) return PAS_ZIP_ENTRY(PAS_ZIP_K_LEN, pas_zip__len_extra[sym - 257], pas_zip__len_base[sym - 257], 0);
+        return PAS_ZIP_ENTRY(PAS_ZIP_K_BAD, 0, 0, 0);
+    }
+    if (table == 1) {
+        if (sym < 30) return PAS_ZIP_ENTRY(PAS_ZIP_K_LEN, pas_zip__dist_extra[sym], pas_zip__dist_base[sym], 0);
+        return PAS_ZIP_ENTRY(PAS_ZIP_K_BAD, 0, 0, 0);
+    }
+    return PAS_ZIP_ENTRY(PAS_ZIP_K_LIT, 0, sym, 0);
+}
+
+/* Build a canonical Huffman decode table (two-level, zlib-style subtables).
+   Incomplete codes are accepted; unused entries decode as K_BAD. Returns 0 if over-subscribed. */
+static int huff_build(uint32_t *table, unsigned table_size, unsigned root,
+                      const uint8_t *lens, unsigned n, int kind) {
+    uint16_t count[16], left_count[16], offs[16];
+    uint16_t sorted[288];
+    unsigned len, i, idx = 0, next_free = 1u << root;
+    unsigned cur_prefix = ~0u, sub_base = 0, sub_bits = 0;
+    uint32_t code = 0;
+    int left = 1;
+    const uint32_t bad = PAS_ZIP_ENTRY(PAS_ZIP_K_BAD, 0, 0, 1);
+
+    memset(count, 0, sizeof(count));
+    for (i = 0; i < n; i++) count[lens[i]]++;
+    count[0] = 0;
+    for (len = 1; len < 16; len++) {
+        left = (left << 1) - count[len];
+        if (left < 0) return 0;
+    }
+    offs[1] = 0;
+    for (len = 1; len < 15; len++) offs[len + 1] = (uint16_t)(offs[len] + count[len]);
+    for (i = 0; i < n; i++) if (lens[i]) sorted[offs[lens[i]]++] = (uint16_t)i;
+    memcpy(left_count, count, sizeof(count));
+
+    for (i = 0; i < (1u << root); i++) table[i] = bad;
+
+    for (len = 1; len < 16; len++) {
+        unsigned k;
+        for (k = 0; k < count[len]; k++, code++) {
+            unsigned sym = sorted[idx++];
+            uint32_t rev = 0, c = code;
+            unsigned b;
+            for (b = 0; b < len; b++) { rev = (rev << 1) | (c & 1u); c >>= 1; }
+
+            if (len <= root) {
+                uint32_t e = huff_symbol_entry(kind, sym) | len;
+                for (i = rev; i < (1u << root); i += 1u << len) table[i] = e;
+            } else {
+                unsigned prefix = rev & ((1u << root) - 1u);
+                uint32_t e;
+                if (prefix != cur_prefix) {
+                    int room;
+                    sub_bits = len - root;
+                    room = 1 << sub_bits;
+                    while (sub_bits + root < 15) {
+                        room -= left_count[sub_bits + root];
+                        if (room <= 0) break;
+                        sub_bits++;
+                        room <<= 1;
+                    }
+                    if (next_free + (1u << sub_bits) > table_size) return 0;
+                    for (i = 0; i < (1u << sub_bits); i++) table[next_free + i] = bad;
+                    table[prefix] = PAS_ZIP_ENTRY(PAS_ZIP_K_SUB, sub_bits, next_free, root);
+                    sub_base = next_free;
+                    next_free += 1u << sub_bits;
+                    cur_prefix = prefix;
+                }
+                e = huff_symbol_entry(kind, sym) | (len - root);
+                for (i = rev >> root; i < (1u << sub_bits); i += 1u << (len - root)) table[sub_base + i] = e;
+            }
+            left_count[len]--;
+        }
+        code <<= 1;
+    }
+
+    if (kind == 0) {
+        /* Pack literal pairs. Descending order: entry i >> l1 is still unpacked when read. */
+        for (i = (1u << root); i-- > 0; ) {
+            uint32_t e = table[i], e2;
+            unsigned l1 = PAS_ZIP_E_NBITS(e), l2;
+            if (PAS_ZIP_E_KIND(e) != PAS_ZIP_K_LIT || l1 >= root) continue;
+            e2 = table[i >> l1];
+            l2 = PAS_ZIP_E_NBITS(e2);
+            if (PAS_ZIP_E_KIND(e2) != PAS_ZIP_K_LIT || l1 + l2 > root) continue;
+            table[i] = PAS_ZIP_ENTRY(PAS_ZIP_K_LIT2, l1, (e >> 16) | ((e2 >> 16) << 8), l1 + l2);
+        }
+    }
+    return 1;
+}
+
+/* Code lengths of the fixed Huffman code (RFC 1951 3.2.6): 288 literal/length, then 32 distance */
+static void inflate_fixed_lens(uint8_t *lens) {
+    unsigned i;
+    for (i = 0; i < 144; i++) lens[i] = 8;
+    for (; i < 256; i++) lens[i] = 9;
+    for (; i < 280; i++) lens[i] = 7;
+    for (; i < 288; i++) lens[i] = 8;
+    for (; i < 320; i++) lens[i] = 5;
+}
+
+/* Fixed-code tables in the state itself: the fallback while the shared tables are not ready */
+static int inflate_fixed_tables(pas_zip_inflate_t *st) {
+    uint8_t lens[320];
+    inflate_fixed_lens(lens);
+    if (!huff_build(st->litlen, PAS_ZIP_LITLEN_TABLE_SIZE, PAS_ZIP_LITLEN_BITS, lens, 288, 0)) return 0;
+    if (!huff_build(st->dist, PAS_ZIP_DIST_TABLE_SIZE, PAS_ZIP_DIST_BITS, lens + 288, 32, 1)) return 0;
+    st->fixed_tables = PAS_ZIP_FIXED_OWN;
+    return 1;
+}
+
+/* The fixed Huffman code (RFC 1951 3.2.6), built once into shared tables on first use. No fixed
+   code is longer than the primary index, so they need no subtables. Build state: 0 unbuilt,
+   1 building, 2 ready. */
+static uint32_t pas_zip__fixed_litlen[1u << PAS_ZIP_LITLEN_BITS];
+static uint32_t pas_zip__fixed_dist[1u << PAS_ZIP_DIST_BITS];
+static int pas_zip__fixed_state;
+
+/* Returns 1 when the shared tables are ready. The first caller builds them; a caller racing
+   that build gets 0 and uses its own tables for this block. Without GCC-style atomics the
+   shared tables are never used. */
+static int inflate_fixed_shared(void) {
+#if defined(__GNUC__)
+    uint8_t lens[320];
+    int expected = 0;
+
+    if (__atomic_load_n(&pas_zip__fixed_state, __ATOMIC_ACQUIRE) == 2) return 1;
+    if (!__atomic_compare_exchange_n(&pas_zip__fixed_state, &expected, 1, 0,
+                                     __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) return 0;
+    inflate_fixed_lens(lens);
+    if (!huff_build(pas_zip__fixed_litlen, 1u << PAS_ZIP_LITLEN_BITS, PAS_ZIP_LITLEN_BITS, lens, 288, 0) ||
+        !huff_build(pas_zip__fixed_dist, 1u << PAS_ZIP_DIST_BITS, PAS_ZIP_DIST_BITS, lens + 288, 32, 1)) {
+        __atomic_store_n(&pas_zip__fixed_state, 0, __ATOMIC_RELEASE);
+        return 0;
+    }
+    __atomic_store_n(&pas_zip__fixed_state, 2, __ATOMIC_RELEASE);
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+static void inflate_init(pas_zip_inflate_t *st, const uint8_t *in, size_t in_len) {
+    st->in = in;
+    st->in_end = in + in_len;
+    st->bitbuf = 0;
+    st->bitcount = 0;
+    st->overrun = 0;
+    st->block = PAS_ZIP_BLOCK_HEADER;
+    st->final = 0;
+    st->fixed_tables = PAS_ZIP_FIXED_NONE;
+    st->block_stop = 0;
+    st->stored_left = 0;
+    st->match_len = 0;
+    st->match_dist = 0;
+}
+
+/* Refill so that at least 56 bits are buffered. The fast path loads 8 bytes and keeps only whole
+   bytes; the bits above bitcount then already hold the following input, so OR-ing it again later is
+   harmless. Past the end of input, zero bytes are fed and counted in overrun. */
+#define PAS_ZIP_REFILL() do { \
+    if (in_end - in >= 8) { \
+        unsigned take_ = (63u - bitcount) >> 3; \
+        bitbuf |= read_u64_le(in) << bitcount; \
+        in += take_; \
+        bitcount += take_ << 3; \
+    } else { \
+        while (bitcount < 56) { \
+            if (in < in_end) bitbuf |= (uint64_t)*in++ << bitcount; \
+            else overrun++; \
+            bitcount += 8; \
+        } \
+    } \
+} while (0)
+
+#define PAS_ZIP_DROP(n) do { bitbuf >>= (n); bitcount -= (n); } while (0)
+
+/* Decode the code lengths of a dynamic block and build its tables. */
+static int inflate_dynamic_tables(pas_zip_inflate_t *st, uint64_t *pbitbuf, unsigned *pbitcount,
+                                  const uint8_t **pin, unsigned *poverrun) {
+    uint64_t bitbuf = *pbitbuf;
+    unsigned bitcount = *pbitcount, overrun = *poverrun;
+    const uint8_t *in = *pin, *in_end = st->in_end;
+    uint8_t lens[288 + 32], pre_lens[19];
+    unsigned hlit, hdist, hclen, i, n;
+
+    PAS_ZIP_REFILL();
+    hlit = (unsigned)(bitbuf & 31u) + 257;
+    hdist = (unsigned)((bitbuf >> 5) & 31u) + 1;
+    hclen = (unsigned)((bitbuf >> 10) & 15u) + 4;
+    PAS_ZIP_DROP(14);
+    if (hlit > 286 || hdist > 30) return 0;
+
+    memset(pre_lens, 0, sizeof(pre_lens));
+    for (i = 0; i < hclen; i++) {
+        if (bitcount < 3) PAS_ZIP_REFILL();
+        pre_lens[pas_zip__precode_order[i]] = (uint8_t)(bitbuf & 7u);
+        PAS_ZIP_DROP(3);
+    }
+    if (!huff_build(st->precode, PAS_ZIP_PRECODE_TABLE_SIZE, PAS_ZIP_PRECODE_BITS, pre_lens, 19, 2)) return 0;
+
+    n = hlit + hdist;
+    for (i = 0; i < n; ) {
+        uint32_t e;
+        unsigned sym, rep_len, rep_val;
+        PAS_ZIP_REFILL();
+        e = st->precode[bitbuf & ((1u << PAS_ZIP_PRECODE_BITS) - 1u)];
+        if (PAS_ZIP_E_KIND(e) == PAS_ZIP_K_BAD) return 0;
+        PAS_ZIP_DROP(PAS_ZIP_E_NBITS(e));
+        sym = e >> 16;
+        if (sym < 16) {
+            lens[i++] = (uint8_t)sym;
+            continue;
+        }
+        if (sym == 16) {
+            if (i == 0) return 0;
+            rep_val = lens[i - 1];
+            rep_len = 3 + (unsigned)(bitbuf & 3u);
+            PAS_ZIP_DROP(2);
+        } else if (sym == 17) {
+            rep_val = 0;
+            rep_len = 3 + (unsigned)(bitbuf & 7u);
+            PAS_ZIP_DROP(3);
+        } else {
+            rep_val = 0;
+            rep_len = 11 + (unsigned)(bitbuf & 127u);
+            PAS_ZIP_DROP(7);
+        }
+        if (i + rep_len > n) return 0;
+        while (rep_len--) lens[i++] = (uint8_t)rep_val;
+    }
+    if (overrun * 8 > bitcount) return 0;
+    if (lens[256] == 0) return 0;
+
+    if (!huff_build(st->litlen, PAS_ZIP_LITLEN_TABLE_SIZE, PAS_ZIP_LITLEN_BITS, lens, hlit, 0)) return 0;
+    if (!huff_build(st->dist, PAS_ZIP_DIST_TABLE_SIZE, PAS_ZIP_DIST_BITS, lens + hlit, hdist, 1)) return 0;
+    st->fixed_tables = PAS_ZIP_FIXED_NONE;
+
+    *pbitbuf = bitbuf;
+    *pbitcount = bitcount;
+    *pin = in;
+    *poverrun = overrun;
+    return 1;
+}
+
+/* Decode into out_base[*out_pos .. out_end). Everything before *out_pos is history that matches
+   may reference. Returns 1 when the stream is complete, 0 when the output range is full (call
+   again with more room), -1 on corrupt or truncated data. */
+static int inflate_run(pas_zip_inflate_t *st, uint8_t *out_base, size_t *out_pos, size_t out_end) {
+    const uint8_t *in = st->in;
+    const uint8_t *in_end = st->in_end;
+    uint64_t bitbuf = st->bitbuf;
+    unsigned bitcount = st->bitcount;
+    unsigned overrun = st->overrun;
+    uint8_t *out = out_base + *out_pos;
+    uint8_t *const out_stop = out_base + out_end;
+    const uint32_t *litlen, *dist_table;
+    int ret = -1;
+
+    for (;;) {
+        if (st->block == PAS_ZIP_BLOCK_DONE) { ret = 1; break; }
+
+        if (st->block == PAS_ZIP_BLOCK_HEADER) {
+            unsigned type;
+            if (st->final) { st->block = PAS_ZIP_BLOCK_DONE; continue; }
+            PAS_ZIP_REFILL();
+            st->final = (int)(bitbuf & 1u);
+            type = (unsigned)((bitbuf >> 1) & 3u);
+            PAS_ZIP_DROP(3);
+            if (type == 0) {
+                unsigned real;
+                PAS_ZIP_DROP(bitcount & 7u);
+                /* Give back whole buffered bytes, then read LEN/NLEN directly. */
+                real = bitcount >> 3;
+                if (real < overrun) goto out;
+                in -= real - overrun;
+                overrun = 0;
+                bitbuf = 0;
+                bitcount = 0;
+                if (in_end - in < 4) goto out;
+                if ((read_u16_le(in) ^ read_u16_le(in + 2)) != 0xFFFFu) goto out;
+                st->stored_left = read_u16_le(in);
+                in += 4;
+                st->block = PAS_ZIP_BLOCK_STORED;
+            } else if (type == 1) {
+                if (inflate_fixed_shared()) st->fixed_tables = PAS_ZIP_FIXED_SHARED;
+                else if (st->fixed_tables != PAS_ZIP_FIXED_OWN && !inflate_fixed_tables(st)) goto out;
+                st->block = PAS_ZIP_BLOCK_HUFF;
+            } else if (type == 2) {
+                if (!inflate_dynamic_tables(st, &bitbuf, &bitcount, &in, &overrun)) goto out;
+                st->block = PAS_ZIP_BLOCK_HUFF;
+            } else {
+                goto out;
+            }
+            continue;
+        }
+
+        if (st->block == PAS_ZIP_BLOCK_STORED) {
+            size_t n = st->stored_left;
+            if ((size_t)(out_stop - out) < n) n = (size_t)(out_stop - out);
+            if ((size_t)(in_end - in) < n) goto out;
+            memcpy(out, in, n);
+            out += n;
+            in += n;
+            st->stored_left -= n;
+            if (st->stored_left) { ret = 0; break; }
+            st->block = PAS_ZIP_BLOCK_HEADER;
+            if (st->block_stop) { ret = 0; break; }
+            continue;
+        }
+
+        /* Huffman block. Finish a match interrupted by a full output first. */
+        if (st->match_len) {
+            unsigned len = st->match_len;
+            const uint8_t *src = out - st->match_dist;
+            if ((size_t)(out_stop - out) < len) len = (unsigned)(out_stop - out);
+            st->match_len -= len;
+            while (len--) *out++ = *src++;
+            if (st->match_len) { ret = 0; break; }
+        }
+
+        /* Symbols are peeked first and consumed only once there is room for their output, so
+           an end-of-block code is still taken when the output is exactly full. */
+        litlen = st->fixed_tables == PAS_ZIP_FIXED_SHARED ? pas_zip__fixed_litlen : st->litlen;
+        dist_table = st->fixed_tables == PAS_ZIP_FIXED_SHARED ? pas_zip__fixed_dist : st->dist;
+        for (;;) {
+            uint32_t e;
+            unsigned kind, nbits;
+
+            if (bitcount < 48) {
+                if (in_end - in < 8 && overrun * 8 > bitcount) goto out;
+                PAS_ZIP_REFILL();
+            }
+
+            e = litlen[bitbuf & ((1u << PAS_ZIP_LITLEN_BITS) - 1u)];
+            kind = PAS_ZIP_E_KIND(e);
+            if (kind == PAS_ZIP_K_LIT2) {
+                if (out_stop - out >= 2) {
+                    out[0] = (uint8_t)(e >> 16);
+                    out[1] = (uint8_t)(e >> 24);
+                    out += 2;
+                    PAS_ZIP_DROP(PAS_ZIP_E_NBITS(e));
+                    continue;
+                }
+                if (out >= out_stop) { ret = 0; goto out; }
+                *out++ = (uint8_t)(e >> 16);
+                PAS_ZIP_DROP(PAS_ZIP_E_AUX(e));
+                continue;
+            }
+            nbits = PAS_ZIP_E_NBITS(e);
+            if (kind == PAS_ZIP_K_SUB) {
+                e = litlen[(e >> 16) +
+                           (unsigned)((bitbuf >> PAS_ZIP_LITLEN_BITS) & ((1u << PAS_ZIP_E_AUX(e)) - 1u))];
+                kind = PAS_ZIP_E_KIND(e);
+                nbits += PAS_ZIP_E_NBITS(e);
+            }
+            if (kind == PAS_ZIP_K_LIT) {
+                if (out >= out_stop) { ret = 0; goto out; }
+                *out++ = (uint8_t)(e >> 16);
+                PAS_ZIP_DROP(nbits);
+                continue;
+            }
+            if (kind == PAS_ZIP_K_LEN) {
+                unsigned len, dist, avail;
+                const uint8_t *src;
+
+                if (out >= out_stop) { ret = 0; goto out; }
+                PAS_ZIP_DROP(nbits);
+                len = (e >> 16) + (unsigned)(bitbuf & ((1u << PAS_ZIP_E_AUX(e)) - 1u));
+                PAS_ZIP_DROP(PAS_ZIP_E_AUX(e));
+
+                e = dist_table[bitbuf & ((1u << PAS_ZIP_DIST_BITS) - 1u)];
+                if (PAS_ZIP_E_KIND(e) == PAS_ZIP_K_SUB) {
+                    PAS_ZIP_DROP(PAS_ZIP_DIST_BITS);
+                    e = dist_table[(e >> 16) + (unsigned)(bitbuf & ((1u << PAS_ZIP_E_AUX(e)) - 1u))];
+                }
+                if (PAS_ZIP_E_KIND(e) != PAS_ZIP_K_LEN) goto out;
+                PAS_ZIP_DROP(PAS_ZIP_E_NBITS(e));
+                dist = (e >> 16) + (unsigned)(bitbuf & ((1u << PAS_ZIP_E_AUX(e)) - 1u));
+                PAS_ZIP_DROP(PAS_ZIP_E_AUX(e));
+
+                if ((size_t)dist > (size_t)(out - out_base)) goto out;
+                src = out - dist;
+                avail = (size_t)(out_stop - out) < len ? (unsigned)(out_stop - out) : len;
+                if (avail < len) {
+                    st->match_len = len - avail;
+                    st->match_dist = dist;
+                    while (avail--) *out++ = *src++;
+                    ret = 0;
+                    goto out;
+                }
+                if (dist >= 8 && (size_t)(out_stop - out) >= (size_t)len + 8) {
+                    /* 8-byte chunks may run past the match end; those bytes are overwritten next. */
+                    uint8_t *end = out + len;
+                    do {
+                        memcpy(out, src, 8);
+                        out += 8;
+                        src += 8;
+                    } while (out < end);
+                    out = end;
+                } else if (dist >= len) {
+                    memcpy(out, src, len);
+                    out += len;
+                } else if (dist == 1) {
+                    memset(out, *src, len);
+                    out += len;
+                } else {
+                    while (len--) *out++ = *src++;
+                }
+                continue;
+            }
+            if (kind == PAS_ZIP_K_EOB) {
+                PAS_ZIP_DROP(nbits);
+                st->block = PAS_ZIP_BLOCK_HEADER;
+                if (st->block_stop) { ret = 0; goto out; }
+                break;
+            }
+            goto out; /* K_BAD */
+        }
+    }
+
+out:
+    if (ret >= 0 && overrun * 8 > bitcount) ret = -1; /* consumed bits past the end of input */
+    st->in = in;
+    st->bitbuf = bitbuf;
+    st->bitcount = bitcount;
+    st->overrun = overrun;
+    *out_pos = (size_t)(out - out_base);
+    return ret;
+}
+
+size_t pas_zip_inflate(pas_zip_inflate_t *state, const void *in, size_t in_len,
+                       void *out, size_t out_size, pas_zip_status *status) {
+    size_t pos = 0;
+    int r;
+
+    if (status) *status = PAS_ZIP_E_INVALID;
+    if (!state || (!in && in_len) || (!out && out_size)) return 0;
+
+    inflate_init(state, (const uint8_t *)in, in_len);
+    r = inflate_run(state, (uint8_t *)out, &pos, out_size);
+    if (r == 0 && out_size == pos) {
+        /* Output full: fine if the stream ends exactly here. */
+        uint8_t dummy;
+        size_t extra = 0;
+        if (inflate_run(state, &dummy, &extra, 0) != 1) {
+            if (status) *status = PAS_ZIP_E_NOSPACE;
+            return pos;
+        }
+        r = 1;
+    }
+    if (status) *status = (r == 1) ? PAS_ZIP_OK : PAS_ZIP_E_ZLIB;
+    return pos;
+}
+
+/* ----- CRC-32 -----
+   Slice-by-16 tables for the portable path. On x86 with PCLMULQDQ (checked at runtime) blocks of
+   64+ bytes are folded with carry-less multiplies (Intel, "Fast CRC Computation for Generic
+   Polynomials Using PCLMULQDQ"); with ARMv8 CRC32 instructions enabled at compile time
+   (__ARM_FEATURE_CRC32) those are used. Define PAS_ZIP_NO_SIMD to force the table path. */
+
+static const uint32_t pas_zip__crc_table[16][256] = {
+    {
+        0x00000000, 0x77073096, 0xee0e612c, 0x990951ba, 0x076dc419, 0x706af48f, 0xe963a535, 0x9e6495a3,
+        0x0edb8832, 0x79dcb8a4, 0xe0d5e91e, 0x97d2d988, 0x09b64c2b, 0x7eb17cbd, 0xe7b82d07, 0x90bf1d91,
+        0x1db71064, 0x6ab020f2, 0xf3b97148, 0x84be41de, 0x1adad47d, 0x6ddde4eb, 0xf4d4b551, 0x83d385c7,
+        0x136c9856, 0x646ba8c0, 0xfd62f97a, 0x8a65c9ec, 0x14015c4f, 0x63066cd9, 0xfa0f3d63, 0x8d080df5,
+        0x3b6e20c8, 0x4c69105e, 0xd56041e4, 0xa2677172, 0x3c03e4d1, 0x4b04d447, 0xd20d85fd, 0xa50ab56b,
+        0x35b5a8fa, 0x42b2986c, 0xdbbbc9d6, 0xacbcf940, 0x32d86ce3, 0x45df5c75, 0xdcd60dcf, 0xabd13d59,
+        0x26d930ac, 0x51de003a, 0xc8d75180, 0xbfd06116, 0x21b4f4b5, 0x56b3c423, 0xcfba9599, 0xb8bda50f,
+        0x2802b89e, 0x5f058808, 0xc60cd9b2, 0xb10be924, 0x2f6f7c87, 0x58684c11, 0xc1611dab, 0xb6662d3d,
+        0x76dc4190, 0x01db7106, 0x98d220bc, 0xefd5102a, 0x71b18589, 0x06b6b51f, 0x9fbfe4a5, 0xe8b8d433,
+        0x7807c9a2, 0x0f00f934, 0x9609a88e, 0xe10e9818, 0x7f6a0dbb, 0x086d3d2d, 0x91646c97, 0xe6635c01,
+        0x6b6b51f4, 0x1c6c6162, 0x856530d8, 0xf262004e, 0x6c0695ed, 0x1b01a57b, 0x8208f4c1, 0xf50fc457,
+        0x65b0d9c6, 0x12b7e950, 0x8bbeb8ea, 0xfcb9887c, 0x62dd1ddf, 0x15da2d49, 0x8cd37cf3, 0xfbd44c65,
+        0x4db26158, 0x3ab551ce, 0xa3bc0074, 0xd4bb30e2, 0x4adfa541, 0x3dd895d7, 0xa4d1c46d, 0xd3d6f4fb,
+        0x4369e96a, 0x346ed9fc, 0xad678846, 0xda60b8d0, 0x44042d73, 0x33031de5, 0xaa0a4c5f, 0xdd0d7cc9,
+        0x5005713c, 0x270241aa, 0xbe0b1010, 0xc90c2086, 0x5768b525, 0x206f85b3, 0xb966d409, 0xce61e49f,
+        0x5edef90e, 0x29d9c998, 0xb0d09822, 0xc7d7a8b4, 0x59b33d17, 0x2eb40d81, 0xb7bd5c3b, 0xc0ba6cad,
+        0xedb88320, 0x9abfb3b6, 0x03b6e20c, 0x74b1d29a, 0xead54739, 0x9dd277af, 0x04db2615, 0x73dc1683,
+        0xe3630b12, 0x94643b84, 0x0d6d6a3e, 0x7a6a5aa8, 0xe40ecf0b, 0x9309ff9d, 0x0a00ae27, 0x7d079eb1,
+        0xf00f9344, 0x8708a3d2, 0x1e01f268, 0x6906c2fe, 0xf762575d, 0x806567cb, 0x196c3671, 0x6e6b06e7,
+        0xfed41b76, 0x89d32be0, 0x10da7a5a, 0x67dd4acc, 0xf9b9df6f, 0x8ebeeff9, 0x17b7be43, 0x60b08ed5,
+        0xd6d6a3e8, 0xa1d1937e, 0x38d8c2c4, 0x4fdff252, 0xd1bb67f1, 0xa6bc5767, 0x3fb506dd, 0x48b2364b,
+        0xd80d2bda, 0xaf0a1b4c, 0x36034af6, 0x41047a60, 0xdf60efc3, 0xa867df55, 0x316e8eef, 0x4669be79,
+        0xcb61b38c, 0xbc66831a, 0x256fd2a0, 0x5268e236, 0xcc0c7795, 0xbb0b4703, 0x220216b9, 0x5505262f,
+        0xc5ba3bbe, 0xb2bd0b28, 0x2bb45a92, 0x5cb36a04, 0xc2d7ffa7, 0xb5d0cf31, 0x2cd99e8b, 0x5bdeae1d,
+        0x9b64c2b0, 0xec63f226, 0x756aa39c, 0x026d930a, 0x9c0906a9, 0xeb0e363f, 0x72076785, 0x05005713,
+        0x95bf4a82, 0xe2b87a14, 0x7bb12bae, 0x0cb61b38, 0x92d28e9b, 0xe5d5be0d, 0x7cdcefb7, 0x0bdbdf21,
+        0x86d3d2d4, 0xf1d4e242, 0x68ddb3f8, 0x1fda836e, 0x81be16cd, 0xf6b9265b, 0x6fb077e1, 0x18b74777,
+        0x88085ae6, 0xff0f6a70, 0x66063bca, 0x11010b5c, 0x8f659eff, 0xf862ae69, 0x616bffd3, 0x166ccf45,
+        0xa00ae278, 0xd70dd2ee, 0x4e048354, 0x3903b3c2, 0xa7672661, 0xd06016f7, 0x4969474d, 0x3e6e77db,
+        0xaed16a4a, 0xd9d65adc, 0x40df0b66, 0x37d83bf0, 0xa9bcae53, 0xdebb9ec5, 0x47b2cf7f, 0x30b5ffe9,
+        0xbdbdf21c, 0xcabac28a, 0x53b39330, 0x24b4a3a6, 0xbad03605, 0xcdd70693, 0x54de5729, 0x23d967bf,
+        0xb3667a2e, 0xc4614ab8, 0x5d681b02, 0x2a6f2b94, 0xb40bbe37, 0xc30c8ea1, 0x5a05df1b, 0x2d02ef8d
+    },
+    {
+        0x00000000, 0x191b3141, 0x32366282, 0x2b2d53c3, 0x646cc504, 0x7d77f445, 0x565aa786, 0x4f4196c7,
+        0xc8d98a08, 0xd1c2bb49, 0xfaefe88a, 0xe3f4d9cb, 0xacb54f0c, 0xb5ae7e4d, 0x9e832d8e, 0x87981ccf,
+        0x4ac21251, 0x53d92310, 0x78f470d3, 0x61ef4192, 0x2eaed755, 0x37b5e614, 0x1c98b5d7, 0x05838496,
+        0x821b9859, 0x9b00a918, 0xb02dfadb, 0xa936cb9a, 0xe6775d5d, 0xff6c6c1c, 0xd4413fdf, 0xcd5a0e9e,
+        0x958424a2, 0x8c9f15e3, 0xa7b24620, 0xbea97761, 0xf1e8e1a6, 0xe8f3d0e7, 0xc3de8324, 0xdac5b265,
+        0x5d5daeaa, 0x44469feb, 0x6f6bcc28, 0x7670fd69, 0x39316bae, 0x202a5aef, 0x0b07092c, 0x121c386d,
+        0xdf4636f3, 0xc65d07b2, 0xed705471, 0xf46b6530, 0xbb2af3f7, 0xa231c2b6, 0x891c9175, 0x9007a034,
+        0x179fbcfb, 0x0e848dba, 0x25a9de79, 0x3cb2ef38, 0x73f379ff, 0x6ae848be, 0x41c51b7d, 0x58de2a3c,
+        0xf0794f05, 0xe9627e44, 0xc24f2d87, 0xdb541cc6, 0x94158a01, 0x8d0ebb40, 0xa623e883, 0xbf38d9c2,
+        0x38a0c50d, 0x21bbf44c, 0x0a96a78f, 0x138d96ce, 0x5ccc0009, 0x45d73148, 0x6efa628b, 0x77e153ca,
+        0xbabb5d54, 0xa3a06c15, 0x888d3fd6, 0x91960e97, 0xded79850, 0xc7cca911, 0xece1fad2, 0xf5facb93,
+        0x7262d75c, 0x6b79e61d, 0x4054b5de, 0x594f849f, 0x160e1258, 0x0f152319, 0x243870da, 0x3d23419b,
+        0x65fd6ba7, 0x7ce65ae6, 0x57cb0925, 0x4ed03864, 0x0191aea3, 0x188a9fe2, 0x33a7cc21, 0x2abcfd60,
+        0xad24e1af, 0xb43fd0ee, 0x9f12832d, 0x8609b26c, 0xc94824ab, 0xd05315ea, 0xfb7e4629, 0xe2657768,
+        0x2f3f79f6, 0x362448b7, 0x1d091b74, 0x04122a35, 0x4b53bcf2, 0x52488db3, 0x7965de70, 0x607eef31,
+        0xe7e6f3fe, 0xfefdc2bf, 0xd5d0917c, 0xcccba03d, 0x838a36fa, 0x9a9107bb, 0xb1bc5478, 0xa8a76539,
+        0x3b83984b, 0x2298a90a, 0x09b5fac9, 0x10aecb88, 0x5fef5d4f, 0x46f46c0e, 0x6dd93fcd, 0x74c20e8c,
+        0xf35a1243, 0xea412302, 0xc16c70c1, 0xd8774180, 0x9736d747, 0x8e2de606, 0xa500b5c5, 0xbc1b8484,
+        0x71418a1a, 0x685abb5b, 0x4377e898, 0x5a6cd9d9, 0x152d4f1e, 0x0c367e5f, 0x271b2d9c, 0x3e001cdd,
+        0xb9980012, 0xa0833153, 0x8bae6290, 0x92b553d1, 0xddf4c516, 0xc4eff457, 0xefc2a794, 0xf6d996d5,
+        0xae07bce9, 0xb71c8da8, 0x9c31de6b, 0x852aef2a, 0xca6b79ed, 0xd37048ac, 0xf85d1b6f, 0xe1462a2e,
+        0x66de36e1, 0x7fc507a0, 0x54e85463, 0x4df36522, 0x02b2f3e5, 0x1ba9c2a4, 0x30849167, 0x299fa026,
+        0xe4c5aeb8, 0xfdde9ff9, 0xd6f3cc3a, 0xcfe8fd7b, 0x80a96bbc, 0x99b25afd, 0xb29f093e, 0xab84387f,
+        0x2c1c24b0, 0x350715f1, 0x1e2a4632, 0x07317773, 0x4870e1b4, 0x516bd0f5, 0x7a468336, 0x635db277,
+        0xcbfad74e, 0xd2e1e60f, 0xf9ccb5cc, 0xe0d7848d, 0xaf96124a, 0xb68d230b, 0x9da070c8, 0x84bb4189,
+        0x03235d46, 0x1a386c07, 0x31153fc4, 0x280e0e85, 0x674f9842, 0x7e54a903, 0x5579fac0, 0x4c62cb81,
+        0x8138c51f, 0x9823f45e, 0xb30ea79d, 0xaa1596dc, 0xe554001b, 0xfc4f315a, 0xd7626299, 0xce7953d8,
+        0x49e14f17, 0x50fa7e56, 0x7bd72d95, 0x62cc1cd4, 0x2d8d8a13, 0x3496bb52, 0x1fbbe891, 0x06a0d9d0,
+        0x5e7ef3ec, 0x4765c2ad, 0x6c48916e, 0x7553a02f, 0x3a1236e8, 0x230907a9, 0x0824546a, 0x113f652b,
+        0x96a779e4, 0x8fbc48a5, 0xa4911b66, 0xbd8a2a27, 0xf2cbbce0, 0xebd08da1, 0xc0fdde62, 0xd9e6ef23,
+        0x14bce1bd, 0x0da7d0fc, 0x268a833f, 0x3f91b27e, 0x70d024b9, 0x69cb15f8, 0x42e6463b, 0x5bfd777a,
+        0xdc656bb5, 0xc57e5af4, 0xee530937, 0xf7483876, 0xb809aeb1, 0xa1129ff0, 0x8a3fcc33, 0x9324fd72
+    },
+    {
+        0x00000000, 0x01c26a37, 0x0384d46e, 0x0246be59, 0x0709a8dc, 0x06cbc2eb, 0x048d7cb2, 0x054f1685,
+        0x0e1351b8, 0x0fd13b8f, 0x0d9785d6, 0x0c55efe1, 0x091af964, 0x08d89353, 0x0a9e2d0a, 0x0b5c473d,
+        0x1c26a370, 0x1de4c947, 0x1fa2771e, 0x1e601d29, 0x1b2f0bac, 0x1aed619b, 0x18abdfc2, 0x1969b5f5,
+        0x1235f2c8, 0x13f798ff, 0x11b126a6, 0x10734c91, 0x153c5a14, 0x14fe3023, 0x16b88e7a, 0x177ae44d,
+        0x384d46e0, 0x398f2cd7, 0x3bc9928e, 0x3a0bf8b9, 0x3f44ee3c, 0x3e86840b, 0x3cc03a52, 0x3d025065,
+        0x365e1758, 0x379c7d6f, 0x35dac336, 0x3418a901, 0x3157bf84, 0x3095d5b3, 0x32d36bea, 0x331101dd,
+        0x246be590, 0x25a98fa7, 0x27ef31fe, 0x262d5bc9, 0x23624d4c, 0x22a0277b, 0x20e69922, 0x2124f315,
+        0x2a78b428, 0x2bbade1f, 0x29fc6046, 0x283e0a71, 0x2d711cf4, 0x2cb376c3, 0x2ef5c89a, 0x2f37a2ad,
+        0x709a8dc0, 0x7158e7f7, 0x731e59ae, 0x72dc3399, 0x7793251c, 0x76514f2b, 0x7417f172, 0x75d59b45,
+        0x7e89dc78, 0x7f4bb64f, 0x7d0d0816, 0x7ccf6221, 0x798074a4, 0x78421e93, 0x7a04a0ca, 0x7bc6cafd,
+        0x6cbc2eb0, 0x6d7e4487, 0x6f38fade, 0x6efa90e9, 0x6bb5866c, 0x6a77ec5b, 0x68315202, 0x69f33835,
+        0x62af7f08, 0x636d153f, 0x612bab66, 0x60e9c151, 0x65a6d7d4, 0x6464bde3, 0x662203ba, 0x67e0698d,
+        0x48d7cb20, 0x4915a117, 0x4b531f4e, 0x4a917579, 0x4fde63fc, 0x4e1c09cb, 0x4c5ab792, 0x4d98dda5,
+        0x46c49a98, 0x4706f0af, 0x45404ef6, 0x448224c1, 0x41cd3244, 0x400f5873, 0x4249e62a, 0x438b8c1d,
+        0x54f16850, 0x55330267, 0x5775bc3e, 0x56b7d609, 0x53f8c08c, 0x523aaabb, 0x507c14e2, 0x51be7ed5,
+        0x5ae239e8, 0x5b2053df, 0x5966ed86, 0x58a487b1, 0x5deb9134, 0x5c29fb03, 0x5e6f455a, 0x5fad2f6d,
+        0xe1351b80, 0xe0f771b7, 0xe2b1cfee, 0xe373a5d9, 0xe63cb35c, 0xe7fed96b, 0xe5b86732, 0xe47a0d05,
+        0xef264a38, 0xeee4200f, 0xeca29e56, 0xed60f461, 0xe82fe2e4, 0xe9ed88d3, 0xebab368a, 0xea695cbd,
+        0xfd13b8f0, 0xfcd1d2c7, 0xfe976c9e, 0xff5506a9, 0xfa1a102c, 0xfbd87a1b, 0xf99ec442, 0xf85cae75,
+        0xf300e948, 0xf2c2837f, 0xf0843d26, 0xf1465711, 0xf4094194, 0xf5cb2ba3, 0xf78d95fa, 0xf64fffcd,
+        0xd9785d60, 0xd8ba3757, 0xdafc890e, 0xdb3ee339, 0xde71f5bc, 0xdfb39f8b, 0xddf521d2, 0xdc374be5,
+        0xd76b0cd8, 0xd6a966ef, 0xd4efd8b6, 0xd52db281, 0xd062a404, 0xd1a0ce33, 0xd3e6706a, 0xd2241a5d,
+        0xc55efe10, 0xc49c9427, 0xc6da2a7e, 0xc7184049, 0xc25756cc, 0xc3953cfb, 0xc1d382a2, 0xc011e895,
+        0xcb4dafa8, 0xca8fc59f, 0xc8c97bc6, 0xc90b11f1, 0xcc440774, 0xcd866d43, 0xcfc0d31a, 0xce02b92d,
+        0x91af9640, 0x906dfc77, 0x922b422e, 0x93e92819, 0x96a63e9c, 0x976454ab, 0x9522eaf2, 0x94e080c5,
+        0x9fbcc7f8, 0x9e7eadcf, 0x9c381396, 0x9dfa79a1, 0x98b56f24, 0x99770513, 0x9b31bb4a, 0x9af3d17d,
+        0x8d893530, 0x8c4b5f07, 0x8e0de15e, 0x8fcf8b69, 0x8a809dec, 0x8b42f7db, 0x89044982, 0x88c623b5,
+        0x839a6488, 0x82580ebf, 0x801eb0e6, 0x81dcdad1, 0x8493cc54, 0x8551a663, 0x8717183a, 0x86d5720d,
+        0xa9e2d0a0, 0xa820ba97, 0xaa6604ce, 0xaba46ef9, 0xaeeb787c, 0xaf29124b, 0xad6fac12, 0xacadc625,
+        0xa7f18118, 0xa633eb2f, 0xa4755576, 0xa5b73f41, 0xa0f829c4, 0xa13a43f3, 0xa37cfdaa, 0xa2be979d,
+        0xb5c473d0, 0xb40619e7, 0xb640a7be, 0xb782cd89, 0xb2cddb0c, 0xb30fb13b, 0xb1490f62, 0xb08b6555,
+        0xbbd72268, 0xba15485f, 0xb853f606, 0xb9919c31, 0xbcde8ab4, 0xbd1ce083, 0xbf5a5eda, 0xbe9834ed
+    },
+    {
+        0x00000000, 0xb8bc6765, 0xaa09c88b, 0x12b5afee, 0x8f629757, 0x37def032, 0x256b5fdc, 0x9dd738b9,
+        0xc5b428ef, 0x7d084f8a, 0x6fbde064, 0xd7018701, 0x4ad6bfb8, 0xf26ad8dd, 0xe0df7733, 0x58631056,
+        0x5019579f, 0xe8a530fa, 0xfa109f14, 0x42acf871, 0xdf7bc0c8, 0x67c7a7ad, 0x75720843, 0xcdce6f26,
+        0x95ad7f70, 0x2d111815, 0x3fa4b7fb, 0x8718d09e, 0x1acfe827, 0xa2738f42, 0xb0c620ac, 0x087a47c9,
+        0xa032af3e, 0x188ec85b, 0x0a3b67b5, 0xb28700d0, 0x2f503869, 0x97ec5f0c, 0x8559f0e2, 0x3de59787,
+        0x658687d1, 0xdd3ae0b4, 0xcf8f4f5a, 0x7733283f, 0xeae41086, 0x525877e3, 0x40edd80d, 0xf851bf68,
+        0xf02bf8a1, 0x48979fc4, 0x5a22302a, 0xe29e574f, 0x7f496ff6, 0xc7f50893, 0xd540a77d, 0x6dfcc018,
+        0x359fd04e, 0x8d23b72b, 0x9f9618c5, 0x272a7fa0, 0xbafd4719, 0x0241207c, 0x10f48f92, 0xa848e8f7,
+        0x9b14583d, 0x23a83f58, 0x311d90b6, 0x89a1f7d3, 0x1476cf6a, 0xaccaa80f, 0xbe7f07e1, 0x06c36084,
+        0x5ea070d2, 0xe61c17b7, 0xf4a9b859, 0x4c15df3c, 0xd1c2e785, 0x697e80e0, 0x7bcb2f0e, 0xc377486b,
+        0xcb0d0fa2, 0x73b168c7, 0x6104c729, 0xd9b8a04c, 0x446f98f5, 0xfcd3ff90, 0xee66507e, 0x56da371b,
+        0x0eb9274d, 0xb6054028, 0xa4b0efc6, 0x1c0c88a3, 0x81dbb01a, 0x3967d77f, 0x2bd27891, 0x936e1ff4,
+        0x3b26f703, 0x839a9066, 0x912f3f88, 0x299358ed, 0xb4446054, 0x0cf80731, 0x1e4da8df, 0xa6f1cfba,
+        0xfe92dfec, 0x462eb889, 0x549b1767, 0xec277002, 0x71f048bb, 0xc94c2fde, 0xdbf98030, 0x6345e755,
+        0x6b3fa09c, 0xd383c7f9, 0xc1366817, 0x798a0f72, 0xe45d37cb, 0x5ce150ae, 0x4e54ff40, 0xf6e89825,
+        0xae8b8873, 0x1637ef16, 0x048240f8, 0xbc3e279d, 0x21e91f24, 0x99557841, 0x8be0d7af, 0x335cb0ca,
+        0xed59b63b, 0x55e5d15e, 0x47507eb0, 0xffec19d5, 0x623b216c, 0xda874609, 0xc832e9e7, 0x708e8e82,
+        0x28ed9ed4, 0x9051f9b1, 0x82e4565f, 0x3a58313a, 0xa78f0983, 0x1f336ee6, 0x0d86c108, 0xb53aa66d,
+        0xbd40e1a4, 0x05fc86c1, 0x1749292f, 0xaff54e4a, 0x322276f3, 0x8a9e1196, 0x982bbe78, 0x2097d91d,
+        0x78f4c94b, 0xc048ae2e, 0xd2fd01c0, 0x6a4166a5, 0xf7965e1c, 0x4f2a3979, 0x5d9f9697, 0xe523f1f2,
+        0x4d6b1905, 0xf5d77e60, 0xe762d18e, 0x5fdeb6eb, 0xc2098e52, 0x7ab5e937, 0x680046d9, 0xd0bc21bc,
+        0x88df31ea, 0x3063568f, 0x22d6f961, 0x9a6a9e04, 0x07bda6bd, 0xbf01c1d8, 0xadb46e36, 0x15080953,
+        0x1d724e9a, 0xa5ce29ff, 0xb77b8611, 0x0fc7e174, 0x9210d9cd, 0x2aacbea8, 0x38191146, 0x80a57623,
+        0xd8c66675, 0x607a0110, 0x72cfaefe, 0xca73c99b, 0x57a4f122, 0xef189647, 0xfdad39a9, 0x45115ecc,
+        0x764dee06, 0xcef18963, 0xdc44268d, 0x64f841e8, 0xf92f7951, 0x41931e34, 0x5326b1da, 0xeb9ad6bf,
+        0xb3f9c6e9, 0x0b45a18c, 0x19f00e62, 0xa14c6907, 0x3c9b51be, 0x842736db, 0x96929935, 0x2e2efe50,
+        0x2654b999, 0x9ee8defc, 0x8c5d7112, 0x34e11677, 0xa9362ece, 0x118a49ab, 0x033fe645, 0xbb838120,
+        0xe3e09176, 0x5b5cf613, 0x49e959fd, 0xf1553e98, 0x6c820621, 0xd43e6144, 0xc68bceaa, 0x7e37a9cf,
+        0xd67f4138, 0x6ec3265d, 0x7c7689b3, 0xc4caeed6, 0x591dd66f, 0xe1a1b10a, 0xf3141ee4, 0x4ba87981,
+        0x13cb69d7, 0xab770eb2, 0xb9c2a15c, 0x017ec639, 0x9ca9fe80, 0x241599e5, 0x36a0360b, 0x8e1c516e,
+        0x866616a7, 0x3eda71c2, 0x2c6fde2c, 0x94d3b949, 0x090481f0, 0xb1b8e695, 0xa30d497b, 0x1bb12e1e,
+        0x43d23e48, 0xfb6e592d, 0xe9dbf6c3, 0x516791a6, 0xccb0a91f, 0x740cce7a, 0x66b96194, 0xde0506f1
+    },
+    {
+        0x00000000, 0x3d6029b0, 0x7ac05360, 0x47a07ad0, 0xf580a6c0, 0xc8e08f70, 0x8f40f5a0, 0xb220dc10,
+        0x30704bc1, 0x0d106271, 0x4ab018a1, 0x77d03111, 0xc5f0ed01, 0xf890c4b1, 0xbf30be61, 0x825097d1,
+        0x60e09782, 0x5d80be32, 0x1a20c4e2, 0x2740ed52, 0x95603142, 0xa80018f2, 0xefa06222, 0xd2c04b92,
+        0x5090dc43, 0x6df0f5f3, 0x2a508f23, 0x1730a693, 0xa5107a83, 0x98705333, 0xdfd029e3, 0xe2b00053,
+        0xc1c12f04, 0xfca106b4, 0xbb017c64, 0x866155d4, 0x344189c4, 0x0921a074, 0x4e81daa4, 0x73e1f314,
+        0xf1b164c5, 0xccd14d75, 0x8b7137a5, 0xb6111e15, 0x0431c205, 0x3951ebb5, 0x7ef19165, 0x4391b8d5,
+        0xa121b886, 0x9c419136, 0xdbe1ebe6, 0xe681c256, 0x54a11e46, 0x69c137f6, 0x2e614d26, 0x13016496,
+        0x9151f347, 0xac31daf7, 0xeb91a027, 0xd6f18997, 0x64d15587, 0x59b17c37, 0x1e1106e7, 0x23712f57,
+        0x58f35849, 0x659371f9, 0x22330b29, 0x1f532299, 0xad73fe89, 0x9013d739, 0xd7b3ade9, 0xead38459,
+        0x68831388, 0x55e33a38, 0x124340e8, 0x2f236958, 0x9d03b548, 0xa0639cf8, 0xe7c3e628, 0xdaa3cf98,
+        0x3813cfcb, 0x0573e67b, 0x42d39cab, 0x7fb3b51b, 0xcd93690b, 0xf0f340bb, 0xb7533a6b, 0x8a3313db,
+        0x0863840a, 0x3503adba, 0x72a3d76a, 0x4fc3feda, 0xfde322ca, 0xc0830b7a, 0x872371aa, 0xba43581a,
+        0x9932774d, 0xa4525efd, 0xe3f2242d, 0xde920d9d, 0x6cb2d18d, 0x51d2f83d, 0x167282ed, 0x2b12ab5d,
+        0xa9423c8c, 0x9422153c, 0xd3826fec, 0xeee2465c, 0x5cc29a4c, 0x61a2b3fc, 0x2602c92c, 0x1b62e09c,
+        0xf9d2e0cf, 0xc4b2c97f, 0x8312b3af, 0xbe729a1f, 0x0c52460f, 0x31326fbf, 0x7692156f, 0x4bf23cdf,
+        0xc9a2ab0e, 0xf4c282be, 0xb362f86e, 0x8e02d1de, 0x3c220dce, 0x0142247e, 0x46e25eae, 0x7b82771e,
+        0xb1e6b092, 0x8c869922, 0xcb26e3f2, 0xf646ca42, 0x44661652, 0x79063fe2, 0x3ea64532, 0x03c66c82,
+        0x8196fb53, 0xbcf6d2e3, 0xfb56a833, 0xc6368183, 0x74165d93, 0x49767423, 0x0ed60ef3, 0x33b62743,
+        0xd1062710, 0xec660ea0, 0xabc67470, 0x96a65dc0, 0x248681d0, 0x19e6a860, 0x5e46d2b0, 0x6326fb00,
+        0xe1766cd1, 0xdc164561, 0x9bb63fb1, 0xa6d61601, 0x14f6ca11, 0x2996e3a1, 0x6e369971, 0x5356b0c1,
+        0x70279f96, 0x4d47b626, 0x0ae7ccf6, 0x3787e546, 0x85a73956, 0xb8c710e6, 0xff676a36, 0xc2074386,
+        0x4057d457, 0x7d37fde7, 0x3a978737, 0x07f7ae87, 0xb5d77297, 0x88b75b27, 0xcf1721f7, 0xf2770847,
+        0x10c70814, 0x2da721a4, 0x6a075b74, 0x576772c4, 0xe547aed4, 0xd8278764, 0x9f87fdb4, 0xa2e7d404,
+        0x20b743d5, 0x1dd76a65, 0x5a7710b5, 0x67173905, 0xd537e515, 0xe857cca5, 0xaff7b675, 0x92979fc5,
+        0xe915e8db, 0xd475c16b, 0x93d5bbbb, 0xaeb5920b, 0x1c954e1b, 0x21f567ab, 0x66551d7b, 0x5b3534cb,
+        0xd965a31a, 0xe4058aaa, 0xa3a5f07a, 0x9ec5d9ca, 0x2ce505da, 0x11852c6a, 0x562556ba, 0x6b457f0a,
+        0x89f57f59, 0xb49556e9, 0xf3352c39, 0xce550589, 0x7c75d999, 0x4115f029, 0x06b58af9, 0x3bd5a349,
+        0xb9853498, 0x84e51d28, 0xc34567f8, 0xfe254e48, 0x4c059258, 0x7165bbe8, 0x36c5c138, 0x0ba5e888,
+        0x28d4c7df, 0x15b4ee6f, 0x521494bf, 0x6f74bd0f, 0xdd54611f, 0xe03448af, 0xa794327f, 0x9af41bcf,
+        0x18a48c1e, 0x25c4a5ae, 0x6264df7e, 0x5f04f6ce, 0xed242ade, 0xd044036e, 0x97e479be, 0xaa84500e,
+        0x4834505d, 0x755479ed, 0x32f4033d, 0x0f942a8d, 0xbdb4f69d, 0x80d4df2d, 0xc774a5fd, 0xfa148c4d,
+        0x78441b9c, 0x4524322c, 0x028448fc, 0x3fe4614c, 0x8dc4bd5c, 0xb0a494ec, 0xf704ee3c, 0xca64c78c
+    },
+    {
+        0x00000000, 0xcb5cd3a5, 0x4dc8a10b, 0x869472ae, 0x9b914216, 0x50cd91b3, 0xd659e31d, 0x1d0530b8,
+        0xec53826d, 0x270f51c8, 0xa19b2366, 0x6ac7f0c3, 0x77c2c07b, 0xbc9e13de, 0x3a0a6170, 0xf156b2d5,
+        0x03d6029b, 0xc88ad13e, 0x4e1ea390, 0x85427035, 0x9847408d, 0x531b9328, 0xd58fe186, 0x1ed33223,
+        0xef8580f6, 0x24d95353, 0xa24d21fd, 0x6911f258, 0x7414c2e0, 0xbf481145, 0x39dc63eb, 0xf280b04e,
+        0x07ac0536, 0xccf0d693, 0x4a64a43d, 0x81387798, 0x9c3d4720, 0x57619485, 0xd1f5e62b, 0x1aa9358e,
+        0xebff875b, 0x20a354fe, 0xa6372650, 0x6d6bf5f5, 0x706ec54d, 0xbb3216e8, 0x3da66446, 0xf6fab7e3,
+        0x047a07ad, 0xcf26d408, 0x49b2a6a6, 0x82ee7503, 0x9feb45bb, 0x54b7961e, 0xd223e4b0, 0x197f3715,
+        0xe82985c0, 0x23755665, 0xa5e124cb, 0x6ebdf76e, 0x73b8c7d6, 0xb8e41473, 0x3e7066dd, 0xf52cb578,
+        0x0f580a6c, 0xc404d9c9, 0x4290ab67, 0x89cc78c2, 0x94c9487a, 0x5f959bdf, 0xd901e971, 0x125d3ad4,
+        0xe30b8801, 0x28575ba4, 0xaec3290a, 0x659ffaaf, 0x789aca17, 0xb3c619b2, 0x35526b1c, 0xfe0eb8b9,
+        0x0c8e08f7, 0xc7d2db52, 0x4146a9fc, 0x8a1a7a59, 0x971f4ae1, 0x5c439944, 0xdad7ebea, 0x118b384f,
+        0xe0dd8a9a, 0x2b81593f, 0xad152b91, 0x6649f834, 0x7b4cc88c, 0xb0101b29, 0x36846987, 0xfdd8ba22,
+        0x08f40f5a, 0xc3a8dcff, 0x453cae51, 0x8e607df4, 0x93654d4c, 0x58399ee9, 0xdeadec47, 0x15f13fe2,
+        0xe4a78d37, 0x2ffb5e92, 0xa96f2c3c, 0x6233ff99, 0x7f36cf21, 0xb46a1c84, 0x32fe6e2a, 0xf9a2bd8f,
+        0x0b220dc1, 0xc07ede64, 0x46eaacca, 0x8db67f6f, 0x90b34fd7, 0x5bef9c72, 0xdd7beedc, 0x16273d79,
+        0xe7718fac, 0x2c2d5c09, 0xaab92ea7, 0x61e5fd02, 0x7ce0cdba, 0xb7bc1e1f, 0x31286cb1, 0xfa74bf14,
+        0x1eb014d8, 0xd5ecc77d, 0x5378b5d3, 0x98246676, 0x852156ce, 0x4e7d856b, 0xc8e9f7c5, 0x03b52460,
+        0xf2e396b5, 0x39bf4510, 0xbf2b37be, 0x7477e41b, 0x6972d4a3, 0xa22e0706, 0x24ba75a8, 0xefe6a60d,
+        0x1d661643, 0xd63ac5e6, 0x50aeb748, 0x9bf264ed, 0x86f75455, 0x4dab87f0, 0xcb3ff55e, 0x006326fb,
+        0xf135942e, 0x3a69478b, 0xbcfd3525, 0x77a1e680, 0x6aa4d638, 0xa1f8059d, 0x276c7733, 0xec30a496,
+        0x191c11ee, 0xd240c24b, 0x54d4b0e5, 0x9f886340, 0x828d53f8, 0x49d1805d, 0xcf45f2f3, 0x04192156,
+        0xf54f9383, 0x3e134026, 0xb8873288, 0x73dbe12d, 0x6eded195, 0xa5820230, 0x2316709e, 0xe84aa33b,
+        0x1aca1375, 0xd196c0d0, 0x5702b27e, 0x9c5e61db, 0x815b5163, 0x4a0782c6, 0xcc93f068, 0x07cf23cd,
+        0xf6999118, 0x3dc542bd, 0xbb513013, 0x700de3b6, 0x6d08d30e, 0xa65400ab, 0x20c07205, 0xeb9ca1a0,
+        0x11e81eb4, 0xdab4cd11, 0x5c20bfbf, 0x977c6c1a, 0x8a795ca2, 0x41258f07, 0xc7b1fda9, 0x0ced2e0c,
+        0xfdbb9cd9, 0x36e74f7c, 0xb0733dd2, 0x7b2fee77, 0x662adecf, 0xad760d6a, 0x2be27fc4, 0xe0beac61,
+        0x123e1c2f, 0xd962cf8a, 0x5ff6bd24, 0x94aa6e81, 0x89af5e39, 0x42f38d9c, 0xc467ff32, 0x0f3b2c97,
+        0xfe6d9e42, 0x35314de7, 0xb3a53f49, 0x78f9ecec, 0x65fcdc54, 0xaea00ff1, 0x28347d5f, 0xe368aefa,
+        0x16441b82, 0xdd18c827, 0x5b8cba89, 0x90d0692c, 0x8dd55994, 0x46898a31, 0xc01df89f, 0x0b412b3a,
+        0xfa1799ef, 0x314b4a4a, 0xb7df38e4, 0x7c83eb41, 0x6186dbf9, 0xaada085c, 0x2c4e7af2, 0xe712a957,
+        0x15921919, 0xdececabc, 0x585ab812, 0x93066bb7, 0x8e035b0f, 0x455f88aa, 0xc3cbfa04, 0x089729a1,
+        0xf9c19b74, 0x329d48d1, 0xb4093a7f, 0x7f55e9da, 0x6250d962, 0xa90c0ac7, 0x2f987869, 0xe4c4abcc
+    },
+    {
+        0x00000000, 0xa6770bb4, 0x979f1129, 0x31e81a9d, 0xf44f2413, 0x52382fa7, 0x63d0353a, 0xc5a73e8e,
+        0x33ef4e67, 0x959845d3, 0xa4705f4e, 0x020754fa, 0xc7a06a74, 0x61d761c0, 0x503f7b5d, 0xf64870e9,
+        0x67de9cce, 0xc1a9977a, 0xf0418de7, 0x56368653, 0x9391b8dd, 0x35e6b369, 0x040ea9f4, 0xa279a240,
+        0x5431d2a9, 0xf246d91d, 0xc3aec380, 0x65d9c834, 0xa07ef6ba, 0x0609fd0e, 0x37e1e793, 0x9196ec27,
+        0xcfbd399c, 0x69ca3228, 0x582228b5, 0xfe552301, 0x3bf21d8f, 0x9d85163b, 0xac6d0ca6, 0x0a1a0712,
+        0xfc5277fb, 0x5a257c4f, 0x6bcd66d2, 0xcdba6d66, 0x081d53e8, 0xae6a585c, 0x9f8242c1, 0x39f54975,
+        0xa863a552, 0x0e14aee6, 0x3ffcb47b, 0x998bbfcf, 0x5c2c8141, 0xfa5b8af5, 0xcbb39068, 0x6dc49bdc,
+        0x9b8ceb35, 0x3dfbe081, 0x0c13fa1c, 0xaa64f1a8, 0x6fc3cf26, 0xc9b4c492, 0xf85cde0f, 0x5e2bd5bb,
+        0x440b7579, 0xe27c7ecd, 0xd3946450, 0x75e36fe4, 0xb044516a, 0x16335ade, 0x27db4043, 0x81ac4bf7,
+        0x77e43b1e, 0xd19330aa, 0xe07b2a37, 0x460c2183, 0x83ab1f0d, 0x25dc14b9, 0x14340e24, 0xb2430590,
+        0x23d5e9b7, 0x85a2e203, 0xb44af89e, 0x123df32a, 0xd79acda4, 0x71edc610, 0x4005dc8d, 0xe672d739,
+        0x103aa7d0, 0xb64dac64, 0x87a5b6f9, 0x21d2bd4d, 0xe47583c3, 0x42028877, 0x73ea92ea, 0xd59d995e,
+        0x8bb64ce5, 0x2dc14751, 0x1c295dcc, 0xba5e5678, 0x7ff968f6, 0xd98e6342, 0xe86679df, 0x4e11726b,
+        0xb8590282, 0x1e2e0936, 0x2fc613ab, 0x89b1181f, 0x4c162691, 0xea612d25, 0xdb8937b8, 0x7dfe3c0c,
+        0xec68d02b, 0x4a1fdb9f, 0x7bf7c102, 0xdd80cab6, 0x1827f438, 0xbe50ff8c, 0x8fb8e511, 0x29cfeea5,
+        0xdf879e4c, 0x79f095f8, 0x48188f65, 0xee6f84d1, 0x2bc8ba5f, 0x8dbfb1eb, 0xbc57ab76, 0x1a20a0c2,
+        0x8816eaf2, 0x2e61e146, 0x1f89fbdb, 0xb9fef06f, 0x7c59cee1, 0xda2ec555, 0xebc6dfc8, 0x4db1d47c,
+        0xbbf9a495, 0x1d8eaf21, 0x2c66b5bc, 0x8a11be08, 0x4fb68086, 0xe9c18b32, 0xd82991af, 0x7e5e9a1b,
+        0xefc8763c, 0x49bf7d88, 0x78576715, 0xde206ca1, 0x1b87522f, 0xbdf0599b, 0x8c184306, 0x2a6f48b2,
+        0xdc27385b, 0x7a5033ef, 0x4bb82972, 0xedcf22c6, 0x28681c48, 0x8e1f17fc, 0xbff70d61, 0x198006d5,
+        0x47abd36e, 0xe1dcd8da, 0xd034c247, 0x7643c9f3, 0xb3e4f77d, 0x1593fcc9, 0x247be654, 0x820cede0,
+        0x74449d09, 0xd23396bd, 0xe3db8c20, 0x45ac8794, 0x800bb91a, 0x267cb2ae, 0x1794a833, 0xb1e3a387,
+        0x20754fa0, 0x86024414, 0xb7ea5e89, 0x119d553d, 0xd43a6bb3, 0x724d6007, 0x43a57a9a, 0xe5d2712e,
+        0x139a01c7, 0xb5ed0a73, 0x840510ee, 0x22721b5a, 0xe7d525d4, 0x41a22e60, 0x704a34fd, 0xd63d3f49,
+        0xcc1d9f8b, 0x6a6a943f, 0x5b828ea2, 0xfdf58516, 0x3852bb98, 0x9e25b02c, 0xafcdaab1, 0x09baa105,
+        0xfff2d1ec, 0x5985da58, 0x686dc0c5, 0xce1acb71, 0x0bbdf5ff, 0xadcafe4b, 0x9c22e4d6, 0x3a55ef62,
+        0xabc30345, 0x0db408f1, 0x3c5c126c, 0x9a2b19d8, 0x5f8c2756, 0xf9fb2ce2, 0xc813367f, 0x6e643dcb,
+        0x982c4d22, 0x3e5b4696, 0x0fb35c0b, 0xa9c457bf, 0x6c636931, 0xca146285, 0xfbfc7818, 0x5d8b73ac,
+        0x03a0a617, 0xa5d7ada3, 0x943fb73e, 0x3248bc8a, 0xf7ef8204, 0x519889b0, 0x6070932d, 0xc6079899,
+        0x304fe870, 0x9638e3c4, 0xa7d0f959, 0x01a7f2ed, 0xc400cc63, 0x6277c7d7, 0x539fdd4a, 0xf5e8d6fe,
+        0x647e3ad9, 0xc209316d, 0xf3e12bf0, 0x55962044, 0x90311eca, 0x3646157e, 0x07ae0fe3, 0xa1d90457,
+        0x579174be, 0xf1e67f0a, 0xc00e6597, 0x66796e23, 0xa3de50ad, 0x05a95b19, 0x34414184, 0x92364a30
+    },
+    {
+        0x00000000, 0xccaa009e, 0x4225077d, 0x8e8f07e3, 0x844a0efa, 0x48e00e64, 0xc66f0987, 0x0ac50919,
+        0xd3e51bb5, 0x1f4f1b2b, 0x91c01cc8, 0x5d6a1c56, 0x57af154f, 0x9b0515d1, 0x158a1232, 0xd92012ac,
+        0x7cbb312b, 0xb01131b5, 0x3e9e3656, 0xf23436c8, 0xf8f13fd1, 0x345b3f4f, 0xbad438ac, 0x767e3832,
+        0xaf5e2a9e, 0x63f42a00, 0xed7b2de3, 0x21d12d7d, 0x2b142464, 0xe7be24fa, 0x69312319, 0xa59b2387,
+        0xf9766256, 0x35dc62c8, 0xbb53652b, 0x77f965b5, 0x7d3c6cac, 0xb1966c32, 0x3f196bd1, 0xf3b36b4f,
+        0x2a9379e3, 0xe639797d, 0x68b67e9e, 0xa41c7e00, 0xaed97719, 0x62737787, 0xecfc7064, 0x205670fa,
+        0x85cd537d, 0x496753e3, 0xc7e85400, 0x0b42549e, 0x01875d87, 0xcd2d5d19, 0x43a25afa, 0x8f085a64,
+        0x562848c8, 0x9a824856, 0x140d4fb5, 0xd8a74f2b, 0xd2624632, 0x1ec846ac, 0x9047414f, 0x5ced41d1,
+        0x299dc2ed, 0xe537c273, 0x6bb8c590, 0xa712c50e, 0xadd7cc17, 0x617dcc89, 0xeff2cb6a, 0x2358cbf4,
+        0xfa78d958, 0x36d2d9c6, 0xb85dde25, 0x74f7debb, 0x7e32d7a2, 0xb298d73c, 0x3c17d0df, 0xf0bdd041,
+        0x5526f3c6, 0x998cf358, 0x1703f4bb, 0xdba9f425, 0xd16cfd3c, 0x1dc6fda2, 0x9349fa41, 0x5fe3fadf,
+        0x86c3e873, 0x4a69e8ed, 0xc4e6ef0e, 0x084cef90, 0x0289e689, 0xce23e617, 0x40ace1f4, 0x8c06e16a,
+        0xd0eba0bb, 0x1c41a025, 0x92cea7c6, 0x5e64a758, 0x54a1ae41, 0x980baedf, 0x1684a93c, 0xda2ea9a2,
+        0x030ebb0e, 0xcfa4bb90, 0x412bbc73, 0x8d81bced, 0x8744b5f4, 0x4beeb56a, 0xc561b289, 0x09cbb217,
+        0xac509190, 0x60fa910e, 0xee7596ed, 0x22df9673, 0x281a9f6a, 0xe4b09ff4, 0x6a3f9817, 0xa6959889,
+        0x7fb58a25, 0xb31f8abb, 0x3d908d58, 0xf13a8dc6, 0xfbff84df, 0x37558441, 0xb9da83a2, 0x7570833c,
+        0x533b85da, 0x9f918544, 0x111e82a7, 0xddb48239, 0xd7718b20, 0x1bdb8bbe, 0x95548c5d, 0x59fe8cc3,
+        0x80de9e6f, 0x4c749ef1, 0xc2fb9912, 0x0e51998c, 0x04949095, 0xc83e900b, 0x46b197e8, 0x8a1b9776,
+        0x2f80b4f1, 0xe32ab46f, 0x6da5b38c, 0xa10fb312, 0xabcaba0b, 0x6760ba95, 0xe9efbd76, 0x2545bde8,
+        0xfc65af44, 0x30cfafda, 0xbe40a839, 0x72eaa8a7, 0x782fa1be, 0xb485a120, 0x3a0aa6c3, 0xf6a0a65d,
+        0xaa4de78c, 0x66e7e712, 0xe868e0f1, 0x24c2e06f, 0x2e07e976, 0xe2ade9e8, 0x6c22ee0b, 0xa088ee95,
+        0x79a8fc39, 0xb502fca7, 0x3b8dfb44, 0xf727fbda, 0xfde2f2c3, 0x3148f25d, 0xbfc7f5be, 0x736df520,
+        0xd6f6d6a7, 0x1a5cd639, 0x94d3d1da, 0x5879d144, 0x52bcd85d, 0x9e16d8c3, 0x1099df20, 0xdc33dfbe,
+        0x0513cd12, 0xc9b9cd8c, 0x4736ca6f, 0x8b9ccaf1, 0x8159c3e8, 0x4df3c376, 0xc37cc495, 0x0fd6c40b,
+        0x7aa64737, 0xb60c47a9, 0x3883404a, 0xf42940d4, 0xfeec49cd, 0x32464953, 0xbcc94eb0, 0x70634e2e,
+        0xa9435c82, 0x65e95c1c, 0xeb665bff, 0x27cc5b61, 0x2d095278, 0xe1a352e6, 0x6f2c5505, 0xa386559b,
+        0x061d761c, 0xcab77682, 0x44387161, 0x889271ff, 0x825778e6, 0x4efd7878, 0xc0727f9b, 0x0cd87f05,
+        0xd5f86da9, 0x19526d37, 0x97dd6ad4, 0x5b776a4a, 0x51b26353, 0x9d1863cd, 0x1397642e, 0xdf3d64b0,
+        0x83d02561, 0x4f7a25ff, 0xc1f5221c, 0x0d5f2282, 0x079a2b9b, 0xcb302b05, 0x45bf2ce6, 0x89152c78,
+        0x50353ed4, 0x9c9f3e4a, 0x121039a9, 0xdeba3937, 0xd47f302e, 0x18d530b0, 0x965a3753, 0x5af037cd,
+        0xff6b144a, 0x33c114d4, 0xbd4e1337, 0x71e413a9, 0x7b211ab0, 0xb78b1a2e, 0x39041dcd, 0xf5ae1d53,
+        0x2c8e0fff, 0xe0240f61, 0x6eab0882, 0xa201081c, 0xa8c40105, 0x646e019b, 0xeae10678, 0x264b06e6
+    },
+    {
+        0x00000000, 0x177b1443, 0x2ef62886, 0x398d3cc5, 0x5dec510c, 0x4a97454f, 0x731a798a, 0x64616dc9,
+        0xbbd8a218, 0xaca3b65b, 0x952e8a9e, 0x82559edd, 0xe634f314, 0xf14fe757, 0xc8c2db92, 0xdfb9cfd1,
+        0xacc04271, 0xbbbb5632, 0x82366af7, 0x954d7eb4, 0xf12c137d, 0xe657073e, 0xdfda3bfb, 0xc8a12fb8,
+        0x1718e069, 0x0063f42a, 0x39eec8ef, 0x2e95dcac, 0x4af4b165, 0x5d8fa526, 0x640299e3, 0x73798da0,
+        0x82f182a3, 0x958a96e0, 0xac07aa25, 0xbb7cbe66, 0xdf1dd3af, 0xc866c7ec, 0xf1ebfb29, 0xe690ef6a,
+        0x392920bb, 0x2e5234f8, 0x17df083d, 0x00a41c7e, 0x64c571b7, 0x73be65f4, 0x4a335931, 0x5d484d72,
+        0x2e31c0d2, 0x394ad491, 0x00c7e854, 0x17bcfc17, 0x73dd91de, 0x64a6859d, 0x5d2bb958, 0x4a50ad1b,
+        0x95e962ca, 0x82927689, 0xbb1f4a4c, 0xac645e0f, 0xc80533c6, 0xdf7e2785, 0xe6f31b40, 0xf1880f03,
+        0xde920307, 0xc9e91744, 0xf0642b81, 0xe71f3fc2, 0x837e520b, 0x94054648, 0xad887a8d, 0xbaf36ece,
+        0x654aa11f, 0x7231b55c, 0x4bbc8999, 0x5cc79dda, 0x38a6f013, 0x2fdde450, 0x1650d895, 0x012bccd6,
+        0x72524176, 0x65295535, 0x5ca469f0, 0x4bdf7db3, 0x2fbe107a, 0x38c50439, 0x014838fc, 0x16332cbf,
+        0xc98ae36e, 0xdef1f72d, 0xe77ccbe8, 0xf007dfab, 0x9466b262, 0x831da621, 0xba909ae4, 0xadeb8ea7,
+        0x5c6381a4, 0x4b1895e7, 0x7295a922, 0x65eebd61, 0x018fd0a8, 0x16f4c4eb, 0x2f79f82e, 0x3802ec6d,
+        0xe7bb23bc, 0xf0c037ff, 0xc94d0b3a, 0xde361f79, 0xba5772b0, 0xad2c66f3, 0x94a15a36, 0x83da4e75,
+        0xf0a3c3d5, 0xe7d8d796, 0xde55eb53, 0xc92eff10, 0xad4f92d9, 0xba34869a, 0x83b9ba5f, 0x94c2ae1c,
+        0x4b7b61cd, 0x5c00758e, 0x658d494b, 0x72f65d08, 0x169730c1, 0x01ec2482, 0x38611847, 0x2f1a0c04,
+        0x6655004f, 0x712e140c, 0x48a328c9, 0x5fd83c8a, 0x3bb95143, 0x2cc24500, 0x154f79c5, 0x02346d86,
+        0xdd8da257, 0xcaf6b614, 0xf37b8ad1, 0xe4009e92, 0x8061f35b, 0x971ae718, 0xae97dbdd, 0xb9eccf9e,
+        0xca95423e, 0xddee567d, 0xe4636ab8, 0xf3187efb, 0x97791332, 0x80020771, 0xb98f3bb4, 0xaef42ff7,
+        0x714de026, 0x6636f465, 0x5fbbc8a0, 0x48c0dce3, 0x2ca1b12a, 0x3bdaa569, 0x025799ac, 0x152c8def,
+        0xe4a482ec, 0xf3df96af, 0xca52aa6a, 0xdd29be29, 0xb948d3e0, 0xae33c7a3, 0x97befb66, 0x80c5ef25,
+        0x5f7c20f4, 0x480734b7, 0x718a0872, 0x66f11c31, 0x029071f8, 0x15eb65bb, 0x2c66597e, 0x3b1d4d3d,
+        0x4864c09d, 0x5f1fd4de, 0x6692e81b, 0x71e9fc58, 0x15889191, 0x02f385d2, 0x3b7eb917, 0x2c05ad54,
+        0xf3bc6285, 0xe4c776c6, 0xdd4a4a03, 0xca315e40, 0xae503389, 0xb92b27ca, 0x80a61b0f, 0x97dd0f4c,
+        0xb8c70348, 0xafbc170b, 0x96312bce, 0x814a3f8d, 0xe52b5244, 0xf2504607, 0xcbdd7ac2, 0xdca66e81,
+        0x031fa150, 0x1464b513, 0x2de989d6, 0x3a929d95, 0x5ef3f05c, 0x4988e41f, 0x7005d8da, 0x677ecc99,
+        0x14074139, 0x037c557a, 0x3af169bf, 0x2d8a7dfc, 0x49eb1035, 0x5e900476, 0x671d38b3, 0x70662cf0,
+        0xafdfe321, 0xb8a4f762, 0x8129cba7, 0x9652dfe4, 0xf233b22d, 0xe548a66e, 0xdcc59aab, 0xcbbe8ee8,
+        0x3a3681eb, 0x2d4d95a8, 0x14c0a96d, 0x03bbbd2e, 0x67dad0e7, 0x70a1c4a4, 0x492cf861, 0x5e57ec22,
+        0x81ee23f3, 0x969537b0, 0xaf180b75, 0xb8631f36, 0xdc0272ff, 0xcb7966bc, 0xf2f45a79, 0xe58f4e3a,
+        0x96f6c39a, 0x818dd7d9, 0xb800eb1c, 0xaf7bff5f, 0xcb1a9296, 0xdc6186d5, 0xe5ecba10, 0xf297ae53,
+        0x2d2e6182, 0x3a5575c1, 0x03d84904, 0x14a35d47, 0x70c2308e, 0x67b924cd, 0x5e341808, 0x494f0c4b
+    },
+    {
+        0x00000000, 0xefc26b3e, 0x04f5d03d, 0xeb37bb03, 0x09eba07a, 0xe629cb44, 0x0d1e7047, 0xe2dc1b79,
+        0x13d740f4, 0xfc152bca, 0x172290c9, 0xf8e0fbf7, 0x1a3ce08e, 0xf5fe8bb0, 0x1ec930b3, 0xf10b5b8d,
+        0x27ae81e8, 0xc86cead6, 0x235b51d5, 0xcc993aeb, 0x2e452192, 0xc1874aac, 0x2ab0f1af, 0xc5729a91,
+        0x3479c11c, 0xdbbbaa22, 0x308c1121, 0xdf4e7a1f, 0x3d926166, 0xd2500a58, 0x3967b15b, 0xd6a5da65,
+        0x4f5d03d0, 0xa09f68ee, 0x4ba8d3ed, 0xa46ab8d3, 0x46b6a3aa, 0xa974c894, 0x42437397, 0xad8118a9,
+        0x5c8a4324, 0xb348281a, 0x587f9319, 0xb7bdf827, 0x5561e35e, 0xbaa38860, 0x51943363, 0xbe56585d,
+        0x68f38238, 0x8731e906, 0x6c065205, 0x83c4393b, 0x61182242, 0x8eda497c, 0x65edf27f, 0x8a2f9941,
+        0x7b24c2cc, 0x94e6a9f2, 0x7fd112f1, 0x901379cf, 0x72cf62b6, 0x9d0d0988, 0x763ab28b, 0x99f8d9b5,
+        0x9eba07a0, 0x71786c9e, 0x9a4fd79d, 0x758dbca3, 0x9751a7da, 0x7893cce4, 0x93a477e7, 0x7c661cd9,
+        0x8d6d4754, 0x62af2c6a, 0x89989769, 0x665afc57, 0x8486e72e, 0x6b448c10, 0x80733713, 0x6fb15c2d,
+        0xb9148648, 0x56d6ed76, 0xbde15675, 0x52233d4b, 0xb0ff2632, 0x5f3d4d0c, 0xb40af60f, 0x5bc89d31,
+        0xaac3c6bc, 0x4501ad82, 0xae361681, 0x41f47dbf, 0xa32866c6, 0x4cea0df8, 0xa7ddb6fb, 0x481fddc5,
+        0xd1e70470, 0x3e256f4e, 0xd512d44d, 0x3ad0bf73, 0xd80ca40a, 0x37cecf34, 0xdcf97437, 0x333b1f09,
+        0xc2304484, 0x2df22fba, 0xc6c594b9, 0x2907ff87, 0xcbdbe4fe, 0x24198fc0, 0xcf2e34c3, 0x20ec5ffd,
+        0xf6498598, 0x198beea6, 0xf2bc55a5, 0x1d7e3e9b, 0xffa225e2, 0x10604edc, 0xfb57f5df, 0x14959ee1,
+        0xe59ec56c, 0x0a5cae52, 0xe16b1551, 0x0ea97e6f, 0xec756516, 0x03b70e28, 0xe880b52b, 0x0742de15,
+        0xe6050901, 0x09c7623f, 0xe2f0d93c, 0x0d32b202, 0xefeea97b, 0x002cc245, 0xeb1b7946, 0x04d91278,
+        0xf5d249f5, 0x1a1022cb, 0xf12799c8, 0x1ee5f2f6, 0xfc39e98f, 0x13fb82b1, 0xf8cc39b2, 0x170e528c,
+        0xc1ab88e9, 0x2e69e3d7, 0xc55e58d4, 0x2a9c33ea, 0xc8402893, 0x278243ad, 0xccb5f8ae, 0x23779390,
+        0xd27cc81d, 0x3dbea323, 0xd6891820, 0x394b731e, 0xdb976867, 0x34550359, 0xdf62b85a, 0x30a0d364,
+        0xa9580ad1, 0x469a61ef, 0xadaddaec, 0x426fb1d2, 0xa0b3aaab, 0x4f71c195, 0xa4467a96, 0x4b8411a8,
+        0xba8f4a25, 0x554d211b, 0xbe7a9a18, 0x51b8f126, 0xb364ea5f, 0x5ca68161, 0xb7913a62, 0x5853515c,
+        0x8ef68b39, 0x6134e007, 0x8a035b04, 0x65c1303a, 0x871d2b43, 0x68df407d, 0x83e8fb7e, 0x6c2a9040,
+        0x9d21cbcd, 0x72e3a0f3, 0x99d41bf0, 0x761670ce, 0x94ca6bb7, 0x7b080089, 0x903fbb8a, 0x7ffdd0b4,
+        0x78bf0ea1, 0x977d659f, 0x7c4ade9c, 0x9388b5a2, 0x7154aedb, 0x9e96c5e5, 0x75a17ee6, 0x9a6315d8,
+        0x6b684e55, 0x84aa256b, 0x6f9d9e68, 0x805ff556, 0x6283ee2f, 0x8d418511, 0x66763e12, 0x89b4552c,
+        0x5f118f49, 0xb0d3e477, 0x5be45f74, 0xb426344a, 0x56fa2f33, 0xb938440d, 0x520fff0e, 0xbdcd9430,
+        0x4cc6cfbd, 0xa304a483, 0x48331f80, 0xa7f174be, 0x452d6fc7, 0xaaef04f9, 0x41d8bffa, 0xae1ad4c4,
+        0x37e20d71, 0xd820664f, 0x3317dd4c, 0xdcd5b672, 0x3e09ad0b, 0xd1cbc635, 0x3afc7d36, 0xd53e1608,
+        0x24354d85, 0xcbf726bb, 0x20c09db8, 0xcf02f686, 0x2ddeedff, 0xc21c86c1, 0x292b3dc2, 0xc6e956fc,
+        0x104c8c99, 0xff8ee7a7, 0x14b95ca4, 0xfb7b379a, 0x19a72ce3, 0xf66547dd, 0x1d52fcde, 0xf29097e0,
+        0x039bcc6d, 0xec59a753, 0x076e1c50, 0xe8ac776e, 0x0a706c17, 0xe5b20729, 0x0e85bc2a, 0xe147d714
+    },
+    {
+        0x00000000, 0xc18edfc0, 0x586cb9c1, 0x99e26601, 0xb0d97382, 0x7157ac42, 0xe8b5ca43, 0x293b1583,
+        0xbac3e145, 0x7b4d3e85, 0xe2af5884, 0x23218744, 0x0a1a92c7, 0xcb944d07, 0x52762b06, 0x93f8f4c6,
+        0xaef6c4cb, 0x6f781b0b, 0xf69a7d0a, 0x3714a2ca, 0x1e2fb749, 0xdfa16889, 0x46430e88, 0x87cdd148,
+        0x1435258e, 0xd5bbfa4e, 0x4c599c4f, 0x8dd7438f, 0xa4ec560c, 0x656289cc, 0xfc80efcd, 0x3d0e300d,
+        0x869c8fd7, 0x47125017, 0xdef03616, 0x1f7ee9d6, 0x3645fc55, 0xf7cb2395, 0x6e294594, 0xafa79a54,
+        0x3c5f6e92, 0xfdd1b152, 0x6433d753, 0xa5bd0893, 0x8c861d10, 0x4d08c2d0, 0xd4eaa4d1, 0x15647b11,
+        0x286a4b1c, 0xe9e494dc, 0x7006f2dd, 0xb1882d1d, 0x98b3389e, 0x593de75e, 0xc0df815f, 0x01515e9f,
+        0x92a9aa59, 0x53277599, 0xcac51398, 0x0b4bcc58, 0x2270d9db, 0xe3fe061b, 0x7a1c601a, 0xbb92bfda,
+        0xd64819ef, 0x17c6c62f, 0x8e24a02e, 0x4faa7fee, 0x66916a6d, 0xa71fb5ad, 0x3efdd3ac, 0xff730c6c,
+        0x6c8bf8aa, 0xad05276a, 0x34e7416b, 0xf5699eab, 0xdc528b28, 0x1ddc54e8, 0x843e32e9, 0x45b0ed29,
+        0x78bedd24, 0xb93002e4, 0x20d264e5, 0xe15cbb25, 0xc867aea6, 0x09e97166, 0x900b1767, 0x5185c8a7,
+        0xc27d3c61, 0x03f3e3a1, 0x9a1185a0, 0x5b9f5a60, 0x72a44fe3, 0xb32a9023, 0x2ac8f622, 0xeb4629e2,
+        0x50d49638, 0x915a49f8, 0x08b82ff9, 0xc936f039, 0xe00de5ba, 0x21833a7a, 0xb8615c7b, 0x79ef83bb,
+        0xea17777d, 0x2b99a8bd, 0xb27bcebc, 0x73f5117c, 0x5ace04ff, 0x9b40db3f, 0x02a2bd3e, 0xc32c62fe,
+        0xfe2252f3, 0x3fac8d33, 0xa64eeb32, 0x67c034f2, 0x4efb2171, 0x8f75feb1, 0x169798b0, 0xd7194770,
+        0x44e1b3b6, 0x856f6c76, 0x1c8d0a77, 0xdd03d5b7, 0xf438c034, 0x35b61ff4, 0xac5479f5, 0x6ddaa635,
+        0x77e1359f, 0xb66fea5f, 0x2f8d8c5e, 0xee03539e, 0xc738461d, 0x06b699dd, 0x9f54ffdc, 0x5eda201c,
+        0xcd22d4da, 0x0cac0b1a, 0x954e6d1b, 0x54c0b2db, 0x7dfba758, 0xbc757898, 0x25971e99, 0xe419c159,
+        0xd917f154, 0x18992e94, 0x817b4895, 0x40f59755, 0x69ce82d6, 0xa8405d16, 0x31a23b17, 0xf02ce4d7,
+        0x63d41011, 0xa25acfd1, 0x3bb8a9d0, 0xfa367610, 0xd30d6393, 0x1283bc53, 0x8b61da52, 0x4aef0592,
+        0xf17dba48, 0x30f36588, 0xa9110389, 0x689fdc49, 0x41a4c9ca, 0x802a160a, 0x19c8700b, 0xd846afcb,
+        0x4bbe5b0d, 0x8a3084cd, 0x13d2e2cc, 0xd25c3d0c, 0xfb67288f, 0x3ae9f74f, 0xa30b914e, 0x62854e8e,
+        0x5f8b7e83, 0x9e05a143, 0x07e7c742, 0xc6691882, 0xef520d01, 0x2edcd2c1, 0xb73eb4c0, 0x76b06b00,
+        0xe5489fc6, 0x24c64006, 0xbd242607, 0x7caaf9c7, 0x5591ec44, 0x941f3384, 0x0dfd5585, 0xcc738a45,
+        0xa1a92c70, 0x6027f3b0, 0xf9c595b1, 0x384b4a71, 0x11705ff2, 0xd0fe8032, 0x491ce633, 0x889239f3,
+        0x1b6acd35, 0xdae412f5, 0x430674f4, 0x8288ab34, 0xabb3beb7, 0x6a3d6177, 0xf3df0776, 0x3251d8b6,
+        0x0f5fe8bb, 0xced1377b, 0x5733517a, 0x96bd8eba, 0xbf869b39, 0x7e0844f9, 0xe7ea22f8, 0x2664fd38,
+        0xb59c09fe, 0x7412d63e, 0xedf0b03f, 0x2c7e6fff, 0x05457a7c, 0xc4cba5bc, 0x5d29c3bd, 0x9ca71c7d,
+        0x2735a3a7, 0xe6bb7c67, 0x7f591a66, 0xbed7c5a6, 0x97ecd025, 0x56620fe5, 0xcf8069e4, 0x0e0eb624,
+        0x9df642e2, 0x5c789d22, 0xc59afb23, 0x041424e3, 0x2d2f3160, 0xeca1eea0, 0x754388a1, 0xb4cd5761,
+        0x89c3676c, 0x484db8ac, 0xd1afdead, 0x1021016d, 0x391a14ee, 0xf894cb2e, 0x6176ad2f, 0xa0f872ef,
+        0x33008629, 0xf28e59e9, 0x6b6c3fe8, 0xaae2e028, 0x83d9f5ab, 0x42572a6b, 0xdbb54c6a, 0x1a3b93aa
+    },
+    {
+        0x00000000, 0x9ba54c6f, 0xec3b9e9f, 0x779ed2f0, 0x03063b7f, 0x98a37710, 0xef3da5e0, 0x7498e98f,
+        0x060c76fe, 0x9da93a91, 0xea37e861, 0x7192a40e, 0x050a4d81, 0x9eaf01ee, 0xe931d31e, 0x72949f71,
+        0x0c18edfc, 0x97bda193, 0xe0237363, 0x7b863f0c, 0x0f1ed683, 0x94bb9aec, 0xe325481c, 0x78800473,
+        0x0a149b02, 0x91b1d76d, 0xe62f059d, 0x7d8a49f2, 0x0912a07d, 0x92b7ec12, 0xe5293ee2, 0x7e8c728d,
+        0x1831dbf8, 0x83949797, 0xf40a4567, 0x6faf0908, 0x1b37e087, 0x8092ace8, 0xf70c7e18, 0x6ca93277,
+        0x1e3dad06, 0x8598e169, 0xf2063399, 0x69a37ff6, 0x1d3b9679, 0x869eda16, 0xf10008e6, 0x6aa54489,
+        0x14293604, 0x8f8c7a6b, 0xf812a89b, 0x63b7e4f4, 0x172f0d7b, 0x8c8a4114, 0xfb1493e4, 0x60b1df8b,
+        0x122540fa, 0x89800c95, 0xfe1ede65, 0x65bb920a, 0x11237b85, 0x8a8637ea, 0xfd18e51a, 0x66bda975,
+        0x3063b7f0, 0xabc6fb9f, 0xdc58296f, 0x47fd6500, 0x33658c8f, 0xa8c0c0e0, 0xdf5e1210, 0x44fb5e7f,
+        0x366fc10e, 0xadca8d61, 0xda545f91, 0x41f113fe, 0x3569fa71, 0xaeccb61e, 0xd95264ee, 0x42f72881,
+        0x3c7b5a0c, 0xa7de1663, 0xd040c493, 0x4be588fc, 0x3f7d6173, 0xa4d82d1c, 0xd346ffec, 0x48e3b383,
+        0x3a772cf2, 0xa1d2609d, 0xd64cb26d, 0x4de9fe02, 0x3971178d, 0xa2d45be2, 0xd54a8912, 0x4eefc57d,
+        0x28526c08, 0xb3f72067, 0xc469f297, 0x5fccbef8, 0x2b545777, 0xb0f11b18, 0xc76fc9e8, 0x5cca8587,
+        0x2e5e1af6, 0xb5fb5699, 0xc2658469, 0x59c0c806, 0x2d582189, 0xb6fd6de6, 0xc163bf16, 0x5ac6f379,
+        0x244a81f4, 0xbfefcd9b, 0xc8711f6b, 0x53d45304, 0x274cba8b, 0xbce9f6e4, 0xcb772414, 0x50d2687b,
+        0x2246f70a, 0xb9e3bb65, 0xce7d6995, 0x55d825fa, 0x2140cc75, 0xbae5801a, 0xcd7b52ea, 0x56de1e85,
+        0x60c76fe0, 0xfb62238f, 0x8cfcf17f, 0x1759bd10, 0x63c1549f, 0xf86418f0, 0x8ffaca00, 0x145f866f,
+        0x66cb191e, 0xfd6e5571, 0x8af08781, 0x1155cbee, 0x65cd2261, 0xfe686e0e, 0x89f6bcfe, 0x1253f091,
+        0x6cdf821c, 0xf77ace73, 0x80e41c83, 0x1b4150ec, 0x6fd9b963, 0xf47cf50c, 0x83e227fc, 0x18476b93,
+        0x6ad3f4e2, 0xf176b88d, 0x86e86a7d, 0x1d4d2612, 0x69d5cf9d, 0xf27083f2, 0x85ee5102, 0x1e4b1d6d,
+        0x78f6b418, 0xe353f877, 0x94cd2a87, 0x0f6866e8, 0x7bf08f67, 0xe055c308, 0x97cb11f8, 0x0c6e5d97,
+        0x7efac2e6, 0xe55f8e89, 0x92c15c79, 0x09641016, 0x7dfcf999, 0xe659b5f6, 0x91c76706, 0x0a622b69,
+        0x74ee59e4, 0xef4b158b, 0x98d5c77b, 0x03708b14, 0x77e8629b, 0xec4d2ef4, 0x9bd3fc04, 0x0076b06b,
+        0x72e22f1a, 0xe9476375, 0x9ed9b185, 0x057cfdea, 0x71e41465, 0xea41580a, 0x9ddf8afa, 0x067ac695,
+        0x50a4d810, 0xcb01947f, 0xbc9f468f, 0x273a0ae0, 0x53a2e36f, 0xc807af00, 0xbf997df0, 0x243c319f,
+        0x56a8aeee, 0xcd0de281, 0xba933071, 0x21367c1e, 0x55ae9591, 0xce0bd9fe, 0xb9950b0e, 0x22304761,
+        0x5cbc35ec, 0xc7197983, 0xb087ab73, 0x2b22e71c, 0x5fba0e93, 0xc41f42fc, 0xb381900c, 0x2824dc63,
+        0x5ab04312, 0xc1150f7d, 0xb68bdd8d, 0x2d2e91e2, 0x59b6786d, 0xc2133402, 0xb58de6f2, 0x2e28aa9d,
+        0x489503e8, 0xd3304f87, 0xa4ae9d77, 0x3f0bd118, 0x4b933897, 0xd03674f8, 0xa7a8a608, 0x3c0dea67,
+        0x4e997516, 0xd53c3979, 0xa2a2eb89, 0x3907a7e6, 0x4d9f4e69, 0xd63a0206, 0xa1a4d0f6, 0x3a019c99,
+        0x448dee14, 0xdf28a27b, 0xa8b6708b, 0x33133ce4, 0x478bd56b, 0xdc2e9904, 0xabb04bf4, 0x3015079b,
+        0x428198ea, 0xd924d485, 0xaeba0675, 0x351f4a1a, 0x4187a395, 0xda22effa, 0xadbc3d0a, 0x36197165
+    },
+    {
+        0x00000000, 0xdd96d985, 0x605cb54b, 0xbdca6cce, 0xc0b96a96, 0x1d2fb313, 0xa0e5dfdd, 0x7d730658,
+        0x5a03d36d, 0x87950ae8, 0x3a5f6626, 0xe7c9bfa3, 0x9abab9fb, 0x472c607e, 0xfae60cb0, 0x2770d535,
+        0xb407a6da, 0x69917f5f, 0xd45b1391, 0x09cdca14, 0x74becc4c, 0xa92815c9, 0x14e27907, 0xc974a082,
+        0xee0475b7, 0x3392ac32, 0x8e58c0fc, 0x53ce1979, 0x2ebd1f21, 0xf32bc6a4, 0x4ee1aa6a, 0x937773ef,
+        0xb37e4bf5, 0x6ee89270, 0xd322febe, 0x0eb4273b, 0x73c72163, 0xae51f8e6, 0x139b9428, 0xce0d4dad,
+        0xe97d9898, 0x34eb411d, 0x89212dd3, 0x54b7f456, 0x29c4f20e, 0xf4522b8b, 0x49984745, 0x940e9ec0,
+        0x0779ed2f, 0xdaef34aa, 0x67255864, 0xbab381e1, 0xc7c087b9, 0x1a565e3c, 0xa79c32f2, 0x7a0aeb77,
+        0x5d7a3e42, 0x80ece7c7, 0x3d268b09, 0xe0b0528c, 0x9dc354d4, 0x40558d51, 0xfd9fe19f, 0x2009381a,
+        0xbd8d91ab, 0x601b482e, 0xddd124e0, 0x0047fd65, 0x7d34fb3d, 0xa0a222b8, 0x1d684e76, 0xc0fe97f3,
+        0xe78e42c6, 0x3a189b43, 0x87d2f78d, 0x5a442e08, 0x27372850, 0xfaa1f1d5, 0x476b9d1b, 0x9afd449e,
+        0x098a3771, 0xd41ceef4, 0x69d6823a, 0xb4405bbf, 0xc9335de7, 0x14a58462, 0xa96fe8ac, 0x74f93129,
+        0x5389e41c, 0x8e1f3d99, 0x33d55157, 0xee4388d2, 0x93308e8a, 0x4ea6570f, 0xf36c3bc1, 0x2efae244,
+        0x0ef3da5e, 0xd36503db, 0x6eaf6f15, 0xb339b690, 0xce4ab0c8, 0x13dc694d, 0xae160583, 0x7380dc06,
+        0x54f00933, 0x8966d0b6, 0x34acbc78, 0xe93a65fd, 0x944963a5, 0x49dfba20, 0xf415d6ee, 0x29830f6b,
+        0xbaf47c84, 0x6762a501, 0xdaa8c9cf, 0x073e104a, 0x7a4d1612, 0xa7dbcf97, 0x1a11a359, 0xc7877adc,
+        0xe0f7afe9, 0x3d61766c, 0x80ab1aa2, 0x5d3dc327, 0x204ec57f, 0xfdd81cfa, 0x40127034, 0x9d84a9b1,
+        0xa06a2517, 0x7dfcfc92, 0xc036905c, 0x1da049d9, 0x60d34f81, 0xbd459604, 0x008ffaca, 0xdd19234f,
+        0xfa69f67a, 0x27ff2fff, 0x9a354331, 0x47a39ab4, 0x3ad09cec, 0xe7464569, 0x5a8c29a7, 0x871af022,
+        0x146d83cd, 0xc9fb5a48, 0x74313686, 0xa9a7ef03, 0xd4d4e95b, 0x094230de, 0xb4885c10, 0x691e8595,
+        0x4e6e50a0, 0x93f88925, 0x2e32e5eb, 0xf3a43c6e, 0x8ed73a36, 0x5341e3b3, 0xee8b8f7d, 0x331d56f8,
+        0x13146ee2, 0xce82b767, 0x7348dba9, 0xaede022c, 0xd3ad0474, 0x0e3bddf1, 0xb3f1b13f, 0x6e6768ba,
+        0x4917bd8f, 0x9481640a, 0x294b08c4, 0xf4ddd141, 0x89aed719, 0x54380e9c, 0xe9f26252, 0x3464bbd7,
+        0xa713c838, 0x7a8511bd, 0xc74f7d73, 0x1ad9a4f6, 0x67aaa2ae, 0xba3c7b2b, 0x07f617e5, 0xda60ce60,
+        0xfd101b55, 0x2086c2d0, 0x9d4cae1e, 0x40da779b, 0x3da971c3, 0xe03fa846, 0x5df5c488, 0x80631d0d,
+        0x1de7b4bc, 0xc0716d39, 0x7dbb01f7, 0xa02dd872, 0xdd5ede2a, 0x00c807af, 0xbd026b61, 0x6094b2e4,
+        0x47e467d1, 0x9a72be54, 0x27b8d29a, 0xfa2e0b1f, 0x875d0d47, 0x5acbd4c2, 0xe701b80c, 0x3a976189,
+        0xa9e01266, 0x7476cbe3, 0xc9bca72d, 0x142a7ea8, 0x695978f0, 0xb4cfa175, 0x0905cdbb, 0xd493143e,
+        0xf3e3c10b, 0x2e75188e, 0x93bf7440, 0x4e29adc5, 0x335aab9d, 0xeecc7218, 0x53061ed6, 0x8e90c753,
+        0xae99ff49, 0x730f26cc, 0xcec54a02, 0x13539387, 0x6e2095df, 0xb3b64c5a, 0x0e7c2094, 0xd3eaf911,
+        0xf49a2c24, 0x290cf5a1, 0x94c6996f, 0x495040ea, 0x342346b2, 0xe9b59f37, 0x547ff3f9, 0x89e92a7c,
+        0x1a9e5993, 0xc7088016, 0x7ac2ecd8, 0xa754355d, 0xda273305, 0x07b1ea80, 0xba7b864e, 0x67ed5fcb,
+        0x409d8afe, 0x9d0b537b, 0x20c13fb5, 0xfd57e630, 0x8024e068, 0x5db239ed, 0xe0785523, 0x3dee8ca6
+    },
+    {
+        0x00000000, 0x9d0fe176, 0xe16ec4ad, 0x7c6125db, 0x19ac8f1b, 0x84a36e6d, 0xf8c24bb6, 0x65cdaac0,
+        0x33591e36, 0xae56ff40, 0xd237da9b, 0x4f383bed, 0x2af5912d, 0xb7fa705b, 0xcb9b5580, 0x5694b4f6,
+        0x66b23c6c, 0xfbbddd1a, 0x87dcf8c1, 0x1ad319b7, 0x7f1eb377, 0xe2115201, 0x9e7077da, 0x037f96ac,
+        0x55eb225a, 0xc8e4c32c, 0xb485e6f7, 0x298a0781, 0x4c47ad41, 0xd1484c37, 0xad2969ec, 0x3026889a,
+        0xcd6478d8, 0x506b99ae, 0x2c0abc75, 0xb1055d03, 0xd4c8f7c3, 0x49c716b5, 0x35a6336e, 0xa8a9d218,
+        0xfe3d66ee, 0x63328798, 0x1f53a243, 0x825c4335, 0xe791e9f5, 0x7a9e0883, 0x06ff2d58, 0x9bf0cc2e,
+        0xabd644b4, 0x36d9a5c2, 0x4ab88019, 0xd7b7616f, 0xb27acbaf, 0x2f752ad9, 0x53140f02, 0xce1bee74,
+        0x988f5a82, 0x0580bbf4, 0x79e19e2f, 0xe4ee7f59, 0x8123d599, 0x1c2c34ef, 0x604d1134, 0xfd42f042,
+        0x41b9f7f1, 0xdcb61687, 0xa0d7335c, 0x3dd8d22a, 0x581578ea, 0xc51a999c, 0xb97bbc47, 0x24745d31,
+        0x72e0e9c7, 0xefef08b1, 0x938e2d6a, 0x0e81cc1c, 0x6b4c66dc, 0xf64387aa, 0x8a22a271, 0x172d4307,
+        0x270bcb9d, 0xba042aeb, 0xc6650f30, 0x5b6aee46, 0x3ea74486, 0xa3a8a5f0, 0xdfc9802b, 0x42c6615d,
+        0x1452d5ab, 0x895d34dd, 0xf53c1106, 0x6833f070, 0x0dfe5ab0, 0x90f1bbc6, 0xec909e1d, 0x719f7f6b,
+        0x8cdd8f29, 0x11d26e5f, 0x6db34b84, 0xf0bcaaf2, 0x95710032, 0x087ee144, 0x741fc49f, 0xe91025e9,
+        0xbf84911f, 0x228b7069, 0x5eea55b2, 0xc3e5b4c4, 0xa6281e04, 0x3b27ff72, 0x4746daa9, 0xda493bdf,
+        0xea6fb345, 0x77605233, 0x0b0177e8, 0x960e969e, 0xf3c33c5e, 0x6eccdd28, 0x12adf8f3, 0x8fa21985,
+        0xd936ad73, 0x44394c05, 0x385869de, 0xa55788a8, 0xc09a2268, 0x5d95c31e, 0x21f4e6c5, 0xbcfb07b3,
+        0x8373efe2, 0x1e7c0e94, 0x621d2b4f, 0xff12ca39, 0x9adf60f9, 0x07d0818f, 0x7bb1a454, 0xe6be4522,
+        0xb02af1d4, 0x2d2510a2, 0x51443579, 0xcc4bd40f, 0xa9867ecf, 0x34899fb9, 0x48e8ba62, 0xd5e75b14,
+        0xe5c1d38e, 0x78ce32f8, 0x04af1723, 0x99a0f655, 0xfc6d5c95, 0x6162bde3, 0x1d039838, 0x800c794e,
+        0xd698cdb8, 0x4b972cce, 0x37f60915, 0xaaf9e863, 0xcf3442a3, 0x523ba3d5, 0x2e5a860e, 0xb3556778,
+        0x4e17973a, 0xd318764c, 0xaf795397, 0x3276b2e1, 0x57bb1821, 0xcab4f957, 0xb6d5dc8c, 0x2bda3dfa,
+        0x7d4e890c, 0xe041687a, 0x9c204da1, 0x012facd7, 0x64e20617, 0xf9ede761, 0x858cc2ba, 0x188323cc,
+        0x28a5ab56, 0xb5aa4a20, 0xc9cb6ffb, 0x54c48e8d, 0x3109244d, 0xac06c53b, 0xd067e0e0, 0x4d680196,
+        0x1bfcb560, 0x86f35416, 0xfa9271cd, 0x679d90bb, 0x02503a7b, 0x9f5fdb0d, 0xe33efed6, 0x7e311fa0,
+        0xc2ca1813, 0x5fc5f965, 0x23a4dcbe, 0xbeab3dc8, 0xdb669708, 0x4669767e, 0x3a0853a5, 0xa707b2d3,
+        0xf1930625, 0x6c9ce753, 0x10fdc288, 0x8df223fe, 0xe83f893e, 0x75306848, 0x09514d93, 0x945eace5,
+        0xa478247f, 0x3977c509, 0x4516e0d2, 0xd81901a4, 0xbdd4ab64, 0x20db4a12, 0x5cba6fc9, 0xc1b58ebf,
+        0x97213a49, 0x0a2edb3f, 0x764ffee4, 0xeb401f92, 0x8e8db552, 0x13825424, 0x6fe371ff, 0xf2ec9089,
+        0x0fae60cb, 0x92a181bd, 0xeec0a466, 0x73cf4510, 0x1602efd0, 0x8b0d0ea6, 0xf76c2b7d, 0x6a63ca0b,
+        0x3cf77efd, 0xa1f89f8b, 0xdd99ba50, 0x40965b26, 0x255bf1e6, 0xb8541090, 0xc435354b, 0x593ad43d,
+        0x691c5ca7, 0xf413bdd1, 0x8872980a, 0x157d797c, 0x70b0d3bc, 0xedbf32ca, 0x91de1711, 0x0cd1f667,
+        0x5a454291, 0xc74aa3e7, 0xbb2b863c, 0x2624674a, 0x43e9cd8a, 0xdee62cfc, 0xa2870927, 0x3f88e851
+    },
+    {
+        0x00000000, 0xb9fbdbe8, 0xa886b191, 0x117d6a79, 0x8a7c6563, 0x3387be8b, 0x22fad4f2, 0x9b010f1a,
+        0xcf89cc87, 0x7672176f, 0x670f7d16, 0xdef4a6fe, 0x45f5a9e4, 0xfc0e720c, 0xed731875, 0x5488c39d,
+        0x44629f4f, 0xfd9944a7, 0xece42ede, 0x551ff536, 0xce1efa2c, 0x77e521c4, 0x66984bbd, 0xdf639055,
+        0x8beb53c8, 0x32108820, 0x236de259, 0x9a9639b1, 0x019736ab, 0xb86ced43, 0xa911873a, 0x10ea5cd2,
+        0x88c53e9e, 0x313ee576, 0x20438f0f, 0x99b854e7, 0x02b95bfd, 0xbb428015, 0xaa3fea6c, 0x13c43184,
+        0x474cf219, 0xfeb729f1, 0xefca4388, 0x56319860, 0xcd30977a, 0x74cb4c92, 0x65b626eb, 0xdc4dfd03,
+        0xcca7a1d1, 0x755c7a39, 0x64211040, 0xdddacba8, 0x46dbc4b2, 0xff201f5a, 0xee5d7523, 0x57a6aecb,
+        0x032e6d56, 0xbad5b6be, 0xaba8dcc7, 0x1253072f, 0x89520835, 0x30a9d3dd, 0x21d4b9a4, 0x982f624c,
+        0xcafb7b7d, 0x7300a095, 0x627dcaec, 0xdb861104, 0x40871e1e, 0xf97cc5f6, 0xe801af8f, 0x51fa7467,
+        0x0572b7fa, 0xbc896c12, 0xadf4066b, 0x140fdd83, 0x8f0ed299, 0x36f50971, 0x27886308, 0x9e73b8e0,
+        0x8e99e432, 0x37623fda, 0x261f55a3, 0x9fe48e4b, 0x04e58151, 0xbd1e5ab9, 0xac6330c0, 0x1598eb28,
+        0x411028b5, 0xf8ebf35d, 0xe9969924, 0x506d42cc, 0xcb6c4dd6, 0x7297963e, 0x63eafc47, 0xda1127af,
+        0x423e45e3, 0xfbc59e0b, 0xeab8f472, 0x53432f9a, 0xc8422080, 0x71b9fb68, 0x60c49111, 0xd93f4af9,
+        0x8db78964, 0x344c528c, 0x253138f5, 0x9ccae31d, 0x07cbec07, 0xbe3037ef, 0xaf4d5d96, 0x16b6867e,
+        0x065cdaac, 0xbfa70144, 0xaeda6b3d, 0x1721b0d5, 0x8c20bfcf, 0x35db6427, 0x24a60e5e, 0x9d5dd5b6,
+        0xc9d5162b, 0x702ecdc3, 0x6153a7ba, 0xd8a87c52, 0x43a97348, 0xfa52a8a0, 0xeb2fc2d9, 0x52d41931,
+        0x4e87f0bb, 0xf77c2b53, 0xe601412a, 0x5ffa9ac2, 0xc4fb95d8, 0x7d004e30, 0x6c7d2449, 0xd586ffa1,
+        0x810e3c3c, 0x38f5e7d4, 0x29888dad, 0x90735645, 0x0b72595f, 0xb28982b7, 0xa3f4e8ce, 0x1a0f3326,
+        0x0ae56ff4, 0xb31eb41c, 0xa263de65, 0x1b98058d, 0x80990a97, 0x3962d17f, 0x281fbb06, 0x91e460ee,
+        0xc56ca373, 0x7c97789b, 0x6dea12e2, 0xd411c90a, 0x4f10c610, 0xf6eb1df8, 0xe7967781, 0x5e6dac69,
+        0xc642ce25, 0x7fb915cd, 0x6ec47fb4, 0xd73fa45c, 0x4c3eab46, 0xf5c570ae, 0xe4b81ad7, 0x5d43c13f,
+        0x09cb02a2, 0xb030d94a, 0xa14db333, 0x18b668db, 0x83b767c1, 0x3a4cbc29, 0x2b31d650, 0x92ca0db8,
+        0x8220516a, 0x3bdb8a82, 0x2aa6e0fb, 0x935d3b13, 0x085c3409, 0xb1a7efe1, 0xa0da8598, 0x19215e70,
+        0x4da99ded, 0xf4524605, 0xe52f2c7c, 0x5cd4f794, 0xc7d5f88e, 0x7e2e2366, 0x6f53491f, 0xd6a892f7,
+        0x847c8bc6, 0x3d87502e, 0x2cfa3a57, 0x9501e1bf, 0x0e00eea5, 0xb7fb354d, 0xa6865f34, 0x1f7d84dc,
+        0x4bf54741, 0xf20e9ca9, 0xe373f6d0, 0x5a882d38, 0xc1892222, 0x7872f9ca, 0x690f93b3, 0xd0f4485b,
+        0xc01e1489, 0x79e5cf61, 0x6898a518, 0xd1637ef0, 0x4a6271ea, 0xf399aa02, 0xe2e4c07b, 0x5b1f1b93,
+        0x0f97d80e, 0xb66c03e6, 0xa711699f, 0x1eeab277, 0x85ebbd6d, 0x3c106685, 0x2d6d0cfc, 0x9496d714,
+        0x0cb9b558, 0xb5426eb0, 0xa43f04c9, 0x1dc4df21, 0x86c5d03b, 0x3f3e0bd3, 0x2e4361aa, 0x97b8ba42,
+        0xc33079df, 0x7acba237, 0x6bb6c84e, 0xd24d13a6, 0x494c1cbc, 0xf0b7c754, 0xe1caad2d, 0x583176c5,
+        0x48db2a17, 0xf120f1ff, 0xe05d9b86, 0x59a6406e, 0xc2a74f74, 0x7b5c949c, 0x6a21fee5, 0xd3da250d,
+        0x8752e690, 0x3ea93d78, 0x2fd45701, 0x962f8ce9, 0x0d2e83f3, 0xb4d5581b, 0xa5a83262, 0x1c53e98a
+    },
+    {
+        0x00000000, 0xae689191, 0x87a02563, 0x29c8b4f2, 0xd4314c87, 0x7a59dd16, 0x539169e4, 0xfdf9f875,
+        0x73139f4f, 0xdd7b0ede, 0xf4b3ba2c, 0x5adb2bbd, 0xa722d3c8, 0x094a4259, 0x2082f6ab, 0x8eea673a,
+        0xe6273e9e, 0x484faf0f, 0x61871bfd, 0xcfef8a6c, 0x32167219, 0x9c7ee388, 0xb5b6577a, 0x1bdec6eb,
+        0x9534a1d1, 0x3b5c3040, 0x129484b2, 0xbcfc1523, 0x4105ed56, 0xef6d7cc7, 0xc6a5c835, 0x68cd59a4,
+        0x173f7b7d, 0xb957eaec, 0x909f5e1e, 0x3ef7cf8f, 0xc30e37fa, 0x6d66a66b, 0x44ae1299, 0xeac68308,
+        0x642ce432, 0xca4475a3, 0xe38cc151, 0x4de450c0, 0xb01da8b5, 0x1e753924, 0x37bd8dd6, 0x99d51c47,
+        0xf11845e3, 0x5f70d472, 0x76b86080, 0xd8d0f111, 0x25290964, 0x8b4198f5, 0xa2892c07, 0x0ce1bd96,
+        0x820bdaac, 0x2c634b3d, 0x05abffcf, 0xabc36e5e, 0x563a962b, 0xf85207ba, 0xd19ab348, 0x7ff222d9,
+        0x2e7ef6fa, 0x8016676b, 0xa9ded399, 0x07b64208, 0xfa4fba7d, 0x54272bec, 0x7def9f1e, 0xd3870e8f,
+        0x5d6d69b5, 0xf305f824, 0xdacd4cd6, 0x74a5dd47, 0x895c2532, 0x2734b4a3, 0x0efc0051, 0xa09491c0,
+        0xc859c864, 0x663159f5, 0x4ff9ed07, 0xe1917c96, 0x1c6884e3, 0xb2001572, 0x9bc8a180, 0x35a03011,
+        0xbb4a572b, 0x1522c6ba, 0x3cea7248, 0x9282e3d9, 0x6f7b1bac, 0xc1138a3d, 0xe8db3ecf, 0x46b3af5e,
+        0x39418d87, 0x97291c16, 0xbee1a8e4, 0x10893975, 0xed70c100, 0x43185091, 0x6ad0e463, 0xc4b875f2,
+        0x4a5212c8, 0xe43a8359, 0xcdf237ab, 0x639aa63a, 0x9e635e4f, 0x300bcfde, 0x19c37b2c, 0xb7abeabd,
+        0xdf66b319, 0x710e2288, 0x58c6967a, 0xf6ae07eb, 0x0b57ff9e, 0xa53f6e0f, 0x8cf7dafd, 0x229f4b6c,
+        0xac752c56, 0x021dbdc7, 0x2bd50935, 0x85bd98a4, 0x784460d1, 0xd62cf140, 0xffe445b2, 0x518cd423,
+        0x5cfdedf4, 0xf2957c65, 0xdb5dc897, 0x75355906, 0x88cca173, 0x26a430e2, 0x0f6c8410, 0xa1041581,
+        0x2fee72bb, 0x8186e32a, 0xa84e57d8, 0x0626c649, 0xfbdf3e3c, 0x55b7afad, 0x7c7f1b5f, 0xd2178ace,
+        0xbadad36a, 0x14b242fb, 0x3d7af609, 0x93126798, 0x6eeb9fed, 0xc0830e7c, 0xe94bba8e, 0x47232b1f,
+        0xc9c94c25, 0x67a1ddb4, 0x4e696946, 0xe001f8d7, 0x1df800a2, 0xb3909133, 0x9a5825c1, 0x3430b450,
+        0x4bc29689, 0xe5aa0718, 0xcc62b3ea, 0x620a227b, 0x9ff3da0e, 0x319b4b9f, 0x1853ff6d, 0xb63b6efc,
+        0x38d109c6, 0x96b99857, 0xbf712ca5, 0x1119bd34, 0xece04541, 0x4288d4d0, 0x6b406022, 0xc528f1b3,
+        0xade5a817, 0x038d3986, 0x2a458d74, 0x842d1ce5, 0x79d4e490, 0xd7bc7501, 0xfe74c1f3, 0x501c5062,
+        0xdef63758, 0x709ea6c9, 0x5956123b, 0xf73e83aa, 0x0ac77bdf, 0xa4afea4e, 0x8d675ebc, 0x230fcf2d,
+        0x72831b0e, 0xdceb8a9f, 0xf5233e6d, 0x5b4baffc, 0xa6b25789, 0x08dac618, 0x211272ea, 0x8f7ae37b,
+        0x01908441, 0xaff815d0, 0x8630a122, 0x285830b3, 0xd5a1c8c6, 0x7bc95957, 0x5201eda5, 0xfc697c34,
+        0x94a42590, 0x3accb401, 0x130400f3, 0xbd6c9162, 0x40956917, 0xeefdf886, 0xc7354c74, 0x695ddde5,
+        0xe7b7badf, 0x49df2b4e, 0x60179fbc, 0xce7f0e2d, 0x3386f658, 0x9dee67c9, 0xb426d33b, 0x1a4e42aa,
+        0x65bc6073, 0xcbd4f1e2, 0xe21c4510, 0x4c74d481, 0xb18d2cf4, 0x1fe5bd65, 0x362d0997, 0x98459806,
+        0x16afff3c, 0xb8c76ead, 0x910fda5f, 0x3f674bce, 0xc29eb3bb, 0x6cf6222a, 0x453e96d8, 0xeb560749,
+        0x839b5eed, 0x2df3cf7c, 0x043b7b8e, 0xaa53ea1f, 0x57aa126a, 0xf9c283fb, 0xd00a3709, 0x7e62a698,
+        0xf088c1a2, 0x5ee05033, 0x7728e4c1, 0xd9407550, 0x24b98d25, 0x8ad11cb4, 0xa319a846, 0x0d7139d7
+    }
+};
+
+static uint32_t crc32_slice16(uint32_t crc, const uint8_t *p, size_t len) {
+    while (len >= 16) {
+        uint32_t a = crc ^ read_u32_le(p), b = read_u32_le(p + 4);
+        uint32_t c = read_u32_le(p + 8), d = read_u32_le(p + 12);
+        crc = pas_zip__crc_table[15][a & 0xFF] ^ pas_zip__crc_table[14][(a >> 8) & 0xFF] ^
+              pas_zip__crc_table[13][(a >> 16) & 0xFF] ^ pas_zip__crc_table[12][a >> 24] ^
+              pas_zip__crc_table[11][b & 0xFF] ^ pas_zip__crc_table[10][(b >> 8) & 0xFF] ^
+              pas_zip__crc_table[9][(b >> 16) & 0xFF] ^ pas_zip__crc_table[8][b >> 24] ^
+              pas_zip__crc_table[7][c & 0xFF] ^ pas_zip__crc_table[6][(c >> 8) & 0xFF] ^
+              pas_zip__crc_table[5][(c >> 16) & 0xFF] ^ pas_zip__crc_table[4][c >> 24] ^
+              pas_zip__crc_table[3][d & 0xFF] ^ pas_zip__crc_table[2][(d >> 8) & 0xFF] ^
+              pas_zip__crc_table[1][(d >> 16) & 0xFF] ^ pas_zip__crc_table[0][d >> 24];
+        p += 16;
+        len -= 16;
+    }
+    while (len--) crc = (crc >> 8) ^ pas_zip__crc_table[0][(crc ^ *p++) & 0xFF];
+    return crc;
+}
+
+#if !defined(PAS_ZIP_NO_SIMD) && (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define PAS_ZIP_CRC_PCLMUL 1
+#include <cpuid.h>
+#include <immintrin.h>
+#define PAS_ZIP_TARGET_PCLMUL __attribute__((target("pclmul,sse4.1")))
+static int crc32_cpu_has_pclmul(void) {
+    unsigned a, b, c, d;
+    if (!__get_cpuid(1, &a, &b, &c, &d)) return 0;
+    return (c & (1u << 1)) && (c & (1u << 19)); /* PCLMULQDQ, SSE4.1 */
+}
+#elif !defined(PAS_ZIP_NO_SIMD) && (defined(_M_X64) || defined(_M_IX86)) && defined(_MSC_VER)
+#define PAS_ZIP_CRC_PCLMUL 1
+#include <intrin.h>
+#define PAS_ZIP_TARGET_PCLMUL
+static int crc32_cpu_has_pclmul(void) {
+    int r[4];
+    __cpuid(r, 1);
+    return (r[2] & (1 << 1)) && (r[2] & (1 << 19));
+}
+#elif !defined(PAS_ZIP_NO_SIMD) && defined(__ARM_FEATURE_CRC32)
+#define PAS_ZIP_CRC_ARM 1
+#include <arm_acle.h>
+#endif
+
+#ifdef PAS_ZIP_CRC_PCLMUL
+/* len >= 64 and a multiple of 16. Folds four 128-bit lanes, then one, then Barrett-reduces. */
+PAS_ZIP_TARGET_PCLMUL
+static uint32_t crc32_pclmul(uint32_t crc, const uint8_t *p, size_t len) {
+    /* 33-bit folding constants as (low, high) 32-bit halves of each 64-bit lane */
+    static const uint32_t k[4][4] = {
+        { 0x54442bd4u, 1, 0xc6e41596u, 1 },  /* k1, k2: fold by 512 bits */
+        { 0x751997d0u, 1, 0xccaa009eu, 0 },  /* k3, k4: fold by 128 bits */
+        { 0x63cd6124u, 1, 0, 0 },            /* k5: 64 -> 32 */
+        { 0xdb710641u, 1, 0xf7011641u, 1 }   /* P(x), mu: Barrett reduction */
+    };
+    const __m128i k1k2 = _mm_loadu_si128((const __m128i *)k[0]);
+    const __m128i k3k4 = _mm_loadu_si128((const __m128i *)k[1]);
+    const __m128i k5k0 = _mm_loadu_si128((const __m128i *)k[2]);
+    const __m128i poly = _mm_loadu_si128((const __m128i *)k[3]);
+    const __m128i mask32 = _mm_setr_epi32(-1, 0, -1, 0);
+    __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8;
+
+    x1 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)p), _mm_cvtsi32_si128((int)crc));
+    x2 = _mm_loadu_si128((const __m128i *)(p + 16));
+    x3 = _mm_loadu_si128((const __m128i *)(p + 32));
+    x4 = _mm_loadu_si128((const __m128i *)(p + 48));
+    p += 64;
+    len -= 64;
+
+    x0 = k1k2;
+    while (len >= 64) {
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+        x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+        x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((const __m128i *)p));
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128((const __m128i *)(p + 16)));
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128((const __m128i *)(p + 32)));
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128((const __m128i *)(p + 48)));
+        p += 64;
+        len -= 64;
+    }
+
+    /* Fold the four lanes into one */
+    x0 = k3k4;
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, x0, 0x11), x2), x5);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, x0, 0x11), x3), x5);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, x0, 0x11), x4), x5);
+    while (len >= 16) {
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128((const __m128i *)p)), x5);
+        p += 16;
+        len -= 16;
+    }
+
+    /* 128 -> 64 bits */
+    x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, mask32);
+    x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, k5k0, 0x00), x2);
+
+    /* Barrett reduction to 32 bits */
+    x2 = _mm_and_si128(x1, mask32);
+    x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+    x2 = _mm_and_si128(x2, mask32);
+    x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+    return (uint32_t)_mm_extract_epi32(x1, 1);
+}
+
+/* CPU check result cached: 0 unknown, 1 table path, 2 PCLMUL */
+static int pas_zip__crc_mode;
+
+#if defined(__GNUC__)
+#define PAS_ZIP_CRC_MODE_LOAD()    __atomic_load_n(&pas_zip__crc_mode, __ATOMIC_RELAXED)
+#define PAS_ZIP_CRC_MODE_STORE(v)  __atomic_store_n(&pas_zip__crc_mode, (v), __ATOMIC_RELAXED)
+#else
+#define PAS_ZIP_CRC_MODE_LOAD()    (*(volatile int *)&pas_zip__crc_mode)
+#define PAS_ZIP_CRC_MODE_STORE(v)  (*(volatile int *)&pas_zip__crc_mode = (v))
+#endif
+#endif /* PAS_ZIP_CRC_PCLMUL */
+
+uint32_t pas_zip_crc32(uint32_t crc, const void *data, size_t len) {
+    const uint8_t *p = (const uint8_t *)data;
+
+    if (!data) return crc;
+    crc = ~crc;
+#if defined(PAS_ZIP_CRC_PCLMUL)
+    if (len >= 64) {
+        int mode = PAS_ZIP_CRC_MODE_LOAD();
+        if (mode == 0) {
+            mode = crc32_cpu_has_pclmul() ? 2 : 1;
+            PAS_ZIP_CRC_MODE_STORE(mode);
+        }
+        if (mode == 2) {
+            size_t n = len & ~(size_t)15;
+            crc = crc32_pclmul(crc, p, n);
+            p += n;
+            len -= n;
+        }
+    }
+#elif defined(PAS_ZIP_CRC_ARM)
+    while (len >= 8) {
+        uint64_t v;
+        memcpy(&v, p, 8);
+        crc = __crc32d(crc, v);
+        p += 8;
+        len -= 8;
+    }
+    while (len--) crc = __crc32b(crc, *p++);
+#endif
+    crc = crc32_slice16(crc, p, len);
+    return ~crc;
+}
+
+/* x^(2^k) modulo the CRC polynomial, bit-reflected, for k = 0..31 */
+static const uint32_t pas_zip__crc_x2n[32] = {
+    0x40000000, 0x20000000, 0x08000000, 0x00800000, 0x00008000, 0xedb88320, 0xb1e6b092, 0xa06a2517,
+    0xed627dae, 0x88d14467, 0xd7bbfe6a, 0xec447f11, 0x8e7ea170, 0x6427800e, 0x4d47bae0, 0x09fe548f,
+    0x83852d0f, 0x30362f1a, 0x7b5a9cc3, 0x31fec169, 0x9fec022a, 0x6c8dedc4, 0x15d6874d, 0x5fde7a4e,
+    0xbad90e37, 0x2e4e5eef, 0x4eaba214, 0xa8a472c0, 0x429a969e, 0x148d302a, 0xc40ba6d0, 0xc4e22c3c
+};
+
+/* a * b modulo the CRC polynomial (both bit-reflected, x^0 in the top bit). */
+static uint32_t crc32_multmodp(uint32_t a, uint32_t b) {
+    uint32_t m = 0x80000000u, p = 0;
+    for (;;) {
+        if (a & m) {
+            p ^= b;
+            if ((a & (m - 1)) == 0) break;
+        }
+        m >>= 1;
+        b = b & 1 ? (b >> 1) ^ 0xEDB88320u : b >> 1;
+    }
+    return p;
+}
+
+/* Appending len2 zero bytes multiplies the CRC register by x^(8 * len2). */
+uint32_t pas_zip_crc32_combine(uint32_t crc1, uint32_t crc2, uint64_t len2) {
+    uint32_t p = 0x80000000u; /* x^0 */
+    unsigned k = 3;
+    while (len2) {
+        if (len2 & 1) p = crc32_multmodp(pas_zip__crc_x2n[k & 31], p);
+        len2 >>= 1;
+        k++;
+    }
+    return crc32_multmodp(p, crc1) ^ crc2;
+}
+
+static size_t skip_local_header(const uint8_t *data, size_t size, uint64_t offset) {
+    const uint8_t *p;
+    uint16_t fn_len, extra_len;
+
+    if (offset >= size || size - offset < 30) return 0;
+    p = data + (size_t)offset;
+    if (read_u32_le(p) != PAS_ZIP_LFH_SIG) return 0;
+    fn_len = read_u16_le(p + 26);
+    extra_len = read_u16_le(p + 28);
+    return 30 + fn_len + extra_len;
+}
+
+/* Start of the entry's compressed data, after validating its local header; NULL if invalid. */
+static const uint8_t *entry_payload(const pas_zip_file_t *file) {
+    const uint8_t *data = file->zip->data;
+    size_t data_size = file->zip->size;
+    size_t payload_offset;
+    size_t hdr_len = skip_local_header(data, data_size, file->local_header_offset);
+
+    if (hdr_len == 0) return NULL;
+    payload_offset = (size_t)file->local_header_offset + hdr_len;
+    if (payload_offset > data_size || file->compressed_size > data_size - payload_offset) return NULL;
+#ifdef PAS_ZIP_USE_MMAP
+    if (file->zip->mapped) map_will_need(file->zip, payload_offset, file->compressed_size);
+#endif
+    return data + payload_offset;
+}
+
+/* Final step of pas_zip_extract: the optional CRC-32 check over the n bytes written. */
+static size_t extract_check(const pas_zip_file_t *file, const void *buffer, size_t n,
+                            pas_zip_status *status) {
+    if (file->zip->verify_crc && pas_zip_crc32(0, buffer, n) != file->crc32) {
+        if (status) *status = PAS_ZIP_E_CRC;
+        return 0;
+    }
+    if (status) *status = PAS_ZIP_OK;
+    return n;
+}
+
+int pas_zip_get_data_ptr(const pas_zip_file_t *file, const void **ptr, size_t *len, pas_zip_status *status) {
+    const uint8_t *payload;
+
+    if (status) *status = PAS_ZIP_E_INVALID;
+    if (!file || !file->zip || !ptr || !len) return 0;
+    if (file->compression_method != PAS_ZIP_METHOD_STORE) {
+        if (status) *status = PAS_ZIP_E_COMPRESSED;
+        return 0;
+    }
+    if (file->compressed_size != file->uncompressed_size) return 0;
+    payload = entry_payload(file);
+    if (!payload) return 0;
+    if (file->zip->verify_crc && pas_zip_crc32(0, payload, (size_t)file->compressed_size) != file->crc32) {
+        if (status) *status = PAS_ZIP_E_CRC;
+        return 0;
+    }
+    *ptr = payload;
+    *len = (size_t)file->compressed_size;
+    if (status) *status = PAS_ZIP_OK;
+    return 1;
+}
+
+size_t pas_zip_extract(pas_zip_file_t *file, void *buffer, size_t buffer_size, pas_zip_status *status) {
+    const uint8_t *payload;
+
+    if (status) *status = PAS_ZIP_E_INVALID;
+    if (!file || !buffer || !file->zip) return 0;
+
+    payload = entry_payload(file);
+    if (!payload) return 0;
+
+    if (buffer_size < file->uncompressed_size) {
+        if (status) *status = PAS_ZIP_E_NOSPACE;
+        return 0;
+    }
+
+    if (file->compression_method == PAS_ZIP_METHOD_STORE) {
+        memcpy(buffer, payload, (size_t)file->compressed_size);
+        return extract_check(file, buffer, (size_t)file->uncompressed_size, status);
+    }
+
+    if (file->compression_method == PAS_ZIP_METHOD_DEFLATE) {
+#if defined(PAS_ZIP_USE_MINIZ) || defined(PAS_ZIP_USE_ZLIB)
+        unsigned long dest_len = (unsigned long)file->uncompressed_size;
+        int r;
+#if defined(PAS_ZIP_USE_MINIZ)
+        r = mz_uncompress((unsigned char *)buffer, &dest_len,
+                          payload, (mz_ulong)file->compressed_size);
+#else
+        r = uncompress((Bytef *)buffer, &dest_len,
+                       payload, (uLong)file->compressed_size);
+#endif
+        if (r != 0) {
+            if (status) *status = PAS_ZIP_E_ZLIB;
+            return 0;
+        }
+        return extract_check(file, buffer, (size_t)dest_len, status);
+#else
+        pas_zip_inflate_t st;
+        pas_zip_status ist;
+        size_t n = pas_zip_inflate(&st, payload, (size_t)file->compressed_size,
+                                   buffer, (size_t)file->uncompressed_size, &ist);
+        if (ist != PAS_ZIP_OK || n != file->uncompressed_size) {
+            if (status) *status = PAS_ZIP_E_ZLIB;
+            return 0;
+        }
+        return extract_check(file, buffer, n, status);
+#endif
+    }
+
+    if (status) *status = PAS_ZIP_E_INVALID;
+    return 0;
+}
+
+/* ----- Worker threads -----
+   run_workers(fn, arg, count) calls fn(arg, w) for w = 0..count-1, worker 0 on the calling thread.
+   Workers whose thread cannot be created run inline after worker 0, so fn must not rely on
+   workers running concurrently. */
+
+#ifdef PAS_ZIP_USE_THREADS
+typedef struct {
+    void (*fn)(void *arg, int worker);
+    void *arg;
+    int worker;
+} pas_zip__worker_t;
+
+#if defined(_WIN32) || defined(_WIN64)
+static DWORD WINAPI worker_entry(LPVOID p) {
+    pas_zip__worker_t *w = (pas_zip__worker_t *)p;
+    w->fn(w->arg, w->worker);
+    return 0;
+}
+static int thread_start(pas_zip__thread_t *t, pas_zip__worker_t *w) {
+    *t = CreateThread(NULL, 0, worker_entry, w, 0, NULL);
+    return *t != NULL;
+}
+static void thread_join(pas_zip__thread_t t) {
+    WaitForSingleObject(t, INFINITE);
+    CloseHandle(t);
+}
+#else
+static void *worker_entry(void *p) {
+    pas_zip__worker_t *w = (pas_zip__worker_t *)p;
+    w->fn(w->arg, w->worker);
+    return NULL;
+}
+static int thread_start(pas_zip__thread_t *t, pas_zip__worker_t *w) {
+    return pthread_create(t, NULL, worker_entry, w) == 0;
+}
+static void thread_join(pas_zip__thread_t t) {
+    pthread_join(t, NULL);
+}
+#endif
+#endif /* PAS_ZIP_USE_THREADS */
+
+static void run_workers(void (*fn)(void *arg, int worker), void *arg, int count) {
+#ifdef PAS_ZIP_USE_THREADS
+    pas_zip__thread_t threads[PAS_ZIP_MAX_THREADS];
+    pas_zip__worker_t workers[PAS_ZIP_MAX_THREADS];
+    int started[PAS_ZIP_MAX_THREADS];
+    int i;
+
+    if (count > PAS_ZIP_MAX_THREADS) count = PAS_ZIP_MAX_THREADS;
+    for (i = 1; i < count; i++) {
+        workers[i].fn = fn;
+        workers[i].arg = arg;
+        workers[i].worker = i;
+        started[i] = thread_start(&threads[i], &workers[i]);
+    }
+    fn(arg, 0);
+    for (i = 1; i < count; i++) {
+        if (started[i]) thread_join(threads[i]);
+        else fn(arg, i);
+    }
+#else
+    int i;
+    for (i = 0; i < count; i++) fn(arg, i);
+#endif
+}
+
+/* ----- Batch extraction ----- */
+
+typedef struct {
+#ifdef PAS_ZIP_USE_THREADS
+    pas_zip__mutex_t lock;
+#endif
+    size_t head, tail; /* pending entries [head, tail); owner pops head, thieves take from tail */
+} pas_zip__range_t;
+
+typedef struct {
+    const pas_zip_t       *zip;
+    const pas_zip_file_t  *entries;
+    void *const           *out_buffers;
+    const size_t          *buffer_sizes;
+    size_t                *out_sizes;
+    pas_zip_status        *statuses;
+    int                    count;
+    pas_zip__range_t       ranges[PAS_ZIP_MAX_THREADS];
+    size_t                 done[PAS_ZIP_MAX_THREADS]; /* successful extractions per worker */
+} pas_zip__batch_t;
+
+#ifdef PAS_ZIP_USE_THREADS
+#define PAS_ZIP_RANGE_LOCK(r)   PAS_ZIP_MUTEX_LOCK(&(r)->lock)
+#define PAS_ZIP_RANGE_UNLOCK(r) PAS_ZIP_MUTEX_UNLOCK(&(r)->lock)
+#else
+#define PAS_ZIP_RANGE_LOCK(r)   ((void)0)
+#define PAS_ZIP_RANGE_UNLOCK(r) ((void)0)
+#endif
+
+static int batch_next(pas_zip__batch_t *b, int worker, size_t *out_index) {
+    pas_zip__range_t *own = &b->ranges[worker];
+
+    for (;;) {
+        int v, victim = -1;
+        size_t best = 0;
+
+        PAS_ZIP_RANGE_LOCK(own);
+        if (own->head < own->tail) {
+            *out_index = own->head++;
+            PAS_ZIP_RANGE_UNLOCK(own);
+            return 1;
+        }
+        PAS_ZIP_RANGE_UNLOCK(own);
+
+        for (v = 0; v < b->count; v++) {
+            pas_zip__range_t *r = &b->ranges[v];
+            size_t left;
+            if (v == worker) continue;
+            PAS_ZIP_RANGE_LOCK(r);
+            left = r->tail - r->head;
+            PAS_ZIP_RANGE_UNLOCK(r);
+            if (left > best) { best = left; victim = v; }
+        }
+        if (victim < 0) return 0; /* nothing left anywhere: no work is ever added back */
+
+        {
+            pas_zip__range_t *r = &b->ranges[victim];
+            size_t lo = 0, hi = 0;
+            PAS_ZIP_RANGE_LOCK(r);
+            if (r->head < r->tail) {
+                size_t take = (r->tail - r->head + 1) / 2;
+                hi = r->tail;
+                lo = hi - take;
+                r->tail = lo;
+            }
+            PAS_ZIP_RANGE_UNLOCK(r);
+            if (lo == hi) continue; /* lost the race; rescan */
+            PAS_ZIP_RANGE_LOCK(own);
+            own->head = lo;
+            own->tail = hi;
+            PAS_ZIP_RANGE_UNLOCK(own);
+        }
+    }
+}
+
+static void batch_worker(void *arg, int worker) {
+    pas_zip__batch_t *b = (pas_zip__batch_t *)arg;
+    size_t i;
+
+    while (batch_next(b, worker, &i)) {
+        pas_zip_status st = PAS_ZIP_E_INVALID;
+        size_t n = 0;
+        if (b->entries[i].zip == b->zip && b->out_buffers[i])
+            n = pas_zip_extract((pas_zip_file_t *)&b->entries[i], b->out_buffers[i], b->buffer_sizes[i], &st);
+        if (b->statuses) b->statuses[i] = st;
+        if (b->out_sizes) b->out_sizes[i] = n;
+        if (st == PAS_ZIP_OK) b->done[worker]++;
+    }
+}
+
+size_t pas_zip_extract_many(const pas_zip_t *zip, const pas_zip_file_t *entries,
+                            void *const *out_buffers, const size_t *buffer_sizes,
+                            size_t *out_sizes, pas_zip_status *statuses, size_t n, int thread_count) {
+    pas_zip__batch_t b;
+    uint64_t total = 0, share, acc;
+    size_t i, start, ok = 0;
+    int w;
+
+    if (!zip || !entries || !out_buffers || !buffer_sizes || n == 0) return 0;
+    if (thread_count < 1) thread_count = 1;
+    if (thread_count > PAS_ZIP_MAX_THREADS) thread_count = PAS_ZIP_MAX_THREADS;
+    if ((size_t)thread_count > n) thread_count = (int)n;
+
+    b.zip = zip;
+    b.entries = entries;
+    b.out_buffers = out_buffers;
+    b.buffer_sizes = buffer_sizes;
+    b.out_sizes = out_sizes;
+    b.statuses = statuses;
+    b.count = thread_count;
+
+    /* Contiguous ranges of roughly total/thread_count compressed bytes each (+1 per entry so
+       empty entries still count). */
+    for (i = 0; i < n; i++) total += (uint64_t)entries[i].compressed_size + 1;
+    share = total / (uint64_t)thread_count + 1;
+    start = 0;
+    acc = 0;
+    w = 0;
+    for (i = 0; i < n && w < thread_count - 1; i++) {
+        acc += (uint64_t)entries[i].compressed_size + 1;
+        if (acc >= share * (uint64_t)(w + 1)) {
+            b.ranges[w].head = start;
+            b.ranges[w].tail = i + 1;
+            start = i + 1;
+            w++;
+        }
+    }
+    for (; w < thread_count; w++) {
+        b.ranges[w].head = start;
+        b.ranges[w].tail = n;
+        start = n;
+    }
+    for (w = 0; w < thread_count; w++) {
+#ifdef PAS_ZIP_USE_THREADS
+        PAS_ZIP_MUTEX_INIT(&b.ranges[w].lock);
+#endif
+        b.done[w] = 0;
+    }
+
+    run_workers(batch_worker, &b, thread_count);
+
+    for (w = 0; w < thread_count; w++) {
+#ifdef PAS_ZIP_USE_THREADS
+        PAS_ZIP_MUTEX_DESTROY(&b.ranges[w].lock);
+#endif
+        ok += b.done[w];
+    }
+    return ok;
+}
+
+/* ----- Streaming reader ----- */
+
+int pas_zip_reader_init(pas_zip_reader_t *reader, const pas_zip_file_t *file, pas_zip_status *status) {
+    if (status) *status = PAS_ZIP_E_INVALID;
+    if (!reader || !file || !file->zip) return 0;
+
+    reader->file = *file;
+    reader->payload = entry_payload(file);
+    reader->produced = 0;
+    reader->delivered = 0;
+    reader->crc = 0;
+    reader->win_pos = 0;
+    reader->win_read = 0;
+    reader->done = 0;
+    reader->check_crc = file->zip->verify_crc;
+    reader->error = PAS_ZIP_OK;
+    if (!reader->payload) return 0;
+
+    if (file->compression_method == PAS_ZIP_METHOD_DEFLATE) {
+        inflate_init(&reader->inflate, reader->payload, (size_t)file->compressed_size);
+    } else if (file->compression_method != PAS_ZIP_METHOD_STORE) {
+        if (status) *status = PAS_ZIP_E_COMPRESSED;
+        return 0;
+    }
+    if (status) *status = PAS_ZIP_OK;
+    return 1;
+}
+
+/* Decode the next piece of a Deflate entry into the window. The window keeps the last
+   PAS_ZIP_WINDOW_SIZE bytes as match history: once full, the upper half slides down. */
+static int reader_fill(pas_zip_reader_t *r) {
+    size_t before;
+    int ret;
+
+    if (r->win_pos == sizeof(r->window)) {
+        memmove(r->window, r->window + PAS_ZIP_WINDOW_SIZE, PAS_ZIP_WINDOW_SIZE);
+        r->win_pos = PAS_ZIP_WINDOW_SIZE;
+        r->win_read = PAS_ZIP_WINDOW_SIZE;
+    }
+    before = r->win_pos;
+    ret = inflate_run(&r->inflate, r->window, &r->win_pos, sizeof(r->window));
+    r->produced += r->win_pos - before;
+    if (ret < 0 || r->produced > r->file.uncompressed_size) return 0;
+    if (ret == 1) {
+        if (r->produced != r->file.uncompressed_size) return 0;
+        r->done = 1;
+    }
+    return 1;
+}
+
+/* Account for n bytes handed out and, when verifying, check the CRC-32 once the last one is. */
+static size_t reader_deliver(pas_zip_reader_t *r, const uint8_t *out, size_t n, pas_zip_status *status) {
+    r->delivered += n;
+    if (r->check_crc && n > 0) {
+        r->crc = pas_zip_crc32(r->crc, out, n);
+        if (r->delivered == r->file.uncompressed_size && r->crc != r->file.crc32) {
+            r->error = PAS_ZIP_E_CRC;
+            if (status) *status = PAS_ZIP_E_CRC;
+            return n;
+        }
+    }
+    if (status) *status = PAS_ZIP_OK;
+    return n;
+}
+
+size_t pas_zip_reader_read(pas_zip_reader_t *reader, void *buffer, size_t size, pas_zip_status *status) {
+    uint8_t *out = (uint8_t *)buffer;
+    size_t total = 0;
+
+    if (status) *status = PAS_ZIP_E_INVALID;
+    if (!reader || !reader->payload || (!buffer && size)) return 0;
+    if (reader->error != PAS_ZIP_OK) {
+        if (status) *status = reader->error;
+        return 0;
+    }
+
+    if (reader->file.compression_method == PAS_ZIP_METHOD_STORE) {
+        uint64_t left = (uint64_t)reader->file.compressed_size - reader->delivered;
+        if ((uint64_t)size > left) size = (size_t)left;
+        memcpy(out, reader->payload + (size_t)reader->delivered, size);
+        return reader_deliver(reader, out, size, status);
+    }
+
+    while (total < size) {
+        if (reader->win_read < reader->win_pos) {
+            size_t n = reader->win_pos - reader->win_read;
+            if (n > size - total) n = size - total;
+            memcpy(out + total, reader->window + reader->win_read, n);
+            reader->win_read += n;
+            total += n;
+            continue;
+        }
+        if (reader->done) break;
+        if (!reader_fill(reader)) {
+            reader->error = PAS_ZIP_E_ZLIB;
+            if (status) *status = PAS_ZIP_E_ZLIB;
+            reader->delivered += total;
+            return total;
+        }
+    }
+    return reader_deliver(reader, out, total, status);
+}
+
+void pas_zip_reader_close(pas_zip_reader_t *reader) {
+    if (!reader) return;
+    reader->payload = NULL;
+    reader->done = 1;
+}
+
+/* ----- Random access inside Deflate entries ----- */
+
+#define PAS_ZIP_SEEK_POINT_BYTES (sizeof(pas_zip_seek_point_t) + PAS_ZIP_WINDOW_SIZE)
+
+/* Discard the next n bytes of the entry. */
+static int reader_skip(pas_zip_reader_t *r, uint64_t n) {
+    while (n > 0) {
+        if (r->win_read < r->win_pos) {
+            size_t k = r->win_pos - r->win_read;
+            if ((uint64_t)k > n) k = (size_t)n;
+            r->win_read += k;
+            r->delivered += k;
+            n -= k;
+            continue;
+        }
+        if (r->done || !reader_fill(r)) return 0;
+    }
+    return 1;
+}
+
+size_t pas_zip_seek_index_size(const pas_zip_file_t *file, uint64_t span) {
+    if (!file || span == 0 || file->compression_method != PAS_ZIP_METHOD_DEFLATE) return 0;
+    return (size_t)(file->uncompressed_size / span) * PAS_ZIP_SEEK_POINT_BYTES;
+}
+
+int pas_zip_seek_index_build(pas_zip_seek_index_t *idx, const pas_zip_file_t *file, uint64_t span,
+                             void *storage, size_t storage_size, pas_zip_reader_t *work,
+                             pas_zip_status *status) {
+    pas_zip_inflate_t *st;
+    size_t max_points;
+    uint64_t last = 0;
+
+    if (status) *status = PAS_ZIP_E_INVALID;
+    if (!idx || !file || !work || span == 0 || (!storage && storage_size)) return 0;
+    max_points = storage_size / PAS_ZIP_SEEK_POINT_BYTES;
+    idx->file = *file;
+    idx->points = (pas_zip_seek_point_t *)storage;
+    idx->windows = (uint8_t *)storage + max_points * sizeof(pas_zip_seek_point_t);
+    idx->count = 0;
+    if (!pas_zip_reader_init(work, file, status)) return 0;
+    if (file->compression_method == PAS_ZIP_METHOD_STORE) return 1;
+
+    st = &work->inflate;
+    st->block_stop = 1;
+    while (!work->done) {
+        if (!reader_fill(work)) {
+            if (status) *status = PAS_ZIP_E_ZLIB;
+            return 0;
+        }
+        work->win_read = work->win_pos;
+        if (st->block == PAS_ZIP_BLOCK_HEADER && !st->final && work->produced - last >= span) {
+            pas_zip_seek_point_t *pt;
+            size_t wlen = work->win_pos < PAS_ZIP_WINDOW_SIZE ? work->win_pos : PAS_ZIP_WINDOW_SIZE;
+            if (idx->count == max_points) {
+                if (status) *status = PAS_ZIP_E_NOSPACE;
+                return 0;
+            }
+            pt = &idx->points[idx->count];
+            pt->out_offset = work->produced;
+            pt->in_bit = (uint64_t)(st->in - work->payload) * 8 + (uint64_t)st->overrun * 8 - st->bitcount;
+            memcpy(idx->windows + idx->count * PAS_ZIP_WINDOW_SIZE, work->window + work->win_pos - wlen, wlen);
+            idx->count++;
+            last = work->produced;
+        }
+    }
+    st->block_stop = 0;
+    if (status) *status = PAS_ZIP_OK;
+    return 1;
+}
+
+/* Position work at the last point at or before offset: input at its bit offset, its window as
+   the history. Returns 0 if the point lies outside the compressed data. */
+static int seek_restore(const pas_zip_seek_index_t *idx, pas_zip_reader_t *work, uint64_t offset) {
+    const pas_zip_seek_point_t *pt;
+    size_t lo = 0, hi = idx->count, byte, wlen;
+    unsigned bits;
+
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (idx->points[mid].out_offset <= offset) lo = mid + 1;
+        else hi = mid;
+    }
+    if (lo == 0) return 1; /* before the first point: from the start */
+
+    pt = &idx->points[lo - 1];
+    byte = (size_t)(pt->in_bit >> 3);
+    bits = (unsigned)(pt->in_bit & 7u);
+    if (pt->in_bit >> 3 >= idx->file.compressed_size || pt->out_offset > idx->file.uncompressed_size) return 0;
+    inflate_init(&work->inflate, work->payload + byte, (size_t)idx->file.compressed_size - byte);
+    if (bits) {
+        work->inflate.bitbuf = (uint64_t)(work->payload[byte] >> bits);
+        work->inflate.bitcount = 8 - bits;
+        work->inflate.in++;
+    }
+    wlen = pt->out_offset < PAS_ZIP_WINDOW_SIZE ? (size_t)pt->out_offset : PAS_ZIP_WINDOW_SIZE;
+    memcpy(work->window, idx->windows + (lo - 1) * PAS_ZIP_WINDOW_SIZE, wlen);
+    work->win_pos = wlen;
+    work->win_read = wlen;
+    work->produced = pt->out_offset;
+    work->delivered = pt->out_offset;
+    return 1;
+}
+
+size_t pas_zip_read_at(const pas_zip_seek_index_t *idx, pas_zip_reader_t *work, uint64_t offset,
+                       void *buffer, size_t len, pas_zip_status *status) {
+    uint8_t *out = (uint8_t *)buffer;
+    size_t total = 0;
+    pas_zip_status st;
+
+    if (status) *status = PAS_ZIP_E_INVALID;
+    if (!idx || !work || (!buffer && len)) return 0;
+    if (offset > idx->file.uncompressed_size) return 0;
+    if (!pas_zip_reader_init(work, &idx->file, status)) return 0;
+    work->check_crc = 0;
+
+    if (idx->file.compression_method == PAS_ZIP_METHOD_STORE) {
+        work->delivered = offset;
+    } else if (!seek_restore(idx, work, offset) || !reader_skip(work, offset - work->delivered)) {
+        work->error = PAS_ZIP_E_ZLIB;
+        if (status) *status = PAS_ZIP_E_ZLIB;
+        return 0;
+    }
+
+    while (total < len) {
+        size_t n = pas_zip_reader_read(work, out + total, len - total, &st);
+        if (st != PAS_ZIP_OK) {
+            if (status) *status = st;
+            return 0;
+        }
+        if (n == 0) break;
+        total += n;
+    }
+    if (status) *status = PAS_ZIP_OK;
+    return total;
+}
+
+int pas_zip_list(pas_zip_t *zip, void (*callback)(const char *name, size_t size, void *user), void *user) {
+    if (!zip || !callback) return -1;
+    return cd_iterate(zip, NULL, NULL, callback, user) ? 0 : -1;
+}
+
+/* ----- Built-in Deflate encoder ----- */
+
+typedef struct {
+    uint16_t good;   /* lazy: shorten the chain when the previous match is at least this long */
+    uint16_t lazy;   /* lazy: no second search above this length; greedy: max length to index */
+    uint16_t nice;   /* stop searching at this length */
+    uint16_t chain;  /* max chain links followed */
+} pas_zip__level_t;
+
+static const pas_zip__level_t pas_zip__levels[10] = {
+    {0, 0, 0, 0},                                     /* 0: stored */
+    {4, 4, 8, 4}, {4, 5, 16, 8}, {4, 6, 32, 32},      /* 1-3: greedy */
+    {4, 4, 16, 16}, {8, 16, 32, 32}, {8, 16, 128, 128}, /* 4-9: lazy */
+    {8, 32, 128, 256}, {32, 128, 258, 1024}, {32, 258, 258, 4096}
+};
+
+#define PAS_ZIP_TOO_FAR 4096 /* length-3 matches further back than this cost more than literals */
+
+#define PAS_ZIP_HASH3(p) \
+    ((((uint32_t)(p)[0] | ((uint32_t)(p)[1] << 8) | ((uint32_t)(p)[2] << 16)) * 2654435761u) \
+     >> (32 - PAS_ZIP_HASH_BITS))
+
+typedef struct {
+    uint8_t *out;
+    size_t   pos;
+    size_t   end;
+    uint64_t bitbuf;
+    unsigned bitcount;  /* < 32 between calls */
+    int      overflow;
+} pas_zip__bitwriter_t;
+
+static void bw_put(pas_zip__bitwriter_t *w, uint32_t bits, unsigned n) {
+    w->bitbuf |= (uint64_t)bits << w->bitcount;
+    w->bitcount += n;
+    if (w->bitcount >= 32) {
+        if (w->end - w->pos >= 4) {
+            uint8_t *o = w->out + w->pos;
+            o[0] = (uint8_t)w->bitbuf;
+            o[1] = (uint8_t)(w->bitbuf >> 8);
+            o[2] = (uint8_t)(w->bitbuf >> 16);
+            o[3] = (uint8_t)(w->bitbuf >> 24);
+            w->pos += 4;
+        } else {
+            w->overflow = 1;
+        }
+        w->bitbuf >>= 32;
+        w->bitcount -= 32;
+    }
+}
+
+/* Pad to a byte boundary and write out all pending bits. */
+static void bw_align(pas_zip__bitwriter_t *w) {
+    while (w->bitcount > 0) {
+        if (w->pos < w->end) w->out[w->pos++] = (uint8_t)w->bitbuf;
+        else w->overflow = 1;
+        w->bitbuf >>= 8;
+        w->bitcount = w->bitcount > 8 ? w->bitcount - 8 : 0;
+    }
+}
+
+static void bw_bytes(pas_zip__bitwriter_t *w, const uint8_t *p, size_t n) {
+    if (w->end - w->pos < n) {
+        w->overflow = 1;
+        return;
+    }
+    memcpy(w->out + w->pos, p, n);
+    w->pos += n;
+}
+
+/* Distance -> distance code, zlib-style: direct for 1..256, by (dist - 1) >> 7 above. */
+static unsigned deflate_dist_code(const pas_zip_deflate_t *st, unsigned dist) {
+    return dist <= 256 ? st->dist_code[dist - 1] : st->dist_code[256 + ((dist - 1) >> 7)];
+}
+
+static void deflate_init_codes(pas_zip_deflate_t *st) {
+    unsigned code, i;
+    for (code = 0; code < 29; code++)
+        for (i = pas_zip__len_base[code]; i < 259 && i < pas_zip__len_base[code] + (1u << pas_zip__len_extra[code]); i++)
+            st->len_code[i] = (uint8_t)code;
+    st->len_code[258] = 28;
+    for (code = 0; code < 30; code++) {
+        unsigned lo = pas_zip__dist_base[code] - 1, hi = lo + (1u << pas_zip__dist_extra[code]);
+        for (i = lo; i < hi && i < 256; i++) st->dist_code[i] = (uint8_t)code;
+        for (i = lo >> 7; lo >= 256 && i < (hi >> 7); i++) st->dist_code[256 + i] = (uint8_t)code;
+    }
+}
+
+/* Code lengths of at most max_bits for n symbols: minimum-redundancy lengths computed in place
+   (Moffat-Katajainen), then length-limited by moving leaves down from the deepest levels.
+   At least two symbols get a code so every code is complete. */
+static void huff_lengths(const uint32_t *freq, unsigned n, unsigned max_bits, uint8_t *lens) {
+    uint32_t key[288];
+    uint16_t sym[288];
+    unsigned count[33];
+    unsigned used = 0, i, j;
+    int root, leaf, next, avbl, depth, nused;
+    uint32_t total;
+
+    for (i = 0; i < n; i++) {
+        lens[i] = 0;
+        if (freq[i]) { sym[used] = (uint16_t)i; key[used] = freq[i]; used++; }
+    }
+    for (i = 0; used < 2; i++)
+        if (!freq[i]) { sym[used] = (uint16_t)i; key[used] = 1; used++; }
+
+    /* Sort ascending by frequency */
+    for (i = 1; i < used; i++) {
+        uint32_t k = key[i];
+        uint16_t s = sym[i];
+        for (j = i; j > 0 && key[j - 1] > k; j--) { key[j] = key[j - 1]; sym[j] = sym[j - 1]; }
+        key[j] = k;
+        sym[j] = s;
+    }
+
+    /* Internal node weights, then parent pointers, then depths */
+    key[0] += key[1];
+    root = 0;
+    leaf = 2;
+    for (next = 1; next < (int)used - 1; next++) {
+        if (leaf >= (int)used || key[root] < key[leaf]) { key[next] = key[root]; key[root++] = (uint32_t)next; }
+        else key[next] = key[leaf++];
+        if (leaf >= (int)used || (root < next && key[root] < key[leaf])) { key[next] += key[root]; key[root++] = (uint32_t)next; }
+        else key[next] += key[leaf++];
+    }
+    key[used - 2] = 0;
+    for (next = (int)used - 3; next >= 0; next--) key[next] = key[key[next]] + 1;
+    avbl = 1;
+    nused = depth = 0;
+    root = (int)used - 2;
+    next = (int)used - 1;
+    while (avbl > 0) {
+        while (root >= 0 && (int)key[root] == depth) { nused++; root--; }
+        while (avbl > nused) { key[next--] = (uint32_t)depth; avbl--; }
+        avbl = 2 * nused;
+        depth++;
+        nused = 0;
+    }
+
+    memset(count, 0, sizeof(count));
+    for (i = 0; i < used; i++) count[key[i] > 32 ? 32 : key[i]]++;
+    for (i = max_bits + 1; i <= 32; i++) { count[max_bits] += count[i]; count[i] = 0; }
+    total = 0;
+    for (i = max_bits; i > 0; i--) total += (uint32_t)count[i] << (max_bits - i);
+    while (total != (1u << max_bits)) {
+        count[max_bits]--;
+        for (i = max_bits - 1; i > 0; i--)
+            if (count[i]) { count[i]--; count[i + 1] += 2; break; }
+        total--;
+    }
+
+    /* Most frequent symbols (end of the sorted list) get the shortest codes */
+    j = used;
+    for (i = 1; i <= max_bits; i++) {
+        unsigned k;
+        for (k = count[i]; k > 0; k--) lens[sym[--j]] = (uint8_t)i;
+    }
+}
+
+/* Canonical codes from lengths, bit-reversed for LSB-first output. */
+static void huff_codes(const uint8_t *lens, unsigned n, uint16_t *codes) {
+    unsigned bl_count[16], next[16], code = 0, i, b;
+
+    memset(bl_count, 0, sizeof(bl_count));
+    for (i = 0; i < n; i++) bl_count[lens[i]]++;
+    bl_count[0] = 0;
+    for (b = 1; b < 16; b++) {
+        code = (code + bl_count[b - 1]) << 1;
+        next[b] = code;
+    }
+    for (i = 0; i < n; i++) {
+        unsigned len = lens[i], c, r = 0;
+        if (!len) continue;
+        c = next[len]++;
+        for (b = 0; b < len; b++) { r = (r << 1) | (c & 1); c >>= 1; }
+        codes[i] = (uint16_t)r;
+    }
+}
+
+static void deflate_fixed_lens(uint8_t *ll, uint8_t *d) {
+    unsigned i;
+    for (i = 0; i < 144; i++) ll[i] = 8;
+    for (; i < 256; i++) ll[i] = 9;
+    for (; i < 280; i++) ll[i] = 7;
+    for (; i < 288; i++) ll[i] = 8;
+    for (i = 0; i < 32; i++) d[i] = 5;
+}
+
+/* Bits for the buffered symbols under the given code lengths, extra bits included. */
+static uint64_t deflate_symbol_bits(const pas_zip_deflate_t *st, const uint8_t *ll, const uint8_t *d) {
+    uint64_t bits = 0;
+    unsigned i;
+    for (i = 0; i < 286; i++) bits += (uint64_t)st->freq_ll[i] * ll[i];
+    for (i = 0; i < 29; i++) bits += (uint64_t)st->freq_ll[257 + i] * pas_zip__len_extra[i];
+    for (i = 0; i < 30; i++) bits += (uint64_t)st->freq_d[i] * (d[i] + pas_zip__dist_extra[i]);
+    return bits;
+}
+
+static void deflate_write_symbols(const pas_zip_deflate_t *st, pas_zip__bitwriter_t *w,
+                                  const uint8_t *ll_lens, const uint16_t *ll_codes,
+                                  const uint8_t *d_lens, const uint16_t *d_codes) {
+    size_t i;
+    for (i = 0; i < st->nsyms; i++) {
+        unsigned sym = st->sym_ll[i], dist = st->sym_dist[i];
+        if (!dist) {
+            bw_put(w, ll_codes[sym], ll_lens[sym]);
+        } else {
+            unsigned len = sym - 256, lc = st->len_code[len], dc = deflate_dist_code(st, dist);
+            bw_put(w, ll_codes[257 + lc], ll_lens[257 + lc]);
+            bw_put(w, len - pas_zip__len_base[lc], pas_zip__len_extra[lc]);
+            bw_put(w, d_codes[dc], d_lens[dc]);
+            bw_put(w, dist - pas_zip__dist_base[dc], pas_zip__dist_extra[dc]);
+        }
+    }
+    bw_put(w, ll_codes[256], ll_lens[256]);
+}
+
+static void deflate_stored(pas_zip__bitwriter_t *w, const uint8_t *block, size_t block_len, int final) {
+    size_t off = 0;
+    do {
+        size_t n = block_len - off < 65535 ? block_len - off : 65535;
+        uint8_t hdr[4];
+        bw_put(w, (final && off + n == block_len) ? 1u : 0u, 3);
+        bw_align(w);
+        hdr[0] = (uint8_t)n; hdr[1] = (uint8_t)(n >> 8);
+        hdr[2] = (uint8_t)~n; hdr[3] = (uint8_t)(~n >> 8);
+        bw_bytes(w, hdr, 4);
+        bw_bytes(w, block + off, n);
+        off += n;
+    } while (off < block_len);
+}
+
+/* Write the buffered symbols, which encode block[0..block_len), as the cheapest block type. */
+static void deflate_flush_block(pas_zip_deflate_t *st, pas_zip__bitwriter_t *w,
+                                const uint8_t *block, size_t block_len, int final) {
+    uint8_t ll_lens[288], d_lens[32], fixed_ll[288], fixed_d[32], all[288 + 32], pre_lens[19];
+    uint16_t ll_codes[288], d_codes[32], pre_codes[19];
+    uint8_t rle_sym[288 + 32], rle_extra[288 + 32];
+    uint32_t pre_freq[19];
+    unsigned hlit, hdist, hclen, nrle = 0, i;
+    uint64_t dyn_bits, fixed_bits, stored_bits;
+
+    st->freq_ll[256] = 1;
+    huff_lengths(st->freq_ll, 286, 15, ll_lens);
+    huff_lengths(st->freq_d, 30, 15, d_lens);
+    for (hlit = 286; hlit > 257 && !ll_lens[hlit - 1]; hlit--) {}
+    for (hdist = 30; hdist > 1 && !d_lens[hdist - 1]; hdist--) {}
+
+    /* Run-length code the concatenated lengths with symbols 16 (repeat previous), 17/18 (zeros) */
+    memcpy(all, ll_lens, hlit);
+    memcpy(all + hlit, d_lens, hdist);
+    memset(pre_freq, 0, sizeof(pre_freq));
+    for (i = 0; i < hlit + hdist;) {
+        unsigned cur = all[i], run = 1;
+        while (i + run < hlit + hdist && all[i + run] == cur) run++;
+        i += run;
+        if (cur == 0) {
+            while (run >= 11) {
+                unsigned r = run < 138 ? run : 138;
+                rle_sym[nrle] = 18; rle_extra[nrle++] = (uint8_t)(r - 11); run -= r;
+            }
+            if (run >= 3) { rle_sym[nrle] = 17; rle_extra[nrle++] = (uint8_t)(run - 3); run = 0; }
+        } else {
+            rle_sym[nrle] = (uint8_t)cur; rle_extra[nrle++] = 0; run--;
+            while (run >= 3) {
+                unsigned r = run < 6 ? run : 6;
+                rle_sym[nrle] = 16; rle_extra[nrle++] = (uint8_t)(r - 3); run -= r;
+            }
+        }
+        while (run--) { rle_sym[nrle] = (uint8_t)cur; rle_extra[nrle++] = 0; }
+    }
+    for (i = 0; i < nrle; i++) pre_freq[rle_sym[i]]++;
+    huff_lengths(pre_freq, 19, 7, pre_lens);
+    for (hclen = 19; hclen > 4 && !pre_lens[pas_zip__precode_order[hclen - 1]]; hclen--) {}
+
+    dyn_bits = 3 + 14 + 3 * (uint64_t)hclen + deflate_symbol_bits(st, ll_lens, d_lens);
+    for (i = 0; i < 19; i++) dyn_bits += (uint64_t)pre_freq[i] * pre_lens[i];
+    dyn_bits += 2 * (uint64_t)pre_freq[16] + 3 * (uint64_t)pre_freq[17] + 7 * (uint64_t)pre_freq[18];
+    deflate_fixed_lens(fixed_ll, fixed_d);
+    fixed_bits = 3 + deflate_symbol_bits(st, fixed_ll, fixed_d);
+    stored_bits = ((block_len + 65534) / 65535 + (block_len == 0)) * 40 + 8 + 8 * (uint64_t)block_len;
+
+    if (stored_bits <= dyn_bits && stored_bits <= fixed_bits) {
+        deflate_stored(w, block, block_len, final);
+    } else if (fixed_bits <= dyn_bits) {
+        huff_codes(fixed_ll, 288, ll_codes);
+        huff_codes(fixed_d, 32, d_codes);
+        bw_put(w, final ? 3u : 2u, 3);
+        deflate_write_symbols(st, w, fixed_ll, ll_codes, fixed_d, d_codes);
+    } else {
+        huff_codes(ll_lens, 286, ll_codes);
+        huff_codes(d_lens, 30, d_codes);
+        huff_codes(pre_lens, 19, pre_codes);
+        bw_put(w, final ? 5u : 4u, 3);
+        bw_put(w, hlit - 257, 5);
+        bw_put(w, hdist - 1, 5);
+        bw_put(w, hclen - 4, 4);
+        for (i = 0; i < hclen; i++) bw_put(w, pre_lens[pas_zip__precode_order[i]], 3);
+        for (i = 0; i < nrle; i++) {
+            unsigned s = rle_sym[i];
+            bw_put(w, pre_codes[s], pre_lens[s]);
+            if (s == 16) bw_put(w, rle_extra[i], 2);
+            else if (s == 17) bw_put(w, rle_extra[i], 3);
+            else if (s == 18) bw_put(w, rle_extra[i], 7);
+        }
+        deflate_write_symbols(st, w, ll_lens, ll_codes, d_lens, d_codes);
+    }
+
+    st->nsyms = 0;
+    memset(st->freq_ll, 0, sizeof(st->freq_ll));
+    memset(st->freq_d, 0, sizeof(st->freq_d));
+}
+
+static void deflate_literal(pas_zip_deflate_t *st, unsigned c) {
+    st->sym_ll[st->nsyms] = (uint16_t)c;
+    st->sym_dist[st->nsyms++] = 0;
+    st->freq_ll[c]++;
+}
+
+static void deflate_match(pas_zip_deflate_t *st, unsigned len, unsigned dist) {
+    st->sym_ll[st->nsyms] = (uint16_t)(256 + len);
+    st->sym_dist[st->nsyms++] = (uint16_t)dist;
+    st->freq_ll[257 + st->len_code[len]]++;
+    st->freq_d[deflate_dist_code(st, dist)]++;
+}
+
+static void deflate_insert(pas_zip_deflate_t *st, const uint8_t *data, size_t pos) {
+    uint32_t h = PAS_ZIP_HASH3(data + pos);
+    st->prev[pos & (PAS_ZIP_WINDOW_SIZE - 1)] = st->head[h];
+    st->head[h] = (uint32_t)pos + 1;
+}
+
+static unsigned match_len(const uint8_t *a, const uint8_t *b, unsigned max) {
+    unsigned n = 0;
+    while (n + 8 <= max) {
+        uint64_t x, y;
+        memcpy(&x, a + n, 8);
+        memcpy(&y, b + n, 8);
+        if (x != y) break;
+        n += 8;
+    }
+    while (n < max && a[n] == b[n]) n++;
+    return n;
+}
+
+/* Longest match for data[pos..] (at least 3 bytes available) among earlier positions with the
+   same hash. Only matches longer than best count; returns the best length, *dist updated. */
+static unsigned deflate_longest_match(const pas_zip_deflate_t *st, const uint8_t *data, size_t pos,
+                                      size_t avail, unsigned chain, unsigned nice, unsigned best,
+                                      unsigned *dist) {
+    const uint8_t *cur = data + pos;
+    unsigned max = avail < 258 ? (unsigned)avail : 258;
+    uint32_t c = st->head[PAS_ZIP_HASH3(cur)];
+
+    if (nice > max) nice = max;
+    if (best >= max) return best;
+    while (c && chain--) {
+        size_t cand = c - 1;
+        const uint8_t *m = data + cand;
+        if (pos - cand > PAS_ZIP_WINDOW_SIZE) break;
+        if (m[best] == cur[best] && m[0] == cur[0] && m[1] == cur[1]) {
+            unsigned len = match_len(m, cur, max);
+            if (len > best) {
+                best = len;
+                *dist = (unsigned)(pos - cand);
+                if (len >= nice) break;
+            }
+        }
+        c = st->prev[cand & (PAS_ZIP_WINDOW_SIZE - 1)];
+    }
+    return best;
+}
+
+/* Encode data[start..end) as Deflate blocks into w, the last one marked final if final is set.
+   data[start - 32K..start), when present, is history: it is indexed first so matches can reach
+   back into it, but it is not encoded. Without final the stream ends mid-byte, ready for more
+   blocks. */
+static void deflate_range(pas_zip_deflate_t *st, int level, const uint8_t *data, size_t start,
+                          size_t end, pas_zip__bitwriter_t *w, int final) {
+    pas_zip__level_t cfg = pas_zip__levels[level];
+    size_t pos = start, block_start = start, emitted = start;
+
+    st->nsyms = 0;
+    memset(st->freq_ll, 0, sizeof(st->freq_ll));
+    memset(st->freq_d, 0, sizeof(st->freq_d));
+
+    if (level == 0) {
+        if (final || end > start) deflate_stored(w, data + start, end - start, final);
+        return;
+    }
+
+    deflate_init_codes(st);
+    memset(st->head, 0, sizeof(st->head));
+    for (pos = start > PAS_ZIP_WINDOW_SIZE ? start - PAS_ZIP_WINDOW_SIZE : 0; pos < start && end - pos >= 3; pos++)
+        deflate_insert(st, data, pos);
+    pos = start;
+
+    if (level <= 3) {
+        while (pos < end && !w->overflow) {
+            unsigned len = 0, dist = 0;
+            if (end - pos >= 3) {
+                len = deflate_longest_match(st, data, pos, end - pos, cfg.chain, cfg.nice, 2, &dist);
+                if (len == 3 && dist > PAS_ZIP_TOO_FAR) len = 0;
+                deflate_insert(st, data, pos);
+            }
+            if (len >= 3) {
+                size_t stop = pos + len;
+                deflate_match(st, len, dist);
+                if (len <= cfg.lazy)
+                    for (pos++; pos < stop && end - pos >= 3; pos++) deflate_insert(st, data, pos);
+                pos = stop;
+            } else {
+                deflate_literal(st, data[pos++]);
+            }
+            if (st->nsyms == PAS_ZIP_BLOCK_SYMS) {
+                deflate_flush_block(st, w, data + block_start, pos - block_start, 0);
+                block_start = pos;
+            }
+        }
+        emitted = pos;
+    } else {
+        unsigned prev_len = 2, prev_dist = 0;
+        int pending = 0; /* data[pos - 1] is not emitted yet */
+        while (pos < end && !w->overflow) {
+            unsigned cur_len = 2, cur_dist = 0;
+            if (end - pos >= 3) {
+                if (prev_len < cfg.lazy) {
+                    unsigned chain = prev_len >= cfg.good ? cfg.chain >> 2 : cfg.chain;
+                    cur_len = deflate_longest_match(st, data, pos, end - pos, chain, cfg.nice, prev_len, &cur_dist);
+                    if (cur_len == 3 && cur_dist > PAS_ZIP_TOO_FAR) cur_len = 2;
+                }
+                deflate_insert(st, data, pos);
+            }
+            if (prev_len >= 3 && cur_len <= prev_len) {
+                size_t stop = pos - 1 + prev_len;
+                deflate_match(st, prev_len, prev_dist);
+                for (pos++; pos < stop && end - pos >= 3; pos++) deflate_insert(st, data, pos);
+                pos = stop;
+                emitted = stop;
+                pending = 0;
+                prev_len = 2;
+            } else {
+                if (pending) {
+                    deflate_literal(st, data[pos - 1]);
+                    emitted = pos;
+                }
+                pending = 1;
+                prev_len = cur_len;
+                prev_dist = cur_dist;
+                pos++;
+            }
+            if (st->nsyms == PAS_ZIP_BLOCK_SYMS) {
+                deflate_flush_block(st, w, data + block_start, emitted - block_start, 0);
+                block_start = emitted;
+            }
+        }
+        if (pending && !w->overflow) {
+            deflate_literal(st, data[pos - 1]);
+            emitted = pos;
+        }
+    }
+
+    if (final || st->nsyms > 0) deflate_flush_block(st, w, data + block_start, emitted - block_start, final);
+}
+
+static void bw_init(pas_zip__bitwriter_t *w, uint8_t *out, size_t out_size) {
+    w->out = out;
+    w->pos = 0;
+    w->end = out_size;
+    w->bitbuf = 0;
+    w->bitcount = 0;
+    w->overflow = 0;
+}
+
+static int deflate_level(int level) {
+    return level < 0 ? 0 : level > 9 ? 9 : level;
+}
+
+size_t pas_zip_deflate(pas_zip_deflate_t *st, int level, const void *in, size_t in_len,
+                       void *out, size_t out_size, pas_zip_status *status) {
+    pas_zip__bitwriter_t w;
+
+    if (status) *status = PAS_ZIP_E_INVALID;
+    if (!st || (!in && in_len) || (!out && out_size)) return 0;
+    if ((uint64_t)in_len >= 0xFFFFFFFFu) return 0; /* positions are stored as uint32 + 1 */
+
+    bw_init(&w, (uint8_t *)out, out_size);
+    deflate_range(st, deflate_level(level), (const uint8_t *)in, 0, in_len, &w, 1);
+    bw_align(&w);
+    if (w.overflow) {
+        if (status) *status = PAS_ZIP_E_NOSPACE;
+        return 0;
+    }
+    if (status) *status = PAS_ZIP_OK;
+    return w.pos;
+}
+
+static void write_u16_le(uint8_t *p, unsigned v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+static void write_u32_le(uint8_t *p, uint32_t v) {
+    write_u16_le(p, (unsigned)(v & 0xFFFFu));
+    write_u16_le(p + 2, (unsigned)(v >> 16));
+}
+
+/* ----- Deduplication -----
+   XXH64 (xxHash, 64-bit variant): four lanes over 32-byte stripes, several GB/s. Table slots
+   hold a content hash and entry index + 1 (0 = empty), with linear probing. */
+
+#define PAS_ZIP_XXH_P1 (((uint64_t)0x9E3779B1u << 32) | 0x85EBCA87u)
+#define PAS_ZIP_XXH_P2 (((uint64_t)0xC2B2AE3Du << 32) | 0x27D4EB4Fu)
+#define PAS_ZIP_XXH_P3 (((uint64_t)0x165667B1u << 32) | 0x9E3779F9u)
+#define PAS_ZIP_XXH_P4 (((uint64_t)0x85EBCA77u << 32) | 0xC2B2AE63u)
+#define PAS_ZIP_XXH_P5 (((uint64_t)0x27D4EB2Fu << 32) | 0x165667C5u)
+#define PAS_ZIP_ROTL64(x, r) (((x) << (r)) | ((x) >> (64 - (r))))
+
+static uint64_t xxh64_round(uint64_t acc, uint64_t in) {
+    acc += in * PAS_ZIP_XXH_P2;
+    acc = PAS_ZIP_ROTL64(acc, 31);
+    return acc * PAS_ZIP_XXH_P1;
+}
+
+static uint64_t xxh64_merge(uint64_t h, uint64_t v) {
+    h ^= xxh64_round(0, v);
+    return h * PAS_ZIP_XXH_P1 + PAS_ZIP_XXH_P4;
+}
+
+static uint64_t xxh64(const uint8_t *p, size_t len, uint64_t seed) {
+    const uint8_t *end = p + len;
+    uint64_t h;
+
+    if (len >= 32) {
+        uint64_t v1 = seed + PAS_ZIP_XXH_P1 + PAS_ZIP_XXH_P2, v2 = seed + PAS_ZIP_XXH_P2;
+        uint64_t v3 = seed, v4 = seed - PAS_ZIP_XXH_P1;
+        do {
+            v1 = xxh64_round(v1, read_u64_le(p));
+            v2 = xxh64_round(v2, read_u64_le(p + 8));
+            v3 = xxh64_round(v3, read_u64_le(p + 16));
+            v4 = xxh64_round(v4, read_u64_le(p + 24));
+            p += 32;
+        } while (end - p >= 32);
+        h = PAS_ZIP_ROTL64(v1, 1) + PAS_ZIP_ROTL64(v2, 7) + PAS_ZIP_ROTL64(v3, 12) + PAS_ZIP_ROTL64(v4, 18);
+        h = xxh64_merge(h, v1);
+        h = xxh64_merge(h, v2);
+        h = xxh64_merge(h, v3);
+        h = xxh64_merge(h, v4);
+    } else {
+        h = seed + PAS_ZIP_XXH_P5;
+    }
+    h += (uint64_t)len;
+
+    for (; end - p >= 8; p += 8) {
+        h ^= xxh64_round(0, read_u64_le(p));
+        h = PAS_ZIP_ROTL64(h, 27) * PAS_ZIP_XXH_P1 + PAS_ZIP_XXH_P4;
+    }
+    if (end - p >= 4) {
+        h ^= (uint64_t)read_u32_le(p) * PAS_ZIP_XXH_P1;
+        h = PAS_ZIP_ROTL64(h, 23) * PAS_ZIP_XXH_P2 + PAS_ZIP_XXH_P3;
+        p += 4;
+    }
+    for (; p < end; p++) {
+        h ^= (uint64_t)*p * PAS_ZIP_XXH_P5;
+        h = PAS_ZIP_ROTL64(h, 11) * PAS_ZIP_XXH_P1;
+    }
+
+    h ^= h >> 33;
+    h *= PAS_ZIP_XXH_P2;
+    h ^= h >> 29;
+    h *= PAS_ZIP_XXH_P3;
+    return h ^ (h >> 32);
+}
+
+typedef struct {
+    uint64_t hash;
+    uint32_t entry;  /* first entry with this content + 1, 0 = empty slot */
+    uint32_t unused;
+} pas_zip__dedup_slot_t;
+
+/* Slots: a power of two, at least twice the entry count */
+static size_t dedup_slots(int file_count) {
+    size_t n = 16;
+    while (n < 2 * (size_t)file_count) n <<= 1;
+    return n;
+}
+
+size_t pas_zip_dedup_size(int file_count) {
+    if (file_count <= 0) return 0;
+    return dedup_slots(file_count) * sizeof(pas_zip__dedup_slot_t) + (size_t)file_count * sizeof(uint32_t);
+}
+
+/* Create ZIP: local header + data per entry, then the Central Directory, then the end record.
+   With slots, each input is looked up first and a duplicate reuses the earlier entry's local
+   header; offsets[] then keeps every entry's local header offset for the CD pass. */
+static size_t create_impl(const char **filenames, const void **datas, const size_t *sizes,
+                          int file_count, int level, pas_zip_deflate_t *state,
+                          pas_zip__dedup_slot_t *slots, size_t nslots, uint32_t *offsets,
+                          void *buffer, size_t buffer_size, pas_zip_status *status) {
+    uint8_t *out = (uint8_t *)buffer;
+    size_t written = 0, local_off;
+    uint32_t cd_offset;
+    int i;
+
+    if (status) *status = PAS_ZIP_E_INVALID;
+    if (!filenames || !datas || !sizes || !buffer || file_count <= 0 || file_count > 0xFFFF) return 0;
+
+    for (i = 0; i < file_count; i++) {
+        size_t fn_len = strlen(filenames[i]);
+        size_t sz = sizes[i], comp = sz, payload;
+        unsigned method = PAS_ZIP_METHOD_STORE;
+        uint8_t *h;
+
+        if (fn_len > 0xFFFF || (uint64_t)sz >= 0xFFFFFFFFu) return 0; /* no ZIP64 output */
+        if (slots && sz > 0) {
+            uint64_t hash = xxh64((const uint8_t *)datas[i], sz, 0);
+            size_t k = (size_t)hash & (nslots - 1);
+            for (; slots[k].entry; k = (k + 1) & (nslots - 1)) {
+                size_t j = slots[k].entry - 1;
+                if (slots[k].hash == hash && sizes[j] == sz &&
+                    (datas[j] == datas[i] || memcmp(datas[j], datas[i], sz) == 0))
+                    break;
+            }
+            if (slots[k].entry) {
+                offsets[i] = offsets[slots[k].entry - 1];
+                continue;
+            }
+            slots[k].hash = hash;
+            slots[k].entry = (uint32_t)i + 1;
+        }
+        if ((uint64_t)written >= 0xFFFFFFFFu) return 0;
+        if (offsets) offsets[i] = (uint32_t)written;
+        if (written + 30 + fn_len > buffer_size) {
+            if (status) *status = PAS_ZIP_E_NOSPACE;
+            return 0;
+        }
+        payload = written + 30 + fn_len;
+
+        if (level > 0 && state && sz > 0) {
+            /* Keep the Deflate output only if it is smaller than the data */
+            size_t room = buffer_size - payload;
+            pas_zip_status ds;
+            size_t n;
+            if (room > sz - 1) room = sz - 1;
+            n = pas_zip_deflate(state, level, datas[i], sz, out + payload, room, &ds);
+            if (ds == PAS_ZIP_OK) {
+                method = PAS_ZIP_METHOD_DEFLATE;
+                comp = n;
+            }
+        }
+        if (method == PAS_ZIP_METHOD_STORE) {
+            if (sz > buffer_size - payload) {
+                if (status) *status = PAS_ZIP_E_NOSPACE;
+                return 0;
+            }
+            memcpy(out + payload, datas[i], sz);
+        }
+
+        h = out + written;
+        write_u32_le(h, PAS_ZIP_LFH_SIG);
+        write_u16_le(h + 4, 20);                 /* version needed */
+        write_u16_le(h + 6, 0);                  /* flags */
+        write_u16_le(h + 8, method);
+        write_u32_le(h + 10, 0);                 /* mod time, mod date */
+        write_u32_le(h + 14, pas_zip_crc32(0, datas[i], sz));
+        write_u32_le(h + 18, (uint32_t)comp);
+        write_u32_le(h + 22, (uint32_t)sz);
+        write_u16_le(h + 26, (unsigned)fn_len);
+        write_u16_le(h + 28, 0);                 /* extra len */
+        memcpy(h + 30, filenames[i], fn_len);
+        written = payload + comp;
+    }
+
+    if ((uint64_t)written >= 0xFFFFFFFFu) return 0;
+    cd_offset = (uint32_t)written;
+    local_off = 0;
+    for (i = 0; i < file_count; i++) {
+        const uint8_t *lh = out + (offsets ? offsets[i] : local_off);
+        size_t fn_len = strlen(filenames[i]);
+        uint8_t *c = out + written;
+        if (written + 46 + fn_len > buffer_size) {
+            if (status) *status = PAS_ZIP_E_NOSPACE;
+            return 0;
+        }
+        write_u32_le(c, PAS_ZIP_CDH_SIG);
+        write_u16_le(c + 4, 20);                 /* version made by */
+        memcpy(c + 6, lh + 4, 22);               /* version needed .. uncompressed size */
+        write_u16_le(c + 28, (unsigned)fn_len);
+        write_u16_le(c + 30, 0);                 /* extra len */
+        write_u16_le(c + 32, 0);                 /* comment len */
+        write_u16_le(c + 34, 0);                 /* disk */
+        write_u16_le(c + 36, 0);                 /* internal attrs */
+        write_u32_le(c + 38, 0);                 /* external attrs */
+        write_u32_le(c + 42, (uint32_t)(lh - out));
+        memcpy(c + 46, filenames[i], fn_len);
+        written += 46 + fn_len;
+        local_off += 30 + fn_len + read_u32_le(lh + 18);
+    }
+
+    if (written + 22 > buffer_size || (uint64_t)written - cd_offset >= 0xFFFFFFFFu) {
+        if (status) *status = PAS_ZIP_E_NOSPACE;
+        return 0;
+    }
+    write_u32_le(out + written, PAS_ZIP_EOCD_SIG);
+    write_u32_le(out + written + 4, 0);          /* disk numbers */
+    write_u16_le(out + written + 8, (unsigned)file_count);
+    write_u16_le(out + written + 10, (unsigned)file_count);
+    write_u32_le(out + written + 12, (uint32_t)(written - cd_offset));
+    write_u32_le(out + written + 16, cd_offset);
+    write_u16_le(out + written + 20, 0);         /* comment len */
+    written += 22;
 
     if (status) *status = PAS_ZIP_OK;
     return written;
 }
 
+size_t pas_zip_create_ex(const char **filenames, const void **datas, const size_t *sizes,
+                         int file_count, int level, pas_zip_deflate_t *state,
+                         void *buffer, size_t buffer_size, pas_zip_status *status) {
+    return create_impl(filenames, datas, sizes, file_count, level, state, NULL, 0, NULL,
+                       buffer, buffer_size, status);
+}
+
+size_t pas_zip_create_dedup(const char **filenames, const void **datas, const size_t *sizes,
+                            int file_count, int level, pas_zip_deflate_t *state,
+                            void *storage, size_t storage_size,
+                            void *buffer, size_t buffer_size, pas_zip_status *status) {
+    pas_zip__dedup_slot_t *slots = (pas_zip__dedup_slot_t *)storage;
+    size_t nslots;
+
+    if (status) *status = PAS_ZIP_E_INVALID;
+    if (!storage || file_count <= 0 || file_count > 0xFFFF) return 0;
+    if (storage_size < pas_zip_dedup_size(file_count)) {
+        if (status) *status = PAS_ZIP_E_NOSPACE;
+        return 0;
+    }
+    nslots = dedup_slots(file_count);
+    memset(slots, 0, nslots * sizeof(*slots));
+    return create_impl(filenames, datas, sizes, file_count, level, state, slots, nslots,
+                       (uint32_t *)(void *)(slots + nslots), buffer, buffer_size, status);
+}
+
+size_t pas_zip_create(const char **filenames, const void **datas, const size_t *sizes,
+                      int file_count, void *buffer, size_t buffer_size, pas_zip_status *status) {
+    return pas_zip_create_ex(filenames, datas, sizes, file_count, 0, NULL, buffer, buffer_size, status);
+}
+
+/* ----- Streaming writer ----- */
+
+static void write_u64_le(uint8_t *p, uint64_t v) {
+    write_u32_le(p, (uint32_t)v);
+    write_u32_le(p + 4, (uint32_t)(v >> 32));
+}
+
+static int writer_fail(pas_zip_writer_t *wr, pas_zip_status err, pas_zip_status *status) {
+    if (wr->error == PAS_ZIP_OK) wr->error = err;
+    if (status) *status = wr->error;
+    return 0;
+}
+
+int pas_zip_writer_begin(pas_zip_writer_t *wr, void *buffer, size_t buffer_size,
+                         pas_zip_writer_entry_t *entries, size_t max_entries,
+                         pas_zip_deflate_t *deflate, pas_zip_status *status) {
+    if (status) *status = PAS_ZIP_E_INVALID;
+    if (!wr || !buffer || !entries) return 0;
+    wr->out = (uint8_t *)buffer;
+    wr->out_size = buffer_size;
+    wr->pos = 0;
+    wr->entries = entries;
+    wr->max_entries = max_entries;
+    wr->count = 0;
+    wr->deflate = deflate;
+    wr->level = 0;
+    wr->open = 0;
+    wr->finished = 0;
+    wr->error = PAS_ZIP_OK;
+    if (status) *status = PAS_ZIP_OK;
+    return 1;
+}
+
+/* Compress the buffered piece window[hist_len..hist_len + fill) and keep its last 32 KB as
+   history for the next one. */
+static void writer_deflate(pas_zip_writer_t *wr, int final) {
+    pas_zip__bitwriter_t w;
+    size_t total, keep;
+
+    bw_init(&w, wr->out + wr->pos, wr->out_size - wr->pos);
+    w.bitbuf = wr->bitbuf;
+    w.bitcount = wr->bitcount;
+    deflate_range(wr->deflate, wr->level, wr->window, wr->hist_len, wr->hist_len + wr->fill, &w, final);
+    if (final) bw_align(&w);
+    if (w.overflow) {
+        wr->error = PAS_ZIP_E_NOSPACE;
+        return;
+    }
+    wr->pos += w.pos;
+    wr->bitbuf = w.bitbuf;
+    wr->bitcount = w.bitcount;
+
+    total = wr->hist_len + wr->fill;
+    keep = total < PAS_ZIP_WINDOW_SIZE ? total : PAS_ZIP_WINDOW_SIZE;
+    memmove(wr->window, wr->window + total - keep, keep);
+    wr->hist_len = keep;
+    wr->fill = 0;
+}
+
+/* Flush the open entry and patch its local header with method and sizes. */
+static void writer_close_entry(pas_zip_writer_t *wr) {
+    pas_zip_writer_entry_t *e = &wr->entries[wr->count - 1];
+    uint8_t *h = wr->out + e->local_header_offset;
+    uint64_t comp;
+
+    wr->open = 0;
+    if (wr->level > 0) {
+        if (e->uncompressed_size == 0) wr->level = 0; /* nothing to compress: Store */
+        else writer_deflate(wr, 1);
+        if (wr->error != PAS_ZIP_OK) return;
+    }
+    comp = wr->pos - wr->payload;
+    e->compressed_size = comp;
+    e->method = wr->level ? PAS_ZIP_METHOD_DEFLATE : PAS_ZIP_METHOD_STORE;
+    write_u16_le(h + 8, e->method);
+    write_u32_le(h + 14, e->crc32);
+
+    if (comp >= 0xFFFFFFFFu || e->uncompressed_size >= 0xFFFFFFFFu) {
+        /* Rare: slide the data to make room for a ZIP64 extra field in the local header */
+        if (wr->out_size - wr->pos < 20) {
+            wr->error = PAS_ZIP_E_NOSPACE;
+            return;
+        }
+        memmove(wr->out + wr->payload + 20, wr->out + wr->payload, (size_t)comp);
+        write_u16_le(wr->out + wr->payload, PAS_ZIP_ZIP64_EXTRA);
+        write_u16_le(wr->out + wr->payload + 2, 16);
+        write_u64_le(wr->out + wr->payload + 4, e->uncompressed_size);
+        write_u64_le(wr->out + wr->payload + 12, comp);
+        wr->pos += 20;
+        write_u16_le(h + 4, 45);
+        write_u32_le(h + 18, 0xFFFFFFFFu);
+        write_u32_le(h + 22, 0xFFFFFFFFu);
+        write_u16_le(h + 28, 20);
+    } else {
+        write_u32_le(h + 18, (uint32_t)comp);
+        write_u32_le(h + 22, (uint32_t)e->uncompressed_size);
+    }
+}
+
+int pas_zip_writer_add_entry(pas_zip_writer_t *wr, const char *name, int level, pas_zip_status *status) {
+    pas_zip_writer_entry_t *e;
+    size_t fn_len;
+    uint8_t *h;
+
+    if (status) *status = PAS_ZIP_E_INVALID;
+    if (!wr || !name || wr->finished) return 0;
+    if (wr->error != PAS_ZIP_OK) return writer_fail(wr, wr->error, status);
+    if (wr->open) {
+        writer_close_entry(wr);
+        if (wr->error != PAS_ZIP_OK) return writer_fail(wr, wr->error, status);
+    }
+    fn_len = strlen(name);
+    if (fn_len > 0xFFFF) return writer_fail(wr, PAS_ZIP_E_INVALID, status);
+    if (wr->count == wr->max_entries || wr->out_size - wr->pos < 30 + fn_len)
+        return writer_fail(wr, PAS_ZIP_E_NOSPACE, status);
+
+    h = wr->out + wr->pos;
+    write_u32_le(h, PAS_ZIP_LFH_SIG);
+    write_u16_le(h + 4, 20);                 /* version needed */
+    write_u16_le(h + 6, 0);                  /* flags */
+    write_u16_le(h + 8, 0);                  /* method, set when the entry is closed */
+    write_u32_le(h + 10, 0);                 /* mod time, mod date */
+    write_u32_le(h + 14, 0);                 /* crc and sizes, set when the entry is closed */
+    write_u32_le(h + 18, 0);
+    write_u32_le(h + 22, 0);
+    write_u16_le(h + 26, (unsigned)fn_len);
+    write_u16_le(h + 28, 0);                 /* extra len */
+    memcpy(h + 30, name, fn_len);
+
+    e = &wr->entries[wr->count++];
+    e->local_header_offset = wr->pos;
+    e->compressed_size = 0;
+    e->uncompressed_size = 0;
+    e->crc32 = 0;
+    e->method = PAS_ZIP_METHOD_STORE;
+    wr->pos += 30 + fn_len;
+    wr->payload = wr->pos;
+    wr->level = wr->deflate ? deflate_level(level) : 0;
+    wr->open = 1;
+    wr->bitbuf = 0;
+    wr->bitcount = 0;
+    wr->hist_len = 0;
+    wr->fill = 0;
+    if (status) *status = PAS_ZIP_OK;
+    return 1;
+}
+
+int pas_zip_writer_add_chunk(pas_zip_writer_t *wr, const void *data, size_t size, pas_zip_status *status) {
+    const uint8_t *p = (const uint8_t *)data;
+
+    if (status) *status = PAS_ZIP_E_INVALID;
+    if (!wr || (!data && size) || wr->finished) return 0;
+    if (wr->error != PAS_ZIP_OK) return writer_fail(wr, wr->error, status);
+    if (!wr->open) return 0;
+
+    wr->entries[wr->count - 1].uncompressed_size += size;
+    wr->entries[wr->count - 1].crc32 = pas_zip_crc32(wr->entries[wr->count - 1].crc32, data, size);
+    if (wr->level == 0) {
+        if (wr->out_size - wr->pos < size) return writer_fail(wr, PAS_ZIP_E_NOSPACE, status);
+        memcpy(wr->out + wr->pos, p, size);
+        wr->pos += size;
+    } else {
+        while (size > 0) {
+            size_t n = PAS_ZIP_WRITER_CHUNK - wr->fill;
+            if (n > size) n = size;
+            memcpy(wr->window + wr->hist_len + wr->fill, p, n);
+            wr->fill += n;
+            p += n;
+            size -= n;
+            if (wr->fill == PAS_ZIP_WRITER_CHUNK) {
+                writer_deflate(wr, 0);
+                if (wr->error != PAS_ZIP_OK) return writer_fail(wr, wr->error, status);
+            }
+        }
+    }
+    if (status) *status = PAS_ZIP_OK;
+    return 1;
+}
+
+size_t pas_zip_writer_finish(pas_zip_writer_t *wr, pas_zip_status *status) {
+    uint64_t cd_offset, cd_size;
+    size_t i;
+    uint8_t *p;
+
+    if (status) *status = PAS_ZIP_E_INVALID;
+    if (!wr || wr->finished) return 0;
+    wr->finished = 1;
+    if (wr->open) writer_close_entry(wr);
+    if (wr->error != PAS_ZIP_OK) return (size_t)writer_fail(wr, wr->error, status);
+
+    /* Central Directory: one linear pass over the entry table */
+    cd_offset = wr->pos;
+    for (i = 0; i < wr->count; i++) {
+        const pas_zip_writer_entry_t *e = &wr->entries[i];
+        const uint8_t *h = wr->out + e->local_header_offset;
+        size_t fn_len = read_u16_le(h + 26);
+        int big_unc = e->uncompressed_size >= 0xFFFFFFFFu;
+        int big_comp = e->compressed_size >= 0xFFFFFFFFu;
+        int big_off = e->local_header_offset >= 0xFFFFFFFFu;
+        unsigned extra = 8u * (unsigned)(big_unc + big_comp + big_off);
+
+        if (extra) extra += 4;
+        if (wr->out_size - wr->pos < 46 + fn_len + extra) return (size_t)writer_fail(wr, PAS_ZIP_E_NOSPACE, status);
+        p = wr->out + wr->pos;
+        write_u32_le(p, PAS_ZIP_CDH_SIG);
+        write_u16_le(p + 4, extra ? 45 : 20);  /* version made by */
+        write_u16_le(p + 6, extra ? 45 : read_u16_le(h + 4));
+        write_u16_le(p + 8, 0);                /* flags */
+        write_u16_le(p + 10, e->method);
+        memcpy(p + 12, h + 10, 8);             /* mod time, mod date, crc */
+        write_u32_le(p + 20, big_comp ? 0xFFFFFFFFu : (uint32_t)e->compressed_size);
+        write_u32_le(p + 24, big_unc ? 0xFFFFFFFFu : (uint32_t)e->uncompressed_size);
+        write_u16_le(p + 28, (unsigned)fn_len);
+        write_u16_le(p + 30, extra);
+        write_u16_le(p + 32, 0);               /* comment len */
+        write_u16_le(p + 34, 0);               /* disk */
+        write_u16_le(p + 36, 0);               /* internal attrs */
+        write_u32_le(p + 38, 0);               /* external attrs */
+        write_u32_le(p + 42, big_off ? 0xFFFFFFFFu : (uint32_t)e->local_header_offset);
+        memcpy(p + 46, h + 30, fn_len);
+        p += 46 + fn_len;
+        if (extra) {
+            write_u16_le(p, PAS_ZIP_ZIP64_EXTRA);
+            write_u16_le(p + 2, extra - 4);
+            p += 4;
+            if (big_unc) { write_u64_le(p, e->uncompressed_size); p += 8; }
+            if (big_comp) { write_u64_le(p, e->compressed_size); p += 8; }
+            if (big_off) { write_u64_le(p, e->local_header_offset); p += 8; }
+        }
+        wr->pos += 46 + fn_len + extra;
+    }
+    cd_size = wr->pos - cd_offset;
+
+    if (wr->count >= 0xFFFF || cd_offset >= 0xFFFFFFFFu || cd_size >= 0xFFFFFFFFu) {
+        uint64_t rec = wr->pos;
+        if (wr->out_size - wr->pos < 56 + 20) return (size_t)writer_fail(wr, PAS_ZIP_E_NOSPACE, status);
+        p = wr->out + wr->pos;
+        write_u32_le(p, PAS_ZIP_EOCD64_SIG);
+        write_u64_le(p + 4, 44);               /* size of the rest of the record */
+        write_u16_le(p + 12, 45);
+        write_u16_le(p + 14, 45);
+        write_u32_le(p + 16, 0);               /* disk numbers */
+        write_u32_le(p + 20, 0);
+        write_u64_le(p + 24, wr->count);
+        write_u64_le(p + 32, wr->count);
+        write_u64_le(p + 40, cd_size);
+        write_u64_le(p + 48, cd_offset);
+        write_u32_le(p + 56, PAS_ZIP_EOCD64_LOC_SIG);
+        write_u32_le(p + 60, 0);
+        write_u64_le(p + 64, rec);
+        write_u32_le(p + 72, 1);               /* total disks */
+        wr->pos += 56 + 20;
+    }
+
+    if (wr->out_size - wr->pos < 22) return (size_t)writer_fail(wr, PAS_ZIP_E_NOSPACE, status);
+    p = wr->out + wr->pos;
+    write_u32_le(p, PAS_ZIP_EOCD_SIG);
+    write_u32_le(p + 4, 0);                    /* disk numbers */
+    write_u16_le(p + 8, wr->count >= 0xFFFF ? 0xFFFFu : (unsigned)wr->count);
+    write_u16_le(p + 10, wr->count >= 0xFFFF ? 0xFFFFu : (unsigned)wr->count);
+    write_u32_le(p + 12, cd_size >= 0xFFFFFFFFu ? 0xFFFFFFFFu : (uint32_t)cd_size);
+    write_u32_le(p + 16, cd_offset >= 0xFFFFFFFFu ? 0xFFFFFFFFu : (uint32_t)cd_offset);
+    write_u16_le(p + 20, 0);                   /* comment len */
+    wr->pos += 22;
+
+    if (status) *status = PAS_ZIP_OK;
+    return wr->pos;
+}
+
+/* ----- Parallel Deflate -----
+   The workers start once per call and take block indices from a shared counter until the chunk
+   is done. Each compresses into its own output slot, then waits for its block's turn and appends
+   the slot to the archive, so the output stays in block order. A slot holds the worst case of a
+   block (all stored sub-blocks plus headers and the sync flush). */
+
+#define PAS_ZIP_BLOCK_BOUND(n) ((n) + ((n) >> 10) + 64)
+#define PAS_ZIP_ALIGN64(n)     (((n) + 63) & ~(size_t)63)
+
+typedef struct {
+    pas_zip_deflate_t *state;
+    uint8_t           *out;
+    size_t             out_size;
+} pas_zip__pslot_t;
+
+typedef struct {
+    pas_zip_writer_t       *wr;
+    pas_zip_writer_entry_t *entry;
+    const uint8_t          *data;
+    size_t                  size;
+    size_t                  block_size;
+    size_t                  nblocks;
+    size_t                  prime;   /* bytes of block 0 compressed behind the writer's history */
+    size_t                  next;    /* next block to take */
+    size_t                  done;    /* blocks appended (or skipped after an error) */
+    pas_zip_status          error;   /* only touched by the block whose turn it is */
+    int                     level;
+#ifdef PAS_ZIP_USE_THREADS
+    pas_zip__mutex_t        lock;
+    pas_zip__cond_t         turn;
+#endif
+    pas_zip__pslot_t        slots[PAS_ZIP_MAX_THREADS];
+} pas_zip__parallel_t;
+
+static size_t parallel_take(pas_zip__parallel_t *pc) {
+#if defined(PAS_ZIP_USE_THREADS) && defined(__GNUC__)
+    return __atomic_fetch_add(&pc->next, 1, __ATOMIC_RELAXED);
+#elif defined(PAS_ZIP_USE_THREADS)
+    size_t i;
+    PAS_ZIP_MUTEX_LOCK(&pc->lock);
+    i = pc->next++;
+    PAS_ZIP_MUTEX_UNLOCK(&pc->lock);
+    return i;
+#else
+    return pc->next++;
+#endif
+}
+
+/* After an error: no more blocks are taken */
+static void parallel_stop(pas_zip__parallel_t *pc) {
+#if defined(PAS_ZIP_USE_THREADS) && defined(__GNUC__)
+    __atomic_store_n(&pc->next, pc->nblocks, __ATOMIC_RELAXED);
+#elif defined(PAS_ZIP_USE_THREADS)
+    PAS_ZIP_MUTEX_LOCK(&pc->lock);
+    pc->next = pc->nblocks;
+    PAS_ZIP_MUTEX_UNLOCK(&pc->lock);
+#else
+    pc->next = pc->nblocks;
+#endif
+}
+
+static void parallel_wait_turn(pas_zip__parallel_t *pc, size_t block) {
+#ifdef PAS_ZIP_USE_THREADS
+    PAS_ZIP_MUTEX_LOCK(&pc->lock);
+    while (pc->done != block) PAS_ZIP_COND_WAIT(&pc->turn, &pc->lock);
+    PAS_ZIP_MUTEX_UNLOCK(&pc->lock);
+#else
+    (void)pc;
+    (void)block;
+#endif
+}
+
+static void parallel_end_turn(pas_zip__parallel_t *pc) {
+#ifdef PAS_ZIP_USE_THREADS
+    PAS_ZIP_MUTEX_LOCK(&pc->lock);
+    pc->done++;
+    PAS_ZIP_COND_BROADCAST(&pc->turn);
+    PAS_ZIP_MUTEX_UNLOCK(&pc->lock);
+#else
+    pc->done++;
+#endif
+}
+
+static void parallel_worker(void *arg, int worker) {
+    pas_zip__parallel_t *pc = (pas_zip__parallel_t *)arg;
+    pas_zip__pslot_t *s = &pc->slots[worker];
+    pas_zip_writer_t *wr = pc->wr;
+    size_t block;
+
+    while ((block = parallel_take(pc)) < pc->nblocks) {
+        size_t start = block * pc->block_size, hist, len;
+        pas_zip__bitwriter_t w;
+        uint32_t crc;
+
+        len = pc->size - start < pc->block_size ? pc->size - start : pc->block_size;
+        bw_init(&w, s->out, s->out_size);
+        if (block == 0 && pc->prime > 0) {
+            /* Continue the entry's stream: the first 32 KB sit behind the history in the writer's
+               window, the rest finds its 32 KB of history in data */
+            deflate_range(s->state, pc->level, wr->window, wr->hist_len, wr->hist_len + pc->prime, &w, 0);
+            if (len > pc->prime) deflate_range(s->state, pc->level, pc->data, pc->prime, len, &w, 0);
+        } else {
+            hist = start < PAS_ZIP_WINDOW_SIZE ? start : PAS_ZIP_WINDOW_SIZE;
+            deflate_range(s->state, pc->level, pc->data + start - hist, hist, hist + len, &w, 0);
+        }
+        /* Sync flush: an empty stored block pads to a byte boundary, so the next block's bytes can
+           follow directly. Already on one: just write out the pending bits. */
+        if (w.bitcount & 7) deflate_stored(&w, pc->data, 0, 0);
+        else bw_align(&w);
+        crc = pas_zip_crc32(0, pc->data + start, len);
+
+        parallel_wait_turn(pc, block);
+        if (pc->error == PAS_ZIP_OK) {
+            if (w.overflow || wr->out_size - wr->pos < w.pos) {
+                pc->error = PAS_ZIP_E_NOSPACE;
+                parallel_stop(pc);
+            } else {
+                memcpy(wr->out + wr->pos, s->out, w.pos);
+                wr->pos += w.pos;
+                pc->entry->crc32 = pas_zip_crc32_combine(pc->entry->crc32, crc, len);
+                pc->entry->uncompressed_size += len;
+            }
+        }
+        parallel_end_turn(pc);
+    }
+}
+
+size_t pas_zip_writer_parallel_size(int thread_count, size_t block_size) {
+    if (thread_count < 1) thread_count = 1;
+    if (thread_count > PAS_ZIP_MAX_THREADS) thread_count = PAS_ZIP_MAX_THREADS;
+    if (block_size == 0) block_size = PAS_ZIP_PARALLEL_BLOCK;
+    return (size_t)thread_count *
+           (PAS_ZIP_ALIGN64(sizeof(pas_zip_deflate_t)) + PAS_ZIP_ALIGN64(PAS_ZIP_BLOCK_BOUND(block_size)));
+}
+
+int pas_zip_writer_add_chunk_parallel(pas_zip_writer_t *wr, const void *data, size_t size,
+                                      int thread_count, size_t block_size, void *scratch,
+                                      size_t scratch_size, pas_zip_status *status) {
+    pas_zip__parallel_t pc;
+    pas_zip__bitwriter_t w;
+    uint8_t *slot_mem = (uint8_t *)scratch;
+    size_t nblocks;
+    int t;
+
+    if (status) *status = PAS_ZIP_E_INVALID;
+    if (!wr || (!data && size) || wr->finished || block_size > 0x40000000u) return 0; /* positions are uint32 */
+    if (wr->error != PAS_ZIP_OK) return writer_fail(wr, wr->error, status);
+    if (!wr->open) return 0;
+    if (wr->level == 0 || size == 0) return pas_zip_writer_add_chunk(wr, data, size, status);
+
+    if (thread_count < 1) thread_count = 1;
+    if (thread_count > PAS_ZIP_MAX_THREADS) thread_count = PAS_ZIP_MAX_THREADS;
+    if (block_size == 0) block_size = PAS_ZIP_PARALLEL_BLOCK;
+    if (!scratch || scratch_size < pas_zip_writer_parallel_size(thread_count, block_size)) {
+        if (status) *status = PAS_ZIP_E_NOSPACE;
+        return 0;
+    }
+    nblocks = (size - 1) / block_size + 1;
+    if ((size_t)thread_count > nblocks) thread_count = (int)nblocks;
+
+    /* Compress what add_chunk has buffered, then bring the stream to a byte boundary */
+    if (wr->fill > 0) {
+        writer_deflate(wr, 0);
+        if (wr->error != PAS_ZIP_OK) return writer_fail(wr, wr->error, status);
+    }
+    bw_init(&w, wr->out + wr->pos, wr->out_size - wr->pos);
+    w.bitbuf = wr->bitbuf;
+    w.bitcount = wr->bitcount;
+    if (w.bitcount & 7) deflate_stored(&w, wr->window, 0, 0);
+    else bw_align(&w);
+    if (w.overflow) return writer_fail(wr, PAS_ZIP_E_NOSPACE, status);
+    wr->pos += w.pos;
+    wr->bitbuf = 0;
+    wr->bitcount = 0;
+
+    for (t = 0; t < thread_count; t++) {
+        pc.slots[t].state = (pas_zip_deflate_t *)(void *)slot_mem;
+        slot_mem += PAS_ZIP_ALIGN64(sizeof(pas_zip_deflate_t));
+        pc.slots[t].out = slot_mem;
+        pc.slots[t].out_size = PAS_ZIP_BLOCK_BOUND(block_size);
+        slot_mem += PAS_ZIP_ALIGN64(PAS_ZIP_BLOCK_BOUND(block_size));
+    }
+    pc.wr = wr;
+    pc.entry = &wr->entries[wr->count - 1];
+    pc.data = (const uint8_t *)data;
+    pc.size = size;
+    pc.block_size = block_size;
+    pc.nblocks = nblocks;
+    pc.next = 0;
+    pc.done = 0;
+    pc.error = PAS_ZIP_OK;
+    pc.level = wr->level;
+
+    /* Block 0 continues from the entry's history: its first 32 KB go into the window behind it */
+    pc.prime = 0;
+    if (wr->hist_len > 0) {
+        pc.prime = size < block_size ? size : block_size;
+        if (pc.prime > PAS_ZIP_WINDOW_SIZE) pc.prime = PAS_ZIP_WINDOW_SIZE;
+        memcpy(wr->window + wr->hist_len, data, pc.prime);
+    }
+
+#ifdef PAS_ZIP_USE_THREADS
+    PAS_ZIP_MUTEX_INIT(&pc.lock);
+    PAS_ZIP_COND_INIT(&pc.turn);
+#endif
+    run_workers(parallel_worker, &pc, thread_count);
+#ifdef PAS_ZIP_USE_THREADS
+    PAS_ZIP_COND_DESTROY(&pc.turn);
+    PAS_ZIP_MUTEX_DESTROY(&pc.lock);
+#endif
+    if (pc.error != PAS_ZIP_OK) return writer_fail(wr, pc.error, status);
+
+    /* The last 32 KB become the history for later add_chunk calls */
+    if (size >= PAS_ZIP_WINDOW_SIZE) {
+        memcpy(wr->window, pc.data + size - PAS_ZIP_WINDOW_SIZE, PAS_ZIP_WINDOW_SIZE);
+        wr->hist_len = PAS_ZIP_WINDOW_SIZE;
+    } else {
+        size_t keep = PAS_ZIP_WINDOW_SIZE - size < wr->hist_len ? PAS_ZIP_WINDOW_SIZE - size : wr->hist_len;
+        memmove(wr->window, wr->window + wr->hist_len - keep, keep);
+        memcpy(wr->window + keep, data, size);
+        wr->hist_len = keep + size;
+    }
+    if (status) *status = PAS_ZIP_OK;
+    return 1;
+}
+
 #endif /* PAS_ZIP_IMPLEMENTATION */
 
 #endif /* PAS_ZIP_H */
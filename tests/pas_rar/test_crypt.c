@@ -0,0 +1,848 @@
+/*
+    test_crypt.c - Test RAR5 decryption: SHA-256 / HMAC / PBKDF2 and AES-256 against published and
+    precomputed vectors, then archives encrypted by the small AES encoder below: stored and
+    compressed entries, password check values, MAC checksums, encrypted headers (rar -hp), an
+    entry split over volumes off a block boundary, volumes with their own header salts, and the
+    key slots (pas_rar_derive_keys).
+    From repo root: gcc -o tests/pas_rar/test_crypt tests/pas_rar/test_crypt.c -I.
+    (with -DPAS_RAR_USE_THREADS -lpthread the keys are derived on worker threads)
+*/
+
+#define PAS_RAR_IMPLEMENTATION
+#include "pas_rar.h"
+#include <stdio.h>
+#include <string.h>
+
+static int g_failed, g_assertions;
+
+#define ASSERT(cond) do { \
+    ++g_assertions; \
+    if (!(cond)) { (void)fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); ++g_failed; } \
+} while (0)
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+#define DATA_SIZE 20000
+#define LG2       4      /* 16 KDF rounds keep the archives quick to build */
+
+static uint8_t g_data[DATA_SIZE];
+static uint8_t g_arc[2 * DATA_SIZE + 4096];
+static uint8_t g_vol[2][DATA_SIZE + 1024];
+static uint8_t g_out[2 * DATA_SIZE + (1u << 20)];
+static uint8_t g_buf[DATA_SIZE + 64];
+static uint8_t g_head[1024];
+
+static const uint8_t k_salt_a[16] = { 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+                                      0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f };
+static const uint8_t k_salt_b[16] = { 0xb0, 0x0b, 0xb1, 0xe5, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+static const uint8_t k_salt_c[16] = { 0xc0, 0xff, 0xee, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+
+static int hex_is(const uint8_t *d, size_t n, const char *hex) {
+    unsigned v;
+    size_t i;
+    for (i = 0; i < n; i++) {
+        if (sscanf(hex + 2 * i, "%2x", &v) != 1 || d[i] != v) return 0;
+    }
+    return 1;
+}
+
+static void make_data(void) {
+    uint32_t x = 777;
+    size_t i;
+    for (i = 0; i < sizeof(g_data); i++) {
+        x = x * 1103515245u + 12345u;
+        g_data[i] = (uint8_t)(i % 5 ? x >> 24 : 'A' + i % 26);
+    }
+}
+
+/* ----- Reference encryption ----- */
+
+static uint8_t xtime(uint8_t x) { return (uint8_t)((x << 1) ^ ((x >> 7) * 0x1b)); }
+
+/* One AES-256 block, byte by byte as in FIPS-197 (the library only decrypts) */
+static void aes_encrypt(const uint8_t key[32], const uint8_t in[16], uint8_t out[16]) {
+    const uint8_t *sb = pas_rar__aes_sbox;
+    uint8_t w[240], s[16], t[16], rc = 1;
+    unsigned i, r, c;
+
+    memcpy(w, key, 32);
+    for (i = 32; i < 240; i += 4) {
+        uint8_t k[4];
+        memcpy(k, w + i - 4, 4);
+        if (i % 32 == 0) {
+            uint8_t k0 = k[0];
+            k[0] = (uint8_t)(sb[k[1]] ^ rc);
+            k[1] = sb[k[2]];
+            k[2] = sb[k[3]];
+            k[3] = sb[k0];
+            rc = xtime(rc);
+        } else if (i % 32 == 16) {
+            for (c = 0; c < 4; c++) k[c] = sb[k[c]];
+        }
+        for (c = 0; c < 4; c++) w[i + c] = (uint8_t)(w[i - 32 + c] ^ k[c]);
+    }
+    for (i = 0; i < 16; i++) s[i] = (uint8_t)(in[i] ^ w[i]);
+    for (r = 1; r <= 14; r++) {
+        for (i = 0; i < 16; i++) t[i] = sb[s[(i + 4 * (i % 4)) % 16]]; /* SubBytes, ShiftRows */
+        if (r < 14) {
+            for (c = 0; c < 16; c += 4) {
+                uint8_t a0 = t[c], a1 = t[c + 1], a2 = t[c + 2], a3 = t[c + 3], all = a0 ^ a1 ^ a2 ^ a3;
+                t[c] = (uint8_t)(a0 ^ all ^ xtime(a0 ^ a1));
+                t[c + 1] = (uint8_t)(a1 ^ all ^ xtime(a1 ^ a2));
+                t[c + 2] = (uint8_t)(a2 ^ all ^ xtime(a2 ^ a3));
+                t[c + 3] = (uint8_t)(a3 ^ all ^ xtime(a3 ^ a0));
+            }
+        }
+        for (i = 0; i < 16; i++) s[i] = (uint8_t)(t[i] ^ w[16 * r + i]);
+    }
+    memcpy(out, s, 16);
+}
+
+/* n bytes (a multiple of 16) in CBC mode */
+static void cbc_encrypt(const uint8_t key[32], const uint8_t iv[16], const uint8_t *in, uint8_t *out, size_t n) {
+    uint8_t x[16];
+    const uint8_t *prev = iv;
+    size_t at;
+    unsigned i;
+    for (at = 0; at < n; at += 16) {
+        for (i = 0; i < 16; i++) x[i] = (uint8_t)(in[at + i] ^ prev[i]);
+        aes_encrypt(key, x, out + at);
+        prev = out + at;
+    }
+}
+
+/* RAR5 KDF written out plainly: PBKDF2-HMAC-SHA256, block 1, the running sum taken after
+   2^lg2, then 16 and 32 more rounds */
+static void kdf(const char *pw, const uint8_t salt[16], unsigned lg2, uint8_t key[32], uint8_t hash_key[32],
+                uint8_t check[8]) {
+    pas_rar__hmac_t m;
+    uint8_t u[32], sum[32], msg[20];
+    unsigned r, i, rounds = (1u << lg2) + 32;
+
+    pas_rar__hmac_init(&m, (const uint8_t *)pw, strlen(pw));
+    memcpy(msg, salt, 16);
+    msg[16] = msg[17] = msg[18] = 0;
+    msg[19] = 1;
+    pas_rar__hmac(&m, msg, 20, u);
+    memcpy(sum, u, 32);
+    memset(check, 0, 8);
+    for (r = 1; r < rounds; r++) {
+        if (r == 1u << lg2) memcpy(key, sum, 32);
+        if (r == (1u << lg2) + 16) memcpy(hash_key, sum, 32);
+        pas_rar__hmac(&m, u, 32, u);
+        for (i = 0; i < 32; i++) sum[i] ^= u[i];
+    }
+    for (i = 0; i < 32; i++) check[i % 8] ^= sum[i];
+}
+
+/* ----- Archive builder ----- */
+
+static uint32_t crc32_buf(const uint8_t *p, size_t n) { return pas_rar_crc32(0, p, n); }
+
+static void put32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static size_t put_vint(uint8_t *p, uint64_t v) {
+    size_t n = 0;
+    while (v >= 0x80) {
+        p[n++] = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    p[n++] = (uint8_t)v;
+    return n;
+}
+
+/* Set by begin_headers: later headers are encrypted with this key */
+static int g_hcrypt;
+static uint8_t g_hkey[32];
+static uint8_t g_hiv = 1;
+
+/* RAR5 header: CRC32, size, then fields; the CRC covers size and fields. Encrypted: a fresh IV,
+   then the header padded to whole blocks and encrypted. */
+static size_t put_header(uint8_t *out, const uint8_t *fields, size_t n) {
+    size_t len = 4 + put_vint(g_head + 4, n), pad;
+    memcpy(g_head + len, fields, n);
+    len += n;
+    put32(g_head, crc32_buf(g_head + 4, len - 4));
+    if (!g_hcrypt) {
+        memcpy(out, g_head, len);
+        return len;
+    }
+    pad = (len + 15) & ~(size_t)15;
+    memset(g_head + len, 0xEE, pad - len);
+    memset(out, g_hiv++, 16);
+    cbc_encrypt(g_hkey, out, g_head, out + 16, pad);
+    return 16 + pad;
+}
+
+/* Encryption fields: version 0, flags, lg2, salt, [iv], [check value and its SHA-256 check] */
+static size_t put_crypt(uint8_t *p, const uint8_t salt[16], unsigned lg2, const uint8_t *iv, const uint8_t *check,
+                        int mac) {
+    size_t n = 0;
+    p[n++] = 0;
+    p[n++] = (uint8_t)((check ? 1 : 0) | (mac ? 2 : 0));
+    p[n++] = (uint8_t)lg2;
+    memcpy(p + n, salt, 16);
+    n += 16;
+    if (iv) {
+        memcpy(p + n, iv, 16);
+        n += 16;
+    }
+    if (check) {
+        pas_rar__sha256_t c;
+        uint8_t d[32];
+        memcpy(p + n, check, 8);
+        pas_rar__sha256_init(&c);
+        pas_rar__sha256_update(&c, check, 8);
+        pas_rar__sha256_final(&c, d);
+        memcpy(p + n + 8, d, 4);
+        n += 12;
+    }
+    return n;
+}
+
+static size_t begin_archive(uint8_t *out) {
+    static const uint8_t sig[8] = { 'R','a','r','!',0x1A,0x07,0x01,0x00 };
+    static const uint8_t main_hdr[3] = { 1, 0, 0 };
+    g_hcrypt = 0;
+    memcpy(out, sig, 8);
+    return 8 + put_header(out + 8, main_hdr, 3);
+}
+
+/* rar -hp: encryption header after the signature, main and later headers encrypted */
+static size_t begin_crypt_archive(uint8_t *out, const char *pw, const uint8_t salt[16], unsigned lg2) {
+    static const uint8_t sig[8] = { 'R','a','r','!',0x1A,0x07,0x01,0x00 };
+    static const uint8_t main_hdr[3] = { 1, 0, 0 };
+    uint8_t f[64], hash_key[32], check[8];
+    size_t n = 0, len = 8;
+
+    g_hcrypt = 0;
+    memcpy(out, sig, 8);
+    kdf(pw, salt, lg2, g_hkey, hash_key, check);
+    n += put_vint(f + n, 4);
+    n += put_vint(f + n, 0);
+    n += put_crypt(f + n, salt, lg2, NULL, check, 0);
+    len += put_header(out + len, f, n);
+    g_hcrypt = 1;
+    return len + put_header(out + len, main_hdr, 3);
+}
+
+static size_t end_archive(uint8_t *out) {
+    static const uint8_t end_hdr[3] = { 5, 0, 0 };
+    return put_header(out, end_hdr, 3);
+}
+
+/* One block of 8-bit literals: bit lengths 1 for symbols 8 and 19, then 256 literals of length 8
+   and 174 zero lengths (two runs of symbol 19), then the bytes themselves as their own codes */
+static size_t literal_stream(uint8_t *out, const uint8_t *d, size_t n) {
+    uint8_t t[44];
+    size_t size = sizeof(t) + n, len = 0;
+    unsigned count = size > 0xffff ? 3 : size > 0xff ? 2 : 1;
+    unsigned flags = 0x80 | 0x40 | ((count - 1) << 3) | 7, i;
+
+    memset(t, 0, sizeof(t));
+    t[4] = 0x10;
+    t[9] = 0x01;
+    t[42] = 0xff;  /* 1 1111111: 138 zeros */
+    t[43] = 0x99;  /* 1 0011001: 36 zeros */
+    out[len++] = (uint8_t)flags;
+    out[len++] = (uint8_t)(0x5a ^ flags ^ size ^ (size >> 8) ^ (size >> 16));
+    for (i = 0; i < count; i++) out[len++] = (uint8_t)(size >> (8 * i));
+    memcpy(out + len, t, sizeof(t));
+    memcpy(out + len + sizeof(t), d, n);
+    return len + size;
+}
+
+#define E_CHECK 1   /* password check value in the encryption record */
+#define E_MAC   2   /* CRC32 and BLAKE2sp stored as MACs */
+#define E_HASH  4   /* BLAKE2sp hash record besides the CRC32 */
+#define E_LZ    8   /* compressed (one literal block) instead of stored */
+#define E_PLAIN 16  /* not encrypted */
+
+/* RAR5 entry encrypted with pw; with cut, only the first cut bytes of its data and a second part
+   header (SPLIT_BEFORE) with the rest go to out2 */
+static size_t add_file(uint8_t *out, const char *name, const uint8_t *data, size_t size, const char *pw,
+                       const uint8_t salt[16], int with, uint8_t *out2, size_t cut, size_t *len2) {
+    static uint8_t body[DATA_SIZE + 256];
+    uint8_t f[256], extra[160], key[32], hash_key[32], check[8], iv[16];
+    size_t n, ne = 0, nl = strlen(name), bn, dn, len, part;
+    uint32_t crc = crc32_buf(data, size);
+    uint8_t digest[32];
+    unsigned i;
+    int p;
+
+    bn = with & E_LZ ? literal_stream(body, data, size) : (memcpy(body, data, size), size);
+    dn = bn;
+    pas_rar_blake2sp(data, size, digest);
+    if (!(with & E_PLAIN)) {
+        kdf(pw, salt, LG2, key, hash_key, check);
+        for (i = 0; i < 16; i++) iv[i] = (uint8_t)(name[0] + 3 * i);
+        dn = (bn + 15) & ~(size_t)15;
+        memset(body + bn, 0x5A, dn - bn);
+        cbc_encrypt(key, iv, body, body, dn);
+        if (with & E_MAC) {
+            crc = pas_rar__crc_mac(hash_key, crc);
+            pas_rar__blake2_mac(hash_key, digest);
+        }
+        extra[ne] = (uint8_t)(1 + put_crypt(extra + ne + 2, salt, LG2, iv, with & E_CHECK ? check : NULL,
+                                            with & E_MAC));
+        extra[ne + 1] = 1;
+        ne += 1 + extra[ne];
+    }
+    if (with & E_HASH) {
+        extra[ne++] = 34;
+        extra[ne++] = 2;
+        extra[ne++] = 0;
+        memcpy(extra + ne, digest, 32);
+        ne += 32;
+    }
+    len = 0;
+    for (p = 0; p < (out2 ? 2 : 1); p++) {
+        uint8_t *o = p ? out2 : out;
+        size_t hl, at = p ? cut : 0;
+        part = out2 ? (p ? dn - cut : cut) : dn;
+        n = 0;
+        n += put_vint(f + n, 2);
+        n += put_vint(f + n, (ne ? 0x03 : 0x02) | (out2 ? (p ? 0x08 : 0x10) : 0));
+        if (ne) n += put_vint(f + n, ne);
+        n += put_vint(f + n, part);
+        n += put_vint(f + n, 0x04);                     /* data CRC32 */
+        n += put_vint(f + n, size);
+        n += put_vint(f + n, 0);
+        put32(f + n, crc);
+        n += 4;
+        n += put_vint(f + n, with & E_LZ ? 0x80 : 0);   /* method 1, 128 KB window / store */
+        n += put_vint(f + n, 0);
+        n += put_vint(f + n, nl);
+        memcpy(f + n, name, nl);
+        n += nl;
+        memcpy(f + n, extra, ne);
+        n += ne;
+        hl = put_header(o, f, n);
+        memcpy(o + hl, body + at, part);
+        if (p) *len2 = hl + part;
+        else len = hl + part;
+    }
+    return len;
+}
+
+static size_t extract(pas_rar_t *rar, const char *name, pas_rar_status *st) {
+    pas_rar_file_t f;
+    *st = PAS_RAR_E_NOT_FOUND;
+    if (!pas_rar_find_ex(rar, name, &f)) return 0;
+    return pas_rar_extract(&f, g_out, sizeof(g_out), st);
+}
+
+static size_t used_slots(const pas_rar_key_t *k, size_t n) {
+    size_t i, used = 0;
+    for (i = 0; i < n; i++) used += k[i].used != 0;
+    return used;
+}
+
+/* ----- Tests ----- */
+
+static void test_primitives(void) {
+    static const uint8_t fips_key[32] = {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+    };
+    static const uint8_t fips_ct[16] = { 0x8e, 0xa2, 0xb7, 0xca, 0x51, 0x67, 0x45, 0xbf,
+                                         0xea, 0xfc, 0x49, 0x90, 0x4b, 0x49, 0x60, 0x89 };
+    static const char *fips_pt = "00112233445566778899aabbccddeeff";
+    pas_rar__sha256_t c;
+    pas_rar__hmac_t m;
+    uint8_t d[32], rk[240], iv[16], iv2[16], ct[16 * 37], a[16 * 37], b[16 * 37], big[131];
+    size_t i, bad;
+
+    pas_rar__sha256_init(&c);
+    pas_rar__sha256_final(&c, d);
+    ASSERT(hex_is(d, 32, "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"));
+    pas_rar__sha256_init(&c);
+    pas_rar__sha256_update(&c, (const uint8_t *)"abcdbcdecdefdefgefghfghighijhijk", 32);
+    pas_rar__sha256_update(&c, (const uint8_t *)"ijkljklmklmnlmnomnopnopq", 24);
+    pas_rar__sha256_final(&c, d);
+    ASSERT(hex_is(d, 32, "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"));
+
+    /* RFC 4231 cases 2 and 6 (a key longer than the block is hashed first) */
+    pas_rar__hmac_init(&m, (const uint8_t *)"Jefe", 4);
+    pas_rar__hmac(&m, (const uint8_t *)"what do ya want for nothing?", 28, d);
+    ASSERT(hex_is(d, 32, "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843"));
+    memset(big, 0xaa, sizeof(big));
+    pas_rar__hmac_init(&m, big, sizeof(big));
+    pas_rar__hmac(&m, (const uint8_t *)"Test Using Larger Than Block-Size Key - Hash Key First", 54, d);
+    ASSERT(hex_is(d, 32, "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54"));
+
+    /* FIPS-197 C.3: a zero IV makes the first CBC block plain AES */
+    pas_rar__aes_key(rk, fips_key);
+    memset(iv, 0, 16);
+    pas_rar__aes_cbc_c(rk, iv, fips_ct, d, 1);
+    ASSERT(hex_is(d, 16, fips_pt));
+    ASSERT(memcmp(iv, fips_ct, 16) == 0);
+    memset(iv, 0, 16);
+    pas_rar__aes_cbc(rk, iv, fips_ct, d, 1);
+    ASSERT(hex_is(d, 16, fips_pt));
+    aes_encrypt(fips_key, d, d);
+    ASSERT(memcmp(d, fips_ct, 16) == 0);
+
+    /* 37 blocks: the 8-wide AES-NI loop and its tail; in place and not, same as the portable path */
+    memset(iv, 0x42, 16);
+    cbc_encrypt(fips_key, iv, g_data, ct, sizeof(ct));
+    memcpy(a, ct, sizeof(ct));
+    pas_rar__aes_cbc(rk, iv, a, a, 37);
+    memcpy(iv2, "\x42\x42\x42\x42\x42\x42\x42\x42\x42\x42\x42\x42\x42\x42\x42\x42", 16);
+    pas_rar__aes_cbc_c(rk, iv2, ct, b, 37);
+    ASSERT(memcmp(a, g_data, sizeof(a)) == 0);
+    ASSERT(memcmp(b, g_data, sizeof(b)) == 0);
+    ASSERT(memcmp(iv, ct + sizeof(ct) - 16, 16) == 0);
+    ASSERT(memcmp(iv2, iv, 16) == 0);
+    /* Any split of the run continues the chain */
+    for (i = 0, bad = 0; i <= 37; i++) {
+        memset(iv, 0x42, 16);
+        pas_rar__aes_cbc(rk, iv, ct, a, i);
+        pas_rar__aes_cbc(rk, iv, ct + 16 * i, a + 16 * i, 37 - i);
+        bad += memcmp(a, g_data, sizeof(a)) != 0;
+    }
+    ASSERT_EQ(bad, 0u);
+}
+
+/* Key, MAC key and check value from a PBKDF2 implementation elsewhere (Python hashlib) */
+static void test_kdf(void) {
+    pas_rar_key_t k;
+    uint8_t key[32], hash_key[32], check[8], rk[240];
+
+    memset(&k, 0, sizeof(k));
+    memcpy(k.salt, k_salt_a, 16);
+    k.lg2_count = 5;
+    pas_rar__derive("password", 8, &k);
+    ASSERT(hex_is(k.check, 8, "0f58d889d6ca0908"));
+    ASSERT(hex_is(k.hash_key, 32, "a73c052e0fdf1019517b4211c9b00fb47858ddfdb50ef9a5371bb611f25893ec"));
+    kdf("password", k_salt_a, 5, key, hash_key, check);
+    ASSERT(hex_is(key, 32, "6260b58333bff37c5aafbe2b606e7d1d596ee594a73ae6dde787b2f03f12b123"));
+    ASSERT(memcmp(hash_key, k.hash_key, 32) == 0);
+    ASSERT(memcmp(check, k.check, 8) == 0);
+    pas_rar__aes_key(rk, key);
+    ASSERT(memcmp(rk, k.round_keys, 240) == 0);
+    ASSERT_EQ(pas_rar__crc_mac(k.hash_key, 0x12345678u), 0x8bdaa282u);
+
+    /* The default 2^15 rounds, the fast loop against the plain one */
+    memcpy(k.salt, k_salt_b, 16);
+    k.lg2_count = 15;
+    pas_rar__derive("p\xc3\xa4ss", 5, &k);
+    kdf("p\xc3\xa4ss", k_salt_b, 15, key, hash_key, check);
+    ASSERT(memcmp(check, k.check, 8) == 0);
+    ASSERT(memcmp(hash_key, k.hash_key, 32) == 0);
+}
+
+static size_t make_stored(uint8_t *out) {
+    size_t len = begin_archive(out);
+    len += add_file(out + len, "plain.txt", (const uint8_t *)"not encrypted", 13, NULL, NULL, E_PLAIN, NULL, 0, NULL);
+    len += add_file(out + len, "secret.txt", (const uint8_t *)"attack at dawn", 14, "hunter2", k_salt_a, E_CHECK,
+                    NULL, 0, NULL);
+    len += add_file(out + len, "mac.bin", g_data, DATA_SIZE - 5, "hunter2", k_salt_a, E_CHECK | E_MAC | E_HASH,
+                    NULL, 0, NULL);
+    len += add_file(out + len, "blocks.bin", g_data, 64, "hunter2", k_salt_b, E_HASH, NULL, 0, NULL);
+    len += add_file(out + len, "empty", g_data, 0, "hunter2", k_salt_b, E_CHECK, NULL, 0, NULL);
+    return len + end_archive(out + len);
+}
+
+static void test_stored(void) {
+    pas_rar_t rar;
+    pas_rar_file_t f;
+    pas_rar_status st;
+    pas_rar_seq_t seq;
+    pas_rar_unpack_t state;
+    pas_rar_key_t keys[4];
+    size_t len = make_stored(g_arc), n;
+
+    ASSERT(pas_rar_open_ex(&rar, g_arc, len, &st));
+    ASSERT_EQ(rar.crypt_headers, 0);
+    ASSERT(pas_rar_find_ex(&rar, "plain.txt", &f));
+    ASSERT_EQ(f.crypt, 0);
+    ASSERT(pas_rar_find_ex(&rar, "secret.txt", &f));
+    ASSERT_EQ(f.crypt, PAS_RAR_CRYPT_DATA | PAS_RAR_CRYPT_CHECK);
+    ASSERT_EQ(f.lg2_count, LG2);
+    ASSERT(memcmp(f.salt, k_salt_a, 16) == 0);
+    ASSERT_EQ(f.unpacked_size, 14u);
+    ASSERT_EQ(f.packed_size, 16u);
+    ASSERT(pas_rar_find_ex(&rar, "mac.bin", &f));
+    ASSERT_EQ(f.crypt, PAS_RAR_CRYPT_DATA | PAS_RAR_CRYPT_CHECK | PAS_RAR_CRYPT_MAC);
+    ASSERT(pas_rar_find_ex(&rar, "blocks.bin", &f));
+    ASSERT_EQ(f.crypt, PAS_RAR_CRYPT_DATA);
+
+    /* No password */
+    ASSERT_EQ(extract(&rar, "secret.txt", &st), 0u);
+    ASSERT_EQ(st, PAS_RAR_E_PASSWORD);
+    ASSERT_EQ(extract(&rar, "plain.txt", &st), 13u);
+    ASSERT_EQ(st, PAS_RAR_OK);
+
+    /* Wrong password: refused by the check value; without one the CRC catches it */
+    ASSERT(pas_rar_set_password(&rar, "hunter3", 7, keys, 4, &st));
+    ASSERT_EQ(extract(&rar, "secret.txt", &st), 0u);
+    ASSERT_EQ(st, PAS_RAR_E_PASSWORD);
+    ASSERT_EQ(extract(&rar, "blocks.bin", &st), 64u);
+    ASSERT(memcmp(g_out, g_data, 64) != 0);
+    rar.verify = 1;
+    ASSERT_EQ(extract(&rar, "blocks.bin", &st), 0u);
+    ASSERT_EQ(st, PAS_RAR_E_CRC);
+
+    /* Right password; the slots cleared, extraction derives keys without storing them, then
+       pas_rar_derive_keys fills one per salt */
+    ASSERT(pas_rar_set_password(&rar, "hunter2", 7, keys, 4, &st));
+    ASSERT_EQ(used_slots(keys, 4), 0u);
+    ASSERT_EQ(extract(&rar, "secret.txt", &st), 14u);
+    ASSERT_EQ(st, PAS_RAR_OK);
+    ASSERT(memcmp(g_out, "attack at dawn", 14) == 0);
+    ASSERT_EQ(used_slots(keys, 4), 0u);
+    ASSERT(pas_rar_derive_keys(&rar, 1, &st));
+    ASSERT_EQ(used_slots(keys, 4), 2u);
+    ASSERT(memcmp(keys[0].salt, k_salt_a, 16) == 0);
+    ASSERT(memcmp(keys[1].salt, k_salt_b, 16) == 0);
+    n = extract(&rar, "mac.bin", &st);
+    ASSERT_EQ(n, DATA_SIZE - 5u);
+    ASSERT_EQ(st, PAS_RAR_OK);
+    ASSERT(memcmp(g_out, g_data, DATA_SIZE - 5) == 0);
+    ASSERT_EQ(extract(&rar, "blocks.bin", &st), 64u);
+    ASSERT_EQ(st, PAS_RAR_OK);
+    ASSERT(memcmp(g_out, g_data, 64) == 0);
+    ASSERT_EQ(extract(&rar, "empty", &st), 0u);
+    ASSERT_EQ(st, PAS_RAR_OK);
+    ASSERT_EQ(used_slots(keys, 4), 2u);
+
+    /* Sequentially; then without key slots at all */
+    ASSERT(pas_rar_seq_begin(&seq, &rar, &state, NULL, 0, &st));
+    ASSERT(pas_rar_seq_next(&seq, &f, &st));
+    ASSERT(pas_rar_seq_next(&seq, &f, &st));
+    ASSERT(pas_rar_seq_next(&seq, &f, &st));
+    ASSERT_EQ(pas_rar_seq_extract(&seq, g_out, sizeof(g_out), &st), DATA_SIZE - 5u);
+    ASSERT_EQ(st, PAS_RAR_OK);
+    ASSERT(pas_rar_set_password(&rar, "hunter2", 7, NULL, 0, &st));
+    ASSERT_EQ(extract(&rar, "secret.txt", &st), 14u);
+    ASSERT_EQ(st, PAS_RAR_OK);
+
+    /* MAC checksums: a flipped byte fails, the plain CRC32 of the data is not what is stored */
+    ASSERT(pas_rar_find_ex(&rar, "mac.bin", &f));
+    ASSERT(f.crc32 != crc32_buf(g_data, DATA_SIZE - 5));
+    g_arc[f.data_offset + 1000] ^= 1;
+    ASSERT_EQ(extract(&rar, "mac.bin", &st), 0u);
+    ASSERT_EQ(st, PAS_RAR_E_CRC);
+    g_arc[f.data_offset + 1000] ^= 1;
+
+    /* Removed */
+    ASSERT(pas_rar_set_password(&rar, NULL, 0, NULL, 0, &st));
+    ASSERT_EQ(extract(&rar, "secret.txt", &st), 0u);
+    ASSERT_EQ(st, PAS_RAR_E_PASSWORD);
+}
+
+static void test_compressed(void) {
+    pas_rar_t rar;
+    pas_rar_file_t f;
+    pas_rar_status st;
+    pas_rar_seq_t seq;
+    pas_rar_key_t keys[2];
+    static pas_rar_unpack_t state;
+    static uint8_t window[1u << 17];
+    size_t len = begin_archive(g_arc);
+
+    len += add_file(g_arc + len, "lz.bin", g_data, DATA_SIZE, "pw", k_salt_c, E_CHECK | E_MAC | E_LZ | E_HASH,
+                    NULL, 0, NULL);
+    len += add_file(g_arc + len, "lz.txt", (const uint8_t *)"short", 5, "pw", k_salt_c, E_LZ, NULL, 0, NULL);
+    len += end_archive(g_arc + len);
+
+    ASSERT(pas_rar_open_ex(&rar, g_arc, len, &st));
+    rar.verify = 1;
+    ASSERT(pas_rar_set_password(&rar, "pw", 2, keys, 2, &st));
+    ASSERT(pas_rar_find_ex(&rar, "lz.bin", &f));
+    ASSERT(pas_rar_is_compressed(&f));
+    ASSERT_EQ(f.packed_size % 16, 0u);
+    ASSERT_EQ(pas_rar_extract(&f, g_out, sizeof(g_out), &st), (size_t)DATA_SIZE);
+    ASSERT_EQ(st, PAS_RAR_OK);
+    ASSERT(memcmp(g_out, g_data, DATA_SIZE) == 0);
+    ASSERT_EQ(pas_rar_extract_ex(&f, g_out, DATA_SIZE, &state, window, sizeof(window), &st), (size_t)DATA_SIZE);
+    ASSERT_EQ(st, PAS_RAR_OK);
+    ASSERT_EQ(extract(&rar, "lz.txt", &st), 5u);
+    ASSERT(memcmp(g_out, "short", 5) == 0);
+
+    ASSERT(pas_rar_seq_begin(&seq, &rar, &state, window, sizeof(window), &st));
+    ASSERT(pas_rar_seq_next(&seq, &f, &st));
+    ASSERT(pas_rar_seq_next(&seq, &f, &st)); /* lz.bin decoded nowhere, not needed */
+    ASSERT_EQ(pas_rar_seq_extract(&seq, g_out, sizeof(g_out), &st), 5u);
+    ASSERT_EQ(st, PAS_RAR_OK);
+
+    ASSERT(pas_rar_set_password(&rar, "wp", 2, keys, 2, &st));
+    ASSERT_EQ(extract(&rar, "lz.bin", &st), 0u);
+    ASSERT_EQ(st, PAS_RAR_E_PASSWORD);
+}
+
+typedef struct {
+    int  count;
+    char names[4][80];
+} list_ctx;
+
+static void list_cb(const char *name, uint64_t size, void *user) {
+    list_ctx *c = (list_ctx *)user;
+    (void)size;
+    if (c->count < 4) (void)snprintf(c->names[c->count], sizeof(c->names[0]), "%s", name);
+    c->count++;
+}
+
+static void test_headers(void) {
+    static const char *long_name = "a/directory/deep/enough/for/more/than/one/aes/block/and/then/some.txt";
+    pas_rar_t rar;
+    pas_rar_file_t f;
+    pas_rar_file_t *pf;
+    pas_rar_status st;
+    pas_rar_key_t keys[2];
+    pas_rar_index_slot_t table[16];
+    list_ctx lc;
+    char name[100];
+    size_t len = begin_crypt_archive(g_arc, "hidden", k_salt_b, LG2), span;
+
+    len += add_file(g_arc + len, "first.txt", (const uint8_t *)"one", 3, "hidden", k_salt_b, E_CHECK, NULL, 0, NULL);
+    len += add_file(g_arc + len, long_name, g_data, 999, "hidden", k_salt_b, E_CHECK | E_MAC | E_LZ, NULL, 0, NULL);
+    len += add_file(g_arc + len, "third.txt", (const uint8_t *)"three", 5, "hidden", k_salt_b, E_CHECK, NULL, 0, NULL);
+    g_hcrypt = 1;
+    len += end_archive(g_arc + len);
+    g_hcrypt = 0;
+
+    ASSERT(pas_rar_open_ex(&rar, g_arc, len, &st));
+    ASSERT_EQ(rar.crypt_headers, 1);
+    ASSERT(!pas_rar_find_ex(&rar, "first.txt", &f));
+    ASSERT(!pas_rar_set_password(&rar, "hidden", 6, NULL, 0, &st));
+    ASSERT_EQ(st, PAS_RAR_E_NOSPACE);
+    ASSERT(!pas_rar_set_password(&rar, "hiding", 6, keys, 2, &st));
+    ASSERT_EQ(st, PAS_RAR_E_PASSWORD);
+    ASSERT(rar.password == NULL);
+    ASSERT(pas_rar_set_password(&rar, "hidden", 6, keys, 2, &st));
+    ASSERT_EQ(st, PAS_RAR_OK);
+
+    ASSERT(pas_rar_find_ex(&rar, "third.txt", &f));
+    ASSERT_EQ(f.crypt, PAS_RAR_CRYPT_DATA | PAS_RAR_CRYPT_CHECK | PAS_RAR_CRYPT_HEADER);
+    ASSERT(pas_rar_name_span(&f, &span) == NULL);
+    ASSERT_EQ(span, 0u);
+    ASSERT_EQ(pas_rar_name_copy(&f, name, sizeof(name)), 9u);
+    ASSERT(strcmp(name, "third.txt") == 0);
+    ASSERT_EQ(pas_rar_name_copy(&f, name, 6), 5u);
+    ASSERT(strcmp(name, "third") == 0);
+    ASSERT(!pas_rar_find_ex(&rar, "third.tx", &f));
+    ASSERT(!pas_rar_find_ex(&rar, "third.txx", &f));
+
+    pf = pas_rar_find(&rar, long_name);
+    ASSERT(pf != NULL);
+    if (pf) {
+        ASSERT(strcmp(pas_rar_name(pf), long_name) == 0);
+        rar.verify = 1;
+        ASSERT_EQ(pas_rar_extract(pf, g_out, sizeof(g_out), &st), 999u);
+        ASSERT_EQ(st, PAS_RAR_OK);
+        ASSERT(memcmp(g_out, g_data, 999) == 0);
+    }
+    memset(&lc, 0, sizeof(lc));
+    ASSERT_EQ(pas_rar_list(&rar, list_cb, &lc), 0);
+    ASSERT_EQ(lc.count, 3);
+    ASSERT(strcmp(lc.names[0], "first.txt") == 0);
+    ASSERT(strcmp(lc.names[1], long_name) == 0);
+
+    ASSERT(pas_rar_index_build(&rar, table, 16, &st));
+    ASSERT(pas_rar_find_ex(&rar, "first.txt", &f));
+    ASSERT_EQ(pas_rar_extract(&f, g_out, sizeof(g_out), &st), 3u);
+    ASSERT(memcmp(g_out, "one", 3) == 0);
+    ASSERT(pas_rar_find_ex(&rar, long_name, &f));
+    ASSERT(!pas_rar_find_ex(&rar, "first.txu", &f));
+    ASSERT_EQ(used_slots(keys, 2), 1u); /* files share the header salt */
+}
+
+/* One entry's ciphertext cut at byte 1001 (mid-block) between two volumes */
+static void test_volumes(void) {
+    pas_rar_volume_t vols[2];
+    pas_rar_t rar;
+    pas_rar_file_t f;
+    pas_rar_status st;
+    pas_rar_key_t keys[1];
+    pas_rar_seq_t seq;
+    static pas_rar_unpack_t state;
+    size_t len0 = begin_archive(g_vol[0]), len1 = begin_archive(g_vol[1]), part = 0;
+
+    len0 += add_file(g_vol[0] + len0, "split.bin", g_data, 5000, "vol", k_salt_a, E_CHECK | E_MAC | E_HASH,
+                     g_buf, 1001, &part);
+    len0 += end_archive(g_vol[0] + len0);
+    memcpy(g_vol[1] + len1, g_buf, part);
+    len1 += part;
+    len1 += add_file(g_vol[1] + len1, "lz.bin", g_data, 3000, "vol", k_salt_a, E_CHECK | E_LZ, NULL, 0, NULL);
+    len1 += end_archive(g_vol[1] + len1);
+    vols[0].data = g_vol[0];
+    vols[0].size = len0;
+    vols[1].data = g_vol[1];
+    vols[1].size = len1;
+
+    ASSERT(pas_rar_open_volumes(&rar, vols, 2, &st));
+    ASSERT(pas_rar_set_password(&rar, "vol", 3, keys, 1, &st));
+    rar.verify = 1;
+    ASSERT(pas_rar_find_ex(&rar, "split.bin", &f));
+    ASSERT_EQ(f.packed_size, 5008u);
+    ASSERT_EQ(f.part_size, 1001u);
+    ASSERT_EQ(pas_rar_extract(&f, g_out, sizeof(g_out), &st), 5000u);
+    ASSERT_EQ(st, PAS_RAR_OK);
+    ASSERT(memcmp(g_out, g_data, 5000) == 0);
+    ASSERT_EQ(extract(&rar, "lz.bin", &st), 3000u);
+    ASSERT_EQ(st, PAS_RAR_OK);
+
+    ASSERT(pas_rar_seq_begin(&seq, &rar, &state, g_out + DATA_SIZE, 1u << 17, &st));
+    ASSERT(pas_rar_seq_next(&seq, &f, &st));
+    ASSERT_EQ(pas_rar_seq_extract(&seq, g_out, DATA_SIZE, &st), 5000u);
+    ASSERT(pas_rar_seq_next(&seq, &f, &st));
+    ASSERT_EQ(pas_rar_seq_extract(&seq, g_out, DATA_SIZE, &st), 3000u);
+    ASSERT_EQ(st, PAS_RAR_OK);
+    ASSERT(memcmp(g_out, g_data, 3000) == 0);
+}
+
+/* Volumes with encrypted headers under different salts: pas_rar_derive_keys fills a slot for each
+   header salt, so header walks find every key cached */
+static void test_volume_headers(void) {
+    pas_rar_volume_t vols[2];
+    pas_rar_t rar;
+    pas_rar_file_t f;
+    pas_rar_status st;
+    pas_rar_key_t keys[4];
+    pas_rar_index_slot_t table[16];
+    size_t len0 = begin_crypt_archive(g_vol[0], "vol", k_salt_b, LG2), len1;
+
+    len0 += add_file(g_vol[0] + len0, "one.txt", g_data, 700, "vol", k_salt_a, E_CHECK, NULL, 0, NULL);
+    len0 += end_archive(g_vol[0] + len0);
+    len1 = begin_crypt_archive(g_vol[1], "vol", k_salt_c, LG2);
+    len1 += add_file(g_vol[1] + len1, "two.txt", g_data + 700, 900, "vol", k_salt_a, E_CHECK, NULL, 0, NULL);
+    len1 += end_archive(g_vol[1] + len1);
+    g_hcrypt = 0;
+    vols[0].data = g_vol[0];
+    vols[0].size = len0;
+    vols[1].data = g_vol[1];
+    vols[1].size = len1;
+
+    ASSERT(pas_rar_open_volumes(&rar, vols, 2, &st));
+    ASSERT(pas_rar_set_password(&rar, "vol", 3, keys, 4, &st));
+    ASSERT_EQ(used_slots(keys, 4), 1u); /* the first volume's header key */
+    ASSERT(pas_rar_derive_keys(&rar, 2, &st));
+    ASSERT_EQ(st, PAS_RAR_OK);
+    ASSERT_EQ(used_slots(keys, 4), 3u);
+    ASSERT(memcmp(keys[0].salt, k_salt_b, 16) == 0);
+    ASSERT(memcmp(keys[1].salt, k_salt_c, 16) == 0);
+    ASSERT(memcmp(keys[2].salt, k_salt_a, 16) == 0);
+
+    /* A wrong password would fail any key derived again: everything comes from the slots */
+    rar.password = "xxx";
+    ASSERT(pas_rar_index_build(&rar, table, 16, &st));
+    ASSERT(pas_rar_find_ex(&rar, "two.txt", &f));
+    ASSERT_EQ(f.volume, 1u);
+    ASSERT_EQ(pas_rar_extract(&f, g_out, sizeof(g_out), &st), 900u);
+    ASSERT(memcmp(g_out, g_data + 700, 900) == 0);
+    ASSERT_EQ(extract(&rar, "one.txt", &st), 700u);
+    ASSERT_EQ(used_slots(keys, 4), 3u);
+}
+
+static void test_derive(void) {
+    pas_rar_t rar;
+    pas_rar_status st;
+    pas_rar_key_t keys[4], small[2];
+    size_t len = begin_archive(g_arc), i, bad;
+    static const char *names[5] = { "a", "b", "c", "d", "e" };
+    const uint8_t *salts[5];
+
+    salts[0] = k_salt_a;
+    salts[1] = k_salt_b;
+    salts[2] = k_salt_a;
+    salts[3] = k_salt_c;
+    salts[4] = k_salt_b;
+    for (i = 0; i < 5; i++)
+        len += add_file(g_arc + len, names[i], g_data + 100 * i, 100, "many", salts[i], E_CHECK, NULL, 0, NULL);
+    len += end_archive(g_arc + len);
+
+    ASSERT(pas_rar_open_ex(&rar, g_arc, len, &st));
+    ASSERT(!pas_rar_derive_keys(&rar, 4, &st));
+    ASSERT_EQ(st, PAS_RAR_E_PASSWORD);
+
+    ASSERT(pas_rar_set_password(&rar, "many", 4, small, 2, &st));
+    ASSERT(!pas_rar_derive_keys(&rar, 4, &st));
+    ASSERT_EQ(st, PAS_RAR_E_NOSPACE);
+    ASSERT_EQ(used_slots(small, 2), 2u);
+    ASSERT(small[0].used == 1 && small[1].used == 1);
+    /* The salt without a slot is derived per entry; the slots are left as they are */
+    memcpy(keys, small, sizeof(small));
+    for (i = 0, bad = 0; i < 5; i++)
+        bad += extract(&rar, names[i], &st) != 100 || st != PAS_RAR_OK || memcmp(g_out, g_data + 100 * i, 100);
+    ASSERT_EQ(bad, 0u);
+    ASSERT(memcmp(keys, small, sizeof(small)) == 0);
+
+    ASSERT(pas_rar_set_password(&rar, "many", 4, keys, 4, &st));
+    ASSERT(pas_rar_derive_keys(&rar, 4, &st));
+    ASSERT_EQ(st, PAS_RAR_OK);
+    ASSERT_EQ(used_slots(keys, 4), 3u);
+    ASSERT(memcmp(keys[0].salt, k_salt_a, 16) == 0);
+    ASSERT(memcmp(keys[1].salt, k_salt_b, 16) == 0);
+    ASSERT(memcmp(keys[2].salt, k_salt_c, 16) == 0);
+    ASSERT(pas_rar_derive_keys(&rar, 4, &st)); /* nothing left to derive */
+    ASSERT_EQ(used_slots(keys, 4), 3u);
+    for (i = 0, bad = 0; i < 5; i++)
+        bad += extract(&rar, names[i], &st) != 100 || st != PAS_RAR_OK || memcmp(g_out, g_data + 100 * i, 100);
+    ASSERT_EQ(bad, 0u);
+    ASSERT_EQ(used_slots(keys, 4), 3u);
+
+    /* Same keys on one thread */
+    ASSERT(pas_rar_set_password(&rar, "many", 4, small, 2, &st));
+    memcpy(small, keys, sizeof(small));
+    ASSERT(pas_rar_set_password(&rar, "many", 4, keys, 4, &st));
+    ASSERT(pas_rar_derive_keys(&rar, 1, &st));
+    ASSERT(memcmp(small, keys, sizeof(small)) == 0);
+}
+
+/* RAR4 encryption (FILE_HEADER flag 0x04) is reported, not extracted */
+static void test_rar4(void) {
+    static const uint8_t head[14] = { 'R','a','r','!',0x1A,0x07,0x00, 0,0,0x73,0,0,7,0 };
+    pas_rar_t rar;
+    pas_rar_file_t f;
+    pas_rar_status st;
+    uint8_t *p = g_arc + sizeof(head);
+
+    memcpy(g_arc, head, sizeof(head));
+    memset(p, 0, 32);
+    p[2] = 0x74;
+    p[3] = 0x04;
+    p[4] = 0x80;
+    p[5] = 32 + 1;
+    put32(p + 7, 16);
+    put32(p + 11, 5);
+    p[24] = 0x14;
+    p[25] = 0x30;
+    p[26] = 1;
+    p[32] = 'x';
+    memset(p + 33, 0x77, 16);
+
+    ASSERT(pas_rar_open_ex(&rar, g_arc, sizeof(head) + 49, &st));
+    ASSERT(pas_rar_find_ex(&rar, "x", &f));
+    ASSERT_EQ(f.crypt, PAS_RAR_CRYPT_DATA);
+    ASSERT_EQ(pas_rar_extract(&f, g_out, sizeof(g_out), &st), 0u);
+    ASSERT_EQ(st, PAS_RAR_E_UNSUPPORTED);
+}
+
+int main(void) {
+    g_failed = 0;
+    g_assertions = 0;
+
+    make_data();
+    test_primitives();
+    test_kdf();
+    test_stored();
+    test_compressed();
+    test_headers();
+    test_volumes();
+    test_volume_headers();
+    test_derive();
+    test_rar4();
+
+    if (g_failed) {
+        (void)fprintf(stderr, "Total: %d assertions, %d failed\n", g_assertions, g_failed);
+        return 1;
+    }
+    (void)printf("All %d assertions passed.\n", g_assertions);
+    return 0;
+}
@@ -19,8 +19,8 @@ static int g_failed, g_assertions;
 static const unsigned char minimal_rar4[] = {
     0x52, 0x61, 0x72, 0x21, 0x1A, 0x07, 0x00,
     0x00, 0x00, 0x73, 0x00, 0x00, 0x07, 0x00,
-    0x00, 0x00, 0x74, 0x00, 0x80, 0x29, 0x00, 0x05, 0x00, 0x00, 0x00,
-    0x05, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x74, 0x00, 0x80, 0x25, 0x00, 0x05, 0x00, 0x00, 0x00,
+    0x05, 0x00, 0x00, 0x00, 0x00,
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x14, 0x30,
     0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x61, 0x2e, 0x74, 0x78, 0x74,
     0x68, 0x65, 0x6c, 0x6c, 0x6f
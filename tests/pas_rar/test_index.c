@@ -0,0 +1,123 @@
+/*
+    test_index.c - Test pas_rar_index_build and lookups through the entry table.
+    From repo root: gcc -o tests/pas_rar/test_index tests/pas_rar/test_index.c -I.
+*/
+
+#define PAS_RAR_IMPLEMENTATION
+#include "pas_rar.h"
+#include <stdio.h>
+#include <string.h>
+
+static int g_failed, g_assertions;
+
+#define ASSERT(cond) do { \
+    ++g_assertions; \
+    if (!(cond)) { (void)fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); ++g_failed; } \
+} while (0)
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+#define NUM_FILES 2000
+
+static unsigned char g_rar[NUM_FILES * 64];
+static char g_names[NUM_FILES][16];
+static pas_rar_index_slot_t g_table[4096];
+
+static void put16(unsigned char *p, unsigned v) { p[0] = (unsigned char)v; p[1] = (unsigned char)(v >> 8); }
+static void put32(unsigned char *p, unsigned long v) { put16(p, (unsigned)(v & 0xFFFF)); put16(p + 2, (unsigned)(v >> 16)); }
+
+/* RAR4 store entry: header + name + data */
+static size_t add_rar4(unsigned char *h, const char *name, const char *data, size_t dl) {
+    size_t nl = strlen(name);
+    memset(h, 0, 32);
+    h[2] = 0x74;
+    put16(h + 3, 0x8000);
+    put16(h + 5, (unsigned)(32 + nl));
+    put32(h + 7, (unsigned long)dl);
+    put32(h + 11, (unsigned long)dl);
+    h[24] = 0x14;
+    h[25] = 0x30;
+    put16(h + 26, (unsigned)nl);
+    memcpy(h + 32, name, nl);
+    memcpy(h + 32 + nl, data, dl);
+    return 32 + nl + dl;
+}
+
+static size_t make_archive(void) {
+    static const unsigned char head[14] = { 'R','a','r','!',0x1A,0x07,0x00, 0,0,0x73,0,0,7,0 };
+    size_t len = sizeof(head);
+    int i;
+    memcpy(g_rar, head, len);
+    for (i = 0; i < NUM_FILES; i++) {
+        (void)sprintf(g_names[i], "dir/f%04d.txt", i);
+        len += add_rar4(g_rar + len, g_names[i], g_names[i], (size_t)(i % 13));
+    }
+    /* A later entry with a duplicate name is shadowed by the first, as in a linear scan */
+    len += add_rar4(g_rar + len, g_names[7], "shadowed", 8);
+    return len;
+}
+
+int main(void) {
+    pas_rar_status status;
+    pas_rar_t rar;
+    pas_rar_file_t f, *legacy;
+    size_t len, cap;
+    char out[16];
+    int i, bad = 0;
+
+    g_failed = 0;
+    g_assertions = 0;
+
+    len = make_archive();
+    ASSERT(pas_rar_open_ex(&rar, g_rar, len, &status));
+    ASSERT(rar.index == NULL);
+
+    cap = pas_rar_index_capacity(&rar);
+    ASSERT_EQ(cap, 4096u);
+    ASSERT_EQ(pas_rar_index_build(&rar, g_table, 2048, &status), 0);
+    ASSERT(status == PAS_RAR_E_NOSPACE);
+    ASSERT(rar.index == NULL);
+    ASSERT_EQ(pas_rar_index_build(&rar, g_table, 8, &status), 0);
+    ASSERT(status == PAS_RAR_E_NOSPACE);
+    ASSERT_EQ(pas_rar_index_build(&rar, g_table, cap, &status), 1);
+    ASSERT(status == PAS_RAR_OK);
+    ASSERT(rar.index == g_table);
+    ASSERT_EQ(rar.index_slots, 4096u);
+
+    for (i = 0; i < NUM_FILES; i++) {
+        size_t n;
+        if (!pas_rar_find_ex(&rar, g_names[i], &f) || f.rar != &rar ||
+            pas_rar_size(&f) != (uint64_t)(i % 13)) {
+            bad++;
+            continue;
+        }
+        n = pas_rar_extract(&f, out, sizeof(out), &status);
+        if (status != PAS_RAR_OK || n != (size_t)(i % 13) || memcmp(out, g_names[i], n) != 0) bad++;
+    }
+    ASSERT_EQ(bad, 0);
+
+    ASSERT(pas_rar_find_ex(&rar, g_names[7], &f));
+    ASSERT_EQ(pas_rar_size(&f), 7u);
+    ASSERT_EQ(pas_rar_find_ex(&rar, "dir/f2000.txt", &f), 0);
+    ASSERT_EQ(pas_rar_find_ex(&rar, "dir/f000", &f), 0);
+    ASSERT_EQ(pas_rar_find_ex(&rar, "", &f), 0);
+
+    /* pas_rar_find goes through the table too */
+    legacy = pas_rar_find(&rar, "dir/f1234.txt");
+    ASSERT(legacy != NULL);
+    ASSERT(strcmp(pas_rar_name(legacy), "dir/f1234.txt") == 0);
+    ASSERT_EQ(pas_rar_size(legacy), (uint64_t)(1234 % 13));
+
+    /* Truncated archive: the walk fails, no table is installed */
+    ASSERT(pas_rar_open_ex(&rar, g_rar, len - 3, &status));
+    ASSERT_EQ(pas_rar_index_capacity(&rar), 0u);
+    ASSERT_EQ(pas_rar_index_build(&rar, g_table, 4096, &status), 0);
+    ASSERT(status == PAS_RAR_E_INVALID);
+    ASSERT(rar.index == NULL);
+
+    if (g_failed) {
+        (void)fprintf(stderr, "Total: %d assertions, %d failed\n", g_assertions, g_failed);
+        return 1;
+    }
+    (void)printf("All %d assertions passed.\n", g_assertions);
+    return 0;
+}
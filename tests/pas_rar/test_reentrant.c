@@ -0,0 +1,157 @@
+/*
+    test_reentrant.c - Test the re-entrant _ex API (RAR4 and RAR5 archives, several live entries).
+    From repo root: gcc -o tests/pas_rar/test_reentrant tests/pas_rar/test_reentrant.c -I.
+*/
+
+#define PAS_RAR_IMPLEMENTATION
+#include "pas_rar.h"
+#include <stdio.h>
+#include <string.h>
+
+static int g_failed, g_assertions;
+
+#define ASSERT(cond) do { \
+    ++g_assertions; \
+    if (!(cond)) { (void)fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); ++g_failed; } \
+} while (0)
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+static void put16(unsigned char *p, unsigned v) { p[0] = (unsigned char)v; p[1] = (unsigned char)(v >> 8); }
+static void put32(unsigned char *p, unsigned long v) { put16(p, (unsigned)(v & 0xFFFF)); put16(p + 2, (unsigned)(v >> 16)); }
+
+/* RAR4 archive of store entries (CRCs left zero) */
+static size_t make_rar4(unsigned char *out, const char **names, const char **datas, int n) {
+    static const unsigned char head[14] = { 'R','a','r','!',0x1A,0x07,0x00, 0,0,0x73,0,0,7,0 };
+    size_t len = sizeof(head);
+    int i;
+    memcpy(out, head, len);
+    for (i = 0; i < n; i++) {
+        size_t nl = strlen(names[i]), dl = strlen(datas[i]);
+        unsigned char *h = out + len;
+        memset(h, 0, 32);
+        h[2] = 0x74;
+        put16(h + 3, 0x8000);
+        put16(h + 5, (unsigned)(32 + nl));
+        put32(h + 7, (unsigned long)dl);   /* PACK_SIZE (the block's ADD_SIZE) */
+        put32(h + 11, (unsigned long)dl);  /* UNP_SIZE */
+        h[24] = 0x14;                      /* UNP_VER */
+        h[25] = 0x30;                      /* METHOD: store */
+        put16(h + 26, (unsigned)nl);
+        memcpy(h + 32, names[i], nl);
+        memcpy(h + 32 + nl, datas[i], dl);
+        len += 32 + nl + dl;
+    }
+    return len;
+}
+
+/* RAR5 archive of uncompressed entries (sizes and names under 128 bytes) */
+static size_t make_rar5(unsigned char *out, const char **names, const char **datas, int n) {
+    static const unsigned char sig[8] = { 'R','a','r','!',0x1A,0x07,0x01,0x00 };
+    size_t len = sizeof(sig);
+    int i;
+    memcpy(out, sig, len);
+    for (i = 0; i < n; i++) {
+        size_t nl = strlen(names[i]), dl = strlen(datas[i]);
+        unsigned char *h = out + len;
+        memset(h, 0, 4);                   /* header CRC, not checked */
+        h[4] = (unsigned char)(9 + nl);    /* header size */
+        h[5] = 2;                          /* file header */
+        h[6] = 0x02;                       /* data area present */
+        h[7] = (unsigned char)dl;          /* data size */
+        h[8] = 0;                          /* file flags */
+        h[9] = (unsigned char)dl;          /* unpacked size */
+        h[10] = 0;                         /* attributes */
+        h[11] = 0;                         /* compression info: method 0 */
+        h[12] = 0;                         /* host OS */
+        h[13] = (unsigned char)nl;
+        memcpy(h + 14, names[i], nl);
+        memcpy(h + 14 + nl, datas[i], dl);
+        len += 14 + nl + dl;
+    }
+    memset(out + len, 0, 4);
+    out[len + 4] = 3;                      /* end of archive: size, type 5, flags 0 */
+    out[len + 5] = 5;
+    out[len + 6] = 0;
+    out[len + 7] = 0;
+    return len + 8;
+}
+
+static int extracts(pas_rar_file_t *f, const char *expect) {
+    pas_rar_status st;
+    char out[64];
+    size_t n = pas_rar_extract(f, out, sizeof(out), &st);
+    return st == PAS_RAR_OK && n == strlen(expect) && memcmp(out, expect, n) == 0;
+}
+
+static void list_cb(const char *name, uint64_t size, void *user) {
+    (void)size;
+    if (strcmp(name, "dir/two.txt") == 0) ++*(int *)user;
+}
+
+int main(void) {
+    static const char *names_a[] = { "one.txt", "dir/two.txt" };
+    static const char *datas_a[] = { "first", "second" };
+    static const char *names_b[] = { "one.txt" };
+    static const char *datas_b[] = { "other archive" };
+    unsigned char buf_a[256], buf_b[256];
+    size_t len_a, len_b, name_len;
+    pas_rar_status status;
+    pas_rar_t rar_a, rar_b;
+    pas_rar_file_t a1, a2, b1, *legacy;
+    const char *name;
+    int seen = 0;
+
+    g_failed = 0;
+    g_assertions = 0;
+
+    len_a = make_rar4(buf_a, names_a, datas_a, 2);
+    len_b = make_rar5(buf_b, names_b, datas_b, 1);
+
+    ASSERT_EQ(pas_rar_open_ex(&rar_a, buf_a, len_a, &status), 1);
+    ASSERT_EQ(pas_rar_open_ex(&rar_b, buf_b, len_b, &status), 1);
+    ASSERT_EQ(rar_a.format, 4);
+    ASSERT_EQ(rar_b.format, 5);
+    ASSERT_EQ(pas_rar_open_ex(&rar_b, buf_b, 3, &status), 0);
+    ASSERT(status == PAS_RAR_E_INVALID);
+    ASSERT_EQ(pas_rar_open_ex(&rar_b, buf_b, len_b, &status), 1);
+
+    ASSERT_EQ(pas_rar_find_ex(&rar_a, "one.txt", &a1), 1);
+    ASSERT_EQ(pas_rar_find_ex(&rar_a, "dir/two.txt", &a2), 1);
+    ASSERT_EQ(pas_rar_find_ex(&rar_b, "one.txt", &b1), 1);
+    ASSERT_EQ(pas_rar_find_ex(&rar_b, "dir/two.txt", &b1), 0);
+    ASSERT_EQ(pas_rar_find_ex(&rar_b, "one.tx", &b1), 0);
+    ASSERT_EQ(pas_rar_find_ex(&rar_b, "one.txt", &b1), 1);
+
+    ASSERT(a1.rar == &rar_a);
+    ASSERT(b1.rar == &rar_b);
+    ASSERT(pas_rar_name(&a1) == NULL);
+    name = pas_rar_name_span(&a2, &name_len);
+    ASSERT_EQ(name_len, 11u);
+    ASSERT(memcmp(name, "dir/two.txt", 11) == 0);
+    name = pas_rar_name_span(&b1, &name_len);
+    ASSERT_EQ(name_len, 7u);
+    ASSERT(memcmp(name, "one.txt", 7) == 0);
+
+    /* Entries from both archives stay valid side by side */
+    ASSERT(extracts(&b1, "other archive"));
+    ASSERT(extracts(&a1, "first"));
+    ASSERT(extracts(&a2, "second"));
+
+    /* The legacy handle does not disturb _ex entries */
+    ASSERT(pas_rar_open(buf_b, len_b, &status) != NULL);
+    legacy = pas_rar_find(pas_rar_open(buf_a, len_a, &status), "dir/two.txt");
+    ASSERT(legacy != NULL);
+    ASSERT(strcmp(pas_rar_name(legacy), "dir/two.txt") == 0);
+    ASSERT(extracts(legacy, "second"));
+    ASSERT(extracts(&b1, "other archive"));
+
+    ASSERT_EQ(pas_rar_list(&rar_a, list_cb, &seen), 0);
+    ASSERT_EQ(seen, 1);
+
+    if (g_failed) {
+        (void)fprintf(stderr, "Total: %d assertions, %d failed\n", g_assertions, g_failed);
+        return 1;
+    }
+    (void)printf("All %d assertions passed.\n", g_assertions);
+    return 0;
+}
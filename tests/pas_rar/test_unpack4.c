@@ -0,0 +1,1699 @@
+/*
+    test_unpack4.c - Test RAR 2.9/3.x decompression (LZ and PPMd blocks, VM filters) through
+    pas_rar_extract and pas_rar_extract_ex, and of a solid run through pas_rar_seq_*; all of it
+    also with the archives cut into volumes.
+    The archives come from a small RAR 3.x packer below: greedy LZ over the four Huffman tables
+    (repeat, short, long and low-distance-repeat codes, tables kept as deltas), a PPMd variant H
+    coder driving the library's own model with every escape code, and the standard filter
+    programs, whose bytes are forged to carry the checksums the decoders recognise. A splitter
+    re-cuts the archives into multi-volume sets.
+    From repo root: gcc -o tests/pas_rar/test_unpack4 tests/pas_rar/test_unpack4.c -I.
+*/
+
+#define PAS_RAR_IMPLEMENTATION
+#include "pas_rar.h"
+#include <stdio.h>
+#include <string.h>
+
+static int g_failed, g_assertions;
+
+#define ASSERT(cond) do { \
+    ++g_assertions; \
+    if (!(cond)) { (void)fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); ++g_failed; } \
+} while (0)
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+#define SIZE_A     740000u
+#define SIZE_B     1500000u
+#define SIZE_C     300000u
+#define SIZE_F     24000u
+#define SIZE_S     150000u
+#define MAX_SIZE   SIZE_B
+#define MAX_TOKENS (1u << 20)
+#define NTABLES    PAS_RAR3_TABLES
+#define MODEL_MB   4           /* largest PPMd model the packer starts */
+#define NONE       0xffffffffu
+
+enum { T_LIT, T_LAST, T_REP, T_SHORT, T_MATCH, T_FILTER, T_END };
+enum { F_E8, F_E8E9, F_DELTA, F_RGB, F_AUDIO, F_UNKNOWN, F_COUNT };
+enum { S_LZ, S_PPM };
+enum { E_FILE, E_TABLES, E_FILE_TABLES };  /* end of block: file ends, new tables, both */
+
+typedef struct {
+    uint8_t  kind;
+    uint8_t  idx;      /* T_REP: distance index; T_END: an E_* code */
+    uint16_t len;      /* T_LIT: the byte; T_FILTER: record length */
+    uint32_t dist;     /* T_FILTER: record offset in g_recs */
+} token_t;
+
+typedef struct {
+    uint32_t start, length;
+    uint8_t  type;
+    uint32_t r0;       /* delta and audio: channels; RGB: line width + 3 */
+    uint8_t  r1;       /* RGB: offset of the red byte */
+    uint16_t ahead;    /* the record goes this many bytes before the block */
+} region_t;
+
+typedef struct {
+    uint32_t end;
+    uint8_t  kind;
+    uint8_t  flag;     /* LZ: tables are deltas from the previous ones; PPM: start a new model */
+    uint8_t  order;    /* PPM: flags & 0x1f */
+    uint8_t  mb;
+    int      esc;      /* PPM: new escape byte, or -1 */
+} segment_t;
+
+static uint8_t  g_a[SIZE_A], g_b[SIZE_B], g_c[SIZE_C], g_f[SIZE_F], g_s[SIZE_S];
+static uint8_t  g_win[MAX_SIZE];          /* what the decoder's window holds (filters not applied) */
+static uint8_t  g_pack[MAX_SIZE + 65536];
+static uint8_t  g_rar[8u << 20];
+static uint8_t  g_srar[1u << 20];
+static uint8_t  g_out[12u << 20];
+static uint8_t  g_fuzz[65536];
+static uint8_t  g_vol_data[12u << 20];
+static pas_rar_volume_t g_vols[4096];
+static uint8_t  g_model_mem[((size_t)MODEL_MB << 20) + 65536];
+static token_t  g_tokens[MAX_TOKENS];
+static uint8_t  g_recs[65536];
+static size_t   g_nrecs;
+static uint32_t g_head[1 << 16], g_last2[1 << 16];
+static uint32_t g_prev[MAX_SIZE];
+static pas_rar_unpack_t g_state;
+
+/* ----- Helpers: random numbers, CRC32, bit writer ----- */
+
+static uint32_t g_seed = 4242;
+static uint32_t rnd(void) { g_seed = g_seed * 1103515245u + 12345u; return g_seed >> 8; }
+
+static uint32_t crc32_buf(const uint8_t *p, size_t n) {
+    uint32_t c = 0xFFFFFFFFu;
+    size_t i;
+    int k;
+    for (i = 0; i < n; i++) {
+        c ^= p[i];
+        for (k = 0; k < 8; k++) c = (c >> 1) ^ (0xEDB88320u & (0u - (c & 1)));
+    }
+    return c ^ 0xFFFFFFFFu;
+}
+
+static void put16(uint8_t *p, unsigned v) { p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); }
+static void put32(uint8_t *p, uint32_t v) { put16(p, v & 0xFFFF); put16(p + 2, v >> 16); }
+static uint32_t get32(const uint8_t *p) { return p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24; }
+
+typedef struct { uint8_t *buf; size_t bits; } bitw_t;
+
+static void put_bits(bitw_t *w, uint32_t v, unsigned n) {
+    while (n--) {
+        size_t byte = w->bits >> 3;
+        if ((w->bits & 7) == 0) w->buf[byte] = 0;
+        if ((v >> n) & 1) w->buf[byte] |= (uint8_t)(0x80 >> (w->bits & 7));
+        w->bits++;
+    }
+}
+
+/* ----- Slot tables, rebuilt from the format's bit counts ----- */
+
+static const uint8_t k_lbits[28] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5 };
+static const uint8_t k_sdbits[8] = { 2, 2, 3, 4, 5, 6, 6, 6 };
+static const uint8_t k_sdbase[8] = { 0, 4, 8, 16, 32, 64, 128, 192 };
+static uint32_t g_lbase[28], g_dbase[60];
+static uint8_t  g_dbits[60];
+
+static void init_slots(void) {
+    static const uint8_t counts[19] = { 4, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 14, 0, 12 };
+    unsigned i, j, s = 0;
+    uint32_t base = 0;
+    for (i = 0; i < 28; i++) {
+        g_lbase[i] = base;
+        base += 1u << k_lbits[i];
+    }
+    base = 0;
+    for (i = 0; i < 19; i++)
+        for (j = 0; j < counts[i]; j++, s++) {
+            g_dbase[s] = base;
+            g_dbits[s] = (uint8_t)i;
+            base += 1u << i;
+        }
+}
+
+static unsigned lslot(uint32_t v) { unsigned s = 27; while (g_lbase[s] > v) s--; return s; }
+static unsigned dslot(uint32_t d) { unsigned s = 59; while (g_dbase[s] > d) s--; return s; }
+static unsigned sdslot(uint32_t d) { unsigned s = 7; while (k_sdbase[s] > d) s--; return s; }
+static unsigned bonus(uint32_t dist) { return (dist >= 0x2000) + (dist >= 0x40000); }
+
+/* ----- Huffman code construction ----- */
+
+/* Code lengths <= limit: plain Huffman, flattened by halving the counts until it fits */
+static void huff_lengths(const uint32_t *freq, unsigned n, unsigned limit, uint8_t *lens) {
+    uint32_t f[2 * PAS_RAR3_NC], w[2 * PAS_RAR3_NC];
+    int parent[2 * PAS_RAR3_NC], alive[2 * PAS_RAR3_NC];
+    unsigned i, nodes, used, maxlen;
+
+    memcpy(f, freq, n * sizeof(f[0]));
+    for (;;) {
+        used = 0;
+        for (i = 0; i < n; i++) {
+            w[i] = f[i];
+            alive[i] = f[i] != 0;
+            parent[i] = -1;
+            used += alive[i];
+            lens[i] = 0;
+        }
+        if (used <= 1) {
+            /* Keep every table complete - some readers reject a lone or empty code - by pairing
+               the symbol with an unused 1-bit sibling */
+            for (i = 0; i < n; i++) if (f[i]) lens[i] = 1;
+            for (i = 0; used < 2; i++) if (!lens[i]) lens[i] = 1, used++;
+            return;
+        }
+        for (nodes = n; used > 1; nodes++, used--) {
+            int a = -1, b = -1;
+            for (i = 0; i < nodes; i++) {
+                if (!alive[i]) continue;
+                if (a < 0 || w[i] < w[a]) { b = a; a = (int)i; }
+                else if (b < 0 || w[i] < w[b]) b = (int)i;
+            }
+            w[nodes] = w[a] + w[b];
+            alive[nodes] = 1;
+            parent[nodes] = -1;
+            alive[a] = alive[b] = 0;
+            parent[a] = parent[b] = (int)nodes;
+        }
+        maxlen = 0;
+        for (i = 0; i < n; i++) {
+            unsigned d = 0;
+            int p;
+            if (!f[i]) continue;
+            for (p = parent[i]; p >= 0; p = parent[p]) d++;
+            lens[i] = (uint8_t)d;
+            if (d > maxlen) maxlen = d;
+        }
+        if (maxlen <= limit) return;
+        for (i = 0; i < n; i++) if (f[i]) f[i] = (f[i] >> 1) | 1;
+    }
+}
+
+static void huff_codes(const uint8_t *lens, unsigned n, uint16_t *codes) {
+    unsigned count[16], next[16], i, code = 0;
+    memset(count, 0, sizeof(count));
+    for (i = 0; i < n; i++) count[lens[i]]++;
+    count[0] = 0;
+    for (i = 1; i < 16; i++) {
+        code = (code + count[i - 1]) << 1;
+        next[i] = code;
+    }
+    for (i = 0; i < n; i++) codes[i] = lens[i] ? (uint16_t)next[lens[i]]++ : 0;
+}
+
+/* ----- Filter programs ----- */
+
+/* Program sizes and CRC32s of the standard filters; the last one is no filter anyone knows */
+static const struct { uint32_t len, crc; } k_progs[F_COUNT] = {
+    { 53, 0xad576887u }, { 57, 0x3cd7e57eu }, { 29, 0x0e06077du }, { 149, 0x1c2c5dc8u },
+    { 216, 0xbc85e701u }, { 40, 0x01234567u }
+};
+static uint8_t g_prog[F_COUNT][256];
+
+/* CRC32 of the program and the XOR check byte in front as a 40-bit vector */
+static uint64_t prog_check(const uint8_t *p, unsigned len) {
+    uint8_t x = 0;
+    unsigned i;
+    for (i = 1; i < len; i++) x ^= p[i];
+    return (uint64_t)crc32_buf(p, len) | (uint64_t)(uint8_t)(x ^ p[0]) << 32;
+}
+
+/* Random bytes, then the first 7 of them solved over GF(2) so that the CRC32 is crc and byte 0 is
+   the XOR of the others. Both are affine in the bits, so each of the 56 free bits contributes a
+   fixed 40-bit column. */
+static void forge_prog(uint8_t *p, unsigned len, uint32_t crc) {
+    for (;;) {
+        uint64_t basis[40], comb[40], want, col, mask;
+        unsigned i, b, rank = 0;
+        int pivot[40];
+
+        for (i = 0; i < len; i++) p[i] = (uint8_t)rnd();
+        memset(p, 0, 7);
+        want = prog_check(p, len) ^ crc;
+        for (i = 0; i < 40; i++) pivot[i] = -1;
+        for (i = 0; i < 56; i++) {
+            col = prog_check(p, len);
+            p[i / 8] ^= (uint8_t)(1u << (i & 7));
+            col ^= prog_check(p, len);
+            p[i / 8] ^= (uint8_t)(1u << (i & 7));
+            mask = (uint64_t)1 << i;
+            /* Reduce on the lowest set bits; each basis vector owns its lowest bit */
+            for (b = 0; b < 40; b++)
+                if (((col >> b) & 1) && pivot[b] >= 0) {
+                    col ^= basis[pivot[b]];
+                    mask ^= comb[pivot[b]];
+                }
+            if (!col) continue;
+            for (b = 0; !((col >> b) & 1); b++) {}
+            basis[rank] = col;
+            comb[rank] = mask;
+            pivot[b] = (int)rank++;
+        }
+        if (rank < 40) continue;
+        mask = 0;
+        for (b = 0; b < 40; b++)
+            if ((want >> b) & 1) {
+                want ^= basis[pivot[b]];
+                mask ^= comb[pivot[b]];
+            }
+        for (i = 0; i < 56; i++)
+            if ((mask >> i) & 1) p[i / 8] ^= (uint8_t)(1u << (i & 7));
+        if (prog_check(p, len) == crc) return;
+    }
+}
+
+/* ----- Filter records ----- */
+
+static int      g_prog_num[F_COUNT], g_nprogs, g_last_prog;
+static const region_t *g_regions;
+static unsigned g_nregions, g_next_region;
+
+/* RarVM::ReadData number: 2-bit selector and 4, 8, 16 or 32 bits */
+static void put_vm_number(bitw_t *w, uint32_t v) {
+    if (v < 16) { put_bits(w, 0, 2); put_bits(w, v, 4); }
+    else if (v < 256) { put_bits(w, 1, 2); put_bits(w, v, 8); }
+    else if (v < 65536) { put_bits(w, 2, 2); put_bits(w, v, 16); }
+    else { put_bits(w, 3, 2); put_bits(w, v >> 16, 16); put_bits(w, v & 0xffff, 16); }
+}
+
+/* Record for region r decoded at stream position pos: flags byte with the record length, then
+   program number (left out when it is the last one used), block start, length, registers and,
+   the first time a program is used, its code. Appended to g_recs; returns its offset. */
+static size_t make_record(const region_t *r, uint32_t pos, uint16_t *len) {
+    uint8_t body[512];
+    bitw_t w;
+    size_t at = g_nrecs, n;
+    uint32_t rel = r->start - pos;
+    unsigned first = 0x20, i;
+    int num = g_prog_num[r->type];
+
+    w.buf = body;
+    w.bits = 0;
+    if (num < 0) num = g_nprogs;
+    if (num != g_last_prog || num == g_nprogs) {
+        first |= 0x80;
+        put_vm_number(&w, (uint32_t)num + 1);
+    }
+    if (rel >= 258) first |= 0x40;
+    put_vm_number(&w, rel >= 258 ? rel - 258 : rel);
+    put_vm_number(&w, r->length);
+    if (r->type == F_DELTA || r->type == F_AUDIO) {
+        first |= 0x10;
+        put_bits(&w, 0x01, 7);
+        put_vm_number(&w, r->r0);
+    } else if (r->type == F_RGB) {
+        first |= 0x10;
+        put_bits(&w, 0x03, 7);
+        put_vm_number(&w, r->r0);
+        put_vm_number(&w, r->r1);
+    }
+    if (num == g_nprogs) {
+        put_vm_number(&w, k_progs[r->type].len);
+        for (i = 0; i < k_progs[r->type].len; i++) put_bits(&w, g_prog[r->type][i], 8);
+        g_prog_num[r->type] = g_nprogs++;
+    }
+    g_last_prog = num;
+
+    n = (w.bits + 7) / 8;
+    if (n <= 6) {
+        g_recs[g_nrecs++] = (uint8_t)(first | (n - 1));
+    } else if (n <= 262) {
+        g_recs[g_nrecs++] = (uint8_t)(first | 6);
+        g_recs[g_nrecs++] = (uint8_t)(n - 7);
+    } else {
+        g_recs[g_nrecs++] = (uint8_t)(first | 7);
+        g_recs[g_nrecs++] = (uint8_t)(n >> 8);
+        g_recs[g_nrecs++] = (uint8_t)n;
+    }
+    memcpy(g_recs + g_nrecs, body, n);
+    g_nrecs += n;
+    *len = (uint16_t)(g_nrecs - at);
+    return at;
+}
+
+/* Where the next record goes (limit if none before it) */
+static uint32_t next_emit(uint32_t limit) {
+    uint32_t at;
+    if (g_next_region == g_nregions) return limit;
+    at = g_regions[g_next_region].start - g_regions[g_next_region].ahead;
+    return at < limit ? at : limit;
+}
+
+/* ----- Forward filters: what RAR applies before packing ----- */
+
+static uint32_t e8_decode(uint32_t a, uint32_t off) {
+    if (a & 0x80000000u) return ((a + off) & 0x80000000u) == 0 ? a + 0x1000000u : a;
+    return ((a - 0x1000000u) & 0x80000000u) ? a - off : a;
+}
+
+static void e8_encode(uint8_t *d, uint32_t n, uint32_t file_off, int e9) {
+    uint32_t i;
+    for (i = 0; i + 4 < n; ) {
+        uint8_t b = d[i++];
+        if (b == 0xe8 || (e9 && b == 0xe9)) {
+            uint32_t rel = get32(d + i), off = i + file_off;
+            uint32_t cand[3];
+            unsigned k;
+            cand[0] = rel + off;
+            cand[1] = rel;
+            cand[2] = rel - 0x1000000u;
+            for (k = 0; k < 3 && e8_decode(cand[k], off) != rel; k++) {}
+            put32(d + i, k < 3 ? cand[k] : rel);
+            i += 4;
+        }
+    }
+}
+
+static unsigned rgb_predict(const uint8_t *s, uint32_t i, uint32_t width, unsigned prev) {
+    unsigned up, up_left, pred;
+    int pa, pb, pc;
+    if (i < width + 3) return prev;
+    up = s[i - width];
+    up_left = s[i - width - 3];
+    pred = prev + up - up_left;
+    pa = (int)(pred - prev);
+    pb = (int)(pred - up);
+    pc = (int)(pred - up_left);
+    if (pa < 0) pa = -pa;
+    if (pb < 0) pb = -pb;
+    if (pc < 0) pc = -pc;
+    return pa <= pb && pa <= pc ? prev : pb <= pc ? up : up_left;
+}
+
+/* Region r of orig into win: channel-planar residuals for delta, RGB and audio */
+static void forward_filter(const region_t *r, const uint8_t *orig, uint8_t *win) {
+    static uint8_t s[PAS_RAR3_MAX_FILTER];
+    const uint8_t *o = orig + r->start;
+    uint8_t *w = win + r->start;
+    uint32_t n = r->length, i, src = 0, c;
+
+    memcpy(w, o, n);
+    if (r->type == F_E8 || r->type == F_E8E9) {
+        e8_encode(w, n, r->start, r->type == F_E8E9);
+    } else if (r->type == F_DELTA) {
+        for (c = 0; c < r->r0; c++) {
+            uint8_t prev = 0;
+            for (i = c; i < n; i += r->r0) {
+                w[src++] = (uint8_t)(prev - o[i]);
+                prev = o[i];
+            }
+        }
+    } else if (r->type == F_RGB) {
+        uint32_t width = r->r0 - 3;
+        memcpy(s, o, n);
+        for (i = r->r1; i + 2 < n; i += 3) {
+            s[i] = (uint8_t)(s[i] - s[i + 1]);
+            s[i + 2] = (uint8_t)(s[i + 2] - s[i + 1]);
+        }
+        for (c = 0; c < 3; c++) {
+            unsigned prev = 0;
+            for (i = c; i < n; i += 3) {
+                w[src++] = (uint8_t)(rgb_predict(s, i, width, prev) - s[i]);
+                prev = s[i];
+            }
+        }
+    } else if (r->type == F_AUDIO) {
+        for (c = 0; c < r->r0; c++) {
+            uint32_t dif[7], prev = 0, count = 0, j;
+            int d1 = 0, d2 = 0, d3, k1 = 0, k2 = 0, k3 = 0, prev_delta = 0;
+            memset(dif, 0, sizeof(dif));
+            for (i = c; i < n; i += r->r0, count++) {
+                uint32_t pred;
+                int cur, e, best = 0;
+                d3 = d2;
+                d2 = prev_delta - d1;
+                d1 = prev_delta;
+                pred = ((8 * prev + (uint32_t)(k1 * d1) + (uint32_t)(k2 * d2) + (uint32_t)(k3 * d3)) >> 3) & 0xff;
+                cur = (int)((pred - o[i]) & 0xff);
+                w[src++] = (uint8_t)cur;
+                prev_delta = (signed char)(o[i] - prev);
+                prev = o[i];
+                e = (signed char)cur * 8;
+                dif[0] += (uint32_t)(e < 0 ? -e : e);
+                dif[1] += (uint32_t)(e - d1 < 0 ? d1 - e : e - d1);
+                dif[2] += (uint32_t)(e + d1 < 0 ? -e - d1 : e + d1);
+                dif[3] += (uint32_t)(e - d2 < 0 ? d2 - e : e - d2);
+                dif[4] += (uint32_t)(e + d2 < 0 ? -e - d2 : e + d2);
+                dif[5] += (uint32_t)(e - d3 < 0 ? d3 - e : e - d3);
+                dif[6] += (uint32_t)(e + d3 < 0 ? -e - d3 : e + d3);
+                if ((count & 0x1f) == 0) {
+                    uint32_t min_dif = dif[0];
+                    dif[0] = 0;
+                    for (j = 1; j < 7; j++) {
+                        if (dif[j] < min_dif) { min_dif = dif[j]; best = (int)j; }
+                        dif[j] = 0;
+                    }
+                    if (best == 1 && k1 >= -16) k1--;
+                    if (best == 2 && k1 < 16) k1++;
+                    if (best == 3 && k2 >= -16) k2--;
+                    if (best == 4 && k2 < 16) k2++;
+                    if (best == 5 && k3 >= -16) k3--;
+                    if (best == 6 && k3 < 16) k3++;
+                }
+            }
+        }
+    }
+}
+
+/* ----- Match finding (shared by the LZ and PPMd paths, positions inserted in order) ----- */
+
+static uint32_t g_old[4], g_last_len;  /* repeat state, carried across blocks like the decoder's */
+
+/* Statistics of what the packer used, so the test can check every code was exercised */
+static struct {
+    unsigned lit, last, rep, shrt, match, far, low_rep, records, esc_lit, esc_match, esc_run, restarts;
+} g_used;
+
+static uint32_t hash3(const uint8_t *d, uint32_t pos) {
+    return ((uint32_t)d[pos] << 8 ^ (uint32_t)d[pos + 1] << 4 ^ d[pos + 2]) & 0xffff;
+}
+
+static void insert(const uint8_t *d, uint32_t pos, uint32_t size) {
+    if (pos + 3 <= size) {
+        uint32_t h = hash3(d, pos);
+        g_prev[pos] = g_head[h];
+        g_head[h] = pos;
+    }
+    if (pos >= 1) g_last2[(uint32_t)d[pos - 1] << 8 | d[pos]] = pos - 1;
+}
+
+static uint32_t match_len(const uint8_t *d, uint32_t pos, uint32_t dist, uint32_t max) {
+    uint32_t n = 0;
+    while (n < max && d[pos + n] == d[pos + n - dist]) n++;
+    return n;
+}
+
+/* Longest match through the hash chain. LZ: 3..258 bytes plus the far-distance bonus;
+   PPMd: 32..287 bytes at distance >= 2. */
+static uint32_t longest(const uint8_t *d, uint32_t pos, uint32_t size, uint32_t max, uint32_t max_dist, int lz,
+                        uint32_t *out_dist) {
+    uint32_t cand, chain = 48, best = 0;
+    if (pos + 3 > size) return 0;
+    for (cand = g_head[hash3(d, pos)]; cand != NONE && chain--; cand = g_prev[cand]) {
+        uint32_t dist = pos - cand, lo = lz ? 3 + bonus(dist) : 32, hi = lz ? 258 + bonus(dist) : 287, len;
+        if (dist > max_dist) break;
+        if (!lz && dist < 2) continue;
+        len = match_len(d, pos, dist, max < hi ? max : hi);
+        if (len >= lo && len > best) {
+            best = len;
+            *out_dist = dist;
+        }
+    }
+    return best;
+}
+
+/* ----- LZ blocks ----- */
+
+typedef struct {
+    uint32_t freq[NTABLES];   /* main, distance, low distance, repeat length counts */
+    uint8_t  lens[NTABLES];
+    uint16_t codes[NTABLES];
+} tables_t;
+
+#define T_MAIN 0
+#define T_DIST PAS_RAR3_NC
+#define T_LOW  (PAS_RAR3_NC + PAS_RAR3_DC)
+#define T_RLEN (PAS_RAR3_NC + PAS_RAR3_DC + PAS_RAR3_LDC)
+
+static uint8_t g_old_lens[NTABLES];   /* the last LZ tables, base of the next deltas */
+
+/* Greedy parse of [from, to); records go out at their emit points, which matches do not cross */
+static size_t tokenize(const uint8_t *d, uint32_t from, uint32_t to, uint32_t size, uint32_t max_dist) {
+    uint32_t pos = from, i;
+    size_t n = 0;
+
+    while (pos < to) {
+        uint32_t emit = next_emit(to), max, best = 0, best_dist = 0, len, dist = 0;
+        int rep = -1;
+        token_t *k = &g_tokens[n++];
+
+        if (pos >= emit) {
+            k->kind = T_FILTER;
+            k->dist = (uint32_t)make_record(&g_regions[g_next_region++], pos, &k->len);
+            continue;
+        }
+        max = emit - pos;
+
+        if (g_last_len && g_old[0] && g_old[0] <= pos && g_last_len <= max &&
+            match_len(d, pos, g_old[0], g_last_len) == g_last_len) {
+            k->kind = T_LAST;
+            best = g_last_len;
+        } else {
+            for (i = 0; i < 4; i++) {
+                if (!g_old[i] || g_old[i] > pos) continue;
+                len = match_len(d, pos, g_old[i], max < 257 ? max : 257);
+                if (len >= 2 && len > best) { best = len; rep = (int)i; }
+            }
+            len = longest(d, pos, size, max, max_dist, 1, &dist);
+            if (len > best + 1) { best = len; best_dist = dist; rep = -1; }
+
+            if (best == 0 && max >= 2 && pos + 2 <= size) {
+                uint32_t c = g_last2[(uint32_t)d[pos] << 8 | d[pos + 1]];
+                if (c != NONE && pos - c <= 256) best_dist = pos - c;
+            }
+            if (best == 0 && best_dist) {
+                k->kind = T_SHORT;
+                k->dist = best_dist;
+                best = 2;
+                memmove(g_old + 1, g_old, 3 * sizeof(g_old[0]));
+                g_old[0] = best_dist;
+                g_last_len = 2;
+            } else if (best == 0) {
+                k->kind = T_LIT;
+                k->len = d[pos];
+                best = 1;
+            } else if (rep >= 0) {
+                uint32_t rd = g_old[rep];
+                k->kind = T_REP;
+                k->idx = (uint8_t)rep;
+                k->len = (uint16_t)best;
+                for (i = (uint32_t)rep; i > 0; i--) g_old[i] = g_old[i - 1];
+                g_old[0] = rd;
+                g_last_len = best;
+            } else {
+                k->kind = T_MATCH;
+                k->len = (uint16_t)best;
+                k->dist = best_dist;
+                memmove(g_old + 1, g_old, 3 * sizeof(g_old[0]));
+                g_old[0] = best_dist;
+                g_last_len = best;
+            }
+        }
+        for (i = 0; i < best; i++) insert(d, pos++, size);
+    }
+    return n;
+}
+
+typedef struct { unsigned prev_low, low_rep; } lowdist_t;
+
+static void sym(bitw_t *w, tables_t *t, unsigned s) {
+    if (w) put_bits(w, t->codes[s], t->lens[s]);
+    else t->freq[s]++;
+}
+static void raw(bitw_t *w, uint32_t v, unsigned n) { if (w) put_bits(w, v, n); }
+
+/* Long match i: slot > 9, low 4 distance bits */
+static int far_low(const token_t *k, unsigned *low) {
+    uint32_t d = k->dist - 1;
+    unsigned s;
+    if (k->kind != T_MATCH) return 0;
+    s = dslot(d);
+    *low = (d - g_dbase[s]) & 15;
+    return s > 9;
+}
+
+/* Code 16 makes the decoder reuse the low bits for the next 15 far matches; only send it when
+   they all have them within this block. Tables reset the repeat state, but libarchive carries it
+   over, so no repeat is left pending at a block end */
+static int low_rep_ok(const token_t *t, size_t i, size_t n, unsigned low) {
+    unsigned seen = 0, l;
+    for (i++; i < n && seen < 15; i++) {
+        if (!far_low(&t[i], &l)) continue;
+        if (l != low) return 0;
+        seen++;
+    }
+    return seen == 15;
+}
+
+static void put_token(bitw_t *w, tables_t *t, const token_t *tok, size_t i, size_t n, lowdist_t *ld) {
+    const token_t *k = &tok[i];
+    uint32_t v, d, e;
+    unsigned s, bits, low;
+
+    switch (k->kind) {
+    case T_LIT:
+        sym(w, t, k->len);
+        if (w) g_used.lit++;
+        break;
+    case T_LAST:
+        sym(w, t, 258);
+        if (w) g_used.last++;
+        break;
+    case T_REP:
+        sym(w, t, 259 + k->idx);
+        v = k->len - 2u;
+        s = lslot(v);
+        sym(w, t, T_RLEN + s);
+        raw(w, v - g_lbase[s], k_lbits[s]);
+        if (w) g_used.rep++;
+        break;
+    case T_SHORT:
+        d = k->dist - 1;
+        s = sdslot(d);
+        sym(w, t, 263 + s);
+        raw(w, d - k_sdbase[s], k_sdbits[s]);
+        if (w) g_used.shrt++;
+        break;
+    case T_MATCH:
+        v = k->len - 3u - bonus(k->dist);
+        s = lslot(v);
+        sym(w, t, 271 + s);
+        raw(w, v - g_lbase[s], k_lbits[s]);
+        d = k->dist - 1;
+        s = dslot(d);
+        sym(w, t, T_DIST + s);
+        e = d - g_dbase[s];
+        bits = g_dbits[s];
+        if (w) {
+            g_used.match++;
+            g_used.far += k->dist >= 0x40000;
+        }
+        if (s <= 9) {
+            raw(w, e, bits);
+            break;
+        }
+        if (bits > 4) raw(w, e >> 4, bits - 4);
+        low = e & 15;
+        if (ld->low_rep) {
+            ld->low_rep--;
+        } else if (low == ld->prev_low && low_rep_ok(tok, i, n, low)) {
+            sym(w, t, T_LOW + 16);
+            ld->low_rep = 15;
+            if (w) g_used.low_rep++;
+        } else {
+            sym(w, t, T_LOW + low);
+            ld->prev_low = low;
+        }
+        break;
+    case T_FILTER:
+        sym(w, t, 257);
+        if (w) {
+            for (s = 0; s < k->len; s++) put_bits(w, g_recs[k->dist + s], 8);
+            g_used.records++;
+        }
+        break;
+    default:
+        /* End of block: "1" new tables, "00" end of file, "01" end of file, new tables next */
+        sym(w, t, 256);
+        raw(w, k->idx != E_FILE, k->idx == E_TABLES ? 1 : 2);
+        break;
+    }
+}
+
+/* Table lengths: 20 pre-code lengths as nibbles (15 + count escapes 15 and zero runs), then the
+   404 lengths through the pre-code - literal ones as deltas from the previous tables (mod 16),
+   runs as 16/17 (repeat the previous length) and 18/19 (zeros) */
+static void put_tables(bitw_t *w, const uint8_t *lens, const uint8_t *old) {
+    uint32_t bfreq[20];
+    uint8_t blens[20], rsym[NTABLES], rext[NTABLES];
+    uint16_t bcodes[20];
+    unsigned i, nr = 0;
+
+    for (i = 0; i < NTABLES; ) {
+        unsigned r = 1;
+        if (lens[i] == 0) {
+            while (i + r < NTABLES && lens[i + r] == 0 && r < 138) r++;
+            if (r >= 11) { rsym[nr] = 19; rext[nr++] = (uint8_t)(r - 11); i += r; continue; }
+            if (r >= 3) { rsym[nr] = 18; rext[nr++] = (uint8_t)(r - 3); i += r; continue; }
+        } else if (i > 0 && lens[i] == lens[i - 1]) {
+            while (i + r < NTABLES && lens[i + r] == lens[i] && r < 138) r++;
+            if (r >= 11) { rsym[nr] = 17; rext[nr++] = (uint8_t)(r - 11); i += r; continue; }
+            if (r >= 3) { rsym[nr] = 16; rext[nr++] = (uint8_t)(r - 3); i += r; continue; }
+        }
+        rsym[nr++] = (uint8_t)((lens[i] - old[i]) & 15);
+        i++;
+    }
+
+    memset(bfreq, 0, sizeof(bfreq));
+    for (i = 0; i < nr; i++) bfreq[rsym[i]]++;
+    huff_lengths(bfreq, 20, 15, blens);
+    huff_codes(blens, 20, bcodes);
+    for (i = 0; i < 20; ) {
+        unsigned r = 1;
+        while (blens[i] == 0 && i + r < 20 && blens[i + r] == 0 && r < 17) r++;
+        if (blens[i] == 0 && r >= 3) {
+            put_bits(w, 15, 4);
+            put_bits(w, r - 2, 4);
+            i += r;
+            continue;
+        }
+        put_bits(w, blens[i], 4);
+        if (blens[i] == 15) put_bits(w, 0, 4);
+        i++;
+    }
+    for (i = 0; i < nr; i++) {
+        put_bits(w, bcodes[rsym[i]], blens[rsym[i]]);
+        if (rsym[i] == 16 || rsym[i] == 18) put_bits(w, rext[i], 3);
+        else if (rsym[i] == 17 || rsym[i] == 19) put_bits(w, rext[i], 7);
+    }
+}
+
+static tables_t g_lz;
+
+/* LZ table read at a byte boundary of w: "0", keep flag (deltas from the previous tables), then
+   the tables for g_tokens[0, n) */
+static void lz_tables(bitw_t *w, size_t n, int keep) {
+    static const uint8_t zeros[NTABLES];
+    tables_t *t = &g_lz;
+    size_t i;
+    lowdist_t ld;
+
+    memset(t->freq, 0, sizeof(t->freq));
+    ld.prev_low = 16;  /* unknown to libarchive after the tables, see low_rep_ok */
+    ld.low_rep = 0;
+    for (i = 0; i < n; i++) put_token(NULL, t, g_tokens, i, n, &ld);
+    huff_lengths(t->freq, PAS_RAR3_NC, 15, t->lens);
+    huff_lengths(t->freq + T_DIST, PAS_RAR3_DC, 15, t->lens + T_DIST);
+    huff_lengths(t->freq + T_LOW, PAS_RAR3_LDC, 15, t->lens + T_LOW);
+    huff_lengths(t->freq + T_RLEN, PAS_RAR3_RC, 15, t->lens + T_RLEN);
+    huff_codes(t->lens, PAS_RAR3_NC, t->codes);
+    huff_codes(t->lens + T_DIST, PAS_RAR3_DC, t->codes + T_DIST);
+    huff_codes(t->lens + T_LOW, PAS_RAR3_LDC, t->codes + T_LOW);
+    huff_codes(t->lens + T_RLEN, PAS_RAR3_RC, t->codes + T_RLEN);
+
+    put_bits(w, 0, 1);
+    put_bits(w, (uint32_t)keep, 1);
+    put_tables(w, t->lens, keep ? g_old_lens : zeros);
+    memcpy(g_old_lens, t->lens, sizeof(g_old_lens));
+}
+
+/* g_tokens[0, n) through the last tables, then to the next byte boundary */
+static void lz_tokens(bitw_t *w, size_t n) {
+    size_t i;
+    lowdist_t ld;
+
+    ld.prev_low = 16;
+    ld.low_rep = 0;
+    for (i = 0; i < n; i++) put_token(w, &g_lz, g_tokens, i, n, &ld);
+    w->bits = (w->bits + 7) & ~(size_t)7;
+}
+
+/* [from, to) as tokens, closed by symbol 256 with end code end; returns the token count */
+static size_t lz_parse(const uint8_t *d, uint32_t size, uint32_t from, uint32_t to, unsigned end, uint32_t max_dist) {
+    size_t n = tokenize(d, from, to, size, max_dist);
+    g_tokens[n].kind = T_END;
+    g_tokens[n++].idx = (uint8_t)end;
+    return n;
+}
+
+/* LZ block for [from, s->end) at a byte boundary of w: tables, tokens, then symbol 256 with end
+   code end - a byte-aligned table read follows for E_TABLES */
+static void pack_lz(bitw_t *w, const uint8_t *d, uint32_t size, uint32_t from, const segment_t *s, unsigned end,
+                    uint32_t max_dist) {
+    size_t n = lz_parse(d, size, from, s->end, end, max_dist);
+    lz_tables(w, n, s->flag);
+    lz_tokens(w, n);
+}
+
+/* ----- PPMd blocks: the library's model, driven from the coding side ----- */
+
+typedef struct {
+    pas_rar__ppm *m;
+    bitw_t       *w;
+    uint32_t      low, range;
+    int           esc;
+} ppm_enc_t;
+
+static ppm_enc_t g_enc;
+
+static void rc_encode(ppm_enc_t *e, uint32_t lo, uint32_t hi, uint32_t scale) {
+    e->low += lo * (e->range /= scale);
+    e->range *= hi - lo;
+}
+
+static void rc_normalize(ppm_enc_t *e) {
+    for (;;) {
+        if ((e->low ^ (e->low + e->range)) >= PAS_RAR_PPM_TOP) {
+            if (e->range >= PAS_RAR_PPM_BOT) break;
+            e->range = (0u - e->low) & (PAS_RAR_PPM_BOT - 1);
+        }
+        put_bits(e->w, e->low >> 24, 8);
+        e->range <<= 8;
+        e->low <<= 8;
+    }
+}
+
+static void rc_flush(ppm_enc_t *e) {
+    unsigned i;
+    for (i = 0; i < 4; i++, e->low <<= 8) put_bits(e->w, e->low >> 24, 8);
+}
+
+/* Mirrors of pas_rar__ppm_decode_bin / decode_symbol1 / decode_symbol2 */
+static void enc_bin(ppm_enc_t *e, pas_rar__ppm_ctx *c, unsigned sym) {
+    static const uint8_t exp_escape[16] = { 25, 14, 9, 7, 5, 5, 4, 4, 4, 3, 3, 3, 2, 2, 2, 2 };
+    pas_rar__ppm *m = e->m;
+    pas_rar__ppm_state *rs = &c->u.one;
+    uint16_t *bs = pas_rar__ppm_bin_summ(m, c);
+
+    e->range >>= PAS_RAR_PPM_TOT_BITS;
+    if (rs->symbol == sym) {
+        e->range *= *bs;
+        m->found_state = rs;
+        rs->freq = (uint8_t)(rs->freq + (rs->freq < 128));
+        *bs = (uint16_t)(*bs + PAS_RAR_PPM_INTERVAL - PAS_RAR_PPM_MEAN(*bs));
+        m->prev_success = 1;
+        m->run_length++;
+    } else {
+        e->low += e->range * *bs;
+        e->range *= PAS_RAR_PPM_BIN_SCALE - *bs;
+        *bs = (uint16_t)(*bs - PAS_RAR_PPM_MEAN(*bs));
+        m->init_esc = exp_escape[*bs >> 10];
+        m->num_masked = 1;
+        m->char_mask[rs->symbol] = m->esc_count;
+        m->prev_success = 0;
+        m->found_state = NULL;
+    }
+}
+
+static void enc_symbol1(ppm_enc_t *e, pas_rar__ppm_ctx *c, unsigned sym) {
+    pas_rar__ppm *m = e->m;
+    pas_rar__ppm_state *p = pas_rar__ppm_stats(m, c);
+    unsigned scale = c->u.s.summ_freq, lo, i;
+
+    m->scale = scale;
+    if (p->symbol == sym) {
+        unsigned hi = p->freq;
+        rc_encode(e, 0, hi, scale);
+        m->prev_success = 2 * hi > scale;
+        m->run_length += (int)m->prev_success;
+        (m->found_state = p)->freq = (uint8_t)(hi + 4);
+        c->u.s.summ_freq += 4;
+        if (hi + 4 > PAS_RAR_PPM_MAX_FREQ) pas_rar__ppm_rescale(m, c);
+        return;
+    }
+    m->prev_success = 0;
+    lo = p->freq;
+    for (i = c->num_stats - 1u; i > 0; i--) {
+        if ((++p)->symbol == sym) {
+            rc_encode(e, lo, lo + p->freq, scale);
+            pas_rar__ppm_update1(m, c, p);
+            return;
+        }
+        lo += p->freq;
+    }
+    m->hi_bits_flag = m->hb2flag[m->found_state->symbol];
+    for (i = 0; i < c->num_stats; i++) m->char_mask[p[-(int)i].symbol] = m->esc_count;
+    m->num_masked = c->num_stats;
+    m->found_state = NULL;
+    rc_encode(e, lo, scale, scale);
+}
+
+static void enc_symbol2(ppm_enc_t *e, pas_rar__ppm_ctx *c, unsigned sym) {
+    pas_rar__ppm *m = e->m;
+    pas_rar__ppm_state *ps[256], *p = pas_rar__ppm_stats(m, c) - 1, *found = NULL;
+    unsigned i = c->num_stats - m->num_masked, n = 0, k, hi = 0, lo = 0;
+    pas_rar__ppm_see *see = pas_rar__ppm_make_esc_freq2(m, c, i);
+
+    do {
+        do {
+            p++;
+        } while (m->char_mask[p->symbol] == m->esc_count);
+        if (p->symbol == sym) {
+            found = p;
+            lo = hi;
+        }
+        hi += p->freq;
+        ps[n++] = p;
+    } while (--i);
+    m->scale += hi;
+    if (found) {
+        rc_encode(e, lo, lo + found->freq, m->scale);
+        pas_rar__ppm_see_update(see);
+        pas_rar__ppm_update2(m, c, found);
+    } else {
+        rc_encode(e, hi, m->scale, m->scale);
+        for (k = 0; k < n; k++) m->char_mask[ps[k]->symbol] = m->esc_count;
+        see->summ = (uint16_t)(see->summ + m->scale);
+        m->num_masked = c->num_stats;
+    }
+}
+
+/* Mirror of pas_rar__ppm_decode_char */
+static void enc_char(ppm_enc_t *e, unsigned sym) {
+    pas_rar__ppm *m = e->m;
+    pas_rar__ppm_ctx *c = m->min_context;
+    uint32_t text = m->text;
+
+    if (c->num_stats != 1) enc_symbol1(e, c, sym);
+    else enc_bin(e, c, sym);
+    while (!m->found_state) {
+        rc_normalize(e);
+        do {
+            m->order_fall++;
+            c = m->min_context = pas_rar__ppm_ctx_at(m, c->suffix);
+        } while (c->num_stats == m->num_masked);
+        enc_symbol2(e, c, sym);
+    }
+    if (!m->order_fall && pas_rar__ppm_succ(m->found_state) > m->text) {
+        m->min_context = m->max_context = pas_rar__ppm_ctx_at(m, pas_rar__ppm_succ(m->found_state));
+    } else {
+        pas_rar__ppm_update_model(m);
+        if (m->esc_count == 0) pas_rar__ppm_clear_mask(m);
+    }
+    if (m->text + 1 < text) g_used.restarts++;
+    rc_normalize(e);
+}
+
+/* PPMd block header at a byte boundary of w: flags (0x80, 0x20 + order for a new model, 0x40 for
+   a new escape byte), model MB - 1, escape byte; the coder starts after it */
+static void ppm_header(bitw_t *w, const segment_t *s) {
+    ppm_enc_t *e = &g_enc;
+
+    put_bits(w, 0x80u | (s->flag ? 0x20u | s->order : 0) | (s->esc >= 0 ? 0x40u : 0), 8);
+    if (s->flag) put_bits(w, s->mb - 1u, 8);
+    if (s->esc >= 0) {
+        put_bits(w, (uint32_t)s->esc, 8);
+        e->esc = s->esc;
+    }
+    if (s->flag) {
+        uint8_t *a = g_model_mem;
+        int order = s->order + 1;
+        if (order > 16) order = 16 + (order - 16) * 3;
+        a += (8 - ((size_t)a & 7)) & 7;
+        e->m = (pas_rar__ppm *)(void *)a;
+        e->m->base = a + sizeof(pas_rar__ppm);
+        pas_rar__ppm_start(e->m, (uint32_t)s->mb << 20, order);
+    }
+    e->w = w;
+    e->low = 0;
+    e->range = 0xffffffffu;
+}
+
+/* [from, to) as PPMd symbols: literals (the escape byte doubled), runs, matches, filter records */
+static void ppm_chars(const uint8_t *d, uint32_t size, uint32_t from, uint32_t to) {
+    ppm_enc_t *e = &g_enc;
+    uint32_t pos = from, i;
+
+    while (pos < to) {
+        uint32_t emit = next_emit(to), max, len = 0, dist = 0;
+
+        if (pos >= emit) {
+            uint16_t n;
+            size_t at = make_record(&g_regions[g_next_region++], pos, &n);
+            enc_char(e, (unsigned)e->esc);
+            enc_char(e, 3);
+            for (i = 0; i < n; i++) enc_char(e, g_recs[at + i]);
+            g_used.records++;
+            continue;
+        }
+        max = emit - pos;
+        if (pos >= 1)
+            while (len < max && len < 259 && d[pos + len] == d[pos - 1]) len++;
+        if (len >= 4) {
+            enc_char(e, (unsigned)e->esc);
+            enc_char(e, 5);
+            enc_char(e, len - 4);
+            g_used.esc_run++;
+        } else if ((len = longest(d, pos, size, max, 0xffffff + 2, 0, &dist)) != 0) {
+            enc_char(e, (unsigned)e->esc);
+            enc_char(e, 4);
+            enc_char(e, (dist - 2) >> 16);
+            enc_char(e, ((dist - 2) >> 8) & 0xff);
+            enc_char(e, (dist - 2) & 0xff);
+            enc_char(e, len - 32);
+            g_used.esc_match++;
+        } else {
+            len = 1;
+            enc_char(e, d[pos]);
+            if (d[pos] == e->esc) {
+                enc_char(e, 1);
+                g_used.esc_lit++;
+            }
+        }
+        for (i = 0; i < len; i++) insert(d, pos++, size);
+    }
+}
+
+/* PPMd block for [from, s->end) - ending in escape + 0 (tables follow) or escape + 2 (end of file) */
+static void pack_ppm(bitw_t *w, const uint8_t *d, uint32_t size, uint32_t from, const segment_t *s, int last) {
+    ppm_header(w, s);
+    ppm_chars(d, size, from, s->end);
+    enc_char(&g_enc, (unsigned)g_enc.esc);
+    enc_char(&g_enc, last ? 2 : 0);
+    rc_flush(&g_enc);
+}
+
+/* ----- Packer: segments of LZ and PPMd blocks over one bit stream ----- */
+
+/* Fresh packer state: empty match finder, no repeats, tables, programs or records */
+static void pack_reset(const region_t *regions, unsigned nregions) {
+    unsigned i;
+
+    memset(g_head, 0xff, sizeof(g_head));
+    memset(g_last2, 0xff, sizeof(g_last2));
+    memset(g_old, 0, sizeof(g_old));
+    memset(g_old_lens, 0, sizeof(g_old_lens));
+    for (i = 0; i < F_COUNT; i++) g_prog_num[i] = -1;
+    g_nprogs = 0;
+    g_last_prog = -1;
+    g_last_len = 0;
+    g_nrecs = 0;
+    g_regions = regions;
+    g_nregions = nregions;
+    g_next_region = 0;
+    g_enc.esc = 2;
+}
+
+static size_t pack(const uint8_t *orig, uint32_t size, const region_t *regions, unsigned nregions,
+                   const segment_t *segs, unsigned nsegs, uint32_t max_dist, uint8_t *out) {
+    bitw_t w;
+    uint32_t from = 0;
+    unsigned i;
+
+    memcpy(g_win, orig, size);
+    for (i = 0; i < nregions; i++) forward_filter(&regions[i], orig, g_win);
+    pack_reset(regions, nregions);
+
+    w.buf = out;
+    w.bits = 0;
+    for (i = 0; i < nsegs; i++) {
+        if (segs[i].kind == S_LZ)
+            pack_lz(&w, g_win, size, from, &segs[i], i + 1 == nsegs ? E_FILE : E_TABLES, max_dist);
+        else pack_ppm(&w, g_win, size, from, &segs[i], i + 1 == nsegs);
+        from = segs[i].end;
+    }
+    return (w.bits + 7) / 8;
+}
+
+/* Solid run over g_s, one packer stream cut into the files' data (ends in g_cut):
+   s0.txt  LZ, ending "new file, new tables"
+   s1.bin  tables, LZ, then a new PPMd model that runs on past the end of the file
+   s2.txt  more of that PPMd block; escape + 0 switches to LZ tables made for s3.txt, then
+           "new file" keeps them
+   s3.txt  LZ on those tables, ending "new file, new tables"
+   s5.txt  tables as deltas, LZ (a stored note.txt comes before it in the archive) */
+static size_t g_cut[5];
+
+static void pack_solid(void) {
+    static const segment_t lz0 = { 30000, S_LZ, 0, 0, 0, -1 }, lz1 = { 45000, S_LZ, 1, 0, 0, -1 };
+    static const segment_t ppm1 = { 90000, S_PPM, 1, 5, 1, -1 }, lz5 = { SIZE_S, S_LZ, 1, 0, 0, -1 };
+    const uint32_t max_dist = 1u << 20;
+    bitw_t w;
+    size_t n;
+
+    pack_reset(NULL, 0);
+    w.buf = g_pack;
+    w.bits = 0;
+    pack_lz(&w, g_s, SIZE_S, 0, &lz0, E_FILE_TABLES, max_dist);
+    g_cut[0] = w.bits / 8;
+
+    pack_lz(&w, g_s, SIZE_S, 30000, &lz1, E_TABLES, max_dist);
+    ppm_header(&w, &ppm1);
+    ppm_chars(g_s, SIZE_S, 45000, 60000);
+    enc_char(&g_enc, (unsigned)g_enc.esc);
+    enc_char(&g_enc, 2);
+    /* The decoder holds 4 bytes past what the coder has put out: they still belong to s1.bin */
+    g_cut[1] = w.bits / 8 + 4;
+
+    ppm_chars(g_s, SIZE_S, 60000, 90000);
+    enc_char(&g_enc, (unsigned)g_enc.esc);
+    enc_char(&g_enc, 0);
+    rc_flush(&g_enc);
+    n = lz_parse(g_s, SIZE_S, 90000, 120000, E_FILE_TABLES, max_dist);
+    lz_tables(&w, n, 1);
+    put_bits(&w, g_lz.codes[256], g_lz.lens[256]);   /* "00": new file, same tables */
+    put_bits(&w, 0, 2);
+    w.bits = (w.bits + 7) & ~(size_t)7;
+    g_cut[2] = w.bits / 8;
+
+    lz_tokens(&w, n);
+    g_cut[3] = w.bits / 8;
+
+    pack_lz(&w, g_s, SIZE_S, 120000, &lz5, E_FILE, max_dist);
+    g_cut[4] = w.bits / 8;
+}
+
+/* ----- RAR4 archive ----- */
+
+/* Header CRC: low 16 bits of the CRC32 from HEAD_TYPE on */
+static void seal(uint8_t *h, size_t size) { put16(h, crc32_buf(h + 2, size - 2) & 0xFFFF); }
+
+static size_t start_archive(uint8_t *out) {
+    static const uint8_t marker[7] = { 'R', 'a', 'r', '!', 0x1A, 0x07, 0x00 };
+    memcpy(out, marker, 7);
+    memset(out + 7, 0, 13);
+    out[9] = 0x73;
+    put16(out + 12, 13);
+    seal(out + 7, 13);
+    return 20;
+}
+
+static size_t end_archive(uint8_t *out) {
+    memset(out, 0, 7);
+    out[2] = 0x7B;
+    put16(out + 3, 0x4000);
+    put16(out + 5, 7);
+    seal(out, 7);
+    return 7;
+}
+
+/* File header (dictionary 64 KB << dict) + packed data */
+static size_t add_file(uint8_t *out, const char *name, const uint8_t *data, uint32_t size,
+                       const uint8_t *packed, size_t packed_size, unsigned ver, unsigned method, unsigned dict) {
+    size_t nl = strlen(name);
+    memset(out, 0, 32);
+    out[2] = 0x74;
+    put16(out + 3, 0x8000 | dict << 5);
+    put16(out + 5, (unsigned)(32 + nl));
+    put32(out + 7, (uint32_t)packed_size);
+    put32(out + 11, size);
+    out[15] = 2;                           /* host OS: Windows */
+    put32(out + 16, crc32_buf(data, size));
+    put32(out + 20, 0x5A8C6000u);          /* DOS time */
+    out[24] = (uint8_t)ver;
+    out[25] = (uint8_t)method;
+    put16(out + 26, (unsigned)nl);
+    put32(out + 28, 0x20);
+    memcpy(out + 32, name, nl);
+    seal(out, 32 + nl);
+    memcpy(out + 32 + nl, packed, packed_size);
+    return 32 + nl + packed_size;
+}
+
+static void set_solid(uint8_t *h) {
+    h[3] |= 0x10;                          /* LHD_SOLID */
+    seal(h, h[5] | (size_t)h[6] << 8);
+}
+
+/* ----- Volumes ----- */
+
+/* Marker and main header of volume n: MHD_VOLUME, MHD_FIRSTVOLUME on the first */
+static uint8_t *start_volume(uint8_t *out, size_t n, unsigned main_flags) {
+    g_vols[n].data = out;
+    (void)start_archive(out);
+    put16(out + 10, main_flags | 0x0001 | (n ? 0 : 0x0100));
+    seal(out + 7, 13);
+    return out + 20;
+}
+
+/* End of archive closing volume n; EARC_NEXT_VOLUME when more follow */
+static uint8_t *end_volume(uint8_t *out, size_t n, int more) {
+    out += end_archive(out);
+    if (more) {
+        put16(out - 4, 0x4001);
+        seal(out - 7, 7);
+    }
+    g_vols[n].size = (size_t)(out - (const uint8_t *)g_vols[n].data);
+    return out;
+}
+
+/* Cut archive src into volumes holding at most chunk bytes of file data each, the way RAR splits
+   them: file data crossing a cut goes on in the next volume under a copy of the file header
+   flagged LHD_SPLIT_AFTER (0x02) here and LHD_SPLIT_BEFORE (0x01) there; a part followed by
+   another carries the CRC32 of its own packed bytes. Returns the volume count. */
+static size_t make_volumes(const uint8_t *src, size_t len, size_t chunk) {
+    unsigned main_flags = src[10] | (unsigned)src[11] << 8;
+    size_t off = 20, n = 0, room = chunk;
+    uint8_t *out = start_volume(g_vol_data, 0, main_flags);
+
+    while (off + 7 <= len && src[off + 2] != 0x7B) {
+        const uint8_t *h = src + off;
+        unsigned flags = h[3] | (unsigned)h[4] << 8, hsize = h[5] | (unsigned)h[6] << 8;
+        uint32_t add = (flags & 0x8000) ? get32(h + 7) : 0, done = 0, take;
+
+        off += hsize + add;
+        if (h[2] != 0x74) {
+            memcpy(out, h, hsize + add);
+            out += hsize + add;
+            continue;
+        }
+        do {
+            if (!room) {
+                out = end_volume(out, n++, 1);
+                out = start_volume(out, n, main_flags);
+                room = chunk;
+            }
+            take = add - done < room ? add - done : (uint32_t)room;
+            memcpy(out, h, hsize);
+            put16(out + 3, flags | (done ? 0x01 : 0) | (done + take < add ? 0x02 : 0));
+            put32(out + 7, take);
+            if (done + take < add) put32(out + 16, crc32_buf(h + hsize + done, take));
+            seal(out, hsize);
+            memcpy(out + hsize, h + hsize + done, take);
+            out += hsize + take;
+            done += take;
+            room -= take;
+        } while (done < add);
+    }
+    (void)end_volume(out, n, 0);
+    return n + 1;
+}
+
+/* ----- Test data ----- */
+
+static const char *k_words[] = {
+    "the ", "archive ", "window ", "filter ", "block ", "of ", "Huffman ", "PPMd ", "model ",
+    "decoder ", "table\n", "and ", "a ", "escape ", "context ", "order ", "symbol ", "range "
+};
+
+/* Words, with copies of earlier text (PPMd matches, LZ repeats) and runs mixed in */
+static void gen_text(uint8_t *d, uint32_t pos, uint32_t end, int vocab) {
+    while (pos < end) {
+        uint32_t r = rnd() % 100, n, i;
+        if (r < 3 && pos > 2000) {
+            uint32_t dist = 1 + rnd() % (pos < 60000 ? pos : 60000);
+            n = 32 + rnd() % 220;
+            for (i = 0; i < n && pos < end; i++, pos++) d[pos] = d[pos - dist];
+        } else if (r < 5) {
+            uint8_t c = "  -=\0*"[rnd() % 6];
+            n = 4 + rnd() % 300;
+            for (i = 0; i < n && pos < end; i++) d[pos++] = c;
+        } else if (vocab) {
+            /* Made-up words and numbers: many distinct contexts to fill a small model */
+            n = 2 + rnd() % 8;
+            for (i = 0; i < n && pos < end; i++) d[pos++] = (uint8_t)("etaoinshrdlucmfwyp"[rnd() % 18] - (rnd() % 9 == 0 ? 32 : 0));
+            if (pos < end) d[pos++] = rnd() % 7 ? ' ' : (uint8_t)('0' + rnd() % 10);
+        } else {
+            const char *w = k_words[rnd() % (sizeof(k_words) / sizeof(k_words[0]))];
+            n = (uint32_t)strlen(w);
+            for (i = 0; i < n && pos < end; i++) d[pos++] = (uint8_t)w[i];
+        }
+    }
+}
+
+static void gen_random(uint8_t *d, uint32_t pos, uint32_t end) {
+    while (pos < end) d[pos++] = (uint8_t)rnd();
+}
+
+/* x86-ish code: opcodes from a small set, calls and jumps with near, far and negative targets */
+static void gen_code(uint8_t *d, uint32_t pos, uint32_t end) {
+    static const uint8_t ops[8] = { 0x8b, 0x89, 0x55, 0xc3, 0x48, 0x0f, 0x83, 0x90 };
+    while (pos < end) {
+        uint32_t r = rnd() % 16, rel;
+        if (r < 3 && pos + 5 <= end) {
+            d[pos++] = r == 2 ? 0xe9 : 0xe8;
+            r = rnd() % 8;
+            rel = r < 5 ? (uint32_t)(rnd() % 8192) - 4096u : r < 6 ? 0x02000000u + rnd() : 0u - pos - 100 - rnd() % 1000;
+            put32(d + pos, rel);
+            pos += 4;
+        } else {
+            d[pos++] = ops[rnd() % 8];
+        }
+    }
+}
+
+/* channels interleaved slow random walks */
+static void gen_walk(uint8_t *d, uint32_t pos, uint32_t end, unsigned channels) {
+    uint8_t v[8];
+    unsigned c = 0;
+    memset(v, 128, sizeof(v));
+    for (; pos < end; pos++, c = (c + 1) % channels) {
+        v[c] = (uint8_t)(v[c] + (int)(rnd() % 5) - 2);
+        d[pos] = v[c];
+    }
+}
+
+/* 24-bit image: gradients plus noise */
+static void gen_image(uint8_t *d, uint32_t pos, uint32_t end, uint32_t width) {
+    uint32_t i;
+    for (i = 0; pos < end; i++, pos++) {
+        uint32_t x = (i % width) / 3, y = i / width, c = i % 3;
+        d[pos] = (uint8_t)(x * (c + 1) + y * 2 + rnd() % 4);
+    }
+}
+
+/* Stereo 8-bit audio: triangle waves plus noise */
+static void gen_audio(uint8_t *d, uint32_t pos, uint32_t end) {
+    uint32_t i;
+    for (i = 0; pos < end; i++, pos++) {
+        uint32_t t = (i / 2) % (i & 1 ? 200 : 146), half = (i & 1 ? 100 : 73);
+        uint32_t tri = t < half ? t : 2 * half - t;
+        d[pos] = (uint8_t)(80 + tri + rnd() % 3);
+    }
+}
+
+/* Chunks copied from distances that all end in the same 4 low bits, rotating through more of
+   them than the repeat slots hold: far matches whose low bits the decoder can reuse */
+static void gen_low_rep(uint8_t *d, uint32_t pos, uint32_t end) {
+    static const uint32_t dists[6] = { 20001, 24017, 28033, 32049, 36065, 40081 };
+    unsigned k = 0;
+    while (pos < end) {
+        uint32_t n = 20 + rnd() % 20, i;
+        for (i = 0; i < n && pos < end; i++, pos++) d[pos] = d[pos - dists[k]];
+        k = (k + 1) % 6;
+    }
+}
+
+/* Pieces of the random block at [src, src + 20000) from more than 256 KB back */
+static void gen_far(uint8_t *d, uint32_t pos, uint32_t end, uint32_t src) {
+    while (pos < end) {
+        uint32_t n = 50 + rnd() % 150, from = src + rnd() % (20000 - 200), i;
+        for (i = 0; i < n && pos < end; i++) d[pos++] = d[from + i];
+        if (pos < end) d[pos++] = (uint8_t)rnd();
+    }
+}
+
+static const region_t k_regions_a[7] = {
+    { 40000, 20000, F_E8, 0, 0, 300 },
+    { 80000, 20000, F_DELTA, 4, 0, 0 },
+    { 200000, 30000, F_RGB, 303, 1, 300 },
+    { 260000, 40000, F_AUDIO, 2, 0, 0 },
+    { 470000, 5000, F_DELTA, 3, 0, 0 },
+    { 480000, 5000, F_DELTA, 4, 0, 100 },  /* same program as the one before: no number */
+    { 540000, 20000, F_E8E9, 0, 0, 300 }
+};
+static const segment_t k_segs_a[7] = {
+    { 120000, S_LZ, 0, 0, 0, -1 },
+    { 330000, S_PPM, 1, 5, MODEL_MB, -1 },   /* order 6 */
+    { 450000, S_LZ, 0, 0, 0, -1 },           /* back to LZ, fresh tables */
+    { 520000, S_LZ, 1, 0, 0, -1 },           /* tables as deltas */
+    { 600000, S_PPM, 0, 0, 0, 'e' },         /* the same model, a frequent escape byte */
+    { 700000, S_PPM, 1, 31, 2, -1 },         /* order 64, 'e' stays the escape */
+    { SIZE_A, S_LZ, 1, 0, 0, -1 }            /* deltas from the tables before the PPMd blocks */
+};
+static const segment_t k_segs_b[1] = { { SIZE_B, S_PPM, 1, 31, 1, -1 } };
+static const region_t k_regions_c[2] = {
+    { 100000, 16000, F_DELTA, 2, 0, 0 },
+    { 200000, 20000, F_E8, 0, 0, 0 }
+};
+static const segment_t k_segs_c[2] = { { 150000, S_LZ, 0, 0, 0, -1 }, { SIZE_C, S_LZ, 1, 0, 0, -1 } };
+static const region_t k_regions_f[2] = {
+    { 2000, 1000, F_DELTA, 2, 0, 0 },
+    { 9000, 2000, F_E8, 0, 0, 0 }
+};
+static const segment_t k_segs_f[3] = {
+    { 8000, S_LZ, 0, 0, 0, -1 }, { 16000, S_PPM, 1, 3, 1, -1 }, { SIZE_F, S_LZ, 1, 0, 0, -1 }
+};
+static const region_t k_region_d = { 1000, 500, F_UNKNOWN, 0, 0, 0 };
+static const segment_t k_segs_d = { 4000, S_LZ, 0, 0, 0, -1 };
+
+static void make_data(void) {
+    gen_text(g_a, 0, 40000, 0);
+    gen_code(g_a, 40000, 60000);
+    gen_text(g_a, 60000, 80000, 0);
+    gen_walk(g_a, 80000, 100000, 4);
+    gen_random(g_a, 100000, 120000);
+    gen_text(g_a, 120000, 200000, 0);
+    gen_image(g_a, 200000, 230000, 300);
+    gen_text(g_a, 230000, 260000, 0);
+    gen_audio(g_a, 260000, 300000);
+    gen_text(g_a, 300000, 330000, 0);
+    gen_random(g_a, 330000, 372000);
+    gen_low_rep(g_a, 372000, 392000);
+    gen_far(g_a, 392000, 420000, 100000);
+    gen_text(g_a, 420000, 470000, 0);
+    gen_walk(g_a, 470000, 475000, 3);
+    gen_text(g_a, 475000, 480000, 0);
+    gen_walk(g_a, 480000, 485000, 4);
+    gen_text(g_a, 485000, 540000, 0);
+    gen_code(g_a, 540000, 560000);
+    gen_text(g_a, 560000, SIZE_A, 0);
+
+    gen_text(g_b, 0, SIZE_B, 1);
+
+    gen_text(g_c, 0, 100000, 0);
+    gen_walk(g_c, 100000, 116000, 2);
+    gen_text(g_c, 116000, 200000, 0);
+    gen_code(g_c, 200000, 220000);
+    gen_text(g_c, 220000, SIZE_C, 0);
+
+    gen_text(g_f, 0, 2000, 0);
+    gen_walk(g_f, 2000, 3000, 2);
+    gen_text(g_f, 3000, 9000, 0);
+    gen_code(g_f, 9000, 11000);
+    gen_text(g_f, 11000, SIZE_F, 0);
+
+    gen_text(g_s, 0, 30000, 0);
+    gen_code(g_s, 30000, 45000);
+    gen_text(g_s, 45000, 90000, 1);
+    gen_text(g_s, 90000, 120000, 0);
+    gen_far(g_s, 120000, SIZE_S, 5000);
+}
+
+static size_t g_packed_f_at, g_packed_f;
+
+static size_t make_archive(void) {
+    static const uint8_t order1[8] = { 0xA0, 0x00, 0, 0, 0, 0, 0, 0 };  /* PPMd order 1: invalid */
+    static const uint8_t no_model[8] = { 0x80, 0, 0, 0, 0, 0, 0, 0 };   /* PPMd block, no model yet */
+    size_t len = start_archive(g_rar), n;
+
+    n = pack(g_a, SIZE_A, k_regions_a, 7, k_segs_a, 7, 1u << 20, g_pack);
+    len += add_file(g_rar + len, "mixed.bin", g_a, SIZE_A, g_pack, n, 29, 0x33, 4);
+    n = pack(g_b, SIZE_B, NULL, 0, k_segs_b, 1, 1u << 22, g_pack);
+    len += add_file(g_rar + len, "ppmd.txt", g_b, SIZE_B, g_pack, n, 29, 0x35, 6);
+    n = pack(g_c, SIZE_C, k_regions_c, 2, k_segs_c, 2, 1u << 16, g_pack);
+    len += add_file(g_rar + len, "small_dict.bin", g_c, SIZE_C, g_pack, n, 36, 0x33, 0);
+    n = pack(g_f, SIZE_F, k_regions_f, 2, k_segs_f, 3, 1u << 16, g_pack);
+    g_packed_f = n;
+    g_packed_f_at = len + 32 + strlen("fuzz.bin");
+    len += add_file(g_rar + len, "fuzz.bin", g_f, SIZE_F, g_pack, n, 29, 0x33, 0);
+    n = pack(g_a, 4000, &k_region_d, 1, &k_segs_d, 1, 1u << 16, g_pack);
+    len += add_file(g_rar + len, "unknown_filter.bin", g_a, 4000, g_pack, n, 29, 0x33, 0);
+    len += add_file(g_rar + len, "rar20.bin", g_a, 100, g_pack, 50, 20, 0x33, 0);
+    len += add_file(g_rar + len, "order1.bin", g_a, 100, order1, sizeof(order1), 29, 0x33, 0);
+    len += add_file(g_rar + len, "no_model.bin", g_a, 100, no_model, sizeof(no_model), 29, 0x33, 0);
+    return len + end_archive(g_rar + len);
+}
+
+/* The solid run in archive order; note.txt is stored */
+static const struct { const char *name; uint32_t from, to; } k_solid[6] = {
+    { "s0.txt", 0, 30000 }, { "s1.bin", 30000, 60000 }, { "s2.txt", 60000, 90000 },
+    { "s3.txt", 90000, 120000 }, { "note.txt", 0, 100 }, { "s5.txt", 120000, SIZE_S }
+};
+
+static size_t make_solid(void) {
+    size_t len = start_archive(g_srar), at, from = 0;
+    unsigned i, k = 0;
+
+    put16(g_srar + 10, 0x0008);            /* MHD_SOLID */
+    seal(g_srar + 7, 13);
+    pack_solid();
+    for (i = 0; i < 6; i++) {
+        const uint8_t *d = g_s + k_solid[i].from;
+        uint32_t size = k_solid[i].to - k_solid[i].from;
+        at = len;
+        if (i == 4) {
+            len += add_file(g_srar + len, k_solid[i].name, d, size, d, size, 29, 0x30, 4);
+        } else {
+            len += add_file(g_srar + len, k_solid[i].name, d, size, g_pack + from, g_cut[k] - from, 29, 0x33, 4);
+            from = g_cut[k++];
+        }
+        if (i) set_solid(g_srar + at);
+    }
+    return len + end_archive(g_srar + len);
+}
+
+/* Walk the solid archive, extracting the entries set in mask (bit i: entry i) */
+static int seq_walk(const pas_rar_t *rar, size_t window_size, unsigned mask) {
+    pas_rar_seq_t seq;
+    pas_rar_file_t f;
+    pas_rar_status st;
+    const char *name;
+    size_t len;
+    unsigned i;
+
+    if (!pas_rar_seq_begin(&seq, rar, &g_state, g_out + SIZE_S, window_size, &st)) return 0;
+    for (i = 0; i < 6; i++) {
+        uint32_t size = k_solid[i].to - k_solid[i].from;
+        if (!pas_rar_seq_next(&seq, &f, &st)) return 0;
+        name = pas_rar_name_span(&f, &len);
+        if (len != strlen(k_solid[i].name) || memcmp(name, k_solid[i].name, len) != 0) return 0;
+        if (!(mask >> i & 1)) continue;
+        if (pas_rar_seq_extract(&seq, g_out, SIZE_S, &st) != size || st != PAS_RAR_OK ||
+            memcmp(g_out, g_s + k_solid[i].from, size) != 0)
+            return 0;
+    }
+    return pas_rar_seq_next(&seq, &f, &st) == 0 && st == PAS_RAR_OK;
+}
+
+static size_t extract_status(pas_rar_t *rar, const char *name, size_t size, pas_rar_status *st) {
+    pas_rar_file_t f;
+    if (!pas_rar_find_ex(rar, name, &f)) return (size_t)-1;
+    return pas_rar_extract(&f, g_out, size, st);
+}
+
+int main(void) {
+    pas_rar_status st;
+    pas_rar_t rar, fuzz_rar, srar, vrar;
+    pas_rar_file_t f, g;
+    pas_rar_seq_t seq;
+    size_t len, n, win, nv;
+    unsigned i, bad = 0;
+
+    g_failed = 0;
+    g_assertions = 0;
+
+    init_slots();
+    for (i = 0; i < F_COUNT; i++) forge_prog(g_prog[i], k_progs[i].len, k_progs[i].crc);
+    make_data();
+    len = make_archive();
+
+    /* Every code of the format went into the packed data */
+    ASSERT(g_used.lit > 0 && g_used.last > 0 && g_used.rep > 0 && g_used.shrt > 0);
+    ASSERT(g_used.match > 0 && g_used.far > 0 && g_used.low_rep > 0);
+    ASSERT(g_used.esc_lit > 0 && g_used.esc_match > 0 && g_used.esc_run > 0);
+    ASSERT_EQ(g_used.records, 7u + 2u + 2u + 1u);
+    ASSERT(g_used.restarts > 0);
+
+    ASSERT(pas_rar_ppm_arena_size(0) == 0);
+    ASSERT(pas_rar_ppm_arena_size(PAS_RAR_PPM_MAX_MB + 1) == 0);
+    ASSERT(pas_rar_ppm_arena_size(1) > (1u << 20));
+    ASSERT(pas_rar_ppm_arena_size(MODEL_MB) <= sizeof(g_model_mem));
+
+    ASSERT(pas_rar_open_ex(&rar, g_rar, len, &st));
+    ASSERT_EQ(rar.format, 4);
+
+    /* LZ and PPMd blocks, all filter types */
+    ASSERT(pas_rar_find_ex(&rar, "mixed.bin", &f));
+    ASSERT(pas_rar_is_compressed(&f));
+    ASSERT_EQ(f.unpack_version, 29);
+    ASSERT_EQ(f.dict_size, 1u << 20);
+    win = pas_rar_window_size(&f);
+    ASSERT_EQ(win, SIZE_A);
+    n = pas_rar_extract(&f, g_out, SIZE_A + win + pas_rar_ppm_arena_size(MODEL_MB), &st);
+    ASSERT(st == PAS_RAR_OK);
+    ASSERT_EQ(n, SIZE_A);
+    ASSERT(memcmp(g_out, g_a, SIZE_A) == 0);
+    ASSERT_EQ(pas_rar_extract(&f, g_out, SIZE_A + win, &st), 0u);
+    ASSERT(st == PAS_RAR_E_NOSPACE);
+    memset(g_out, 0, SIZE_A);
+    n = pas_rar_extract_ex(&f, g_out, SIZE_A, &g_state, g_out + SIZE_A + 3, win + pas_rar_ppm_arena_size(MODEL_MB), &st);
+    ASSERT(st == PAS_RAR_OK);
+    ASSERT_EQ(n, SIZE_A);
+    ASSERT(memcmp(g_out, g_a, SIZE_A) == 0);
+    ASSERT_EQ(pas_rar_extract_ex(&f, g_out, SIZE_A, &g_state, g_out + SIZE_A, win + pas_rar_ppm_arena_size(2), &st), 0u);
+    ASSERT(st == PAS_RAR_E_NOSPACE);
+
+    /* Cut short: the decoder runs out of input */
+    g = f;
+    g.packed_size /= 2;
+    g.part_size = g.packed_size;
+    ASSERT_EQ(pas_rar_extract_ex(&g, g_out, SIZE_A, &g_state, g_out + SIZE_A, win + pas_rar_ppm_arena_size(MODEL_MB), &st), 0u);
+    ASSERT(st == PAS_RAR_E_INVALID);
+
+    /* A 1 MB model that fills up and restarts many times */
+    ASSERT(pas_rar_find_ex(&rar, "ppmd.txt", &f));
+    win = pas_rar_window_size(&f);
+    n = pas_rar_extract(&f, g_out, SIZE_B + win + pas_rar_ppm_arena_size(1), &st);
+    ASSERT(st == PAS_RAR_OK);
+    ASSERT_EQ(n, SIZE_B);
+    ASSERT(memcmp(g_out, g_b, SIZE_B) == 0);
+
+    /* 64 KB dictionary: the window wraps many times under the filters */
+    ASSERT(pas_rar_find_ex(&rar, "small_dict.bin", &f));
+    ASSERT_EQ(f.unpack_version, 36);
+    memset(g_out, 0, SIZE_C);
+    n = pas_rar_extract_ex(&f, g_out, SIZE_C, &g_state, g_out + SIZE_C, 65536, &st);
+    ASSERT(st == PAS_RAR_OK);
+    ASSERT_EQ(n, SIZE_C);
+    ASSERT(memcmp(g_out, g_c, SIZE_C) == 0);
+    ASSERT_EQ(pas_rar_extract_ex(&f, g_out, SIZE_C, &g_state, g_out + SIZE_C, 32768, &st), 0u);
+    ASSERT(st == PAS_RAR_E_NOSPACE);
+
+    ASSERT_EQ(extract_status(&rar, "unknown_filter.bin", sizeof(g_out), &st), 0u);
+    ASSERT(st == PAS_RAR_E_UNSUPPORTED);
+    ASSERT_EQ(extract_status(&rar, "rar20.bin", sizeof(g_out), &st), 0u);
+    ASSERT(st == PAS_RAR_E_COMPRESSED);
+    ASSERT_EQ(extract_status(&rar, "order1.bin", sizeof(g_out), &st), 0u);
+    ASSERT(st == PAS_RAR_E_INVALID);
+    ASSERT_EQ(extract_status(&rar, "no_model.bin", sizeof(g_out), &st), 0u);
+    ASSERT(st == PAS_RAR_E_INVALID);
+
+    /* Corrupted copies of a small mixed stream fail cleanly or decode to something */
+    ASSERT(pas_rar_find_ex(&rar, "fuzz.bin", &f));
+    ASSERT_EQ(extract_status(&rar, "fuzz.bin", sizeof(g_out), &st), SIZE_F);
+    ASSERT(memcmp(g_out, g_f, SIZE_F) == 0);
+    ASSERT_EQ((size_t)f.data_offset, g_packed_f_at);
+    fuzz_rar = rar;
+    fuzz_rar.data = g_fuzz;
+    fuzz_rar.size = g_packed_f;
+    f.rar = &fuzz_rar;
+    f.data_offset = 0;
+    for (i = 0; i < 400; i++) {
+        unsigned k, flips = 1 + rnd() % 3;
+        memcpy(g_fuzz, g_rar + g_packed_f_at, g_packed_f);
+        for (k = 0; k < flips; k++) g_fuzz[rnd() % g_packed_f] ^= (uint8_t)(1u << (rnd() % 8));
+        n = pas_rar_extract_ex(&f, g_out, SIZE_F, &g_state, g_out + SIZE_F, SIZE_F + pas_rar_ppm_arena_size(1), &st);
+        if (st == PAS_RAR_OK ? n != SIZE_F
+                             : n != 0 || (st != PAS_RAR_E_INVALID && st != PAS_RAR_E_UNSUPPORTED && st != PAS_RAR_E_NOSPACE))
+            bad++;
+    }
+    ASSERT_EQ(bad, 0u);
+
+    /* Volumes of 100000 data bytes: mixed.bin and ppmd.txt are split, the LZ and PPMd streams
+       read on across the cuts */
+    nv = make_volumes(g_rar, len, 100000);
+    ASSERT(nv >= 6);
+    ASSERT(pas_rar_open_volumes(&vrar, g_vols, nv, &st));
+    ASSERT(pas_rar_find_ex(&vrar, "mixed.bin", &f));
+    ASSERT(f.volume == 0 && f.split == PAS_RAR_SPLIT_AFTER && f.part_size == 100000u);
+    /* FILE_CRC of the whole file from the last part; rar->verify checks it */
+    ASSERT_EQ(f.checks, PAS_RAR_CHECK_CRC32);
+    ASSERT_EQ(f.crc32, crc32_buf(g_a, SIZE_A));
+    vrar.verify = 1;
+    win = pas_rar_window_size(&f);
+    memset(g_out, 0, SIZE_A);
+    n = pas_rar_extract(&f, g_out, SIZE_A + win + pas_rar_ppm_arena_size(MODEL_MB), &st);
+    ASSERT(st == PAS_RAR_OK && n == SIZE_A && memcmp(g_out, g_a, SIZE_A) == 0);
+    f.crc32 ^= 1;
+    ASSERT_EQ(pas_rar_extract(&f, g_out, SIZE_A + win + pas_rar_ppm_arena_size(MODEL_MB), &st), 0u);
+    ASSERT(st == PAS_RAR_E_CRC);
+    ASSERT(pas_rar_find_ex(&vrar, "ppmd.txt", &f));
+    ASSERT(f.volume == 1 && f.split == PAS_RAR_SPLIT_AFTER);
+    win = pas_rar_window_size(&f);
+    n = pas_rar_extract(&f, g_out, SIZE_B + win + pas_rar_ppm_arena_size(1), &st);
+    ASSERT(st == PAS_RAR_OK && n == SIZE_B && memcmp(g_out, g_b, SIZE_B) == 0);
+    ASSERT_EQ(extract_status(&vrar, "small_dict.bin", sizeof(g_out), &st), SIZE_C);
+    ASSERT(memcmp(g_out, g_c, SIZE_C) == 0);
+
+    /* 4-byte parts, so every bit read near a cut looks into the next volumes; note.txt (stored)
+       is split as well. Without the last volume fuzz.bin lacks data; alone, the first volume
+       lists note.txt but cannot extract it. */
+    len = start_archive(g_fuzz);
+    len += add_file(g_fuzz + len, "note.txt", (const uint8_t *)"stored", 6, (const uint8_t *)"stored", 6, 29, 0x30, 0);
+    len += add_file(g_fuzz + len, "fuzz.bin", g_f, SIZE_F, g_rar + g_packed_f_at, g_packed_f, 29, 0x33, 0);
+    len += end_archive(g_fuzz + len);
+    nv = make_volumes(g_fuzz, len, 4);
+    ASSERT_EQ(nv, (6 + g_packed_f + 3) / 4);
+    ASSERT(pas_rar_open_volumes(&vrar, g_vols, nv, &st));
+    vrar.verify = 1;
+    ASSERT_EQ(extract_status(&vrar, "fuzz.bin", sizeof(g_out), &st), SIZE_F);
+    ASSERT(memcmp(g_out, g_f, SIZE_F) == 0);
+    ASSERT(pas_rar_find_ex(&vrar, "note.txt", &f));
+    ASSERT(f.split == PAS_RAR_SPLIT_AFTER && f.part_size == 4u && f.packed_size == 6u);
+    ASSERT_EQ(extract_status(&vrar, "note.txt", 6, &st), 6u);
+    ASSERT(memcmp(g_out, "stored", 6) == 0);
+    ASSERT(pas_rar_open_volumes(&vrar, g_vols, nv - 1, &st));
+    ASSERT(pas_rar_find_ex(&vrar, "fuzz.bin", &f));
+    ASSERT(f.packed_size < g_packed_f);
+    ASSERT_EQ(pas_rar_extract(&f, g_out, sizeof(g_out), &st), 0u);
+    ASSERT(st == PAS_RAR_E_INVALID);
+    ASSERT(pas_rar_open_ex(&vrar, g_vols[0].data, g_vols[0].size, &st));
+    ASSERT_EQ(extract_status(&vrar, "note.txt", 6, &st), 0u);
+    ASSERT(st == PAS_RAR_E_INVALID);
+
+    /* Solid run: every subset of the entries extracts through pas_rar_seq_*, the rest decoded
+       on the way */
+    len = make_solid();
+    ASSERT(pas_rar_open_ex(&srar, g_srar, len, &st));
+    win = pas_rar_seq_window_size(&srar);
+    ASSERT_EQ(win, SIZE_S);
+    for (i = 0, bad = 0; i < 64; i++) bad += !seq_walk(&srar, win + pas_rar_ppm_arena_size(1), i);
+    ASSERT_EQ(bad, 0u);
+    ASSERT(pas_rar_find_ex(&srar, "s2.txt", &f));
+    ASSERT_EQ(f.solid, 1);
+    ASSERT_EQ(pas_rar_extract(&f, g_out, sizeof(g_out), &st), 0u);
+    ASSERT(st == PAS_RAR_E_UNSUPPORTED);
+    ASSERT(pas_rar_find_ex(&srar, "s0.txt", &f));
+    ASSERT_EQ(f.solid, 0);
+    ASSERT_EQ(extract_status(&srar, "s0.txt", sizeof(g_out), &st), 30000u);
+    ASSERT(memcmp(g_out, g_s, 30000) == 0);
+    nv = make_volumes(g_srar, len, 1000);
+    ASSERT(pas_rar_open_volumes(&vrar, g_vols, nv, &st));
+    ASSERT_EQ(pas_rar_seq_window_size(&vrar), SIZE_S);
+    vrar.verify = 1;
+    for (i = 0, bad = 0; i < 64; i++) bad += !seq_walk(&vrar, win + pas_rar_ppm_arena_size(1), i);
+    ASSERT_EQ(bad, 0u);
+
+    /* No room for the PPMd model: s1.bin fails, s2.txt has no stream to continue */
+    ASSERT(pas_rar_seq_begin(&seq, &srar, &g_state, g_out + SIZE_S, win + pas_rar_ppm_arena_size(1) - 1, &st));
+    ASSERT(pas_rar_seq_next(&seq, &f, &st));
+    ASSERT_EQ(pas_rar_seq_extract(&seq, g_out, SIZE_S, &st), 30000u);
+    ASSERT(pas_rar_seq_next(&seq, &f, &st));
+    ASSERT_EQ(pas_rar_seq_extract(&seq, g_out, SIZE_S, &st), 0u);
+    ASSERT(st == PAS_RAR_E_NOSPACE);
+    ASSERT(pas_rar_seq_next(&seq, &f, &st));
+    ASSERT_EQ(pas_rar_seq_extract(&seq, g_out, SIZE_S, &st), 0u);
+    ASSERT(st == PAS_RAR_E_INVALID);
+
+    if (g_failed) {
+        (void)fprintf(stderr, "Total: %d assertions, %d failed\n", g_assertions, g_failed);
+        return 1;
+    }
+    (void)printf("All %d assertions passed.\n", g_assertions);
+    return 0;
+}
@@ -0,0 +1,1023 @@
+/*
+    test_unpack5.c - Test RAR5 decompression (pas_rar_extract_ex, pas_rar_extract on compressed entries,
+    pas_rar_seq_* on a solid archive, both cut into volumes).
+    The archives are produced by a small RAR5 encoder below: greedy LZ with repeat distances, every
+    filter type, several blocks (one reusing the previous tables), solid entries continuing the
+    stream of the one before. A splitter re-cuts them into multi-volume sets.
+    From repo root: gcc -o tests/pas_rar/test_unpack5 tests/pas_rar/test_unpack5.c -I.
+*/
+
+#define PAS_RAR_IMPLEMENTATION
+#include "pas_rar.h"
+#include <stdio.h>
+#include <string.h>
+
+static int g_failed, g_assertions;
+
+#define ASSERT(cond) do { \
+    ++g_assertions; \
+    if (!(cond)) { (void)fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); ++g_failed; } \
+} while (0)
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+#define BIG_SIZE   (1u << 20)
+#define BIG_DICT   2           /* 128 KB << 2 = 512 KB */
+#define MAX_TOKENS (1u << 20)
+#define NTABLES    (PAS_RAR5_NC + PAS_RAR5_DC + PAS_RAR5_LDC + PAS_RAR5_RC)
+
+enum { T_LIT, T_MATCH, T_REP, T_LAST, T_FILTER };
+enum { F_DELTA, F_E8, F_E8E9, F_ARM };
+
+typedef struct {
+    uint8_t  kind;
+    uint8_t  type;     /* T_REP: distance index; T_FILTER: filter type */
+    uint8_t  channels;
+    uint32_t len;      /* T_LIT: the byte */
+    uint32_t dist;     /* T_FILTER: block start relative to the token */
+} token_t;
+
+typedef struct {
+    uint32_t start, length;
+    uint8_t  type, channels;
+} region_t;
+
+static uint8_t  g_window_data[BIG_SIZE]; /* what the decoder's window holds (filters not applied) */
+static uint8_t  g_expect[BIG_SIZE];
+static uint8_t  g_rar[3u << 20];
+static uint8_t  g_copy[3u << 20];
+static uint8_t  g_solid[3u << 20];
+static uint8_t  g_vol_data[4u << 20];
+static pas_rar_volume_t g_vols[256];
+static uint8_t  g_small[256];
+static uint8_t  g_out[(2u << 20) + 16];
+static uint8_t  g_window[BIG_SIZE];
+static uint8_t  g_body[2u << 20];
+static token_t  g_tokens[MAX_TOKENS];
+static uint32_t g_head[1 << 16];
+static uint32_t g_prev[BIG_SIZE];
+static pas_rar_unpack_t g_state;
+
+static const region_t k_regions[4] = {
+    { 300000, 50000, F_E8, 0 },
+    { 350000, 50000, F_E8E9, 0 },
+    { 400000, 50000, F_ARM, 0 },
+    { 450000, 50000, F_DELTA, 3 }
+};
+
+/* ----- Helpers: random numbers, CRC32, bit writer ----- */
+
+static uint32_t g_seed = 12345;
+static uint32_t rnd(void) { g_seed = g_seed * 1103515245u + 12345u; return g_seed >> 8; }
+
+static uint32_t crc32_buf(const uint8_t *p, size_t n) {
+    uint32_t c = 0xFFFFFFFFu;
+    size_t i;
+    int k;
+    for (i = 0; i < n; i++) {
+        c ^= p[i];
+        for (k = 0; k < 8; k++) c = (c >> 1) ^ (0xEDB88320u & (0u - (c & 1)));
+    }
+    return c ^ 0xFFFFFFFFu;
+}
+
+typedef struct { uint8_t *buf; size_t bits; } bitw_t;
+
+static void put_bits(bitw_t *w, uint32_t v, unsigned n) {
+    while (n--) {
+        size_t byte = w->bits >> 3;
+        if ((w->bits & 7) == 0) w->buf[byte] = 0;
+        if ((v >> n) & 1) w->buf[byte] |= (uint8_t)(0x80 >> (w->bits & 7));
+        w->bits++;
+    }
+}
+
+/* ----- Huffman code construction ----- */
+
+/* Code lengths <= limit: plain Huffman, flattened by halving the counts until it fits */
+static void huff_lengths(const uint32_t *freq, unsigned n, unsigned limit, uint8_t *lens) {
+    uint32_t f[2 * PAS_RAR5_NC], w[2 * PAS_RAR5_NC];
+    int parent[2 * PAS_RAR5_NC], alive[2 * PAS_RAR5_NC];
+    unsigned i, nodes, used, maxlen;
+
+    memcpy(f, freq, n * sizeof(f[0]));
+    for (;;) {
+        used = 0;
+        for (i = 0; i < n; i++) {
+            w[i] = f[i];
+            alive[i] = f[i] != 0;
+            parent[i] = -1;
+            used += alive[i];
+            lens[i] = 0;
+        }
+        if (used <= 1) {
+            for (i = 0; i < n; i++) if (f[i]) lens[i] = 1;
+            return;
+        }
+        for (nodes = n; used > 1; nodes++, used--) {
+            int a = -1, b = -1;
+            for (i = 0; i < nodes; i++) {
+                if (!alive[i]) continue;
+                if (a < 0 || w[i] < w[a]) { b = a; a = (int)i; }
+                else if (b < 0 || w[i] < w[b]) b = (int)i;
+            }
+            w[nodes] = w[a] + w[b];
+            alive[nodes] = 1;
+            parent[nodes] = -1;
+            alive[a] = alive[b] = 0;
+            parent[a] = parent[b] = (int)nodes;
+        }
+        maxlen = 0;
+        for (i = 0; i < n; i++) {
+            unsigned d = 0;
+            int p;
+            if (!f[i]) continue;
+            for (p = parent[i]; p >= 0; p = parent[p]) d++;
+            lens[i] = (uint8_t)d;
+            if (d > maxlen) maxlen = d;
+        }
+        if (maxlen <= limit) return;
+        for (i = 0; i < n; i++) if (f[i]) f[i] = (f[i] >> 1) | 1;
+    }
+}
+
+static void huff_codes(const uint8_t *lens, unsigned n, uint16_t *codes) {
+    unsigned count[16], next[16], i, code = 0;
+    memset(count, 0, sizeof(count));
+    for (i = 0; i < n; i++) count[lens[i]]++;
+    count[0] = 0;
+    for (i = 1; i < 16; i++) {
+        code = (code + count[i - 1]) << 1;
+        next[i] = code;
+    }
+    for (i = 0; i < n; i++) codes[i] = lens[i] ? (uint16_t)next[lens[i]]++ : 0;
+}
+
+/* ----- Encoder ----- */
+
+typedef struct {
+    uint32_t freq[NTABLES];   /* main, distance, low distance, repeat length counts */
+    uint8_t  lens[NTABLES];
+    uint16_t codes[NTABLES];
+} tables_t;
+
+#define T_MAIN 0
+#define T_DIST PAS_RAR5_NC
+#define T_LOW  (PAS_RAR5_NC + PAS_RAR5_DC)
+#define T_RLEN (PAS_RAR5_NC + PAS_RAR5_DC + PAS_RAR5_LDC)
+
+static void sym(bitw_t *w, tables_t *t, unsigned s) {
+    if (w) put_bits(w, t->codes[s], t->lens[s]);
+    else t->freq[s]++;
+}
+static void raw(bitw_t *w, uint32_t v, unsigned n) { if (w) put_bits(w, v, n); }
+
+static unsigned log2u(uint32_t v) { unsigned n = 0; while (v >>= 1) n++; return n; }
+
+/* Length 2..4097 as slot (added to base) and extra bits */
+static void put_length(bitw_t *w, tables_t *t, unsigned base, uint32_t len) {
+    uint32_t v = len - 2;
+    unsigned bits, slot;
+    if (v < 8) {
+        sym(w, t, base + v);
+        return;
+    }
+    bits = log2u(v) - 2;
+    slot = 4 * (bits + 1) + ((v >> bits) & 3);
+    sym(w, t, base + slot);
+    raw(w, v - ((4u | (slot & 3)) << bits), bits);
+}
+
+static void put_filter_number(bitw_t *w, uint32_t v) {
+    unsigned n = v < 0x100 ? 1 : v < 0x10000 ? 2 : v < 0x1000000 ? 3 : 4, i;
+    raw(w, n - 1, 2);
+    for (i = 0; i < n; i++) raw(w, (v >> (8 * i)) & 0xff, 8);
+}
+
+static void put_token(bitw_t *w, tables_t *t, const token_t *k) {
+    uint32_t d;
+    unsigned bits, slot;
+
+    switch (k->kind) {
+    case T_LIT:
+        sym(w, t, k->len);
+        break;
+    case T_LAST:
+        sym(w, t, 257);
+        break;
+    case T_REP:
+        sym(w, t, 258 + k->type);
+        put_length(w, t, T_RLEN, k->len);
+        break;
+    case T_FILTER:
+        sym(w, t, 256);
+        put_filter_number(w, k->dist);
+        put_filter_number(w, k->len);
+        raw(w, k->type, 3);
+        if (k->type == F_DELTA) raw(w, k->channels - 1u, 5);
+        break;
+    default:
+        d = k->dist;
+        put_length(w, t, 262, k->len - (d > 0x100) - (d > 0x2000) - (d > 0x40000));
+        d -= 1;
+        if (d < 4) {
+            sym(w, t, T_DIST + d);
+            break;
+        }
+        bits = log2u(d) - 1;
+        slot = 2 * (bits + 1) + ((d >> bits) & 1);
+        sym(w, t, T_DIST + slot);
+        d -= (2u | (slot & 1)) << bits;
+        if (bits >= 4) {
+            raw(w, d >> 4, bits - 4);
+            sym(w, t, T_LOW + (d & 15));
+        } else {
+            raw(w, d, bits);
+        }
+        break;
+    }
+}
+
+/* Table lengths: 20 pre-code lengths as nibbles (15 + count escapes 15 and zero runs), then the
+   430 lengths run-length coded through the pre-code */
+static void put_tables(bitw_t *w, const tables_t *t) {
+    uint32_t bfreq[20];
+    uint8_t blens[20], rsym[NTABLES], rext[NTABLES];
+    uint16_t bcodes[20];
+    unsigned i, nr = 0;
+
+    for (i = 0; i < NTABLES; ) {
+        unsigned r = 1;
+        if (t->lens[i] == 0) {
+            while (i + r < NTABLES && t->lens[i + r] == 0 && r < 138) r++;
+            if (r >= 11) { rsym[nr] = 19; rext[nr++] = (uint8_t)(r - 11); i += r; continue; }
+            if (r >= 3) { rsym[nr] = 18; rext[nr++] = (uint8_t)(r - 3); i += r; continue; }
+        } else if (i > 0 && t->lens[i] == t->lens[i - 1]) {
+            while (i + r < NTABLES && t->lens[i + r] == t->lens[i] && r < 138) r++;
+            if (r >= 11) { rsym[nr] = 17; rext[nr++] = (uint8_t)(r - 11); i += r; continue; }
+            if (r >= 3) { rsym[nr] = 16; rext[nr++] = (uint8_t)(r - 3); i += r; continue; }
+        }
+        rsym[nr++] = t->lens[i++];
+    }
+
+    memset(bfreq, 0, sizeof(bfreq));
+    for (i = 0; i < nr; i++) bfreq[rsym[i]]++;
+    huff_lengths(bfreq, 20, 15, blens);
+    huff_codes(blens, 20, bcodes);
+    for (i = 0; i < 20; ) {
+        unsigned r = 1;
+        while (blens[i] == 0 && i + r < 20 && blens[i + r] == 0 && r < 17) r++;
+        if (blens[i] == 0 && r >= 3) {
+            put_bits(w, 15, 4);
+            put_bits(w, r - 2, 4);
+            i += r;
+            continue;
+        }
+        put_bits(w, blens[i], 4);
+        if (blens[i] == 15) put_bits(w, 0, 4);
+        i++;
+    }
+    for (i = 0; i < nr; i++) {
+        put_bits(w, bcodes[rsym[i]], blens[rsym[i]]);
+        if (rsym[i] == 16 || rsym[i] == 18) put_bits(w, rext[i], 3);
+        else if (rsym[i] == 17 || rsym[i] == 19) put_bits(w, rext[i], 7);
+    }
+}
+
+static uint32_t match_len(const uint8_t *d, uint32_t pos, uint32_t dist, uint32_t max) {
+    uint32_t n = 0;
+    while (n < max && d[pos + n] == d[pos + n - dist]) n++;
+    return n;
+}
+
+/* Greedy parse of d[from, size); filter tokens are placed at fixed positions (matches stop
+   there). Past from == 0 the parse goes on from the previous call: matches and repeat
+   distances reach back into the data before from (a solid entry). */
+static size_t tokenize(const uint8_t *d, uint32_t from, uint32_t size, uint32_t max_dist,
+                       const region_t *regions, unsigned nregions) {
+    static uint32_t old[4], last_len;
+    uint32_t pos = from;
+    unsigned next = 0;
+    size_t n = 0;
+
+    if (from == 0) {
+        memset(g_head, 0xff, sizeof(g_head));
+        memset(old, 0, sizeof(old));
+        last_len = 0;
+    }
+    while (pos < size) {
+        /* The filter record for region r goes 100 bytes ahead of it (odd regions) or right at it */
+        uint32_t emit = next < nregions ? regions[next].start - (next & 1 ? 100 : 0) : size;
+        uint32_t max = size - pos, best = 0, best_dist = 0, len, i;
+        int rep = -1;
+        token_t *k = &g_tokens[n++];
+
+        if (pos >= emit) {
+            k->kind = T_FILTER;
+            k->dist = regions[next].start - pos;
+            k->len = regions[next].length;
+            k->type = regions[next].type;
+            k->channels = regions[next].channels;
+            next++;
+            continue;
+        }
+        if (max > emit - pos) max = emit - pos;
+
+        if (last_len && old[0] && old[0] <= pos && last_len <= max &&
+            match_len(d, pos, old[0], last_len) == last_len) {
+            k->kind = T_LAST;
+            pos += last_len;
+            continue;
+        }
+        for (i = 0; i < 4; i++) {
+            if (!old[i] || old[i] > pos) continue;
+            len = match_len(d, pos, old[i], max < 4097 ? max : 4097);
+            if (len >= 2 && len > best) { best = len; rep = (int)i; }
+        }
+        if (pos + 3 <= size) {
+            uint32_t h = ((uint32_t)d[pos] << 8 ^ (uint32_t)d[pos + 1] << 4 ^ d[pos + 2]) & 0xffff;
+            uint32_t cand = g_head[h], chain = 32, best_m = 0, dist_m = 0;
+            while (cand != 0xffffffffu && chain--) {
+                uint32_t dist = pos - cand, bonus = (dist > 0x100) + (dist > 0x2000) + (dist > 0x40000);
+                if (dist > max_dist) break;
+                len = match_len(d, pos, dist, max < 4097 + bonus ? max : 4097 + bonus);
+                if (len >= 3 + bonus && len > best_m) { best_m = len; dist_m = dist; }
+                cand = g_prev[cand];
+            }
+            if (best_m > best + 1) { best = best_m; best_dist = dist_m; rep = -1; }
+        }
+
+        if (best == 0) {
+            k->kind = T_LIT;
+            k->len = d[pos];
+            best = 1;
+        } else if (rep >= 0) {
+            uint32_t dist = old[rep];
+            k->kind = T_REP;
+            k->type = (uint8_t)rep;
+            k->len = best;
+            for (i = (uint32_t)rep; i > 0; i--) old[i] = old[i - 1];
+            old[0] = dist;
+            last_len = best;
+        } else {
+            k->kind = T_MATCH;
+            k->len = best;
+            k->dist = best_dist;
+            memmove(old + 1, old, 3 * sizeof(old[0]));
+            old[0] = best_dist;
+            last_len = best;
+        }
+        for (i = 0; i < best; i++, pos++) {
+            if (pos + 3 <= size) {
+                uint32_t h = ((uint32_t)d[pos] << 8 ^ (uint32_t)d[pos + 1] << 4 ^ d[pos + 2]) & 0xffff;
+                g_prev[pos] = g_head[h];
+                g_head[h] = pos;
+            }
+        }
+    }
+    return n;
+}
+
+#define C5_REUSE 1   /* the first block reuses the tables of the previous call */
+#define C5_SHARE 2   /* the last tables code every symbol, so a C5_REUSE call can follow */
+
+/* Compressed stream of d[from, size): blocks of block_tokens tokens; every third block reuses the
+   tables before it */
+static size_t compress5(const uint8_t *d, uint32_t from, uint32_t size, uint32_t max_dist,
+                        const region_t *regions, unsigned nregions, size_t block_tokens, unsigned opts,
+                        uint8_t *out) {
+    static tables_t t;
+    size_t ntok = tokenize(d, from, size, max_dist, regions, nregions), b, len = 0, i;
+    unsigned blk = opts & C5_REUSE ? 2 : 0;
+
+    for (b = 0; b < ntok; b += block_tokens, blk++) {
+        size_t end = b + block_tokens < ntok ? b + block_tokens : ntok, body, count;
+        int table = blk % 3 != 2;
+        unsigned flags;
+        bitw_t w;
+
+        if (table) {
+            /* Counts over this block and the table-less one after it */
+            size_t group = b + (blk % 3 == 1 ? 2 : 1) * block_tokens;
+            if (group > ntok) group = ntok;
+            memset(t.freq, 0, sizeof(t.freq));
+            for (i = b; i < group; i++) put_token(NULL, &t, &g_tokens[i]);
+            if ((opts & C5_SHARE) && group == ntok)
+                for (i = 0; i < NTABLES; i++) t.freq[i] |= !t.freq[i];
+            huff_lengths(t.freq, PAS_RAR5_NC, 15, t.lens);
+            huff_lengths(t.freq + T_DIST, PAS_RAR5_DC, 15, t.lens + T_DIST);
+            huff_lengths(t.freq + T_LOW, PAS_RAR5_LDC, 15, t.lens + T_LOW);
+            huff_lengths(t.freq + T_RLEN, PAS_RAR5_RC, 15, t.lens + T_RLEN);
+            huff_codes(t.lens, PAS_RAR5_NC, t.codes);
+            huff_codes(t.lens + T_DIST, PAS_RAR5_DC, t.codes + T_DIST);
+            huff_codes(t.lens + T_LOW, PAS_RAR5_LDC, t.codes + T_LOW);
+            huff_codes(t.lens + T_RLEN, PAS_RAR5_RC, t.codes + T_RLEN);
+        }
+        w.buf = g_body;
+        w.bits = 0;
+        if (table) put_tables(&w, &t);
+        for (i = b; i < end; i++) put_token(&w, &t, &g_tokens[i]);
+
+        body = (w.bits + 7) / 8;
+        count = body < 0x100 ? 1 : body < 0x10000 ? 2 : 3;
+        flags = (unsigned)((count - 1) << 3) | (unsigned)((w.bits - 1) & 7) | (table ? 0x80u : 0u) |
+                (end == ntok ? 0x40u : 0u);
+        out[len] = (uint8_t)flags;
+        out[len + 1] = (uint8_t)(0x5a ^ flags ^ body ^ (body >> 8) ^ (body >> 16));
+        for (i = 0; i < count; i++) out[len + 2 + i] = (uint8_t)(body >> (8 * i));
+        len += 2 + count;
+        memcpy(out + len, g_body, body);
+        len += body;
+    }
+    return len;
+}
+
+/* ----- Archive ----- */
+
+static size_t put_vint(uint8_t *p, uint64_t v) {
+    size_t n = 0;
+    do {
+        p[n++] = (uint8_t)((v & 0x7f) | (v > 0x7f ? 0x80 : 0));
+        v >>= 7;
+    } while (v);
+    return n;
+}
+
+/* Header: CRC32, size, then fields; the CRC covers size and fields */
+static size_t put_header(uint8_t *out, const uint8_t *fields, size_t n) {
+    size_t len = 4 + put_vint(out + 4, n);
+    uint32_t crc;
+    memcpy(out + len, fields, n);
+    len += n;
+    crc = crc32_buf(out + 4, len - 4);
+    out[0] = (uint8_t)crc;
+    out[1] = (uint8_t)(crc >> 8);
+    out[2] = (uint8_t)(crc >> 16);
+    out[3] = (uint8_t)(crc >> 24);
+    return len;
+}
+
+/* File header + data. dict < 0: stored */
+static size_t add_file(uint8_t *out, const char *name, const uint8_t *data, size_t size,
+                       const uint8_t *packed, size_t packed_size, int dict, int solid) {
+    uint8_t f[64];
+    size_t n = 0, nl = strlen(name), len;
+    uint32_t crc = crc32_buf(data, size);
+
+    n += put_vint(f + n, 2);                  /* file header */
+    n += put_vint(f + n, 0x02);               /* data area present */
+    n += put_vint(f + n, packed_size);
+    n += put_vint(f + n, 0x04);               /* CRC32 present */
+    n += put_vint(f + n, size);
+    n += put_vint(f + n, 0x20);               /* attributes */
+    f[n++] = (uint8_t)crc;
+    f[n++] = (uint8_t)(crc >> 8);
+    f[n++] = (uint8_t)(crc >> 16);
+    f[n++] = (uint8_t)(crc >> 24);
+    n += put_vint(f + n, (dict < 0 ? 0 : (uint64_t)(3u << 7) | ((uint64_t)dict << 10)) |
+                         (solid ? 0x40u : 0u));                      /* method 3 */
+    n += put_vint(f + n, 0);                  /* host OS: Windows */
+    n += put_vint(f + n, nl);
+    memcpy(f + n, name, nl);
+    n += nl;
+    len = put_header(out, f, n);
+    memcpy(out + len, packed, packed_size);
+    return len + packed_size;
+}
+
+/* ----- Test data ----- */
+
+static void make_data(void) {
+    static const char *words[] = { "the ", "archive ", "window ", "filter ", "block ", "of ",
+                                   "Huffman ", "RAR5 ", "decoder ", "table\n", "and ", "a " };
+    uint32_t i = 0, j, r;
+
+    while (i < 200000) {
+        const char *s = words[rnd() % 12];
+        while (*s && i < 200000) g_window_data[i++] = (uint8_t)*s++;
+    }
+    for (; i < 260000; i++) g_window_data[i] = (uint8_t)rnd();
+    for (; i < 280000; i++) g_window_data[i] = 'A';
+    for (; i < 300000; i++) g_window_data[i] = (uint8_t)("0123456789"[i % 10]);
+    /* x86-like code: call / jmp opcodes followed by 32-bit operands */
+    for (; i < 400000; i++) {
+        r = rnd() % 16;
+        g_window_data[i] = (uint8_t)(r == 0 ? 0xe8 : r == 1 ? 0xe9 : rnd() % 64);
+    }
+    /* ARM: words with the BL "always" top byte */
+    for (; i < 450000; i += 4) {
+        r = rnd();
+        g_window_data[i] = (uint8_t)r;
+        g_window_data[i + 1] = (uint8_t)(r >> 8);
+        g_window_data[i + 2] = (uint8_t)(r % 3);
+        g_window_data[i + 3] = (uint8_t)(r % 2 ? 0xeb : 0xe1);
+    }
+    /* Delta: three channels of slowly changing samples, stored as differences */
+    for (; i < 500000; i++) g_window_data[i] = (uint8_t)(rnd() % 3);
+    /* Copies from up to 480 KB back (all three length bonuses), mutated, then more text */
+    for (; i < 800000; ) {
+        uint32_t dist = 0x100 + rnd() % 480000, n = 100 + rnd() % 6000;
+        if (dist > i) dist = i;
+        for (j = 0; j < n && i < 800000; j++, i++) g_window_data[i] = g_window_data[i - dist];
+        if (i < 800000) g_window_data[i++] = (uint8_t)rnd();
+    }
+    while (i < BIG_SIZE) {
+        const char *s = words[rnd() % 12];
+        while (*s && i < BIG_SIZE) g_window_data[i++] = (uint8_t)*s++;
+    }
+}
+
+/* Reference filters (what the decoder applies to each block of its output) */
+static void apply_regions(uint8_t *out, const uint8_t *win, const region_t *regions, unsigned n) {
+    unsigned r;
+    for (r = 0; r < n; r++) {
+        const region_t *g = &regions[r];
+        uint8_t *d = out + g->start;
+        uint32_t i, c, src = g->start;
+        if (g->type == F_DELTA) {
+            for (c = 0; c < g->channels; c++) {
+                uint8_t prev = 0;
+                for (i = c; i < g->length; i += g->channels) d[i] = prev = (uint8_t)(prev - win[src++]);
+            }
+        } else if (g->type == F_ARM) {
+            for (i = 0; i + 3 < g->length; i += 4) {
+                if (d[i + 3] == 0xeb) {
+                    uint32_t off = (d[i] | (uint32_t)d[i + 1] << 8 | (uint32_t)d[i + 2] << 16) - (g->start + i) / 4;
+                    d[i] = (uint8_t)off;
+                    d[i + 1] = (uint8_t)(off >> 8);
+                    d[i + 2] = (uint8_t)(off >> 16);
+                }
+            }
+        } else {
+            for (i = 0; i + 4 < g->length; ) {
+                uint8_t b = d[i++];
+                if (b == 0xe8 || (g->type == F_E8E9 && b == 0xe9)) {
+                    uint32_t offset = (g->start + i) % 0x1000000, v;
+                    uint32_t addr = d[i] | (uint32_t)d[i + 1] << 8 | (uint32_t)d[i + 2] << 16 | (uint32_t)d[i + 3] << 24;
+                    if (addr & 0x80000000u) v = ((addr + offset) & 0x80000000u) ? addr : addr + 0x1000000;
+                    else v = ((addr - 0x1000000) & 0x80000000u) ? addr - offset : addr;
+                    d[i] = (uint8_t)v;
+                    d[i + 1] = (uint8_t)(v >> 8);
+                    d[i + 2] = (uint8_t)(v >> 16);
+                    d[i + 3] = (uint8_t)(v >> 24);
+                    i += 4;
+                }
+            }
+        }
+    }
+}
+
+static const char k_hello[] = "Hello, hello, hello RAR5 world! Hello again, RAR5 world!\n";
+
+/* big.bin (512 KB dictionary, filters, many blocks), hello.txt (one block), note.txt (stored) */
+static size_t make_archive(uint8_t *packed, size_t *packed_big) {
+    static const uint8_t sig[8] = { 'R','a','r','!',0x1A,0x07,0x01,0x00 };
+    static const uint8_t main_hdr[3] = { 1, 0, 0 }, end_hdr[3] = { 5, 0, 0 };
+    size_t len = 0, n;
+
+    make_data();
+    memcpy(g_expect, g_window_data, BIG_SIZE);
+    apply_regions(g_expect, g_window_data, k_regions, 4);
+
+    memcpy(g_rar, sig, 8);
+    len = 8 + put_header(g_rar + 8, main_hdr, 3);
+    n = compress5(g_window_data, 0, BIG_SIZE, 0x20000u << BIG_DICT, k_regions, 4, 30000, 0, packed);
+    *packed_big = n;
+    len += add_file(g_rar + len, "big.bin", g_expect, BIG_SIZE, packed, n, BIG_DICT, 0);
+    n = compress5((const uint8_t *)k_hello, 0, sizeof(k_hello) - 1, 0x20000, NULL, 0, 100000, 0, packed);
+    len += add_file(g_rar + len, "hello.txt", (const uint8_t *)k_hello, sizeof(k_hello) - 1, packed, n, 0, 0);
+    len += add_file(g_rar + len, "note.txt", (const uint8_t *)"stored", 6, (const uint8_t *)"stored", 6, -1, 0);
+    len += put_header(g_rar + len, end_hdr, 3);
+    return len;
+}
+
+/* Solid archive over the same data, unfiltered: a.txt starts the run, b.bin and a stored note.txt
+   follow, c.bin and d.txt begin on the tables of the entry before them. e.txt starts a second run
+   that f.txt (the same text again) continues. */
+static const uint32_t k_solid_ends[4] = { 200000, 300000, 800000, BIG_SIZE };
+
+static size_t make_solid(uint8_t *packed) {
+    static const uint8_t sig[8] = { 'R','a','r','!',0x1A,0x07,0x01,0x00 };
+    static const uint8_t main_hdr[3] = { 1, 0, 0x04 }, end_hdr[3] = { 5, 0, 0 };  /* solid */
+    static const char *names[4] = { "a.txt", "b.bin", "c.bin", "d.txt" };
+    static const unsigned opts[4] = { 0, C5_SHARE, C5_REUSE | C5_SHARE, C5_REUSE };
+    size_t len, n, h = sizeof(k_hello) - 1;
+    uint32_t from = 0;
+    unsigned i;
+
+    memcpy(g_solid, sig, 8);
+    len = 8 + put_header(g_solid + 8, main_hdr, 3);
+    for (i = 0; i < 4; i++) {
+        n = compress5(g_window_data, from, k_solid_ends[i], 0x20000u << BIG_DICT, NULL, 0, 30000, opts[i], packed);
+        len += add_file(g_solid + len, names[i], g_window_data + from, k_solid_ends[i] - from, packed, n,
+                        BIG_DICT, i > 0);
+        if (i == 1)
+            len += add_file(g_solid + len, "note.txt", (const uint8_t *)"stored", 6, (const uint8_t *)"stored", 6, -1, 1);
+        from = k_solid_ends[i];
+    }
+    memcpy(g_small, k_hello, h);
+    memcpy(g_small + h, k_hello, h);
+    n = compress5(g_small, 0, (uint32_t)h, 0x20000, NULL, 0, 100000, 0, packed);
+    len += add_file(g_solid + len, "e.txt", g_small, h, packed, n, 0, 0);
+    n = compress5(g_small, (uint32_t)h, (uint32_t)(2 * h), 0x20000, NULL, 0, 100000, 0, packed);
+    len += add_file(g_solid + len, "f.txt", g_small + h, h, packed, n, 0, 1);
+    len += put_header(g_solid + len, end_hdr, 3);
+    return len;
+}
+
+/* ----- Volumes ----- */
+
+static uint64_t get_vint(const uint8_t **p) {
+    uint64_t v = 0;
+    unsigned shift = 0;
+    while (**p & 0x80) {
+        v |= (uint64_t)(*(*p)++ & 0x7f) << shift;
+        shift += 7;
+    }
+    return v | (uint64_t)*(*p)++ << shift;
+}
+
+/* Signature and main header of volume n: arc_flags plus 0x0001 (volume) and, after the first,
+   0x0002 with the volume number */
+static uint8_t *start_volume(uint8_t *out, size_t n, uint64_t arc_flags) {
+    static const uint8_t sig[8] = { 'R','a','r','!',0x1A,0x07,0x01,0x00 };
+    uint8_t f[16];
+    size_t k = 0;
+    g_vols[n].data = out;
+    memcpy(out, sig, 8);
+    k += put_vint(f + k, 1);
+    k += put_vint(f + k, 0);
+    k += put_vint(f + k, arc_flags | 0x0001 | (n ? 0x0002 : 0));
+    if (n) k += put_vint(f + k, n);
+    return out + 8 + put_header(out + 8, f, k);
+}
+
+/* End of archive (0x0001: more volumes follow) closing volume n */
+static uint8_t *end_volume(uint8_t *out, size_t n, unsigned more) {
+    const uint8_t f[3] = { 5, 0, (uint8_t)more };
+    out += put_header(out, f, 3);
+    g_vols[n].size = (size_t)(out - (const uint8_t *)g_vols[n].data);
+    return out;
+}
+
+/* Cut archive src into volumes holding at most chunk bytes of file data each, the way RAR splits
+   them: file data crossing a cut goes on in the next volume under a copy of the file header with
+   the split flags (0x0008 continued from the previous volume, 0x0010 continued in the next); a
+   part followed by another carries the CRC32 of its own packed bytes. Returns the volume count. */
+static size_t make_volumes(const uint8_t *src, size_t chunk) {
+    const uint8_t *p = src + 8, *q;
+    uint8_t *out = g_vol_data;
+    uint64_t arc_flags, size;
+    size_t n = 0, room = chunk;
+
+    q = p + 4;
+    size = get_vint(&q);                  /* main header: skip to the next block */
+    q += size;
+    p += 4;
+    (void)get_vint(&p);
+    (void)get_vint(&p);                   /* type */
+    (void)get_vint(&p);                   /* flags */
+    arc_flags = get_vint(&p);
+    p = q;
+    out = start_volume(out, n, arc_flags);
+
+    for (;;) {
+        const uint8_t *fields = p + 4, *rest, *data, *end;
+        uint64_t type, flags, extra = 0, dsize = 0, done = 0;
+
+        size = get_vint(&fields);
+        end = fields + size;
+
+        q = fields;
+        type = get_vint(&q);
+        flags = get_vint(&q);
+        if (flags & 0x0001) extra = get_vint(&q);
+        if (flags & 0x0002) dsize = get_vint(&q);
+        if (type == 5) break;
+        rest = q;
+        data = end;
+        if (type != 2) {
+            memcpy(out, p, (size_t)(end + dsize - p));
+            out += end + dsize - p;
+            p = end + dsize;
+            continue;
+        }
+        do {
+            uint8_t f[256];
+            size_t k = 0, take;
+            const uint8_t *r = rest;
+            uint64_t ff;
+            unsigned split;
+
+            if (!room) {
+                out = end_volume(out, n++, 1);
+                out = start_volume(out, n, arc_flags);
+                room = chunk;
+            }
+            take = (size_t)(dsize - done) < room ? (size_t)(dsize - done) : room;
+            split = (done ? 0x0008u : 0u) | (done + take < dsize ? 0x0010u : 0u);
+            k += put_vint(f + k, type);
+            k += put_vint(f + k, flags | split);
+            if (flags & 0x0001) k += put_vint(f + k, extra);
+            k += put_vint(f + k, take);
+            memcpy(f + k, rest, (size_t)(end - rest));
+            /* File flags, unpacked size, attributes, then mtime and CRC32 when flagged */
+            ff = get_vint(&r);
+            (void)get_vint(&r);
+            (void)get_vint(&r);
+            if (ff & 0x0002) r += 4;
+            if ((ff & 0x0004) && (split & 0x0010)) {
+                uint32_t crc = crc32_buf(data + done, take);
+                uint8_t *c = f + k + (r - rest);
+                c[0] = (uint8_t)crc;
+                c[1] = (uint8_t)(crc >> 8);
+                c[2] = (uint8_t)(crc >> 16);
+                c[3] = (uint8_t)(crc >> 24);
+            }
+            k += (size_t)(end - rest);
+            out += put_header(out, f, k);
+            memcpy(out, data + done, take);
+            out += take;
+            done += take;
+            room -= take;
+        } while (done < dsize);
+        p = end + dsize;
+    }
+    (void)end_volume(out, n, 0);
+    return n + 1;
+}
+
+/* ----- Tests ----- */
+
+static int big_ok(size_t n, pas_rar_status st) {
+    return st == PAS_RAR_OK && n == BIG_SIZE && memcmp(g_out, g_expect, BIG_SIZE) == 0;
+}
+
+/* Next entry of a solid walk is name; extract it (want) or skip it, and check the bytes */
+static int seq_step(pas_rar_seq_t *seq, const char *name, const uint8_t *expect, size_t size, int want) {
+    pas_rar_file_t f;
+    pas_rar_status st;
+    size_t len, n;
+    const char *s;
+
+    if (!pas_rar_seq_next(seq, &f, &st) || st != PAS_RAR_OK) return 0;
+    s = pas_rar_name_span(&f, &len);
+    if (len != strlen(name) || memcmp(s, name, len) != 0) return 0;
+    if (!want) return 1;
+    n = pas_rar_seq_extract(seq, g_out, sizeof(g_out), &st);
+    return st == PAS_RAR_OK && n == size && memcmp(g_out, expect, size) == 0;
+}
+
+/* Walk the solid archive, extracting the entries set in mask (bit i: entry i) */
+static int seq_walk(const pas_rar_t *rar, size_t window_size, unsigned mask) {
+    const uint8_t *d = g_window_data;
+    pas_rar_seq_t seq;
+    pas_rar_status st;
+    size_t h = sizeof(k_hello) - 1;
+    int ok;
+
+    if (!pas_rar_seq_begin(&seq, rar, &g_state, g_window, window_size, &st)) return 0;
+    ok = seq_step(&seq, "a.txt", d, 200000, mask & 1) &&
+         seq_step(&seq, "b.bin", d + 200000, 100000, mask & 2) &&
+         seq_step(&seq, "note.txt", (const uint8_t *)"stored", 6, mask & 4) &&
+         seq_step(&seq, "c.bin", d + 300000, 500000, mask & 8) &&
+         seq_step(&seq, "d.txt", d + 800000, BIG_SIZE - 800000, mask & 16) &&
+         seq_step(&seq, "e.txt", g_small, h, mask & 32) &&
+         seq_step(&seq, "f.txt", g_small + h, h, mask & 64);
+    return ok && pas_rar_seq_next(&seq, NULL, &st) == 0 && st == PAS_RAR_OK;
+}
+
+int main(void) {
+    pas_rar_status status;
+    pas_rar_t rar, bad, srar, vrar;
+    pas_rar_file_t big, hello, note, f;
+    pas_rar_seq_t seq;
+    pas_rar_index_slot_t slots[16];
+    size_t len, rar_len, packed_big, n, nv;
+
+    g_failed = 0;
+    g_assertions = 0;
+
+    len = rar_len = make_archive(g_copy, &packed_big);
+    ASSERT(packed_big < BIG_SIZE / 2);
+    ASSERT(pas_rar_open_ex(&rar, g_rar, len, &status));
+    ASSERT(pas_rar_find_ex(&rar, "big.bin", &big));
+    ASSERT(pas_rar_find_ex(&rar, "hello.txt", &hello));
+    ASSERT(pas_rar_find_ex(&rar, "note.txt", &note));
+
+    ASSERT(pas_rar_is_compressed(&big));
+    ASSERT_EQ(big.method, 0x33);
+    ASSERT_EQ(big.dict_size, (uint64_t)0x80000);
+    ASSERT_EQ(big.unpack_version, 50);
+    ASSERT_EQ(big.solid, 0);
+    ASSERT_EQ(pas_rar_packed_size(&big), (uint64_t)packed_big);
+    ASSERT_EQ(pas_rar_window_size(&big), (size_t)BIG_SIZE);   /* under 8 MB: the whole file */
+    ASSERT_EQ(pas_rar_window_size(&hello), sizeof(k_hello) - 1);
+    ASSERT_EQ(pas_rar_window_size(&note), 0u);
+
+    /* Window of exactly the dictionary size: wraps twice */
+    n = pas_rar_extract_ex(&big, g_out, BIG_SIZE, &g_state, g_window, 0x80000, &status);
+    ASSERT(big_ok(n, status));
+    /* Window covering the whole file */
+    memset(g_out, 0, BIG_SIZE);
+    n = pas_rar_extract_ex(&big, g_out, BIG_SIZE, &g_state, g_window, BIG_SIZE, &status);
+    ASSERT(big_ok(n, status));
+
+    /* pas_rar_extract: the window lives behind the data */
+    memset(g_out, 0, BIG_SIZE);
+    n = pas_rar_extract(&big, g_out, 2 * BIG_SIZE, &status);
+    ASSERT(big_ok(n, status));
+    ASSERT_EQ(pas_rar_extract(&big, g_out, 2 * BIG_SIZE - 1, &status), 0u);
+    ASSERT_EQ(status, PAS_RAR_E_NOSPACE);
+    n = pas_rar_extract(&hello, g_out, 2 * (sizeof(k_hello) - 1), &status);
+    ASSERT_EQ(status, PAS_RAR_OK);
+    ASSERT(n == sizeof(k_hello) - 1 && memcmp(g_out, k_hello, n) == 0);
+    n = pas_rar_extract_ex(&note, g_out, 6, NULL, NULL, 0, &status);
+    ASSERT(status == PAS_RAR_OK && n == 6 && memcmp(g_out, "stored", 6) == 0);
+
+    /* Too small */
+    ASSERT_EQ(pas_rar_extract_ex(&big, g_out, BIG_SIZE - 1, &g_state, g_window, BIG_SIZE, &status), 0u);
+    ASSERT_EQ(status, PAS_RAR_E_NOSPACE);
+    ASSERT_EQ(pas_rar_extract_ex(&big, g_out, BIG_SIZE, &g_state, g_window, 0x80000 - 1, &status), 0u);
+    ASSERT_EQ(status, PAS_RAR_E_NOSPACE);
+
+    /* Solid and RAR 7 entries are not decoded */
+    f = big;
+    f.solid = 1;
+    ASSERT_EQ(pas_rar_extract_ex(&f, g_out, BIG_SIZE, &g_state, g_window, BIG_SIZE, &status), 0u);
+    ASSERT_EQ(status, PAS_RAR_E_UNSUPPORTED);
+    f = big;
+    f.unpack_version = 70;
+    ASSERT_EQ(pas_rar_extract_ex(&f, g_out, BIG_SIZE, &g_state, g_window, BIG_SIZE, &status), 0u);
+    ASSERT_EQ(status, PAS_RAR_E_UNSUPPORTED);
+
+    /* Corrupt data: block checksum, truncated stream, entry longer than the stream */
+    memcpy(g_copy, g_rar, len);
+    g_copy[big.data_offset + 1] ^= 0x40;
+    ASSERT(pas_rar_open_ex(&bad, g_copy, len, &status));
+    ASSERT(pas_rar_find_ex(&bad, "big.bin", &f));
+    ASSERT_EQ(pas_rar_extract_ex(&f, g_out, BIG_SIZE, &g_state, g_window, BIG_SIZE, &status), 0u);
+    ASSERT_EQ(status, PAS_RAR_E_INVALID);
+    f = big;
+    f.packed_size -= 100;
+    f.part_size -= 100;
+    ASSERT_EQ(pas_rar_extract_ex(&f, g_out, BIG_SIZE, &g_state, g_window, BIG_SIZE, &status), 0u);
+    ASSERT_EQ(status, PAS_RAR_E_INVALID);
+    f = hello;
+    f.unpacked_size += 1;
+    ASSERT_EQ(pas_rar_extract_ex(&f, g_out, sizeof(g_out), &g_state, g_window, BIG_SIZE, &status), 0u);
+    ASSERT_EQ(status, PAS_RAR_E_INVALID);
+
+    /* rar->verify: the data CRC32 of the decoded bytes */
+    ASSERT_EQ(big.checks, PAS_RAR_CHECK_CRC32);
+    ASSERT_EQ(big.crc32, crc32_buf(g_expect, BIG_SIZE));
+    rar.verify = 1;
+    n = pas_rar_extract_ex(&big, g_out, BIG_SIZE, &g_state, g_window, BIG_SIZE, &status);
+    ASSERT(big_ok(n, status));
+    f = big;
+    f.crc32 ^= 1;
+    ASSERT_EQ(pas_rar_extract_ex(&f, g_out, BIG_SIZE, &g_state, g_window, BIG_SIZE, &status), 0u);
+    ASSERT_EQ(status, PAS_RAR_E_CRC);
+    rar.verify = 0;
+    n = pas_rar_extract_ex(&f, g_out, BIG_SIZE, &g_state, g_window, BIG_SIZE, &status);
+    ASSERT(big_ok(n, status));
+
+    /* Volumes of 200000 data bytes: big.bin is split, hello.txt and note.txt sit in the last one */
+    nv = make_volumes(g_rar, 200000);
+    ASSERT(nv >= 2);
+    ASSERT(pas_rar_open_volumes(&vrar, g_vols, nv, &status));
+    ASSERT(pas_rar_find_ex(&vrar, "big.bin", &f));
+    ASSERT_EQ(f.volume, 0u);
+    ASSERT_EQ(f.split, PAS_RAR_SPLIT_AFTER);
+    ASSERT_EQ(f.part_size, 200000u);
+    ASSERT_EQ(f.packed_size, (uint64_t)packed_big);
+    ASSERT_EQ(f.crc32, big.crc32);            /* from the last part's header */
+    memset(g_out, 0, BIG_SIZE);
+    vrar.verify = 1;
+    n = pas_rar_extract_ex(&f, g_out, BIG_SIZE, &g_state, g_window, 0x80000, &status);
+    ASSERT(big_ok(n, status));
+    ASSERT_EQ(pas_rar_index_capacity(&vrar), 16u);
+    ASSERT(pas_rar_index_build(&vrar, slots, 16, &status));
+    ASSERT(pas_rar_find_ex(&vrar, "hello.txt", &f));
+    ASSERT_EQ(f.volume, (uint32_t)(nv - 1));
+    n = pas_rar_extract(&f, g_out, sizeof(g_out), &status);
+    ASSERT(status == PAS_RAR_OK && n == sizeof(k_hello) - 1 && memcmp(g_out, k_hello, n) == 0);
+    ASSERT(pas_rar_find_ex(&vrar, "note.txt", &f));
+    n = pas_rar_extract(&f, g_out, 6, &status);
+    ASSERT(status == PAS_RAR_OK && n == 6 && memcmp(g_out, "stored", 6) == 0);
+    ASSERT(pas_rar_seq_begin(&seq, &vrar, &g_state, g_window, 0x80000, &status));
+    ASSERT(seq_step(&seq, "big.bin", NULL, 0, 0));
+    ASSERT(seq_step(&seq, "hello.txt", (const uint8_t *)k_hello, sizeof(k_hello) - 1, 1));
+    ASSERT(seq_step(&seq, "note.txt", (const uint8_t *)"stored", 6, 1));
+    ASSERT_EQ(pas_rar_seq_next(&seq, &f, &status), 0);
+    ASSERT_EQ(status, PAS_RAR_OK);
+
+    /* 4-byte parts: block headers and bit reads cross several volumes */
+    memcpy(g_copy, g_rar, 16);            /* signature, main header */
+    len = 16;
+    n = compress5((const uint8_t *)k_hello, 0, sizeof(k_hello) - 1, 0x20000, NULL, 0, 100000, 0, g_out);
+    len += add_file(g_copy + len, "hello.txt", (const uint8_t *)k_hello, sizeof(k_hello) - 1, g_out, n, 0, 0);
+    len += add_file(g_copy + len, "note.txt", (const uint8_t *)"stored", 6, (const uint8_t *)"stored", 6, -1, 0);
+    memcpy(g_copy + len, g_rar + rar_len - 8, 8);
+    nv = make_volumes(g_copy, 4);
+    ASSERT_EQ(nv, (n + 6 + 3) / 4);
+    ASSERT(pas_rar_open_volumes(&vrar, g_vols, nv, &status));
+    ASSERT(pas_rar_find_ex(&vrar, "hello.txt", &f));
+    ASSERT_EQ(f.packed_size, (uint64_t)n);
+    n = pas_rar_extract(&f, g_out, sizeof(g_out), &status);
+    ASSERT(status == PAS_RAR_OK && n == sizeof(k_hello) - 1 && memcmp(g_out, k_hello, n) == 0);
+    ASSERT(pas_rar_find_ex(&vrar, "note.txt", &f));
+    ASSERT(f.split == PAS_RAR_SPLIT_AFTER && f.volume > 0);
+    n = pas_rar_extract(&f, g_out, 6, &status);
+    ASSERT(status == PAS_RAR_OK && n == 6 && memcmp(g_out, "stored", 6) == 0);
+
+    /* Last volume missing: note.txt is short of data */
+    ASSERT(pas_rar_open_volumes(&vrar, g_vols, nv - 1, &status));
+    ASSERT(pas_rar_find_ex(&vrar, "note.txt", &f));
+    ASSERT(f.packed_size < 6);
+    ASSERT_EQ(pas_rar_extract(&f, g_out, 6, &status), 0u);
+    ASSERT_EQ(status, PAS_RAR_E_INVALID);
+    /* One volume on its own: split entries list but do not extract, continued parts do not list */
+    ASSERT(pas_rar_open_ex(&vrar, g_vols[0].data, g_vols[0].size, &status));
+    ASSERT(pas_rar_find_ex(&vrar, "hello.txt", &f));
+    ASSERT_EQ(f.part_size, 4u);
+    ASSERT_EQ(pas_rar_extract(&f, g_out, sizeof(g_out), &status), 0u);
+    ASSERT_EQ(status, PAS_RAR_E_INVALID);
+    ASSERT(pas_rar_open_ex(&vrar, g_vols[1].data, g_vols[1].size, &status));
+    ASSERT_EQ(pas_rar_find_ex(&vrar, "hello.txt", &f), 0);
+    /* Every volume must be an archive of the same format */
+    g_vols[1].data = "Rar!";
+    ASSERT_EQ(pas_rar_open_volumes(&vrar, g_vols, nv, &status), 0);
+    ASSERT_EQ(status, PAS_RAR_E_INVALID);
+
+    /* Solid archive: the pas_rar_seq_* walk decodes it whichever entries are extracted */
+    len = make_solid(g_copy);
+    ASSERT(pas_rar_open_ex(&srar, g_solid, len, &status));
+    ASSERT_EQ(pas_rar_seq_window_size(&srar), (size_t)BIG_SIZE);
+    ASSERT(seq_walk(&srar, BIG_SIZE, 0x7f));
+    ASSERT(seq_walk(&srar, 0x80000, 0x7f));      /* the dictionary: wraps */
+    ASSERT(seq_walk(&srar, BIG_SIZE, 0x50));     /* d.txt and f.txt only */
+    ASSERT(seq_walk(&srar, BIG_SIZE, 0x08));
+    ASSERT(seq_walk(&srar, BIG_SIZE, 0));
+    nv = make_volumes(g_solid, 30000);
+    ASSERT(nv >= 4);
+    ASSERT(pas_rar_open_volumes(&vrar, g_vols, nv, &status));
+    ASSERT(seq_walk(&vrar, 0x80000, 0x7f));
+    vrar.verify = 1;
+    ASSERT(seq_walk(&vrar, 0x80000, 0x7f));
+    ASSERT(seq_walk(&vrar, BIG_SIZE, 0x50));
+    ASSERT(pas_rar_find_ex(&srar, "c.bin", &f));
+    ASSERT_EQ(f.solid, 1);
+    ASSERT_EQ(pas_rar_extract_ex(&f, g_out, BIG_SIZE, &g_state, g_window, BIG_SIZE, &status), 0u);
+    ASSERT_EQ(status, PAS_RAR_E_UNSUPPORTED);
+    ASSERT(pas_rar_find_ex(&srar, "a.txt", &f));
+    ASSERT_EQ(f.solid, 0);
+    n = pas_rar_extract_ex(&f, g_out, BIG_SIZE, &g_state, g_window, BIG_SIZE, &status);
+    ASSERT(status == PAS_RAR_OK && n == 200000 && memcmp(g_out, g_window_data, n) == 0);
+
+    /* Window under the dictionary: c.bin does not fit, so d.txt has no stream to continue; e.txt
+       starts a new one */
+    ASSERT(pas_rar_seq_begin(&seq, &srar, &g_state, g_window, 0x80000 - 1, &status));
+    ASSERT(seq_step(&seq, "a.txt", g_window_data, 200000, 1));
+    ASSERT(seq_step(&seq, "b.bin", NULL, 0, 0));
+    ASSERT(seq_step(&seq, "note.txt", NULL, 0, 0));
+    ASSERT(seq_step(&seq, "c.bin", NULL, 0, 0));
+    ASSERT_EQ(pas_rar_seq_extract(&seq, g_out, sizeof(g_out), &status), 0u);
+    ASSERT_EQ(status, PAS_RAR_E_NOSPACE);
+    ASSERT(seq_step(&seq, "d.txt", NULL, 0, 0));
+    ASSERT_EQ(pas_rar_seq_extract(&seq, g_out, sizeof(g_out), &status), 0u);
+    ASSERT_EQ(status, PAS_RAR_E_INVALID);
+    ASSERT(seq_step(&seq, "e.txt", g_small, sizeof(k_hello) - 1, 1));
+    ASSERT(seq_step(&seq, "f.txt", g_small + sizeof(k_hello) - 1, sizeof(k_hello) - 1, 1));
+
+    /* Buffer too small: the entry stays current; nothing to extract once it is done */
+    ASSERT(pas_rar_seq_begin(&seq, &srar, &g_state, g_window, BIG_SIZE, &status));
+    ASSERT(seq_step(&seq, "a.txt", NULL, 0, 0));
+    ASSERT(seq_step(&seq, "b.bin", NULL, 0, 0));
+    ASSERT_EQ(pas_rar_seq_extract(&seq, g_out, 100000 - 1, &status), 0u);
+    ASSERT_EQ(status, PAS_RAR_E_NOSPACE);
+    n = pas_rar_seq_extract(&seq, g_out, 100000, &status);
+    ASSERT(status == PAS_RAR_OK && n == 100000 && memcmp(g_out, g_window_data + 200000, n) == 0);
+    ASSERT_EQ(pas_rar_seq_extract(&seq, g_out, 100000, &status), 0u);
+    ASSERT_EQ(status, PAS_RAR_E_INVALID);
+
+    /* A non-solid archive walks the same way */
+    ASSERT(pas_rar_seq_begin(&seq, &rar, &g_state, g_window, 0x80000, &status));
+    ASSERT(pas_rar_seq_next(&seq, &f, &status));
+    memset(g_out, 0, BIG_SIZE);
+    n = pas_rar_seq_extract(&seq, g_out, BIG_SIZE, &status);
+    ASSERT(big_ok(n, status));
+    ASSERT(seq_step(&seq, "hello.txt", (const uint8_t *)k_hello, sizeof(k_hello) - 1, 1));
+    ASSERT(seq_step(&seq, "note.txt", (const uint8_t *)"stored", 6, 1));
+    ASSERT_EQ(pas_rar_seq_next(&seq, &f, &status), 0);
+    ASSERT_EQ(status, PAS_RAR_OK);
+    ASSERT(pas_rar_seq_begin(&seq, &rar, &g_state, g_window, 0x80000, &status));
+    ASSERT(seq_step(&seq, "big.bin", NULL, 0, 0));
+    ASSERT(seq_step(&seq, "hello.txt", (const uint8_t *)k_hello, sizeof(k_hello) - 1, 1));
+
+    if (g_failed) {
+        (void)fprintf(stderr, "Total: %d assertions, %d failed\n", g_assertions, g_failed);
+        return 1;
+    }
+    (void)printf("All %d assertions passed.\n", g_assertions);
+    return 0;
+}
@@ -0,0 +1,322 @@
+/*
+    test_verify.c - Test pas_rar_crc32, pas_rar_blake2sp and rar->verify (stored CRC32 and RAR5
+    hash records checked on extract).
+    From repo root: gcc -o tests/pas_rar/test_verify tests/pas_rar/test_verify.c -I.
+*/
+
+#define PAS_RAR_IMPLEMENTATION
+#include "pas_rar.h"
+#include <stdio.h>
+#include <string.h>
+
+static int g_failed, g_assertions;
+
+#define ASSERT(cond) do { \
+    ++g_assertions; \
+    if (!(cond)) { (void)fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); ++g_failed; } \
+} while (0)
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+#define DATA_SIZE 100000
+
+static unsigned char g_data[DATA_SIZE + 16];
+static unsigned char g_arc[DATA_SIZE + 4096];
+static unsigned char g_out[DATA_SIZE];
+
+/* Reference: one bit at a time */
+static uint32_t crc_bitwise(const unsigned char *p, size_t n) {
+    uint32_t c = 0xFFFFFFFFu;
+    int k;
+    while (n--) {
+        c ^= *p++;
+        for (k = 0; k < 8; k++) c = (c >> 1) ^ (0xEDB88320u & (0u - (c & 1)));
+    }
+    return ~c;
+}
+
+static void make_data(void) {
+    uint32_t x = 12345;
+    size_t i;
+    for (i = 0; i < sizeof(g_data); i++) {
+        x = x * 1103515245u + 12345u;
+        g_data[i] = (unsigned char)(i % 3 ? x >> 24 : 'a' + i % 7);
+    }
+}
+
+static int digest_is(const uint8_t *d, const char *hex) {
+    unsigned i, v;
+    for (i = 0; i < 32; i++) {
+        if (sscanf(hex + 2 * i, "%2x", &v) != 1 || d[i] != v) return 0;
+    }
+    return 1;
+}
+
+static int blake2sp_is(const void *p, size_t n, const char *hex) {
+    uint8_t d[32];
+    pas_rar_blake2sp(p, n, d);
+    return digest_is(d, hex);
+}
+
+static void test_crc(void) {
+    size_t len, off, bad = 0, bad_split = 0;
+
+    ASSERT_EQ(pas_rar_crc32(0, "", 0), 0u);
+    ASSERT_EQ(pas_rar_crc32(0, NULL, 5), 0u);
+    ASSERT_EQ(pas_rar_crc32(0, "123456789", 9), 0xCBF43926u);
+    ASSERT_EQ(pas_rar_crc32(0, "The quick brown fox jumps over the lazy dog", 43), 0x414FA339u);
+
+    /* Every length around the SIMD thresholds, at every alignment, and split into pieces */
+    for (len = 0; len <= 300; len++) {
+        for (off = 0; off < 16; off++) {
+            uint32_t want = crc_bitwise(g_data + off, len);
+            size_t cut = len / 3;
+            if (pas_rar_crc32(0, g_data + off, len) != want) bad++;
+            if (pas_rar_crc32(pas_rar_crc32(0, g_data + off, cut), g_data + off + cut, len - cut) != want)
+                bad_split++;
+        }
+    }
+    ASSERT_EQ(bad, 0u);
+    ASSERT_EQ(bad_split, 0u);
+    ASSERT_EQ(pas_rar_crc32(0, g_data + 3, DATA_SIZE), crc_bitwise(g_data + 3, DATA_SIZE));
+}
+
+/* Digests from the BLAKE2 reference (BLAKE2s in tree mode: fanout 8, depth 2, inner length 32).
+   The lengths straddle the stripe and last-leaf-block boundaries of the 8-lane path. */
+static void test_blake2sp(void) {
+    static const struct { size_t len; const char *hex; } k[] = {
+        { 1, "02d8a06b8727bea60d84158144ddc59c14553f637e3244f7c2c22814853ff3cb" },
+        { 63, "e3ad441f42690141c8d7dfad39851a6df9ee9cf58427d5fd03bfa5c92bffd5b5" },
+        { 64, "f8be286ab1ae779e9f32cdfcc0a27d2951715a8156f7786d3d9b2e7ec5d598a8" },
+        { 65, "44dfa7b921d602f1b489d5b8f2cfbfd9186d20107e2938c807b83cbe185f93db" },
+        { 448, "5e607ebc11eb9879a3010be02560b1852a4724828067e00fc09c482a8d536820" },
+        { 449, "c71bf98ee3bce843a8bb34e55c9babc79ae82cec6ebb960677bb419bd2bfcc57" },
+        { 511, "72134b975396cc3ea941d8cc937d619c016fa8cc87c97ee4e501e8756d86e794" },
+        { 512, "6bc50cc417f1ce3ff10bda3ada5b51a97607ac000f75c55ab55eada20af381a3" },
+        { 513, "66cf727c38b43cd43c96e5262996fd6d5e67bf7d484d2e586c33ed6094f66a93" },
+        { 960, "634108ccf235c6d819a9e11b90477efa5d4f197f36340952a045893185d539d4" },
+        { 961, "c19a6f52d7230febddb007777b93ea7e644fbfb5192bba71ba660d53d7ae961c" },
+        { 1024, "0c66dffb92b4ea1d56a8f0ad4da6f3565dcb080282da1125229d56ff8d66dec5" },
+        { 1473, "f56959739f73915037090c8a98549b2f4ecaea2f2f51f596b5da075d72ad724b" },
+        { 4096, "831cb435769b83bbe69a5409a6428d7128099cf8d79895de8203fa09623cf740" },
+        { DATA_SIZE, "1838c7a9cd47823356c21724284b3b3a7514ecb2253b0e4ad98ac4430dc94c4d" }
+    };
+    size_t i;
+
+    ASSERT(blake2sp_is("", 0, "dd0e891776933f43c7d032b08a917e25741f8aa9a12c12e1cac8801500f2ca4f"));
+    ASSERT(blake2sp_is(NULL, 5, "dd0e891776933f43c7d032b08a917e25741f8aa9a12c12e1cac8801500f2ca4f"));
+    ASSERT(blake2sp_is("abc", 3, "70f75b58f1fecab821db43c88ad84edde5a52600616cd22517b7bb14d440a7d5"));
+    for (i = 0; i < sizeof(k) / sizeof(k[0]); i++) ASSERT(blake2sp_is(g_data, k[i].len, k[i].hex));
+    ASSERT(blake2sp_is(g_data + 3, DATA_SIZE, "edc990632d5f0a39567523290fc3cab2ad94df3ead30f01520261a9e39f80a42"));
+}
+
+static void put32(unsigned char *p, uint32_t v) {
+    p[0] = (unsigned char)v;
+    p[1] = (unsigned char)(v >> 8);
+    p[2] = (unsigned char)(v >> 16);
+    p[3] = (unsigned char)(v >> 24);
+}
+
+static size_t put_vint(unsigned char *p, uint64_t v) {
+    size_t n = 0;
+    while (v >= 0x80) {
+        p[n++] = (unsigned char)(v | 0x80);
+        v >>= 7;
+    }
+    p[n++] = (unsigned char)v;
+    return n;
+}
+
+/* RAR5 header: CRC32, size, then fields; the CRC covers size and fields */
+static size_t put_header(unsigned char *out, const unsigned char *fields, size_t n) {
+    size_t len = 4 + put_vint(out + 4, n);
+    memcpy(out + len, fields, n);
+    len += n;
+    put32(out, crc_bitwise(out + 4, len - 4));
+    return len;
+}
+
+#define WITH_CRC  1   /* data CRC32 in the file header */
+#define WITH_HASH 2   /* BLAKE2sp hash record */
+#define WITH_TIME 4   /* a time record in front of the hash record */
+
+/* Stored RAR5 entry */
+static size_t add_file5(unsigned char *out, const char *name, const unsigned char *data, size_t size, int with) {
+    unsigned char f[256], extra[64];
+    size_t n = 0, ne = 0, nl = strlen(name), len;
+
+    if (with & WITH_TIME) {
+        extra[ne++] = 6;                      /* record size: type, flags, Unix mtime */
+        extra[ne++] = 3;
+        extra[ne++] = 3;
+        put32(extra + ne, 1700000000u);
+        ne += 4;
+    }
+    if (with & WITH_HASH) {
+        extra[ne++] = 34;                     /* type, hash type 0 (BLAKE2sp), digest */
+        extra[ne++] = 2;
+        extra[ne++] = 0;
+        pas_rar_blake2sp(data, size, extra + ne);
+        ne += 32;
+    }
+    n += put_vint(f + n, 2);                  /* file header */
+    n += put_vint(f + n, ne ? 0x03 : 0x02);   /* extra area, data area */
+    if (ne) n += put_vint(f + n, ne);
+    n += put_vint(f + n, size);
+    n += put_vint(f + n, with & WITH_CRC ? 0x04 : 0);
+    n += put_vint(f + n, size);
+    n += put_vint(f + n, 0);                  /* attributes */
+    if (with & WITH_CRC) {
+        put32(f + n, crc_bitwise(data, size));
+        n += 4;
+    }
+    n += put_vint(f + n, 0);                  /* compression info: store */
+    n += put_vint(f + n, 0);                  /* host OS */
+    n += put_vint(f + n, nl);
+    memcpy(f + n, name, nl);
+    n += nl;
+    memcpy(f + n, extra, ne);
+    n += ne;
+    len = put_header(out, f, n);
+    memcpy(out + len, data, size);
+    return len + size;
+}
+
+static size_t make_rar5(unsigned char *out) {
+    static const unsigned char sig[8] = { 'R','a','r','!',0x1A,0x07,0x01,0x00 };
+    static const unsigned char main_hdr[3] = { 1, 0, 0 };
+    static const unsigned char end_hdr[3] = { 5, 0, 0 };
+    size_t len = 8;
+
+    memcpy(out, sig, 8);
+    len += put_header(out + len, main_hdr, 3);
+    len += add_file5(out + len, "crc.txt", (const unsigned char *)"checked by CRC32", 16, WITH_CRC);
+    len += add_file5(out + len, "hash.bin", g_data, DATA_SIZE, WITH_HASH | WITH_TIME);
+    len += add_file5(out + len, "both.txt", (const unsigned char *)"CRC32 and BLAKE2sp", 18, WITH_CRC | WITH_HASH);
+    len += add_file5(out + len, "none.txt", (const unsigned char *)"unchecked", 9, 0);
+    len += put_header(out + len, end_hdr, 3);
+    return len;
+}
+
+/* Stored RAR4 entry with FILE_CRC crc */
+static size_t add_file4(unsigned char *out, const char *name, const char *data, uint32_t crc) {
+    size_t nl = strlen(name), dl = strlen(data);
+    memset(out, 0, 32);
+    out[2] = 0x74;
+    out[4] = 0x80;                            /* HEAD_FLAGS 0x8000: ADD_SIZE present */
+    out[5] = (unsigned char)(32 + nl);
+    put32(out + 7, (uint32_t)dl);             /* PACK_SIZE */
+    put32(out + 11, (uint32_t)dl);            /* UNP_SIZE */
+    put32(out + 16, crc);                     /* FILE_CRC */
+    out[24] = 0x14;
+    out[25] = 0x30;                           /* store */
+    out[26] = (unsigned char)nl;
+    memcpy(out + 32, name, nl);
+    memcpy(out + 32 + nl, data, dl);
+    return 32 + nl + dl;
+}
+
+/* Extract name from rar: bytes written, status in *st */
+static size_t extract(pas_rar_t *rar, const char *name, pas_rar_status *st) {
+    pas_rar_file_t f;
+    *st = PAS_RAR_E_NOT_FOUND;
+    if (!pas_rar_find_ex(rar, name, &f)) return 0;
+    return pas_rar_extract(&f, g_out, sizeof(g_out), st);
+}
+
+static void test_rar5(void) {
+    static const char *names[4] = { "crc.txt", "hash.bin", "both.txt", "none.txt" };
+    static const size_t sizes[4] = { 16, DATA_SIZE, 18, 9 };
+    pas_rar_t rar;
+    pas_rar_file_t f;
+    pas_rar_status st;
+    pas_rar_seq_t seq;
+    pas_rar_unpack_t state;
+    size_t len = make_rar5(g_arc), i, bad;
+
+    ASSERT(pas_rar_open_ex(&rar, g_arc, len, &st));
+    ASSERT_EQ(rar.verify, 0);
+    ASSERT(pas_rar_find_ex(&rar, "crc.txt", &f));
+    ASSERT_EQ(f.checks, PAS_RAR_CHECK_CRC32);
+    ASSERT_EQ(f.crc32, crc_bitwise((const unsigned char *)"checked by CRC32", 16));
+    ASSERT(pas_rar_find_ex(&rar, "hash.bin", &f));
+    ASSERT_EQ(f.checks, PAS_RAR_CHECK_BLAKE2);
+    ASSERT(digest_is(f.blake2, "1838c7a9cd47823356c21724284b3b3a7514ecb2253b0e4ad98ac4430dc94c4d"));
+    ASSERT(pas_rar_find_ex(&rar, "both.txt", &f));
+    ASSERT_EQ(f.checks, PAS_RAR_CHECK_CRC32 | PAS_RAR_CHECK_BLAKE2);
+    ASSERT(pas_rar_find_ex(&rar, "none.txt", &f));
+    ASSERT_EQ(f.checks, 0);
+
+    /* Intact: every entry passes, through pas_rar_extract and the sequential walk */
+    rar.verify = 1;
+    for (i = 0, bad = 0; i < 4; i++) bad += extract(&rar, names[i], &st) != sizes[i] || st != PAS_RAR_OK;
+    ASSERT_EQ(bad, 0u);
+    ASSERT(pas_rar_seq_begin(&seq, &rar, &state, NULL, 0, &st));
+    for (i = 0, bad = 0; i < 4; i++) {
+        bad += !pas_rar_seq_next(&seq, &f, &st);
+        bad += pas_rar_seq_extract(&seq, g_out, sizeof(g_out), &st) != sizes[i] || st != PAS_RAR_OK;
+    }
+    ASSERT_EQ(bad, 0u);
+
+    /* One byte flipped in each entry's data */
+    for (i = 0; i < 4; i++) {
+        ASSERT(pas_rar_find_ex(&rar, names[i], &f));
+        g_arc[f.data_offset + sizes[i] / 2] ^= 0x10;
+    }
+    ASSERT_EQ(extract(&rar, "crc.txt", &st), 0u);
+    ASSERT_EQ(st, PAS_RAR_E_CRC);
+    ASSERT_EQ(extract(&rar, "hash.bin", &st), 0u);
+    ASSERT_EQ(st, PAS_RAR_E_CRC);
+    ASSERT_EQ(extract(&rar, "both.txt", &st), 0u);
+    ASSERT_EQ(st, PAS_RAR_E_CRC);
+    ASSERT_EQ(extract(&rar, "none.txt", &st), 9u);
+    ASSERT_EQ(st, PAS_RAR_OK);
+    ASSERT(pas_rar_seq_begin(&seq, &rar, &state, NULL, 0, &st));
+    ASSERT(pas_rar_seq_next(&seq, &f, &st));
+    ASSERT_EQ(pas_rar_seq_extract(&seq, g_out, sizeof(g_out), &st), 0u);
+    ASSERT_EQ(st, PAS_RAR_E_CRC);
+
+    /* Off by default: the damaged data comes out as stored */
+    rar.verify = 0;
+    for (i = 0, bad = 0; i < 4; i++) bad += extract(&rar, names[i], &st) != sizes[i] || st != PAS_RAR_OK;
+    ASSERT_EQ(bad, 0u);
+}
+
+static void test_rar4(void) {
+    static const unsigned char head[14] = { 'R','a','r','!',0x1A,0x07,0x00, 0,0,0x73,0,0,7,0 };
+    pas_rar_t rar;
+    pas_rar_file_t f;
+    pas_rar_status st;
+    size_t len = sizeof(head);
+
+    memcpy(g_arc, head, len);
+    len += add_file4(g_arc + len, "good.txt", "intact", crc_bitwise((const unsigned char *)"intact", 6));
+    len += add_file4(g_arc + len, "bad.txt", "damaged", crc_bitwise((const unsigned char *)"damages", 7));
+
+    ASSERT(pas_rar_open_ex(&rar, g_arc, len, &st));
+    ASSERT(pas_rar_find_ex(&rar, "bad.txt", &f));
+    ASSERT_EQ(f.checks, PAS_RAR_CHECK_CRC32);
+    ASSERT_EQ(extract(&rar, "bad.txt", &st), 7u);
+    rar.verify = 1;
+    ASSERT_EQ(extract(&rar, "good.txt", &st), 6u);
+    ASSERT_EQ(st, PAS_RAR_OK);
+    ASSERT_EQ(extract(&rar, "bad.txt", &st), 0u);
+    ASSERT_EQ(st, PAS_RAR_E_CRC);
+}
+
+int main(void) {
+    g_failed = 0;
+    g_assertions = 0;
+
+    make_data();
+    test_crc();
+    test_blake2sp();
+    test_rar5();
+    test_rar4();
+
+    if (g_failed) {
+        (void)fprintf(stderr, "Total: %d assertions, %d failed\n", g_assertions, g_failed);
+        return 1;
+    }
+    (void)printf("All %d assertions passed.\n", g_assertions);
+    return 0;
+}
@@ -0,0 +1,142 @@
+/*
+    test_compress.c - Test the built-in Deflate encoder (pas_zip_deflate, pas_zip_create_ex).
+    From repo root: gcc -o tests/pas_zip/test_compress tests/pas_zip/test_compress.c -I.
+*/
+
+#define PAS_ZIP_IMPLEMENTATION
+#include "pas_zip.h"
+#include <stdio.h>
+#include <string.h>
+
+static int g_failed, g_assertions;
+
+#define ASSERT(cond) do { \
+    ++g_assertions; \
+    if (!(cond)) { (void)fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); ++g_failed; } \
+} while (0)
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+#define TEXT_SIZE 200000
+
+static pas_zip_deflate_t g_deflate;
+static pas_zip_inflate_t g_inflate;
+static char g_text[TEXT_SIZE];
+static unsigned char g_noise[70000];
+static unsigned char g_comp[TEXT_SIZE + 1024];
+static char g_out[TEXT_SIZE];
+
+/* Log-like text: repeats at short and long distances, spans several blocks. */
+static void make_inputs(void) {
+    static const char *words[] = { "open", "read", "close", "seek", "map", "error", "ok", "retry" };
+    uint32_t x = 12345;
+    size_t n = 0, i;
+    while (n < TEXT_SIZE - 64) {
+        x = x * 1103515245u + 12345u;
+        n += (size_t)sprintf(g_text + n, "%06u %s file%u.dat\n", (unsigned)(n / 40),
+                             words[(x >> 16) % 8], (unsigned)((x >> 8) % 100));
+    }
+    memset(g_text + n, '.', TEXT_SIZE - n);
+    for (i = 0; i < sizeof(g_noise); i++) {
+        x = x * 1103515245u + 12345u;
+        g_noise[i] = (unsigned char)(x >> 24);
+    }
+}
+
+static void test_levels(void) {
+    size_t n, m, prev = (size_t)-1;
+    pas_zip_status status;
+    int level;
+
+    for (level = 0; level <= 9; level++) {
+        n = pas_zip_deflate(&g_deflate, level, g_text, TEXT_SIZE, g_comp, sizeof(g_comp), &status);
+        ASSERT(status == PAS_ZIP_OK);
+        if (level > 0) ASSERT(n < TEXT_SIZE / 3);
+        if (level == 1 || level == 9) { ASSERT(n <= prev); prev = n; }
+        m = pas_zip_inflate(&g_inflate, g_comp, n, g_out, sizeof(g_out), &status);
+        ASSERT(status == PAS_ZIP_OK);
+        ASSERT_EQ(m, (size_t)TEXT_SIZE);
+        ASSERT(memcmp(g_out, g_text, TEXT_SIZE) == 0);
+    }
+
+    /* Incompressible data falls back to stored blocks */
+    n = pas_zip_deflate(&g_deflate, 6, g_noise, sizeof(g_noise), g_comp, sizeof(g_comp), &status);
+    ASSERT(status == PAS_ZIP_OK);
+    ASSERT(n <= sizeof(g_noise) + 64);
+    m = pas_zip_inflate(&g_inflate, g_comp, n, g_out, sizeof(g_out), &status);
+    ASSERT_EQ(m, sizeof(g_noise));
+    ASSERT(memcmp(g_out, g_noise, sizeof(g_noise)) == 0);
+
+    /* Empty input */
+    n = pas_zip_deflate(&g_deflate, 6, "", 0, g_comp, sizeof(g_comp), &status);
+    ASSERT(status == PAS_ZIP_OK);
+    ASSERT(n > 0);
+    m = pas_zip_inflate(&g_inflate, g_comp, n, g_out, sizeof(g_out), &status);
+    ASSERT(status == PAS_ZIP_OK);
+    ASSERT_EQ(m, 0u);
+
+    n = pas_zip_deflate(&g_deflate, 6, g_text, TEXT_SIZE, g_comp, 100, &status);
+    ASSERT(status == PAS_ZIP_E_NOSPACE);
+    ASSERT_EQ(n, 0u);
+}
+
+static void test_create(void) {
+    static unsigned char zip[TEXT_SIZE + 90000];
+    const char *names[3] = { "log.txt", "noise.bin", "empty" };
+    const void *datas[3];
+    size_t sizes[3], written, n;
+    pas_zip_status status;
+    pas_zip_t arch;
+    pas_zip_file_t file;
+
+    datas[0] = g_text; sizes[0] = TEXT_SIZE;
+    datas[1] = g_noise; sizes[1] = sizeof(g_noise);
+    datas[2] = ""; sizes[2] = 0;
+
+    written = pas_zip_create_ex(names, datas, sizes, 3, 6, &g_deflate, zip, sizeof(zip), &status);
+    ASSERT(status == PAS_ZIP_OK);
+    ASSERT(written < sizeof(g_noise) + TEXT_SIZE / 3);
+
+    ASSERT_EQ(pas_zip_open_ex(&arch, zip, written, &status), 1);
+    ASSERT_EQ(arch.num_entries, 3u);
+
+    ASSERT_EQ(pas_zip_find_ex(&arch, "log.txt", &file), 1);
+    ASSERT_EQ(file.compression_method, PAS_ZIP_METHOD_DEFLATE);
+    n = pas_zip_extract(&file, g_out, sizeof(g_out), &status);
+    ASSERT(status == PAS_ZIP_OK);
+    ASSERT_EQ(n, (size_t)TEXT_SIZE);
+    ASSERT(memcmp(g_out, g_text, TEXT_SIZE) == 0);
+
+    ASSERT_EQ(pas_zip_find_ex(&arch, "noise.bin", &file), 1);
+    ASSERT_EQ(file.compression_method, PAS_ZIP_METHOD_STORE);
+    n = pas_zip_extract(&file, g_out, sizeof(g_out), &status);
+    ASSERT_EQ(n, sizeof(g_noise));
+    ASSERT(memcmp(g_out, g_noise, sizeof(g_noise)) == 0);
+
+    ASSERT_EQ(pas_zip_find_ex(&arch, "empty", &file), 1);
+    ASSERT_EQ(file.uncompressed_size, 0u);
+
+    /* Level 0 stores everything */
+    written = pas_zip_create_ex(names, datas, sizes, 3, 0, &g_deflate, zip, sizeof(zip), &status);
+    ASSERT(status == PAS_ZIP_OK);
+    ASSERT_EQ(pas_zip_open_ex(&arch, zip, written, &status), 1);
+    ASSERT_EQ(pas_zip_find_ex(&arch, "log.txt", &file), 1);
+    ASSERT_EQ(file.compression_method, PAS_ZIP_METHOD_STORE);
+
+    /* Buffer too small even for the compressed entries */
+    (void)pas_zip_create_ex(names, datas, sizes, 3, 6, &g_deflate, zip, 1000, &status);
+    ASSERT(status == PAS_ZIP_E_NOSPACE);
+}
+
+int main(void) {
+    g_failed = 0;
+    g_assertions = 0;
+    make_inputs();
+    test_levels();
+    test_create();
+    if (g_failed) {
+        (void)fprintf(stderr, "Total: %d assertions, %d failed\n", g_assertions, g_failed);
+        return 1;
+    }
+    (void)printf("All %d assertions passed.\n", g_assertions);
+    return 0;
+}
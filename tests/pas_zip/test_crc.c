@@ -0,0 +1,183 @@
+/*
+    test_crc.c - Test pas_zip_crc32, CRCs written by create/writer and verify_crc on extract/read.
+    From repo root: gcc -o tests/pas_zip/test_crc tests/pas_zip/test_crc.c -I.
+*/
+
+#define PAS_ZIP_IMPLEMENTATION
+#include "pas_zip.h"
+#include <stdio.h>
+#include <string.h>
+
+static int g_failed, g_assertions;
+
+#define ASSERT(cond) do { \
+    ++g_assertions; \
+    if (!(cond)) { (void)fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); ++g_failed; } \
+} while (0)
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+#define DATA_SIZE 100000
+
+static pas_zip_deflate_t g_deflate;
+static pas_zip_writer_t g_writer;
+static pas_zip_writer_entry_t g_entries[4];
+static pas_zip_reader_t g_reader;
+static unsigned char g_data[DATA_SIZE + 16];
+static unsigned char g_zip[2 * DATA_SIZE];
+static unsigned char g_out[DATA_SIZE];
+
+/* Reference: one bit at a time */
+static uint32_t crc_bitwise(const unsigned char *p, size_t n) {
+    uint32_t c = 0xFFFFFFFFu;
+    int k;
+    while (n--) {
+        c ^= *p++;
+        for (k = 0; k < 8; k++) c = (c >> 1) ^ (0xEDB88320u & (0u - (c & 1)));
+    }
+    return ~c;
+}
+
+static void make_data(void) {
+    uint32_t x = 12345;
+    size_t i;
+    for (i = 0; i < sizeof(g_data); i++) {
+        x = x * 1103515245u + 12345u;
+        g_data[i] = (unsigned char)(i % 3 ? x >> 24 : 'a' + i % 7);
+    }
+}
+
+static void test_vectors(void) {
+    ASSERT_EQ(pas_zip_crc32(0, "", 0), 0u);
+    ASSERT_EQ(pas_zip_crc32(0, NULL, 5), 0u);
+    ASSERT_EQ(pas_zip_crc32(0, "a", 1), 0xE8B7BE43u);
+    ASSERT_EQ(pas_zip_crc32(0, "123456789", 9), 0xCBF43926u);
+    ASSERT_EQ(pas_zip_crc32(0, "The quick brown fox jumps over the lazy dog", 43), 0x414FA339u);
+}
+
+/* Every length around the SIMD thresholds, at every alignment, and split into pieces */
+static void test_lengths(void) {
+    size_t len, off, bad = 0, bad_split = 0;
+    for (len = 0; len <= 300; len++) {
+        for (off = 0; off < 16; off++) {
+            uint32_t want = crc_bitwise(g_data + off, len);
+            size_t cut = len / 3;
+            if (pas_zip_crc32(0, g_data + off, len) != want) bad++;
+            if (pas_zip_crc32(pas_zip_crc32(0, g_data + off, cut), g_data + off + cut, len - cut) != want)
+                bad_split++;
+        }
+    }
+    ASSERT_EQ(bad, 0u);
+    ASSERT_EQ(bad_split, 0u);
+    ASSERT_EQ(pas_zip_crc32(0, g_data + 3, DATA_SIZE), crc_bitwise(g_data + 3, DATA_SIZE));
+}
+
+static void test_create_and_verify(void) {
+    const char *names[2] = { "text.bin", "small.txt" };
+    const void *datas[2];
+    size_t sizes[2] = { DATA_SIZE, 9 };
+    pas_zip_status st;
+    pas_zip_t zip;
+    pas_zip_file_t f;
+    size_t len, n, total;
+    uint8_t *payload;
+
+    datas[0] = g_data;
+    datas[1] = "123456789";
+    len = pas_zip_create_ex(names, datas, sizes, 2, 6, &g_deflate, g_zip, sizeof(g_zip), &st);
+    ASSERT(len > 0);
+    ASSERT(pas_zip_open_ex(&zip, g_zip, len, &st));
+    ASSERT_EQ(zip.verify_crc, 0);
+    ASSERT(pas_zip_find_ex(&zip, "text.bin", &f));
+    ASSERT_EQ(f.crc32, crc_bitwise(g_data, DATA_SIZE));
+    ASSERT(pas_zip_find_ex(&zip, "small.txt", &f));
+    ASSERT_EQ(f.crc32, 0xCBF43926u);
+    ASSERT_EQ(read_u32_le(g_zip + 14), crc_bitwise(g_data, DATA_SIZE)); /* local header too */
+
+    zip.verify_crc = 1;
+    ASSERT(pas_zip_find_ex(&zip, "small.txt", &f));
+    ASSERT_EQ(pas_zip_extract(&f, g_out, sizeof(g_out), &st), 9u);
+    ASSERT_EQ(st, PAS_ZIP_OK);
+
+    /* Corrupt one stored byte: only detected with verify_crc */
+    payload = g_zip + f.local_header_offset + 30 + f.name_len;
+    payload[4] ^= 1;
+    ASSERT_EQ(pas_zip_extract(&f, g_out, sizeof(g_out), &st), 0u);
+    ASSERT_EQ(st, PAS_ZIP_E_CRC);
+    ASSERT(pas_zip_reader_init(&g_reader, &f, &st));
+    ASSERT_EQ(pas_zip_reader_read(&g_reader, g_out, 5, &st), 5u);
+    ASSERT_EQ(st, PAS_ZIP_OK);
+    ASSERT_EQ(pas_zip_reader_read(&g_reader, g_out, 100, &st), 4u);
+    ASSERT_EQ(st, PAS_ZIP_E_CRC);
+    ASSERT_EQ(pas_zip_reader_read(&g_reader, g_out, 100, &st), 0u);
+    ASSERT_EQ(st, PAS_ZIP_E_CRC);
+    zip.verify_crc = 0;
+    ASSERT_EQ(pas_zip_extract(&f, g_out, sizeof(g_out), &st), 9u);
+    ASSERT_EQ(st, PAS_ZIP_OK);
+    payload[4] ^= 1;
+
+    /* Deflate entry streamed in odd-sized reads with verification on */
+    zip.verify_crc = 1;
+    ASSERT(pas_zip_find_ex(&zip, "text.bin", &f));
+    ASSERT_EQ(f.compression_method, PAS_ZIP_METHOD_DEFLATE);
+    ASSERT_EQ(pas_zip_extract(&f, g_out, sizeof(g_out), &st), (size_t)DATA_SIZE);
+    ASSERT_EQ(st, PAS_ZIP_OK);
+    ASSERT(pas_zip_reader_init(&g_reader, &f, &st));
+    total = 0;
+    while ((n = pas_zip_reader_read(&g_reader, g_out + total, 777 < DATA_SIZE - total ? 777 : DATA_SIZE - total, &st)) > 0 &&
+           st == PAS_ZIP_OK)
+        total += n;
+    ASSERT_EQ(total, (size_t)DATA_SIZE);
+    ASSERT_EQ(st, PAS_ZIP_OK);
+    ASSERT(memcmp(g_out, g_data, DATA_SIZE) == 0);
+}
+
+static void test_writer_crc(void) {
+    pas_zip_status st;
+    pas_zip_t zip;
+    pas_zip_file_t f;
+    size_t len, off;
+
+    ASSERT(pas_zip_writer_begin(&g_writer, g_zip, sizeof(g_zip), g_entries, 4, &g_deflate, &st));
+    ASSERT(pas_zip_writer_add_entry(&g_writer, "deflated", 6, &st));
+    for (off = 0; off < DATA_SIZE; off += 3001)
+        ASSERT(pas_zip_writer_add_chunk(&g_writer, g_data + off, DATA_SIZE - off < 3001 ? DATA_SIZE - off : 3001, &st));
+    ASSERT(pas_zip_writer_add_entry(&g_writer, "stored", 0, &st));
+    ASSERT(pas_zip_writer_add_chunk(&g_writer, "1234", 4, &st));
+    ASSERT(pas_zip_writer_add_chunk(&g_writer, "56789", 5, &st));
+    ASSERT(pas_zip_writer_add_entry(&g_writer, "empty", 6, &st));
+    len = pas_zip_writer_finish(&g_writer, &st);
+    ASSERT(len > 0);
+    ASSERT_EQ(g_entries[0].crc32, crc_bitwise(g_data, DATA_SIZE));
+    ASSERT_EQ(g_entries[1].crc32, 0xCBF43926u);
+    ASSERT_EQ(g_entries[2].crc32, 0u);
+
+    ASSERT(pas_zip_open_ex(&zip, g_zip, len, &st));
+    zip.verify_crc = 1;
+    ASSERT(pas_zip_find_ex(&zip, "deflated", &f));
+    ASSERT_EQ(f.crc32, g_entries[0].crc32);
+    ASSERT_EQ(pas_zip_extract(&f, g_out, sizeof(g_out), &st), (size_t)DATA_SIZE);
+    ASSERT_EQ(st, PAS_ZIP_OK);
+    ASSERT(pas_zip_find_ex(&zip, "stored", &f));
+    ASSERT_EQ(f.crc32, 0xCBF43926u);
+    ASSERT_EQ(pas_zip_extract(&f, g_out, sizeof(g_out), &st), 9u);
+    ASSERT_EQ(st, PAS_ZIP_OK);
+    ASSERT(pas_zip_find_ex(&zip, "empty", &f));
+    ASSERT_EQ(pas_zip_extract(&f, g_out, sizeof(g_out), &st), 0u);
+    ASSERT_EQ(st, PAS_ZIP_OK);
+}
+
+int main(void) {
+    g_failed = 0;
+    g_assertions = 0;
+    make_data();
+    test_vectors();
+    test_lengths();
+    test_create_and_verify();
+    test_writer_crc();
+    if (g_failed) {
+        (void)fprintf(stderr, "Total: %d assertions, %d failed\n", g_assertions, g_failed);
+        return 1;
+    }
+    (void)printf("All %d assertions passed.\n", g_assertions);
+    return 0;
+}
@@ -0,0 +1,96 @@
+/*
+    test_data_ptr.c - Test pas_zip_get_data_ptr (zero-copy Store entries).
+    From repo root: gcc -o tests/pas_zip/test_data_ptr tests/pas_zip/test_data_ptr.c -I.
+*/
+
+#define PAS_ZIP_IMPLEMENTATION
+#include "pas_zip.h"
+#include <stdio.h>
+#include <string.h>
+
+static int g_failed, g_assertions;
+
+#define ASSERT(cond) do { \
+    ++g_assertions; \
+    if (!(cond)) { (void)fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); ++g_failed; } \
+} while (0)
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+static pas_zip_deflate_t g_deflate;
+static unsigned char g_zip[65536];
+static char g_text[20000];
+
+int main(void) {
+    const char *names[3] = { "store.txt", "deflate.txt", "empty" };
+    const void *datas[3];
+    size_t sizes[3];
+    pas_zip_status st;
+    pas_zip_t zip;
+    pas_zip_file_t f;
+    const void *ptr;
+    size_t len, written, i;
+
+    g_failed = 0;
+    g_assertions = 0;
+
+    for (i = 0; i < sizeof(g_text); i++) g_text[i] = (char)('a' + i % 3);
+    datas[0] = "Hello, ZIP!";
+    datas[1] = g_text;
+    datas[2] = "";
+    sizes[0] = 11;
+    sizes[1] = sizeof(g_text);
+    sizes[2] = 0;
+    /* Store for the first and last entry, Deflate for the middle one */
+    written = pas_zip_create_ex(names, datas, sizes, 3, 6, &g_deflate, g_zip, sizeof(g_zip), &st);
+    ASSERT(written > 0);
+    ASSERT(pas_zip_open_ex(&zip, g_zip, written, &st));
+
+    ASSERT(pas_zip_find_ex(&zip, "store.txt", &f));
+    ASSERT_EQ(f.compression_method, PAS_ZIP_METHOD_STORE);
+    ASSERT(pas_zip_get_data_ptr(&f, &ptr, &len, &st));
+    ASSERT_EQ(st, PAS_ZIP_OK);
+    ASSERT_EQ(len, 11u);
+    ASSERT(memcmp(ptr, "Hello, ZIP!", 11) == 0);
+    ASSERT((const unsigned char *)ptr == g_zip + 30 + 9); /* no copy: right after the local header */
+
+    ASSERT(pas_zip_find_ex(&zip, "deflate.txt", &f));
+    ptr = NULL;
+    ASSERT_EQ(pas_zip_get_data_ptr(&f, &ptr, &len, &st), 0);
+    ASSERT_EQ(st, PAS_ZIP_E_COMPRESSED);
+    ASSERT(ptr == NULL);
+
+    ASSERT(pas_zip_find_ex(&zip, "empty", &f));
+    ASSERT(pas_zip_get_data_ptr(&f, &ptr, &len, &st));
+    ASSERT_EQ(len, 0u);
+
+    /* CRC is checked only with verify_crc */
+    ASSERT(pas_zip_find_ex(&zip, "store.txt", &f));
+    g_zip[30 + 9] = 'J';
+    ASSERT(pas_zip_get_data_ptr(&f, &ptr, &len, &st));
+    zip.verify_crc = 1;
+    ASSERT(pas_zip_find_ex(&zip, "store.txt", &f));
+    ASSERT_EQ(pas_zip_get_data_ptr(&f, &ptr, &len, &st), 0);
+    ASSERT_EQ(st, PAS_ZIP_E_CRC);
+    g_zip[30 + 9] = 'H';
+    ASSERT(pas_zip_get_data_ptr(&f, &ptr, &len, &st));
+    zip.verify_crc = 0;
+
+    /* Bad local header signature */
+    g_zip[0] = 'X';
+    ASSERT_EQ(pas_zip_get_data_ptr(&f, &ptr, &len, &st), 0);
+    ASSERT_EQ(st, PAS_ZIP_E_INVALID);
+    g_zip[0] = 'P';
+
+    /* Sizes that disagree for a Store entry */
+    f.uncompressed_size = 12;
+    ASSERT_EQ(pas_zip_get_data_ptr(&f, &ptr, &len, &st), 0);
+    ASSERT_EQ(st, PAS_ZIP_E_INVALID);
+    ASSERT_EQ(pas_zip_get_data_ptr(NULL, &ptr, &len, &st), 0);
+
+    if (g_failed) {
+        (void)fprintf(stderr, "Total: %d assertions, %d failed\n", g_assertions, g_failed);
+        return 1;
+    }
+    (void)printf("All %d assertions passed.\n", g_assertions);
+    return 0;
+}
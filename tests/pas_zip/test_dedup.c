@@ -0,0 +1,163 @@
+/*
+    test_dedup.c - Test duplicate-content deduplication (pas_zip_create_dedup).
+    From repo root: gcc -o tests/pas_zip/test_dedup tests/pas_zip/test_dedup.c -I.
+*/
+
+#define PAS_ZIP_IMPLEMENTATION
+#include "pas_zip.h"
+#include <stdio.h>
+#include <string.h>
+
+static int g_failed, g_assertions;
+
+#define ASSERT(cond) do { \
+    ++g_assertions; \
+    if (!(cond)) { (void)fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); ++g_failed; } \
+} while (0)
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+#define LICENSE_SIZE 20000
+#define COUNT 10
+#define MANY 5000
+
+static pas_zip_deflate_t g_deflate;
+static unsigned char g_zip[400000];
+static unsigned char g_plain[400000];
+static unsigned char g_storage[MANY * 64];
+static char g_license[LICENSE_SIZE];
+static char g_copy[LICENSE_SIZE];
+static char g_other[LICENSE_SIZE];
+static char g_out[LICENSE_SIZE];
+static char g_names[MANY][24];
+
+static const char *k_names[COUNT] = {
+    "LICENSE", "a/LICENSE", "b/LICENSE.txt", "other.txt", "c/LICENSE",
+    "empty1", "empty2", "hello.txt", "hello_copy.txt", "d/LICENSE"
+};
+
+static size_t make_inputs(const void **datas, size_t *sizes) {
+    size_t i;
+    for (i = 0; i < LICENSE_SIZE; i++) g_license[i] = (char)("Permission is hereby granted "[i % 29]);
+    memcpy(g_copy, g_license, LICENSE_SIZE);
+    memcpy(g_other, g_license, LICENSE_SIZE);
+    g_other[LICENSE_SIZE / 2] ^= 1; /* same size, one bit different */
+
+    datas[0] = g_license; sizes[0] = LICENSE_SIZE;
+    datas[1] = g_license; sizes[1] = LICENSE_SIZE;  /* same pointer */
+    datas[2] = g_copy;    sizes[2] = LICENSE_SIZE;  /* equal bytes elsewhere */
+    datas[3] = g_other;   sizes[3] = LICENSE_SIZE;
+    datas[4] = g_license; sizes[4] = 1000;          /* prefix only */
+    datas[5] = "";        sizes[5] = 0;
+    datas[6] = "";        sizes[6] = 0;
+    datas[7] = "hello";   sizes[7] = 5;
+    datas[8] = "hello";   sizes[8] = 5;
+    datas[9] = g_copy;    sizes[9] = LICENSE_SIZE;
+    return COUNT;
+}
+
+static int entry_is(const pas_zip_t *zip, const char *name, const void *data, size_t size, pas_zip_file_t *f) {
+    pas_zip_status st;
+    size_t n;
+    if (!pas_zip_find_ex(zip, name, f)) return 0;
+    n = pas_zip_extract(f, g_out, sizeof(g_out), &st);
+    return st == PAS_ZIP_OK && n == size && memcmp(g_out, data, size) == 0;
+}
+
+static int name_matches(const pas_zip_file_t *f, const char *s) {
+    size_t n;
+    const char *p = pas_zip_name_span(f, &n);
+    return n == strlen(s) && memcmp(p, s, n) == 0;
+}
+
+static void test_dedup(int level) {
+    const void *datas[COUNT];
+    size_t sizes[COUNT], plain, len, i;
+    pas_zip_t zip;
+    pas_zip_file_t f[COUNT];
+    pas_zip_status st;
+
+    make_inputs(datas, sizes);
+    plain = pas_zip_create_ex(k_names, datas, sizes, COUNT, level, &g_deflate, g_plain, sizeof(g_plain), &st);
+    ASSERT(plain > 0);
+    len = pas_zip_create_dedup(k_names, datas, sizes, COUNT, level, &g_deflate, g_storage,
+                               pas_zip_dedup_size(COUNT), g_zip, sizeof(g_zip), &st);
+    ASSERT(len > 0);
+    ASSERT_EQ(st, PAS_ZIP_OK);
+    ASSERT(len < plain);
+    if (level == 0) ASSERT(plain - len > 3 * LICENSE_SIZE); /* three license copies and one hello left out */
+
+    ASSERT(pas_zip_open_ex(&zip, g_zip, len, &st));
+    ASSERT_EQ(zip.num_entries, (uint64_t)COUNT);
+    zip.verify_crc = 1;
+    for (i = 0; i < COUNT; i++) ASSERT(entry_is(&zip, k_names[i], datas[i], sizes[i], &f[i]));
+
+    /* Duplicates share the first copy's local header; the rest have their own */
+    ASSERT_EQ(f[1].local_header_offset, f[0].local_header_offset);
+    ASSERT_EQ(f[2].local_header_offset, f[0].local_header_offset);
+    ASSERT_EQ(f[9].local_header_offset, f[0].local_header_offset);
+    ASSERT_EQ(f[8].local_header_offset, f[7].local_header_offset);
+    ASSERT(f[3].local_header_offset != f[0].local_header_offset);
+    ASSERT(f[4].local_header_offset != f[0].local_header_offset);
+    ASSERT(f[6].local_header_offset != f[5].local_header_offset);
+    ASSERT_EQ(f[2].crc32, f[0].crc32);
+    ASSERT_EQ(f[2].compressed_size, f[0].compressed_size);
+    ASSERT(name_matches(&f[2], "b/LICENSE.txt"));
+}
+
+/* Many entries, most of them copies of a few contents */
+static void test_many(void) {
+    static const char *contents[4] = { "alpha", "bravo bravo", "charlie", "delta delta delta" };
+    const char *names[MANY];
+    const void *datas[MANY];
+    size_t sizes[MANY], len, i, bad = 0;
+    pas_zip_t zip;
+    pas_zip_file_t f;
+    pas_zip_status st;
+
+    for (i = 0; i < MANY; i++) {
+        (void)sprintf(g_names[i], "dir%u/f%u", (unsigned)(i % 17), (unsigned)i);
+        names[i] = g_names[i];
+        datas[i] = contents[i % 4];
+        sizes[i] = strlen(contents[i % 4]);
+    }
+    ASSERT(pas_zip_dedup_size(MANY) <= sizeof(g_storage));
+    len = pas_zip_create_dedup(names, datas, sizes, MANY, 0, NULL, g_storage, sizeof(g_storage),
+                               g_zip, sizeof(g_zip), &st);
+    ASSERT(len > 0);
+    ASSERT(pas_zip_open_ex(&zip, g_zip, len, &st));
+    for (i = 0; i < MANY; i += 7)
+        if (!entry_is(&zip, names[i], datas[i], sizes[i], &f) || f.local_header_offset >= 4 * 64) bad++;
+    ASSERT_EQ(bad, 0u);
+}
+
+static void test_errors(void) {
+    const void *datas[COUNT];
+    size_t sizes[COUNT];
+    pas_zip_status st;
+
+    make_inputs(datas, sizes);
+    ASSERT_EQ(pas_zip_dedup_size(0), 0u);
+    ASSERT_EQ(pas_zip_create_dedup(k_names, datas, sizes, COUNT, 0, NULL, g_storage,
+                                   pas_zip_dedup_size(COUNT) - 1, g_zip, sizeof(g_zip), &st), 0u);
+    ASSERT_EQ(st, PAS_ZIP_E_NOSPACE);
+    ASSERT_EQ(pas_zip_create_dedup(k_names, datas, sizes, COUNT, 0, NULL, NULL, 0, g_zip, sizeof(g_zip), &st), 0u);
+    ASSERT_EQ(st, PAS_ZIP_E_INVALID);
+    ASSERT_EQ(pas_zip_create_dedup(k_names, datas, sizes, COUNT, 0, NULL, g_storage, sizeof(g_storage),
+                                   g_zip, LICENSE_SIZE, &st), 0u);
+    ASSERT_EQ(st, PAS_ZIP_E_NOSPACE);
+}
+
+int main(void) {
+    g_failed = 0;
+    g_assertions = 0;
+    test_dedup(0);
+    test_dedup(6);
+    test_many();
+    test_errors();
+    if (g_failed) {
+        (void)fprintf(stderr, "Total: %d assertions, %d failed\n", g_assertions, g_failed);
+        return 1;
+    }
+    (void)printf("All %d assertions passed.\n", g_assertions);
+    return 0;
+}
@@ -0,0 +1,147 @@
+/*
+    test_eocd.c - Test locating the end of central directory record (archive comments, false
+    signatures, trailing data, the 64 KB search limit).
+    From repo root: gcc -o tests/pas_zip/test_eocd tests/pas_zip/test_eocd.c -I.
+*/
+
+#define PAS_ZIP_IMPLEMENTATION
+#include "pas_zip.h"
+#include <stdio.h>
+#include <string.h>
+
+static int g_failed, g_assertions;
+
+#define ASSERT(cond) do { \
+    ++g_assertions; \
+    if (!(cond)) { (void)fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); ++g_failed; } \
+} while (0)
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+#define BUF_SIZE (200 * 1024)
+
+static unsigned char g_zip[BUF_SIZE];
+static size_t g_base; /* archive size without comment */
+
+static void make_base(void) {
+    const char *names[2] = { "a.txt", "b.txt" };
+    const void *datas[2] = { "alpha", "bravo!" };
+    size_t sizes[2] = { 5, 6 };
+    pas_zip_status st;
+    g_base = pas_zip_create(names, datas, sizes, 2, g_zip, sizeof(g_zip), &st);
+}
+
+/* Give the archive a comment of len bytes filled with fill; returns the new size. */
+static size_t set_comment(size_t len, unsigned char fill) {
+    memset(g_zip + g_base, fill, len);
+    g_zip[g_base - 2] = (unsigned char)(len & 0xFF);
+    g_zip[g_base - 1] = (unsigned char)(len >> 8);
+    return g_base + len;
+}
+
+static int opens(size_t size) {
+    pas_zip_t zip;
+    pas_zip_file_t f;
+    pas_zip_status st;
+    char buf[8];
+    if (!pas_zip_open_ex(&zip, g_zip, size, &st)) return 0;
+    if (zip.num_entries != 2 || !pas_zip_find_ex(&zip, "b.txt", &f)) return 0;
+    return pas_zip_extract(&f, buf, sizeof(buf), &st) == 6 && memcmp(buf, "bravo!", 6) == 0;
+}
+
+static void test_comments(void) {
+    size_t len, bad = 0;
+    ASSERT(g_base > 22);
+    ASSERT(opens(set_comment(0, 0)));
+    for (len = 1; len < 300; len++)
+        if (!opens(set_comment(len, 'x'))) bad++;
+    ASSERT_EQ(bad, 0u);
+    ASSERT(opens(set_comment(4096, 'y')));
+    ASSERT(opens(set_comment(65535, 'z')));
+}
+
+/* Stray signatures in the comment at every offset: their fields cannot describe a valid CD */
+static void test_false_signatures(void) {
+    static const unsigned char sig[4] = { 0x50, 0x4b, 0x05, 0x06 };
+    size_t size, pos, bad = 0;
+
+    for (pos = 0; pos + 4 <= 100; pos++) {
+        size = set_comment(100, 0xFF);
+        memcpy(g_zip + g_base + pos, sig, 4);
+        if (!opens(size)) bad++;
+    }
+    ASSERT_EQ(bad, 0u);
+
+    /* Many signatures back to back, more than one per vector */
+    size = set_comment(200, 0);
+    for (pos = 0; pos + 4 <= 200; pos += 4) memcpy(g_zip + g_base + pos, sig, 4);
+    ASSERT(opens(size));
+
+    /* A copy of the real EOCD in the comment whose comment length runs past the end */
+    size = set_comment(100, 'c');
+    memcpy(g_zip + g_base + 10, g_zip + g_base - 22, 22);
+    g_zip[g_base + 10 + 20] = 0xFF;
+    ASSERT(opens(size));
+
+    /* A copy with a CD offset past its own position */
+    size = set_comment(100, 'c');
+    memcpy(g_zip + g_base + 10, g_zip + g_base - 22, 20);
+    g_zip[g_base + 10 + 20] = g_zip[g_base + 10 + 21] = 0; /* comment fits */
+    g_zip[g_base + 10 + 16] = 0xF0;
+    ASSERT(opens(size));
+
+    /* A copy claiming more entries than its CD size allows */
+    size = set_comment(100, 'c');
+    memcpy(g_zip + g_base + 10, g_zip + g_base - 22, 20);
+    g_zip[g_base + 10 + 20] = g_zip[g_base + 10 + 21] = 0; /* comment fits */
+    g_zip[g_base + 10 + 8] = 200;
+    ASSERT(opens(size));
+}
+
+static void test_limits(void) {
+    pas_zip_t zip;
+    pas_zip_status st;
+    size_t size;
+
+    /* Bytes after the comment are tolerated */
+    size = set_comment(10, 'q');
+    memset(g_zip + size, 'j', 50);
+    ASSERT(opens(size + 50));
+
+    /* Comment length larger than what follows: the only record is rejected */
+    size = set_comment(10, 'q');
+    ASSERT_EQ(pas_zip_open_ex(&zip, g_zip, size - 1, &st), 0);
+    ASSERT_EQ(st, PAS_ZIP_E_INVALID);
+
+    /* Record more than 64 KB + 22 bytes from the end is not searched for */
+    size = set_comment(65535, 'q');
+    memset(g_zip + size, 'j', 1);
+    ASSERT_EQ(pas_zip_open_ex(&zip, g_zip, size + 1, &st), 0);
+
+    /* Empty archive */
+    {
+        unsigned char empty[22] = { 0x50, 0x4b, 0x05, 0x06 };
+        ASSERT(pas_zip_open_ex(&zip, empty, sizeof(empty), &st));
+        ASSERT_EQ(zip.num_entries, 0u);
+        ASSERT_EQ(pas_zip_open_ex(&zip, empty, 21, &st), 0);
+    }
+
+    /* No record at all */
+    memset(g_zip, 'n', 70000);
+    ASSERT_EQ(pas_zip_open_ex(&zip, g_zip, 70000, &st), 0);
+    ASSERT_EQ(pas_zip_open_ex(&zip, g_zip, 40, &st), 0);
+}
+
+int main(void) {
+    g_failed = 0;
+    g_assertions = 0;
+    make_base();
+    test_comments();
+    test_false_signatures();
+    test_limits();
+    if (g_failed) {
+        (void)fprintf(stderr, "Total: %d assertions, %d failed\n", g_assertions, g_failed);
+        return 1;
+    }
+    (void)printf("All %d assertions passed.\n", g_assertions);
+    return 0;
+}
@@ -0,0 +1,105 @@
+/*
+    test_extract_many.c - Test pas_zip_extract_many (batch extraction on worker threads).
+    From repo root: gcc -o tests/pas_zip/test_extract_many tests/pas_zip/test_extract_many.c -I. -lpthread
+*/
+
+#define PAS_ZIP_USE_THREADS
+#define PAS_ZIP_IMPLEMENTATION
+#include "pas_zip.h"
+#include <stdio.h>
+#include <string.h>
+
+static int g_failed, g_assertions;
+
+#define ASSERT(cond) do { \
+    ++g_assertions; \
+    if (!(cond)) { (void)fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); ++g_failed; } \
+} while (0)
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+#define NUM_FILES 300
+#define MAX_SIZE  257
+
+static unsigned char g_zip[NUM_FILES * (MAX_SIZE + 80) + 64];
+static unsigned char g_data[NUM_FILES][MAX_SIZE];
+static unsigned char g_out[NUM_FILES][MAX_SIZE];
+static char g_names[NUM_FILES][16];
+
+static void run(const pas_zip_t *zip, const pas_zip_file_t *entries, int threads) {
+    void *bufs[NUM_FILES];
+    size_t buf_sizes[NUM_FILES];
+    size_t out_sizes[NUM_FILES];
+    pas_zip_status statuses[NUM_FILES];
+    size_t ok;
+    int i;
+
+    memset(g_out, 0, sizeof(g_out));
+    for (i = 0; i < NUM_FILES; i++) {
+        bufs[i] = g_out[i];
+        buf_sizes[i] = sizeof(g_out[i]);
+        statuses[i] = 123;
+    }
+    /* Entry 7 gets a buffer that is too small */
+    buf_sizes[7] = 0;
+
+    ok = pas_zip_extract_many(zip, entries, bufs, buf_sizes, out_sizes, statuses, NUM_FILES, threads);
+    ASSERT_EQ(ok, (size_t)(NUM_FILES - 1));
+    for (i = 0; i < NUM_FILES; i++) {
+        size_t expect = (size_t)((i * 37) % MAX_SIZE);
+        if (i == 7) {
+            ASSERT(statuses[i] == PAS_ZIP_E_NOSPACE || expect == 0);
+            continue;
+        }
+        ASSERT(statuses[i] == PAS_ZIP_OK);
+        ASSERT_EQ(out_sizes[i], expect);
+        ASSERT(memcmp(g_out[i], g_data[i], expect) == 0);
+    }
+}
+
+int main(void) {
+    const char *names[NUM_FILES];
+    const void *datas[NUM_FILES];
+    size_t sizes[NUM_FILES];
+    pas_zip_file_t entries[NUM_FILES];
+    pas_zip_t zip;
+    pas_zip_status status;
+    size_t written;
+    int i, j;
+
+    g_failed = 0;
+    g_assertions = 0;
+
+    for (i = 0; i < NUM_FILES; i++) {
+        (void)sprintf(g_names[i], "e%d.bin", i);
+        sizes[i] = (size_t)((i * 37) % MAX_SIZE);
+        for (j = 0; j < MAX_SIZE; j++) g_data[i][j] = (unsigned char)(i * 7 + j);
+        names[i] = g_names[i];
+        datas[i] = g_data[i];
+    }
+    written = pas_zip_create(names, datas, sizes, NUM_FILES, g_zip, sizeof(g_zip), &status);
+    ASSERT(status == PAS_ZIP_OK);
+    ASSERT_EQ(pas_zip_open_ex(&zip, g_zip, written, &status), 1);
+    for (i = 0; i < NUM_FILES; i++)
+        ASSERT_EQ(pas_zip_find_ex(&zip, g_names[i], &entries[i]), 1);
+
+    run(&zip, entries, 1);
+    run(&zip, entries, 4);
+    run(&zip, entries, 1000); /* clamped to PAS_ZIP_MAX_THREADS */
+
+    /* Entry from another archive is rejected */
+    {
+        pas_zip_t other = zip;
+        void *buf = g_out[0];
+        size_t buf_size = sizeof(g_out[0]);
+        pas_zip_status st = PAS_ZIP_OK;
+        ASSERT_EQ(pas_zip_extract_many(&other, entries, &buf, &buf_size, NULL, &st, 1, 2), 0u);
+        ASSERT(st == PAS_ZIP_E_INVALID);
+    }
+
+    if (g_failed) {
+        (void)fprintf(stderr, "Total: %d assertions, %d failed\n", g_assertions, g_failed);
+        return 1;
+    }
+    (void)printf("All %d assertions passed.\n", g_assertions);
+    return 0;
+}
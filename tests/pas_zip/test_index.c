@@ -0,0 +1,82 @@
+/*
+    test_index.c - Test pas_zip_index_build / pas_zip_find_indexed.
+    From repo root: gcc -o tests/pas_zip/test_index tests/pas_zip/test_index.c -I.
+*/
+
+#define PAS_ZIP_IMPLEMENTATION
+#include "pas_zip.h"
+#include <stdio.h>
+#include <string.h>
+
+static int g_failed, g_assertions;
+
+#define ASSERT(cond) do { \
+    ++g_assertions; \
+    if (!(cond)) { (void)fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); ++g_failed; } \
+} while (0)
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+#define NUM_FILES 200
+
+int main(void) {
+    static unsigned char zip_buf[32768];
+    static char names[NUM_FILES][16];
+    const char *name_ptrs[NUM_FILES];
+    const void *datas[NUM_FILES];
+    size_t sizes[NUM_FILES];
+    uint32_t index_buf[1024];
+    size_t written;
+    pas_zip_status status;
+    pas_zip_t *zip;
+    pas_zip_file_t *file;
+    int i;
+
+    g_failed = 0;
+    g_assertions = 0;
+
+    for (i = 0; i < NUM_FILES; i++) {
+        (void)sprintf(names[i], "dir/f%03d.txt", i);
+        name_ptrs[i] = names[i];
+        datas[i] = names[i];
+        sizes[i] = (size_t)(i % 13);
+    }
+    written = pas_zip_create(name_ptrs, datas, sizes, NUM_FILES, zip_buf, sizeof(zip_buf), &status);
+    ASSERT(status == PAS_ZIP_OK);
+    ASSERT(written > 0);
+
+    zip = pas_zip_open(zip_buf, written, &status);
+    ASSERT(zip != NULL);
+
+    /* No index yet */
+    ASSERT(pas_zip_find_indexed(zip, "dir/f000.txt") == NULL);
+
+    ASSERT(pas_zip_index_size(zip) <= sizeof(index_buf));
+    ASSERT_EQ(pas_zip_index_build(zip, index_buf, 16, &status), -1);
+    ASSERT(status == PAS_ZIP_E_NOSPACE);
+    ASSERT_EQ(pas_zip_index_build(zip, index_buf, sizeof(index_buf), &status), 0);
+    ASSERT(status == PAS_ZIP_OK);
+
+    for (i = 0; i < NUM_FILES; i++) {
+        file = pas_zip_find_indexed(zip, names[i]);
+        ASSERT(file != NULL);
+        if (!file) continue;
+        ASSERT(strcmp(pas_zip_name(file), names[i]) == 0);
+        ASSERT_EQ(pas_zip_size(file), (size_t)(i % 13));
+    }
+
+    ASSERT(pas_zip_find_indexed(zip, "dir/f200.txt") == NULL);
+    ASSERT(pas_zip_find_indexed(zip, "dir/f00") == NULL);
+    ASSERT(pas_zip_find_indexed(zip, "") == NULL);
+
+    /* pas_zip_find goes through the index once it exists */
+    file = pas_zip_find(zip, "dir/f123.txt");
+    ASSERT(file != NULL);
+    ASSERT_EQ(pas_zip_size(file), (size_t)(123 % 13));
+
+    if (g_failed) {
+        (void)fprintf(stderr, "Total: %d assertions, %d failed\n", g_assertions, g_failed);
+        return 1;
+    }
+    (void)printf("All %d assertions passed.\n", g_assertions);
+    return 0;
+}
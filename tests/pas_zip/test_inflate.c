@@ -0,0 +1,185 @@
+/*
+    test_inflate.c - Test the built-in Deflate decoder (pas_zip_inflate, pas_zip_extract).
+    From repo root: gcc -o tests/pas_zip/test_inflate tests/pas_zip/test_inflate.c -I.
+*/
+
+#define PAS_ZIP_IMPLEMENTATION
+#include "pas_zip.h"
+#include <stdio.h>
+#include <string.h>
+
+static int g_failed, g_assertions;
+
+#define ASSERT(cond) do { \
+    ++g_assertions; \
+    if (!(cond)) { (void)fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); ++g_failed; } \
+} while (0)
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+/* Raw Deflate streams produced by zlib (fixed Huffman, stored, dynamic Huffman). */
+static const unsigned char fixed_stream[19] = {
+    0xf3, 0x48, 0xcd, 0xc9, 0xc9, 0xd7, 0x51, 0xf0, 0x40, 0xa1, 0x5c, 0x52,
+    0xd3, 0x72, 0x12, 0x4b, 0x52, 0x15, 0x01,
+};
+static const unsigned char stored_stream[22] = {
+    0x01, 0x11, 0x00, 0xee, 0xff, 0x73, 0x74, 0x6f, 0x72, 0x65, 0x64, 0x20,
+    0x62, 0x6c, 0x6f, 0x63, 0x6b, 0x20, 0x64, 0x61, 0x74, 0x61,
+};
+static const unsigned char dynamic_stream[95] = {
+    0xed, 0xd1, 0xcb, 0x09, 0x80, 0x30, 0x10, 0x45, 0xd1, 0xbd, 0x55, 0x4c,
+    0x09, 0x8e, 0x7f, 0x2d, 0x47, 0x89, 0x18, 0x0c, 0x09, 0x8a, 0xa2, 0xe5,
+    0x8b, 0x0d, 0xdc, 0x7d, 0x60, 0xd6, 0x67, 0xf5, 0xee, 0x0b, 0x3e, 0x3a,
+    0x29, 0x27, 0xb9, 0x36, 0x27, 0xc7, 0xed, 0x97, 0x5d, 0xe6, 0x33, 0x3d,
+    0x51, 0xd6, 0xf4, 0x16, 0xe1, 0x37, 0x05, 0xab, 0xc0, 0x6a, 0xb0, 0x06,
+    0xac, 0x05, 0xeb, 0xc0, 0x7a, 0xb0, 0x01, 0x6c, 0xa4, 0xed, 0x18, 0x86,
+    0xca, 0x28, 0xa5, 0x51, 0x6a, 0xa3, 0x14, 0x47, 0xa9, 0x8e, 0x52, 0x1e,
+    0xbb, 0xd8, 0x2e, 0xb6, 0x8b, 0xed, 0xe2, 0x2c, 0x2f, 0xfe, 0x00,
+};
+
+static pas_zip_inflate_t g_state;
+
+static size_t make_text(char *buf) {
+    size_t n = 0;
+    int i;
+    for (i = 0; i < 60; i++)
+        n += (size_t)sprintf(buf + n, "line %d: the quick brown fox\n", i % 17);
+    return n;
+}
+
+static void test_streams(void) {
+    char out[2048], text[2048];
+    size_t n, text_len = make_text(text);
+    pas_zip_status status;
+
+    n = pas_zip_inflate(&g_state, fixed_stream, sizeof(fixed_stream), out, sizeof(out), &status);
+    ASSERT(status == PAS_ZIP_OK);
+    ASSERT_EQ(n, 29u);
+    ASSERT(memcmp(out, "Hello, Hello, Hello, Deflate!", 29) == 0);
+
+    n = pas_zip_inflate(&g_state, stored_stream, sizeof(stored_stream), out, sizeof(out), &status);
+    ASSERT(status == PAS_ZIP_OK);
+    ASSERT_EQ(n, 17u);
+    ASSERT(memcmp(out, "stored block data", 17) == 0);
+
+    n = pas_zip_inflate(&g_state, dynamic_stream, sizeof(dynamic_stream), out, sizeof(out), &status);
+    ASSERT(status == PAS_ZIP_OK);
+    ASSERT_EQ(n, text_len);
+    ASSERT(memcmp(out, text, text_len) == 0);
+
+    /* Exact-size output is enough */
+    n = pas_zip_inflate(&g_state, dynamic_stream, sizeof(dynamic_stream), out, text_len, &status);
+    ASSERT(status == PAS_ZIP_OK);
+    ASSERT_EQ(n, text_len);
+}
+
+/* The shared fixed-code tables match the per-state fallback, and fixed blocks decode from them */
+static void test_fixed_tables(void) {
+    char out[64];
+    pas_zip_status st;
+    size_t n;
+
+    ASSERT(inflate_fixed_shared());
+    ASSERT(inflate_fixed_tables(&g_state));
+    ASSERT_EQ(g_state.fixed_tables, PAS_ZIP_FIXED_OWN);
+    ASSERT(memcmp(g_state.litlen, pas_zip__fixed_litlen, sizeof(pas_zip__fixed_litlen)) == 0);
+    ASSERT(memcmp(g_state.dist, pas_zip__fixed_dist, sizeof(pas_zip__fixed_dist)) == 0);
+
+    n = pas_zip_inflate(&g_state, fixed_stream, sizeof(fixed_stream), out, sizeof(out), &st);
+    ASSERT_EQ(st, PAS_ZIP_OK);
+    ASSERT_EQ(g_state.fixed_tables, PAS_ZIP_FIXED_SHARED);
+    ASSERT(n > 0);
+}
+
+static void test_errors(void) {
+    unsigned char bad[sizeof(dynamic_stream)];
+    char out[2048];
+    size_t n;
+    pas_zip_status status;
+
+    n = pas_zip_inflate(&g_state, dynamic_stream, sizeof(dynamic_stream), out, 100, &status);
+    ASSERT(status == PAS_ZIP_E_NOSPACE);
+    ASSERT_EQ(n, 100u);
+
+    (void)pas_zip_inflate(&g_state, dynamic_stream, sizeof(dynamic_stream) - 10, out, sizeof(out), &status);
+    ASSERT(status == PAS_ZIP_E_ZLIB);
+
+    (void)pas_zip_inflate(&g_state, stored_stream, 10, out, sizeof(out), &status);
+    ASSERT(status == PAS_ZIP_E_ZLIB);
+
+    /* Block type 3 is reserved */
+    bad[0] = 0x07;
+    (void)pas_zip_inflate(&g_state, bad, 1, out, sizeof(out), &status);
+    ASSERT(status == PAS_ZIP_E_ZLIB);
+
+    /* Stored block with a broken NLEN */
+    memcpy(bad, stored_stream, sizeof(stored_stream));
+    bad[3] ^= 1;
+    (void)pas_zip_inflate(&g_state, bad, sizeof(stored_stream), out, sizeof(out), &status);
+    ASSERT(status == PAS_ZIP_E_ZLIB);
+}
+
+/* ZIP with one Deflate entry "d.txt" holding dynamic_stream, extracted through pas_zip_extract. */
+static void test_extract(void) {
+    unsigned char zip[512];
+    char out[2048], text[2048];
+    size_t w = 0, n, text_len = make_text(text);
+    uint32_t comp = (uint32_t)sizeof(dynamic_stream), unc = (uint32_t)text_len, cd_off, cd_size = 46 + 5;
+    pas_zip_t arch;
+    pas_zip_file_t file;
+    pas_zip_status status;
+    int i;
+
+    zip[w++] = 0x50; zip[w++] = 0x4b; zip[w++] = 0x03; zip[w++] = 0x04;
+    zip[w++] = 20; zip[w++] = 0; zip[w++] = 0; zip[w++] = 0;
+    zip[w++] = 8; zip[w++] = 0;
+    for (i = 0; i < 8; i++) zip[w++] = 0;
+    for (i = 0; i < 4; i++) zip[w++] = (uint8_t)(comp >> (8 * i));
+    for (i = 0; i < 4; i++) zip[w++] = (uint8_t)(unc >> (8 * i));
+    zip[w++] = 5; zip[w++] = 0; zip[w++] = 0; zip[w++] = 0;
+    memcpy(zip + w, "d.txt", 5); w += 5;
+    memcpy(zip + w, dynamic_stream, comp); w += comp;
+    cd_off = (uint32_t)w;
+    zip[w++] = 0x50; zip[w++] = 0x4b; zip[w++] = 0x01; zip[w++] = 0x02;
+    zip[w++] = 20; zip[w++] = 0; zip[w++] = 20; zip[w++] = 0;
+    zip[w++] = 0; zip[w++] = 0; zip[w++] = 8; zip[w++] = 0;
+    for (i = 0; i < 8; i++) zip[w++] = 0;
+    for (i = 0; i < 4; i++) zip[w++] = (uint8_t)(comp >> (8 * i));
+    for (i = 0; i < 4; i++) zip[w++] = (uint8_t)(unc >> (8 * i));
+    zip[w++] = 5; zip[w++] = 0;
+    for (i = 0; i < 16; i++) zip[w++] = 0; /* extra, comment, disk, attrs, local header offset 0 */
+    memcpy(zip + w, "d.txt", 5); w += 5;
+    zip[w++] = 0x50; zip[w++] = 0x4b; zip[w++] = 0x05; zip[w++] = 0x06;
+    for (i = 0; i < 4; i++) zip[w++] = 0;
+    zip[w++] = 1; zip[w++] = 0; zip[w++] = 1; zip[w++] = 0;
+    for (i = 0; i < 4; i++) zip[w++] = (uint8_t)(cd_size >> (8 * i));
+    for (i = 0; i < 4; i++) zip[w++] = (uint8_t)(cd_off >> (8 * i));
+    zip[w++] = 0; zip[w++] = 0;
+
+    ASSERT_EQ(pas_zip_open_ex(&arch, zip, w, &status), 1);
+    ASSERT_EQ(pas_zip_find_ex(&arch, "d.txt", &file), 1);
+    ASSERT(pas_zip_is_compressed(&file));
+
+    n = pas_zip_extract(&file, out, sizeof(out), &status);
+    ASSERT(status == PAS_ZIP_OK);
+    ASSERT_EQ(n, text_len);
+    ASSERT(memcmp(out, text, text_len) == 0);
+
+    n = pas_zip_extract(&file, out, 10, &status);
+    ASSERT(status == PAS_ZIP_E_NOSPACE);
+    ASSERT_EQ(n, 0u);
+}
+
+int main(void) {
+    g_failed = 0;
+    g_assertions = 0;
+    test_streams();
+    test_fixed_tables();
+    test_errors();
+    test_extract();
+    if (g_failed) {
+        (void)fprintf(stderr, "Total: %d assertions, %d failed\n", g_assertions, g_failed);
+        return 1;
+    }
+    (void)printf("All %d assertions passed.\n", g_assertions);
+    return 0;
+}
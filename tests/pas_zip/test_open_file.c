@@ -0,0 +1,102 @@
+/*
+    test_open_file.c - Test pas_zip_open_file / pas_zip_close_file (memory-mapped archive).
+    From repo root: gcc -o tests/pas_zip/test_open_file tests/pas_zip/test_open_file.c -I.
+*/
+
+#define PAS_ZIP_IMPLEMENTATION
+#define PAS_ZIP_USE_MMAP
+#include "pas_zip.h"
+#include <stdio.h>
+#include <string.h>
+
+static int g_failed, g_assertions;
+
+#define ASSERT(cond) do { \
+    ++g_assertions; \
+    if (!(cond)) { (void)fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); ++g_failed; } \
+} while (0)
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+#define TMP_PATH "test_open_file.tmp.zip"
+
+static int write_file(const char *path, const void *data, size_t size) {
+    FILE *f = fopen(path, "wb");
+    int ok;
+    if (!f) return 0;
+    ok = fwrite(data, 1, size, f) == size;
+    return fclose(f) == 0 && ok;
+}
+
+static pas_zip_reader_t g_reader;
+
+int main(void) {
+    unsigned char zip_buf[1024];
+    size_t written, n;
+    pas_zip_status status;
+    pas_zip_t zip;
+    pas_zip_file_t file;
+    char out[64];
+
+    g_failed = 0;
+    g_assertions = 0;
+
+    written = pas_zip_create(
+        (const char *[]){ "a.txt", "b.txt" },
+        (const void *[]){ "Hello, ZIP!", "mapped" },
+        (size_t[]){ 11, 6 },
+        2, zip_buf, sizeof(zip_buf), &status
+    );
+    ASSERT(status == PAS_ZIP_OK);
+    ASSERT(write_file(TMP_PATH, zip_buf, written));
+
+    ASSERT_EQ(pas_zip_open_file(&zip, TMP_PATH, &status), 1);
+    ASSERT(status == PAS_ZIP_OK);
+    ASSERT(zip.mapped);
+    ASSERT_EQ(zip.size, written);
+    ASSERT_EQ(zip.num_entries, 2u);
+
+    ASSERT_EQ(pas_zip_find_ex(&zip, "a.txt", &file), 1);
+    n = pas_zip_extract(&file, out, sizeof(out), &status);
+    ASSERT(status == PAS_ZIP_OK);
+    ASSERT_EQ(n, 11u);
+    ASSERT(memcmp(out, "Hello, ZIP!", 11) == 0);
+
+    ASSERT_EQ(pas_zip_find_ex(&zip, "b.txt", &file), 1);
+    ASSERT_EQ(pas_zip_reader_init(&g_reader, &file, &status), 1);
+    n = pas_zip_reader_read(&g_reader, out, sizeof(out), &status);
+    ASSERT_EQ(n, 6u);
+    ASSERT(memcmp(out, "mapped", 6) == 0);
+    pas_zip_reader_close(&g_reader);
+
+    pas_zip_close_file(&zip);
+    ASSERT(zip.data == NULL);
+    ASSERT(!zip.mapped);
+    pas_zip_close_file(&zip); /* no-op */
+
+    /* Opened from memory: close_file leaves it alone */
+    ASSERT_EQ(pas_zip_open_ex(&zip, zip_buf, written, &status), 1);
+    ASSERT(!zip.mapped);
+    pas_zip_close_file(&zip);
+    ASSERT(zip.data == zip_buf);
+
+    /* Not a ZIP */
+    ASSERT(write_file(TMP_PATH, "this is definitely not a zip archive", 36));
+    ASSERT_EQ(pas_zip_open_file(&zip, TMP_PATH, &status), 0);
+    ASSERT(status == PAS_ZIP_E_INVALID);
+
+    /* Too small to hold an end record */
+    ASSERT(write_file(TMP_PATH, "PK", 2));
+    ASSERT_EQ(pas_zip_open_file(&zip, TMP_PATH, &status), 0);
+    ASSERT(status == PAS_ZIP_E_IO);
+    (void)remove(TMP_PATH);
+
+    ASSERT_EQ(pas_zip_open_file(&zip, "does/not/exist.zip", &status), 0);
+    ASSERT(status == PAS_ZIP_E_IO);
+
+    if (g_failed) {
+        (void)fprintf(stderr, "Total: %d assertions, %d failed\n", g_assertions, g_failed);
+        return 1;
+    }
+    (void)printf("All %d assertions passed.\n", g_assertions);
+    return 0;
+}
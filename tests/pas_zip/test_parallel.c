@@ -0,0 +1,170 @@
+/*
+    test_parallel.c - Test parallel Deflate in the writer (pas_zip_writer_add_chunk_parallel) and
+    pas_zip_crc32_combine.
+    From repo root: gcc -o tests/pas_zip/test_parallel tests/pas_zip/test_parallel.c -I. -lpthread
+*/
+
+#define PAS_ZIP_USE_THREADS
+#define PAS_ZIP_IMPLEMENTATION
+#include "pas_zip.h"
+#include <stdio.h>
+#include <string.h>
+
+static int g_failed, g_assertions;
+
+#define ASSERT(cond) do { \
+    ++g_assertions; \
+    if (!(cond)) { (void)fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); ++g_failed; } \
+} while (0)
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+#define TEXT_SIZE (2 * 1024 * 1024 + 12345)
+#define BLOCK (256 * 1024)
+#define THREADS 4
+
+static pas_zip_writer_t g_writer;
+static pas_zip_deflate_t g_deflate;
+static pas_zip_writer_entry_t g_entries[8];
+static unsigned char g_zip[2 * TEXT_SIZE];
+static unsigned char g_scratch[THREADS * (sizeof(pas_zip_deflate_t) + BLOCK + BLOCK / 512 + 256)];
+static char g_text[TEXT_SIZE];
+static char g_out[TEXT_SIZE];
+
+static void make_text(void) {
+    size_t n = 0;
+    uint32_t x = 5;
+    while (n < TEXT_SIZE - 100) {
+        x = x * 1103515245u + 12345u;
+        n += (size_t)sprintf(g_text + n, "item %u: %s=%u\n", x >> 20, (x & 64) ? "width" : "height", x & 0xFFF);
+    }
+    memset(g_text + n, '-', TEXT_SIZE - n);
+}
+
+/* Extracted data and stored CRC of an entry match g_text[0..size) */
+static int entry_ok(const pas_zip_t *zip, const char *name, size_t size) {
+    pas_zip_file_t f;
+    pas_zip_status st;
+    if (!pas_zip_find_ex(zip, name, &f) || f.compression_method != PAS_ZIP_METHOD_DEFLATE) return 0;
+    if (f.crc32 != pas_zip_crc32(0, g_text, size)) return 0;
+    return pas_zip_extract(&f, g_out, sizeof(g_out), &st) == size && memcmp(g_out, g_text, size) == 0;
+}
+
+static void test_combine(void) {
+    static const size_t splits[] = { 0, 1, 3, 16, 1000, 65536, TEXT_SIZE };
+    uint32_t whole = pas_zip_crc32(0, g_text, TEXT_SIZE);
+    size_t i;
+    for (i = 0; i < sizeof(splits) / sizeof(splits[0]); i++) {
+        size_t k = splits[i];
+        uint32_t a = pas_zip_crc32(0, g_text, k), b = pas_zip_crc32(0, g_text + k, TEXT_SIZE - k);
+        ASSERT_EQ(pas_zip_crc32_combine(a, b, TEXT_SIZE - k), whole);
+    }
+    ASSERT_EQ(pas_zip_crc32_combine(0x12345678u, 0, 0), 0x12345678u);
+}
+
+static void test_entries(void) {
+    pas_zip_status st;
+    pas_zip_t zip;
+    size_t size, need, serial_size, off;
+
+    need = pas_zip_writer_parallel_size(THREADS, BLOCK);
+    ASSERT(need > 0 && need <= sizeof(g_scratch));
+    ASSERT(pas_zip_writer_parallel_size(1, 0) > PAS_ZIP_PARALLEL_BLOCK);
+
+    ASSERT(pas_zip_writer_begin(&g_writer, g_zip, sizeof(g_zip), g_entries, 8, &g_deflate, &st));
+    /* Whole entry in one parallel call */
+    ASSERT(pas_zip_writer_add_entry(&g_writer, "a.txt", 6, &st));
+    ASSERT(pas_zip_writer_add_chunk_parallel(&g_writer, g_text, TEXT_SIZE, THREADS, BLOCK, g_scratch, need, &st));
+    ASSERT_EQ(st, PAS_ZIP_OK);
+    /* Serial, parallel and serial again: the stream is byte-aligned between the parts */
+    ASSERT(pas_zip_writer_add_entry(&g_writer, "b.txt", 1, &st));
+    ASSERT(pas_zip_writer_add_chunk(&g_writer, g_text, 1001, &st));
+    ASSERT(pas_zip_writer_add_chunk_parallel(&g_writer, g_text + 1001, 1500000, THREADS, BLOCK, g_scratch, need, &st));
+    ASSERT(pas_zip_writer_add_chunk(&g_writer, g_text + 1501001, TEXT_SIZE - 1501001, &st));
+    /* Small parallel calls: fewer blocks than threads, history kept across calls */
+    ASSERT(pas_zip_writer_add_entry(&g_writer, "c.txt", 9, &st));
+    ASSERT(pas_zip_writer_add_chunk_parallel(&g_writer, g_text, 10, THREADS, BLOCK, g_scratch, need, &st));
+    ASSERT(pas_zip_writer_add_chunk_parallel(&g_writer, g_text + 10, 300000, THREADS, BLOCK, g_scratch, need, &st));
+    ASSERT(pas_zip_writer_add_chunk(&g_writer, g_text + 300010, 50000, &st));
+    ASSERT(pas_zip_writer_add_chunk_parallel(&g_writer, g_text + 350010, 0, THREADS, BLOCK, g_scratch, need, &st));
+    /* Store entries are copied */
+    ASSERT(pas_zip_writer_add_entry(&g_writer, "d.txt", 0, &st));
+    ASSERT(pas_zip_writer_add_chunk_parallel(&g_writer, g_text, 5000, THREADS, BLOCK, NULL, 0, &st));
+    size = pas_zip_writer_finish(&g_writer, &st);
+    ASSERT(size > 0);
+
+    ASSERT(g_entries[0].compressed_size < TEXT_SIZE / 3);
+    ASSERT_EQ(g_entries[0].uncompressed_size, (uint64_t)TEXT_SIZE);
+    ASSERT_EQ(g_entries[3].method, PAS_ZIP_METHOD_STORE);
+    ASSERT(pas_zip_open_ex(&zip, g_zip, size, &st));
+    zip.verify_crc = 1;
+    ASSERT(entry_ok(&zip, "a.txt", TEXT_SIZE));
+    ASSERT(entry_ok(&zip, "b.txt", TEXT_SIZE));
+    ASSERT(entry_ok(&zip, "c.txt", 350010));
+
+    /* The dictionary keeps the ratio close to the single-threaded writer */
+    ASSERT(pas_zip_writer_begin(&g_writer, g_zip, sizeof(g_zip), g_entries, 8, &g_deflate, &st));
+    ASSERT(pas_zip_writer_add_entry(&g_writer, "a.txt", 6, &st));
+    ASSERT(pas_zip_writer_add_chunk(&g_writer, g_text, TEXT_SIZE, &st));
+    ASSERT(pas_zip_writer_finish(&g_writer, &st) > 0);
+    serial_size = (size_t)g_entries[0].compressed_size;
+    ASSERT(pas_zip_writer_begin(&g_writer, g_zip, sizeof(g_zip), g_entries, 8, &g_deflate, &st));
+    ASSERT(pas_zip_writer_add_entry(&g_writer, "a.txt", 6, &st));
+    ASSERT(pas_zip_writer_add_chunk_parallel(&g_writer, g_text, TEXT_SIZE, THREADS, BLOCK, g_scratch, need, &st));
+    ASSERT(pas_zip_writer_finish(&g_writer, &st) > 0);
+    ASSERT(g_entries[0].compressed_size < serial_size + serial_size / 50);
+
+    /* Many small calls: each call's first block continues from the history before it */
+    ASSERT(pas_zip_writer_begin(&g_writer, g_zip, sizeof(g_zip), g_entries, 8, &g_deflate, &st));
+    ASSERT(pas_zip_writer_add_entry(&g_writer, "a.txt", 6, &st));
+    for (off = 0; off < TEXT_SIZE; off += 40000) {
+        size_t n = TEXT_SIZE - off < 40000 ? TEXT_SIZE - off : 40000;
+        ASSERT(pas_zip_writer_add_chunk_parallel(&g_writer, g_text + off, n, THREADS, BLOCK, g_scratch, need, &st));
+    }
+    size = pas_zip_writer_finish(&g_writer, &st);
+    ASSERT(g_entries[0].compressed_size < serial_size + serial_size / 50);
+    ASSERT(pas_zip_open_ex(&zip, g_zip, size, &st));
+    ASSERT(entry_ok(&zip, "a.txt", TEXT_SIZE));
+
+    /* Block size not a multiple of the writer piece, one thread */
+    ASSERT(pas_zip_writer_begin(&g_writer, g_zip, sizeof(g_zip), g_entries, 8, &g_deflate, &st));
+    ASSERT(pas_zip_writer_add_entry(&g_writer, "a.txt", 4, &st));
+    ASSERT(pas_zip_writer_add_chunk_parallel(&g_writer, g_text, TEXT_SIZE, 1, 100003, g_scratch,
+                                             pas_zip_writer_parallel_size(1, 100003), &st));
+    size = pas_zip_writer_finish(&g_writer, &st);
+    ASSERT(pas_zip_open_ex(&zip, g_zip, size, &st));
+    ASSERT(entry_ok(&zip, "a.txt", TEXT_SIZE));
+}
+
+static void test_errors(void) {
+    pas_zip_status st;
+    size_t need = pas_zip_writer_parallel_size(THREADS, BLOCK);
+
+    ASSERT(pas_zip_writer_begin(&g_writer, g_zip, sizeof(g_zip), g_entries, 8, &g_deflate, &st));
+    ASSERT_EQ(pas_zip_writer_add_chunk_parallel(&g_writer, g_text, 100, THREADS, BLOCK, g_scratch, need, &st), 0);
+    ASSERT(pas_zip_writer_add_entry(&g_writer, "a.txt", 6, &st));
+    ASSERT_EQ(pas_zip_writer_add_chunk_parallel(&g_writer, g_text, 100, THREADS, BLOCK, g_scratch, need - 1, &st), 0);
+    ASSERT_EQ(st, PAS_ZIP_E_NOSPACE);
+    ASSERT(pas_zip_writer_add_chunk(&g_writer, g_text, 100, &st)); /* scratch errors are not sticky */
+
+    /* Archive buffer too small: sticky */
+    ASSERT(pas_zip_writer_begin(&g_writer, g_zip, 100000, g_entries, 8, &g_deflate, &st));
+    ASSERT(pas_zip_writer_add_entry(&g_writer, "a.txt", 6, &st));
+    ASSERT_EQ(pas_zip_writer_add_chunk_parallel(&g_writer, g_text, TEXT_SIZE, THREADS, BLOCK, g_scratch, need, &st), 0);
+    ASSERT_EQ(st, PAS_ZIP_E_NOSPACE);
+    ASSERT_EQ(pas_zip_writer_finish(&g_writer, &st), 0u);
+}
+
+int main(void) {
+    g_failed = 0;
+    g_assertions = 0;
+    make_text();
+    test_combine();
+    test_entries();
+    test_errors();
+    if (g_failed) {
+        (void)fprintf(stderr, "Total: %d assertions, %d failed\n", g_assertions, g_failed);
+        return 1;
+    }
+    (void)printf("All %d assertions passed.\n", g_assertions);
+    return 0;
+}
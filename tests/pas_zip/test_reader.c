@@ -0,0 +1,328 @@
+/*
+    test_reader.c - Test the streaming entry reader (pas_zip_reader_init/read/close).
+    From repo root: gcc -o tests/pas_zip/test_reader tests/pas_zip/test_reader.c -I.
+*/
+
+#define PAS_ZIP_IMPLEMENTATION
+#include "pas_zip.h"
+#include <stdio.h>
+#include <string.h>
+
+static int g_failed, g_assertions;
+
+#define ASSERT(cond) do { \
+    ++g_assertions; \
+    if (!(cond)) { (void)fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); ++g_failed; } \
+} while (0)
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+#define TEXT_REPEAT 200
+
+/* zlib raw Deflate (level 9) of make_text() repeated TEXT_REPEAT times: 340200 bytes, so the
+   reader's window slides many times and matches reach back across the slide. */
+static const unsigned char big_stream[1766] = {
+    0xed, 0xd5, 0xcd, 0x09, 0xc2, 0x40, 0x14, 0x85, 0xd1, 0xbd, 0x55, 0x4c,
+    0x09, 0x3e, 0xff, 0xb5, 0x1c, 0x25, 0x62, 0x30, 0x24, 0x28, 0x8a, 0x96,
+    0x2f, 0x36, 0x70, 0xf7, 0xe2, 0x59, 0xcf, 0xea, 0xcd, 0xf9, 0xe0, 0x0e,
+    0xfd, 0xd8, 0xb5, 0xf9, 0xa1, 0x3d, 0x2e, 0x5d, 0xbb, 0x3d, 0xfb, 0xd3,
+    0xb5, 0x1d, 0xef, 0xd3, 0x6b, 0x6c, 0xe7, 0xe9, 0x3d, 0x1b, 0xbe, 0x6f,
+    0x15, 0xde, 0x16, 0xe1, 0x6d, 0x19, 0xde, 0x56, 0xe1, 0x6d, 0x1d, 0xde,
+    0x36, 0xe1, 0x6d, 0x1b, 0xde, 0x76, 0xe1, 0x6d, 0x9f, 0x6e, 0x8f, 0x1f,
+    0x93, 0x7e, 0xa6, 0xd2, 0xd7, 0x54, 0xfa, 0x9b, 0x4a, 0x9f, 0x53, 0xe9,
+    0x77, 0x2a, 0x7d, 0x0f, 0x62, 0xc4, 0x88, 0x11, 0xff, 0x2e, 0xb1, 0xbc,
+    0xe5, 0x8d, 0x18, 0x31, 0x62, 0xc4, 0x46, 0x4a, 0xde, 0xf2, 0x46, 0x8c,
+    0x18, 0x31, 0x62, 0x23, 0x25, 0x6f, 0xc4, 0x88, 0x11, 0x23, 0x36, 0x52,
+    0xf2, 0x96, 0x37, 0x62, 0xc4, 0x88, 0x11, 0x1b, 0x29, 0x79, 0xcb, 0x1b,
+    0x31, 0x62, 0xc4, 0x46, 0x4a, 0xde, 0xf2, 0x46, 0x8c, 0x18, 0x31, 0x62,
+    0x23, 0x25, 0x6f, 0x79, 0x23, 0x46, 0x8c, 0x18, 0xb1, 0x91, 0x92, 0x37,
+    0x62, 0xc4, 0x88, 0x11, 0x1b, 0x29, 0x79, 0xcb, 0x1b, 0x31, 0x62, 0xc4,
+    0x88, 0x8d, 0x94, 0xbc, 0xe5, 0x8d, 0x18, 0x31, 0x62, 0x23, 0x25, 0x6f,
+    0x79, 0x23, 0x46, 0x8c, 0x18, 0xb1, 0x91, 0x92, 0xb7, 0xbc, 0x11, 0x23,
+    0x46, 0x8c, 0xd8, 0x48, 0xc9, 0x1b, 0x31, 0x62, 0xc4, 0x88, 0x8d, 0x94,
+    0xbc, 0xe5, 0x8d, 0x18, 0x31, 0x62, 0xc4, 0x46, 0x4a, 0xde, 0xf2, 0x46,
+    0x8c, 0x18, 0xb1, 0x91, 0x92, 0xb7, 0xbc, 0x11, 0x23, 0x46, 0x8c, 0xd8,
+    0x48, 0xc9, 0x5b, 0xde, 0x88, 0x11, 0x23, 0x46, 0xec, 0x76, 0x79, 0x23,
+    0x46, 0x8c, 0x18, 0xb1, 0x91, 0x92, 0xb7, 0xbc, 0x11, 0x23, 0x46, 0x8c,
+    0xd8, 0x48, 0xc9, 0x5b, 0xde, 0x88, 0x11, 0x23, 0x36, 0x52, 0xf2, 0x96,
+    0x37, 0x62, 0xc4, 0x88, 0x11, 0x1b, 0x29, 0x79, 0xcb, 0x1b, 0x31, 0x62,
+    0xc4, 0x88, 0xdd, 0x2e, 0x6f, 0xc4, 0x88, 0x11, 0x23, 0x36, 0x52, 0xf2,
+    0x96, 0x37, 0x62, 0xc4, 0x88, 0x11, 0x1b, 0x29, 0x79, 0x23, 0x46, 0x8c,
+    0x18, 0xb1, 0x91, 0x92, 0xb7, 0xbc, 0x11, 0x23, 0x46, 0x8c, 0xd8, 0x48,
+    0xc9, 0x5b, 0xde, 0x88, 0x11, 0x23, 0x46, 0x2c, 0x6f, 0x79, 0x23, 0x46,
+    0x8c, 0x18, 0xb1, 0x91, 0x92, 0xb7, 0xbc, 0x11, 0x23, 0x46, 0x8c, 0xd8,
+    0x48, 0xc9, 0x1b, 0x31, 0x62, 0xc4, 0x88, 0x8d, 0x94, 0xbc, 0xe5, 0x8d,
+    0x18, 0x31, 0x62, 0xc4, 0x46, 0x4a, 0xde, 0xf2, 0x46, 0x8c, 0x18, 0xb1,
+    0x91, 0x92, 0xb7, 0xbc, 0x11, 0x23, 0x46, 0x8c, 0xd8, 0x48, 0xc9, 0x5b,
+    0xde, 0x88, 0x11, 0x23, 0x46, 0x6c, 0xa4, 0xe4, 0x8d, 0x18, 0x31, 0x62,
+    0xc4, 0x46, 0x4a, 0xde, 0xf2, 0x46, 0x8c, 0x18, 0x31, 0x62, 0x23, 0x25,
+    0x6f, 0x79, 0x23, 0x46, 0x8c, 0xd8, 0x48, 0xc9, 0x5b, 0xde, 0x88, 0x11,
+    0x23, 0x46, 0x6c, 0xa4, 0xe4, 0x2d, 0x6f, 0xc4, 0x88, 0x11, 0x23, 0x36,
+    0x52, 0xf2, 0x46, 0x8c, 0x18, 0x31, 0x62, 0x23, 0x25, 0x6f, 0x79, 0x23,
+    0x46, 0x8c, 0x18, 0xb1, 0x91, 0x92, 0xb7, 0xbc, 0x11, 0x23, 0x46, 0x6c,
+    0xa4, 0xe4, 0x2d, 0x6f, 0xc4, 0x88, 0x11, 0x23, 0x36, 0x52, 0xf2, 0x96,
+    0x37, 0x62, 0xc4, 0x88, 0x11, 0xbb, 0x5d, 0xde, 0x88, 0x11, 0x23, 0x46,
+    0x6c, 0xa4, 0xe4, 0x2d, 0x6f, 0xc4, 0x88, 0x11, 0x23, 0x36, 0x52, 0xf2,
+    0x96, 0x37, 0x62, 0xc4, 0x88, 0x8d, 0x94, 0xbc, 0xe5, 0x8d, 0x18, 0x31,
+    0x62, 0xc4, 0x46, 0x4a, 0xde, 0xf2, 0x46, 0x8c, 0x18, 0x31, 0x62, 0xb7,
+    0xcb, 0x1b, 0x31, 0x62, 0xc4, 0x88, 0x8d, 0x94, 0xbc, 0xe5, 0x8d, 0x18,
+    0x31, 0x62, 0xc4, 0x46, 0x4a, 0xde, 0xf2, 0x46, 0x8c, 0x18, 0xb1, 0x91,
+    0x92, 0xb7, 0xbc, 0x11, 0x23, 0x46, 0x8c, 0xd8, 0x48, 0xc9, 0x5b, 0xde,
+    0x88, 0x11, 0x23, 0x46, 0xec, 0x76, 0x79, 0x23, 0x46, 0x8c, 0x18, 0xb1,
+    0x91, 0x92, 0xb7, 0xbc, 0x11, 0x23, 0x46, 0x8c, 0xd8, 0x48, 0xc9, 0x1b,
+    0x31, 0x62, 0xc4, 0x88, 0x8d, 0x94, 0xbc, 0xe5, 0x8d, 0x18, 0x31, 0x62,
+    0xc4, 0x46, 0x4a, 0xde, 0xf2, 0x46, 0x8c, 0x18, 0xb1, 0x91, 0x92, 0xb7,
+    0xbc, 0x11, 0x23, 0x46, 0x8c, 0xd8, 0x48, 0xc9, 0x5b, 0xde, 0x88, 0x11,
+    0x23, 0x46, 0x6c, 0xa4, 0xe4, 0x8d, 0x18, 0x31, 0x62, 0xc4, 0x46, 0x4a,
+    0xde, 0xf2, 0x46, 0x8c, 0x18, 0x31, 0x62, 0x23, 0x25, 0x6f, 0x79, 0x23,
+    0x46, 0x8c, 0xd8, 0x48, 0xc9, 0x5b, 0xde, 0x88, 0x11, 0x23, 0x46, 0x6c,
+    0xa4, 0xe4, 0x2d, 0x6f, 0xc4, 0x88, 0x11, 0x23, 0x36, 0x52, 0xf2, 0x46,
+    0x8c, 0x18, 0x31, 0x62, 0x23, 0x25, 0x6f, 0x79, 0x23, 0x46, 0x8c, 0x18,
+    0xb1, 0x91, 0x92, 0xb7, 0xbc, 0x11, 0x23, 0x46, 0x6c, 0xa4, 0xe4, 0x2d,
+    0x6f, 0xc4, 0x88, 0x11, 0x23, 0x36, 0x52, 0xf2, 0x96, 0x37, 0x62, 0xc4,
+    0x88, 0x11, 0xbb, 0x5d, 0xde, 0x88, 0x11, 0x23, 0x46, 0x6c, 0xa4, 0xe4,
+    0x2d, 0x6f, 0xc4, 0x88, 0x11, 0x23, 0x36, 0x52, 0xf2, 0x96, 0x37, 0x62,
+    0xc4, 0x88, 0x8d, 0x94, 0xbc, 0xe5, 0x8d, 0x18, 0x31, 0x62, 0xc4, 0x46,
+    0x4a, 0xde, 0xf2, 0x46, 0x8c, 0x18, 0x31, 0x62, 0xb7, 0xcb, 0x1b, 0x31,
+    0x62, 0xc4, 0x88, 0x8d, 0x94, 0xbc, 0xe5, 0x8d, 0x18, 0x31, 0x62, 0xc4,
+    0x46, 0x4a, 0xde, 0xf2, 0x46, 0x8c, 0x18, 0xb1, 0x91, 0x92, 0xb7, 0xbc,
+    0x11, 0x23, 0x46, 0x8c, 0xd8, 0x48, 0xc9, 0x5b, 0xde, 0x88, 0x11, 0x23,
+    0x46, 0xec, 0x76, 0x79, 0x23, 0x46, 0x8c, 0x18, 0xb1, 0x91, 0x92, 0xb7,
+    0xbc, 0x11, 0x23, 0x46, 0x8c, 0xd8, 0x48, 0xc9, 0x1b, 0x31, 0x62, 0xc4,
+    0x88, 0x8d, 0x94, 0xbc, 0xe5, 0x8d, 0x18, 0x31, 0x62, 0xc4, 0x46, 0x4a,
+    0xde, 0xf2, 0x46, 0x8c, 0x18, 0x31, 0x62, 0x79, 0xcb, 0x1b, 0x31, 0x62,
+    0xc4, 0x88, 0x8d, 0x94, 0xbc, 0xe5, 0x8d, 0x18, 0x31, 0x62, 0xc4, 0x46,
+    0x4a, 0xde, 0x88, 0x11, 0x23, 0x46, 0x6c, 0xa4, 0xe4, 0x2d, 0x6f, 0xc4,
+    0x88, 0x11, 0x23, 0x36, 0x52, 0xf2, 0x96, 0x37, 0x62, 0xc4, 0x88, 0x8d,
+    0x94, 0xbc, 0xe5, 0x8d, 0x18, 0x31, 0x62, 0xc4, 0x46, 0x4a, 0xde, 0xf2,
+    0x46, 0x8c, 0x18, 0x31, 0x62, 0x23, 0x25, 0x6f, 0xc4, 0x88, 0x11, 0x23,
+    0x36, 0x52, 0xf2, 0x96, 0x37, 0x62, 0xc4, 0x88, 0x11, 0x1b, 0x29, 0x79,
+    0xcb, 0x1b, 0x31, 0x62, 0xc4, 0x46, 0x4a, 0xde, 0xf2, 0x46, 0x8c, 0x18,
+    0x31, 0x62, 0x23, 0x25, 0x6f, 0x79, 0x23, 0x46, 0x8c, 0x18, 0xb1, 0x91,
+    0x92, 0x37, 0x62, 0xc4, 0x88, 0x11, 0x1b, 0x29, 0x79, 0xcb, 0x1b, 0x31,
+    0x62, 0xc4, 0x88, 0x8d, 0x94, 0xbc, 0xe5, 0x8d, 0x18, 0x31, 0x62, 0x23,
+    0x25, 0x6f, 0x79, 0x23, 0x46, 0x8c, 0x18, 0xb1, 0x91, 0x92, 0xb7, 0xbc,
+    0x11, 0x23, 0x46, 0x8c, 0xd8, 0xed, 0xf2, 0x46, 0x8c, 0x18, 0x31, 0x62,
+    0x23, 0x25, 0x6f, 0x79, 0x23, 0x46, 0x8c, 0x18, 0xb1, 0x91, 0x92, 0xb7,
+    0xbc, 0x11, 0x23, 0x46, 0x6c, 0xa4, 0xe4, 0x2d, 0x6f, 0xc4, 0x88, 0x11,
+    0x23, 0x36, 0x52, 0xf2, 0x96, 0x37, 0x62, 0xc4, 0x88, 0x11, 0xbb, 0x5d,
+    0xde, 0x88, 0x11, 0x23, 0x46, 0x6c, 0xa4, 0xe4, 0x2d, 0x6f, 0xc4, 0x88,
+    0x11, 0x23, 0x36, 0x52, 0xf2, 0x46, 0x8c, 0x18, 0x31, 0x62, 0x23, 0x25,
+    0x6f, 0x79, 0x23, 0x46, 0x8c, 0x18, 0xb1, 0x91, 0x92, 0xb7, 0xbc, 0x11,
+    0x23, 0x46, 0x8c, 0x58, 0xde, 0xf2, 0x46, 0x8c, 0x18, 0x31, 0x62, 0x23,
+    0x25, 0x6f, 0x79, 0x23, 0x46, 0x8c, 0x18, 0xb1, 0x91, 0x92, 0x37, 0x62,
+    0xc4, 0x88, 0x11, 0x1b, 0x29, 0x79, 0xcb, 0x1b, 0x31, 0x62, 0xc4, 0x88,
+    0x8d, 0x94, 0xbc, 0xe5, 0x8d, 0x18, 0x31, 0x62, 0x23, 0x25, 0x6f, 0x79,
+    0x23, 0x46, 0x8c, 0x18, 0xb1, 0x91, 0x92, 0xb7, 0xbc, 0x11, 0x23, 0x46,
+    0x8c, 0xd8, 0x48, 0xc9, 0x1b, 0x31, 0x62, 0xc4, 0x88, 0x8d, 0x94, 0xbc,
+    0xe5, 0x8d, 0x18, 0x31, 0x62, 0xc4, 0x46, 0x4a, 0xde, 0xf2, 0x46, 0x8c,
+    0x18, 0xb1, 0x91, 0x92, 0xb7, 0xbc, 0x11, 0x23, 0x46, 0x8c, 0xd8, 0x48,
+    0xc9, 0x5b, 0xde, 0x88, 0x11, 0x23, 0x46, 0x6c, 0xa4, 0xe4, 0x8d, 0x18,
+    0x31, 0x62, 0xc4, 0x46, 0x4a, 0xde, 0xf2, 0x46, 0x8c, 0x18, 0x31, 0x62,
+    0x23, 0x25, 0x6f, 0x79, 0x23, 0x46, 0x8c, 0xd8, 0x48, 0xc9, 0x5b, 0xde,
+    0x88, 0x11, 0x23, 0x46, 0x6c, 0xa4, 0xe4, 0x2d, 0x6f, 0xc4, 0x88, 0x11,
+    0x23, 0x76, 0xbb, 0xbc, 0x11, 0x23, 0x46, 0x8c, 0xd8, 0x48, 0xc9, 0x5b,
+    0xde, 0x88, 0x11, 0x23, 0x46, 0x6c, 0xa4, 0xe4, 0x2d, 0x6f, 0xc4, 0x88,
+    0x11, 0x1b, 0x29, 0x79, 0xcb, 0x1b, 0x31, 0x62, 0xc4, 0x88, 0x8d, 0x94,
+    0xbc, 0xe5, 0x8d, 0x18, 0x31, 0x62, 0xc4, 0x6e, 0x97, 0x37, 0x62, 0xc4,
+    0x88, 0x11, 0x1b, 0x29, 0x79, 0xcb, 0x1b, 0x31, 0x62, 0xc4, 0x88, 0x8d,
+    0x94, 0xbc, 0xe5, 0x8d, 0x18, 0x31, 0x62, 0x23, 0x25, 0x6f, 0x79, 0x23,
+    0x46, 0x8c, 0x18, 0xb1, 0x91, 0x92, 0xb7, 0xbc, 0x11, 0x23, 0x46, 0x8c,
+    0xd8, 0xed, 0xf2, 0x46, 0x8c, 0x18, 0x31, 0x62, 0x23, 0x25, 0x6f, 0x79,
+    0x23, 0x46, 0x8c, 0x18, 0xb1, 0x91, 0x92, 0x37, 0x62, 0xc4, 0x88, 0x11,
+    0x1b, 0x29, 0x79, 0xcb, 0x1b, 0x31, 0x62, 0xc4, 0x88, 0x8d, 0x94, 0xbc,
+    0xe5, 0x8d, 0x18, 0x31, 0x62, 0x23, 0x25, 0x6f, 0x79, 0x23, 0x46, 0x8c,
+    0x18, 0xb1, 0x91, 0x92, 0xb7, 0xbc, 0x11, 0x23, 0x46, 0x8c, 0xd8, 0x48,
+    0xc9, 0x1b, 0x31, 0x62, 0xc4, 0x88, 0x8d, 0x94, 0xbc, 0xe5, 0x8d, 0x18,
+    0x31, 0x62, 0xc4, 0x46, 0x4a, 0xde, 0xf2, 0x46, 0x8c, 0x18, 0xb1, 0x91,
+    0x92, 0xb7, 0xbc, 0x11, 0x23, 0x46, 0x8c, 0xd8, 0x48, 0xc9, 0x5b, 0xde,
+    0x88, 0x11, 0x23, 0x46, 0x6c, 0xa4, 0xe4, 0x8d, 0x18, 0x31, 0x62, 0xc4,
+    0x46, 0x4a, 0xde, 0xf2, 0x46, 0x8c, 0x18, 0x31, 0x62, 0x23, 0x25, 0x6f,
+    0x79, 0x23, 0x46, 0x8c, 0xd8, 0x48, 0xc9, 0x5b, 0xde, 0x88, 0x11, 0x23,
+    0x46, 0x6c, 0xa4, 0xe4, 0x2d, 0x6f, 0xc4, 0x88, 0x11, 0x23, 0x76, 0xbb,
+    0xbc, 0x11, 0x23, 0x46, 0x8c, 0xd8, 0x48, 0xc9, 0x5b, 0xde, 0x88, 0x11,
+    0x23, 0x46, 0x6c, 0xa4, 0xe4, 0x2d, 0x6f, 0xc4, 0x88, 0x11, 0x1b, 0x29,
+    0x79, 0xcb, 0x1b, 0x31, 0x62, 0xc4, 0x88, 0x8d, 0x94, 0xbc, 0xe5, 0x8d,
+    0x18, 0x31, 0x62, 0xc4, 0x6e, 0x97, 0x37, 0x62, 0xc4, 0x88, 0x11, 0x1b,
+    0x29, 0x79, 0xcb, 0x1b, 0x31, 0x62, 0xc4, 0x88, 0x8d, 0x94, 0xbc, 0xe5,
+    0x8d, 0x18, 0x31, 0x62, 0x23, 0x25, 0x6f, 0x79, 0x23, 0x46, 0x8c, 0x18,
+    0xb1, 0x91, 0x92, 0xb7, 0xbc, 0x11, 0x23, 0x46, 0x8c, 0xd8, 0xed, 0xf2,
+    0x46, 0x8c, 0x18, 0x31, 0x62, 0x23, 0x25, 0x6f, 0x79, 0x23, 0x46, 0x8c,
+    0x18, 0xb1, 0x91, 0x92, 0x37, 0x62, 0xc4, 0x88, 0x11, 0x1b, 0x29, 0x79,
+    0xcb, 0x1b, 0x31, 0x62, 0xc4, 0x88, 0x8d, 0x94, 0xbc, 0xe5, 0x8d, 0x18,
+    0x31, 0x62, 0xc4, 0xf2, 0x96, 0x37, 0x62, 0xc4, 0x88, 0x11, 0x1b, 0x29,
+    0x79, 0xcb, 0x1b, 0x31, 0x62, 0xc4, 0x88, 0x8d, 0x94, 0xbc, 0x11, 0x23,
+    0x46, 0x8c, 0xd8, 0x48, 0xc9, 0x5b, 0xde, 0x88, 0x11, 0x23, 0x46, 0x6c,
+    0xa4, 0xe4, 0x2d, 0x6f, 0xc4, 0x88, 0x11, 0x1b, 0x29, 0x79, 0xcb, 0x1b,
+    0x31, 0x62, 0xc4, 0x88, 0x8d, 0x94, 0xbc, 0xe5, 0x8d, 0x18, 0x31, 0x62,
+    0xc4, 0x46, 0x4a, 0xde, 0x88, 0x11, 0x23, 0x46, 0x6c, 0xa4, 0xe4, 0x2d,
+    0x6f, 0xc4, 0x88, 0x11, 0x23, 0x36, 0x52, 0xf2, 0x96, 0x37, 0x62, 0xc4,
+    0x88, 0x8d, 0x94, 0xbc, 0xe5, 0x8d, 0x18, 0x31, 0x62, 0xc4, 0x46, 0x4a,
+    0xde, 0xf2, 0x46, 0x8c, 0x18, 0x31, 0x62, 0x23, 0x25, 0x6f, 0xc4, 0x88,
+    0x11, 0x23, 0x36, 0x52, 0xf2, 0x96, 0x37, 0x62, 0xc4, 0x88, 0x11, 0x1b,
+    0x29, 0x79, 0xcb, 0x1b, 0x31, 0x62, 0xc4, 0x46, 0x4a, 0xde, 0xf2, 0x46,
+    0x8c, 0x18, 0x31, 0x62, 0x23, 0x25, 0x6f, 0x79, 0x23, 0x46, 0x8c, 0x18,
+    0xb1, 0xdb, 0xe5, 0x8d, 0x18, 0x31, 0x62, 0xc4, 0x46, 0x4a, 0xde, 0xf2,
+    0x46, 0x8c, 0x18, 0x31, 0x62, 0x23, 0x25, 0x6f, 0x79, 0x23, 0x46, 0x8c,
+    0xd8, 0x48, 0xc9, 0x5b, 0xde, 0x88, 0x11, 0x23, 0x46, 0x6c, 0xa4, 0xe4,
+    0x2d, 0x6f, 0xc4, 0x88, 0x11, 0x23, 0x76, 0xbb, 0xbc, 0x11, 0x23, 0x46,
+    0x8c, 0xd8, 0x48, 0xc9, 0x5b, 0xde, 0x88, 0x11, 0x23, 0x46, 0x6c, 0xa4,
+    0xe4, 0x8d, 0x18, 0x31, 0x62, 0xc4, 0x46, 0x4a, 0xde, 0xf2, 0x46, 0x8c,
+    0x18, 0x31, 0x62, 0x23, 0x25, 0x6f, 0x79, 0x23, 0x46, 0x8c, 0xf8, 0xdf,
+    0x89, 0x3f,
+};
+
+static char g_text[TEXT_REPEAT * 1701 + 64];
+static char g_out[sizeof(g_text)];
+static unsigned char g_zip[4096];
+static pas_zip_reader_t g_reader;
+
+static size_t make_text(char *buf) {
+    size_t n = 0;
+    int i;
+    for (i = 0; i < 60; i++)
+        n += (size_t)sprintf(buf + n, "line %d: the quick brown fox\n", i % 17);
+    return n;
+}
+
+static size_t make_big_text(void) {
+    size_t n = make_text(g_text), total = n;
+    int i;
+    for (i = 1; i < TEXT_REPEAT; i++, total += n) memcpy(g_text + total, g_text, n);
+    return total;
+}
+
+static void put_u16(unsigned char *p, size_t *w, unsigned v) {
+    p[(*w)++] = (unsigned char)v;
+    p[(*w)++] = (unsigned char)(v >> 8);
+}
+
+static void put_u32(unsigned char *p, size_t *w, uint32_t v) {
+    put_u16(p, w, (unsigned)(v & 0xFFFF));
+    put_u16(p, w, (unsigned)(v >> 16));
+}
+
+/* One-entry ZIP "e" with the given method and payload. Returns archive size. */
+static size_t make_zip(unsigned method, const void *payload, uint32_t comp, uint32_t unc) {
+    size_t w = 0, cd_off;
+    put_u32(g_zip, &w, 0x04034b50);
+    put_u16(g_zip, &w, 20); put_u16(g_zip, &w, 0); put_u16(g_zip, &w, method);
+    put_u32(g_zip, &w, 0); put_u32(g_zip, &w, 0);
+    put_u32(g_zip, &w, comp); put_u32(g_zip, &w, unc);
+    put_u16(g_zip, &w, 1); put_u16(g_zip, &w, 0);
+    g_zip[w++] = 'e';
+    memcpy(g_zip + w, payload, comp); w += comp;
+    cd_off = w;
+    put_u32(g_zip, &w, 0x02014b50);
+    put_u16(g_zip, &w, 20); put_u16(g_zip, &w, 20); put_u16(g_zip, &w, 0); put_u16(g_zip, &w, method);
+    put_u32(g_zip, &w, 0); put_u32(g_zip, &w, 0);
+    put_u32(g_zip, &w, comp); put_u32(g_zip, &w, unc);
+    put_u16(g_zip, &w, 1); put_u16(g_zip, &w, 0); put_u16(g_zip, &w, 0);
+    put_u16(g_zip, &w, 0); put_u16(g_zip, &w, 0); put_u32(g_zip, &w, 0);
+    put_u32(g_zip, &w, 0);
+    g_zip[w++] = 'e';
+    put_u32(g_zip, &w, 0x06054b50);
+    put_u16(g_zip, &w, 0); put_u16(g_zip, &w, 0); put_u16(g_zip, &w, 1); put_u16(g_zip, &w, 1);
+    put_u32(g_zip, &w, (uint32_t)(w - cd_off - 12)); put_u32(g_zip, &w, (uint32_t)cd_off);
+    put_u16(g_zip, &w, 0);
+    return w;
+}
+
+/* Read the whole entry with chunks of chunk bytes. Returns total bytes; *status is the last status. */
+static size_t read_all(const pas_zip_file_t *file, size_t chunk, pas_zip_status *status) {
+    size_t total = 0, n;
+    if (!pas_zip_reader_init(&g_reader, file, status)) return 0;
+    do {
+        size_t want = chunk;
+        if (want > sizeof(g_out) - total) want = sizeof(g_out) - total;
+        n = pas_zip_reader_read(&g_reader, g_out + total, want, status);
+        total += n;
+    } while (n > 0 && *status == PAS_ZIP_OK);
+    pas_zip_reader_close(&g_reader);
+    return total;
+}
+
+static void test_deflate(void) {
+    static const size_t chunks[] = { 1, 7, 1000, 65536, sizeof(g_out) };
+    size_t text_len = make_big_text(), size, n, i;
+    pas_zip_t arch;
+    pas_zip_file_t file;
+    pas_zip_status status;
+
+    size = make_zip(8, big_stream, (uint32_t)sizeof(big_stream), (uint32_t)text_len);
+    ASSERT_EQ(pas_zip_open_ex(&arch, g_zip, size, &status), 1);
+    ASSERT_EQ(pas_zip_find_ex(&arch, "e", &file), 1);
+
+    for (i = 0; i < sizeof(chunks) / sizeof(chunks[0]); i++) {
+        memset(g_out, 0, sizeof(g_out));
+        n = read_all(&file, chunks[i], &status);
+        ASSERT(status == PAS_ZIP_OK);
+        ASSERT_EQ(n, text_len);
+        ASSERT(memcmp(g_out, g_text, text_len) == 0);
+    }
+
+    /* Reads after the end keep returning 0 */
+    ASSERT_EQ(pas_zip_reader_init(&g_reader, &file, &status), 1);
+    while (pas_zip_reader_read(&g_reader, g_out, sizeof(g_out), &status) > 0) {}
+    ASSERT(status == PAS_ZIP_OK);
+    ASSERT_EQ(pas_zip_reader_read(&g_reader, g_out, 10, &status), 0u);
+    ASSERT(status == PAS_ZIP_OK);
+    pas_zip_reader_close(&g_reader);
+}
+
+static void test_store(void) {
+    size_t text_len = make_text(g_text), size, n;
+    pas_zip_t arch;
+    pas_zip_file_t file;
+    pas_zip_status status;
+
+    size = make_zip(0, g_text, (uint32_t)text_len, (uint32_t)text_len);
+    ASSERT_EQ(pas_zip_open_ex(&arch, g_zip, size, &status), 1);
+    ASSERT_EQ(pas_zip_find_ex(&arch, "e", &file), 1);
+    n = read_all(&file, 13, &status);
+    ASSERT(status == PAS_ZIP_OK);
+    ASSERT_EQ(n, text_len);
+    ASSERT(memcmp(g_out, g_text, text_len) == 0);
+}
+
+static void test_errors(void) {
+    size_t text_len = make_big_text(), size, n;
+    pas_zip_t arch;
+    pas_zip_file_t file;
+    pas_zip_status status;
+
+    /* Declared size smaller than the stream */
+    size = make_zip(8, big_stream, (uint32_t)sizeof(big_stream), (uint32_t)(text_len - 1));
+    ASSERT_EQ(pas_zip_open_ex(&arch, g_zip, size, &status), 1);
+    ASSERT_EQ(pas_zip_find_ex(&arch, "e", &file), 1);
+    n = read_all(&file, 4096, &status);
+    ASSERT(status == PAS_ZIP_E_ZLIB);
+    ASSERT(n < text_len);
+
+    /* Truncated stream */
+    size = make_zip(8, big_stream, (uint32_t)sizeof(big_stream) - 20, (uint32_t)text_len);
+    ASSERT_EQ(pas_zip_open_ex(&arch, g_zip, size, &status), 1);
+    ASSERT_EQ(pas_zip_find_ex(&arch, "e", &file), 1);
+    (void)read_all(&file, 4096, &status);
+    ASSERT(status == PAS_ZIP_E_ZLIB);
+
+    /* Unsupported method */
+    size = make_zip(12, big_stream, 16, 16);
+    ASSERT_EQ(pas_zip_open_ex(&arch, g_zip, size, &status), 1);
+    ASSERT_EQ(pas_zip_find_ex(&arch, "e", &file), 1);
+    ASSERT_EQ(pas_zip_reader_init(&g_reader, &file, &status), 0);
+    ASSERT(status == PAS_ZIP_E_COMPRESSED);
+}
+
+int main(void) {
+    g_failed = 0;
+    g_assertions = 0;
+    test_deflate();
+    test_store();
+    test_errors();
+    if (g_failed) {
+        (void)fprintf(stderr, "Total: %d assertions, %d failed\n", g_assertions, g_failed);
+        return 1;
+    }
+    (void)printf("All %d assertions passed.\n", g_assertions);
+    return 0;
+}
@@ -0,0 +1,87 @@
+/*
+    test_reentrant.c - Test the re-entrant _ex API (two archives, several live entries).
+    From repo root: gcc -o tests/pas_zip/test_reentrant tests/pas_zip/test_reentrant.c -I.
+*/
+
+#define PAS_ZIP_IMPLEMENTATION
+#include "pas_zip.h"
+#include <stdio.h>
+#include <string.h>
+
+static int g_failed, g_assertions;
+
+#define ASSERT(cond) do { \
+    ++g_assertions; \
+    if (!(cond)) { (void)fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); ++g_failed; } \
+} while (0)
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+int main(void) {
+    unsigned char buf_a[1024], buf_b[1024];
+    size_t len_a, len_b, n, name_len;
+    pas_zip_status status;
+    pas_zip_t zip_a, zip_b;
+    pas_zip_file_t a1, a2, b1;
+    const char *name;
+    char out[64];
+
+    g_failed = 0;
+    g_assertions = 0;
+
+    len_a = pas_zip_create(
+        (const char *[]){ "one.txt", "two.txt" },
+        (const void *[]){ "first", "second" },
+        (size_t[]){ 5, 6 },
+        2, buf_a, sizeof(buf_a), &status
+    );
+    ASSERT(status == PAS_ZIP_OK);
+    len_b = pas_zip_create(
+        (const char *[]){ "one.txt" },
+        (const void *[]){ "other archive" },
+        (size_t[]){ 13 },
+        1, buf_b, sizeof(buf_b), &status
+    );
+    ASSERT(status == PAS_ZIP_OK);
+
+    ASSERT_EQ(pas_zip_open_ex(&zip_a, buf_a, len_a, &status), 1);
+    ASSERT_EQ(pas_zip_open_ex(&zip_b, buf_b, len_b, &status), 1);
+    ASSERT_EQ(pas_zip_open_ex(&zip_b, buf_b, 3, &status), 0);
+    ASSERT(status == PAS_ZIP_E_INVALID);
+    ASSERT_EQ(pas_zip_open_ex(&zip_b, buf_b, len_b, &status), 1);
+
+    ASSERT_EQ(pas_zip_find_ex(&zip_a, "one.txt", &a1), 1);
+    ASSERT_EQ(pas_zip_find_ex(&zip_a, "two.txt", &a2), 1);
+    ASSERT_EQ(pas_zip_find_ex(&zip_b, "one.txt", &b1), 1);
+    ASSERT_EQ(pas_zip_find_ex(&zip_b, "two.txt", &b1), 0);
+    ASSERT_EQ(pas_zip_find_ex(&zip_b, "one.txt", &b1), 1);
+
+    ASSERT(a1.zip == &zip_a);
+    ASSERT(b1.zip == &zip_b);
+    ASSERT(pas_zip_name(&a1) == NULL);
+    name = pas_zip_name_span(&a2, &name_len);
+    ASSERT_EQ(name_len, 7u);
+    ASSERT(memcmp(name, "two.txt", 7) == 0);
+
+    /* Entries from both archives stay valid side by side */
+    n = pas_zip_extract(&b1, out, sizeof(out), &status);
+    ASSERT(status == PAS_ZIP_OK);
+    ASSERT_EQ(n, 13u);
+    ASSERT(memcmp(out, "other archive", 13) == 0);
+
+    n = pas_zip_extract(&a1, out, sizeof(out), &status);
+    ASSERT(status == PAS_ZIP_OK);
+    ASSERT_EQ(n, 5u);
+    ASSERT(memcmp(out, "first", 5) == 0);
+
+    n = pas_zip_extract(&a2, out, sizeof(out), &status);
+    ASSERT(status == PAS_ZIP_OK);
+    ASSERT_EQ(n, 6u);
+    ASSERT(memcmp(out, "second", 6) == 0);
+
+    if (g_failed) {
+        (void)fprintf(stderr, "Total: %d assertions, %d failed\n", g_assertions, g_failed);
+        return 1;
+    }
+    (void)printf("All %d assertions passed.\n", g_assertions);
+    return 0;
+}
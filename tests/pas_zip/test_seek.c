@@ -0,0 +1,172 @@
+/*
+    test_seek.c - Test the Deflate seek index (pas_zip_seek_index_build, pas_zip_read_at).
+    From repo root: gcc -o tests/pas_zip/test_seek tests/pas_zip/test_seek.c -I.
+*/
+
+#define PAS_ZIP_IMPLEMENTATION
+#include "pas_zip.h"
+#include <stdio.h>
+#include <string.h>
+
+static int g_failed, g_assertions;
+
+#define ASSERT(cond) do { \
+    ++g_assertions; \
+    if (!(cond)) { (void)fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); ++g_failed; } \
+} while (0)
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+#define TEXT_SIZE (3 * 1024 * 1024)
+#define SPAN (128 * 1024)
+
+static pas_zip_deflate_t g_deflate;
+static pas_zip_reader_t g_work;
+static char g_text[TEXT_SIZE];
+static unsigned char g_zip[TEXT_SIZE + 65536];
+static unsigned char g_storage[(TEXT_SIZE / SPAN) * (PAS_ZIP_WINDOW_SIZE + 16)];
+static char g_out[300000];
+
+static void make_text(void) {
+    size_t n = 0;
+    uint32_t x = 1;
+    while (n < TEXT_SIZE - 100) {
+        x = x * 1103515245u + 12345u;
+        n += (size_t)sprintf(g_text + n, "2024-01-%02u host%u GET /api/v%u/items/%u %u\n",
+                             1 + (x >> 27), (x >> 20) & 15, (x >> 16) & 3, x & 0xFFFF, 200 + (x >> 29));
+    }
+    memset(g_text + n, '.', TEXT_SIZE - n);
+}
+
+static size_t make_zip(int level) {
+    const char *names[1] = { "log.txt" };
+    const void *datas[1];
+    size_t sizes[1] = { TEXT_SIZE };
+    pas_zip_status st;
+    datas[0] = g_text;
+    return pas_zip_create_ex(names, datas, sizes, 1, level, &g_deflate, g_zip, sizeof(g_zip), &st);
+}
+
+/* Reads at scattered offsets and lengths, including across points and past the end */
+static int check_reads(const pas_zip_seek_index_t *idx) {
+    static const size_t lens[] = { 1, 100, 4096, 70000, 300000 };
+    uint32_t x = 99;
+    int bad = 0, i;
+    for (i = 0; i < 60; i++) {
+        pas_zip_status st;
+        size_t len = lens[i % 5], n, want;
+        uint64_t off;
+        x = x * 1103515245u + 12345u;
+        off = i == 0 ? 0 : (i == 1 ? TEXT_SIZE - 10 : x % TEXT_SIZE);
+        want = TEXT_SIZE - off < len ? (size_t)(TEXT_SIZE - off) : len;
+        n = pas_zip_read_at(idx, &g_work, off, g_out, len, &st);
+        if (st != PAS_ZIP_OK || n != want || memcmp(g_out, g_text + off, n) != 0) bad++;
+    }
+    return bad;
+}
+
+static void test_deflate(void) {
+    pas_zip_t zip;
+    pas_zip_file_t f;
+    pas_zip_seek_index_t idx;
+    pas_zip_status st;
+    size_t len, need, i, n;
+
+    len = make_zip(6);
+    ASSERT(len > 0);
+    ASSERT(pas_zip_open_ex(&zip, g_zip, len, &st));
+    ASSERT(pas_zip_find_ex(&zip, "log.txt", &f));
+    ASSERT_EQ(f.compression_method, PAS_ZIP_METHOD_DEFLATE);
+
+    need = pas_zip_seek_index_size(&f, SPAN);
+    ASSERT_EQ(need, sizeof(g_storage));
+    ASSERT_EQ(pas_zip_seek_index_build(&idx, &f, SPAN, g_storage, 3 * (PAS_ZIP_WINDOW_SIZE + 16), &g_work, &st), 0);
+    ASSERT_EQ(st, PAS_ZIP_E_NOSPACE);
+    ASSERT(pas_zip_seek_index_build(&idx, &f, SPAN, g_storage, need, &g_work, &st));
+    ASSERT_EQ(st, PAS_ZIP_OK);
+    ASSERT(idx.count > 10);
+    for (i = 1; i < idx.count; i++) ASSERT(idx.points[i].out_offset - idx.points[i - 1].out_offset >= SPAN);
+
+    ASSERT_EQ(check_reads(&idx), 0);
+
+    /* End of entry and out-of-range offsets */
+    ASSERT_EQ(pas_zip_read_at(&idx, &g_work, TEXT_SIZE, g_out, 10, &st), 0u);
+    ASSERT_EQ(st, PAS_ZIP_OK);
+    ASSERT_EQ(pas_zip_read_at(&idx, &g_work, TEXT_SIZE + 1, g_out, 10, &st), 0u);
+    ASSERT_EQ(st, PAS_ZIP_E_INVALID);
+
+    /* The work reader continues after read_at, even with verify_crc set */
+    zip.verify_crc = 1;
+    ASSERT(pas_zip_find_ex(&zip, "log.txt", &f));
+    ASSERT(pas_zip_seek_index_build(&idx, &f, SPAN, g_storage, need, &g_work, &st));
+    ASSERT_EQ(pas_zip_read_at(&idx, &g_work, TEXT_SIZE - 250000, g_out, 1000, &st), 1000u);
+    n = 1000;
+    while (n < 250000) {
+        size_t k = pas_zip_reader_read(&g_work, g_out + n, sizeof(g_out) - n, &st);
+        if (k == 0 || st != PAS_ZIP_OK) break;
+        n += k;
+    }
+    ASSERT_EQ(n, 250000u);
+    ASSERT_EQ(st, PAS_ZIP_OK);
+    ASSERT(memcmp(g_out, g_text + TEXT_SIZE - 250000, 250000) == 0);
+
+    /* An index without points still reads (from the start) */
+    ASSERT(pas_zip_seek_index_build(&idx, &f, TEXT_SIZE, NULL, 0, &g_work, &st));
+    ASSERT_EQ(idx.count, 0u);
+    ASSERT_EQ(pas_zip_read_at(&idx, &g_work, 2000000, g_out, 5000, &st), 5000u);
+    ASSERT(memcmp(g_out, g_text + 2000000, 5000) == 0);
+
+    /* Corrupt index point */
+    ASSERT(pas_zip_seek_index_build(&idx, &f, SPAN, g_storage, need, &g_work, &st));
+    idx.points[2].in_bit += 5;
+    ASSERT_EQ(pas_zip_read_at(&idx, &g_work, idx.points[2].out_offset + 10, g_out, 100000, &st), 0u);
+    ASSERT(st == PAS_ZIP_E_ZLIB);
+}
+
+/* Random regions make the encoder emit stored blocks between Huffman ones; points land after
+   both kinds. Store entries need no index. */
+static void test_stored(void) {
+    pas_zip_t zip;
+    pas_zip_file_t f;
+    pas_zip_seek_index_t idx;
+    pas_zip_status st;
+    size_t len, i;
+    uint32_t x = 7;
+    const char *names[1] = { "raw" };
+    const void *datas[1];
+    size_t sizes[1] = { TEXT_SIZE };
+
+    for (i = 0; i < TEXT_SIZE; i++) {
+        if ((i / 100000) % 3 != 1) continue;
+        x = x * 1103515245u + 12345u;
+        g_text[i] = (char)(x >> 24);
+    }
+    len = make_zip(1);
+    ASSERT(pas_zip_open_ex(&zip, g_zip, len, &st));
+    ASSERT(pas_zip_find_ex(&zip, "log.txt", &f));
+    ASSERT_EQ(f.compression_method, PAS_ZIP_METHOD_DEFLATE);
+    ASSERT(pas_zip_seek_index_build(&idx, &f, SPAN, g_storage, sizeof(g_storage), &g_work, &st));
+    ASSERT_EQ(check_reads(&idx), 0);
+
+    datas[0] = g_text;
+    len = pas_zip_create(names, datas, sizes, 1, g_zip, sizeof(g_zip), &st);
+    ASSERT(pas_zip_open_ex(&zip, g_zip, len, &st));
+    ASSERT(pas_zip_find_ex(&zip, "raw", &f));
+    ASSERT_EQ(pas_zip_seek_index_size(&f, SPAN), 0u);
+    ASSERT(pas_zip_seek_index_build(&idx, &f, SPAN, NULL, 0, &g_work, &st));
+    ASSERT_EQ(idx.count, 0u);
+    ASSERT_EQ(check_reads(&idx), 0);
+}
+
+int main(void) {
+    g_failed = 0;
+    g_assertions = 0;
+    make_text();
+    test_deflate();
+    test_stored();
+    if (g_failed) {
+        (void)fprintf(stderr, "Total: %d assertions, %d failed\n", g_assertions, g_failed);
+        return 1;
+    }
+    (void)printf("All %d assertions passed.\n", g_assertions);
+    return 0;
+}
@@ -0,0 +1,194 @@
+/*
+    test_sorted.c - Test the sorted Central Directory snapshot (prefix, find, directory listing).
+    From repo root: gcc -o tests/pas_zip/test_sorted tests/pas_zip/test_sorted.c -I.
+*/
+
+#define PAS_ZIP_IMPLEMENTATION
+#include "pas_zip.h"
+#include <stdio.h>
+#include <string.h>
+
+static int g_failed, g_assertions;
+
+#define ASSERT(cond) do { \
+    ++g_assertions; \
+    if (!(cond)) { (void)fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); ++g_failed; } \
+} while (0)
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+#define MANY 3000
+
+static unsigned char g_zip[MANY * 200];
+static pas_zip_sorted_entry_t g_sorted[MANY];
+static char g_names[MANY][32];
+
+static const char *k_names[] = {
+    "textures/wall.png", "readme.txt", "textures/sky/day.png", "sounds/", "textures/",
+    "textures.txt", "textures/sky/night.png", "textures/a.png", "sounds/hit.wav",
+    "textures/sky/", "textures/zz/deep/x.bin", "readme.txt", "textures_old/b.png"
+};
+#define K_COUNT (int)(sizeof(k_names) / sizeof(k_names[0]))
+
+static size_t build_zip(const char **names, int count) {
+    const void *datas[MANY];
+    size_t sizes[MANY];
+    pas_zip_status st;
+    int i;
+    for (i = 0; i < count; i++) {
+        datas[i] = names[i];
+        sizes[i] = strlen(names[i]);
+    }
+    return pas_zip_create(names, datas, sizes, count, g_zip, sizeof(g_zip), &st);
+}
+
+static int span_is(const char *p, size_t len, const char *s) {
+    return len == strlen(s) && memcmp(p, s, len) == 0;
+}
+
+static int name_is(const pas_zip_file_t *f, const char *s) {
+    size_t len;
+    const char *p = pas_zip_name_span(f, &len);
+    return span_is(p, len, s);
+}
+
+static void test_small(void) {
+    pas_zip_t zip;
+    pas_zip_sorted_t sorted;
+    pas_zip_file_t f;
+    pas_zip_dir_iter_t it;
+    pas_zip_status st;
+    size_t len, first, i, n, idx, name_len;
+    const char *name;
+    char buf[64];
+
+    len = build_zip(k_names, K_COUNT);
+    ASSERT(len > 0);
+    ASSERT(pas_zip_open_ex(&zip, g_zip, len, &st));
+
+    ASSERT_EQ(pas_zip_sorted_build(&zip, &sorted, g_sorted, K_COUNT - 1, &st), 0);
+    ASSERT_EQ(st, PAS_ZIP_E_NOSPACE);
+    ASSERT(pas_zip_sorted_build(&zip, &sorted, g_sorted, MANY, &st));
+    ASSERT_EQ(st, PAS_ZIP_OK);
+    ASSERT_EQ(sorted.count, (size_t)K_COUNT);
+    for (i = 1; i < sorted.count; i++) {
+        size_t a = sorted.entries[i - 1].name_len, b = sorted.entries[i].name_len;
+        int c = memcmp(g_zip + sorted.entries[i - 1].name_offset, g_zip + sorted.entries[i].name_offset, a < b ? a : b);
+        ASSERT(c < 0 || (c == 0 && a <= b));
+    }
+
+    /* Prefix runs */
+    ASSERT_EQ(pas_zip_sorted_prefix(&sorted, "textures/", &first), 7u);
+    for (i = first; i < first + 7; i++) ASSERT(memcmp(g_zip + sorted.entries[i].name_offset, "textures/", 9) == 0);
+    ASSERT_EQ(pas_zip_sorted_prefix(&sorted, "textures", &first), 9u);
+    ASSERT_EQ(pas_zip_sorted_prefix(&sorted, "textures/sky/", &first), 3u);
+    ASSERT_EQ(pas_zip_sorted_prefix(&sorted, "", &first), (size_t)K_COUNT);
+    ASSERT_EQ(first, 0u);
+    ASSERT_EQ(pas_zip_sorted_prefix(&sorted, "zzz", &first), 0u);
+    ASSERT_EQ(pas_zip_sorted_prefix(&sorted, "textures/sky/day.png.bak", &first), 0u);
+
+    /* Exact find; duplicates resolve to the first one in the Central Directory like pas_zip_find_ex */
+    ASSERT(pas_zip_sorted_find(&sorted, "textures/sky/night.png", &f));
+    ASSERT(name_is(&f, "textures/sky/night.png"));
+    ASSERT_EQ(pas_zip_extract(&f, buf, sizeof(buf), &st), 22u);
+    ASSERT(pas_zip_sorted_find(&sorted, "readme.txt", &f));
+    ASSERT_EQ(f.local_header_offset, (uint64_t)(30 + 17 + 17));
+    ASSERT_EQ(pas_zip_sorted_find(&sorted, "textures", &f), 0);
+    ASSERT_EQ(pas_zip_sorted_find(&sorted, "textures/sky/day", &f), 0);
+    ASSERT_EQ(pas_zip_sorted_entry(&sorted, sorted.count, &f), 0);
+
+    /* Directory listing */
+    ASSERT(pas_zip_dir_begin(&sorted, "textures/", &it));
+    ASSERT(pas_zip_dir_next(&sorted, &it, &idx, &name, &name_len));
+    ASSERT(span_is(name, name_len, "textures/a.png"));
+    ASSERT(pas_zip_sorted_entry(&sorted, idx, &f));
+    ASSERT(name_is(&f, "textures/a.png"));
+    ASSERT(pas_zip_dir_next(&sorted, &it, &idx, &name, &name_len));
+    ASSERT(span_is(name, name_len, "textures/sky/"));
+    ASSERT(pas_zip_dir_next(&sorted, &it, &idx, &name, &name_len));
+    ASSERT(span_is(name, name_len, "textures/wall.png"));
+    ASSERT(pas_zip_dir_next(&sorted, &it, &idx, &name, &name_len));
+    ASSERT(span_is(name, name_len, "textures/zz/"));
+    ASSERT(span_is((const char *)g_zip + sorted.entries[idx].name_offset, sorted.entries[idx].name_len,
+                   "textures/zz/deep/x.bin"));
+    ASSERT_EQ(pas_zip_dir_next(&sorted, &it, &idx, &name, &name_len), 0);
+
+    n = 0;
+    ASSERT(pas_zip_dir_begin(&sorted, "", &it));
+    while (pas_zip_dir_next(&sorted, &it, NULL, &name, &name_len)) n++;
+    ASSERT_EQ(n, 6u); /* readme.txt twice, sounds/, textures.txt, textures/, textures_old/ */
+    ASSERT_EQ(pas_zip_dir_begin(&sorted, "music/", &it), 0);
+    ASSERT_EQ(pas_zip_dir_next(&sorted, &it, NULL, &name, &name_len), 0);
+    ASSERT(pas_zip_dir_begin(&sorted, "sounds/", &it));
+    ASSERT(pas_zip_dir_next(&sorted, &it, NULL, &name, &name_len));
+    ASSERT(span_is(name, name_len, "sounds/hit.wav"));
+    ASSERT_EQ(pas_zip_dir_next(&sorted, &it, NULL, &name, &name_len), 0);
+}
+
+/* Many entries in scrambled order: prefix counts and listings against a brute-force scan */
+static void test_many(void) {
+    const char *names[MANY];
+    pas_zip_t zip;
+    pas_zip_sorted_t sorted;
+    pas_zip_dir_iter_t it;
+    pas_zip_status st;
+    pas_zip_file_t f;
+    size_t len, first, n, want, name_len;
+    const char *name;
+    char prefix[32];
+    int i, d, bad = 0;
+
+    for (i = 0; i < MANY; i++) {
+        unsigned k = (unsigned)i * 2654435761u % MANY;
+        (void)sprintf(g_names[i], "d%u/s%u/f%u.dat", k % 7, k % 13, k);
+        names[i] = g_names[i];
+    }
+    len = build_zip(names, MANY);
+    ASSERT(len > 0);
+    ASSERT(pas_zip_open_ex(&zip, g_zip, len, &st));
+    ASSERT(pas_zip_sorted_build(&zip, &sorted, g_sorted, MANY, &st));
+
+    for (d = 0; d < 7; d++) {
+        (void)sprintf(prefix, "d%d/", d);
+        want = 0;
+        for (i = 0; i < MANY; i++) want += strncmp(g_names[i], prefix, strlen(prefix)) == 0;
+        if (pas_zip_sorted_prefix(&sorted, prefix, &first) != want) bad++;
+
+        /* 13 subdirectories under each top-level directory */
+        n = 0;
+        pas_zip_dir_begin(&sorted, prefix, &it);
+        while (pas_zip_dir_next(&sorted, &it, NULL, &name, &name_len)) {
+            if (name[name_len - 1] != '/') bad++;
+            n++;
+        }
+        if (n != 13) bad++;
+    }
+    ASSERT_EQ(bad, 0);
+    for (i = 0; i < MANY; i += 97) {
+        ASSERT(pas_zip_sorted_find(&sorted, g_names[i], &f));
+        ASSERT(name_is(&f, g_names[i]));
+    }
+
+    /* An archive written in sorted order is taken as is */
+    for (i = 0; i < MANY; i++) (void)sprintf(g_names[i], "f%05d", i);
+    len = build_zip(names, MANY);
+    ASSERT(pas_zip_open_ex(&zip, g_zip, len, &st));
+    ASSERT(pas_zip_sorted_build(&zip, &sorted, g_sorted, MANY, &st));
+    bad = 0;
+    for (i = 1; i < MANY; i++) bad += sorted.entries[i].cd_offset <= sorted.entries[i - 1].cd_offset;
+    ASSERT_EQ(bad, 0);
+    ASSERT_EQ(pas_zip_sorted_prefix(&sorted, "f01", &first), 1000u);
+    ASSERT_EQ(first, 1000u);
+}
+
+int main(void) {
+    g_failed = 0;
+    g_assertions = 0;
+    test_small();
+    test_many();
+    if (g_failed) {
+        (void)fprintf(stderr, "Total: %d assertions, %d failed\n", g_assertions, g_failed);
+        return 1;
+    }
+    (void)printf("All %d assertions passed.\n", g_assertions);
+    return 0;
+}
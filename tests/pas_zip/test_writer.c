@@ -0,0 +1,199 @@
+/*
+    test_writer.c - Test the streaming writer (pas_zip_writer_begin/add_entry/add_chunk/finish).
+    From repo root: gcc -o tests/pas_zip/test_writer tests/pas_zip/test_writer.c -I.
+*/
+
+#define PAS_ZIP_IMPLEMENTATION
+#include "pas_zip.h"
+#include <stdio.h>
+#include <string.h>
+
+static int g_failed, g_assertions;
+
+#define ASSERT(cond) do { \
+    ++g_assertions; \
+    if (!(cond)) { (void)fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); ++g_failed; } \
+} while (0)
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+#define TEXT_SIZE 300000
+#define MANY 100000
+
+static pas_zip_writer_t g_writer;
+static pas_zip_deflate_t g_deflate;
+static pas_zip_writer_entry_t g_entries[MANY];
+static unsigned char g_zip[MANY * 100];
+static char g_text[TEXT_SIZE];
+static char g_out[TEXT_SIZE];
+
+static void make_text(void) {
+    size_t n = 0;
+    unsigned i = 0;
+    for (; n < TEXT_SIZE - 64; i++)
+        n += (size_t)sprintf(g_text + n, "record %u: value=%u\n", i, (i * 7919u) % 1000u);
+    memset(g_text + n, '#', TEXT_SIZE - n);
+}
+
+/* Feed data in chunks of varying size (1 byte up to past the writer's piece size). */
+static int add_chunks(const char *data, size_t size) {
+    static const size_t steps[] = { 1, 7, 1000, 70000, 4096, 65536 };
+    size_t off = 0, k = 0;
+    pas_zip_status status;
+    while (off < size) {
+        size_t n = steps[k++ % 6];
+        if (n > size - off) n = size - off;
+        if (!pas_zip_writer_add_chunk(&g_writer, data + off, n, &status)) return 0;
+        off += n;
+    }
+    return 1;
+}
+
+static void test_entries(void) {
+    pas_zip_status status;
+    pas_zip_t arch;
+    pas_zip_file_t file;
+    size_t size, n;
+
+    make_text();
+    ASSERT_EQ(pas_zip_writer_begin(&g_writer, g_zip, sizeof(g_zip), g_entries, 8, &g_deflate, &status), 1);
+    ASSERT_EQ(pas_zip_writer_add_entry(&g_writer, "stored.txt", 0, &status), 1);
+    ASSERT(add_chunks(g_text, 5000));
+    ASSERT_EQ(pas_zip_writer_add_entry(&g_writer, "deflated.txt", 6, &status), 1);
+    ASSERT(add_chunks(g_text, TEXT_SIZE));
+    ASSERT_EQ(pas_zip_writer_add_entry(&g_writer, "fast.txt", 1, &status), 1);
+    ASSERT(add_chunks(g_text, TEXT_SIZE));
+    ASSERT_EQ(pas_zip_writer_add_entry(&g_writer, "empty", 9, &status), 1);
+    size = pas_zip_writer_finish(&g_writer, &status);
+    ASSERT(status == PAS_ZIP_OK);
+    ASSERT(size > 0);
+    ASSERT(size < 5000 + TEXT_SIZE / 2);
+
+    ASSERT_EQ(g_writer.count, 4u);
+    ASSERT_EQ(g_entries[0].method, PAS_ZIP_METHOD_STORE);
+    ASSERT_EQ(g_entries[1].method, PAS_ZIP_METHOD_DEFLATE);
+    ASSERT_EQ(g_entries[1].uncompressed_size, (uint64_t)TEXT_SIZE);
+    ASSERT(g_entries[1].compressed_size < TEXT_SIZE / 4);
+    ASSERT_EQ(g_entries[3].method, PAS_ZIP_METHOD_STORE);
+
+    ASSERT_EQ(pas_zip_open_ex(&arch, g_zip, size, &status), 1);
+    ASSERT_EQ(arch.num_entries, 4u);
+
+    ASSERT_EQ(pas_zip_find_ex(&arch, "stored.txt", &file), 1);
+    ASSERT_EQ(file.local_header_offset, g_entries[0].local_header_offset);
+    n = pas_zip_extract(&file, g_out, sizeof(g_out), &status);
+    ASSERT(status == PAS_ZIP_OK);
+    ASSERT_EQ(n, 5000u);
+    ASSERT(memcmp(g_out, g_text, 5000) == 0);
+
+    ASSERT_EQ(pas_zip_find_ex(&arch, "deflated.txt", &file), 1);
+    ASSERT_EQ(file.local_header_offset, g_entries[1].local_header_offset);
+    ASSERT_EQ(file.compressed_size, g_entries[1].compressed_size);
+    n = pas_zip_extract(&file, g_out, sizeof(g_out), &status);
+    ASSERT(status == PAS_ZIP_OK);
+    ASSERT_EQ(n, (size_t)TEXT_SIZE);
+    ASSERT(memcmp(g_out, g_text, TEXT_SIZE) == 0);
+
+    ASSERT_EQ(pas_zip_find_ex(&arch, "fast.txt", &file), 1);
+    memset(g_out, 0, sizeof(g_out));
+    n = pas_zip_extract(&file, g_out, sizeof(g_out), &status);
+    ASSERT(status == PAS_ZIP_OK);
+    ASSERT(memcmp(g_out, g_text, TEXT_SIZE) == 0);
+
+    ASSERT_EQ(pas_zip_find_ex(&arch, "empty", &file), 1);
+    ASSERT_EQ(file.uncompressed_size, 0u);
+}
+
+static void test_many_entries(void) {
+    char name[16];
+    pas_zip_status status;
+    pas_zip_t arch;
+    pas_zip_file_t file;
+    size_t size;
+    char out[16];
+    int i, ok = 1;
+
+    ASSERT_EQ(pas_zip_writer_begin(&g_writer, g_zip, sizeof(g_zip), g_entries, MANY, NULL, &status), 1);
+    for (i = 0; i < MANY && ok; i++) {
+        (void)sprintf(name, "e%06d", i);
+        ok = pas_zip_writer_add_entry(&g_writer, name, 0, &status) &&
+             pas_zip_writer_add_chunk(&g_writer, name, 7, &status);
+    }
+    ASSERT(ok);
+    size = pas_zip_writer_finish(&g_writer, &status);
+    ASSERT(status == PAS_ZIP_OK);
+
+    ASSERT_EQ(pas_zip_open_ex(&arch, g_zip, size, &status), 1);
+    ASSERT_EQ(arch.num_entries, (uint64_t)MANY);
+    ASSERT_EQ(pas_zip_find_ex(&arch, "e099999", &file), 1);
+    ASSERT_EQ(file.local_header_offset, g_entries[MANY - 1].local_header_offset);
+    ASSERT_EQ(pas_zip_extract(&file, out, sizeof(out), &status), 7u);
+    ASSERT(memcmp(out, "e099999", 7) == 0);
+}
+
+static void test_errors(void) {
+    pas_zip_status status;
+    pas_zip_t zip;
+    size_t size;
+
+    /* Entry table full */
+    ASSERT_EQ(pas_zip_writer_begin(&g_writer, g_zip, sizeof(g_zip), g_entries, 1, NULL, &status), 1);
+    ASSERT_EQ(pas_zip_writer_add_entry(&g_writer, "a", 0, &status), 1);
+    ASSERT_EQ(pas_zip_writer_add_entry(&g_writer, "b", 0, &status), 0);
+    ASSERT(status == PAS_ZIP_E_NOSPACE);
+    /* Errors are sticky */
+    ASSERT_EQ(pas_zip_writer_finish(&g_writer, &status), 0u);
+    ASSERT(status == PAS_ZIP_E_NOSPACE);
+
+    /* Output buffer too small for the compressed data */
+    ASSERT_EQ(pas_zip_writer_begin(&g_writer, g_zip, 2000, g_entries, 8, &g_deflate, &status), 1);
+    ASSERT_EQ(pas_zip_writer_add_entry(&g_writer, "big", 6, &status), 1);
+    (void)add_chunks(g_text, TEXT_SIZE);
+    ASSERT_EQ(pas_zip_writer_finish(&g_writer, &status), 0u);
+    ASSERT(status == PAS_ZIP_E_NOSPACE);
+
+    /* No entry open */
+    ASSERT_EQ(pas_zip_writer_begin(&g_writer, g_zip, sizeof(g_zip), g_entries, 8, NULL, &status), 1);
+    ASSERT_EQ(pas_zip_writer_add_chunk(&g_writer, "x", 1, &status), 0);
+    ASSERT(status == PAS_ZIP_E_INVALID);
+
+    /* Name longer than 65535 bytes: sticky like the other failures */
+    memset(g_out, 'n', 70000);
+    g_out[70000] = '\0';
+    ASSERT_EQ(pas_zip_writer_begin(&g_writer, g_zip, sizeof(g_zip), g_entries, 8, NULL, &status), 1);
+    ASSERT_EQ(pas_zip_writer_add_entry(&g_writer, g_out, 0, &status), 0);
+    ASSERT(status == PAS_ZIP_E_INVALID);
+    ASSERT_EQ(pas_zip_writer_add_entry(&g_writer, "a", 0, &status), 0);
+    ASSERT(status == PAS_ZIP_E_INVALID);
+    ASSERT_EQ(pas_zip_writer_finish(&g_writer, &status), 0u);
+    ASSERT(status == PAS_ZIP_E_INVALID);
+
+    /* Calls after finish fail and leave the archive as it was */
+    ASSERT_EQ(pas_zip_writer_begin(&g_writer, g_zip, sizeof(g_zip), g_entries, 8, &g_deflate, &status), 1);
+    ASSERT_EQ(pas_zip_writer_add_entry(&g_writer, "a", 6, &status), 1);
+    ASSERT_EQ(pas_zip_writer_add_chunk(&g_writer, g_text, 1000, &status), 1);
+    size = pas_zip_writer_finish(&g_writer, &status);
+    ASSERT(size > 0);
+    ASSERT_EQ(pas_zip_writer_add_entry(&g_writer, "b", 0, &status), 0);
+    ASSERT(status == PAS_ZIP_E_INVALID);
+    ASSERT_EQ(pas_zip_writer_add_chunk(&g_writer, "x", 1, &status), 0);
+    ASSERT(status == PAS_ZIP_E_INVALID);
+    ASSERT_EQ(pas_zip_writer_finish(&g_writer, &status), 0u);
+    ASSERT(status == PAS_ZIP_E_INVALID);
+    ASSERT_EQ(g_writer.pos, size);
+    ASSERT_EQ(pas_zip_open_ex(&zip, g_zip, size, &status), 1);
+    ASSERT_EQ(zip.num_entries, 1u);
+}
+
+int main(void) {
+    g_failed = 0;
+    g_assertions = 0;
+    test_entries();
+    test_many_entries();
+    test_errors();
+    if (g_failed) {
+        (void)fprintf(stderr, "Total: %d assertions, %d failed\n", g_assertions, g_failed);
+        return 1;
+    }
+    (void)printf("All %d assertions passed.\n", g_assertions);
+    return 0;
+}
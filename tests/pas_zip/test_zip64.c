@@ -0,0 +1,206 @@
+/*
+    test_zip64.c - Test ZIP64 end records and extra fields (more than 65535 entries, 64-bit fields).
+    From repo root: gcc -o tests/pas_zip/test_zip64 tests/pas_zip/test_zip64.c -I.
+*/
+
+#define PAS_ZIP_IMPLEMENTATION
+#include "pas_zip.h"
+#include <stdio.h>
+#include <string.h>
+
+static int g_failed, g_assertions;
+
+#define ASSERT(cond) do { \
+    ++g_assertions; \
+    if (!(cond)) { (void)fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); ++g_failed; } \
+} while (0)
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+#define MANY 70000
+
+static unsigned char g_zip[MANY * 100 + 4096];
+static uint32_t g_index[262144 * 2];
+static size_t g_w;
+
+static void put_u16(unsigned v) {
+    g_zip[g_w++] = (unsigned char)v;
+    g_zip[g_w++] = (unsigned char)(v >> 8);
+}
+static void put_u32(uint32_t v) { put_u16((unsigned)(v & 0xFFFF)); put_u16((unsigned)(v >> 16)); }
+static void put_u64(uint64_t v) { put_u32((uint32_t)v); put_u32((uint32_t)(v >> 32)); }
+
+static void put_local(const char *name, const char *data, uint32_t size) {
+    size_t len = strlen(name);
+    put_u32(0x04034b50);
+    put_u16(20); put_u16(0); put_u16(0);
+    put_u32(0); put_u32(0);
+    put_u32(size); put_u32(size);
+    put_u16((unsigned)len); put_u16(0);
+    memcpy(g_zip + g_w, name, len); g_w += len;
+    memcpy(g_zip + g_w, data, size); g_w += size;
+}
+
+/* Central Directory header. zip64_mask selects which of uncompressed size (1), compressed
+   size (2) and local header offset (4) are saturated and moved into a ZIP64 extra field. */
+static void put_central(const char *name, uint32_t size, uint32_t offset, unsigned zip64_mask) {
+    size_t len = strlen(name);
+    unsigned extra = 0, bit;
+    for (bit = 1; bit <= 4; bit <<= 1) if (zip64_mask & bit) extra += 8;
+    put_u32(0x02014b50);
+    put_u16(45); put_u16(45); put_u16(0); put_u16(0);
+    put_u32(0); put_u32(0);
+    put_u32((zip64_mask & 2) ? 0xFFFFFFFFu : size);
+    put_u32((zip64_mask & 1) ? 0xFFFFFFFFu : size);
+    put_u16((unsigned)len); put_u16(extra ? extra + 4 : 0); put_u16(0);
+    put_u16(0); put_u16(0); put_u32(0);
+    put_u32((zip64_mask & 4) ? 0xFFFFFFFFu : offset);
+    memcpy(g_zip + g_w, name, len); g_w += len;
+    if (extra) {
+        put_u16(0x0001); put_u16(extra);
+        if (zip64_mask & 1) put_u64(size);
+        if (zip64_mask & 2) put_u64(size);
+        if (zip64_mask & 4) put_u64(offset);
+    }
+}
+
+/* ZIP64 end record + locator (if zip64) and the classic end record. */
+static void put_end(uint64_t count, size_t cd_off, int zip64) {
+    size_t cd_size = g_w - cd_off, rec = g_w;
+    if (zip64) {
+        put_u32(0x06064b50); put_u64(44);
+        put_u16(45); put_u16(45); put_u32(0); put_u32(0);
+        put_u64(count); put_u64(count); put_u64(cd_size); put_u64(cd_off);
+        put_u32(0x07064b50); put_u32(0); put_u64(rec); put_u32(1);
+    }
+    put_u32(0x06054b50);
+    put_u16(0); put_u16(0);
+    put_u16(zip64 ? 0xFFFF : (unsigned)count); put_u16(zip64 ? 0xFFFF : (unsigned)count);
+    put_u32(zip64 ? 0xFFFFFFFFu : (uint32_t)cd_size); put_u32(zip64 ? 0xFFFFFFFFu : (uint32_t)cd_off);
+    put_u16(0);
+}
+
+static void count_cb(const char *name, size_t size, void *user) {
+    (void)name;
+    (void)size;
+    ++*(size_t *)user;
+}
+
+static void test_many_entries(void) {
+    char name[16];
+    uint32_t offsets[MANY];
+    size_t cd_off, count = 0;
+    pas_zip_t arch;
+    pas_zip_file_t file;
+    pas_zip_status status;
+    char out[16];
+    int i;
+
+    g_w = 0;
+    for (i = 0; i < MANY; i++) {
+        offsets[i] = (uint32_t)g_w;
+        (void)sprintf(name, "f%05d", i);
+        put_local(name, name, 6);
+    }
+    cd_off = g_w;
+    for (i = 0; i < MANY; i++) {
+        (void)sprintf(name, "f%05d", i);
+        put_central(name, 6, offsets[i], 0);
+    }
+    put_end(MANY, cd_off, 1);
+
+    ASSERT_EQ(pas_zip_open_ex(&arch, g_zip, g_w, &status), 1);
+    ASSERT(status == PAS_ZIP_OK);
+    ASSERT_EQ(arch.num_entries, (uint64_t)MANY);
+    ASSERT_EQ(arch.cd_offset, (uint64_t)cd_off);
+
+    ASSERT_EQ(pas_zip_list(&arch, count_cb, &count), 0);
+    ASSERT_EQ(count, (size_t)MANY);
+
+    ASSERT_EQ(pas_zip_find_ex(&arch, "f69999", &file), 1);
+    ASSERT_EQ(pas_zip_extract(&file, out, sizeof(out), &status), 6u);
+    ASSERT(memcmp(out, "f69999", 6) == 0);
+
+    ASSERT(pas_zip_index_size(&arch) <= sizeof(g_index));
+    ASSERT_EQ(pas_zip_index_build(&arch, g_index, sizeof(g_index), &status), 0);
+    ASSERT_EQ(pas_zip_find_indexed_ex(&arch, "f65536", &file), 1);
+    ASSERT_EQ(file.local_header_offset, (uint64_t)offsets[65536]);
+    ASSERT_EQ(pas_zip_find_indexed_ex(&arch, "f70000", &file), 0);
+}
+
+static void test_extra_field(void) {
+    static const unsigned masks[] = { 1, 2, 4, 7 };
+    pas_zip_t arch;
+    pas_zip_file_t file;
+    pas_zip_status status;
+    char out[16];
+    size_t cd_off, i;
+
+    for (i = 0; i < sizeof(masks) / sizeof(masks[0]); i++) {
+        g_w = 0;
+        put_local("pad", "", 0);
+        put_local("big", "payload", 7);
+        cd_off = g_w;
+        put_central("pad", 0, 0, 0);
+        put_central("big", 7, 33, masks[i]);
+        put_end(2, cd_off, (i & 1) != 0);
+
+        ASSERT_EQ(pas_zip_open_ex(&arch, g_zip, g_w, &status), 1);
+        ASSERT_EQ(pas_zip_find_ex(&arch, "big", &file), 1);
+        ASSERT_EQ(file.compressed_size, 7u);
+        ASSERT_EQ(file.uncompressed_size, 7u);
+        ASSERT_EQ(file.local_header_offset, 33u);
+        ASSERT_EQ(pas_zip_extract(&file, out, sizeof(out), &status), 7u);
+        ASSERT(status == PAS_ZIP_OK);
+        ASSERT(memcmp(out, "payload", 7) == 0);
+    }
+}
+
+static void test_invalid(void) {
+    pas_zip_t arch;
+    pas_zip_file_t file;
+    pas_zip_status status;
+    size_t cd_off;
+
+    /* Saturated size without the ZIP64 extra field */
+    g_w = 0;
+    put_local("big", "payload", 7);
+    cd_off = g_w;
+    put_central("big", 0xFFFFFFFFu, 0, 0);
+    put_end(1, cd_off, 0);
+    ASSERT_EQ(pas_zip_open_ex(&arch, g_zip, g_w, &status), 1);
+    ASSERT_EQ(pas_zip_find_ex(&arch, "big", &file), 0);
+
+    /* Saturated end record without a ZIP64 locator */
+    g_w = 0;
+    put_local("big", "payload", 7);
+    cd_off = g_w;
+    put_central("big", 7, 0, 0);
+    put_u32(0x06054b50);
+    put_u16(0); put_u16(0); put_u16(0xFFFF); put_u16(0xFFFF);
+    put_u32(0xFFFFFFFFu); put_u32(0xFFFFFFFFu); put_u16(0);
+    ASSERT_EQ(pas_zip_open_ex(&arch, g_zip, g_w, &status), 0);
+    ASSERT(status == PAS_ZIP_E_INVALID);
+
+    /* ZIP64 record pointing past the archive */
+    g_w = 0;
+    put_local("big", "payload", 7);
+    cd_off = g_w;
+    put_central("big", 7, 0, 0);
+    put_end(1, cd_off, 1);
+    g_zip[g_w - 22 - 20 + 8] = 0xFF; /* locator's record offset, low byte */
+    ASSERT_EQ(pas_zip_open_ex(&arch, g_zip, g_w, &status), 0);
+}
+
+int main(void) {
+    g_failed = 0;
+    g_assertions = 0;
+    test_many_entries();
+    test_extra_field();
+    test_invalid();
+    if (g_failed) {
+        (void)fprintf(stderr, "Total: %d assertions, %d failed\n", g_assertions, g_failed);
+        return 1;
+    }
+    (void)printf("All %d assertions passed.\n", g_assertions);
+    return 0;
+}